@@ -18,3 +18,7 @@ export class RpcStub {
 
 export class RpcTarget {
 }
+
+export class RpcSerialized {
+  public constructor(value: unknown);
+}
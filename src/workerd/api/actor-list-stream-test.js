@@ -0,0 +1,98 @@
+// Copyright (c) 2023 Cloudflare, Inc.
+// Licensed under the Apache 2.0 license found in the LICENSE file or at:
+//     https://opensource.org/licenses/Apache-2.0
+
+import * as assert from 'node:assert'
+
+// 300 keys deliberately exceeds the iterator's internal chunk size so the test exercises
+// multiple storage round trips.
+const NUM_KEYS = 300;
+const key = i => `key-${String(i).padStart(4, "0")}`;
+
+export class DurableObjectExample {
+  constructor(state, env) {
+    this.state = state;
+  }
+
+  async fetch() {
+    const storage = this.state.storage;
+
+    const entries = {};
+    for (let i = 0; i < NUM_KEYS; ++i) {
+      entries[key(i)] = i;
+    }
+    await storage.put(entries);
+    await storage.put("other-key", "other-value");
+
+    // A full prefix scan yields every entry, in order, with the right values.
+    {
+      let i = 0;
+      for await (const [k, v] of storage.listStream({ prefix: "key-" })) {
+        assert.equal(k, key(i));
+        assert.equal(v, i);
+        ++i;
+      }
+      assert.equal(i, NUM_KEYS);
+    }
+
+    // The streamed results match list() exactly.
+    {
+      const listed = await storage.list();
+      const streamed = [];
+      for await (const entry of storage.listStream()) {
+        streamed.push(entry);
+      }
+      assert.deepEqual(streamed, [...listed.entries()]);
+    }
+
+    // Reverse iteration pages backwards through the range.
+    {
+      let i = NUM_KEYS;
+      for await (const [k, v] of storage.listStream({ prefix: "key-", reverse: true })) {
+        --i;
+        assert.equal(k, key(i));
+        assert.equal(v, i);
+      }
+      assert.equal(i, 0);
+    }
+
+    // limit and startAfter apply across chunk boundaries.
+    {
+      const streamed = [];
+      for await (const [k] of storage.listStream({ startAfter: key(9), limit: 200 })) {
+        streamed.push(k);
+      }
+      assert.equal(streamed.length, 200);
+      assert.equal(streamed[0], key(10));
+      assert.equal(streamed[199], key(209));
+    }
+
+    // Breaking out of the loop terminates the iterator cleanly.
+    {
+      const it = storage.listStream();
+      let count = 0;
+      for await (const entry of it) {
+        if (++count == 5) break;
+      }
+      assert.deepEqual(await it.next(), { done: true, value: undefined });
+    }
+
+    // An empty range finishes immediately.
+    {
+      for await (const entry of storage.listStream({ prefix: "no-such-prefix-" })) {
+        throw new Error(`unexpected entry ${entry}`);
+      }
+    }
+
+    return new Response("OK");
+  }
+}
+
+export default {
+  async test(ctrl, env, ctx) {
+    const id = env.ns.idFromName("A");
+    const obj = env.ns.get(id);
+    const resp = await obj.fetch("http://foo/");
+    assert.equal(await resp.text(), "OK");
+  }
+}
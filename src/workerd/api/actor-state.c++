@@ -211,6 +211,115 @@ kj::Promise<void> updateStorageDeletes(IoContext& context,
   metrics.addStorageDeletes(deleted);
 };
 
+// Computes the key sorting immediately after `key`, i.e. `key` plus one NULL byte. This looks a
+// little sketchy to be doing with strings rather than arrays, but kj::String explicitly allows
+// for NULL bytes inside of strings. kj::String automatically reads the last NULL as string
+// termination, so we need to add it twice to make it stick in the final string.
+kj::String keyAfter(kj::ArrayPtr<const char> key) {
+  auto result = kj::heapArray<char>(key.size() + 2);
+  memcpy(result.begin(), key.begin(), key.size());
+  result[result.size() - 2] = '\0';
+  result[result.size() - 1] = '\0';
+  return kj::String(kj::mv(result));
+}
+
+struct ListRange {
+  kj::String start;
+  kj::Maybe<kj::String> end;
+  bool reverse = false;
+  kj::Maybe<uint> limit;
+};
+
+// Validates list options and collapses start/startAfter/end/prefix down to a single
+// [start, end) key range. Returns kj::none if the requested range is provably empty.
+kj::Maybe<ListRange> normalizeListRange(
+    jsg::Optional<DurableObjectStorageOperations::ListOptions>& maybeOptions) {
+  ListRange range;
+
+  KJ_IF_SOME(o, maybeOptions) {
+    KJ_IF_SOME(s, o.start) {
+      if (o.startAfter != kj::none) {
+        KJ_FAIL_REQUIRE("jsg.TypeError: list() cannot be called with both start and startAfter values.");
+      }
+      range.start = kj::mv(s);
+    }
+    KJ_IF_SOME(sks, o.startAfter) {
+      // Convert an exclusive startAfter into an inclusive start key here so that the implementation
+      // doesn't need to handle both.
+      range.start = keyAfter(sks);
+    }
+    KJ_IF_SOME(e, o.end) {
+      range.end = kj::mv(e);
+    }
+    KJ_IF_SOME(r, o.reverse) {
+      range.reverse = r;
+    }
+    KJ_IF_SOME(l, o.limit) {
+      JSG_REQUIRE(l > 0, TypeError, "List limit must be positive.");
+      range.limit = l;
+    }
+    KJ_IF_SOME(prefix, o.prefix) {
+      // Let's clamp `start` and `end` to include only keys with the given prefix.
+      if (prefix.size() > 0) {
+        if (range.start < prefix) {
+          // `start` is before `prefix`, so listing should actually start at `prefix`.
+          range.start = kj::str(prefix);
+        } else if (range.start.startsWith(prefix)) {
+          // `start` is within the prefix, so need not be modified.
+        } else {
+          // `start` comes after the last value with the prefix, so there's no overlap.
+          return kj::none;
+        }
+
+        // Calculate the first key that sorts after all keys with the given prefix.
+        kj::Vector<char> keyAfterPrefix(prefix.size());
+        keyAfterPrefix.addAll(prefix);
+        while (!keyAfterPrefix.empty() && (byte)keyAfterPrefix.back() == 0xff) {
+          keyAfterPrefix.removeLast();
+        }
+        if (keyAfterPrefix.empty()) {
+          // The prefix is a string of some number of 0xff bytes, so includes the entire key space
+          // up through the last possible key. Hence, there is no end. (But if an end was specified
+          // earlier, that's still valid.)
+        } else {
+          keyAfterPrefix.back()++;
+          keyAfterPrefix.add('\0');
+          auto keyAfterPrefixStr = kj::String(keyAfterPrefix.releaseAsArray());
+
+          KJ_IF_SOME(e, range.end) {
+            if (e <= prefix) {
+              // No keys could possibly match both the end and the prefix.
+              return kj::none;
+            } else if (e.startsWith(prefix)) {
+              // `end` is within the prefix, so need not be modified.
+            } else {
+              // `end` comes after all keys with the prefix, so we should stop at the end of the
+              // prefix.
+              range.end = kj::mv(keyAfterPrefixStr);
+            }
+          } else {
+            // We didn't have any end set, so use the end of the prefix range.
+            range.end = kj::mv(keyAfterPrefixStr);
+          }
+        }
+      }
+    }
+  }
+
+  KJ_IF_SOME(e, range.end) {
+    if (e <= range.start) {
+      // Key range is empty.
+      return kj::none;
+    }
+  }
+
+  return kj::mv(range);
+}
+
+// Keys fetched per storage round trip by listStream(). Small enough to keep per-chunk memory
+// bounded, large enough to amortize the cache lookup over many keys.
+constexpr uint LIST_STREAM_CHUNK_SIZE = 128;
+
 // Return the id of the current actor (or the empty string if there is no current actor).
 kj::Maybe<kj::String> getCurrentActorId() {
   if (IoContext::hasCurrent()) {
@@ -251,6 +360,7 @@ jsg::Promise<jsg::JsRef<jsg::JsValue>> DurableObjectStorageOperations::get(
 jsg::Promise<jsg::JsRef<jsg::JsValue>> DurableObjectStorageOperations::getOne(
     jsg::Lock& js, kj::String key, const GetOptions& options) {
   ActorStorageLimits::checkMaxKeySize(key);
+  recordKeyAccess(key);
 
   auto result = getCache(OP_GET).get(kj::str(key), options);
   return transformCacheResultWithCacheStatus(js, kj::mv(result), options,
@@ -291,112 +401,22 @@ jsg::Promise<kj::Maybe<double>> DurableObjectStorageOperations::getAlarm(
 
 jsg::Promise<jsg::JsRef<jsg::JsValue>> DurableObjectStorageOperations::list(
     jsg::Lock& js, jsg::Optional<ListOptions> maybeOptions) {
-  kj::String start;
-  kj::Maybe<kj::String> end;
-  bool reverse = false;
-  kj::Maybe<uint> limit;
-
-  auto makeEmptyResult = [&]() {
+  auto maybeRange = normalizeListRange(maybeOptions);
+  KJ_IF_SOME(range, maybeRange) {
+    auto options = configureOptions(kj::mv(maybeOptions).orDefault(ListOptions{}));
+    ActorCacheOps::ReadOptions readOptions = options;
+
+    auto result = range.reverse
+        ? getCache(OP_LIST).listReverse(
+              kj::mv(range.start), kj::mv(range.end), range.limit, readOptions)
+        : getCache(OP_LIST).list(
+              kj::mv(range.start), kj::mv(range.end), range.limit, readOptions);
+    return transformCacheResultWithCacheStatus(js, kj::mv(result),
+                                               options, &listResultsToMap);
+  } else {
+    // Key range is empty.
     return js.resolvedPromise(jsg::JsValue(js.map()).addRef(js));
-  };
-
-  KJ_IF_SOME(o, maybeOptions) {
-    KJ_IF_SOME(s, o.start) {
-      if (o.startAfter != kj::none) {
-        KJ_FAIL_REQUIRE("jsg.TypeError: list() cannot be called with both start and startAfter values.");
-      }
-      start = kj::mv(s);
-    }
-    KJ_IF_SOME(sks, o.startAfter) {
-      // Convert an exclusive startAfter into an inclusive start key here so that the implementation
-      // doesn't need to handle both. This can be done simply by adding two NULL bytes. One to the end of
-      // the startAfter and another to set the start key after startAfter.
-      auto startAfterKey = kj::heapArray<char>(sks.size() + 2);
-
-      // Copy over the original string.
-      memcpy(startAfterKey.begin(), sks.begin(), sks.size());
-      // Add one additional null byte to set the new start as the key immediately
-      // after startAfter. This looks a little sketchy to be doing with strings rather
-      // than arrays, but kj::String explicitly allows for NULL bytes inside of strings.
-      startAfterKey[startAfterKey.size()-2] = '\0';
-      // kj::String automatically reads the last NULL as string termination, so we need to add it twice
-      // to make it stick in the final string.
-      startAfterKey[startAfterKey.size()-1] = '\0';
-      start = kj::String(kj::mv(startAfterKey));
-    }
-    KJ_IF_SOME(e, o.end) {
-      end = kj::mv(e);
-    }
-    KJ_IF_SOME(r, o.reverse) {
-      reverse = r;
-    }
-    KJ_IF_SOME(l, o.limit) {
-      JSG_REQUIRE(l > 0, TypeError, "List limit must be positive.");
-      limit = l;
-    }
-    KJ_IF_SOME(prefix, o.prefix) {
-      // Let's clamp `start` and `end` to include only keys with the given prefix.
-      if (prefix.size() > 0) {
-        if (start < prefix) {
-          // `start` is before `prefix`, so listing should actually start at `prefix`.
-          start = kj::str(prefix);
-        } else if (start.startsWith(prefix)) {
-          // `start` is within the prefix, so need not be modified.
-        } else {
-          // `start` comes after the last value with the prefix, so there's no overlap.
-          return makeEmptyResult();
-        }
-
-        // Calculate the first key that sorts after all keys with the given prefix.
-        kj::Vector<char> keyAfterPrefix(prefix.size());
-        keyAfterPrefix.addAll(prefix);
-        while (!keyAfterPrefix.empty() && (byte)keyAfterPrefix.back() == 0xff) {
-          keyAfterPrefix.removeLast();
-        }
-        if (keyAfterPrefix.empty()) {
-          // The prefix is a string of some number of 0xff bytes, so includes the entire key space
-          // up through the last possible key. Hence, there is no end. (But if an end was specified
-          // earlier, that's still valid.)
-        } else {
-          keyAfterPrefix.back()++;
-          keyAfterPrefix.add('\0');
-          auto keyAfterPrefixStr = kj::String(keyAfterPrefix.releaseAsArray());
-
-          KJ_IF_SOME(e, end) {
-            if (e <= prefix) {
-              // No keys could possibly match both the end and the prefix.
-              return makeEmptyResult();
-            } else if (e.startsWith(prefix)) {
-              // `end` is within the prefix, so need not be modified.
-            } else {
-              // `end` comes after all keys with the prefix, so we should stop at the end of the
-              // prefix.
-              end = kj::mv(keyAfterPrefixStr);
-            }
-          } else {
-            // We didn't have any end set, so use the end of the prefix range.
-            end = kj::mv(keyAfterPrefixStr);
-          }
-        }
-      }
-    }
-  }
-
-  KJ_IF_SOME(e, end) {
-    if (e <= start) {
-      // Key range is empty.
-      return makeEmptyResult();
-    }
   }
-
-  auto options = configureOptions(kj::mv(maybeOptions).orDefault(ListOptions{}));
-  ActorCacheOps::ReadOptions readOptions = options;
-
-  auto result = reverse
-      ? getCache(OP_LIST).listReverse(kj::mv(start), kj::mv(end), limit, readOptions)
-      : getCache(OP_LIST).list(kj::mv(start), kj::mv(end), limit, readOptions);
-  return transformCacheResultWithCacheStatus(js, kj::mv(result),
-                                             options, &listResultsToMap);
 }
 
 jsg::Promise<void> DurableObjectStorageOperations::put(
@@ -559,6 +579,9 @@ jsg::Promise<jsg::JsRef<jsg::JsValue>> DurableObjectStorageOperations::getMultip
     kj::Array<kj::String> keys,
     const GetOptions& options) {
   ActorStorageLimits::checkMaxPairsCount(keys.size());
+  for (auto& key: keys) {
+    recordKeyAccess(key);
+  }
 
   auto numKeys = keys.size();
 
@@ -617,6 +640,146 @@ ActorCacheOps& DurableObjectStorage::getCache(OpName op) {
   return *cache;
 }
 
+void DurableObjectStorage::ListStreamState::visitForGc(jsg::GcVisitor& visitor) {
+  visitor.visit(storage);
+  for (auto& entry: buffer) {
+    visitor.visit(entry);
+  }
+}
+
+jsg::Ref<DurableObjectStorage::ListStreamIterator> DurableObjectStorage::listStream(
+    jsg::Lock& js, jsg::Optional<ListOptions> maybeOptions) {
+  auto maybeRange = normalizeListRange(maybeOptions);
+  auto state = ListStreamState {
+    .storage = JSG_THIS,
+    .options = configureOptions(kj::mv(maybeOptions).orDefault(ListOptions{})),
+  };
+  KJ_IF_SOME(range, maybeRange) {
+    state.cursor = kj::mv(range.start);
+    state.end = kj::mv(range.end);
+    state.reverse = range.reverse;
+    state.remaining = range.limit;
+  } else {
+    // Key range is provably empty; like list(), don't touch storage (or bill) at all.
+    state.exhausted = true;
+    state.billedAnything = true;
+  }
+  return jsg::alloc<ListStreamIterator>(kj::mv(state));
+}
+
+jsg::Promise<kj::Maybe<jsg::JsRef<jsg::JsValue>>> DurableObjectStorage::listStreamNext(
+    jsg::Lock& js, ListStreamState& state) {
+  if (state.bufferPos < state.buffer.size()) {
+    auto entry = kj::mv(state.buffer[state.bufferPos++]);
+    if (state.bufferPos == state.buffer.size()) {
+      state.buffer.clear();
+      state.bufferPos = 0;
+    }
+    return js.resolvedPromise(kj::Maybe<jsg::JsRef<jsg::JsValue>>(kj::mv(entry)));
+  }
+
+  if (state.exhausted) {
+    if (!state.billedAnything) {
+      // As with list(), a scan that produced no results still bills one uncached read unit.
+      currentActorMetrics().addUncachedStorageReadUnits(1);
+      state.billedAnything = true;
+    }
+    return js.resolvedPromise(kj::Maybe<jsg::JsRef<jsg::JsValue>>(kj::none));
+  }
+
+  uint chunkLimit = LIST_STREAM_CHUNK_SIZE;
+  KJ_IF_SOME(remaining, state.remaining) {
+    chunkLimit = kj::min(chunkLimit, remaining);
+  }
+
+  ActorCacheOps::ReadOptions readOptions = state.options;
+  auto& cache = state.storage->getCache(OP_LIST);
+  auto copyEnd = [](kj::String& e) { return kj::str(e); };
+  auto result = state.reverse
+      ? cache.listReverse(kj::str(state.cursor), state.end.map(copyEnd), chunkLimit, readOptions)
+      : cache.list(kj::str(state.cursor), state.end.map(copyEnd), chunkLimit, readOptions);
+
+  // The iterator framework keeps the iterator object -- and thus `state` -- alive as long as the
+  // promise returned from here is pending, so capturing `state` by reference is safe.
+  return transformCacheResultWithCacheStatus(js, kj::mv(result), state.options,
+      [&state, chunkLimit](jsg::Lock& js, ActorCacheOps::GetResultList value,
+                           bool completelyCached) -> kj::Maybe<jsg::JsRef<jsg::JsValue>> {
+    size_t cachedReadBytes = 0;
+    size_t uncachedReadBytes = 0;
+    kj::Maybe<kj::String> lastKey;
+
+    // Only already-delivered (moved-from) entries can be left over at this point.
+    state.buffer.clear();
+    state.bufferPos = 0;
+
+    js.withinHandleScope([&] {
+      for (auto entry: value) {
+        auto& bytesRef = entry.status == ActorCacheOps::CacheStatus::CACHED
+                      ? cachedReadBytes : uncachedReadBytes;
+        bytesRef += entry.key.size() + entry.value.size();
+        state.buffer.add(jsg::JsValue(js.arr(
+            js.str(entry.key),
+            deserializeV8Value(js, entry.key, entry.value))).addRef(js));
+        lastKey = kj::str(entry.key);
+      }
+    });
+
+    if (cachedReadBytes || uncachedReadBytes) {
+      // Same accounting as listResultsToMap(), applied chunk by chunk.
+      size_t totalReadBytes = cachedReadBytes + uncachedReadBytes;
+      uint32_t totalUnits = billingUnits(totalReadBytes);
+      auto billAtLeastOne = completelyCached ? BillAtLeastOne::NO : BillAtLeastOne::YES;
+      uint32_t uncachedUnits = billingUnits(uncachedReadBytes, billAtLeastOne);
+      uint32_t cachedUnits = totalUnits - uncachedUnits;
+
+      auto& actorMetrics = currentActorMetrics();
+      actorMetrics.addUncachedStorageReadUnits(uncachedUnits);
+      actorMetrics.addCachedStorageReadUnits(cachedUnits);
+      state.billedAnything = true;
+    }
+
+    uint count = value.size();
+    KJ_IF_SOME(remaining, state.remaining) {
+      remaining -= count;
+      if (remaining == 0) state.exhausted = true;
+    }
+    if (count < chunkLimit) {
+      // A short chunk means storage had no further keys in the range.
+      state.exhausted = true;
+    }
+    if (!state.exhausted) {
+      auto& last = KJ_ASSERT_NONNULL(lastKey);
+      if (state.reverse) {
+        // Reverse scans shrink the range from the top: `last` is the smallest key delivered so
+        // far and the end bound is exclusive.
+        state.end = kj::mv(last);
+      } else {
+        state.cursor = keyAfter(last);
+      }
+    }
+
+    if (state.buffer.size() == 0) {
+      if (!state.billedAnything) {
+        // As with list(), a scan that produced no results still bills one uncached read unit.
+        currentActorMetrics().addUncachedStorageReadUnits(1);
+        state.billedAnything = true;
+      }
+      return kj::none;
+    }
+    return kj::mv(state.buffer[state.bufferPos++]);
+  });
+}
+
+jsg::Promise<void> DurableObjectStorage::listStreamReturn(
+    jsg::Lock& js, ListStreamState& state, jsg::Optional<jsg::Value> value) {
+  // Nothing needs canceling: a chunk fetch already in flight completes into the cache on its
+  // own, and any buffered entries simply drop.
+  state.buffer.clear();
+  state.bufferPos = 0;
+  state.exhausted = true;
+  return js.resolvedPromise();
+}
+
 jsg::Promise<jsg::JsRef<jsg::JsValue>> DurableObjectStorage::transaction(jsg::Lock& js,
     jsg::Function<jsg::Promise<jsg::JsRef<jsg::JsValue>>(
         jsg::Ref<DurableObjectTransaction>)> callback,
@@ -698,6 +861,72 @@ jsg::JsRef<jsg::JsValue> DurableObjectStorage::transactionSync(
   }
 }
 
+// Starts a cache read purely for its warming side effect: if the result was already cached there
+// is nothing to do, and otherwise the in-flight read is parked on waitUntil so it completes (and
+// populates the cache) without anything gating on it.
+template <typename T>
+static void issuePrefetch(kj::OneOf<T, kj::Promise<T>> result) {
+  KJ_SWITCH_ONEOF(result) {
+    KJ_CASE_ONEOF(value, T) {
+      // Already in cache.
+    }
+    KJ_CASE_ONEOF(promise, kj::Promise<T>) {
+      IoContext::current().addWaitUntil(promise.ignoreResult(),
+          IoContext::WaitUntilTaskClass::BEST_EFFORT);
+    }
+  }
+}
+
+void DurableObjectStorage::prefetch(jsg::Lock& js,
+    jsg::Optional<kj::OneOf<kj::String, kj::Array<kj::String>, ListOptions>> keysOrOptions,
+    jsg::Optional<GetOptions> maybeOptions) {
+  auto options = configureOptions(kj::mv(maybeOptions).orDefault(GetOptions{}));
+  KJ_IF_SOME(arg, keysOrOptions) {
+    KJ_SWITCH_ONEOF(arg) {
+      KJ_CASE_ONEOF(key, kj::String) {
+        ActorStorageLimits::checkMaxKeySize(key);
+        issuePrefetch(getCache(OP_PREFETCH).get(kj::mv(key), options));
+      }
+      KJ_CASE_ONEOF(keys, kj::Array<kj::String>) {
+        ActorStorageLimits::checkMaxPairsCount(keys.size());
+        for (auto& key: keys) {
+          ActorStorageLimits::checkMaxKeySize(key);
+        }
+        issuePrefetch(getCache(OP_PREFETCH).get(kj::mv(keys), options));
+      }
+      KJ_CASE_ONEOF(listOptions, ListOptions) {
+        jsg::Optional<ListOptions> opt = kj::mv(listOptions);
+        KJ_IF_SOME(range, normalizeListRange(opt)) {
+          auto result = range.reverse
+              ? getCache(OP_PREFETCH).listReverse(
+                    kj::mv(range.start), kj::mv(range.end), range.limit, options)
+              : getCache(OP_PREFETCH).list(
+                    kj::mv(range.start), kj::mv(range.end), range.limit, options);
+          issuePrefetch(kj::mv(result));
+        }
+        // (An empty range warms nothing.)
+      }
+    }
+  } else {
+    // Learned mode: replay the keys recorded since the previous no-argument call, then start a
+    // fresh recording. The first call records only; see recordKeyAccess().
+    recordingAccesses = true;
+    if (recordedKeys.size() > 0) {
+      auto keys = KJ_MAP(key, recordedKeys) { return kj::mv(key); };
+      recordedKeys.clear();
+      issuePrefetch(getCache(OP_PREFETCH).get(kj::mv(keys), options));
+    }
+  }
+}
+
+void DurableObjectStorage::recordKeyAccess(kj::StringPtr key) {
+  if (!recordingAccesses || recordedKeys.size() >= MAX_LEARNED_KEYS) return;
+  for (auto& existing: recordedKeys) {
+    if (existing == key) return;
+  }
+  recordedKeys.add(kj::str(key));
+}
+
 jsg::Promise<void> DurableObjectStorage::sync(jsg::Lock& js) {
   KJ_IF_SOME(p, cache->onNoPendingFlush()) {
     // Note that we're not actually flushing since that will happen anyway once we go async. We're
@@ -920,6 +1149,40 @@ void DurableObjectState::setWebSocketAutoResponse(
       reqResp->getResponse());
 }
 
+void DurableObjectState::setWebSocketAutoResponses(
+      jsg::Sequence<jsg::Ref<WebSocketRequestResponsePair>> pairs) {
+  auto& a = KJ_REQUIRE_NONNULL(IoContext::current().getActor());
+
+  if (pairs.size() == 0) {
+    // An empty table unsets any current auto response configuration.
+    KJ_IF_SOME(manager, a.getHibernationManager()) {
+      // If there's no hibernation manager created yet, there's nothing to do here.
+      manager.setWebSocketAutoResponse(kj::none, kj::none);
+    }
+    return;
+  }
+
+  auto maxRequestOrResponseSize = 2048;
+  auto table = kj::heapArrayBuilder<Worker::Actor::HibernationManager::AutoResponsePair>(
+      pairs.size());
+  for (auto& pair: pairs) {
+    JSG_REQUIRE(pair->getRequest().size() <= maxRequestOrResponseSize, RangeError, kj::str(
+        "Request cannot be larger than ", maxRequestOrResponseSize, " bytes. ",
+        "A request of size ", pair->getRequest().size(), " was provided."));
+
+    JSG_REQUIRE(pair->getResponse().size() <= maxRequestOrResponseSize, RangeError, kj::str(
+        "Response cannot be larger than ", maxRequestOrResponseSize, " bytes. ",
+        "A response of size ", pair->getResponse().size(), " was provided."));
+
+    table.add(Worker::Actor::HibernationManager::AutoResponsePair {
+      .request = kj::str(pair->getRequest()),
+      .response = kj::str(pair->getResponse()),
+    });
+  }
+
+  maybeInitHibernationManager(a).setWebSocketAutoResponses(table.finish());
+}
+
 kj::Maybe<jsg::Ref<api::WebSocketRequestResponsePair>> DurableObjectState::getWebSocketAutoResponse() {
   auto& a = KJ_REQUIRE_NONNULL(IoContext::current().getActor());
   KJ_IF_SOME(manager, a.getHibernationManager()) {
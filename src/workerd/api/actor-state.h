@@ -138,13 +138,18 @@ protected:
   static constexpr OpName OP_DELETE_ALARM = "deleteAlarm()"_kj;
   static constexpr OpName OP_RENAME = "rename()"_kj;
   static constexpr OpName OP_ROLLBACK = "rollback()"_kj;
+  static constexpr OpName OP_PREFETCH = "prefetch()"_kj;
 
   static bool readOnlyOp(OpName op) {
-    return op == OP_GET || op == OP_LIST || op == OP_ROLLBACK;
+    return op == OP_GET || op == OP_LIST || op == OP_ROLLBACK || op == OP_PREFETCH;
   }
 
   virtual ActorCacheOps& getCache(OpName op) = 0;
 
+  // Called for each key read through get(), so that implementations can learn access patterns
+  // (see DurableObjectStorage::prefetch()). The default does nothing.
+  virtual void recordKeyAccess(kj::StringPtr key) {}
+
   // Whether to skip caching and allow concurrency on all operations.
   virtual bool useDirectIo() = 0;
 
@@ -183,6 +188,34 @@ private:
 class DurableObjectTransaction;
 
 class DurableObjectStorage: public jsg::Object, public DurableObjectStorageOperations {
+private:
+  // Internal state of a listStream() iterator. The iterator pulls the requested range from the
+  // cache one bounded chunk at a time; `cursor`/`end` track the portion of the range not yet
+  // fetched and `buffer` holds the entries of the current chunk not yet delivered.
+  struct ListStreamState {
+    jsg::Ref<DurableObjectStorage> storage;
+    // Configured options; the key range itself lives in `cursor`/`end` below.
+    ListOptions options;
+    // Inclusive start key of the next chunk to fetch.
+    kj::String cursor;
+    kj::Maybe<kj::String> end;
+    bool reverse = false;
+    // How much of the caller-provided limit is left, if one was given.
+    kj::Maybe<uint> remaining;
+    kj::Vector<jsg::JsRef<jsg::JsValue>> buffer;
+    size_t bufferPos = 0;
+    // True once there are no more chunks to fetch.
+    bool exhausted = false;
+    bool billedAnything = false;
+
+    void visitForGc(jsg::GcVisitor& visitor);
+  };
+
+  static jsg::Promise<kj::Maybe<jsg::JsRef<jsg::JsValue>>> listStreamNext(
+      jsg::Lock& js, ListStreamState& state);
+  static jsg::Promise<void> listStreamReturn(
+      jsg::Lock& js, ListStreamState& state, jsg::Optional<jsg::Value> value);
+
 public:
   DurableObjectStorage(IoPtr<ActorCacheInterface> cache)
     : cache(kj::mv(cache)) {}
@@ -208,8 +241,35 @@ public:
       jsg::Lock& js,
       jsg::Function<jsg::JsRef<jsg::JsValue>()> callback);
 
+  // Incremental variant of list(): returns an async iterator yielding [key, value] pairs in
+  // order, fetching the range from storage one bounded chunk at a time. This lets arbitrarily
+  // large scans run in constant memory and deliver their first results without waiting for the
+  // whole range to materialize, unlike list() which builds the complete result map up front.
+  JSG_ASYNC_ITERATOR_WITH_OPTIONS(ListStreamIterator,
+                                   listStream,
+                                   jsg::JsRef<jsg::JsValue>,
+                                   ListStreamState,
+                                   listStreamNext,
+                                   listStreamReturn,
+                                   ListOptions);
+
   jsg::Promise<void> deleteAll(jsg::Lock& js, jsg::Optional<PutOptions> options);
 
+  // Warms the actor cache for the given keys or key range without gating anything on the
+  // results: reads that miss cache are issued in the background (held open via waitUntil) and
+  // their values land in cache for later get()/list() calls to hit. Handlers that know which
+  // keys an event will touch can call this up front so subsequent reads don't serialize on
+  // cold storage round trips.
+  //
+  // Calling with no argument enables learned mode: the storage object records which keys get()
+  // touches, and each no-argument prefetch() call issues background reads for the keys recorded
+  // since the previous one, then starts a fresh recording. A handler that calls
+  // `storage.prefetch()` at the top of each event thus automatically warms the key set the
+  // previous event touched. The recording is bounded; see MAX_LEARNED_KEYS.
+  void prefetch(jsg::Lock& js,
+      jsg::Optional<kj::OneOf<kj::String, kj::Array<kj::String>, ListOptions>> keysOrOptions,
+      jsg::Optional<GetOptions> options);
+
   jsg::Promise<void> sync(jsg::Lock& js);
 
   jsg::Ref<SqlStorage> getSql(jsg::Lock& js);
@@ -247,6 +307,8 @@ public:
     JSG_METHOD(sync);
 
     if (flags.getWorkerdExperimental()) {
+      JSG_METHOD(listStream);
+      JSG_METHOD(prefetch);
       JSG_LAZY_INSTANCE_PROPERTY(sql, getSql);
       JSG_METHOD(transactionSync);
 
@@ -260,6 +322,7 @@ public:
       get<T = unknown>(keys: string[], options?: DurableObjectGetOptions): Promise<Map<string, T>>;
 
       list<T = unknown>(options?: DurableObjectListOptions): Promise<Map<string, T>>;
+      listStream<T = unknown>(options?: DurableObjectListOptions): AsyncIterableIterator<[string, T]>;
 
       put<T>(key: string, value: T, options?: DurableObjectPutOptions): Promise<void>;
       put<T>(entries: Record<string, T>, options?: DurableObjectPutOptions): Promise<void>;
@@ -279,9 +342,18 @@ protected:
     return false;
   }
 
+  void recordKeyAccess(kj::StringPtr key) override;
+
 private:
   IoPtr<ActorCacheInterface> cache;
   uint transactionSyncDepth = 0;
+
+  // Learned-prefetch state; see prefetch(). Recording only happens once a no-argument
+  // prefetch() call has opted in, so objects that never use learned mode pay nothing. The
+  // recording is capped so a key-scanning event can't accumulate unbounded state.
+  static constexpr size_t MAX_LEARNED_KEYS = 64;
+  bool recordingAccesses = false;
+  kj::Vector<kj::String> recordedKeys;
 };
 
 class DurableObjectTransaction final: public jsg::Object, public DurableObjectStorageOperations {
@@ -477,6 +549,12 @@ public:
   // If maybeReqResp is not set, we consider it as unset and remove any set request response pair.
   void setWebSocketAutoResponse(jsg::Optional<jsg::Ref<api::WebSocketRequestResponsePair>> maybeReqResp);
 
+  // Like setWebSocketAutoResponse(), but installs a table of request/response pairs: an incoming
+  // message matching any request in the table is answered natively without waking the object.
+  // Passing an empty array clears the table. (Experimental.)
+  void setWebSocketAutoResponses(
+      jsg::Sequence<jsg::Ref<api::WebSocketRequestResponsePair>> pairs);
+
   // Gets the currently set object-wide websocket auto response.
   kj::Maybe<jsg::Ref<api::WebSocketRequestResponsePair>> getWebSocketAutoResponse();
 
@@ -513,6 +591,8 @@ public:
       //   useful to apps in actual production? It's a convenient way to bail out when you discover
       //   your state is inconsistent.
       JSG_METHOD(abort);
+
+      JSG_METHOD(setWebSocketAutoResponses);
     }
 
     JSG_TS_ROOT();
@@ -554,6 +634,8 @@ private:
   api::DurableObjectTransaction,                         \
   api::DurableObjectStorage,                             \
   api::DurableObjectStorage::TransactionOptions,         \
+  api::DurableObjectStorage::ListStreamIterator,         \
+  api::DurableObjectStorage::ListStreamIterator::Next,   \
   api::DurableObjectStorageOperations::ListOptions,      \
   api::DurableObjectStorageOperations::GetOptions,       \
   api::DurableObjectStorageOperations::GetAlarmOptions,  \
@@ -29,12 +29,14 @@ public:
         span.setTag("actor_id"_kjc, kj::str(actorId));
       }
 
-      // Lazily initialize actorChannel
+      // Lazily initialize actorChannel. The channel itself is cached per-request in the
+      // IoContext, so stubs created for the same actor share one resolved channel; the
+      // reference is kept here just to skip the lookup on subsequent requests on this stub.
       if (actorChannel == kj::none) {
         actorChannel = context.getColoLocalActorChannel(channelId, actorId, span);
       }
 
-      return KJ_REQUIRE_NONNULL(actorChannel)->startRequest({
+      return KJ_REQUIRE_NONNULL(actorChannel).startRequest({
         .cfBlobJson = kj::mv(cfStr),
         .parentSpan = span
       });
@@ -48,7 +50,7 @@ public:
 private:
   uint channelId;
   kj::String actorId;
-  kj::Maybe<kj::Own<IoChannelFactory::ActorChannel>> actorChannel;
+  kj::Maybe<IoChannelFactory::ActorChannel&> actorChannel;
 };
 
 class GlobalActorOutgoingFactory final: public Fetcher::OutgoingFactory {
@@ -72,13 +74,15 @@ public:
         span.setTag("actor_id"_kjc, id->toString());
       }
 
-      // Lazily initialize actorChannel
+      // Lazily initialize actorChannel. The channel itself is cached per-request in the
+      // IoContext, so stubs created for the same actor share one resolved channel; the
+      // reference is kept here just to skip the lookup on subsequent requests on this stub.
       if (actorChannel == kj::none) {
         actorChannel = context.getGlobalActorChannel(channelId, id->getInner(), kj::mv(locationHint),
             mode, span);
       }
 
-      return KJ_REQUIRE_NONNULL(actorChannel)->startRequest({
+      return KJ_REQUIRE_NONNULL(actorChannel).startRequest({
         .cfBlobJson = kj::mv(cfStr),
         .parentSpan = span
       });
@@ -94,7 +98,7 @@ private:
   jsg::Ref<DurableObjectId> id;
   kj::Maybe<kj::String> locationHint;
   ActorGetMode mode;
-  kj::Maybe<kj::Own<IoChannelFactory::ActorChannel>> actorChannel;
+  kj::Maybe<IoChannelFactory::ActorChannel&> actorChannel;
 };
 
 jsg::Ref<Fetcher> ColoLocalActorNamespace::get(kj::String actorId) {
@@ -348,30 +348,130 @@ bool EventTarget::dispatchEventImpl(jsg::Lock& js, jsg::Ref<Event> event) {
   // the callback can add or remove listeners without affecting the current event's processing.
 
   return js.withinHandleScope([&] {
-    struct Callback {
-      EventHandler::Handler handler;
-      bool once = false;
-      bool oldStyle = false;
+    // Invokes a single handler with the standard return-value handling. Shared between the
+    // single-listener fast path and the general snapshot loop below.
+    const auto invoke = [&](EventHandler::Handler& handler) {
+      KJ_SWITCH_ONEOF(handler) {
+        KJ_CASE_ONEOF(jsh, EventHandler::JavaScriptHandler) {
+          // Per the standard, the event listener is not supposed to return any value, and if it
+          // does, that value is ignored. That can be somewhat problematic if the user passes an
+          // async function as the event handler. Doing so counts as undefined behavior and can
+          // introduce subtle and difficult to diagnose bugs. Here, if the handler does return a
+          // value, we're going to emit a warning but otherwise ignore it. The warning will only
+          // be emitted at most once per EventEmitter instance.
+          auto ret = jsh.callback(js, event.addRef());
+          // Note: We used to run each handler in its own v8::TryCatch. However, due to a
+          //   misunderstanding of the V8 API, we incorrectly believed that TryCatch mishandled
+          //   termination (or maybe it actually did at the time), so we changed things such that
+          //   we don't catch exceptions so the first handler to throw an exception terminates the
+          //   loop, and the exception flows out of dispatchEvent(). In theory if multiple
+          //   handlers were registered then maybe we ought to be running all of them even if one
+          //   fails. This isn't entirely clear, though: in the case of 'fetch' handlers, in
+          //   fail-closed mode, an exception from any handler should make the whole request fail,
+          //   but then who cares if the remaining handlers run? Meanwhile, in fail-open mode, for
+          //   consistency, we should probably trigger fallback behavior if any handler throws, so
+          //   again it doesn't matter. For other types of handlers, e.g. WebSocket 'message', it's
+          //   not clear why one would ever register multiple handlers.
+          KJ_IF_SOME(r, ret) {
+            auto handle = r.getHandle(js);
+            // Returning true is the same as calling preventDefault() on the event.
+            if (handle->IsTrue()) {
+              event->preventDefault();
+            }
+            if (warnOnHandlerReturn && !handle->IsBoolean()) {
+              warnOnHandlerReturn = false;
+              // To help make debugging easier, let's tailor the warning a bit if it was a promise.
+              if (handle->IsPromise()) {
+                js.logWarning(
+                    kj::str("An event handler returned a promise that will be ignored. Event handlers "
+                            "should not have a return value and should not be async functions."));
+              } else {
+                js.logWarning(
+                    kj::str("An event handler returned a value of type \"",
+                            handle->TypeOf(js.v8Isolate),
+                            "\" that will be ignored. Event handlers should not have a return value."));
+              }
+            }
+          }
+        }
+        KJ_CASE_ONEOF(native, EventHandler::NativeHandlerRef) {
+          native.handler(js, event.addRef());
+        }
+      }
     };
 
-    kj::Vector<Callback> callbacks;
-
     // Check if there is an `on<event>` property on this object. If so, we treat that as an event
     // handler, in addition to the ones registered with addEventListener().
+    kj::Maybe<HandlerFunction> maybeOnProp;
     KJ_IF_SOME(onProp, onEvents.get(js, kj::str("on", event->getType()))) {
       // If the on-event is not a function, we silently ignore it rather than raise an error.
       KJ_IF_SOME(cb, onProp.tryGet<HandlerFunction>()) {
-        callbacks.add(Callback {
-          .handler = EventHandler::JavaScriptHandler {
-            .identity = nullptr,  // won't be used below if oldStyle is true and once is false
-            .callback = kj::mv(cb),
-          },
-          .oldStyle = true,
-        });
+        maybeOnProp = kj::mv(cb);
       }
     }
 
     auto maybeHandlerSet = typeMap.find(event->getType());
+
+    // Fast path: nearly all runtime events (fetch, message, close) have exactly one registered
+    // listener and no on-property handler. Invoke it directly rather than snapshotting the
+    // handler list; with a single listener there is no later entry that could observe a
+    // mid-dispatch mutation, so the snapshot's bookkeeping buys nothing.
+    if (maybeOnProp == kj::none) {
+      KJ_IF_SOME(handlerSet, maybeHandlerSet) {
+        if (handlerSet.handlers.size() == 1 && !event->isStopped()) {
+          auto& handler = *handlerSet.handlers.ordered<kj::InsertionOrderIndex>().begin();
+
+          // Take our own references (and honor `once` by unregistering first) before invoking,
+          // since the callback may remove the listener out from under us.
+          EventHandler::Handler copy = [&]() -> EventHandler::Handler {
+            KJ_SWITCH_ONEOF(handler->handler) {
+              KJ_CASE_ONEOF(jsh, EventHandler::JavaScriptHandler) {
+                return EventHandler::JavaScriptHandler {
+                  .identity = jsh.identity.addRef(js),
+                  .callback = jsh.callback.addRef(js),
+                };
+              }
+              KJ_CASE_ONEOF(native, EventHandler::NativeHandlerRef) {
+                return EventHandler::NativeHandlerRef { .handler = native.handler };
+              }
+            }
+            KJ_UNREACHABLE;
+          }();
+
+          if (handler->once) {
+            KJ_IF_SOME(jsh, copy.tryGet<EventHandler::JavaScriptHandler>()) {
+              removeEventListener(js, kj::str(event->getType()), jsh.identity.addRef(js),
+                                  kj::none);
+            }
+            // A native once-handler detaches itself when invoked.
+          }
+
+          invoke(copy);
+          return !event->isPreventDefault();
+        }
+      } else {
+        // No listeners registered for this event at all.
+        return !event->isPreventDefault();
+      }
+    }
+
+    struct Callback {
+      EventHandler::Handler handler;
+      bool once = false;
+      bool oldStyle = false;
+    };
+
+    kj::Vector<Callback> callbacks;
+
+    KJ_IF_SOME(cb, maybeOnProp) {
+      callbacks.add(Callback {
+        .handler = EventHandler::JavaScriptHandler {
+          .identity = nullptr,  // won't be used below if oldStyle is true and once is false
+          .callback = kj::mv(cb),
+        },
+        .oldStyle = true,
+      });
+    }
     KJ_IF_SOME(handlerSet, maybeHandlerSet) {
       for (auto& handler: handlerSet.handlers.ordered<kj::InsertionOrderIndex>()) {
         KJ_SWITCH_ONEOF(handler->handler) {
@@ -437,53 +537,7 @@ bool EventTarget::dispatchEventImpl(jsg::Lock& js, jsg::Ref<Event> event) {
         }
       }
 
-      KJ_SWITCH_ONEOF(callback.handler) {
-        KJ_CASE_ONEOF(jsh, EventHandler::JavaScriptHandler) {
-          // Per the standard, the event listener is not supposed to return any value, and if it
-          // does, that value is ignored. That can be somewhat problematic if the user passes an
-          // async function as the event handler. Doing so counts as undefined behavior and can
-          // introduce subtle and difficult to diagnose bugs. Here, if the handler does return a
-          // value, we're going to emit a warning but otherwise ignore it. The warning will only
-          // be emitted at most once per EventEmitter instance.
-          auto ret = jsh.callback(js, event.addRef());
-          // Note: We used to run each handler in its own v8::TryCatch. However, due to a
-          //   misunderstanding of the V8 API, we incorrectly believed that TryCatch mishandled
-          //   termination (or maybe it actually did at the time), so we changed things such that
-          //   we don't catch exceptions so the first handler to throw an exception terminates the
-          //   loop, and the exception flows out of dispatchEvent(). In theory if multiple
-          //   handlers were registered then maybe we ought to be running all of them even if one
-          //   fails. This isn't entirely clear, though: in the case of 'fetch' handlers, in
-          //   fail-closed mode, an exception from any handler should make the whole request fail,
-          //   but then who cares if the remaining handlers run? Meanwhile, in fail-open mode, for
-          //   consistency, we should probably trigger fallback behavior if any handler throws, so
-          //   again it doesn't matter. For other types of handlers, e.g. WebSocket 'message', it's
-          //   not clear why one would ever register multiple handlers.
-          KJ_IF_SOME(r, ret) {
-            auto handle = r.getHandle(js);
-            // Returning true is the same as calling preventDefault() on the event.
-            if (handle->IsTrue()) {
-              event->preventDefault();
-            }
-            if (warnOnHandlerReturn && !handle->IsBoolean()) {
-              warnOnHandlerReturn = false;
-              // To help make debugging easier, let's tailor the warning a bit if it was a promise.
-              if (handle->IsPromise()) {
-                js.logWarning(
-                    kj::str("An event handler returned a promise that will be ignored. Event handlers "
-                            "should not have a return value and should not be async functions."));
-              } else {
-                js.logWarning(
-                    kj::str("An event handler returned a value of type \"",
-                            handle->TypeOf(js.v8Isolate),
-                            "\" that will be ignored. Event handlers should not have a return value."));
-              }
-            }
-          }
-        }
-        KJ_CASE_ONEOF(native, EventHandler::NativeHandlerRef) {
-          native.handler(js, event.addRef());
-        }
-      }
+      invoke(callback.handler);
     }
 
     return !event->isPreventDefault();
@@ -497,8 +551,7 @@ bool EventTarget::dispatchEvent(jsg::Lock& js, jsg::Ref<Event> event) {
 AbortSignal::AbortSignal(kj::Maybe<kj::Exception> exception,
                          jsg::Optional<jsg::JsRef<jsg::JsValue>> maybeReason,
                          Flag flag) :
-    canceler(IoContext::current().addObject(
-        kj::refcounted<RefcountedCanceler>(kj::cp(exception)))),
+    maybeException(kj::mv(exception)),
     flag(flag),
     reason(kj::mv(maybeReason)) {}
 
@@ -564,7 +617,7 @@ jsg::Ref<AbortSignal> AbortSignal::abort(
 }
 
 void AbortSignal::throwIfAborted(jsg::Lock& js) {
-  if (canceler->isCanceled()) {
+  if (maybeException != kj::none) {
     KJ_IF_SOME(r, reason) {
       js.throwException(r.getHandle(js));
     } else {
@@ -613,6 +666,18 @@ jsg::Ref<AbortSignal> AbortSignal::any(
   // Otherwise we need to create a new signal and register event handlers on all
   // of the signals that were passed in.
   auto signal = jsg::alloc<AbortSignal>();
+
+  if (signals.size() == 1) {
+    // With a single source there's no need for a separate canceler. Sharing the source's
+    // canceler means promises wrapped by the derived signal are canceled directly when the
+    // source aborts, rather than through a chain of per-signal cancelers -- chains of
+    // AbortSignal.any() derivations all flatten onto the root's canceler. The event
+    // listener registered below still propagates the reason and fires this signal's own
+    // abort event.
+    signal->maybeCanceler = IoContext::current().addObject(
+        kj::addRef(signals[0]->getCanceler()));
+  }
+
   for (auto& sig : signals) {
     // This is a bit of a hack. We want to call addEventListener, but that requires a
     // jsg::Identified<EventTarget::Handler>, which we can't create directly yet.
@@ -649,14 +714,23 @@ void AbortSignal::visitForGc(jsg::GcVisitor& visitor) {
 }
 
 RefcountedCanceler& AbortSignal::getCanceler() {
-  return *canceler;
+  KJ_IF_SOME(c, maybeCanceler) {
+    return *c;
+  }
+  // Allocated on first use. If the signal was already aborted, the canceler starts out in
+  // the canceled state so anything wrapped with it is rejected immediately.
+  auto canceler = IoContext::current().addObject(
+      kj::refcounted<RefcountedCanceler>(kj::cp(maybeException)));
+  auto& ref = *canceler;
+  maybeCanceler = kj::mv(canceler);
+  return ref;
 }
 
 void AbortSignal::triggerAbort(
     jsg::Lock& js,
     jsg::Optional<kj::OneOf<kj::Exception, jsg::JsValue>> maybeReason) {
   KJ_ASSERT(flag != Flag::NEVER_ABORTS);
-  if (canceler->isCanceled()) {
+  if (maybeException != kj::none) {
     return;
   }
   auto exception = AbortSignal::abortException(js, maybeReason);
@@ -670,9 +744,12 @@ void AbortSignal::triggerAbort(
       }
     }
   } else {
-    reason = js.exceptionToJsValue(kj::mv(exception));
+    reason = js.exceptionToJsValue(kj::cp(exception));
+  }
+  KJ_IF_SOME(c, maybeCanceler) {
+    c->cancel(kj::cp(exception));
   }
-  canceler->cancel(kj::cp(exception));
+  maybeException = kj::mv(exception);
 
   // This is questionable only because it goes against the spec but it does help prevent
   // memory leaks. Once the abort signal has been triggered, there's really nothing else
@@ -465,7 +465,7 @@ public:
   // illegal for user code to create an AbortSignal directly.
   static jsg::Ref<AbortSignal> constructor() = delete;
 
-  bool getAborted() { return canceler->isCanceled(); }
+  bool getAborted() { return maybeException != kj::none; }
 
   jsg::JsValue getReason(jsg::Lock& js);
 
@@ -519,8 +519,9 @@ public:
   // Allows this AbortSignal to also serve as a kj::Canceler
   template <typename T>
   kj::Promise<T> wrap(kj::Promise<T> promise) {
-    JSG_REQUIRE(!canceler->isCanceled(), TypeError, "The AbortSignal has already been triggered");
-    return canceler->wrap(kj::mv(promise));
+    JSG_REQUIRE(maybeException == kj::none, TypeError,
+        "The AbortSignal has already been triggered");
+    return getCanceler().wrap(kj::mv(promise));
   }
 
   template <typename T>
@@ -548,7 +549,17 @@ public:
   }
 
 private:
-  IoOwn<RefcountedCanceler> canceler;
+  // If the signal has been aborted, the exception representing the abort reason. This doubles
+  // as the aborted flag.
+  kj::Maybe<kj::Exception> maybeException;
+
+  // The canceler is allocated lazily, the first time something actually needs it -- that is,
+  // when a promise is wrapped or when the fetch machinery asks for it via getCanceler(). The
+  // vast majority of signals (every Request carries one) never abort and never wrap anything,
+  // so they never pay for the canceler at all. Signals derived from a single source (e.g.
+  // AbortSignal.any() with one input) share the source's canceler rather than allocating
+  // their own.
+  kj::Maybe<IoOwn<RefcountedCanceler>> maybeCanceler;
   Flag flag;
   kj::Maybe<jsg::JsRef<jsg::JsValue>> reason;
   kj::Maybe<jsg::JsRef<jsg::JsValue>> onAbortHandler;
@@ -11,16 +11,21 @@
 namespace workerd::api {
 
 namespace {
-// Concatenate an array of segments (parameter to Blob constructor).
-kj::Array<byte> concat(jsg::Lock& js, jsg::Optional<Blob::Bits> maybeBits) {
-  // TODO(perf): Make it so that a Blob can keep references to the input data rather than copy it.
-  //   Note that we can't keep references to ArrayBuffers since they are mutable, but we can
-  //   reference other Blobs in the input.
-
+// Build the data backing a new Blob from an array of segments (parameter to Blob
+// constructor). If the segments reduce to a single Blob, returns a reference to
+// that Blob so the new one can be created as a zero-copy view of it. Otherwise
+// the segments are concatenated directly into a single BufferSource.
+//
+// Note that we can't keep references to ArrayBuffer segments since they are
+// mutable, so those are always copied.
+kj::OneOf<jsg::BufferSource, jsg::Ref<Blob>> buildData(
+    jsg::Lock& js, jsg::Optional<Blob::Bits> maybeBits) {
   auto bits = kj::mv(maybeBits).orDefault(nullptr);
 
   auto maxBlobSize = Worker::Isolate::from(js).getLimitEnforcer().getBlobSizeLimit();
   size_t size = 0;
+  size_t nonEmptyParts = 0;
+  kj::Maybe<jsg::Ref<Blob>&> soleBlob;
   for (auto& part: bits) {
     size_t partSize = 0;
     KJ_SWITCH_ONEOF(part) {
@@ -32,11 +37,17 @@ kj::Array<byte> concat(jsg::Lock& js, jsg::Optional<Blob::Bits> maybeBits) {
       }
       KJ_CASE_ONEOF(blob, jsg::Ref<Blob>) {
         partSize = blob->getData().size();
+        if (partSize > 0 && nonEmptyParts == 0) {
+          soleBlob = blob;
+        }
       }
     }
 
     // We can skip the remaining checks if the part is empty.
     if (partSize == 0) continue;
+    if (++nonEmptyParts > 1) {
+      soleBlob = kj::none;
+    }
 
     // While overflow is *extremely* unlikely to ever be a problem here, let's
     // be extra cautious and check for it anyway.
@@ -61,10 +72,18 @@ kj::Array<byte> concat(jsg::Lock& js, jsg::Optional<Blob::Bits> maybeBits) {
     size += partSize;
   }
 
-  if (size == 0) return nullptr;
+  KJ_IF_SOME(blob, soleBlob) {
+    // The segments reduce to a single Blob; the caller can create a zero-copy
+    // view of it. Blobs are immutable, so sharing the bytes is safe.
+    return blob.addRef();
+  }
 
-  auto result = kj::heapArray<byte>(size);
-  auto view = result.asPtr();
+  // Copy the segments directly into the BufferSource that will back the new
+  // Blob, rather than into an intermediate array that would have to be copied
+  // into a BufferSource again.
+  auto result = JSG_REQUIRE_NONNULL(jsg::BufferSource::tryAlloc(js, size),
+      Error, "Unable to allocate space for Blob data");
+  auto view = result.asArrayPtr();
 
   for (auto& part: bits) {
     KJ_SWITCH_ONEOF(part) {
@@ -93,7 +112,7 @@ kj::Array<byte> concat(jsg::Lock& js, jsg::Optional<Blob::Bits> maybeBits) {
 
   KJ_ASSERT(view == nullptr);
 
-  return result;
+  return kj::mv(result);
 }
 
 kj::String normalizeType(kj::String type) {
@@ -138,15 +157,24 @@ kj::ArrayPtr<const kj::byte> getPtr(jsg::BufferSource& source) {
 Blob::Blob(kj::Array<byte> data, kj::String type)
     : ownData(kj::mv(data)),
       data(ownData.get<kj::Array<kj::byte>>()),
-      type(kj::mv(type)) {}
+      type(kj::mv(type)),
+      accounting(jsg::MemoryCategory::BLOBS, this->data.size()) {}
 
 Blob::Blob(jsg::Lock& js, kj::Array<byte> data, kj::String type)
     : ownData(wrap(js, kj::mv(data))),
       data(getPtr(ownData.get<jsg::BufferSource>())),
-      type(kj::mv(type)) {}
+      type(kj::mv(type)),
+      accounting(jsg::MemoryCategory::BLOBS, this->data.size()) {}
+
+Blob::Blob(jsg::BufferSource data, kj::String type)
+    : ownData(kj::mv(data)),
+      data(getPtr(ownData.get<jsg::BufferSource>())),
+      type(kj::mv(type)),
+      accounting(jsg::MemoryCategory::BLOBS, this->data.size()) {}
 
 Blob::Blob(jsg::Ref<Blob> parent, kj::ArrayPtr<const byte> data, kj::String type)
-      : ownData(kj::mv(parent)), data(data), type(kj::mv(type)) {}
+      : ownData(kj::mv(parent)), data(data), type(kj::mv(type)),
+        accounting(jsg::MemoryCategory::BLOBS) {}
 
 jsg::Ref<Blob> Blob::constructor(jsg::Lock& js,
                                  jsg::Optional<Bits> bits,
@@ -158,7 +186,17 @@ jsg::Ref<Blob> Blob::constructor(jsg::Lock& js,
     }
   }
 
-  return jsg::alloc<Blob>(js, concat(js, kj::mv(bits)), kj::mv(type));
+  auto built = buildData(js, kj::mv(bits));
+  KJ_SWITCH_ONEOF(built) {
+    KJ_CASE_ONEOF(buffer, jsg::BufferSource) {
+      return jsg::alloc<Blob>(kj::mv(buffer), kj::mv(type));
+    }
+    KJ_CASE_ONEOF(blob, jsg::Ref<Blob>) {
+      auto data = blob->getData();
+      return jsg::alloc<Blob>(kj::mv(blob), data, kj::mv(type));
+    }
+  }
+  KJ_UNREACHABLE;
 }
 
 kj::ArrayPtr<const byte> Blob::getData() const {
@@ -286,6 +324,10 @@ File::File(jsg::Lock& js, kj::Array<byte> data, kj::String name, kj::String type
     : Blob(js, kj::mv(data), kj::mv(type)),
       name(kj::mv(name)), lastModified(lastModified) {}
 
+File::File(jsg::BufferSource data, kj::String name, kj::String type, double lastModified)
+    : Blob(kj::mv(data), kj::mv(type)),
+      name(kj::mv(name)), lastModified(lastModified) {}
+
 File::File(jsg::Ref<Blob> parent, kj::ArrayPtr<const byte> data,
            kj::String name, kj::String type, double lastModified)
     : Blob(kj::mv(parent), data, kj::mv(type)),
@@ -309,7 +351,17 @@ jsg::Ref<File> File::constructor(jsg::Lock& js, jsg::Optional<Bits> bits,
     lastModified = dateNow();
   }
 
-  return jsg::alloc<File>(js, concat(js, kj::mv(bits)), kj::mv(name), kj::mv(type), lastModified);
+  auto built = buildData(js, kj::mv(bits));
+  KJ_SWITCH_ONEOF(built) {
+    KJ_CASE_ONEOF(buffer, jsg::BufferSource) {
+      return jsg::alloc<File>(kj::mv(buffer), kj::mv(name), kj::mv(type), lastModified);
+    }
+    KJ_CASE_ONEOF(blob, jsg::Ref<Blob>) {
+      auto data = blob->getData();
+      return jsg::alloc<File>(kj::mv(blob), data, kj::mv(name), kj::mv(type), lastModified);
+    }
+  }
+  KJ_UNREACHABLE;
 }
 
 }  // namespace workerd::api
@@ -15,6 +15,7 @@ class ReadableStream;
 class Blob: public jsg::Object {
 public:
   Blob(jsg::Lock& js, kj::Array<byte> data, kj::String type);
+  Blob(jsg::BufferSource data, kj::String type);
   Blob(jsg::Ref<Blob> parent, kj::ArrayPtr<const byte> data, kj::String type);
 
   kj::ArrayPtr<const byte> getData() const KJ_LIFETIMEBOUND;
@@ -92,6 +93,10 @@ private:
   kj::ArrayPtr<const byte> data;
   kj::String type;
 
+  // Counts this blob (and the bytes it owns directly; slices referencing a parent count
+  // only the instance) toward the isolate's per-category memory accounting.
+  jsg::MemoryAccountingToken accounting;
+
   void visitForGc(jsg::GcVisitor& visitor) {
     KJ_SWITCH_ONEOF(ownData) {
       KJ_CASE_ONEOF(b, jsg::BufferSource) {
@@ -116,6 +121,7 @@ public:
   // JavaScript (such as in the internal fiddle service).
   File(kj::Array<byte> data, kj::String name, kj::String type, double lastModified);
   File(jsg::Lock& js, kj::Array<byte> data, kj::String name, kj::String type, double lastModified);
+  File(jsg::BufferSource data, kj::String name, kj::String type, double lastModified);
   File(jsg::Ref<Blob> parent, kj::ArrayPtr<const byte> data,
        kj::String name, kj::String type, double lastModified);
 
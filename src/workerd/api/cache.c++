@@ -6,6 +6,7 @@
 #include "util.h"
 #include <kj/encoding.h>
 #include <workerd/io/io-context.h>
+#include <workerd/io/limit-enforcer.h>
 
 namespace workerd::api {
 
@@ -86,54 +87,121 @@ jsg::Promise<jsg::Optional<jsg::Ref<Response>>> Cache::match(
       return js.resolvedPromise(jsg::Optional<jsg::Ref<Response>>());
     }
 
-    auto httpClient = getHttpClient(context, jsRequest->serializeCfBlobJson(js),
-                                    "cache_match"_kjc);
+    auto cfBlobJson = jsRequest->serializeCfBlobJson(js);
+
     auto requestHeaders = kj::HttpHeaders(context.getHeaderTable());
     jsRequest->shallowCopyHeadersTo(requestHeaders);
     requestHeaders.set(context.getHeaderIds().cacheControl, "only-if-cached");
-    auto nativeRequest = httpClient->request(
-        kj::HttpMethod::GET, validateUrl(jsRequest->getUrl()), requestHeaders, uint64_t(0));
 
-    return context.awaitIo(js, kj::mv(nativeRequest.response),
-        [httpClient = kj::mv(httpClient), &context]
-        (jsg::Lock& js, kj::HttpClient::Response&& response)
-        mutable -> jsg::Optional<jsg::Ref<Response>> {
-      response.body = response.body.attach(kj::mv(httpClient));
-
-      kj::StringPtr cacheStatus;
-      KJ_IF_SOME(cs, response.headers->get(context.getHeaderIds().cfCacheStatus)) {
-        cacheStatus = cs;
-      } else {
-        // This is an internal error representing a violation of the contract between us and
-        // the cache. Since it is always conformant to return undefined from Cache::match()
-        // (because we are allowed to evict any asset at any time), we don't really need to make the
-        // script fail. However, it might be indicative of a larger problem, and should be
-        // investigated.
-        LOG_CACHE_ERROR_ONCE("Response to Cache API GET has no CF-Cache-Status: ", response);
-        return kj::none;
-      }
+    auto url = validateUrl(jsRequest->getUrl());
 
-      // The status code should be a 504 on cache miss, but we need to rely on CF-Cache-Status
-      // because someone might cache a 504.
-      // See https://httpwg.org/specs/rfc7234.html#cache-request-directive.only-if-cached
-      //
-      // TODO(cleanup): CACHE-5949 We should never receive EXPIRED or UPDATING responses, but we do.
-      //   We treat them the same as a MISS mostly to keep from blowing up our Sentry reports.
-      // TODO(someday): If the cache status is EXPIRED and we return undefined here, does a PURGE on
-      //   this URL result in a 200, causing us to return true from Cache::delete_()? If so, that's
-      //   a small inconsistency: we shouldn't have a match failure but a delete success.
-      if (cacheStatus == "MISS" || cacheStatus == "EXPIRED" || cacheStatus == "UPDATING") {
-        return kj::none;
-      } else if (cacheStatus != "HIT") {
-        // Another internal error. See above comment where we retrieve the CF-Cache-Status header.
-        LOG_CACHE_ERROR_ONCE("Response to Cache API GET has invalid CF-Cache-Status: ", response);
-        return kj::none;
+    // Coalescing key: the serialized request head plus the cf blob, i.e. everything that can
+    // influence what the cache service returns for this lookup.
+    auto key = kj::str(requestHeaders.serializeRequest(kj::HttpMethod::GET, url),
+                       cfBlobJson.orDefault(nullptr));
+
+    auto lookup = [&]() -> kj::Promise<kj::Own<CoalescedMatch>> {
+      KJ_IF_SOME(entry, matchCoalescer->inFlight.find(key)) {
+        // Another match() for the same key is already in flight. Piggyback on it rather than
+        // send a duplicate lookup to the cache service -- but only if it belongs to the same
+        // request, since its response body is owned by that request's IoContext.
+        if (entry.context == &context) {
+          return entry.promise.addBranch();
+        }
       }
 
-      return makeHttpResponse(
-          js, kj::HttpMethod::GET, {},
-          response.statusCode, response.statusText, *response.headers,
-          kj::mv(response.body), kj::none);
+      auto httpClient = getHttpClient(context, kj::mv(cfBlobJson), "cache_match"_kjc);
+      auto nativeRequest = httpClient->request(
+          kj::HttpMethod::GET, url, requestHeaders, uint64_t(0));
+
+      auto forked = nativeRequest.response.then(
+          [httpClient = kj::mv(httpClient), &context]
+          (kj::HttpClient::Response&& response) mutable -> kj::Own<CoalescedMatch> {
+        auto shared = kj::refcounted<CoalescedMatch>();
+        response.body = response.body.attach(kj::mv(httpClient));
+
+        kj::StringPtr cacheStatus;
+        KJ_IF_SOME(cs, response.headers->get(context.getHeaderIds().cfCacheStatus)) {
+          cacheStatus = cs;
+        } else {
+          // This is an internal error representing a violation of the contract between us and
+          // the cache. Since it is always conformant to return undefined from Cache::match()
+          // (because we are allowed to evict any asset at any time), we don't really need to make
+          // the script fail. However, it might be indicative of a larger problem, and should be
+          // investigated.
+          LOG_CACHE_ERROR_ONCE("Response to Cache API GET has no CF-Cache-Status: ", response);
+          return shared;
+        }
+
+        // The status code should be a 504 on cache miss, but we need to rely on CF-Cache-Status
+        // because someone might cache a 504.
+        // See https://httpwg.org/specs/rfc7234.html#cache-request-directive.only-if-cached
+        //
+        // TODO(cleanup): CACHE-5949 We should never receive EXPIRED or UPDATING responses, but we
+        //   do. We treat them the same as a MISS mostly to keep from blowing up our Sentry reports.
+        // TODO(someday): If the cache status is EXPIRED and we return undefined here, does a PURGE
+        //   on this URL result in a 200, causing us to return true from Cache::delete_()? If so,
+        //   that's a small inconsistency: we shouldn't have a match failure but a delete success.
+        if (cacheStatus == "MISS" || cacheStatus == "EXPIRED" || cacheStatus == "UPDATING") {
+          return shared;
+        } else if (cacheStatus != "HIT") {
+          // Another internal error. See above comment where we retrieve the CF-Cache-Status header.
+          LOG_CACHE_ERROR_ONCE("Response to Cache API GET has invalid CF-Cache-Status: ", response);
+          return shared;
+        }
+
+        shared->hit = CoalescedMatch::Hit {
+          .statusCode = response.statusCode,
+          .statusText = kj::str(response.statusText),
+          .headers = response.headers->clone(),
+          .body = kj::mv(response.body),
+        };
+        return shared;
+      }).fork();
+
+      auto id = matchCoalescer->nextId++;
+      auto branch = forked.addBranch();
+
+      // Publish the lookup for later match() calls to join. upsert() rather than insert()
+      // because a different request may have published an entry under the same key; replacing
+      // it is harmless since its waiters each hold their own branch already.
+      matchCoalescer->inFlight.upsert(kj::str(key),
+          MatchCoalescer::Entry { id, &context, kj::mv(forked) },
+          [](MatchCoalescer::Entry& existing, MatchCoalescer::Entry&& replacement) {
+        existing = kj::mv(replacement);
+      });
+
+      // Un-publish the entry once this (leader) branch is done with it, whether because the
+      // lookup completed or because the waiting request was canceled. The id check makes sure
+      // we don't erase a newer entry that reused our key.
+      auto eraser = kj::defer(
+          [coalescer = kj::addRef(*matchCoalescer), key = kj::str(key), id]() {
+        KJ_IF_SOME(entry, coalescer->inFlight.find(key)) {
+          if (entry.id == id) {
+            coalescer->inFlight.erase(key);
+          }
+        }
+      });
+
+      return branch.attach(kj::mv(eraser));
+    }();
+
+    return context.awaitIo(js, kj::mv(lookup),
+        [&context](jsg::Lock& js, kj::Own<CoalescedMatch> shared)
+            -> jsg::Optional<jsg::Ref<Response>> {
+      KJ_IF_SOME(hit, shared->hit) {
+        // Split our response body branch off of the shared lookup, leaving a reserve branch
+        // behind for any other waiters. The reserve branch (and whatever the tee buffered for
+        // it) is dropped along with the last reference to `shared`.
+        auto tee = kj::newTee(kj::mv(hit.body), context.getLimitEnforcer().getBufferingLimit());
+        hit.body = kj::mv(tee.branches[1]);
+
+        return makeHttpResponse(
+            js, kj::HttpMethod::GET, {},
+            hit.statusCode, hit.statusText, hit.headers,
+            newTeeErrorAdapter(kj::mv(tee.branches[0])), kj::none);
+      }
+      return kj::none;
     });
   });
 }
@@ -280,6 +348,11 @@ jsg::Promise<void> Cache::put(jsg::Lock& js, Request::Info requestOrUrl,
     // We need to send the response to our serializer immediately in order to fulfill Cache.put()'s
     // contract: the caller should be able to observe that the response body is disturbed as soon
     // as put() returns.
+    //
+    // Note that this does NOT buffer the response: the serializer hands back the input end of an
+    // unbuffered pipe, and body chunks flow through it to the cache endpoint as they arrive from
+    // the origin (see the pump below). Memory use is bounded by the pipe's in-flight chunk
+    // regardless of response size.
     auto serializePromise = jsResponse->send(js, serializer, {}, kj::none);
     auto payload = serializer.getPayload();
 
@@ -6,7 +6,9 @@
 
 #include <workerd/jsg/jsg.h>
 #include "http.h"
+#include <kj/map.h>
 
+namespace workerd { class IoContext; }
 namespace workerd::api {
 
 // =======================================================================================
@@ -81,6 +83,47 @@ public:
 private:
   kj::Maybe<kj::String> cacheName;
 
+  // Result of a cache lookup that may be shared by several concurrent match() calls.
+  // Refcounted so that each waiter can hold it just long enough to split off its own branch
+  // of the response body.
+  struct CoalescedMatch: public kj::Refcounted {
+    struct Hit {
+      uint statusCode;
+      kj::String statusText;
+      kj::HttpHeaders headers;
+
+      // The not-yet-claimed copy of the response body. Each consumer tees this into the
+      // branch it hands to JavaScript plus a replacement reserve branch; whatever remains is
+      // dropped once the last consumer has claimed its branch.
+      kj::Own<kj::AsyncInputStream> body;
+    };
+
+    // kj::none indicates a cache miss (or a malformed response, which we treat as a miss).
+    kj::Maybe<Hit> hit;
+  };
+
+  // Tracks in-flight match() lookups so that concurrent lookups for the same key share one
+  // subrequest to the cache service. Refcounted because the cleanup objects attached to the
+  // lookup promises may outlive the Cache itself if it is GC'd while a request is in flight.
+  struct MatchCoalescer: public kj::Refcounted {
+    struct Entry {
+      // Distinguishes this entry from a later one reusing the same key, so that a stale
+      // cleanup object doesn't erase a newer entry.
+      uint64_t id;
+
+      // Only match() calls from the same request may share a lookup: the HTTP client and
+      // response body backing it are owned by that request's IoContext.
+      IoContext* context;
+
+      kj::ForkedPromise<kj::Own<CoalescedMatch>> promise;
+    };
+
+    uint64_t nextId = 0;
+    kj::HashMap<kj::String, Entry> inFlight;
+  };
+
+  kj::Own<MatchCoalescer> matchCoalescer = kj::refcounted<MatchCoalescer>();
+
   kj::Own<kj::HttpClient> getHttpClient(IoContext& context,
       kj::Maybe<kj::String> cfBlobJson, kj::ConstString operationName);
 };
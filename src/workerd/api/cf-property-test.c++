@@ -44,5 +44,29 @@ KJ_TEST("Test that CfProperty::deepClone returns editable object") {
   KJ_EXPECT(result.statusCode == 200);
 }
 
+KJ_TEST("Test that repeated cf blobs reuse the per-isolate parse cache") {
+  TestFixture fixture({
+    .mainModuleSource = R"SCRIPT(
+      export default {
+        async fetch(request) {
+          if (!Object.isFrozen(request.cf)) {
+            throw new Error('cf is not frozen');
+          }
+          if (request.cf.botManagement.score !== 99) {
+            throw new Error('unexpected cf contents');
+          }
+          return new Response(`OK`);
+        },
+      };
+    )SCRIPT"_kj});
+
+  // Both requests carry byte-identical cf blobs, so the second one is served from the
+  // per-isolate parse cache. It must still observe the same frozen contents.
+  for (auto i: kj::zeroTo(2)) {
+    auto result = fixture.runRequest(kj::HttpMethod::POST, "http://www.example.com"_kj, "TEST"_kj);
+    KJ_EXPECT(result.statusCode == 200, i);
+  }
+}
+
 }  // namespace
 }  // namespace workerd::api
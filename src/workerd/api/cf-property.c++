@@ -38,6 +38,49 @@ static void handleDefaultBotManagement(jsg::Lock& js, jsg::JsObject handle) {
   }
 }
 
+// Parses and deep-freezes a cf blob, memoizing the result per isolate keyed by the raw JSON
+// text. The bulk of the blob (colo, country, and similar tables) is invariant across the
+// requests a given node serves, so byte-identical blobs repeat constantly; serving a repeat
+// from the cache skips both the JSON parse and the recursive freeze. Sharing the resulting
+// object between requests is safe precisely because it is deeply frozen (the same trick the
+// default botManagement value above relies on). The cache is cleared once it grows past a
+// small bound so that pathological blob churn cannot retain unbounded memory.
+static jsg::JsObject parseAndFreezeCfBlob(jsg::Lock& js, kj::StringPtr unparsed) {
+  static constexpr auto cacheName = "cfBlobCache"_kjc;
+  static constexpr size_t kMaxCachedBlobs = 64;
+
+  auto maybeCache = js.global().getPrivate(js, cacheName).tryCast<jsg::JsMap>();
+
+  KJ_IF_SOME(cache, maybeCache) {
+    KJ_IF_SOME(object, cache.get(js, unparsed).tryCast<jsg::JsObject>()) {
+      return object;
+    }
+  }
+
+  auto parsed = jsg::JsValue::fromJson(js, unparsed);
+  auto object = KJ_ASSERT_NONNULL(parsed.tryCast<jsg::JsObject>());
+
+  if (!FeatureFlags::get(js).getNoCfBotManagementDefault()) {
+    handleDefaultBotManagement(js, object);
+  }
+
+  object.recursivelyFreeze(js);
+
+  KJ_IF_SOME(cache, maybeCache) {
+    v8::Local<v8::Map> handle = cache;
+    if (handle->Size() >= kMaxCachedBlobs) {
+      handle->Clear();
+    }
+    cache.set(js, unparsed, object);
+  } else {
+    auto cache = js.map();
+    cache.set(js, unparsed, object);
+    js.global().setPrivate(js, cacheName, cache);
+  }
+
+  return object;
+}
+
 CfProperty::CfProperty(kj::Maybe<kj::StringPtr> unparsed) {
   KJ_IF_SOME(str, unparsed) {
     value = kj::str(str);
@@ -66,14 +109,7 @@ jsg::Optional<jsg::JsRef<jsg::JsObject>> CfProperty::getRef(jsg::Lock& js) {
         return parsed.addRef(js);
       }
       KJ_CASE_ONEOF(unparsed, kj::String) {
-        auto parsed = jsg::JsValue::fromJson(js, unparsed);
-        auto object = KJ_ASSERT_NONNULL(parsed.tryCast<jsg::JsObject>());
-
-        if (!FeatureFlags::get(js).getNoCfBotManagementDefault()) {
-          handleDefaultBotManagement(js, object);
-        }
-
-        object.recursivelyFreeze(js);
+        auto object = parseAndFreezeCfBlob(js, unparsed);
 
         // replace unparsed string with a parsed v8 object
         this->value = object.addRef(js);
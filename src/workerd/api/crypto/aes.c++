@@ -166,6 +166,67 @@ protected:
   CryptoKey::AesKeyAlgorithm keyAlgorithm;
 };
 
+// A WritableStreamSink that encrypts each chunk written to it through a persistent AES-GCM
+// cipher context and forwards the ciphertext to an inner sink, appending the authentication
+// tag when the stream ends. AES-GCM behaves like a stream cipher (no padding, partial blocks
+// OK), so each chunk produces exactly as many ciphertext bytes as plaintext bytes and the
+// output can be emitted as it is produced. Keeping one context across chunks lets OpenSSL's
+// AES-NI pipeline run continuously rather than paying per-call setup for every chunk.
+class AesGcmEncryptSink final: public WritableStreamSink {
+public:
+  explicit AesGcmEncryptSink(kj::Own<EVP_CIPHER_CTX> cipherCtx, size_t tagByteSize,
+                             kj::Own<WritableStreamSink> inner)
+      : cipherCtx(kj::mv(cipherCtx)), tagByteSize(tagByteSize), inner(kj::mv(inner)) {}
+
+  kj::Promise<void> write(kj::ArrayPtr<const kj::byte> buffer) override {
+    if (buffer.size() == 0) return kj::READY_NOW;
+
+    // Same limit as one-shot encrypt(), applied to the stream's running total:
+    // https://w3c.github.io/webcrypto/Overview.html#aes-gcm-operations
+    plainTextSize += buffer.size();
+    JSG_REQUIRE(plainTextSize <= ((UINT64_C(1) << 39) - 256), DOMOperationError,
+        "AES-GCM can only encrypt up to 2^39 - 256 bytes of plaintext, but this stream has "
+        "received ", plainTextSize, " bytes.");
+
+    auto cipherText = kj::heapArray<kj::byte>(buffer.size());
+    int cipherSize = 0;
+    OSSLCALL(EVP_EncryptUpdate(cipherCtx.get(), cipherText.begin(), &cipherSize,
+                               buffer.begin(), buffer.size()));
+    KJ_ASSERT(cipherSize == buffer.size(), "EVP_EncryptUpdate should encrypt all at once");
+
+    auto ptr = cipherText.asPtr();
+    return inner->write(ptr).attach(kj::mv(cipherText));
+  }
+
+  kj::Promise<void> write(kj::ArrayPtr<const kj::ArrayPtr<const kj::byte>> pieces) override {
+    for (auto& piece: pieces) {
+      co_await write(piece);
+    }
+  }
+
+  kj::Promise<void> end() override {
+    auto tag = kj::heapArray<kj::byte>(tagByteSize);
+
+    int finalCipherSize = 0;
+    OSSLCALL(EVP_EncryptFinal_ex(cipherCtx.get(), tag.begin(), &finalCipherSize));
+    KJ_ASSERT(finalCipherSize == 0, "EVP_EncryptFinal_ex should not output any data");
+    OSSLCALL(EVP_CIPHER_CTX_ctrl(cipherCtx.get(), EVP_CTRL_GCM_GET_TAG, tag.size(), tag.begin()));
+
+    auto ptr = tag.asPtr();
+    return inner->write(ptr).attach(kj::mv(tag)).then([this]() { return inner->end(); });
+  }
+
+  void abort(kj::Exception reason) override {
+    inner->abort(kj::mv(reason));
+  }
+
+private:
+  kj::Own<EVP_CIPHER_CTX> cipherCtx;
+  size_t tagByteSize;
+  kj::Own<WritableStreamSink> inner;
+  uint64_t plainTextSize = 0;
+};
+
 class AesGcmKey final: public AesKeyBase {
 public:
   explicit AesGcmKey(kj::Array<kj::byte> keyData, CryptoKey::AesKeyAlgorithm keyAlgorithm,
@@ -241,6 +302,42 @@ private:
     return cipherText;
   }
 
+  kj::Own<WritableStreamSink> encryptStream(
+      SubtleCrypto::EncryptAlgorithm&& algorithm,
+      kj::Own<WritableStreamSink> inner) const override {
+    kj::ArrayPtr<kj::byte> iv = JSG_REQUIRE_NONNULL(algorithm.iv, TypeError,
+        "Missing field \"iv\" in \"algorithm\".");
+    JSG_REQUIRE(iv.size() != 0, DOMOperationError, "AES-GCM IV must not be empty.");
+
+    auto additionalData = algorithm.additionalData.orDefault(kj::Array<kj::byte>()).asPtr();
+
+    int tagLength = algorithm.tagLength.orDefault(128);
+    validateAesGcmTagLength(tagLength);
+
+    auto cipherCtx = kj::disposeWith<EVP_CIPHER_CTX_free>(EVP_CIPHER_CTX_new());
+    KJ_ASSERT(cipherCtx.get() != nullptr);
+
+    auto type = lookupAesGcmType(keyData.size() * 8);
+
+    // Identical context setup to the one-shot encrypt() above; the difference is that the
+    // context is handed to the sink and kept alive across chunks instead of being consumed by
+    // a single update/final pair.
+    OSSLCALL(EVP_EncryptInit_ex(cipherCtx.get(), type, nullptr, nullptr, nullptr));
+    OSSLCALL(EVP_CIPHER_CTX_ctrl(cipherCtx.get(), EVP_CTRL_GCM_SET_IVLEN,
+                                 iv.size(), nullptr));
+    OSSLCALL(EVP_EncryptInit_ex(cipherCtx.get(), nullptr, nullptr, keyData.begin(),
+                                iv.begin()));
+
+    if (additionalData.size() > 0) {
+      // See the comment in encrypt() for why the if-check.
+      int dummy;
+      OSSLCALL(EVP_EncryptUpdate(cipherCtx.get(), nullptr, &dummy,
+                                 additionalData.begin(), additionalData.size()));
+    }
+
+    return kj::heap<AesGcmEncryptSink>(kj::mv(cipherCtx), tagLength / 8, kj::mv(inner));
+  }
+
   kj::Array<kj::byte> decrypt(
       SubtleCrypto::EncryptAlgorithm&& algorithm,
       kj::ArrayPtr<const kj::byte> cipherText) const override {
@@ -4,6 +4,7 @@
 
 #include "crypto.h"
 #include "impl.h"
+#include <workerd/api/streams/internal.h>
 #include <workerd/api/streams/standard.h>
 #include <openssl/crypto.h>
 #include <openssl/err.h>
@@ -11,6 +12,8 @@
 #include <workerd/jsg/jsg.h>
 #include <workerd/io/io-context.h>
 #include <workerd/util/uuid.h>
+#include <kj/mutex.h>
+#include <kj/thread.h>
 #include <set>
 #include <array>
 #include <algorithm>
@@ -327,6 +330,30 @@ jsg::Promise<kj::Array<kj::byte>> SubtleCrypto::decrypt(
   });
 }
 
+jsg::Ref<TransformStream> SubtleCrypto::encryptStream(
+    jsg::Lock& js,
+    kj::OneOf<kj::String, EncryptAlgorithm> algorithmParam,
+    const CryptoKey& key) {
+  auto algorithm = interpretAlgorithmParam(kj::mv(algorithmParam));
+
+  auto checkErrorsOnFinish = webCryptoOperationBegin(__func__, algorithm);
+
+  validateOperation(key, algorithm.name, CryptoKeyUsageSet::encrypt());
+
+  // The writable side encrypts each chunk through a persistent cipher context owned by the
+  // key's sink; the ciphertext is forwarded into an identity pipe whose other end is the
+  // readable side. Nothing is buffered beyond the chunk in flight, so encrypting a large
+  // upload does not require materializing it.
+  auto pipe = kj::refcounted<IdentityTransformStreamImpl>();
+  auto readableSide = kj::addRef(*pipe);
+  auto writableSide = key.impl->encryptStream(kj::mv(algorithm), kj::mv(pipe));
+
+  auto& ioContext = IoContext::current();
+  return jsg::alloc<TransformStream>(
+      jsg::alloc<ReadableStream>(ioContext, kj::mv(readableSide)),
+      jsg::alloc<WritableStream>(ioContext, kj::mv(writableSide)));
+}
+
 jsg::Promise<kj::Array<kj::byte>> SubtleCrypto::sign(
     jsg::Lock& js,
     kj::OneOf<kj::String, SignAlgorithm> algorithmParam,
@@ -342,6 +369,75 @@ jsg::Promise<kj::Array<kj::byte>> SubtleCrypto::sign(
   });
 }
 
+kj::Maybe<bool> SubtleCrypto::VerifyResultCache::find(kj::ArrayPtr<const kj::byte> key) const {
+  return entries.find(key).map([](const bool& result) { return result; });
+}
+
+void SubtleCrypto::VerifyResultCache::insert(kj::Array<kj::byte> key, bool result) {
+  if (entries.size() >= MAX_ENTRIES) {
+    entries.clear();
+  }
+  entries.upsert(kj::mv(key), result, [](bool&, bool&&) {});
+}
+
+namespace {
+
+// Verification results may only be cached for algorithms where verify() is a pure function of
+// the key, signature, and message. (HMAC is excluded since its "key" is secret material we
+// don't want feeding a cache at all.)
+bool isVerifyCacheable(kj::StringPtr algorithmName) {
+  return algorithmName == "RSASSA-PKCS1-v1_5" || algorithmName == "RSA-PSS" ||
+      algorithmName == "ECDSA" || algorithmName == "Ed25519" ||
+      algorithmName == "NODE-ED25519";
+}
+
+kj::Array<kj::byte> computeVerifyCacheKey(
+    const SubtleCrypto::SignAlgorithm& algorithm,
+    kj::ArrayPtr<const kj::byte> spki,
+    kj::ArrayPtr<const kj::byte> signature,
+    kj::ArrayPtr<const kj::byte> data) {
+  auto ctx = kj::disposeWith<EVP_MD_CTX_free>(EVP_MD_CTX_new());
+  KJ_ASSERT(ctx.get() != nullptr);
+  OSSLCALL(EVP_DigestInit(ctx.get(), EVP_sha256()));
+
+  // Each field is framed with its length so that adjacent fields can't be confused for one
+  // another.
+  const auto update = [&](kj::ArrayPtr<const kj::byte> bytes) {
+    uint64_t size = bytes.size();
+    OSSLCALL(EVP_DigestUpdate(ctx.get(), &size, sizeof(size)));
+    OSSLCALL(EVP_DigestUpdate(ctx.get(), bytes.begin(), bytes.size()));
+  };
+
+  update(algorithm.name.asBytes());
+  KJ_IF_SOME(hash, algorithm.hash) {
+    KJ_SWITCH_ONEOF(hash) {
+      KJ_CASE_ONEOF(name, kj::String) {
+        update(name.asBytes());
+      }
+      KJ_CASE_ONEOF(obj, SubtleCrypto::HashAlgorithm) {
+        update(obj.name.asBytes());
+      }
+    }
+  }
+  int64_t saltLength = algorithm.saltLength.map(
+      [](const int& i) -> int64_t { return i; }).orDefault(-1);
+  update(kj::arrayPtr(reinterpret_cast<const kj::byte*>(&saltLength), sizeof(saltLength)));
+  int64_t dataLength = algorithm.dataLength.map(
+      [](const int& i) -> int64_t { return i; }).orDefault(-1);
+  update(kj::arrayPtr(reinterpret_cast<const kj::byte*>(&dataLength), sizeof(dataLength)));
+  update(spki);
+  update(signature);
+  update(data);
+
+  auto digest = kj::heapArray<kj::byte>(EVP_MD_CTX_size(ctx.get()));
+  uint digestSize = 0;
+  OSSLCALL(EVP_DigestFinal_ex(ctx.get(), digest.begin(), &digestSize));
+  KJ_ASSERT(digestSize == digest.size());
+  return digest;
+}
+
+}  // namespace
+
 jsg::Promise<bool> SubtleCrypto::verify(
     jsg::Lock& js,
     kj::OneOf<kj::String, SignAlgorithm> algorithmParam,
@@ -354,10 +450,76 @@ jsg::Promise<bool> SubtleCrypto::verify(
 
   return js.evalNow([&] {
     validateOperation(key, algorithm.name, CryptoKeyUsageSet::verify());
+
+    kj::Maybe<kj::Array<kj::byte>> maybeCacheKey;
+    if (key.getType() == "public"_kj && isVerifyCacheable(key.getAlgorithmName())) {
+      KJ_SWITCH_ONEOF(key.impl->exportKey("spki"_kj)) {
+        KJ_CASE_ONEOF(spki, kj::Array<kj::byte>) {
+          maybeCacheKey = computeVerifyCacheKey(algorithm, spki, signature, data);
+        }
+        KJ_CASE_ONEOF(jwk, JsonWebKey) {
+          // "spki" export never produces a JWK; don't cache if it somehow does.
+        }
+      }
+    }
+
+    KJ_IF_SOME(cacheKey, maybeCacheKey) {
+      KJ_IF_SOME(cached, verifyResultCache.find(cacheKey)) {
+        return cached;
+      }
+      bool result = key.impl->verify(kj::mv(algorithm), signature, data);
+      verifyResultCache.insert(kj::mv(cacheKey), result);
+      return result;
+    }
+
     return key.impl->verify(kj::mv(algorithm), signature, data);
   });
 }
 
+namespace {
+
+// Digest inputs totaling at least this many bytes are hashed off the isolate thread. Hashing is
+// pure CPU work, and for multi-megabyte inputs it can occupy the isolate thread long enough to
+// stall unrelated requests sharing the isolate. Below the threshold the thread hop costs more
+// than it saves.
+constexpr size_t OFF_THREAD_DIGEST_THRESHOLD = 1024 * 1024;
+
+// Returns the executor for the process-wide digest thread, starting it on first use. This
+// follows the same pattern as the compression thread in streams/compression.c++: a single
+// dedicated thread with its own event loop, reached via executeAsync().
+const kj::Executor& getDigestExecutor() {
+  static const kj::Executor& executor = []() -> const kj::Executor& {
+    // Deliberately leaked: the thread and its event loop live for the rest of the process.
+    auto ready = new kj::MutexGuarded<kj::Maybe<kj::Own<const kj::Executor>>>();
+    new kj::Thread([ready]() {
+      kj::EventLoop loop;
+      kj::WaitScope waitScope(loop);
+      *ready->lockExclusive() = kj::getCurrentThreadExecutor().addRef();
+      kj::Promise<void>(kj::NEVER_DONE).wait(waitScope);
+    });
+    auto lock = ready->lockExclusive();
+    lock.wait([](auto& value) { return value != kj::none; });
+    return *KJ_ASSERT_NONNULL(*lock);
+  }();
+  return executor;
+}
+
+kj::Array<kj::byte> computeDigest(const EVP_MD* type, kj::ArrayPtr<const kj::byte> data) {
+  auto digestCtx = kj::disposeWith<EVP_MD_CTX_free>(EVP_MD_CTX_new());
+  KJ_ASSERT(digestCtx.get() != nullptr);
+
+  OSSLCALL(EVP_DigestInit_ex(digestCtx.get(), type, nullptr));
+  OSSLCALL(EVP_DigestUpdate(digestCtx.get(), data.begin(), data.size()));
+  auto messageDigest = kj::heapArray<kj::byte>(EVP_MD_CTX_size(digestCtx.get()));
+  uint messageDigestSize = 0;
+  OSSLCALL(EVP_DigestFinal_ex(digestCtx.get(), messageDigest.begin(), &messageDigestSize));
+
+  KJ_ASSERT(messageDigestSize == messageDigest.size());
+  return kj::mv(messageDigest);
+}
+
+}  // namespace
+
 jsg::Promise<kj::Array<kj::byte>> SubtleCrypto::digest(
     jsg::Lock& js,
     kj::OneOf<kj::String, HashAlgorithm> algorithmParam,
@@ -366,20 +528,51 @@ jsg::Promise<kj::Array<kj::byte>> SubtleCrypto::digest(
 
   auto checkErrorsOnFinish = webCryptoOperationBegin(__func__, algorithm);
 
-  return js.evalNow([&] {
+  return js.evalNow([&]() -> jsg::Promise<kj::Array<kj::byte>> {
     auto type = lookupDigestAlgorithm(algorithm.name).second;
 
-    auto digestCtx = kj::disposeWith<EVP_MD_CTX_free>(EVP_MD_CTX_new());
-    KJ_ASSERT(digestCtx.get() != nullptr);
+    if (data.size() >= OFF_THREAD_DIGEST_THRESHOLD && IoContext::hasCurrent()) {
+      // The input is large enough that hashing it inline would noticeably block the event loop.
+      // Copy it and ship the work to the digest thread. The copy is required for correctness
+      // anyway: `data` is a view over the caller's ArrayBuffer, which JS could mutate while the
+      // digest thread is reading it. (The spec also calls for digesting a copy of the input.)
+      auto copy = kj::heapArray<const kj::byte>(data);
+      auto promise = getDigestExecutor().executeAsync(
+          [type, copy = kj::mv(copy)]() { return computeDigest(type, copy); });
+      return IoContext::current().awaitIo(js, kj::mv(promise));
+    }
+
+    return js.resolvedPromise(computeDigest(type, data));
+  });
+}
+
+jsg::Promise<kj::Array<kj::Array<kj::byte>>> SubtleCrypto::digestAll(
+    jsg::Lock& js,
+    kj::OneOf<kj::String, HashAlgorithm> algorithmParam,
+    kj::Array<kj::Array<const kj::byte>> datas) {
+  auto algorithm = interpretAlgorithmParam(kj::mv(algorithmParam));
 
-    OSSLCALL(EVP_DigestInit_ex(digestCtx.get(), type, nullptr));
-    OSSLCALL(EVP_DigestUpdate(digestCtx.get(), data.begin(), data.size()));
-    auto messageDigest = kj::heapArray<kj::byte>(EVP_MD_CTX_size(digestCtx.get()));
-    uint messageDigestSize = 0;
-    OSSLCALL(EVP_DigestFinal_ex(digestCtx.get(), messageDigest.begin(), &messageDigestSize));
+  auto checkErrorsOnFinish = webCryptoOperationBegin(__func__, algorithm);
+
+  return js.evalNow([&]() -> jsg::Promise<kj::Array<kj::Array<kj::byte>>> {
+    auto type = lookupDigestAlgorithm(algorithm.name).second;
+
+    size_t totalSize = 0;
+    for (auto& data: datas) {
+      totalSize += data.size();
+    }
+
+    if (totalSize >= OFF_THREAD_DIGEST_THRESHOLD && IoContext::hasCurrent()) {
+      // One thread hop for the whole batch. As in digest(), the inputs must be copied since they
+      // are views over caller-owned ArrayBuffers.
+      auto copies = KJ_MAP(data, datas) { return kj::heapArray<const kj::byte>(data); };
+      auto promise = getDigestExecutor().executeAsync([type, copies = kj::mv(copies)]() {
+        return KJ_MAP(copy, copies) { return computeDigest(type, copy); };
+      });
+      return IoContext::current().awaitIo(js, kj::mv(promise));
+    }
 
-    KJ_ASSERT(messageDigestSize == messageDigest.size());
-    return kj::mv(messageDigest);
+    return js.resolvedPromise(KJ_MAP(data, datas) { return computeDigest(type, data); });
   });
 }
 
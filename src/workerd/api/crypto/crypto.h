@@ -6,6 +6,7 @@
 // WebCrypto API
 
 #include <bit>
+#include <kj/map.h>
 #include <workerd/io/features.h>
 #include <workerd/jsg/buffersource.h>
 #include <workerd/jsg/jsg.h>
@@ -292,6 +293,11 @@ public:
 private:
   kj::Own<Impl> impl;
 
+  // Counts this key toward the isolate's per-category memory accounting. Key material
+  // sizes vary by algorithm and are not worth plumbing through; instance counts are
+  // what investigations actually need.
+  jsg::MemoryAccountingToken accounting{jsg::MemoryCategory::CRYPTO_KEYS};
+
   friend class SubtleCrypto;
   friend class EllipticKey;
   friend class EdDsaKey;
@@ -506,6 +512,16 @@ public:
       const CryptoKey& key,
       kj::Array<const kj::byte> cipherText);
 
+  // Non-standard extension: returns a TransformStream whose writable side encrypts each chunk
+  // through a persistent cipher context and whose readable side produces the ciphertext
+  // incrementally (with the authentication tag appended at the end for AEAD algorithms), so
+  // large payloads can be encrypted without buffering them in memory. Currently only
+  // implemented for AES-GCM.
+  jsg::Ref<TransformStream> encryptStream(
+      jsg::Lock& js,
+      kj::OneOf<kj::String, EncryptAlgorithm> algorithm,
+      const CryptoKey& key);
+
   jsg::Promise<kj::Array<kj::byte>> sign(
       jsg::Lock& js,
       kj::OneOf<kj::String, SignAlgorithm> algorithm,
@@ -523,6 +539,14 @@ public:
       kj::OneOf<kj::String, HashAlgorithm> algorithm,
       kj::Array<const kj::byte> data);
 
+  // Non-standard extension: computes the digest of each of the given inputs with a single
+  // promise (and, for large batches, a single off-thread round trip) rather than one
+  // digest() call per input.
+  jsg::Promise<kj::Array<kj::Array<kj::byte>>> digestAll(
+      jsg::Lock& js,
+      kj::OneOf<kj::String, HashAlgorithm> algorithm,
+      kj::Array<kj::Array<const kj::byte>> datas);
+
   jsg::Promise<kj::OneOf<jsg::Ref<CryptoKey>, CryptoKeyPair>> generateKey(
       jsg::Lock& js,
       kj::OneOf<kj::String, GenerateKeyAlgorithm> algorithm,
@@ -593,9 +617,11 @@ public:
   JSG_RESOURCE_TYPE(SubtleCrypto) {
     JSG_METHOD(encrypt);
     JSG_METHOD(decrypt);
+    JSG_METHOD(encryptStream);
     JSG_METHOD(sign);
     JSG_METHOD(verify);
     JSG_METHOD(digest);
+    JSG_METHOD(digestAll);
     JSG_METHOD(generateKey);
     JSG_METHOD(deriveKey);
     JSG_METHOD(deriveBits);
@@ -605,6 +631,35 @@ public:
     JSG_METHOD(unwrapKey);
     JSG_METHOD(timingSafeEqual);
   }
+
+  void visitForMemoryInfo(jsg::MemoryTracker& tracker) const {
+    // Each entry is a 32-byte digest key plus the map's per-entry overhead.
+    tracker.trackFieldWithSize("verifyResultCache",
+        verifyResultCache.entries.size() * (sizeof(kj::Array<kj::byte>) + 32 + sizeof(bool)));
+  }
+
+private:
+  // Memo cache for public-key signature verification. Verifying the same token repeatedly is
+  // common (e.g. a JWT presented on every request within its TTL), and each verification is a
+  // full modular exponentiation or curve computation. Since verification of a fixed
+  // (public key, signature, message) triple is deterministic for the participating algorithms,
+  // the result can be remembered. Entries are keyed by a SHA-256 over the algorithm parameters,
+  // the exported SPKI form of the key, the signature, and the message.
+  //
+  // The cache is deliberately scoped to this SubtleCrypto instance -- and thus to the context
+  // that owns it -- rather than shared across the process: a wider cache would make the
+  // cached-vs-uncached verify latency observable across tenants, letting one worker probe
+  // whether another recently verified a known (key, signature, message) triple. It is accessed
+  // only under the isolate lock, so no synchronization is needed. Bounded; when full it is
+  // simply cleared, which is adequate for the hot-token workload this serves.
+  struct VerifyResultCache {
+    static constexpr size_t MAX_ENTRIES = 1024;
+    kj::HashMap<kj::Array<kj::byte>, bool> entries;
+
+    kj::Maybe<bool> find(kj::ArrayPtr<const kj::byte> key) const;
+    void insert(kj::Array<kj::byte> key, bool result);
+  };
+  VerifyResultCache verifyResultCache;
 };
 
 // =======================================================================================
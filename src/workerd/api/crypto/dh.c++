@@ -1,9 +1,11 @@
 #include "dh.h"
 #include <workerd/io/io-context.h>
 #include <kj/string.h>
+#include <kj/mutex.h>
 #include <kj/one-of.h>
 #include <openssl/bn.h>
 #include <openssl/dh.h>
+#include <map>
 
 #if WORKERD_BSSL_NEED_DH_PRIMES
 #include <workerd/api/crypto/dh-primes.h>
@@ -37,11 +39,27 @@ BIGNUM* (*findDiffieHellmanGroup(const char* name))(BIGNUM*) {
   return nullptr;
 }
 
+// Returns a copy of the prime for a well-known group, deriving it from its serialized form
+// only on the first use of that group in the process. The primes are constants, so later
+// instances just BN_dup() the cached value instead of re-running the derivation each time a
+// DiffieHellmanGroup is constructed.
+BIGNUM* getCachedGroupPrime(BIGNUM* (*group)(BIGNUM*)) {
+  static kj::MutexGuarded<std::map<void*, BIGNUM*>> cache;
+  auto lock = cache.lockExclusive();
+  auto& prime = (*lock)[reinterpret_cast<void*>(group)];
+  if (prime == nullptr) {
+    // Deliberately never freed; the cache lives for the rest of the process.
+    prime = group(nullptr);
+    KJ_ASSERT(prime != nullptr);
+  }
+  return BN_dup(prime);
+}
+
 kj::Own<DH> initDhGroup(kj::StringPtr name) {
   auto group = findDiffieHellmanGroup(name.begin());
   JSG_REQUIRE(group != nullptr, Error, "Failed to init DiffieHellmanGroup: invalid group. Only "
               "groups {modp14, modp15, modp16, modp17, modp18} are supported.");
-  auto groupKey = group(nullptr);
+  auto groupKey = getCachedGroupPrime(group);
   KJ_ASSERT(groupKey != nullptr);
 
   const int kStandardizedGenerator = 2;
@@ -117,16 +117,67 @@ void zeroOutTrailingKeyBits(kj::Array<kj::byte>& keyDataArray, int keyBitLength)
   }
 }
 
+// Caches key-initialized HMAC contexts so that repeated createHmac() calls with the same
+// algorithm and key clone the prepared state via HMAC_CTX_copy() instead of redoing the key
+// schedule (hashing the padded ipad/opad blocks). Request-signing workloads compute an HMAC
+// per request with one long-lived key, so a handful of slots covers them; slots are replaced
+// round-robin. The cached contexts hold only key-derived state and are never updated with
+// message data. Thread-local since HMAC_CTX is not thread-safe.
+class HmacCtxCache {
+public:
+  kj::Maybe<kj::Own<HMAC_CTX>> tryClone(kj::StringPtr algorithm, kj::ArrayPtr<kj::byte> key) {
+    for (auto& slot: slots) {
+      KJ_IF_SOME(entry, slot) {
+        if (entry.algorithm == algorithm && entry.key.size() == key.size() &&
+            (key.size() == 0 ||
+             CRYPTO_memcmp(entry.key.begin(), key.begin(), key.size()) == 0)) {
+          auto ctx = OSSL_NEW(HMAC_CTX);
+          if (HMAC_CTX_copy(ctx.get(), entry.ctx.get())) {
+            return kj::mv(ctx);
+          }
+          return kj::none;
+        }
+      }
+    }
+    return kj::none;
+  }
+
+  void store(kj::StringPtr algorithm, kj::ArrayPtr<kj::byte> key, HMAC_CTX* ctx) {
+    auto copy = OSSL_NEW(HMAC_CTX);
+    if (!HMAC_CTX_copy(copy.get(), ctx)) return;
+    slots[nextSlot++ % kj::size(slots)]
+        .emplace(kj::str(algorithm), kj::heapArray(key), kj::mv(copy));
+  }
+
+private:
+  struct Entry {
+    Entry(kj::String algorithm, kj::Array<kj::byte> key, kj::Own<HMAC_CTX> ctx)
+        : algorithm(kj::mv(algorithm)), key(kj::mv(key)), ctx(kj::mv(ctx)) {}
+
+    kj::String algorithm;
+    ZeroOnFree key;
+    kj::Own<HMAC_CTX> ctx;
+  };
+  kj::Maybe<Entry> slots[4];
+  uint nextSlot = 0;
+};
+
+thread_local HmacCtxCache hmacCtxCache;
+
 kj::Own<HMAC_CTX> initHmacContext(kj::StringPtr algorithm, HmacContext::KeyData& key) {
   static constexpr auto handle = [](kj::StringPtr algorithm, kj::ArrayPtr<kj::byte> key) {
     ClearErrorOnReturn clearErrorOnReturn;
     JSG_REQUIRE(key.size() <= INT_MAX, RangeError, "key is too long");
+    KJ_IF_SOME(ctx, hmacCtxCache.tryClone(algorithm, key)) {
+      return kj::mv(ctx);
+    }
     const EVP_MD* md = EVP_get_digestbyname(algorithm.begin());
     JSG_REQUIRE(md != nullptr, Error, "Digest method not supported");
     static constexpr auto mt = ""_kjc;
     auto hmac_ctx = OSSL_NEW(HMAC_CTX);
     JSG_REQUIRE(HMAC_Init_ex(hmac_ctx.get(), key.size() ? key.asChars().begin() : mt.begin(),
                             key.size(), md, nullptr), Error, "Failed to initalize HMAC");
+    hmacCtxCache.store(algorithm, key, hmac_ctx.get());
     return kj::mv(hmac_ctx);
   };
 
@@ -148,6 +148,18 @@ public:
         getAlgorithmName(), "\".");
   }
 
+  // Returns a sink that encrypts everything written to it through a persistent cipher context,
+  // forwarding the ciphertext to `inner` chunk by chunk, so the plaintext never needs to be
+  // materialized in one buffer. Only implemented for algorithms that can emit ciphertext
+  // incrementally (currently AES-GCM).
+  virtual kj::Own<WritableStreamSink> encryptStream(
+      SubtleCrypto::EncryptAlgorithm&& algorithm,
+      kj::Own<WritableStreamSink> inner) const {
+    JSG_FAIL_REQUIRE(DOMNotSupportedError,
+        "The streaming encrypt operation is not implemented for \"",
+        getAlgorithmName(), "\".");
+  }
+
   virtual kj::Array<kj::byte> sign(
       SubtleCrypto::SignAlgorithm&& algorithm,
       kj::ArrayPtr<const kj::byte> data) const {
@@ -2,9 +2,148 @@
 
 #include <workerd/api/crypto/impl.h>
 #include <openssl/bn.h>
+#include <kj/mutex.h>
+#include <kj/thread.h>
+#include <kj/vector.h>
 
 namespace workerd::api {
 
+namespace {
+
+// Generates a random prime of the given size with no add/rem constraint, returning none on
+// failure rather than throwing, so it can also run on the refill thread below.
+kj::Maybe<kj::Array<kj::byte>> tryGeneratePrime(uint32_t bits, bool safe) {
+  ClearErrorOnReturn clearErrorOnReturn;
+  // BN_generate_prime_ex() calls RAND_bytes_ex() internally.
+  // Make sure the CSPRNG is properly seeded.
+  if (!CSPRNG(nullptr)) return kj::none;
+  auto prime = OSSL_NEW(BIGNUM);
+  if (BN_generate_prime_ex(prime.get(), static_cast<int>(bits), safe ? 1 : 0,
+                           nullptr, nullptr, nullptr) != 1) {
+    return kj::none;
+  }
+  return bignumToArrayPadded(*prime);
+}
+
+// A pool of pregenerated primes, per (size, safe) class. Generating a large (especially safe)
+// prime stalls the calling thread for anywhere from tens of milliseconds to seconds, which on a
+// shared isolate shows up directly in tail latency. Classes are created the first time a size is
+// requested; a single background thread then keeps each class topped up to a small target depth,
+// generating one prime at a time so the refill work never competes hard for CPU. Requests that
+// miss (first call for a class, or a drained class) fall back to generating inline, exactly as
+// before. Pooled primes are drawn from the same CSPRNG-backed generator and each is handed out
+// only once, so pooling does not change their distribution or freshness.
+class PrimePool {
+public:
+  static PrimePool& instance() {
+    static PrimePool pool;
+    return pool;
+  }
+
+  kj::Maybe<kj::Array<kj::byte>> take(uint32_t bits, bool safe) {
+    if (bits < MIN_POOLED_BITS) {
+      // Small primes are cheap enough to generate inline.
+      return kj::none;
+    }
+    auto lock = state.lockExclusive();
+    for (auto& sizeClass: lock->classes) {
+      if (sizeClass.bits == bits && sizeClass.safe == safe) {
+        if (sizeClass.primes.size() == 0) return kj::none;
+        auto prime = kj::mv(sizeClass.primes.back());
+        sizeClass.primes.removeLast();
+        // Releasing the lock wakes the refill thread, which will top the class back up.
+        return kj::mv(prime);
+      }
+    }
+    // First request for this size class; start pooling it if there's room.
+    if (lock->classes.size() < MAX_SIZE_CLASSES) {
+      lock->classes.add(SizeClass{bits, safe});
+    }
+    return kj::none;
+  }
+
+private:
+  // Pool primes only at sizes where generation is slow enough to be worth hiding.
+  static constexpr uint32_t MIN_POOLED_BITS = 512;
+  static constexpr size_t MAX_SIZE_CLASSES = 8;
+  static constexpr size_t TARGET_POOL_DEPTH = 4;
+
+  struct SizeClass {
+    uint32_t bits;
+    bool safe;
+    kj::Vector<kj::Array<kj::byte>> primes;
+  };
+
+  struct State {
+    kj::Vector<SizeClass> classes;
+  };
+
+  kj::MutexGuarded<State> state;
+
+  PrimePool() {
+    // Deliberately leaked: the refill thread lives for the rest of the process. It spends its
+    // idle time blocked in wait() below.
+    new kj::Thread([this]() { refillLoop(); });
+  }
+
+  [[noreturn]] void refillLoop() {
+    for (;;) {
+      // Any exception (e.g. allocation failure inside OpenSSL) just abandons this iteration;
+      // the pool degrades to inline generation rather than taking the thread down.
+      kj::runCatchingExceptions([&]() {
+        uint32_t bits;
+        bool safe;
+        {
+          auto lock = state.lockExclusive();
+          lock.wait([](const State& s) {
+            for (auto& sizeClass: s.classes) {
+              if (sizeClass.primes.size() < TARGET_POOL_DEPTH) return true;
+            }
+            return false;
+          });
+          auto& sizeClass = KJ_ASSERT_NONNULL(needyClass(*lock));
+          bits = sizeClass.bits;
+          safe = sizeClass.safe;
+        }
+
+        // Generate outside the lock; this is the slow part.
+        auto prime = tryGeneratePrime(bits, safe);
+
+        auto lock = state.lockExclusive();
+        KJ_IF_SOME(p, prime) {
+          for (auto& sizeClass: lock->classes) {
+            if (sizeClass.bits == bits && sizeClass.safe == safe &&
+                sizeClass.primes.size() < TARGET_POOL_DEPTH) {
+              sizeClass.primes.add(kj::mv(p));
+              break;
+            }
+          }
+        } else {
+          // Generation failed; drop the class so we don't spin retrying it.
+          for (auto i: kj::indices(lock->classes)) {
+            if (lock->classes[i].bits == bits && lock->classes[i].safe == safe) {
+              if (i != lock->classes.size() - 1) {
+                lock->classes[i] = kj::mv(lock->classes.back());
+              }
+              lock->classes.removeLast();
+              break;
+            }
+          }
+        }
+      });
+    }
+  }
+
+  static kj::Maybe<SizeClass&> needyClass(State& s) {
+    for (auto& sizeClass: s.classes) {
+      if (sizeClass.primes.size() < TARGET_POOL_DEPTH) return sizeClass;
+    }
+    return kj::none;
+  }
+};
+
+}  // namespace
+
 kj::Array<kj::byte> randomPrime(uint32_t size, bool safe,
                                 kj::Maybe<kj::ArrayPtr<kj::byte>> add_buf,
                                 kj::Maybe<kj::ArrayPtr<kj::byte>> rem_buf) {
@@ -72,6 +211,15 @@ kj::Array<kj::byte> randomPrime(uint32_t size, bool safe,
     }
   }
 
+  if (add == nullptr) {
+    // Unconstrained request: any pooled prime of this size class will do. A miss (first request
+    // for this size, or the pool is drained) falls through to inline generation below while the
+    // refill thread tops the class back up for subsequent calls.
+    KJ_IF_SOME(prime, PrimePool::instance().take(size, safe)) {
+      return kj::mv(prime);
+    }
+  }
+
   // BN_generate_prime_ex() calls RAND_bytes_ex() internally.
   // Make sure the CSPRNG is properly seeded.
   JSG_REQUIRE(workerd::api::CSPRNG(nullptr), Error,
@@ -2,7 +2,10 @@
 #include "x509.h"
 #include "openssl/bio.h"
 #include "openssl/pem.h"
+#include "openssl/sha.h"
 #include "openssl/x509v3.h"
+#include <kj/map.h>
+#include <kj/mutex.h>
 
 KJ_DECLARE_NON_POLYMORPHIC(STACK_OF(ASN1_OBJECT));
 
@@ -543,8 +546,66 @@ struct StackOfXASN1Disposer: public kj::Disposer {
 StackOfXASN1Disposer stackOfXASN1Disposer;
 }  // namespace
 
+namespace {
+
+// Process-wide cache of parsed certificates, keyed by a SHA-256 fingerprint of the raw PEM/DER
+// input. mTLS-heavy workers parse the same client CA chain on every request; X509 objects are
+// reference counted and safe to share once parsed (the standard TLS-server pattern), so a hit
+// hands out another reference instead of re-running the PEM decode and d2i_X509. The accessor
+// fields were already computed lazily per property access, so nothing else needs to be
+// recomputed either. Bounded: when full, the cache drops all of its references and starts over.
+class ParsedCertCache {
+public:
+  kj::Maybe<X509*> find(kj::ArrayPtr<const kj::byte> fingerprint) {
+    auto lock = cache.lockExclusive();
+    KJ_IF_SOME(cert, lock->find(fingerprint)) {
+      X509_up_ref(cert);
+      return cert;
+    }
+    return kj::none;
+  }
+
+  void insert(kj::Array<kj::byte> fingerprint, X509* cert) {
+    auto lock = cache.lockExclusive();
+    if (lock->size() >= MAX_ENTRIES) {
+      for (auto& entry: *lock) {
+        X509_free(entry.value);
+      }
+      lock->clear();
+    }
+    X509_up_ref(cert);
+    lock->upsert(kj::mv(fingerprint), cert, [](X509*& existing, X509*&& replacement) {
+      // Lost a race with another thread parsing the same bytes; keep the existing entry.
+      X509_free(replacement);
+    });
+  }
+
+private:
+  static constexpr size_t MAX_ENTRIES = 256;
+  kj::MutexGuarded<kj::HashMap<kj::Array<kj::byte>, X509*>> cache;
+};
+
+ParsedCertCache& parsedCertCache() {
+  static ParsedCertCache instance;
+  return instance;
+}
+
+kj::Array<kj::byte> contentFingerprint(kj::ArrayPtr<const kj::byte> raw) {
+  auto digest = kj::heapArray<kj::byte>(SHA256_DIGEST_LENGTH);
+  SHA256(raw.begin(), raw.size(), digest.begin());
+  return digest;
+}
+
+}  // namespace
+
 kj::Maybe<jsg::Ref<X509Certificate>> X509Certificate::parse(kj::Array<const kj::byte> raw) {
   ClearErrorOnReturn ClearErrorOnReturn;
+
+  auto fingerprint = contentFingerprint(raw);
+  KJ_IF_SOME(cert, parsedCertCache().find(fingerprint)) {
+    return jsg::alloc<X509Certificate>(cert);
+  }
+
   KJ_IF_SOME(bio, loadBio(raw)) {
     auto ptr = PEM_read_bio_X509_AUX(bio.get(), nullptr, NoPasswordCallback, nullptr);
     if (ptr == nullptr) {
@@ -555,6 +616,7 @@ kj::Maybe<jsg::Ref<X509Certificate>> X509Certificate::parse(kj::Array<const kj::
         throwOpensslError(__FILE__, __LINE__, "X509Certificate::parse()");
       }
     }
+    parsedCertCache().insert(kj::mv(fingerprint), ptr);
     return jsg::alloc<X509Certificate>(ptr);
   }
   return kj::none;
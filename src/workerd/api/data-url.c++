@@ -1,4 +1,5 @@
 #include "data-url.h"
+#include <workerd/api/node/buffer-base64.h>
 #include <kj/encoding.h>
 
 namespace workerd::api {
@@ -37,17 +38,6 @@ kj::Maybe<DataUrl> DataUrl::from(const jsg::Url& url) {
     return label.slice(start, end).asChars();
   };
 
-  static const auto strip = [](auto label) {
-    auto result = kj::heapArray<kj::byte>(label.size());
-    size_t len = 0;
-    for (auto c : label) {
-      if (!isAsciiWhitespace(c)) {
-        result[len++] = c;
-      }
-    }
-    return result.first(len).attach(kj::mv(result));
-  };
-
   static const auto isBase64 = [](kj::ArrayPtr<const char> label) -> bool {
     KJ_IF_SOME(pos, label.findLast(';')) {
       auto res = trim(label.slice(pos + 1));
@@ -81,7 +71,16 @@ kj::Maybe<DataUrl> DataUrl::from(const jsg::Url& url) {
     kj::Array<kj::byte> decoded = nullptr;
     if (isBase64(unparsed)) {
       unparsed = unparsed.first(KJ_ASSERT_NONNULL(unparsed.findLast(';')));
-      decoded = kj::decodeBase64(strip(jsg::Url::percentDecode(data.asBytes())).asChars());
+      // Decode straight from the percent-decoded text into the final buffer in one pass. The
+      // Node-derived decoder (vectorized for clean input) skips ASCII whitespace itself, so no
+      // separate strip pass or intermediate copy is needed. Large inlined data: URLs make this
+      // path surprisingly hot.
+      auto text = jsg::Url::percentDecode(data.asBytes());
+      auto buf = kj::heapArray<kj::byte>(
+          node::base64_decoded_size(text.asChars().begin(), text.size()));
+      size_t len = node::base64_decode(buf.asChars().begin(), buf.size(),
+                                       text.asChars().begin(), text.size());
+      decoded = buf.first(len).attach(kj::mv(buf));
     } else {
       decoded = jsg::Url::percentDecode(data.asBytes());
     }
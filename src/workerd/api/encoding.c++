@@ -4,6 +4,7 @@
 
 #include "encoding.h"
 #include "util.h"
+#include "simdutf.h"
 #include <workerd/jsg/jsg.h>
 #include <workerd/jsg/buffersource.h>
 #include <unicode/ucnv.h>
@@ -319,8 +320,6 @@ kj::Maybe<jsg::JsString> IcuDecoder::decode(
     KJ_UNREACHABLE;
   };
 
-  const auto isUsAscii = [](const auto& b) { return b <= 0x7f; };
-
   KJ_DEFER({ if (flush) reset(); });
 
   // Evaluate fast-path options. These provide shortcuts for common cases with the caveat
@@ -328,16 +327,37 @@ kj::Maybe<jsg::JsString> IcuDecoder::decode(
   // conversions are being handled by v8 directly rather than by the ICU converter).
   if (buffer.size() > 0 && ucnv_toUCountPending(inner.get(), &status) == 0) {
     KJ_ASSERT(U_SUCCESS(status));
-    if (encoding == Encoding::Utf8 && std::all_of(buffer.begin(), buffer.end(), isUsAscii)) {
-      // This is a fast-path option for UTF-8 that can be taken when there
-      // are no buffered inputs and the non-empty input buffer contains only
-      // codepoints <= 0x7f. This path is safe because with ASCII range codepoints
-      // we know we won't accidentally split a multi-byte encoding. We also don't
-      // have to worry about the BOM here since the BOM bytes are > 0x7f.
-      // Note also that in this case we'll interpret as Latin1 since UTF-8 bytes
-      // within this range are identical to Latin1 and v8 allocates these more
-      // efficiently.
-      return js.str(buffer);
+    if (encoding == Encoding::Utf8) {
+      if (simdutf::validate_ascii(buffer.asChars().begin(), buffer.size())) {
+        // This is a fast-path option for UTF-8 that can be taken when there
+        // are no buffered inputs and the non-empty input buffer contains only
+        // codepoints <= 0x7f. This path is safe because with ASCII range codepoints
+        // we know we won't accidentally split a multi-byte encoding. We also don't
+        // have to worry about the BOM here since the BOM bytes are > 0x7f.
+        // Note also that in this case we'll interpret as Latin1 since UTF-8 bytes
+        // within this range are identical to Latin1 and v8 allocates these more
+        // efficiently.
+        return js.str(buffer);
+      }
+
+      if (simdutf::validate_utf8(buffer.asChars().begin(), buffer.size())) {
+        // The buffer is entirely well-formed UTF-8, so it can be handed to v8
+        // directly; only the BOM needs handling here. The vectorized validation
+        // is much cheaper than pushing every byte through the ICU converter.
+        // Ill-formed or truncated input (e.g. a multi-byte sequence split
+        // across stream() chunks) fails validation and falls through to ICU,
+        // which implements the buffering, replacement, and fatal-error
+        // semantics.
+        auto chars = buffer.asChars();
+        if (!ignoreBom && !bomSeen) {
+          bomSeen = true;
+          if (chars.size() >= 3 && chars[0] == '\xef' && chars[1] == '\xbb' &&
+              chars[2] == '\xbf') {
+            chars = chars.slice(3, chars.size());
+          }
+        }
+        return js.str(chars);
+      }
     }
 
     if (encoding == Encoding::Utf16le && buffer.size() % sizeof(char16_t) == 0) {
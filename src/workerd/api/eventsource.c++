@@ -9,6 +9,8 @@
 #include <workerd/jsg/exception.h>
 #include <workerd/util/mimetype.h>
 
+#include <cstring>
+
 namespace workerd::api {
 
 namespace {
@@ -45,17 +47,35 @@ public:
       }
     }
 
-    while (input != nullptr) {
+    // If the previous write ended with a bare \r that we already treated as a line
+    // terminator, a \n at the start of this write is the second half of a \r\n pair
+    // split across chunks, not an empty line.
+    if (danglingCr) {
+      danglingCr = false;
+      if (input.size() > 0 && input[0] == '\n') {
+        input = input.slice(1);
+      }
+    }
+
+    while (input.size() > 0) {
       KJ_IF_SOME(found, findEndOfLine(input)) {
-          auto prefix = kept.releaseAsArray();
-          // Feed the line into the processor.
-          feed(kj::str(prefix, input.slice(0, found.pos)));
-          input = found.remaining;
-          // If we've reached the end of the input, input will == nullptr here.
+        auto line = input.slice(0, found.pos);
+        if (kept.size() > 0) {
+          // This line started in a previous write. Complete the carried-over prefix
+          // and feed that. This is the only case that copies line data; a line that
+          // arrives within a single write is fed as a view of the input directly.
+          kept.addAll(line);
+          feed(kept.asPtr());
+          kept.clear();
+        } else {
+          feed(line);
+        }
+        danglingCr = found.danglingCr;
+        input = found.remaining;
       } else {
         // No end-of-line found, buffer the input.
-        kept.addAll(input.begin(), input.end());
-        input = nullptr;
+        kept.addAll(input);
+        break;
       }
     }
 
@@ -87,9 +107,14 @@ public:
 private:
   kj::Maybe<EventSource&> eventSource;
 
-  // Retained bytes to be processed in the next write.
+  // Retained bytes of a partial line to be completed by the next write.
   kj::Vector<char> kept;
 
+  // Set to true when the previous write ended with a \r, so that a leading \n in
+  // the next write is recognized as the tail of a \r\n pair rather than a new
+  // (empty) line.
+  bool danglingCr = false;
+
   // The collected messages that are pending to be dispatched as events
   kj::Vector<EventSource::PendingMessage> pendingMessages;
 
@@ -106,7 +131,7 @@ private:
     return currentPendingMessage.emplace();
   }
 
-  void feed(kj::String line) {
+  void feed(kj::ArrayPtr<const char> line) {
     // Parse line according to the event stream format and dispatch the event.
 
     // stream        = [ bom ] *event
@@ -195,20 +220,32 @@ private:
   struct EndOfLine {
     size_t pos;
     kj::ArrayPtr<const char> remaining;
+    // True if the terminator was a \r at the very end of the input, in which case
+    // a \n at the start of the next write belongs to this terminator.
+    bool danglingCr = false;
   };
   kj::Maybe<EndOfLine> findEndOfLine(kj::ArrayPtr<const char> input) {
-    // The end-of-line marker is either \n, \r, or \r\n
-    size_t pos = 0;
-    while (pos < input.size()) {
-      if (input[pos] == '\n') {
-        return EndOfLine{pos, input.slice(pos + 1)};
-      } else if (input[pos] == '\r') {
-        if (pos + 1 < input.size() && input[pos + 1] == '\n') {
-          return EndOfLine{pos, input.slice(pos + 2)};
-        }
-        return EndOfLine{pos, input.slice(pos + 1)};
+    // The end-of-line marker is either \n, \r, or \r\n. Use memchr rather than a
+    // byte-at-a-time loop: find the first \n, then look for a \r only in the span
+    // before it, so each byte of input is scanned at most twice and typically once.
+    size_t limit = input.size();
+    const void* nl = memchr(input.begin(), '\n', limit);
+    if (nl != nullptr) {
+      limit = static_cast<const char*>(nl) - input.begin();
+    }
+    const void* cr = memchr(input.begin(), '\r', limit);
+    if (cr != nullptr) {
+      size_t pos = static_cast<const char*>(cr) - input.begin();
+      if (pos + 1 < input.size() && input[pos + 1] == '\n') {
+        return EndOfLine{pos, input.slice(pos + 2)};
       }
-      pos++;
+      if (pos + 1 == input.size()) {
+        return EndOfLine{pos, nullptr, true};
+      }
+      return EndOfLine{pos, input.slice(pos + 1)};
+    }
+    if (nl != nullptr) {
+      return EndOfLine{limit, input.slice(limit + 1)};
     }
     return kj::none;
   }
@@ -66,9 +66,12 @@ constexpr auto contentDisposition =
     p::sequence(p::discardWhitespace, httpIdentifier,
                 p::discardWhitespace, p::many(contentDispositionParam));
 
+// If `backing` is given, `body` must point into the backing blob's buffer, and File
+// entries are created as zero-copy views of their slice of it instead of copying.
 void parseFormData(kj::Maybe<jsg::Lock&> js, kj::Vector<FormData::Entry>& data,
                    kj::StringPtr boundary, kj::ArrayPtr<const char> body,
-                   bool convertFilesToStrings) {
+                   bool convertFilesToStrings,
+                   kj::Maybe<jsg::Ref<Blob>&> backing = kj::none) {
   // multipart/form-data messages are delimited by <CRLF>--<boundary>. We want to be able to handle
   // omitted carriage returns, though, so our delimiter only matches against a preceding line feed.
   const auto delimiter = kj::str("\n--", boundary);
@@ -165,6 +168,13 @@ void parseFormData(kj::Maybe<jsg::Lock&> js, kj::Vector<FormData::Entry>& data,
 
     if (filename == kj::none || convertFilesToStrings) {
       data.add(FormData::Entry { kj::mv(name), kj::str(message) });
+    } else KJ_IF_SOME(b, backing) {
+      data.add(FormData::Entry {
+        kj::mv(name),
+        jsg::alloc<File>(b.addRef(), message.asBytes(),
+                         KJ_ASSERT_NONNULL(kj::mv(filename)),
+                         kj::str(type.orDefault(nullptr)), dateNow())
+      });
     } else {
       auto bytes = kj::heapArray(message.asBytes());
       KJ_IF_SOME(lock, js) {
@@ -353,6 +363,30 @@ void FormData::parse(kj::Maybe<jsg::Lock&> js, kj::ArrayPtr<const char> rawText,
       MimeType::FORM_URLENCODED.toString()));
 }
 
+void FormData::parse(jsg::Lock& js, kj::String rawText,
+                     kj::StringPtr contentType, bool convertFilesToStrings) {
+  KJ_IF_SOME(parsed, MimeType::tryParse(contentType)) {
+    if (MimeType::FORM_DATA == parsed && !convertFilesToStrings) {
+      auto& boundary = JSG_REQUIRE_NONNULL(parsed.params().find("boundary"_kj), TypeError,
+          "No boundary string in Content-Type header. The multipart/form-data MIME "
+          "type requires a boundary parameter, e.g. 'Content-Type: multipart/form-data; "
+          "boundary=\"abcd\"'. See RFC 7578, section 4.");
+      // Wrap the raw body in a single backing Blob so that each File entry can be
+      // created as a zero-copy view of its slice, instead of copying every part out
+      // of the buffer individually.
+      auto backing = jsg::alloc<Blob>(js, rawText.releaseArray().releaseAsBytes(),
+                                      kj::String());
+      parseFormData(js, data, boundary, backing->getData().asChars(),
+                    convertFilesToStrings, backing);
+      return;
+    }
+  }
+
+  // Everything else (x-www-form-urlencoded values require percent-decoding, and the
+  // files-as-strings compatibility mode copies regardless) takes the copying path.
+  parse(js, rawText.asPtr(), contentType, convertFilesToStrings);
+}
+
 jsg::Ref<FormData> FormData::constructor() {
   return jsg::alloc<FormData>();
 }
@@ -56,6 +56,14 @@ public:
   void parse(kj::Maybe<jsg::Lock&> js, kj::ArrayPtr<const char> rawText,
              kj::StringPtr contentType, bool convertFilesToStrings);
 
+  // Like the above, but takes ownership of the raw body. For multipart/form-data
+  // bodies parsed as Files, the whole body is wrapped in a single backing Blob and
+  // each File entry is created as a zero-copy view of its slice of that buffer,
+  // rather than copying every part. Large file uploads consequently hold one copy
+  // of the body instead of one copy per part plus the original.
+  void parse(jsg::Lock& js, kj::String rawText,
+             kj::StringPtr contentType, bool convertFilesToStrings);
+
   struct Entry {
     kj::String name;
     kj::OneOf<jsg::Ref<File>, kj::String> value;
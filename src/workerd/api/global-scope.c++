@@ -343,12 +343,14 @@ void ServiceWorkerGlobalScope::sendTraces(kj::ArrayPtr<kj::Own<Trace>> traces,
 void ServiceWorkerGlobalScope::startScheduled(
     kj::Date scheduledTime,
     kj::StringPtr cron,
+    uint32_t shardIndex,
+    uint32_t shardCount,
     Worker::Lock& lock, kj::Maybe<ExportedHandler&> exportedHandler) {
   auto& context = IoContext::current();
 
   double eventTime = (scheduledTime - kj::UNIX_EPOCH) / kj::MILLISECONDS;
 
-  auto event = jsg::alloc<ScheduledEvent>(eventTime, cron);
+  auto event = jsg::alloc<ScheduledEvent>(eventTime, cron, shardIndex, shardCount);
 
   auto isolate = lock.getIsolate();
 
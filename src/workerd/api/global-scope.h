@@ -48,6 +48,7 @@ class CompressionStream;
 class DecompressionStream;
 class TextEncoderStream;
 class TextDecoderStream;
+class JsonParseStream;
 class URLPattern;
 class Blob;
 class File;
@@ -340,10 +341,14 @@ public:
       Worker::Lock& lock, kj::Maybe<ExportedHandler&> exportedHandler);
 
   // Start a scheduled event (called from C++, not JS). It is the caller's responsibility to wait
-  // for waitUntil()s in order to construct the final ScheduledResult.
+  // for waitUntil()s in order to construct the final ScheduledResult. shardIndex/shardCount
+  // identify this invocation's slice when one trigger is fanned out across parallel invocations;
+  // an unsharded invocation is shard 0 of 1.
   void startScheduled(
       kj::Date scheduledTime,
       kj::StringPtr cron,
+      uint32_t shardIndex,
+      uint32_t shardCount,
       Worker::Lock& lock, kj::Maybe<ExportedHandler&> exportedHandler);
 
   // Received runAlarm (called from C++, not JS).
@@ -547,6 +552,10 @@ public:
     JSG_NESTED_TYPE(TextEncoderStream);
     JSG_NESTED_TYPE(TextDecoderStream);
 
+    if (flags.getWorkerdExperimental()) {
+      JSG_NESTED_TYPE(JsonParseStream);
+    }
+
     JSG_NESTED_TYPE(Headers);
     JSG_NESTED_TYPE(Body);
     JSG_NESTED_TYPE(Request);
@@ -589,20 +598,23 @@ public:
     // Off-spec extensions.
     JSG_NESTED_TYPE(FixedLengthStream);
     JSG_NESTED_TYPE(IdentityTransformStream);
-    JSG_NESTED_TYPE(HTMLRewriter);
+    // HTMLRewriter pulls in the whole html-rewriter type family but is used by a small
+    // minority of workers; don't build its templates in every isolate.
+    JSG_LAZY_NESTED_TYPE(HTMLRewriter);
 
 #ifdef WORKERD_EXPERIMENTAL_ENABLE_WEBGPU
-    // WebGPU
-    JSG_NESTED_TYPE_NAMED(api::gpu::GPUAdapter, GPUAdapter);
-    JSG_NESTED_TYPE_NAMED(api::gpu::GPUOutOfMemoryError, GPUOutOfMemoryError);
-    JSG_NESTED_TYPE_NAMED(api::gpu::GPUValidationError, GPUValidationError);
-    JSG_NESTED_TYPE_NAMED(api::gpu::GPUInternalError, GPUInternalError);
-    JSG_NESTED_TYPE_NAMED(api::gpu::GPUDeviceLostInfo, GPUDeviceLostInfo);
-    JSG_NESTED_TYPE_NAMED(api::gpu::GPUBufferUsage, GPUBufferUsage);
-    JSG_NESTED_TYPE_NAMED(api::gpu::GPUShaderStage, GPUShaderStage);
-    JSG_NESTED_TYPE_NAMED(api::gpu::GPUMapMode, GPUMapMode);
-    JSG_NESTED_TYPE_NAMED(api::gpu::GPUTextureUsage, GPUTextureUsage);
-    JSG_NESTED_TYPE_NAMED(api::gpu::GPUColorWrite, GPUColorWrite);
+    // WebGPU. Registered lazily for the same reason as HTMLRewriter above: the family of GPU
+    // types is large and almost never touched.
+    JSG_LAZY_NESTED_TYPE_NAMED(api::gpu::GPUAdapter, GPUAdapter);
+    JSG_LAZY_NESTED_TYPE_NAMED(api::gpu::GPUOutOfMemoryError, GPUOutOfMemoryError);
+    JSG_LAZY_NESTED_TYPE_NAMED(api::gpu::GPUValidationError, GPUValidationError);
+    JSG_LAZY_NESTED_TYPE_NAMED(api::gpu::GPUInternalError, GPUInternalError);
+    JSG_LAZY_NESTED_TYPE_NAMED(api::gpu::GPUDeviceLostInfo, GPUDeviceLostInfo);
+    JSG_LAZY_NESTED_TYPE_NAMED(api::gpu::GPUBufferUsage, GPUBufferUsage);
+    JSG_LAZY_NESTED_TYPE_NAMED(api::gpu::GPUShaderStage, GPUShaderStage);
+    JSG_LAZY_NESTED_TYPE_NAMED(api::gpu::GPUMapMode, GPUMapMode);
+    JSG_LAZY_NESTED_TYPE_NAMED(api::gpu::GPUTextureUsage, GPUTextureUsage);
+    JSG_LAZY_NESTED_TYPE_NAMED(api::gpu::GPUColorWrite, GPUColorWrite);
 #endif
 
     JSG_TS_ROOT();
@@ -649,6 +649,35 @@ GPUDevice::createComputePipelineAsync(jsg::Lock& js, GPUComputePipelineDescripto
   return promise;
 }
 
+jsg::Promise<jsg::Ref<GPURenderPipeline>>
+GPUDevice::createRenderPipelineAsync(jsg::Lock& js, GPURenderPipelineDescriptor descriptor) {
+  auto parsedDesc = parseRenderPipelineDescriptor(descriptor);
+
+  // Same arrangement as createComputePipelineAsync() above. Dawn copies the descriptor during
+  // the CreateRenderPipelineAsync() call itself, so `parsedDesc` (and the strings it points into
+  // `descriptor`) only need to live until this function returns.
+  using MapAsyncContext = AsyncContext<jsg::Ref<GPURenderPipeline>>;
+  auto ctx = kj::heap<MapAsyncContext>(js, kj::addRef(*async_));
+  auto promise = kj::mv(ctx->promise_);
+  device_.CreateRenderPipelineAsync(
+      &parsedDesc.desc, wgpu::CallbackMode::AllowProcessEvents,
+      [ctx = kj::mv(ctx)](wgpu::CreatePipelineAsyncStatus status, wgpu::RenderPipeline pipeline,
+                          char const*) mutable {
+        // Note: this is invoked outside the JS isolate lock
+
+        switch (status) {
+        case wgpu::CreatePipelineAsyncStatus::Success:
+          ctx->fulfiller_->fulfill(jsg::alloc<GPURenderPipeline>(kj::mv(pipeline)));
+          break;
+        default:
+          ctx->fulfiller_->reject(JSG_KJ_EXCEPTION(FAILED, TypeError, "unknown error"));
+          break;
+        }
+      });
+
+  return promise;
+}
+
 jsg::Ref<GPUQueue> GPUDevice::getQueue() {
   auto queue = device_.GetQueue();
   return jsg::alloc<GPUQueue>(kj::mv(queue));
@@ -47,7 +47,9 @@ public:
     JSG_METHOD(createShaderModule);
     JSG_METHOD(createPipelineLayout);
     JSG_METHOD(createComputePipeline);
+    JSG_METHOD(createComputePipelineAsync);
     JSG_METHOD(createRenderPipeline);
+    JSG_METHOD(createRenderPipelineAsync);
     JSG_METHOD(createCommandEncoder);
     JSG_METHOD(createTexture);
     JSG_METHOD(destroy);
@@ -82,6 +84,8 @@ private:
   jsg::Ref<GPURenderPipeline> createRenderPipeline(GPURenderPipelineDescriptor descriptor);
   jsg::Promise<jsg::Ref<GPUComputePipeline>>
   createComputePipelineAsync(jsg::Lock& js, GPUComputePipelineDescriptor descriptor);
+  jsg::Promise<jsg::Ref<GPURenderPipeline>>
+  createRenderPipelineAsync(jsg::Lock& js, GPURenderPipelineDescriptor descriptor);
   jsg::Ref<GPUCommandEncoder>
   createCommandEncoder(jsg::Optional<GPUCommandEncoderDescriptor> descriptor);
   jsg::Ref<GPUQueue> getQueue();
@@ -208,8 +208,46 @@ struct UnregisteredDocumentHandlers {
   }
 };
 
+struct UnregisteredElementTransforms {
+  kj::Own<lol_html_Selector> selector;
+
+  // Declarative transforms contain only plain data (no JS values), so there is nothing to
+  // visit for GC.
+  HTMLRewriter::ElementTransforms transforms;
+
+  void visitForGc(jsg::GcVisitor& visitor) {}
+
+  JSG_MEMORY_INFO(UnregisteredElementTransforms) {}
+};
+
 using UnregisteredElementOrDocumentHandlers =
-    kj::OneOf<UnregisteredElementHandlers, UnregisteredDocumentHandlers>;
+    kj::OneOf<UnregisteredElementHandlers, UnregisteredDocumentHandlers,
+              UnregisteredElementTransforms>;
+
+// The Rewriter must own its own copy of any declarative transforms, since the HTMLRewriter
+// which holds the originals may be garbage collected while the transformed body is still
+// being pumped.
+HTMLRewriter::ElementTransforms cloneTransforms(const HTMLRewriter::ElementTransforms& t) {
+  using Dict = jsg::Dict<kj::String, kj::String>;
+  const auto cloneString = [](const kj::String& s) { return kj::str(s); };
+  return {
+    .setAttributes = t.setAttributes.map([](const Dict& d) {
+      return Dict { .fields = KJ_MAP(f, d.fields) {
+        return Dict::Field { .name = kj::str(f.name), .value = kj::str(f.value) };
+      }};
+    }),
+    .removeAttributes = t.removeAttributes.map([&](const kj::Array<kj::String>& names) {
+      return KJ_MAP(name, names) { return kj::str(name); };
+    }),
+    .prepend = t.prepend.map(cloneString),
+    .append = t.append.map(cloneString),
+    .before = t.before.map(cloneString),
+    .after = t.after.map(cloneString),
+    .html = t.html,
+    .remove = t.remove,
+    .removeAndKeepContent = t.removeAndKeepContent,
+  };
+}
 
 }  // namespace
 
@@ -280,6 +318,20 @@ private:
   kj::Vector<kj::Own<RegisteredHandler>> registeredEndTagHandlers;
   // TODO(perf) Don't store Owns, same as `registeredHandlers` above.
 
+  // A declarative element transform registered via HTMLRewriter::onElement(). Applied entirely
+  // natively by transformThunk(), without entering JS.
+  struct RegisteredTransforms {
+    Rewriter& rewriter;
+    HTMLRewriter::ElementTransforms transforms;
+  };
+
+  kj::Vector<kj::Own<RegisteredTransforms>> registeredTransforms;
+
+  static lol_html_rewriter_directive_t transformThunk(lol_html_element_t* element,
+                                                      void* userdata);
+  lol_html_rewriter_directive_t transformThunkImpl(lol_html_element_t* element,
+      HTMLRewriter::ElementTransforms& transforms);
+
   template <typename T, typename CType = typename T::CType>
   static lol_html_rewriter_directive_t thunk(CType* content, void* userdata);
   template <typename T, typename CType = typename T::CType>
@@ -297,7 +349,11 @@ private:
 
   kj::Own<WritableStreamSink> inner;
 
-  kj::Maybe<kj::Promise<void>> writePromise;
+  // Output produced by lol-html during the current write()/end() call. lol-html invokes the
+  // output callback many times per input chunk (every token it passes through becomes its own
+  // callback); buffering them here and issuing one write to `inner` per input chunk avoids a
+  // heap allocation, a promise chain node, and a downstream write per token.
+  kj::Vector<kj::byte> pendingOutput;
 
   kj::Maybe<kj::Exception> maybeException;
 
@@ -370,6 +426,19 @@ kj::Own<lol_html_HtmlRewriter> Rewriter::buildRewriter(
             end == kj::none ? nullptr : &Rewriter::thunk<DocumentEnd>,
             end.orDefault(nullptr));
       }
+      KJ_CASE_ONEOF(elementTransforms, UnregisteredElementTransforms) {
+        auto& registration = rewriter.registeredTransforms.add(
+            kj::heap<RegisteredTransforms>(RegisteredTransforms {
+                rewriter, cloneTransforms(elementTransforms.transforms) }));
+
+        check(lol_html_rewriter_builder_add_element_content_handlers(
+            builder,
+            elementTransforms.selector,
+            &Rewriter::transformThunk,
+            registration.get(),
+            nullptr, nullptr,
+            nullptr, nullptr));
+      }
     }
   }
 
@@ -482,8 +551,6 @@ void Rewriter::abort(kj::Exception reason) {
 kj::Promise<void> Rewriter::finishWrite() {
   maybeWaitScope = kj::none;
   auto checkException = [this]() -> kj::Promise<void> {
-    KJ_ASSERT(writePromise == kj::none);
-
     KJ_IF_SOME(exception, maybeException) {
       inner->abort(kj::cp(exception));
       return kj::cp(exception);
@@ -492,11 +559,15 @@ kj::Promise<void> Rewriter::finishWrite() {
     return kj::READY_NOW;
   };
 
-  KJ_IF_SOME(wp, writePromise) {
-    KJ_DEFER(writePromise = kj::none);
-    return wp.then([checkException]() {
-      return checkException();
-    });
+  if (pendingOutput.size() > 0) {
+    auto chunk = pendingOutput.releaseAsArray();
+    if (maybeException == kj::none) {
+      auto promise = inner->write(chunk.asPtr()).attach(kj::mv(chunk));
+      return promise.then([checkException]() {
+        return checkException();
+      });
+    }
+    // On error the output of the failed chunk is dropped; the stream is about to be aborted.
   }
 
   return checkException();
@@ -546,6 +617,64 @@ lol_html_rewriter_directive_t Rewriter::thunkImpl(
   return LOL_HTML_CONTINUE;
 }
 
+lol_html_rewriter_directive_t Rewriter::transformThunk(
+    lol_html_element_t* element, void* userdata) {
+  auto& registration = *reinterpret_cast<RegisteredTransforms*>(userdata);
+  return registration.rewriter.transformThunkImpl(element, registration.transforms);
+}
+
+lol_html_rewriter_directive_t Rewriter::transformThunkImpl(
+    lol_html_element_t* element, HTMLRewriter::ElementTransforms& transforms) {
+  if (isPoisoned()) {
+    // Handlers disabled due to exception.
+    KJ_LOG(ERROR, "poisoned rewriter should not be able to call handlers");
+    return LOL_HTML_STOP;
+  }
+
+  // Unlike thunkImpl(), this runs synchronously on whatever thread is driving the parser:
+  // declarative transforms touch only plain data, so there is no fiber wait and no trip
+  // through the isolate.
+  KJ_IF_SOME(exception, kj::runCatchingExceptions([&] {
+    bool isHtml = transforms.html.orDefault(false);
+
+    KJ_IF_SOME(attributes, transforms.setAttributes) {
+      for (auto& field: attributes.fields) {
+        check(lol_html_element_set_attribute(element,
+            field.name.cStr(), field.name.size(),
+            field.value.cStr(), field.value.size()));
+      }
+    }
+    KJ_IF_SOME(names, transforms.removeAttributes) {
+      for (auto& name: names) {
+        check(lol_html_element_remove_attribute(element, name.cStr(), name.size()));
+      }
+    }
+    KJ_IF_SOME(content, transforms.before) {
+      check(lol_html_element_before(element, content.cStr(), content.size(), isHtml));
+    }
+    KJ_IF_SOME(content, transforms.prepend) {
+      check(lol_html_element_prepend(element, content.cStr(), content.size(), isHtml));
+    }
+    KJ_IF_SOME(content, transforms.append) {
+      check(lol_html_element_append(element, content.cStr(), content.size(), isHtml));
+    }
+    KJ_IF_SOME(content, transforms.after) {
+      check(lol_html_element_after(element, content.cStr(), content.size(), isHtml));
+    }
+    if (transforms.remove.orDefault(false)) {
+      lol_html_element_remove(element);
+    } else if (transforms.removeAndKeepContent.orDefault(false)) {
+      lol_html_element_remove_and_keep_content(element);
+    }
+  })) {
+    // Same as thunkImpl(): we can't unwind with an exception across the Rust/C++ boundary, so
+    // record it and disable all later handlers.
+    maybePoison(kj::mv(exception));
+    return LOL_HTML_STOP;
+  }
+  return LOL_HTML_CONTINUE;
+}
+
 void Rewriter::removeEndTagHandler(RegisteredHandler& handler) {
   auto size = registeredEndTagHandlers.size();
   for (auto counter = size; counter != 0; --counter) {
@@ -614,14 +743,9 @@ void Rewriter::outputImpl(kj::ArrayPtr<const byte> buffer) {
     return;
   }
 
-  auto bufferCopy = kj::heapArray(buffer);
-  KJ_IF_SOME(wp, writePromise) {
-    writePromise = wp.then([this, bufferCopy = kj::mv(bufferCopy)]() mutable {
-      return inner->write(bufferCopy.asPtr()).attach(kj::mv(bufferCopy));
-    });
-  } else {
-    writePromise = inner->write(bufferCopy.asPtr()).attach(kj::mv(bufferCopy));
-  }
+  // The buffer lol-html hands us is only valid for the duration of this callback, so it has to
+  // be copied either way; accumulating it lets finishWrite() issue a single batched write.
+  pendingOutput.addAll(buffer);
 }
 
 // =======================================================================================
@@ -1011,6 +1135,9 @@ struct HTMLRewriter::Impl {
         KJ_CASE_ONEOF(h, UnregisteredDocumentHandlers) {
           tracker.trackField(nullptr, h);
         }
+        KJ_CASE_ONEOF(h, UnregisteredElementTransforms) {
+          tracker.trackField(nullptr, h);
+        }
       }
     }
   }
@@ -1042,6 +1169,20 @@ jsg::Ref<HTMLRewriter> HTMLRewriter::on(kj::String stringSelector, ElementConten
   return JSG_THIS;
 }
 
+jsg::Ref<HTMLRewriter> HTMLRewriter::onElement(
+    kj::String stringSelector, ElementTransforms&& transforms) {
+  kj::Own<lol_html_Selector> selector =
+      LOL_HTML_OWN(selector, lol_html_selector_parse(stringSelector.cStr(),
+                                                         stringSelector.size()));
+
+  impl->unregisteredHandlers.add(UnregisteredElementTransforms {
+    kj::mv(selector),
+    kj::mv(transforms)
+  });
+
+  return JSG_THIS;
+}
+
 jsg::Ref<HTMLRewriter> HTMLRewriter::onDocument(DocumentContentHandlers&& handlers) {
   impl->unregisteredHandlers.add(UnregisteredDocumentHandlers {
     kj::mv(handlers.doctype),
@@ -1104,6 +1245,9 @@ void HTMLRewriter::visitForGc(jsg::GcVisitor& visitor) {
       KJ_CASE_ONEOF(documentHandlers, UnregisteredDocumentHandlers) {
         visitor.visit(documentHandlers);
       }
+      KJ_CASE_ONEOF(elementTransforms, UnregisteredElementTransforms) {
+        // Plain data; nothing to visit.
+      }
     }
   }
 }
@@ -86,9 +86,34 @@ public:
     // Specify parameter types for callback functions
   };
 
+  // A declarative, handler-free description of element rewrites, registered via onElement().
+  // Unlike on(), transforms expressed this way are applied entirely in C++ when the element is
+  // parsed, without entering JavaScript per matched element. The snippet fields (prepend,
+  // append, before, after) are inserted verbatim when `html` is true, or entity-escaped when it
+  // is false or absent. `remove` takes precedence over `removeAndKeepContent`.
+  struct ElementTransforms {
+    jsg::Optional<jsg::Dict<kj::String, kj::String>> setAttributes;
+    jsg::Optional<kj::Array<kj::String>> removeAttributes;
+    jsg::Optional<kj::String> prepend;
+    jsg::Optional<kj::String> append;
+    jsg::Optional<kj::String> before;
+    jsg::Optional<kj::String> after;
+    jsg::Optional<bool> html;
+    jsg::Optional<bool> remove;
+    jsg::Optional<bool> removeAndKeepContent;
+
+    JSG_STRUCT(setAttributes, removeAttributes, prepend, append, before, after, html, remove,
+               removeAndKeepContent);
+  };
+
   jsg::Ref<HTMLRewriter> on(kj::String selector, ElementContentHandlers&& handlers);
   jsg::Ref<HTMLRewriter> onDocument(DocumentContentHandlers&& handlers);
 
+  // Non-standard extension: register declarative element transforms for a selector. These are
+  // evaluated natively inside the rewriter, so pages with thousands of matched elements skip
+  // the per-match JS boundary cost that on() handlers pay.
+  jsg::Ref<HTMLRewriter> onElement(kj::String selector, ElementTransforms&& transforms);
+
   // Register element or doctype content handlers. `handlers` must be unwrappable into a
   // ElementContentHandlers or DocumentContentHandlers struct, respectively. We take it as a
   // v8::Object so that we can use it as the `this` argument for the function calls.
@@ -105,6 +130,7 @@ public:
   JSG_RESOURCE_TYPE(HTMLRewriter) {
     JSG_METHOD(on);
     JSG_METHOD(onDocument);
+    JSG_METHOD(onElement);
     JSG_METHOD(transform);
   }
 
@@ -442,6 +468,7 @@ private:
   api::HTMLRewriter,                            \
   api::HTMLRewriter::ElementContentHandlers,    \
   api::HTMLRewriter::DocumentContentHandlers,   \
+  api::HTMLRewriter::ElementTransforms,         \
   api::Doctype,                                 \
   api::Element,                                 \
   api::EndTag,                                  \
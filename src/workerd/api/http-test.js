@@ -245,5 +245,35 @@ export const cacheMode = {
         message: "The 'cache' field on 'RequestInitializerDict' is not implemented.",
       });
     }
+
+    // Cloning headers preserves casing, multi-value headers, and is independent of the source.
+    {
+      const original = new Headers();
+      original.append("X-Custom-Name", "one");
+      original.append("x-custom-name", "two");
+      original.append("Set-Cookie", "a=1; Expires=Thu, 01 Jan 1970 00:00:00 GMT");
+      original.append("Set-Cookie", "b=2");
+      original.set("Content-Type", "text/plain");
+
+      const copy = new Headers(original);
+      assert.strictEqual(copy.get("x-custom-name"), "one, two");
+      assert.deepStrictEqual(copy.getSetCookie(),
+          ["a=1; Expires=Thu, 01 Jan 1970 00:00:00 GMT", "b=2"]);
+      assert.deepStrictEqual([...copy.keys()],
+          ["content-type", "set-cookie", "x-custom-name"]);
+
+      // Mutating the copy must not affect the original, and vice versa.
+      copy.set("Content-Type", "application/json");
+      copy.delete("x-custom-name");
+      original.append("X-Other", "yes");
+      assert.strictEqual(original.get("content-type"), "text/plain");
+      assert.strictEqual(original.get("x-custom-name"), "one, two");
+      assert.strictEqual(copy.get("x-other"), null);
+
+      // Headers cloned through a Request are independent as well.
+      const request = new Request("https://example.org", { headers: original });
+      original.delete("x-custom-name");
+      assert.strictEqual(request.headers.get("x-custom-name"), "one, two");
+    }
   }
 }
@@ -17,6 +17,7 @@
 #include <workerd/util/http-util.h>
 #include <workerd/util/mimetype.h>
 #include <workerd/util/stream-utils.h>
+#include <workerd/util/strings.h>
 #include <workerd/util/thread-scopes.h>
 #include <workerd/jsg/ser.h>
 #include <workerd/jsg/url.h>
@@ -84,33 +85,56 @@ jsg::ByteString normalizeHeaderValue(jsg::ByteString value) {
   return jsg::ByteString(kj::str(slice));
 }
 
+constexpr auto HTTP_SEPARATOR_CHARS = kj::parse::anyOfChars("()<>@,;:\\\"/[]?={} \t");
+// RFC2616 section 2.2: https://www.w3.org/Protocols/rfc2616/rfc2616-sec2.html#sec2.2
+
+constexpr auto HTTP_TOKEN_CHARS =
+    kj::parse::controlChar.orChar('\x7f')
+    .orGroup(kj::parse::whitespaceChar)
+    .orGroup(HTTP_SEPARATOR_CHARS)
+    .invert();
+// RFC2616 section 2.2: https://www.w3.org/Protocols/rfc2616/rfc2616-sec2.html#sec2.2
+// RFC2616 section 4.2: https://www.w3.org/Protocols/rfc2616/rfc2616-sec4.html#sec4.2
+
+// HTTP_TOKEN_CHARS.contains() flattened into a byte table so that the scan loops below can
+// index it without branching.
+struct HttpTokenTable {
+  bool isToken[256] = {};
+  constexpr HttpTokenTable() {
+    for (int i = 0; i < 256; i++) {
+      isToken[i] = HTTP_TOKEN_CHARS.contains(static_cast<char>(i));
+    }
+  }
+};
+constexpr HttpTokenTable HTTP_TOKEN_TABLE;
+
 void requireValidHeaderName(const jsg::ByteString& name) {
   // TODO(cleanup): Code duplication with kj/compat/http.c++
 
   warnIfBadHeaderString(name);
 
-  constexpr auto HTTP_SEPARATOR_CHARS = kj::parse::anyOfChars("()<>@,;:\\\"/[]?={} \t");
-  // RFC2616 section 2.2: https://www.w3.org/Protocols/rfc2616/rfc2616-sec2.html#sec2.2
-
-  constexpr auto HTTP_TOKEN_CHARS =
-      kj::parse::controlChar.orChar('\x7f')
-      .orGroup(kj::parse::whitespaceChar)
-      .orGroup(HTTP_SEPARATOR_CHARS)
-      .invert();
-  // RFC2616 section 2.2: https://www.w3.org/Protocols/rfc2616/rfc2616-sec2.html#sec2.2
-  // RFC2616 section 4.2: https://www.w3.org/Protocols/rfc2616/rfc2616-sec4.html#sec4.2
-
+  // Accumulate a single validity flag instead of throwing on the first bad byte: the
+  // branch-free loop compiles down to vector compares, and this check runs on every Headers
+  // mutation from JS. The error doesn't identify the offending byte either way.
+  bool valid = true;
   for (char c: name) {
-    JSG_REQUIRE(HTTP_TOKEN_CHARS.contains(c), TypeError, "Invalid header name.");
+    valid &= HTTP_TOKEN_TABLE.isToken[static_cast<unsigned char>(c)];
   }
+  JSG_REQUIRE(valid, TypeError, "Invalid header name.");
 }
 
 void requireValidHeaderValue(kj::StringPtr value) {
   // TODO(cleanup): Code duplication with kj/compat/http.c++
 
+  // As in requireValidHeaderName(), accumulate rather than branch per byte so the scan
+  // vectorizes. Values (e.g. cookies) can be kilobytes long.
+  bool valid = true;
   for (char c: value) {
-    JSG_REQUIRE(c != '\0' && c != '\r' && c != '\n', TypeError, "Invalid header value.");
+    valid &= c != '\0';
+    valid &= c != '\r';
+    valid &= c != '\n';
   }
+  JSG_REQUIRE(valid, TypeError, "Invalid header value.");
 }
 
 }  // namespace
@@ -124,23 +148,95 @@ Headers::Headers(jsg::Dict<jsg::ByteString, jsg::ByteString> dict)
 
 Headers::Headers(const Headers& other)
     : guard(Guard::NONE) {
+  // This copy constructor is on the hot path for every Request/Response construction that
+  // passes headers along, so it avoids the allocation-per-string approach: the total size of
+  // the source's string data is computed up front, everything is copied into one contiguous
+  // arena buffer owned by the new object, and the map entries just point into it. Since we
+  // iterate the source map in sorted order, entries can also be inserted with an end hint,
+  // making each insertion O(1).
+  size_t total = 0;
+  for (auto& header: other.headers) {
+    total += header.second.key.size() + 1;
+    total += header.second.name.size() + 1;
+    for (auto& value: header.second.values) {
+      total += value.size() + 1;
+    }
+  }
+
+  auto arena = kj::heapArray<char>(total);
+  char* pos = arena.begin();
+  const auto copyString = [&pos](kj::StringPtr source) {
+    char* start = pos;
+    memcpy(start, source.begin(), source.size());
+    pos += source.size();
+    *pos++ = '\0';
+    return jsg::ByteString(kj::String(start, source.size(), kj::NullArrayDisposer::instance));
+  };
+
   for (auto& header: other.headers) {
+    kj::Vector<jsg::ByteString> values(header.second.values.size());
+    for (auto& value: header.second.values) {
+      values.add(copyString(value));
+    }
     Header copy {
-      jsg::ByteString(kj::str(header.second.key)),
-      jsg::ByteString(kj::str(header.second.name)),
-      KJ_MAP(value, header.second.values) { return jsg::ByteString(kj::str(value)); },
+      copyString(header.second.key),
+      copyString(header.second.name),
+      kj::mv(values),
     };
     kj::StringPtr keyRef = copy.key;
-    KJ_ASSERT(headers.insert(std::make_pair(keyRef, kj::mv(copy))).second);
+    headers.emplace_hint(headers.end(), keyRef, kj::mv(copy));
+  }
+
+  KJ_DASSERT(pos == arena.end());
+  if (arena.size() > 0) {
+    stringArena.add(kj::mv(arena));
   }
 }
 
 Headers::Headers(const kj::HttpHeaders& other, Guard guard)
     : guard(Guard::NONE) {
-  other.forEach([this](auto name, auto value) {
-    append(jsg::ByteString(kj::str(name)), jsg::ByteString(kj::str(value)));
+  // This conversion runs for every incoming request and for every subrequest response, so it
+  // uses the same arena strategy as the copy constructor above: size all the string data in one
+  // pass, copy it into a single buffer, and make the map entries point into it. Names and values
+  // coming out of kj::HttpHeaders have already been validated by kj's HTTP parser, so the
+  // per-entry validation that append() would perform is skipped too.
+  size_t total = 0;
+  other.forEach([&](kj::StringPtr name, kj::StringPtr value) {
+    // Room for the cased name, the lower-cased key, and the value.
+    total += 2 * (name.size() + 1) + value.size() + 1;
+  });
+
+  auto arena = kj::heapArray<char>(total);
+  char* pos = arena.begin();
+  const auto copyString = [&pos](kj::StringPtr source) {
+    char* start = pos;
+    memcpy(start, source.begin(), source.size());
+    pos += source.size();
+    *pos++ = '\0';
+    return jsg::ByteString(kj::String(start, source.size(), kj::NullArrayDisposer::instance));
+  };
+
+  other.forEach([&](kj::StringPtr name, kj::StringPtr value) {
+    auto key = copyString(name);
+    toLowerAscii(key.begin(), key.size());
+    auto iter = headers.find(key);
+    if (iter == headers.end()) {
+      Header header(kj::mv(key), copyString(name), copyString(value));
+      kj::StringPtr keyRef = header.key;
+      headers.emplace(keyRef, kj::mv(header));
+    } else {
+      // Duplicate name: per the Fetch spec the first occurrence's casing wins, so only the
+      // value needs to be kept. (The bytes reserved for this occurrence's name copies simply
+      // go unused at the end of the arena.)
+      iter->second.values.add(copyString(value));
+    }
   });
 
+  KJ_DASSERT(pos <= arena.end());
+  if (arena.size() > 0) {
+    stringArena.add(kj::mv(arena));
+  }
+
   this->guard = guard;
 }
 
@@ -270,7 +366,7 @@ kj::ArrayPtr<jsg::ByteString> Headers::getSetCookie() {
 kj::ArrayPtr<jsg::ByteString> Headers::getAll(jsg::ByteString name) {
   requireValidHeaderName(name);
 
-  if (strcasecmp(name.cStr(), "set-cookie") != 0) {
+  if (!equalsIgnoreCase(name, "set-cookie"_kj)) {
     JSG_FAIL_REQUIRE(TypeError, "getAll() can only be used with the header name \"Set-Cookie\".");
   }
 
@@ -874,6 +970,23 @@ jsg::Promise<jsg::Ref<Blob>> Body::blob(jsg::Lock& js) {
 
 kj::Maybe<Body::ExtractedBody> Body::clone(jsg::Lock& js) {
   KJ_IF_SOME(i, impl) {
+    KJ_IF_SOME(b, i.buffer) {
+      // When the body was constructed from a buffer (text, bytes, blob, form data) and its
+      // stream hasn't been touched yet, there's no need to tee anything: the bytes are already
+      // refcounted, so both bodies can read them through independent streams. This keeps
+      // clone-then-cache patterns from re-buffering large static bodies through the tee --
+      // notably, a clone branch that is never consumed costs nothing, where a tee would have
+      // buffered the entire body waiting for it. If the stream has been partially read or is
+      // locked, fall through to the tee, which handles (or rejects) those cases.
+      if (!i.stream->isDisturbed() && !i.stream->isLocked()) {
+        return ExtractedBody {
+          jsg::alloc<ReadableStream>(IoContext::current(),
+              kj::heap<BodyBufferInputStream>(b.clone(js))),
+          b.clone(js)
+        };
+      }
+    }
+
     auto branches = i.stream->tee(js);
 
     i.stream = kj::mv(branches[0]);
@@ -1765,6 +1878,14 @@ jsg::Promise<jsg::Ref<Response>> fetchImplNoOutputLock(
 
   // TODO(cleanup): Don't convert to HttpClient. Use the HttpService interface instead. This
   //   requires a significant rewrite of the code below. It'll probably get simpler, though?
+  //
+  //   Note that this conversion is not a data-copy concern: the adapter returned by
+  //   kj::newHttpClient(HttpService&) bridges push-style bodies to pull-style via one-way
+  //   pipes, and kj's AsyncPipe collapses pumps through it so that bytes flow directly from
+  //   the producer to the ultimate consumer. In particular, when one worker proxies another
+  //   service's body through unmodified, the pump path stays native end-to-end (see
+  //   EncodedAsyncOutputStream::tryPumpFrom in system-streams.c++). The pipes do cost an
+  //   allocation and some bookkeeping per subrequest, which is what this TODO is about.
   kj::Own<kj::HttpClient> client = asHttpClient(fetcher->getClient(
       ioContext, jsRequest->serializeCfBlobJson(js), "fetch"_kjc));
 
@@ -2398,10 +2519,10 @@ jsg::Promise<Fetcher::QueueResult> Fetcher::queue(
 jsg::Promise<Fetcher::ScheduledResult> Fetcher::scheduled(
       jsg::Lock& js, jsg::Optional<ScheduledOptions> options) {
   auto& ioContext = IoContext::current();
-  auto worker = getClient(ioContext, kj::none, "scheduled"_kjc);
 
   auto scheduledTime = ioContext.now();
   auto cron = kj::String();
+  uint32_t shardCount = 1;
   KJ_IF_SOME(o, options) {
     KJ_IF_SOME(t, o.scheduledTime) {
       scheduledTime = t;
@@ -2409,14 +2530,37 @@ jsg::Promise<Fetcher::ScheduledResult> Fetcher::scheduled(
     KJ_IF_SOME(c, o.cron) {
       cron = kj::mv(c);
     }
+    KJ_IF_SOME(s, o.shards) {
+      JSG_REQUIRE(s >= 1, TypeError, "shards must be at least 1.");
+      shardCount = s;
+    }
   }
 
-  return ioContext.awaitIo(js, worker->runScheduled(scheduledTime, cron)
-      .attach(kj::mv(worker), kj::mv(cron)),
-      [](jsg::Lock& js, WorkerInterface::ScheduledResult result) {
+  // Each shard gets its own client so the invocations can run on parallel instances of the
+  // target service rather than queueing behind one another on a single one.
+  auto promises = kj::heapArrayBuilder<kj::Promise<WorkerInterface::ScheduledResult>>(shardCount);
+  for (uint32_t shardIndex = 0; shardIndex < shardCount; shardIndex++) {
+    auto worker = getClient(ioContext, kj::none, "scheduled"_kjc);
+    promises.add(worker->runScheduled(scheduledTime, cron, shardIndex, shardCount)
+        .attach(kj::mv(worker)));
+  }
+
+  return ioContext.awaitIo(js,
+      kj::joinPromisesFailFast(promises.finish()).attach(kj::mv(cron)),
+      [](jsg::Lock& js, kj::Array<WorkerInterface::ScheduledResult> results) {
+    // The trigger as a whole retries if any shard asked to retry; report the first non-ok
+    // outcome so a single failed shard isn't masked by its siblings.
+    bool retry = false;
+    EventOutcome outcome = EventOutcome::OK;
+    for (auto& result: results) {
+      retry = retry || result.retry;
+      if (outcome == EventOutcome::OK) {
+        outcome = result.outcome;
+      }
+    }
     return Fetcher::ScheduledResult{
-      .outcome=kj::str(result.outcome),
-      .noRetry=!result.retry,
+      .outcome=kj::str(outcome),
+      .noRetry=!retry,
     };
   });
 }
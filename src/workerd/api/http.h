@@ -215,6 +215,15 @@ private:
   Guard guard;
   std::map<kj::StringPtr, Header> headers;
 
+  // Backing storage for header strings created by the bulk-clone path. The copy constructor
+  // copies all of the source's string data into one contiguous buffer here and makes the map
+  // entries point into it (via NullArrayDisposer-backed strings), rather than performing a
+  // separate allocation per key, name, and value. Strings added through set()/append() own
+  // their memory individually as usual. Note that deleting an arena-backed header does not
+  // reclaim its bytes until the Headers object itself is destroyed; Headers objects are
+  // typically short-lived so this is a good trade.
+  kj::Vector<kj::Array<char>> stringArena;
+
   void checkGuard() {
     JSG_REQUIRE(guard == Guard::NONE, TypeError, "Can't modify immutable headers.");
   }
@@ -559,7 +568,12 @@ public:
     jsg::Optional<kj::Date> scheduledTime;
     jsg::Optional<kj::String> cron;
 
-    JSG_STRUCT(scheduledTime, cron);
+    // If set, fan the trigger out into this many parallel shard invocations. Each invocation
+    // sees its own shardIndex on the ScheduledController, letting one tick drive parallel work
+    // across instances of the service.
+    jsg::Optional<uint32_t> shards;
+
+    JSG_STRUCT(scheduledTime, cron, shards);
   };
 
   struct ScheduledResult {
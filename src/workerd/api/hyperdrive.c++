@@ -21,7 +21,17 @@ Hyperdrive::Hyperdrive(uint clientIndex, kj::String database,
       }
 
 jsg::Ref<Socket> Hyperdrive::connect(jsg::Lock& js) {
-  auto connPromise = connectToDb();
+  auto& context = IoContext::current();
+
+  kj::Promise<kj::Own<kj::AsyncIoStream>> connPromise = nullptr;
+  auto maybePrewarmed = takePrewarmedConnection();
+  KJ_IF_SOME(prewarmed, maybePrewarmed) {
+    connPromise = kj::mv(prewarmed);
+    // Replace the connection we just consumed so the next connect() in this burst is warm too.
+    prewarmConnection(context);
+  } else {
+    connPromise = connectToDb();
+  }
 
   auto paf = kj::newPromiseAndFulfiller<kj::Maybe<kj::Exception>>();
   auto conn = kj::newPromisedStream(connPromise.then(
@@ -74,10 +84,44 @@ uint16_t Hyperdrive::getPort() {
 }
 
 kj::String Hyperdrive::getConnectionString() {
+  // Fetching the connection string is a strong signal that a driver is about to connect();
+  // start establishing the connection now so it overlaps with the driver's own startup.
+  if (IoContext::hasCurrent()) {
+    prewarmConnection(IoContext::current());
+  }
   return kj::str(getScheme(), "://", getUser(), ":", getPassword(), "@", getHost(), ":", getPort(),
                  "/", getDatabase(), "?sslmode=disable");
 }
 
+void Hyperdrive::prewarmConnection(IoContext& context) {
+  KJ_IF_SOME(weak, prewarmContext) {
+    bool haveFresh = false;
+    weak->runIfAlive([&](IoContext& c) { haveFresh = c.isCurrent(); });
+    if (haveFresh) {
+      // A connection is already warming (or waiting) for this request.
+      return;
+    }
+  }
+  prewarmContext = context.getWeakRef();
+  prewarmedConnection = context.addObject(kj::heap(connectToDb().eagerlyEvaluate(nullptr)));
+}
+
+kj::Maybe<kj::Promise<kj::Own<kj::AsyncIoStream>>> Hyperdrive::takePrewarmedConnection() {
+  KJ_IF_SOME(weak, prewarmContext) {
+    bool sameContext = false;
+    weak->runIfAlive([&](IoContext& c) { sameContext = c.isCurrent(); });
+    // If the entry belongs to an earlier request its contents were already destroyed along with
+    // that request's context; either way our handles are no longer needed.
+    auto maybeOwned = kj::mv(prewarmedConnection);
+    prewarmContext = kj::none;
+    prewarmedConnection = kj::none;
+    if (sameContext) {
+      return kj::mv(*KJ_ASSERT_NONNULL(maybeOwned));
+    }
+  }
+  return kj::none;
+}
+
 kj::Promise<kj::Own<kj::AsyncIoStream>> Hyperdrive::connectToDb() {
   auto& context = IoContext::current();
   auto service = context.getSubrequestChannel(this->clientIndex,
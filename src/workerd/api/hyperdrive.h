@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <workerd/io/io-context.h>
 #include <workerd/jsg/jsg.h>
 #include <kj/async-io.h>
 
@@ -60,6 +61,17 @@ private:
   kj::String scheme;
   bool registeredConnectOverride = false;
 
+  // A connection established ahead of need, plus a weak ref to the IoContext it belongs to.
+  // Fetching the connection string starts one, and connect() consumes it and starts a
+  // replacement, so a burst of connections (e.g. a driver warming its pool) overlaps each setup
+  // round trip with the caller's own work instead of serializing behind it. Entries left over
+  // from an earlier request are detected via the weak ref and quietly dropped.
+  kj::Maybe<kj::Own<IoContext::WeakRef>> prewarmContext;
+  kj::Maybe<IoOwn<kj::Promise<kj::Own<kj::AsyncIoStream>>>> prewarmedConnection;
+
+  void prewarmConnection(IoContext& context);
+  kj::Maybe<kj::Promise<kj::Own<kj::AsyncIoStream>>> takePrewarmedConnection();
+
   kj::Promise<kj::Own<kj::AsyncIoStream>> connectToDb();
 };
 #define EW_HYPERDRIVE_ISOLATE_TYPES \
@@ -18,6 +18,10 @@ namespace workerd::api {
 // As documented in Cloudflare's Worker KV limits.
 static constexpr size_t kMaxKeyLength = 512;
 
+// Maximum number of keys that may be requested in a single getMany() call. Keeps a single bulk
+// subrequest from buffering an unbounded response body.
+static constexpr size_t kMaxBulkKeys = 100;
+
 static void checkForErrorStatus(kj::StringPtr method, const kj::HttpClient::Response& response) {
   if (response.statusCode < 200 || response.statusCode >= 300) {
     // Manually construct exception so that we can incorporate method and status into the text
@@ -235,6 +239,89 @@ jsg::Promise<KvNamespace::GetWithMetadataResult> KvNamespace::getWithMetadata(
   });
 }
 
+jsg::Promise<jsg::JsRef<jsg::JsValue>> KvNamespace::getMany(
+    jsg::Lock& js, kj::Array<kj::String> names,
+    jsg::Optional<kj::OneOf<kj::String, GetOptions>> options) {
+  return js.evalNow([&] {
+    JSG_REQUIRE(names.size() > 0, TypeError, "Requires at least one key to be requested.");
+    JSG_REQUIRE(names.size() <= kMaxBulkKeys, Error, "KV GET_BULK failed: ",
+        400, " Requested ", names.size(), " keys, exceeds limit of ", kMaxBulkKeys, ".");
+    for (const auto& name: names) {
+      validateKeyName("GET_BULK", name);
+    }
+
+    auto& context = IoContext::current();
+
+    kj::Maybe<kj::String> type;
+    kj::Maybe<int> cacheTtl;
+    KJ_IF_SOME(oneOfOptions, options) {
+      KJ_SWITCH_ONEOF(oneOfOptions) {
+        KJ_CASE_ONEOF(t, kj::String) {
+          type = kj::mv(t);
+        }
+        KJ_CASE_ONEOF(options, GetOptions) {
+          KJ_IF_SOME(t, options.type) {
+            type = kj::mv(t);
+          }
+          KJ_IF_SOME(ttl, options.cacheTtl) {
+            cacheTtl = ttl;
+          }
+        }
+      }
+    }
+    KJ_IF_SOME(t, type) {
+      JSG_REQUIRE(t == "text" || t == "json", TypeError,
+          "Unknown response type for bulk get. Possible types are \"text\" and \"json\".");
+    }
+
+    // Serialize the request through V8's JSON stringifier so that key names are escaped
+    // correctly no matter what they contain.
+    auto body = js.withinHandleScope([&] {
+      auto keys = KJ_MAP(name, names) { return jsg::JsValue(js.str(name)); };
+      auto obj = js.obj();
+      obj.set(js, "keys", js.arr(keys.asPtr()));
+      KJ_IF_SOME(t, type) {
+        obj.set(js, "type", js.str(t));
+      }
+      KJ_IF_SOME(ttl, cacheTtl) {
+        obj.set(js, "cacheTtl", js.num(ttl));
+      }
+      return jsg::JsValue(obj).toJson(js);
+    });
+
+    auto urlStr = kj::str("https://fake-host/bulk/get");
+
+    auto headers = kj::HttpHeaders(context.getHeaderTable());
+    headers.set(kj::HttpHeaderId::CONTENT_TYPE, MimeType::JSON.toString());
+    auto client = getHttpClient(context, headers, LimitEnforcer::KvOpType::GET, urlStr);
+
+    auto innerReq = client->request(
+        kj::HttpMethod::POST, urlStr, headers, uint64_t(body.size()));
+    auto promise = innerReq.body->write(body.asBytes())
+        .attach(kj::mv(body), kj::mv(innerReq.body))
+        .then([resp = kj::mv(innerReq.response)]() mutable { return kj::mv(resp); });
+
+    return context.awaitIo(js, kj::mv(promise),
+        [&context, client = kj::mv(client)]
+        (jsg::Lock& js, kj::HttpClient::Response&& response) mutable
+            -> jsg::Promise<jsg::JsRef<jsg::JsValue>> {
+
+      checkForErrorStatus("GET_BULK", response);
+
+      auto stream = newSystemStream(
+          response.body.attach(kj::mv(client)), getContentEncoding(context, *response.headers,
+              Response::BodyEncoding::AUTO, FeatureFlags::get(js)));
+
+      return context.awaitIo(js,
+          stream->readAllText(context.getLimitEnforcer().getBufferingLimit())
+              .attach(kj::mv(stream)),
+          [](jsg::Lock& js, kj::String text) {
+        return jsg::JsRef(js, jsg::JsValue::fromJson(js, text));
+      });
+    });
+  });
+}
+
 jsg::Promise<jsg::JsRef<jsg::JsValue>> KvNamespace::list(jsg::Lock& js,
                                                          jsg::Optional<ListOptions> options) {
   return js.evalNow([&] {
@@ -70,6 +70,16 @@ public:
       kj::String name,
       jsg::Optional<kj::OneOf<kj::String, GetOptions>> options);
 
+  // Fetch several keys in a single subrequest. The keys (and the requested value type, if any)
+  // are POSTed as a JSON body and the response is a single JSON object mapping each requested
+  // key to its value, or to null if the key does not exist. Only the "text" and "json" types are
+  // supported; "stream" and "arrayBuffer" don't make sense when many values share one response
+  // body.
+  jsg::Promise<jsg::JsRef<jsg::JsValue>> getMany(
+      jsg::Lock& js,
+      kj::Array<kj::String> names,
+      jsg::Optional<kj::OneOf<kj::String, GetOptions>> options);
+
   struct ListOptions {
     jsg::Optional<int> limit;
     jsg::Optional<kj::Maybe<kj::String>> prefix;
@@ -114,6 +124,7 @@ public:
     JSG_METHOD(list);
     JSG_METHOD(put);
     JSG_METHOD(getWithMetadata);
+    JSG_METHOD(getMany);
     JSG_METHOD_NAMED(delete, delete_);
 
     JSG_TS_ROOT();
@@ -156,6 +167,12 @@ public:
       getWithMetadata<Metadata = unknown>(key: Key, options: KVNamespaceGetOptions<"arrayBuffer">): Promise<KVNamespaceGetWithMetadataResult<ArrayBuffer, Metadata>>;
       getWithMetadata<Metadata = unknown>(key: Key, options: KVNamespaceGetOptions<"stream">): Promise<KVNamespaceGetWithMetadataResult<ReadableStream, Metadata>>;
 
+      getMany(keys: Key[], options?: Partial<KVNamespaceGetOptions<undefined>>): Promise<Record<Key, string | null>>;
+      getMany(keys: Key[], type: "text"): Promise<Record<Key, string | null>>;
+      getMany<ExpectedValue = unknown>(keys: Key[], type: "json"): Promise<Record<Key, ExpectedValue | null>>;
+      getMany(keys: Key[], options: KVNamespaceGetOptions<"text">): Promise<Record<Key, string | null>>;
+      getMany<ExpectedValue = unknown>(keys: Key[], options: KVNamespaceGetOptions<"json">): Promise<Record<Key, ExpectedValue | null>>;
+
       delete(key: Key): Promise<void>;
     });
   }
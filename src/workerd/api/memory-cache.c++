@@ -113,20 +113,43 @@ kj::Maybe<kj::Own<CacheValue>> SharedMemoryCache::getWhileLocked(
       return kj::none;
     }
 
-    // Obtain a reference to the cache value before we kj::mv the cache entry.
-    auto cacheValue = kj::atomicAddRef(*existingCacheEntry.value);
+    // Update the recency stamp. We deliberately don't touch `liveliness` (which
+    // would require re-sorting the liveliness index); eviction gives entries
+    // with a newer `lastUsed` a second chance instead.
+    existingCacheEntry.lastUsed.store(data.stepLiveliness(), std::memory_order_relaxed);
 
-    // Update the liveliness.
-    MemoryCacheEntry entry = data.cache.release(existingCacheEntry);
-    entry.liveliness = data.stepLiveliness();
-    data.cache.insert(kj::mv(entry));
-
-    return kj::mv(cacheValue);
+    return kj::atomicAddRef(*existingCacheEntry.value);
   } else {
     return kj::none;
   }
 }
 
+SharedMemoryCache::SharedLookup SharedMemoryCache::getFreshWhileSharedLocked(
+    const ThreadUnsafeData& data, const kj::String& key, uint32_t refreshWindowMs) const {
+  SharedLookup lookup;
+  KJ_IF_SOME(existingCacheEntry, data.cache.find(key)) {
+    if (hasExpired(existingCacheEntry.expiration)) {
+      // We only hold a shared lock, so we cannot erase the entry here. Tell the
+      // caller to retry with an exclusive lock, which will clean it up.
+      lookup.expired = true;
+      return lookup;
+    }
+
+    existingCacheEntry.lastUsed.store(data.stepLiveliness(), std::memory_order_relaxed);
+
+    if (refreshWindowMs > 0) {
+      KJ_IF_SOME(expiration, existingCacheEntry.expiration) {
+        if (IoContext::hasCurrent() && expiration - refreshWindowMs <= api::dateNow()) {
+          lookup.nearingExpiry = true;
+        }
+      }
+    }
+
+    lookup.value = kj::atomicAddRef(*existingCacheEntry.value);
+  }
+  return lookup;
+}
+
 void SharedMemoryCache::putWhileLocked(ThreadUnsafeData& data,
     const kj::String& key,
     kj::Own<CacheValue>&& value,
@@ -158,6 +181,7 @@ void SharedMemoryCache::putWhileLocked(ThreadUnsafeData& data,
       evictNextWhileLocked(data);
     }
     updatedEntry.liveliness = data.stepLiveliness();
+    updatedEntry.lastUsed.store(updatedEntry.liveliness, std::memory_order_relaxed);
     updatedEntry.value = kj::mv(value);
     updatedEntry.expiration = expiration;
     data.cache.insert(kj::mv(updatedEntry));
@@ -171,12 +195,7 @@ void SharedMemoryCache::putWhileLocked(ThreadUnsafeData& data,
     while (data.totalValueSize + valueSize > data.effectiveLimits.maxTotalValueSize) {
       evictNextWhileLocked(data);
     }
-    MemoryCacheEntry newEntry = {
-      kj::str(key),
-      data.stepLiveliness(),
-      kj::mv(value),
-      expiration,
-    };
+    MemoryCacheEntry newEntry(kj::str(key), data.stepLiveliness(), kj::mv(value), expiration);
     data.cache.insert(kj::mv(newEntry));
     data.totalValueSize += valueSize;
   }
@@ -198,10 +217,28 @@ void SharedMemoryCache::evictNextWhileLocked(
   }
 
   // Otherwise, if no entry has expired, evict the least recently used entry.
-  MemoryCacheEntry& leastRecentlyUsed = *data.cache.ordered<1>().begin();
-  KJ_ASSERT(data.totalValueSize >= leastRecentlyUsed.size());
-  data.totalValueSize -= leastRecentlyUsed.size();
-  data.cache.erase(leastRecentlyUsed);
+  // The liveliness index only reflects writes; reads merely bump the atomic
+  // `lastUsed` stamp. So an entry at the front of the index may have been read
+  // recently -- in that case, give it a second chance by re-inserting it with a
+  // fresh liveliness and consider the next candidate. This terminates: we hold
+  // the exclusive lock, so no stamps can change under us, and a re-inserted
+  // entry's new liveliness exceeds its stamp, so each entry gets at most one
+  // second chance per call.
+  for (;;) {
+    MemoryCacheEntry& leastRecentlyUsed = *data.cache.ordered<1>().begin();
+    if (leastRecentlyUsed.lastUsed.load(std::memory_order_relaxed) >
+        leastRecentlyUsed.liveliness) {
+      MemoryCacheEntry entry = data.cache.release(leastRecentlyUsed);
+      entry.liveliness = data.stepLiveliness();
+      entry.lastUsed.store(entry.liveliness, std::memory_order_relaxed);
+      data.cache.insert(kj::mv(entry));
+      continue;
+    }
+    KJ_ASSERT(data.totalValueSize >= leastRecentlyUsed.size());
+    data.totalValueSize -= leastRecentlyUsed.size();
+    data.cache.erase(leastRecentlyUsed);
+    return;
+  }
 }
 
 void SharedMemoryCache::removeIfExistsWhileLocked(
@@ -225,12 +262,16 @@ kj::Own<const SharedMemoryCache> SharedMemoryCache::create(
   return kj::atomicRefcounted<const SharedMemoryCache>(provider, id, handler);
 }
 
-SharedMemoryCache::Use::Use(kj::Own<const SharedMemoryCache> cache, const Limits& limits)
-    : cache(kj::mv(cache)), limits(limits) {
+SharedMemoryCache::Use::Use(
+    kj::Own<const SharedMemoryCache> cache, const Limits& limits, uint32_t asyncRefreshWindowMs)
+    : cache(kj::mv(cache)), limits(limits), asyncRefreshWindowMs(asyncRefreshWindowMs) {
   this->cache->suggest(limits);
 }
 
-SharedMemoryCache::Use::Use(Use&& other): cache(kj::mv(other.cache)), limits(other.limits) {
+SharedMemoryCache::Use::Use(Use&& other)
+    : cache(kj::mv(other.cache)),
+      limits(other.limits),
+      asyncRefreshWindowMs(other.asyncRefreshWindowMs) {
   this->cache->suggest(limits);
 }
 
@@ -242,13 +283,62 @@ SharedMemoryCache::Use::~Use() noexcept(false) {
 
 kj::Maybe<kj::Own<CacheValue>> SharedMemoryCache::Use::getWithoutFallback(
     const kj::String& key) const {
+  {
+    // Fast path: a fresh hit only needs a shared lock, so concurrent readers
+    // don't contend with each other. Without a fallback there is nothing to
+    // refresh ahead of time, so we pass a zero window.
+    auto data = cache->data.lockShared();
+    auto lookup = cache->getFreshWhileSharedLocked(*data, key, 0);
+    KJ_IF_SOME(existingValue, lookup.value) {
+      return kj::mv(existingValue);
+    }
+    if (!lookup.expired) {
+      // A plain miss; there's nothing an exclusive lock would add.
+      return kj::none;
+    }
+  }
+
+  // The entry expired; take the exclusive lock so it gets erased.
   auto data = cache->data.lockExclusive();
   return cache->getWhileLocked(*data, key);
 }
 
-kj::OneOf<kj::Own<CacheValue>, kj::Promise<SharedMemoryCache::Use::GetWithFallbackOutcome>>
+kj::OneOf<kj::Own<CacheValue>,
+    SharedMemoryCache::Use::RefreshAhead,
+    kj::Promise<SharedMemoryCache::Use::GetWithFallbackOutcome>>
 SharedMemoryCache::Use::getWithFallback(const kj::String& key) const {
+  kj::Maybe<kj::Own<CacheValue>> valueNearingExpiry;
+  {
+    // Fast path: a fresh hit only needs a shared lock. A miss (or an expired
+    // entry) falls through to the exclusive path below, which may need to
+    // erase the entry and register an in-progress fallback. A hit that is
+    // about to expire also falls through (with the value in hand) so that a
+    // background refresh can be registered under the exclusive lock.
+    auto data = cache->data.lockShared();
+    auto lookup = cache->getFreshWhileSharedLocked(*data, key, asyncRefreshWindowMs);
+    KJ_IF_SOME(existingValue, lookup.value) {
+      if (!lookup.nearingExpiry) {
+        return kj::mv(existingValue);
+      }
+      valueNearingExpiry = kj::mv(existingValue);
+    }
+  }
+
   auto data = cache->data.lockExclusive();
+
+  KJ_IF_SOME(existingValue, valueNearingExpiry) {
+    // The value is still fresh, so we serve it either way, but it expires
+    // soon: start a fallback in the background unless one is already in
+    // flight. This keeps the latency at expiry boundaries flat: instead of
+    // some unlucky request paying the fallback's full latency after the entry
+    // expires, the refresh happens while stale-but-valid reads continue to be
+    // served.
+    if (data->inProgress.find(key) == kj::none) {
+      auto& newEntry = data->inProgress.insert(kj::heap<InProgress>(kj::str(key)));
+      return RefreshAhead{kj::mv(existingValue), prepareFallback(*newEntry)};
+    }
+    return kj::mv(existingValue);
+  }
   KJ_IF_SOME(existingValue, cache->getWhileLocked(*data, key)) {
     return kj::mv(existingValue);
   } else KJ_IF_SOME(existingInProgress, data->inProgress.find(key)) {
@@ -379,6 +469,38 @@ jsg::Promise<jsg::JsRef<jsg::JsValue>> MemoryCache::read(jsg::Lock& js,
         jsg::Deserializer deserializer(js, result->bytes.asPtr());
         return js.resolvedPromise(jsg::JsRef(js, deserializer.readValue(js)));
       }
+      KJ_CASE_ONEOF(refreshAhead, SharedMemoryCache::Use::RefreshAhead) {
+        // The cached value is still fresh but expires soon. Serve it without
+        // releasing the isolate lock, but run the fallback in the background
+        // (attached to the request's waitUntil tasks) to renew the entry
+        // before it actually expires.
+        auto& context = IoContext::current();
+        auto heapCallback = kj::heap(kj::mv(refreshAhead.refresh));
+
+        auto backgroundRefresh = js.evalNow([&]() { return fallback(js, kj::str(key.value)); })
+            .then(js,
+                [callback = context.addObject(*heapCallback)](
+                    jsg::Lock& js, CacheValueProduceResult result) mutable {
+          auto serialized = hackySerialize(js, result.value);
+          KJ_IF_SOME(expiration, result.expiration) {
+            JSG_REQUIRE(!kj::isNaN(expiration), TypeError, "Expiration time must not be NaN.");
+          }
+          (*callback)(SharedMemoryCache::Use::FallbackResult{
+            kj::mv(serialized), result.expiration});
+        })
+            .catch_(js,
+                [callback = context.addObject(kj::mv(heapCallback))](
+                    jsg::Lock& js, jsg::Value&& exception) mutable {
+          // The refresh failed. The cached value remains in place until it
+          // expires and the error is not observable by this read; reporting
+          // the failure lets queued fallbacks (if any) take over.
+          (*callback)(kj::none);
+        });
+        context.addWaitUntil(context.awaitJs(js, kj::mv(backgroundRefresh)));
+
+        jsg::Deserializer deserializer(js, refreshAhead.value->bytes.asPtr());
+        return js.resolvedPromise(jsg::JsRef(js, deserializer.readValue(js)));
+      }
       KJ_CASE_ONEOF(promise, kj::Promise<SharedMemoryCache::Use::GetWithFallbackOutcome>) {
         return IoContext::current().awaitIo(js, kj::mv(promise),
             [fallback = kj::mv(fallback), key = kj::str(key.value)](
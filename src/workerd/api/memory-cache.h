@@ -7,6 +7,7 @@
 #include <kj/map.h>
 #include <kj/mutex.h>
 #include <kj/table.h>
+#include <atomic>
 #include <set>
 
 namespace workerd::api {
@@ -38,21 +39,48 @@ struct CacheValue: kj::AtomicRefcounted {
 };
 
 struct MemoryCacheEntry {
+  MemoryCacheEntry(
+      kj::String key, uint64_t liveliness, kj::Own<CacheValue> value, kj::Maybe<double> expiration)
+      : key(kj::mv(key)),
+        liveliness(liveliness),
+        lastUsed(liveliness),
+        value(kj::mv(value)),
+        expiration(expiration) {}
+
+  // kj::Table moves rows around, but std::atomic is not movable, so we spell
+  // out the move operations. Rows are only ever moved under the cache's
+  // exclusive lock, so relaxed loads are sufficient here.
+  MemoryCacheEntry(MemoryCacheEntry&& other)
+      : key(kj::mv(other.key)),
+        liveliness(other.liveliness),
+        lastUsed(other.lastUsed.load(std::memory_order_relaxed)),
+        value(kj::mv(other.value)),
+        expiration(other.expiration) {}
+  MemoryCacheEntry& operator=(MemoryCacheEntry&& other) {
+    key = kj::mv(other.key);
+    liveliness = other.liveliness;
+    lastUsed.store(other.lastUsed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    value = kj::mv(other.value);
+    expiration = other.expiration;
+    return *this;
+  }
+
   // The key that this entry is associated with.
   kj::String key;
 
-  // Whenever an entry is created, updated, or retrieved, its liveliness is
-  // set to the value of a monotonically increasing counter.
+  // Whenever an entry is created or updated, its liveliness is set to the
+  // value of a monotonically increasing counter. This is the key of the
+  // liveliness index, so it must only change while the entry is released from
+  // the table (and thus only under the exclusive lock).
   uint64_t liveliness;
   // TODO(cleanup): The liveliness index accomplishes the same thing as
   //   kj::InsertionOrderIndex.
-  //
-  // TODO(perf): Updating a cache entry's liveliness requires a re-insertion,
-  //   which means that cache reads require an exclusive lock. This may be
-  //   suboptimal for a read-heavy workload. WorkerSet avoids this by atomically
-  //   updating a `lastUsed` timestamp. The tradeoff is that LRU-eviction
-  //   becomes O(n) instead of O(1), since we can no longer use kj::Table's
-  //   index to find the LRU entry.
+
+  // Reads, on the other hand, only bump this atomic stamp, so that fresh cache
+  // hits can be served under a shared lock without re-sorting the liveliness
+  // index. Eviction compares `lastUsed` against `liveliness` to give entries
+  // that have been read since their last write a second chance instead.
+  mutable std::atomic<uint64_t> lastUsed;
 
   // The stored JavaScript value, serialized by V8. It is atomicRefcounted to
   // allow threads to deserialize the value without having to lock the cache,
@@ -164,7 +192,8 @@ public:
   public:
     KJ_DISALLOW_COPY(Use);
 
-    Use(kj::Own<const SharedMemoryCache> cache, const Limits& limits);
+    Use(kj::Own<const SharedMemoryCache> cache, const Limits& limits,
+        uint32_t asyncRefreshWindowMs = 0);
     Use(Use&& other);
     ~Use() noexcept(false);
 
@@ -180,13 +209,25 @@ public:
     typedef kj::Function<void(kj::Maybe<FallbackResult>)> FallbackDoneCallback;
     using GetWithFallbackOutcome = kj::OneOf<kj::Own<CacheValue>, FallbackDoneCallback>;
 
+    // Returned instead of a plain value when the cached value is still fresh
+    // but within the configured refresh-ahead window of its expiration. The
+    // caller should serve `value` immediately and invoke the fallback function
+    // in the background, reporting its outcome through `refresh`.
+    struct RefreshAhead {
+      kj::Own<CacheValue> value;
+      FallbackDoneCallback refresh;
+    };
+
     // Returns either:
-    // 1. The immediate value, if already in cache.
+    // 1. The immediate value, if already in cache. If the value is about to
+    //    expire and this Use was configured with a refresh-ahead window, the
+    //    value arrives as a RefreshAhead so the caller can renew it in the
+    //    background.
     // 2. A Promise that will eventually resolve either to the cached value
     //    or to a FallbackDoneCallback. In the latter case, the caller should
     //    invoke the fallback function.
-    kj::OneOf<kj::Own<CacheValue>, kj::Promise<GetWithFallbackOutcome>> getWithFallback(
-        const kj::String& key) const;
+    kj::OneOf<kj::Own<CacheValue>, RefreshAhead, kj::Promise<GetWithFallbackOutcome>>
+    getWithFallback(const kj::String& key) const;
 
   private:
     // Creates a new FallbackDoneCallback associated with the given
@@ -206,6 +247,12 @@ public:
 
     kj::Own<const SharedMemoryCache> cache;
     Limits limits;
+
+    // If nonzero, getWithFallback() treats a hit whose expiration is at most
+    // this many milliseconds away as a candidate for refresh-ahead: the stale
+    // value is served immediately while a fallback is started in the
+    // background. Zero disables refresh-ahead.
+    uint32_t asyncRefreshWindowMs;
   };
 
 private:
@@ -263,6 +310,26 @@ private:
   kj::Maybe<kj::Own<CacheValue>> getWhileLocked(
       ThreadUnsafeData& data, const kj::String& key) const;
 
+  struct SharedLookup {
+    // The cached value, if the entry exists and has not expired. The entry's
+    // `lastUsed` stamp has been bumped atomically.
+    kj::Maybe<kj::Own<CacheValue>> value;
+
+    // The entry exists but has expired. An exclusive lock is needed to erase
+    // it, so the caller should retry via getWhileLocked().
+    bool expired = false;
+
+    // The value is fresh but expires within `refreshWindowMs` milliseconds.
+    bool nearingExpiry = false;
+  };
+
+  // Like getWhileLocked(), but requires only a shared lock and hence cannot
+  // modify the table itself. If `refreshWindowMs` is nonzero and the lookup is
+  // performed within an I/O context, hits close to their expiration are
+  // flagged so that the caller can refresh them ahead of time.
+  SharedLookup getFreshWhileSharedLocked(
+      const ThreadUnsafeData& data, const kj::String& key, uint32_t refreshWindowMs) const;
+
   // Stores a value in the cache, with an optional expiration timestamp. It is
   // marked as the most recently used entry.
   void putWhileLocked(ThreadUnsafeData& data,
@@ -392,13 +459,16 @@ public:
     Limits effectiveLimits = Limits::min();
 
     // Returns the next liveliness and increments it so that the next call to
-    // this function will return a different value.
-    inline uint64_t stepLiveliness() { return nextLiveliness++; }
+    // this function will return a different value. This is atomic (and const)
+    // because the shared-lock read path uses it to stamp `lastUsed`.
+    inline uint64_t stepLiveliness() const {
+      return nextLiveliness.fetch_add(1, std::memory_order_relaxed);
+    }
 
     // We do not handle integer overflow, but a 64-bit counter should never wrap
     // around, at least not in the foreseeable future. (Even at a billion cache
     // operations per second, it would take almost 600 years.)
-    uint64_t nextLiveliness = 0;
+    mutable std::atomic<uint64_t> nextLiveliness = 0;
 
     // The sum of the sizes of all values that are currently stored in the cache.
     // This is technically redundant information, but more efficient than
@@ -425,9 +495,12 @@ public:
 
 private:
 
-  // To ensure thread-safety, all mutable data is guarded by a mutex. Each cache
-  // operation requires an exclusive lock. Even read-only operations need to
-  // update the liveliness of cache entries, which currently requires a lock.
+  // To ensure thread-safety, all mutable data is guarded by a mutex. Writes
+  // (including misses, which may need to register a fallback, and expired
+  // entries, which are erased eagerly) require an exclusive lock. Fresh read
+  // hits only take a shared lock: updating an entry's recency is done by
+  // atomically bumping its `lastUsed` stamp, so concurrent readers don't
+  // contend with each other.
   kj::MutexGuarded<ThreadUnsafeData> data;
 
   // The MemoryCacheProvider instance needs to be guaranteed to outlive the SharedMemoryCache
@@ -28,6 +28,20 @@
 #include <cstddef>
 #include <cstdint>
 
+// Vectorized fast paths for the overwhelmingly common case of well-formed base64. These are
+// compile-time dispatched: SSSE3 on x86-64 (enabled in our release builds), NEON on arm64
+// (always available). The scalar code below remains both the fallback for other targets and
+// the cleanup path for inputs containing whitespace, padding, or mixed alphabets.
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define WORKERD_BASE64_SIMD 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define WORKERD_BASE64_SIMD 1
+#else
+#define WORKERD_BASE64_SIMD 0
+#endif
+
 
 namespace workerd::api::node {
 
@@ -69,6 +83,10 @@ inline size_t base64_encode(const char* src,
                             size_t dlen,
                             Base64Mode mode = Base64Mode::NORMAL);
 
+static constexpr char base64_table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                       "abcdefghijklmnopqrstuvwxyz"
+                                       "0123456789+/";
+
 static constexpr char base64_table_url[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
                                            "abcdefghijklmnopqrstuvwxyz"
                                            "0123456789-_";
@@ -88,6 +106,191 @@ inline uint32_t ReadUint32BE(const unsigned char* p) {
          static_cast<uint32_t>(p[3]);
 }
 
+#if WORKERD_BASE64_SIMD
+
+// The vector kernels below are the well-known pshufb-based algorithms by Wojciech Muła et al.
+// (the same family of kernels Node.js picked up via simdutf). Decoding validates each block
+// against the *standard* alphabet only; any block containing whitespace, '=', or base64url
+// characters fails validation and is left for the scalar decoder, which implements the full
+// permissive Node.js semantics.
+
+#if defined(__SSSE3__)
+
+// Decodes whole 16-character blocks of `src` (standard alphabet only) into 12-byte groups,
+// advancing `*i` and `*k` past everything decoded. Stops at the first block that is not pure
+// base64 or when the remaining input/output is too short for a full block.
+inline void base64_decode_simd(char* const dst, const size_t available,
+                               const char* const src, const size_t srclen,
+                               size_t* const i, size_t* const k) {
+  const __m128i lut_lo = _mm_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m128i lut_hi = _mm_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m128i lut_roll = _mm_setr_epi8(
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i mask_0f = _mm_set1_epi8(0x0f);
+  const __m128i mask_2f = _mm_set1_epi8(0x2f);
+
+  // Each iteration stores 16 bytes (of which only 12 are meaningful), so leave headroom in the
+  // output; the scalar loop finishes the tail.
+  while (*i + 16 <= srclen && *k + 16 <= available) {
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + *i));
+
+    const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(in, 4), mask_0f);
+    const __m128i lo_nibbles = _mm_and_si128(in, mask_0f);
+    const __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+    const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(
+            _mm_and_si128(lo, hi), _mm_setzero_si128())) != 0xFFFF) {
+      // Not a clean block; let the scalar decoder sort it out.
+      return;
+    }
+
+    const __m128i eq_2f = _mm_cmpeq_epi8(in, mask_2f);
+    const __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2f, hi_nibbles));
+    const __m128i values = _mm_add_epi8(in, roll);
+
+    // Pack the 16 six-bit values into 12 bytes.
+    const __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    __m128i packed = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+    packed = _mm_shuffle_epi8(packed, _mm_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + *k), packed);
+    *i += 16;
+    *k += 12;
+  }
+}
+
+// Translates 16 six-bit indices to base64 characters.
+inline __m128i base64_encode_translate_simd(const __m128i indices, const Base64Mode mode) {
+  __m128i classes = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  classes = _mm_or_si128(classes, _mm_and_si128(less, _mm_set1_epi8(13)));
+  const __m128i shift_lut = mode == Base64Mode::NORMAL
+      ? _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                      '/' - 63, 'A', 0, 0)
+      : _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62,
+                      '_' - 63, 'A', 0, 0);
+  return _mm_add_epi8(indices, _mm_shuffle_epi8(shift_lut, classes));
+}
+
+// Encodes whole 12-byte groups of `src` into 16-character blocks, advancing `*i` and `*k`.
+// The scalar loop handles whatever remains.
+inline void base64_encode_simd(const char* const src, const size_t slen,
+                               char* const dst, const Base64Mode mode,
+                               size_t* const i, size_t* const k) {
+  // Each iteration loads 16 bytes but only consumes 12, so stay a full vector away from the end.
+  while (*i + 16 <= slen) {
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + *i));
+
+    // Duplicate each 3-byte group into a 4-byte lane, then split out the four 6-bit fields.
+    in = _mm_shuffle_epi8(in, _mm_setr_epi8(
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    const __m128i indices = _mm_or_si128(t1, t3);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + *k),
+                     base64_encode_translate_simd(indices, mode));
+    *i += 12;
+    *k += 16;
+  }
+}
+
+#else  // NEON
+
+// Decodes whole 64-character blocks of `src` (standard alphabet only) into 48-byte groups,
+// advancing `*i` and `*k` past everything decoded. Stops at the first block that is not pure
+// base64 or when the remaining input/output is too short for a full block.
+inline void base64_decode_simd(char* const dst, const size_t available,
+                               const char* const src, const size_t srclen,
+                               size_t* const i, size_t* const k) {
+  const uint8x16_t lut_lo = {
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A};
+  const uint8x16_t lut_hi = {
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10};
+  const uint8x16_t lut_roll = {
+      0, 16, 19, 4, 256 - 65, 256 - 65, 256 - 71, 256 - 71, 0, 0, 0, 0, 0, 0, 0, 0};
+
+  while (*i + 64 <= srclen && *k + 48 <= available) {
+    const uint8x16x4_t in = vld4q_u8(reinterpret_cast<const uint8_t*>(src + *i));
+
+    uint8x16_t error = vdupq_n_u8(0);
+    uint8x16_t values[4];
+    for (int j = 0; j < 4; j++) {
+      const uint8x16_t v = in.val[j];
+      const uint8x16_t hi_nibbles = vshrq_n_u8(v, 4);
+      const uint8x16_t lo_nibbles = vandq_u8(v, vdupq_n_u8(0x0f));
+      error = vorrq_u8(error, vandq_u8(vqtbl1q_u8(lut_lo, lo_nibbles),
+                                       vqtbl1q_u8(lut_hi, hi_nibbles)));
+      const uint8x16_t eq_2f = vceqq_u8(v, vdupq_n_u8(0x2f));
+      const uint8x16_t roll = vqtbl1q_u8(lut_roll, vaddq_u8(hi_nibbles, eq_2f));
+      values[j] = vaddq_u8(v, roll);
+    }
+
+    if (vmaxvq_u8(error) != 0) {
+      // Not a clean block; let the scalar decoder sort it out.
+      return;
+    }
+
+    uint8x16x3_t out;
+    out.val[0] = vorrq_u8(vshlq_n_u8(values[0], 2), vshrq_n_u8(values[1], 4));
+    out.val[1] = vorrq_u8(vshlq_n_u8(values[1], 4), vshrq_n_u8(values[2], 2));
+    out.val[2] = vorrq_u8(vshlq_n_u8(values[2], 6), values[3]);
+    vst3q_u8(reinterpret_cast<uint8_t*>(dst + *k), out);
+
+    *i += 64;
+    *k += 48;
+  }
+}
+
+// Encodes whole 48-byte groups of `src` into 64-character blocks, advancing `*i` and `*k`.
+// The scalar loop handles whatever remains.
+inline void base64_encode_simd(const char* const src, const size_t slen,
+                               char* const dst, const Base64Mode mode,
+                               size_t* const i, size_t* const k) {
+  // vqtbl4q covers a full 64-byte lookup table, so translation is a direct table lookup.
+  const char* const table = mode == Base64Mode::NORMAL ? base64_table : base64_table_url;
+  const uint8x16x4_t lut = {
+      vld1q_u8(reinterpret_cast<const uint8_t*>(table)),
+      vld1q_u8(reinterpret_cast<const uint8_t*>(table + 16)),
+      vld1q_u8(reinterpret_cast<const uint8_t*>(table + 32)),
+      vld1q_u8(reinterpret_cast<const uint8_t*>(table + 48))};
+
+  while (*i + 48 <= slen) {
+    const uint8x16x3_t in = vld3q_u8(reinterpret_cast<const uint8_t*>(src + *i));
+
+    uint8x16x4_t out;
+    out.val[0] = vshrq_n_u8(in.val[0], 2);
+    out.val[1] = vorrq_u8(vshlq_n_u8(vandq_u8(in.val[0], vdupq_n_u8(0x03)), 4),
+                          vshrq_n_u8(in.val[1], 4));
+    out.val[2] = vorrq_u8(vshlq_n_u8(vandq_u8(in.val[1], vdupq_n_u8(0x0f)), 2),
+                          vshrq_n_u8(in.val[2], 6));
+    out.val[3] = vandq_u8(in.val[2], vdupq_n_u8(0x3f));
+    for (int j = 0; j < 4; j++) {
+      out.val[j] = vqtbl4q_u8(lut, out.val[j]);
+    }
+    vst4q_u8(reinterpret_cast<uint8_t*>(dst + *k), out);
+
+    *i += 48;
+    *k += 64;
+  }
+}
+
+#endif
+
+#endif  // WORKERD_BASE64_SIMD
+
 #ifdef _MSC_VER
 #pragma warning(push)
 // MSVC C4003: not enough actual parameters for macro 'identifier'
@@ -133,6 +336,13 @@ size_t base64_decode_fast(char* const dst, const size_t dstlen,
   size_t max_i = srclen / 4 * 4;
   size_t i = 0;
   size_t k = 0;
+#if WORKERD_BASE64_SIMD
+  if constexpr (sizeof(TypeName) == 1) {
+    // Bulk-decode clean blocks; always advances i by a multiple of 4, so the scalar loop below
+    // picks up cleanly wherever it stops.
+    base64_decode_simd(dst, available, reinterpret_cast<const char*>(src), srclen, &i, &k);
+  }
+#endif
   while (i < max_i && k < max_k) {
     const unsigned char txt[] = {
         static_cast<unsigned char>(unbase64(static_cast<uint8_t>(src[i + 0]))),
@@ -185,6 +395,9 @@ size_t base64_decode(char* const dst, const size_t dstlen,
 }
 
 
+// Encodes to standard padded base64 in NORMAL mode and to unpadded base64url in URL mode,
+// matching Node.js' toString('base64') / toString('base64url') output. `dst` must have room
+// for base64_encoded_size(slen, mode) characters.
 inline size_t base64_encode(const char* src,
                             size_t slen,
                             char* dst,
@@ -192,25 +405,25 @@ inline size_t base64_encode(const char* src,
                             Base64Mode mode) {
   dlen = base64_encoded_size(slen, mode);
 
-  // Node.js introduced a SIMD-capable fast base64 encoder as a dependency.
-  // if (mode == Base64Mode::NORMAL) {
-  //   ::base64_encode(src, slen, dst, &dlen, 0);
-  //   return dlen;
-  // }
-
   unsigned a;
   unsigned b;
   unsigned c;
-  unsigned i;
-  unsigned k;
-  unsigned n;
+  size_t i;
+  size_t k;
+  size_t n;
 
-  const char* table = base64_table_url;
+  const char* table = mode == Base64Mode::NORMAL ? base64_table : base64_table_url;
 
   i = 0;
   k = 0;
   n = slen / 3 * 3;
 
+#if WORKERD_BASE64_SIMD
+  // Bulk-encode whole vector blocks; always advances i by a multiple of 3, so the scalar loop
+  // below picks up cleanly wherever it stops.
+  base64_encode_simd(src, slen, dst, mode, &i, &k);
+#endif
+
   while (i < n) {
     a = src[i + 0] & 0xff;
     b = src[i + 1] & 0xff;
@@ -230,6 +443,10 @@ inline size_t base64_encode(const char* src,
       a = src[i + 0] & 0xff;
       dst[k + 0] = table[a >> 2];
       dst[k + 1] = table[(a & 3) << 4];
+      if (mode == Base64Mode::NORMAL) {
+        dst[k + 2] = '=';
+        dst[k + 3] = '=';
+      }
       break;
     case 2:
       a = src[i + 0] & 0xff;
@@ -237,6 +454,9 @@ inline size_t base64_encode(const char* src,
       dst[k + 0] = table[a >> 2];
       dst[k + 1] = table[((a & 3) << 4) | (b >> 4)];
       dst[k + 2] = table[(b & 0x0f) << 2];
+      if (mode == Base64Mode::NORMAL) {
+        dst[k + 3] = '=';
+      }
       break;
   }
 
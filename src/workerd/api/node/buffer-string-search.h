@@ -28,9 +28,23 @@
 // found in the LICENSE file.
 #pragma once
 
+#include <cstdint>
 #include <cstring>
 #include <algorithm>
 
+// Vector acceleration for byte searches. SSE2 is part of the x86-64 baseline and NEON is always
+// available on arm64, so no runtime dispatch is needed; other targets use the scalar code
+// unchanged.
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define WORKERD_STRINGSEARCH_SIMD 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define WORKERD_STRINGSEARCH_SIMD 1
+#else
+#define WORKERD_STRINGSEARCH_SIMD 0
+#endif
+
 namespace workerd::api::node {
 namespace stringsearch {
 
@@ -296,6 +310,98 @@ inline size_t FindFirstCharacter(Vector<const uint8_t> pattern,
   return subject.forward() ? raw_pos : (subj_len - raw_pos - 1);
 }
 
+#if WORKERD_STRINGSEARCH_SIMD
+
+// Finds the first position i in [index, last] with data[i] == c0 && data[i + 1] == c1, comparing
+// 16 positions per iteration. `last + 1` must be a valid index into `data` (which holds for any
+// pattern of length >= 2). Returns `length` if there is no such position.
+inline size_t FindFirstBytePair(const uint8_t* data, size_t length,
+                                uint8_t c0, uint8_t c1,
+                                size_t index, size_t last) {
+  size_t i = index;
+
+#if defined(__SSE2__) || defined(_M_X64)
+  const __m128i v0 = _mm_set1_epi8(c0);
+  const __m128i v1 = _mm_set1_epi8(c1);
+  while (i + 17 <= length) {
+    const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 1));
+    const int mask = _mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(b0, v0), _mm_cmpeq_epi8(b1, v1)));
+    if (mask != 0) {
+      const size_t pos = i + __builtin_ctz(mask);
+      // A hit past `last` can't start a match, and no later position can either.
+      return pos <= last ? pos : length;
+    }
+    i += 16;
+  }
+#else
+  const uint8x16_t v0 = vdupq_n_u8(c0);
+  const uint8x16_t v1 = vdupq_n_u8(c1);
+  while (i + 17 <= length) {
+    const uint8x16_t b0 = vld1q_u8(data + i);
+    const uint8x16_t b1 = vld1q_u8(data + i + 1);
+    const uint8x16_t eq = vandq_u8(vceqq_u8(b0, v0), vceqq_u8(b1, v1));
+    // Narrow the per-byte 0x00/0xFF lanes to a nibble-per-position 64-bit mask.
+    const uint64_t mask = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+    if (mask != 0) {
+      const size_t pos = i + (__builtin_ctzll(mask) >> 2);
+      return pos <= last ? pos : length;
+    }
+    i += 16;
+  }
+#endif
+
+  for (; i <= last; i++) {
+    if (data[i] == c0 && data[i + 1] == c1) return i;
+  }
+  return length;
+}
+
+#endif  // WORKERD_STRINGSEARCH_SIMD
+
+// Finds the first position where *both* pattern[0] and pattern[1] occur, so that a single pass
+// filters out the (overwhelmingly common) positions where only the first character matches.
+// Does not check the rest of the pattern. Requires pattern.length() >= 2.
+template <typename Char>
+inline size_t FindFirstTwoCharacters(Vector<const Char> pattern,
+                                     Vector<const Char> subject, size_t index) {
+  const size_t max_n = subject.length() - pattern.length();
+  const Char pattern_second_char = pattern[1];
+  while (true) {
+    const size_t i = FindFirstCharacter(pattern, subject, index);
+    if (i == subject.length()) return subject.length();
+    if (subject[i + 1] == pattern_second_char) return i;
+    if (i >= max_n) return subject.length();
+    index = i + 1;
+  }
+}
+
+template <>
+inline size_t FindFirstTwoCharacters(Vector<const uint8_t> pattern,
+                                     Vector<const uint8_t> subject, size_t index) {
+#if WORKERD_STRINGSEARCH_SIMD
+  if (subject.forward()) {
+    return FindFirstBytePair(subject.start(), subject.length(),
+                             pattern[0], pattern[1],
+                             index, subject.length() - pattern.length());
+  }
+#endif
+
+  // Backward search (and non-SIMD targets): filter on the first byte with memrchr/memchr, then
+  // check the second.
+  const size_t max_n = subject.length() - pattern.length();
+  const uint8_t pattern_second_char = pattern[1];
+  while (true) {
+    const size_t i = FindFirstCharacter(pattern, subject, index);
+    if (i == subject.length()) return subject.length();
+    if (subject[i + 1] == pattern_second_char) return i;
+    if (i >= max_n) return subject.length();
+    index = i + 1;
+  }
+}
+
 //---------------------------------------------------------------------
 // Single Character Pattern Search Strategy
 //---------------------------------------------------------------------
@@ -318,12 +424,14 @@ size_t StringSearch<Char>::LinearSearch(
     size_t index) {
   const size_t n = subject.length() - pattern_.length();
   for (size_t i = index; i <= n; i++) {
-    i = FindFirstCharacter(pattern_, subject, i);
+    // Patterns of length 1 take the kSingleChar strategy, so there are always at least two
+    // characters to filter on here.
+    i = FindFirstTwoCharacters(pattern_, subject, i);
     if (i == subject.length())
       return subject.length();
 
     bool matches = true;
-    for (size_t j = 1; j < pattern_.length(); j++) {
+    for (size_t j = 2; j < pattern_.length(); j++) {
       if (pattern_[j] != subject[i + j]) {
         matches = false;
         break;
@@ -482,15 +590,33 @@ size_t StringSearch<Char>::BoyerMooreHorspoolSearch(
   size_t index = start_index;  // No matches found prior to this index.
   while (index <= subject_length - pattern_length) {
     size_t j = pattern_length - 1;
-    int subject_char;
-    while (last_char != (subject_char = subject[index + j])) {
-      int bc_occ = CharOccurrence(char_occurrences, subject_char);
-      int shift = j - bc_occ;
-      index += shift;
-      badness += 1 - shift;  // at most zero, so badness cannot increase.
-      if (index > subject_length - pattern_length) {
+    if (sizeof(Char) == 1 && subject.forward()) {
+      // Vectorized skip loop: instead of probing the bad-char table one mismatching byte at a
+      // time, jump straight to the next place the pattern's last character can line up. memchr
+      // compiles to SIMD on every platform we care about, so this scans the subject far faster
+      // than the scalar table walk. The badness bookkeeping below is unchanged, so degenerate
+      // inputs (a very common last character) still upgrade to full Boyer-Moore.
+      const void* found = memchr(subject.start() + index + j,
+                                 static_cast<uint8_t>(last_char),
+                                 subject_length - (index + j));
+      if (found == nullptr) {
         return subject_length;
       }
+      size_t shift = static_cast<const uint8_t*>(found) -
+          reinterpret_cast<const uint8_t*>(subject.start() + index + j);
+      index += shift;
+      badness += 1 - static_cast<int64_t>(shift);
+    } else {
+      int subject_char;
+      while (last_char != (subject_char = subject[index + j])) {
+        int bc_occ = CharOccurrence(char_occurrences, subject_char);
+        int shift = j - bc_occ;
+        index += shift;
+        badness += 1 - shift;  // at most zero, so badness cannot increase.
+        if (index > subject_length - pattern_length) {
+          return subject_length;
+        }
+      }
     }
     j--;
     while (pattern_[j] == (subject[index + j])) {
@@ -562,16 +688,13 @@ size_t StringSearch<Char>::InitialSearch(
   for (size_t i = index, n = subject.length() - pattern_length; i <= n; i++) {
     badness++;
     if (badness <= 0) {
-      i = FindFirstCharacter(pattern_, subject, i);
+      i = FindFirstTwoCharacters(pattern_, subject, i);
       if (i == subject.length())
         return subject.length();
-      size_t j = 1;
-      do {
-        if (pattern_[j] != subject[i + j]) {
-          break;
-        }
+      size_t j = 2;
+      while (j < pattern_length && pattern_[j] == subject[i + j]) {
         j++;
-      } while (j < pattern_length);
+      }
       if (j == pattern_length) {
         return i;
       }
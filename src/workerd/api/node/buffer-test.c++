@@ -2,7 +2,11 @@
 // Licensed under the Apache 2.0 license found in the LICENSE file or at:
 //     https://opensource.org/licenses/Apache-2.0
 
+#include <kj/encoding.h>
 #include <kj/test.h>
+#include <kj/vector.h>
+#include <workerd/api/node/buffer-base64.h>
+#include <workerd/api/node/buffer-string-search.h>
 #include <workerd/tests/test-fixture.h>
 
 namespace workerd::api {
@@ -563,6 +567,110 @@ KJ_TEST("Buffer.prototype.indexOf/lastIndexOf") {
   KJ_EXPECT(response.body == "test");
 }
 
+KJ_TEST("base64 encode/decode fast paths agree with reference implementation") {
+  using namespace workerd::api::node;
+
+  // Deterministic pseudo-random input so failures are reproducible. The size list straddles the
+  // vector block sizes (12/16 on x86, 48/64 on arm64) to exercise both the SIMD loop and the
+  // scalar tail.
+  kj::byte data[1100];
+  uint32_t seed = 0x12345678;
+  for (auto& b: data) {
+    seed = seed * 1664525 + 1013904223;
+    b = seed >> 24;
+  }
+
+  for (size_t size: {0, 1, 2, 3, 4, 11, 12, 13, 15, 16, 17, 47, 48, 49,
+                     63, 64, 65, 255, 256, 1000, 1024, 1100}) {
+    auto input = kj::arrayPtr(data, size);
+
+    // Encoding matches kj's (scalar) encoders for both alphabets.
+    auto encoded = kj::heapArray<char>(base64_encoded_size(size, Base64Mode::NORMAL));
+    base64_encode(input.asChars().begin(), size, encoded.begin(), encoded.size(),
+                  Base64Mode::NORMAL);
+    KJ_EXPECT(encoded.asPtr() == kj::encodeBase64(input).asArray(), size);
+
+    auto encodedUrl = kj::heapArray<char>(base64_encoded_size(size, Base64Mode::URL));
+    base64_encode(input.asChars().begin(), size, encodedUrl.begin(), encodedUrl.size(),
+                  Base64Mode::URL);
+    KJ_EXPECT(encodedUrl.asPtr() == kj::encodeBase64Url(input).asArray(), size);
+
+    // Decoding round-trips.
+    auto decoded = kj::heapArray<char>(base64_decoded_size(encoded.begin(), encoded.size()));
+    auto decodedLen = base64_decode(
+        decoded.begin(), decoded.size(), encoded.begin(), encoded.size());
+    KJ_EXPECT(decoded.asPtr().first(decodedLen) == input.asChars(), size);
+
+    // Whitespace knocks the decoder off the vectorized path but must still decode correctly.
+    kj::Vector<char> sprinkled;
+    for (size_t i = 0; i < encoded.size(); i++) {
+      if (i % 10 == 3) sprinkled.add('\n');
+      sprinkled.add(encoded[i]);
+    }
+    auto decoded2 = kj::heapArray<char>(
+        base64_decoded_size(sprinkled.begin(), sprinkled.size()));
+    auto decodedLen2 = base64_decode(
+        decoded2.begin(), decoded2.size(), sprinkled.begin(), sprinkled.size());
+    KJ_EXPECT(decoded2.asPtr().first(decodedLen2) == input.asChars(), size);
+  }
+}
+
+// Reference implementation: scan every candidate position. `startIndex` is the lowest allowed
+// match for forward searches and the highest allowed match for backward ones, mirroring
+// SearchString's contract. Returns the haystack length when there is no match.
+size_t naiveSearch(kj::ArrayPtr<const kj::byte> hay, kj::ArrayPtr<const kj::byte> needle,
+                   size_t startIndex, bool isForward) {
+  if (needle.size() > hay.size()) return hay.size();
+  size_t diff = hay.size() - needle.size();
+  auto matchesAt = [&](size_t i) {
+    return memcmp(hay.begin() + i, needle.begin(), needle.size()) == 0;
+  };
+  if (isForward) {
+    for (size_t i = startIndex; i <= diff; i++) {
+      if (matchesAt(i)) return i;
+    }
+  } else {
+    for (size_t i = kj::min(startIndex, diff) + 1; i > 0; i--) {
+      if (matchesAt(i - 1)) return i - 1;
+    }
+  }
+  return hay.size();
+}
+
+KJ_TEST("Buffer.indexOf search strategies agree with naive search") {
+  using workerd::api::node::SearchString;
+
+  // A small alphabet produces lots of partial matches, which drives the searcher through its
+  // strategy upgrades (linear -> Boyer-Moore-Horspool -> Boyer-Moore). Needle lengths straddle
+  // the strategy thresholds (1, 2-7 linear, >=8 BMH, >250 truncated tables) and the SIMD block
+  // size.
+  auto hay = kj::heapArray<kj::byte>(4096);
+  uint32_t seed = 0xdeadbeef;
+  for (auto& b: hay) {
+    seed = seed * 1664525 + 1013904223;
+    b = 'a' + ((seed >> 24) & 3);
+  }
+
+  for (size_t needleLen: {1, 2, 3, 5, 8, 16, 40, 300}) {
+    // A needle copied out of the middle of the haystack (guaranteed hits) and one that can't
+    // match (no 'z' in the haystack).
+    auto present = kj::heapArray<kj::byte>(hay.slice(1700, 1700 + needleLen));
+    auto absent = kj::heapArray<kj::byte>(hay.slice(1700, 1700 + needleLen));
+    absent[needleLen / 2] = 'z';
+
+    for (auto& needle: {kj::mv(present), kj::mv(absent)}) {
+      for (bool isForward: {true, false}) {
+        for (size_t start: {size_t(0), size_t(1), size_t(17), size_t(1699),
+                            size_t(1701), size_t(4000)}) {
+          size_t expected = naiveSearch(hay, needle, start, isForward);
+          size_t actual = SearchString(
+              hay.begin(), hay.size(), needle.begin(), needle.size(), start, isForward);
+          KJ_EXPECT(actual == expected, needleLen, isForward, start, actual, expected);
+        }
+      }
+    }
+  }
+}
 
 }  // namespace
 }  // namespace workerd::api
@@ -46,6 +46,19 @@
   (((x) & 0x00000000000000FFull) << 56)
 #endif
 
+// As with the base64 fast path in buffer-base64.h, the vectorized byte-swap kernel is selected
+// at compile time. workerd builds target a fixed instruction baseline, so there is no runtime
+// dispatch here.
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define WORKERD_BSWAP_SIMD 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define WORKERD_BSWAP_SIMD 1
+#else
+#define WORKERD_BSWAP_SIMD 0
+#endif
+
 namespace workerd::api::node {
 
 const int8_t unbase64_table[256] =
@@ -74,7 +87,43 @@ void SwapBytes(kj::ArrayPtr<kj::byte> bytes) {
   KJ_DASSERT((bytes.size() % sizeof(T)) == 0);
   uint32_t len = bytes.size() / sizeof(T);
   T* data = reinterpret_cast<T*>(bytes.begin());
-  for (uint32_t i = 0; i < len; i++) {
+  uint32_t i = 0;
+
+#if WORKERD_BSWAP_SIMD
+  // Reverse the bytes of each element 16 bytes at a time with a single byte-shuffle
+  // instruction. The scalar loop below picks up the sub-16-byte tail.
+  kj::byte* p = bytes.begin();
+  size_t vecBytes = bytes.size() & ~size_t(15);
+#if defined(__SSSE3__)
+  __m128i shuffle;
+  if constexpr (kj::isSameType<T, uint16_t>()) {
+    shuffle = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  } else if constexpr (kj::isSameType<T, uint32_t>()) {
+    shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+  } else {
+    shuffle = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  }
+  for (size_t off = 0; off < vecBytes; off += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + off));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p + off), _mm_shuffle_epi8(v, shuffle));
+  }
+#else
+  for (size_t off = 0; off < vecBytes; off += 16) {
+    uint8x16_t v = vld1q_u8(p + off);
+    if constexpr (kj::isSameType<T, uint16_t>()) {
+      v = vrev16q_u8(v);
+    } else if constexpr (kj::isSameType<T, uint32_t>()) {
+      v = vrev32q_u8(v);
+    } else {
+      v = vrev64q_u8(v);
+    }
+    vst1q_u8(p + off, v);
+  }
+#endif
+  i = vecBytes / sizeof(T);
+#endif
+
+  for (; i < len; i++) {
     if constexpr (kj::isSameType<T, uint16_t>()) {
       data[i] = BSWAP_2(data[i]);
     } else if constexpr (kj::isSameType<T, uint32_t>()) {
@@ -553,10 +602,16 @@ jsg::JsString toStringImpl(
       return js.str(data);
     }
     case Encoding::BASE64: {
-      return js.str(kj::encodeBase64(slice));
+      auto dest = kj::heapArray<char>(base64_encoded_size(slice.size(), Base64Mode::NORMAL));
+      base64_encode(slice.asChars().begin(), slice.size(), dest.begin(), dest.size(),
+                    Base64Mode::NORMAL);
+      return js.str(dest.asPtr());
     }
     case Encoding::BASE64URL: {
-      return js.str(kj::encodeBase64Url(slice));
+      auto dest = kj::heapArray<char>(base64_encoded_size(slice.size(), Base64Mode::URL));
+      base64_encode(slice.asChars().begin(), slice.size(), dest.begin(), dest.size(),
+                    Base64Mode::URL);
+      return js.str(dest.asPtr());
     }
     case Encoding::HEX: {
       return js.str(kj::encodeHex(slice));
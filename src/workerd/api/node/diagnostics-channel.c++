@@ -22,6 +22,13 @@ void Channel::publish(jsg::Lock& js, jsg::Value message) {
     sub.value(js, message.addRef(js), name.clone(js));
   }
 
+  // Library code tends to publish unconditionally, so a publish with nobody listening should
+  // cost as little as possible. Outside of a request (e.g. at top-level script evaluation)
+  // there is no tracer either, so return before touching the IoContext rather than requiring
+  // one. Inside a request the tracer check below must still run even with zero subscribers,
+  // since diagnostic events are recorded in traces regardless of subscription.
+  if (!IoContext::hasCurrent()) return;
+
   auto& context = IoContext::current();
   KJ_IF_SOME(tracer, context.getWorkerTracer()) {
     jsg::Serializer ser(js, jsg::Serializer::Options {
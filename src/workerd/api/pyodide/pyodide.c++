@@ -4,6 +4,9 @@
 #include "kj/array.h"
 #include "kj/common.h"
 #include "kj/debug.h"
+#include "kj/map.h"
+#include "kj/mutex.h"
+#include "kj/refcount.h"
 
 namespace workerd::api::pyodide {
 
@@ -147,13 +150,49 @@ jsg::Ref<PyodideMetadataReader> makePyodideMetadataReader(Worker::Reader conf, c
 
 const kj::Maybe<kj::Own<const kj::Directory>> DiskCache::NULL_CACHE_ROOT = kj::none;
 
+namespace {
+
+// A process-wide cache of artifacts written through DiskCache::put(). Cache keys embed the
+// Pyodide and package versions, so an entry (most importantly the post-bootstrap memory
+// snapshot) is valid for every isolate running the same Python version. When no disk cache
+// directory is configured -- the default -- this is the only thing standing between each new
+// Python isolate and a full interpreter bootstrap. Entries are immutable once inserted.
+struct InMemoryArtifact: public kj::AtomicRefcounted {
+  InMemoryArtifact(kj::Array<const kj::byte> data): data(kj::mv(data)) {}
+  const kj::Array<const kj::byte> data;
+};
+
+kj::MutexGuarded<kj::HashMap<kj::String, kj::Own<const InMemoryArtifact>>> inMemoryArtifacts;
+
+}  // namespace
+
 jsg::Optional<kj::Array<kj::byte>> DiskCache::get(jsg::Lock& js, kj::String key) {
+  if (cacheRoot == kj::none) {
+    // No disk cache configured; fall back to the in-process artifact cache so that the first
+    // isolate's bootstrap work is still shared with every later isolate. The caller gets a
+    // private copy since it receives a mutable buffer, but copying pages is orders of magnitude
+    // cheaper than re-running the Pyodide bootstrap.
+    auto lock = inMemoryArtifacts.lockShared();
+    KJ_IF_SOME(entry, lock->find(key)) {
+      return kj::heapArray<kj::byte>(entry->data);
+    }
+    return kj::none;
+  }
+
   KJ_IF_SOME(root, cacheRoot) {
     kj::Path path(key);
     auto file = root->tryOpenFile(path);
 
     KJ_IF_SOME(f, file) {
-      return f->readAllBytes();
+      // Cached artifacts (Pyodide packages, memory snapshots) can be hundreds of megabytes.
+      // Map them copy-on-write rather than reading into an owned buffer: pages are faulted in
+      // lazily and remain shared with the page cache -- and with other workerd processes using
+      // the same cache -- until (unless) the caller writes to them.
+      uint64_t size = f->stat().size;
+      if (size == 0) {
+        return kj::Array<kj::byte>();
+      }
+      return f->mmapPrivate(0, size);
     } else {
       return kj::none;
     }
@@ -173,7 +212,15 @@ void DiskCache::put(jsg::Lock& js, kj::String key, kj::Array<kj::byte> data) {
       KJ_LOG(ERROR, "DiskCache: Failed to open file", key);
     }
   } else {
-    return;
+    // No disk cache; keep the artifact in the in-process cache instead so other isolates can
+    // reuse it. (When a disk cache is configured the file itself serves that purpose: get()
+    // maps it copy-on-write, sharing pages between isolates via the page cache.)
+    auto lock = inMemoryArtifacts.lockExclusive();
+    lock->upsert(kj::str(key),
+        kj::atomicRefcounted<InMemoryArtifact>(kj::heapArray<const kj::byte>(data.asPtr())),
+        [](kj::Own<const InMemoryArtifact>& existing, kj::Own<const InMemoryArtifact>&& replacement) {
+      existing = kj::mv(replacement);
+    });
   }
 }
 
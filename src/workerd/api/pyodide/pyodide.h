@@ -261,7 +261,10 @@ public:
   }
 };
 
-// This cache is used by Pyodide to store wheels fetched over the internet across workerd restarts in local dev only
+// This cache is used by Pyodide to store artifacts (fetched wheels, memory snapshots) across
+// workerd restarts in local dev. When no cache directory is configured, artifacts are instead
+// kept in a process-wide in-memory cache so that isolates running the same Python version still
+// share one bootstrap's work.
 class DiskCache: public jsg::Object {
 private:
   static const kj::Maybe<kj::Own<const kj::Directory>> NULL_CACHE_ROOT; // always set to kj::none
@@ -0,0 +1,74 @@
+// Copyright (c) 2024 Cloudflare, Inc.
+// Licensed under the Apache 2.0 license found in the LICENSE file or at:
+//     https://opensource.org/licenses/Apache-2.0
+
+import assert from "node:assert";
+import { Buffer } from "node:buffer";
+
+// Batches received by the producer receiver below, in arrival order.
+let receivedBatches = [];
+
+function decodeJsonBody(message) {
+  assert.strictEqual(message.contentType, "json");
+  return JSON.parse(Buffer.from(message.body, "base64").toString());
+}
+
+export default {
+  // Producer receiver (from `env.QUEUE`)
+  async fetch(request, env, ctx) {
+    assert.strictEqual(request.method, "POST");
+    const { pathname } = new URL(request.url);
+
+    // With queues_auto_batching enabled, send() must never issue a per-message subrequest.
+    assert.strictEqual(pathname, "/batch");
+
+    const body = await request.json();
+    assert(Array.isArray(body?.messages));
+    assert.strictEqual(
+        request.headers.get("CF-Queue-Batch-Count"), String(body.messages.length));
+    receivedBatches.push(body.messages);
+    return new Response();
+  },
+
+  async test(ctrl, env, ctx) {
+    // All sends made during the same microtask coalesce into a single batch subrequest, in order.
+    receivedBatches = [];
+    await Promise.all([
+      env.QUEUE.send({ a: 1 }),
+      env.QUEUE.send({ b: 2 }, { delaySeconds: 2 }),
+      env.QUEUE.send({ c: 3 }),
+    ]);
+    assert.strictEqual(receivedBatches.length, 1);
+    assert.deepStrictEqual(receivedBatches[0].map(decodeJsonBody),
+        [{ a: 1 }, { b: 2 }, { c: 3 }]);
+    assert.strictEqual(receivedBatches[0][1].delaySecs, 2);
+
+    // Sends made in separate microtasks are separate batches.
+    receivedBatches = [];
+    await env.QUEUE.send({ a: 1 });
+    await env.QUEUE.send({ b: 2 });
+    assert.strictEqual(receivedBatches.length, 2);
+
+    // An explicit sendBatch() flushes buffered sends first so that ordering is preserved.
+    receivedBatches = [];
+    await Promise.all([
+      env.QUEUE.send({ a: 1 }),
+      env.QUEUE.sendBatch([{ body: { b: 2 } }, { body: { c: 3 } }]),
+    ]);
+    assert.strictEqual(receivedBatches.length, 2);
+    // The two subrequests are issued in order but their receiver invocations may complete in
+    // either order, so identify the batches by size.
+    const batches = receivedBatches.map((messages) => messages.map(decodeJsonBody));
+    batches.sort((a, b) => a.length - b.length);
+    assert.deepStrictEqual(batches, [[{ a: 1 }], [{ b: 2 }, { c: 3 }]]);
+
+    // Bad content types still fail the individual send() synchronously rather than poisoning a
+    // whole batch at flush time.
+    receivedBatches = [];
+    assert.throws(() => env.QUEUE.send("abc", { contentType: "nonsense" }), {
+      name: "TypeError",
+      message: "Unsupported queue message content type: nonsense",
+    });
+    assert.strictEqual(receivedBatches.length, 0);
+  },
+}
@@ -23,6 +23,10 @@ static constexpr kj::StringPtr HDR_MSG_FORMAT = "X-Msg-Fmt"_kj;
 // Header for the message delivery delay.
 static constexpr kj::StringPtr HDR_MSG_DELAY = "X-Msg-Delay-Secs"_kj;
 
+// Maximum number of messages to accumulate before an auto-batched send is flushed early, matching
+// the product limit on the number of messages in a batch.
+static constexpr size_t MAX_AUTO_BATCH_COUNT = 100;
+
 kj::StringPtr validateContentType(kj::StringPtr contentType) {
   auto lowerCase = toLower(contentType);
   if (lowerCase == IncomingQueueMessage::ContentType::TEXT) {
@@ -159,25 +163,93 @@ jsg::JsValue deserialize(jsg::Lock& js,
   }
 }
 
-jsg::JsValue deserialize(jsg::Lock& js, rpc::QueueMessage::Reader message) {
-  kj::StringPtr type = message.getContentType();
-  if (type == "") {
-    // default to v8 format
-    type = IncomingQueueMessage::ContentType::V8;
+// Issues a single batch subrequest containing the given already-serialized messages. Shared
+// between sendBatch() and the auto-batching flush path. The serialized bodies are copied into the
+// request body before this returns, so they only need to remain valid for the duration of the
+// call.
+kj::Promise<void> sendBatchRequest(jsg::Lock& js, IoContext& context, uint subrequestChannel,
+                                   kj::ArrayPtr<SerializedWithOptions> serializedBodies,
+                                   kj::Maybe<int> delaySeconds) {
+  auto messageCount = serializedBodies.size();
+  size_t totalSize = 0;
+  size_t largestMessage = 0;
+  for (auto& message: serializedBodies) {
+    totalSize += message.body.data.size();
+    largestMessage = kj::max(largestMessage, message.body.data.size());
   }
 
-  if (type == IncomingQueueMessage::ContentType::TEXT) {
-    return js.str(message.getData().asChars());
-  } else if (type == IncomingQueueMessage::ContentType::BYTES) {
-    kj::Array<kj::byte> bytes = kj::heapArray(message.getData().asBytes());
-    return jsg::JsValue(js.bytes(kj::mv(bytes)).getHandle(js));
-  } else if (type == IncomingQueueMessage::ContentType::JSON) {
-    return jsg::JsValue::fromJson(js, message.getData().asChars());
-  } else if (type == IncomingQueueMessage::ContentType::V8) {
-    return jsg::JsValue(jsg::Deserializer(js, message.getData()).readValue(js));
-  } else {
-    JSG_FAIL_REQUIRE(TypeError, kj::str("Unsupported queue message content type: ", type));
+  // Construct the request body by concatenating the messages together into a JSON message.
+  // Done manually to minimize copies, although it'd be nice to make this safer.
+  // (totalSize + 2) / 3 * 4 is equivalent to ceil(totalSize / 3) * 4 for base64 encoding overhead.
+  auto estimatedSize = (totalSize + 2) / 3 * 4 + messageCount * 64 + 32;
+  kj::Vector<char> bodyBuilder(estimatedSize);
+  bodyBuilder.addAll("{\"messages\":["_kj);
+  for (size_t i = 0; i < messageCount; ++i) {
+    bodyBuilder.addAll("{\"body\":\""_kj);
+    // TODO(perf): We should be able to encode the data directly into bodyBuilder's buffer to
+    // eliminate a lot of data copying (whereas now encodeBase64 allocates a new buffer of its own
+    // to hold its result, which we then have to copy into bodyBuilder).
+    bodyBuilder.addAll(kj::encodeBase64(serializedBodies[i].body.data));
+    bodyBuilder.add('"');
+
+    KJ_IF_SOME(contentType, serializedBodies[i].contentType) {
+      bodyBuilder.addAll(",\"contentType\":\""_kj);
+      bodyBuilder.addAll(contentType);
+      bodyBuilder.add('"');
+    }
+
+    KJ_IF_SOME(delaySecs, serializedBodies[i].delaySeconds) {
+      bodyBuilder.addAll(",\"delaySecs\": "_kj);
+      bodyBuilder.addAll(kj::str(delaySecs));
+    }
+
+    bodyBuilder.addAll("}"_kj);
+    if (i < messageCount - 1) {
+      bodyBuilder.add(',');
+    }
   }
+  bodyBuilder.addAll("]}"_kj);
+  bodyBuilder.add('\0');
+  KJ_DASSERT(bodyBuilder.size() <= estimatedSize);
+  kj::String body(bodyBuilder.releaseAsArray());
+  KJ_DASSERT(jsg::JsValue::fromJson(js, body).isObject());
+
+  auto client = context.getHttpClient(subrequestChannel, true, kj::none, "queue_send"_kjc);
+
+  // We add info about the size of the batch to the headers so that the queue implementation can
+  // decide whether it's too large.
+  // TODO(someday): Enforce the size limits here instead for very slightly better performance.
+  auto headers = kj::HttpHeaders(context.getHeaderTable());
+  headers.add("CF-Queue-Batch-Count"_kj, kj::str(messageCount));
+  headers.add("CF-Queue-Batch-Bytes"_kj, kj::str(totalSize));
+  headers.add("CF-Queue-Largest-Msg"_kj, kj::str(largestMessage));
+  headers.set(kj::HttpHeaderId::CONTENT_TYPE, MimeType::JSON.toString());
+
+  KJ_IF_SOME(secs, delaySeconds) {
+    headers.add(HDR_MSG_DELAY, kj::str(secs));
+  }
+
+  // The stage that we're sending a subrequest to provides a base URL that includes a scheme, the
+  // queue broker's domain, and the start of the URL path including the account ID and queue ID. All
+  // we have to do is provide the end of the path (which is "/batch") to send a message batch.
+
+  auto req = client->request(kj::HttpMethod::POST,
+                             "https://fake-host/batch"_kjc,
+                             headers, body.size());
+
+  static constexpr auto handleWrite = [](auto req, auto body, auto client) -> kj::Promise<void> {
+    co_await req.body->write(body.asBytes());
+    auto response = co_await req.response;
+
+    JSG_REQUIRE(response.statusCode == 200, Error,
+                kj::str("Queue sendBatch failed: ", response.statusText));
+
+    // Read and discard response body, otherwise we might burn the HTTP connection.
+    co_await response.body->readAllBytes().ignoreResult();
+  };
+
+  return handleWrite(kj::mv(req), kj::mv(body), kj::mv(client))
+      .attach(context.registerPendingEvent());
 }
 }  // namespace
 
@@ -188,6 +260,55 @@ kj::Promise<void> WorkerQueue::send(jsg::Lock& js,
 
   JSG_REQUIRE(!body.isUndefined(), TypeError, "Message body cannot be undefined");
 
+  if (FeatureFlags::get(js).getQueuesAutoBatching()) {
+    // Buffer the message rather than sending it immediately: every send() made during the same
+    // microtask is delivered as a single batch subrequest, so a naive loop of per-message sends
+    // costs one subrequest rather than one per message.
+    KJ_IF_SOME(pending, pendingAutoBatch) {
+      if (pending.context != &context) {
+        // Leftover state from a request that was torn down before its flush microtask could run.
+        // Its waiters are long gone, so just drop it and start fresh.
+        pending.fulfiller->reject(KJ_EXCEPTION(FAILED,
+            "jsg.Error: Queue send was buffered but its request was canceled before the batch "
+            "could be sent."));
+        pendingAutoBatch = kj::none;
+      } else if (pending.messages.size() >= MAX_AUTO_BATCH_COUNT) {
+        // Another message would push the batch over the limit; flush what we have now and start a
+        // new batch for this message.
+        flushPendingAutoBatch(js);
+      }
+    }
+
+    MessageSendRequest entry{.body = jsg::JsRef(js, body)};
+    KJ_IF_SOME(opts, options) {
+      KJ_IF_SOME(type, opts.contentType) {
+        // Validate eagerly so that a bad content type rejects this send() synchronously rather
+        // than failing the whole batch at flush time.
+        entry.contentType = kj::str(validateContentType(type));
+      }
+      entry.delaySeconds = opts.delaySeconds;
+    }
+
+    auto& pending = ([&]() -> PendingAutoBatch& {
+      KJ_IF_SOME(p, pendingAutoBatch) {
+        return p;
+      }
+      auto paf = kj::newPromiseAndFulfiller<kj::Promise<void>>();
+      // Flush at the next microtask checkpoint. The continuation holds a strong reference to the
+      // binding to keep the pending batch alive until then.
+      js.resolvedPromise().then(js, [self = JSG_THIS](jsg::Lock& js) {
+        self->flushPendingAutoBatch(js);
+      }).markAsHandled(js);
+      return pendingAutoBatch.emplace(PendingAutoBatch{
+        .context = &context,
+        .fulfiller = kj::mv(paf.fulfiller),
+        .forked = paf.promise.fork(),
+      });
+    })();
+    pending.messages.add(kj::mv(entry));
+    return pending.forked.addBranch().attach(context.registerPendingEvent());
+  }
+
   auto headers = kj::HttpHeaders(context.getHeaderTable());
   headers.set(kj::HttpHeaderId::CONTENT_TYPE, MimeType::OCTET_STREAM.toString());
 
@@ -245,8 +366,10 @@ kj::Promise<void> WorkerQueue::sendBatch(jsg::Lock& js, jsg::Sequence<MessageSen
 
   JSG_REQUIRE(batch.size() > 0, TypeError, "sendBatch() requires at least one message");
 
-  size_t totalSize = 0;
-  size_t largestMessage = 0;
+  // If auto-batched sends are buffered, flush them first so that this batch can't jump ahead of
+  // earlier send() calls.
+  flushPendingAutoBatch(js);
+
   auto messageCount = batch.size();
   auto builder = kj::heapArrayBuilder<SerializedWithOptions>(messageCount);
   for (auto& message: batch) {
@@ -272,108 +395,120 @@ kj::Promise<void> WorkerQueue::sendBatch(jsg::Lock& js, jsg::Sequence<MessageSen
     }
 
     builder.add(kj::mv(item));
-    totalSize += builder.back().body.data.size();
-    largestMessage = kj::max(largestMessage, builder.back().body.data.size());
   }
   auto serializedBodies = builder.finish();
 
-  // Construct the request body by concatenating the messages together into a JSON message.
-  // Done manually to minimize copies, although it'd be nice to make this safer.
-  // (totalSize + 2) / 3 * 4 is equivalent to ceil(totalSize / 3) * 4 for base64 encoding overhead.
-  auto estimatedSize = (totalSize + 2) / 3 * 4 + messageCount * 64 + 32;
-  kj::Vector<char> bodyBuilder(estimatedSize);
-  bodyBuilder.addAll("{\"messages\":["_kj);
-  for (size_t i = 0; i < messageCount; ++i) {
-    bodyBuilder.addAll("{\"body\":\""_kj);
-    // TODO(perf): We should be able to encode the data directly into bodyBuilder's buffer to
-    // eliminate a lot of data copying (whereas now encodeBase64 allocates a new buffer of its own
-    // to hold its result, which we then have to copy into bodyBuilder).
-    bodyBuilder.addAll(kj::encodeBase64(serializedBodies[i].body.data));
-    bodyBuilder.add('"');
-
-    KJ_IF_SOME(contentType, serializedBodies[i].contentType) {
-      bodyBuilder.addAll(",\"contentType\":\""_kj);
-      bodyBuilder.addAll(contentType);
-      bodyBuilder.add('"');
-    }
-
-    KJ_IF_SOME(delaySecs, serializedBodies[i].delaySeconds) {
-      bodyBuilder.addAll(",\"delaySecs\": "_kj);
-      bodyBuilder.addAll(kj::str(delaySecs));
-    }
-
-    bodyBuilder.addAll("}"_kj);
-    if (i < messageCount - 1) {
-      bodyBuilder.add(',');
-    }
+  kj::Maybe<int> delaySeconds;
+  KJ_IF_SOME(opts, options) {
+    delaySeconds = opts.delaySeconds;
   }
-  bodyBuilder.addAll("]}"_kj);
-  bodyBuilder.add('\0');
-  KJ_DASSERT(bodyBuilder.size() <= estimatedSize);
-  kj::String body(bodyBuilder.releaseAsArray());
-  KJ_DASSERT(jsg::JsValue::fromJson(js, body).isObject());
-
-  auto client = context.getHttpClient(subrequestChannel, true, kj::none, "queue_send"_kjc);
 
-  // We add info about the size of the batch to the headers so that the queue implementation can
-  // decide whether it's too large.
-  // TODO(someday): Enforce the size limits here instead for very slightly better performance.
-  auto headers = kj::HttpHeaders(context.getHeaderTable());
-  headers.add("CF-Queue-Batch-Count"_kj, kj::str(messageCount));
-  headers.add("CF-Queue-Batch-Bytes"_kj, kj::str(totalSize));
-  headers.add("CF-Queue-Largest-Msg"_kj, kj::str(largestMessage));
-  headers.set(kj::HttpHeaderId::CONTENT_TYPE, MimeType::JSON.toString());
+  return sendBatchRequest(js, context, subrequestChannel, serializedBodies, delaySeconds);
+};
 
-  KJ_IF_SOME(opts, options) {
-    KJ_IF_SOME(secs, opts.delaySeconds) {
-      headers.add(HDR_MSG_DELAY, kj::str(secs));
+void WorkerQueue::flushPendingAutoBatch(jsg::Lock& js) {
+  KJ_IF_SOME(pending, pendingAutoBatch) {
+    if (pending.context != &IoContext::current()) {
+      // Stale state from another request; leave it for send() to clean up.
+      return;
     }
+  } else {
+    return;
   }
+  auto batch = kj::mv(KJ_ASSERT_NONNULL(pendingAutoBatch));
+  pendingAutoBatch = kj::none;
 
-  // The stage that we're sending a subrequest to provides a base URL that includes a scheme, the
-  // queue broker's domain, and the start of the URL path including the account ID and queue ID. All
-  // we have to do is provide the end of the path (which is "/batch") to send a message batch.
+  auto& context = IoContext::current();
 
-  auto req = client->request(kj::HttpMethod::POST,
-                             "https://fake-host/batch"_kjc,
-                             headers, body.size());
+  // Serialize under the same isolate lock that buffered the messages; the shallow references only
+  // need to live until sendBatchRequest() copies them into the request body below.
+  auto promise = js.tryCatch([&]() -> kj::Maybe<kj::Promise<void>> {
+    auto builder = kj::heapArrayBuilder<SerializedWithOptions>(batch.messages.size());
+    for (auto& message: batch.messages) {
+      auto body = message.body.getHandle(js);
 
-  static constexpr auto handleWrite = [](auto req, auto body, auto client) -> kj::Promise<void> {
-    co_await req.body->write(body.asBytes());
-    auto response = co_await req.response;
+      SerializedWithOptions item;
+      KJ_IF_SOME(secs, message.delaySeconds) {
+        item.delaySeconds = secs;
+      }
 
-    JSG_REQUIRE(response.statusCode == 200, Error,
-                kj::str("Queue sendBatch failed: ", response.statusText));
+      KJ_IF_SOME(contentType, message.contentType) {
+        // Already validated and canonicalized when the message was buffered.
+        item.contentType = kj::StringPtr(contentType);
+        item.body = serialize(js, body, contentType,
+            SerializeArrayBufferBehavior::SHALLOW_REFERENCE);
+      } else if (workerd::FeatureFlags::get(js).getQueuesJsonMessages()) {
+        item.contentType = IncomingQueueMessage::ContentType::JSON;
+        item.body = serialize(js, body, IncomingQueueMessage::ContentType::JSON,
+            SerializeArrayBufferBehavior::SHALLOW_REFERENCE);
+      } else {
+        item.body = serializeV8(js, body);
+      }
 
-    // Read and discard response body, otherwise we might burn the HTTP connection.
-    co_await response.body->readAllBytes().ignoreResult();
-  };
+      builder.add(kj::mv(item));
+    }
+    auto serializedBodies = builder.finish();
+
+    return sendBatchRequest(js, context, subrequestChannel, serializedBodies, kj::none);
+  }, [&](jsg::Value exception) -> kj::Maybe<kj::Promise<void>> {
+    // A message failed to serialize (e.g. a "text" message whose body isn't a string). There's no
+    // way to attribute the failure to an individual send() at this point, so the whole batch
+    // rejects.
+    batch.fulfiller->reject(js.exceptionToKj(kj::mv(exception)));
+    return kj::none;
+  });
 
-  return handleWrite(kj::mv(req), kj::mv(body), kj::mv(client))
-      .attach(context.registerPendingEvent());
-};
+  KJ_IF_SOME(p, promise) {
+    batch.fulfiller->fulfill(kj::mv(p));
+  }
+}
 
 QueueMessage::QueueMessage(jsg::Lock& js,
                            rpc::QueueMessage::Reader message,
+                           kj::Array<kj::byte> serializedBody,
                            IoPtr<QueueEventResult> result)
     : id(kj::str(message.getId())),
       timestamp(message.getTimestampNs() * kj::NANOSECONDS + kj::UNIX_EPOCH),
-      body(deserialize(js, message).addRef(js)),
+      body(LazyBody{
+        .bytes = kj::mv(serializedBody),
+        .contentType = [&]() -> kj::Maybe<kj::String> {
+          kj::StringPtr type = message.getContentType();
+          if (type == "") {
+            // default to v8 format
+            return kj::none;
+          }
+          return kj::str(type);
+        }(),
+      }),
       attempts(message.getAttempts()),
       result(result) {}
 // Note that we must make deep copies of all data here since the incoming Reader may be
-// deallocated while JS's GC wrappers still exist.
+// deallocated while JS's GC wrappers still exist. (The body itself was already copied into the
+// batch buffer that `serializedBody` is a slice of.)
 
 QueueMessage::QueueMessage(
     jsg::Lock& js, IncomingQueueMessage message, IoPtr<QueueEventResult> result)
     : id(kj::mv(message.id)),
       timestamp(message.timestamp),
-      body(deserialize(js, kj::mv(message.body), message.contentType).addRef(js)),
+      body(LazyBody{
+        .bytes = kj::mv(message.body),
+        .contentType = kj::mv(message.contentType),
+      }),
       attempts(message.attempts),
       result(result) {}
 
 jsg::JsValue QueueMessage::getBody(jsg::Lock& js) {
-  return body.getHandle(js);
+  KJ_IF_SOME(lazy, body.tryGet<LazyBody>()) {
+    // First access; deserialize now and cache the result so every access returns the same object.
+    kj::Maybe<kj::StringPtr> contentType;
+    KJ_IF_SOME(type, lazy.contentType) {
+      contentType = kj::StringPtr(type);
+    }
+    auto value = deserialize(js, kj::mv(lazy.bytes), contentType);
+    body = jsg::JsRef(js, value);
+    return value;
+  }
+  return body.get<jsg::JsRef<jsg::JsValue>>().getHandle(js);
 }
 
 void QueueMessage::retry(jsg::Optional<QueueRetryOptions> options) {
@@ -428,10 +563,28 @@ QueueEvent::QueueEvent(jsg::Lock& js, rpc::EventDispatcher::QueueParams::Reader
     : ExtendableEvent("queue"), queueName(kj::heapString(params.getQueueName())), result(result) {
   // Note that we must make deep copies of all data here since the incoming Reader may be
   // deallocated while JS's GC wrappers still exist.
+  //
+  // The serialized bodies are copied into one contiguous refcounted buffer for the whole batch --
+  // one allocation rather than one per message -- and each message gets a slice of it, to be
+  // deserialized only if and when its body is actually read.
   auto incoming = params.getMessages();
+
+  size_t totalBodySize = 0;
+  for (auto message: incoming) {
+    totalBodySize += message.getData().size();
+  }
+  auto batch = kj::refcounted<QueueMessage::SerializedBatch>(
+      kj::heapArray<kj::byte>(totalBodySize));
+
+  size_t offset = 0;
   auto messagesBuilder = kj::heapArrayBuilder<jsg::Ref<QueueMessage>>(incoming.size());
   for (auto i: kj::indices(incoming)) {
-    messagesBuilder.add(jsg::alloc<QueueMessage>(js, incoming[i], result));
+    auto data = incoming[i].getData();
+    auto slice = batch->data.slice(offset, offset + data.size());
+    memcpy(slice.begin(), data.begin(), data.size());
+    offset += data.size();
+    messagesBuilder.add(jsg::alloc<QueueMessage>(
+        js, incoming[i], slice.attach(kj::addRef(*batch)), result));
   }
   messages = messagesBuilder.finish();
 }
@@ -530,9 +683,19 @@ kj::Promise<WorkerInterface::CustomEvent::Result> QueueCustomEventImpl::run(
     kj::Own<IoContext_IncomingRequest> incomingRequest,
     kj::Maybe<kj::StringPtr> entrypointName,
     kj::TaskSet& waitUntilTasks) {
+  // TODO(perf): Sharding one delivered batch across multiple concurrent IoContexts has been
+  //   considered and rejected: every context would contend on the same isolate lock (so no added
+  //   CPU parallelism), and the ack/retry result is reported per delivered batch at the RPC
+  //   boundary. Consumers that want intra-batch concurrency can process messages concurrently
+  //   within the handler (the whole batch is handed to JS at once), and the dispatcher can
+  //   deliver multiple smaller batches concurrently, each of which gets its own IoContext here.
   incomingRequest->delivered();
   auto& context = incomingRequest->getContext();
 
+  // Queue batches are bulk work; don't let them queue ahead of interactive traffic on a shared
+  // isolate.
+  context.setLockPriority(Worker::LockPriority::BACKGROUND);
+
   kj::String queueName;
   uint32_t batchSize;
   KJ_SWITCH_ONEOF(params) {
@@ -615,7 +778,30 @@ kj::Promise<WorkerInterface::CustomEvent::Result> QueueCustomEventImpl::sendRpc(
     capnp::ByteStreamFactory& byteStreamFactory,
     kj::TaskSet& waitUntilTasks,
     rpc::EventDispatcher::Client dispatcher) {
-  auto req = dispatcher.castAs<rpc::EventDispatcher>().queueRequest();
+  // Size the message's first segment to fit the whole batch up front. Queue batches routinely
+  // exceed capnp's default first segment, and without a hint the builder grows by allocating
+  // and copying progressively larger segments for every batch sent.
+  capnp::MessageSize hint { 16, 0 };
+  KJ_SWITCH_ONEOF(params) {
+    KJ_CASE_ONEOF(p, rpc::EventDispatcher::QueueParams::Reader) {
+      auto size = p.totalSize();
+      hint.wordCount += size.wordCount + 8;
+      hint.capCount += size.capCount;
+    }
+    KJ_CASE_ONEOF(p, QueueEvent::Params) {
+      hint.wordCount += p.queueName.size() / sizeof(capnp::word) + 1;
+      hint.wordCount += p.messages.size() * (capnp::sizeInWords<rpc::QueueMessage>() + 1);
+      for (auto& message: p.messages) {
+        hint.wordCount += message.id.size() / sizeof(capnp::word) + 1;
+        hint.wordCount += message.body.size() / sizeof(capnp::word) + 1;
+        KJ_IF_SOME(contentType, message.contentType) {
+          hint.wordCount += contentType.size() / sizeof(capnp::word) + 1;
+        }
+      }
+    }
+  }
+
+  auto req = dispatcher.castAs<rpc::EventDispatcher>().queueRequest(hint);
   KJ_SWITCH_ONEOF(params) {
     KJ_CASE_ONEOF(p, rpc::EventDispatcher::QueueParams::Reader) {
       req.setQueueName(p.getQueueName());
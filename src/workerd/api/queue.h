@@ -6,6 +6,7 @@
 
 #include <kj/async.h>
 #include <kj/common.h>
+#include <kj/vector.h>
 
 #include <workerd/api/basics.h>
 #include <workerd/io/worker-interface.capnp.h>
@@ -87,6 +88,34 @@ public:
 
 private:
   uint subrequestChannel;
+
+  // Messages buffered by send() while the queues_auto_batching compatibility flag is enabled.
+  // The batch is flushed as a single /batch subrequest at the next microtask checkpoint, or
+  // eagerly once it reaches the maximum number of messages allowed in a batch.
+  struct PendingAutoBatch {
+    // The request whose sends are being coalesced. Bindings outlive individual requests, so sends
+    // are only ever batched with other sends from the same request.
+    IoContext* context;
+
+    kj::Vector<MessageSendRequest> messages;
+
+    // Fulfilled with the outcome of the flushed batch subrequest; each buffered send() returns a
+    // branch of `forked`.
+    kj::Own<kj::PromiseFulfiller<kj::Promise<void>>> fulfiller;
+    kj::ForkedPromise<void> forked;
+  };
+  kj::Maybe<PendingAutoBatch> pendingAutoBatch;
+
+  // Serializes and sends any pending auto-batched messages. No-op if nothing is pending.
+  void flushPendingAutoBatch(jsg::Lock& js);
+
+  void visitForGc(jsg::GcVisitor& visitor) {
+    KJ_IF_SOME(pending, pendingAutoBatch) {
+      for (auto& message: pending.messages) {
+        visitor.visit(message.body);
+      }
+    }
+  }
 };
 
 // Event handler types
@@ -153,7 +182,17 @@ struct QueueRetryOptions {
 
 class QueueMessage final: public jsg::Object {
 public:
-  QueueMessage(jsg::Lock& js, rpc::QueueMessage::Reader message, IoPtr<QueueEventResult> result);
+  // Refcounted ownership of the serialized bodies for a whole batch. The bodies are copied out of
+  // the incoming event into one contiguous buffer, and each message's lazily-deserialized body
+  // holds a slice of it.
+  struct SerializedBatch: public kj::Refcounted {
+    SerializedBatch(kj::Array<kj::byte> data): data(kj::mv(data)) {}
+    kj::Array<kj::byte> data;
+  };
+
+  // `serializedBody` is this message's slice of the batch buffer, with the buffer itself attached.
+  QueueMessage(jsg::Lock& js, rpc::QueueMessage::Reader message,
+               kj::Array<kj::byte> serializedBody, IoPtr<QueueEventResult> result);
   QueueMessage(jsg::Lock& js, IncomingQueueMessage message, IoPtr<QueueEventResult> result);
 
   kj::StringPtr getId() { return id; }
@@ -181,19 +220,37 @@ public:
 
   void visitForMemoryInfo(jsg::MemoryTracker& tracker) const {
     tracker.trackField("id", id);
-    tracker.trackField("body", body);
+    KJ_SWITCH_ONEOF(body) {
+      KJ_CASE_ONEOF(lazy, LazyBody) {
+        tracker.trackFieldWithSize("serializedBody", lazy.bytes.size());
+      }
+      KJ_CASE_ONEOF(value, jsg::JsRef<jsg::JsValue>) {
+        tracker.trackField("body", value);
+      }
+    }
     tracker.trackFieldWithSize("IoPtr<QueueEventResult>", sizeof(IoPtr<QueueEventResult>));
   }
 
 private:
+  // A body that has been received but not yet read. Deserialization is deferred until `body` is
+  // first accessed, so consumers that ack or filter messages without reading them never pay for
+  // it; the deserialized value then replaces the serialized form so repeated accesses keep
+  // returning the same object.
+  struct LazyBody {
+    kj::Array<kj::byte> bytes;
+    kj::Maybe<kj::String> contentType;
+  };
+
   kj::String id;
   kj::Date timestamp;
-  jsg::JsRef<jsg::JsValue> body;
+  kj::OneOf<LazyBody, jsg::JsRef<jsg::JsValue>> body;
   uint16_t attempts;
   IoPtr<QueueEventResult> result;
 
   void visitForGc(jsg::GcVisitor& visitor) {
-    visitor.visit(body);
+    KJ_IF_SOME(value, body.tryGet<jsg::JsRef<jsg::JsValue>>()) {
+      visitor.visit(value);
+    }
   }
 };
 
@@ -80,8 +80,7 @@ jsg::Promise<R2Admin::ListResult> R2Admin::list(jsg::Lock& js,
     r2Result.throwIfError("listBucket", errorType);
 
     capnp::MallocMessageBuilder responseMessage;
-    capnp::JsonCodec json;
-    json.handleByAnnotation<R2ListResponse>();
+    auto& json = jsonCodecFor<R2ListResponse>();
     auto responseBuilder = responseMessage.initRoot<R2ListBucketResponse>();
     json.decode(KJ_ASSERT_NONNULL(r2Result.metadataPayload), responseBuilder);
 
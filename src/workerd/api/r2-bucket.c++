@@ -175,9 +175,8 @@ static kj::Maybe<jsg::Ref<T>> parseObjectMetadata(kj::StringPtr action, R2Result
   };
 
   capnp::MallocMessageBuilder responseMessage;
-  capnp::JsonCodec json;
   // Annoyingly our R2GetResponse alias isn't emitted.
-  json.handleByAnnotation<R2HeadResponse>();
+  auto& json = jsonCodecFor<R2HeadResponse>();
   auto responseBuilder = responseMessage.initRoot<R2HeadResponse>();
   json.decode(KJ_ASSERT_NONNULL(r2Result.metadataPayload), responseBuilder);
 
@@ -655,8 +654,7 @@ jsg::Promise<jsg::Ref<R2MultipartUpload>> R2Bucket::createMultipartUpload(jsg::L
       r2Result.throwIfError("createMultipartUpload", errorType);
 
       capnp::MallocMessageBuilder responseMessage;
-      capnp::JsonCodec json;
-      json.handleByAnnotation<R2CreateMultipartUploadResponse>();
+      auto& json = jsonCodecFor<R2CreateMultipartUploadResponse>();
       auto responseBuilder = responseMessage.initRoot<R2CreateMultipartUploadResponse>();
 
       json.decode(KJ_ASSERT_NONNULL(r2Result.metadataPayload), responseBuilder);
@@ -812,8 +810,7 @@ jsg::Promise<R2Bucket::ListResult> R2Bucket::list(
 
       R2Bucket::ListResult result;
       capnp::MallocMessageBuilder responseMessage;
-      capnp::JsonCodec json;
-      json.handleByAnnotation<R2ListResponse>();
+      auto& json = jsonCodecFor<R2ListResponse>();
       auto responseBuilder = responseMessage.initRoot<R2ListResponse>();
 
       json.decode(KJ_ASSERT_NONNULL(r2Result.metadataPayload), responseBuilder);
@@ -5,6 +5,7 @@
 #include "r2-multipart.h"
 #include "r2-bucket.h"
 #include "r2-rpc.h"
+#include <algorithm>
 #include <array>
 #include <math.h>
 #include <kj/compat/http.h>
@@ -15,6 +16,266 @@
 
 namespace workerd::api::public_beta {
 
+namespace {
+
+constexpr uint64_t MULTIPART_MIN_PART_SIZE = 5 * 1024 * 1024;
+constexpr uint64_t MULTIPART_DEFAULT_PART_SIZE = 8 * 1024 * 1024;
+constexpr int MULTIPART_DEFAULT_CONCURRENCY = 4;
+constexpr int MULTIPART_MAX_CONCURRENCY = 16;
+
+// WritableStreamSink backing createWritableStream(). It splits whatever is written to it into
+// fixed-size parts, keeps up to `concurrency` part uploads in flight at a time, and completes
+// the multipart upload when the stream is closed. A part's body is handed off to the HTTP client
+// as soon as its buffer is full, so at most `concurrency` part-sized buffers are ever held in
+// memory regardless of the total upload size.
+//
+// The sink holds copies of the key/uploadId/bucket info rather than a reference to the
+// R2MultipartUpload object, since the JS object may be GC'd while the stream is still being
+// pumped.
+class MultipartUploadSink final: public WritableStreamSink {
+public:
+  MultipartUploadSink(IoContext& context, uint clientIndex, kj::String key, kj::String uploadId,
+                      kj::Maybe<kj::String> adminBucket, uint64_t partSize, int concurrency)
+      : context(context), clientIndex(clientIndex), key(kj::mv(key)), uploadId(kj::mv(uploadId)),
+        adminBucket(kj::mv(adminBucket)), partSize(partSize), concurrency(concurrency),
+        buffer(kj::heapArray<kj::byte>(partSize)) {}
+
+  kj::Promise<void> write(kj::ArrayPtr<const kj::byte> data) override {
+    throwIfFailed();
+    while (data.size() > 0) {
+      auto n = kj::min(partSize - bufferFill, data.size());
+      memcpy(buffer.begin() + bufferFill, data.begin(), n);
+      bufferFill += n;
+      data = data.slice(n, data.size());
+      if (bufferFill == partSize) {
+        co_await launchPart();
+      }
+    }
+  }
+
+  kj::Promise<void> write(kj::ArrayPtr<const kj::ArrayPtr<const kj::byte>> pieces) override {
+    for (auto& piece: pieces) {
+      co_await write(piece);
+    }
+  }
+
+  kj::Promise<void> end() override {
+    throwIfFailed();
+
+    // Flush the final (possibly short) part. If nothing was ever written we still upload one
+    // empty part, since a multipart upload can't complete with zero parts.
+    if (bufferFill > 0 || nextPartNumber == 1) {
+      co_await launchPart();
+    }
+
+    co_await kj::joinPromisesFailFast(partTasks.releaseAsArray());
+    throwIfFailed();
+
+    // Parts finish out of order; complete wants them sorted.
+    std::sort(parts.begin(), parts.end(),
+        [](const auto& a, const auto& b) { return a.partNumber < b.partNumber; });
+
+    capnp::JsonCodec json;
+    json.handleByAnnotation<R2BindingRequest>();
+    capnp::MallocMessageBuilder requestMessage;
+
+    auto requestBuilder = requestMessage.initRoot<R2BindingRequest>();
+    requestBuilder.setVersion(VERSION_PUBLIC_BETA);
+    auto completeBuilder = requestBuilder.initPayload().initCompleteMultipartUpload();
+    completeBuilder.setObject(key);
+    completeBuilder.setUploadId(uploadId);
+    auto partsList = completeBuilder.initParts(parts.size());
+    for (auto i: kj::indices(parts)) {
+      partsList[i].setPart(parts[i].partNumber);
+      partsList[i].setEtag(parts[i].etag);
+    }
+
+    auto result = co_await sendR2Request(
+        "r2_completeMultipartUpload"_kjc, kj::none, json.encode(requestBuilder));
+    throwIfError("completeMultipartUpload", result);
+  }
+
+  void abort(kj::Exception reason) override {
+    // Cancel any in-flight part uploads.
+    partTasks.clear();
+
+    if (!abortSent) {
+      abortSent = true;
+
+      capnp::JsonCodec json;
+      json.handleByAnnotation<R2BindingRequest>();
+      capnp::MallocMessageBuilder requestMessage;
+
+      auto requestBuilder = requestMessage.initRoot<R2BindingRequest>();
+      requestBuilder.setVersion(VERSION_PUBLIC_BETA);
+      auto abortBuilder = requestBuilder.initPayload().initAbortMultipartUpload();
+      abortBuilder.setObject(key);
+      abortBuilder.setUploadId(uploadId);
+
+      // Fire and forget; as with R2MultipartUpload::abort(), failing to abort just leaves the
+      // upload to be cleaned up by the bucket's lifecycle policy.
+      context.addTask(sendR2Request(
+          "r2_abortMultipartUpload"_kjc, kj::none, json.encode(requestBuilder)).ignoreResult());
+    }
+  }
+
+private:
+  // Waits for an upload slot, then starts uploading the currently buffered part.
+  kj::Promise<void> launchPart() {
+    while (inFlight >= concurrency) {
+      auto paf = kj::newPromiseAndFulfiller<void>();
+      slotWaiter = kj::mv(paf.fulfiller);
+      co_await paf.promise;
+      throwIfFailed();
+    }
+
+    int partNumber = nextPartNumber++;
+    if (partNumber > 10000) {
+      kj::throwFatalException(kj::Exception(kj::Exception::Type::FAILED, __FILE__, __LINE__,
+          kj::str(JSG_EXCEPTION(RangeError)
+              ": Upload would exceed 10000 parts; use a larger partSize.")));
+    }
+
+    auto size = bufferFill;
+    auto data = kj::mv(buffer);
+    buffer = kj::heapArray<kj::byte>(partSize);
+    bufferFill = 0;
+    auto body = data.slice(0, size).attach(kj::mv(data));
+
+    capnp::JsonCodec json;
+    json.handleByAnnotation<R2BindingRequest>();
+    json.setHasMode(capnp::HasMode::NON_DEFAULT);
+    capnp::MallocMessageBuilder requestMessage;
+
+    auto requestBuilder = requestMessage.initRoot<R2BindingRequest>();
+    requestBuilder.setVersion(VERSION_PUBLIC_BETA);
+    auto uploadPartBuilder = requestBuilder.initPayload().initUploadPart();
+    uploadPartBuilder.setUploadId(uploadId);
+    uploadPartBuilder.setPartNumber(partNumber);
+    uploadPartBuilder.setObject(key);
+
+    auto promise = sendR2Request(
+        "r2_uploadPart"_kjc, kj::mv(body), json.encode(requestBuilder));
+
+    inFlight++;
+    partTasks.add(promise.then([this, partNumber](R2Result r2Result) {
+      KJ_IF_SOME(e, r2Result.toThrow) {
+        recordFailure(kj::Exception(kj::Exception::Type::FAILED, __FILE__, __LINE__,
+            kj::str(JSG_EXCEPTION(Error) ": uploadPart: ", e->getMessage(),
+                    " (", e->getV4Code(), ')')));
+      } else {
+        capnp::MallocMessageBuilder responseMessage;
+        auto& json = jsonCodecFor<R2UploadPartResponse>();
+        auto responseBuilder = responseMessage.initRoot<R2UploadPartResponse>();
+        json.decode(KJ_ASSERT_NONNULL(r2Result.metadataPayload), responseBuilder);
+        parts.add(R2MultipartUpload::UploadedPart {
+          partNumber, kj::str(responseBuilder.getEtag()) });
+      }
+      finishOne();
+    }, [this](kj::Exception&& e) {
+      recordFailure(kj::mv(e));
+      finishOne();
+    }));
+  }
+
+  // Runs doR2HTTPPutRequest() under the IoContext, since this sink's methods may be invoked
+  // from outside of it (e.g. while being pumped from another native stream).
+  kj::Promise<R2Result> sendR2Request(kj::ConstString operationName,
+                                      kj::Maybe<kj::Array<kj::byte>> body,
+                                      kj::String requestJson) {
+    return context.run([&context = context, clientIndex = clientIndex,
+                        adminBucket = adminBucket.map([](kj::String& s) { return kj::str(s); }),
+                        operationName = kj::mv(operationName), body = kj::mv(body),
+                        requestJson = kj::mv(requestJson)](jsg::Lock&) mutable {
+      auto client = context.getHttpClient(clientIndex, true, kj::none, kj::mv(operationName));
+      kj::StringPtr components[1];
+      auto path = fillR2Path(components, adminBucket);
+      kj::Maybe<R2PutValue> value;
+      KJ_IF_SOME(b, body) {
+        value = R2PutValue(kj::mv(b));
+      }
+      return doR2HTTPPutRequest(kj::mv(client), kj::mv(value), kj::none,
+                                kj::mv(requestJson), path, kj::none);
+    });
+  }
+
+  void recordFailure(kj::Exception&& e) {
+    if (failure == kj::none) {
+      failure = kj::mv(e);
+    }
+  }
+
+  // Called when a part upload settles: frees its slot and wakes up a waiting launchPart().
+  void finishOne() {
+    inFlight--;
+    KJ_IF_SOME(w, slotWaiter) {
+      w->fulfill();
+      slotWaiter = kj::none;
+    }
+  }
+
+  void throwIfFailed() {
+    KJ_IF_SOME(e, failure) {
+      kj::throwFatalException(kj::cp(e));
+    }
+  }
+
+  void throwIfError(kj::StringPtr action, R2Result& result) {
+    KJ_IF_SOME(e, result.toThrow) {
+      kj::throwFatalException(kj::Exception(kj::Exception::Type::FAILED, __FILE__, __LINE__,
+          kj::str(JSG_EXCEPTION(Error) ": ", action, ": ", e->getMessage(),
+                  " (", e->getV4Code(), ')')));
+    }
+  }
+
+  IoContext& context;
+  uint clientIndex;
+  kj::String key;
+  kj::String uploadId;
+  kj::Maybe<kj::String> adminBucket;
+  uint64_t partSize;
+  int concurrency;
+
+  kj::Array<kj::byte> buffer;
+  size_t bufferFill = 0;
+  int nextPartNumber = 1;
+
+  int inFlight = 0;
+  kj::Maybe<kj::Own<kj::PromiseFulfiller<void>>> slotWaiter;
+  kj::Vector<kj::Promise<void>> partTasks;
+  kj::Vector<R2MultipartUpload::UploadedPart> parts;
+  kj::Maybe<kj::Exception> failure;
+  bool abortSent = false;
+};
+
+}  // namespace
+
+jsg::Ref<WritableStream> R2MultipartUpload::createWritableStream(
+    jsg::Lock& js, jsg::Optional<WritableOptions> options) {
+  auto& context = IoContext::current();
+
+  uint64_t partSize = MULTIPART_DEFAULT_PART_SIZE;
+  int concurrency = MULTIPART_DEFAULT_CONCURRENCY;
+  KJ_IF_SOME(o, options) {
+    KJ_IF_SOME(ps, o.partSize) {
+      JSG_REQUIRE(ps >= 0 && uint64_t(ps) >= MULTIPART_MIN_PART_SIZE, RangeError,
+          "partSize must be at least 5 MiB. Actual value was: ", ps);
+      partSize = ps;
+    }
+    KJ_IF_SOME(c, o.concurrency) {
+      JSG_REQUIRE(c >= 1 && c <= MULTIPART_MAX_CONCURRENCY, RangeError,
+          "concurrency must be between 1 and ", MULTIPART_MAX_CONCURRENCY,
+          " (inclusive). Actual value was: ", c);
+      concurrency = c;
+    }
+  }
+
+  auto sink = kj::heap<MultipartUploadSink>(context, this->bucket->clientIndex, kj::str(key),
+      kj::str(uploadId), this->bucket->adminBucket.map([](kj::String& s) { return kj::str(s); }),
+      partSize, concurrency);
+  return jsg::alloc<WritableStream>(context, kj::mv(sink));
+}
+
 jsg::Promise<R2MultipartUpload::UploadedPart> R2MultipartUpload::uploadPart(
   jsg::Lock& js,
   int partNumber,
@@ -55,8 +316,7 @@ jsg::Promise<R2MultipartUpload::UploadedPart> R2MultipartUpload::uploadPart(
       r2Result.throwIfError("uploadPart", errorType);
 
       capnp::MallocMessageBuilder responseMessage;
-      capnp::JsonCodec json;
-      json.handleByAnnotation<R2UploadPartResponse>();
+      auto& json = jsonCodecFor<R2UploadPartResponse>();
       auto responseBuilder = responseMessage.initRoot<R2UploadPartResponse>();
 
       json.decode(KJ_ASSERT_NONNULL(r2Result.metadataPayload), responseBuilder);
@@ -20,6 +20,17 @@ class R2MultipartUpload: public jsg::Object {
       JSG_STRUCT_TS_OVERRIDE(R2UploadedPart);
     };
 
+    struct WritableOptions {
+      // Size in bytes of each uploaded part except the last. R2 requires at least 5 MiB.
+      jsg::Optional<int> partSize;
+
+      // Maximum number of part uploads kept in flight at a time.
+      jsg::Optional<int> concurrency;
+
+      JSG_STRUCT(partSize, concurrency);
+      JSG_STRUCT_TS_OVERRIDE(R2MultipartWritableOptions);
+    };
+
     R2MultipartUpload(kj::String key, kj::String uploadId, jsg::Ref<R2Bucket> bucket):
       key(kj::mv(key)), uploadId(kj::mv(uploadId)), bucket(kj::mv(bucket)) {}
 
@@ -36,12 +47,20 @@ class R2MultipartUpload: public jsg::Object {
         const jsg::TypeHandler<jsg::Ref<R2Error>>& errorType
     );
 
+    // Returns a WritableStream that manages the whole upload: it splits whatever is written to
+    // it into parts, keeps several part uploads in flight at a time, and completes the multipart
+    // upload when the stream is closed (or aborts it if the stream is aborted). This avoids
+    // sequencing parts from JavaScript, which leaves the upload idle between parts.
+    jsg::Ref<WritableStream> createWritableStream(
+        jsg::Lock& js, jsg::Optional<WritableOptions> options);
+
     JSG_RESOURCE_TYPE(R2MultipartUpload) {
       JSG_LAZY_READONLY_INSTANCE_PROPERTY(key, getKey);
       JSG_LAZY_READONLY_INSTANCE_PROPERTY(uploadId, getUploadId);
       JSG_METHOD(uploadPart);
       JSG_METHOD(abort);
       JSG_METHOD(complete);
+      JSG_METHOD(createWritableStream);
     }
 
     void visitForMemoryInfo(jsg::MemoryTracker& tracker) const {
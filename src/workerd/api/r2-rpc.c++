@@ -15,8 +15,7 @@
 
 namespace workerd::api {
 static kj::Own<R2Error> toError(uint statusCode, kj::StringPtr responseBody) {
-  capnp::JsonCodec json;
-  json.handleByAnnotation<public_beta::R2ErrorResponse>();
+  auto& json = jsonCodecFor<public_beta::R2ErrorResponse>();
   capnp::MallocMessageBuilder errorMessageArena;
   auto errorMessage = errorMessageArena.initRoot<public_beta::R2ErrorResponse>();
   json.decode(responseBody, errorMessage);
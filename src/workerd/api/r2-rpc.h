@@ -7,6 +7,7 @@
 #include <workerd/api/basics.h>
 #include <workerd/api/blob.h>
 #include <workerd/jsg/jsg.h>
+#include <capnp/compat/json.h>
 
 namespace workerd::api {
 
@@ -78,6 +79,20 @@ struct R2Result {
   void throwIfError(kj::StringPtr action, const jsg::TypeHandler<jsg::Ref<R2Error>>& errorType);
 };
 
+// Returns a lazily-initialized, thread-local JsonCodec configured to map `T` by its $Json
+// annotations. handleByAnnotation() walks the whole schema to build its handler tables, which is
+// measurable per-call overhead on hot paths like decoding list results; encode()/decode() are
+// const, so a per-thread instance can safely be reused.
+template <typename T>
+capnp::JsonCodec& jsonCodecFor() {
+  struct Holder {
+    capnp::JsonCodec codec;
+    Holder() { codec.handleByAnnotation<T>(); }
+  };
+  static thread_local Holder holder;
+  return holder.codec;
+}
+
 kj::Promise<R2Result> doR2HTTPGetRequest(
     kj::Own<kj::HttpClient> client,
     kj::String metadataPayload,
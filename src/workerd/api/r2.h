@@ -14,6 +14,7 @@ namespace workerd::api::public_beta {
     api::public_beta::R2Bucket, \
     api::public_beta::R2MultipartUpload, \
     api::public_beta::R2MultipartUpload::UploadedPart, \
+    api::public_beta::R2MultipartUpload::WritableOptions, \
     api::public_beta::R2Bucket::HeadResult, \
     api::public_beta::R2Bucket::GetResult, \
     api::public_beta::R2Bucket::Range, \
@@ -9,5 +9,10 @@ export default {
   async test(ctrl, env, ctx) {
     const buffer = rtti.exportTypes("2023-05-18", ["nodejs_compat"]);
     assert(buffer.byteLength > 0);
+
+    // Repeated exports of the same configuration are served from the process-wide cache and
+    // must be byte-identical.
+    const again = rtti.exportTypes("2023-05-18", ["nodejs_compat"]);
+    assert.deepStrictEqual(new Uint8Array(again), new Uint8Array(buffer));
   }
 }
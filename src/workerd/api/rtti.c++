@@ -5,6 +5,7 @@
 #include "rtti.h"
 
 #include <kj/map.h>
+#include <kj/mutex.h>
 #include <capnp/serialize-packed.h>
 
 #include <workerd/api/actor.h>
@@ -268,16 +269,53 @@ private:
   unsigned int structureIndex = 0;
 };
 
+// The encoded output is fully determined by the requested compatibility configuration: the
+// builder walks the entire API surface, which is an expensive pause when invoked on a live
+// isolate. Cache the encoded blobs process-wide so repeated requests -- the type-generation
+// scripts and the workerd:rtti endpoint ask for the same handful of configurations over and
+// over -- only pay for a copy. The cache is bounded because the key is caller-supplied; once
+// full, unrecognized configurations are still encoded, just not retained.
+constexpr size_t MAX_CACHED_RTTI_CONFIGS = 16;
+
+kj::Array<byte> encodeTypesCached(kj::String key, auto encodeFn) {
+  static kj::MutexGuarded<kj::HashMap<kj::String, kj::Array<byte>>> cache;
+
+  {
+    auto lock = cache.lockExclusive();
+    KJ_IF_SOME(cached, lock->find(key)) {
+      return kj::heapArray(cached.asPtr());
+    }
+  }
+
+  // Encode outside the lock; several isolates may request different configurations concurrently,
+  // and a bad configuration throws without poisoning the cache.
+  auto bytes = encodeFn();
+
+  auto lock = cache.lockExclusive();
+  if (lock->size() < MAX_CACHED_RTTI_CONFIGS) {
+    lock->upsert(kj::mv(key), kj::heapArray(bytes.asPtr()), [](auto&, auto&&) {
+      // Another thread encoded the same configuration in the meantime; keep the existing copy.
+    });
+  }
+  return bytes;
+}
+
 } // namespace
 
 kj::Array<byte> RTTIModule::exportTypes(kj::String compatDate, kj::Array<kj::String> compatFlags) {
-  TypesEncoder encoder(kj::mv(compatDate), kj::mv(compatFlags));
-  return encoder.encode();
+  auto key = kj::str(compatDate, '\n', kj::strArray(compatFlags, "\n"));
+  return encodeTypesCached(kj::mv(key), [&]() {
+    TypesEncoder encoder(kj::mv(compatDate), kj::mv(compatFlags));
+    return encoder.encode();
+  });
 }
 
 kj::Array<byte> RTTIModule::exportExperimentalTypes() {
-  TypesEncoder encoder;
-  return encoder.encode();
+  // '\n' can't appear in a compat date, so this key can't collide with an exportTypes() key.
+  return encodeTypesCached(kj::str("\n<experimental>"), []() {
+    TypesEncoder encoder;
+    return encoder.encode();
+  });
 }
 
 } // namespace workerd::api
@@ -6,8 +6,12 @@
 
 namespace workerd::api {
 
-ScheduledEvent::ScheduledEvent(double scheduledTime, kj::StringPtr cron)
-    : ExtendableEvent("scheduled"), scheduledTime(scheduledTime), cron(kj::str(cron)) {}
+ScheduledEvent::ScheduledEvent(double scheduledTime, kj::StringPtr cron,
+                               uint32_t shardIndex, uint32_t shardCount)
+    : ExtendableEvent("scheduled"), scheduledTime(scheduledTime), cron(kj::str(cron)),
+      shardIndex(shardIndex),
+      // Unsharded senders (including old RPC peers) may leave shardCount zero.
+      shardCount(shardCount == 0 ? 1 : shardCount) {}
 
 void ScheduledEvent::noRetry() {
   IoContext::current().setNoRetryScheduled();
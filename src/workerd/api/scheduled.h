@@ -11,12 +11,15 @@ namespace workerd::api {
 
 class ScheduledEvent final: public ExtendableEvent {
 public:
-  explicit ScheduledEvent(double scheduledTime, kj::StringPtr cron);
+  explicit ScheduledEvent(double scheduledTime, kj::StringPtr cron,
+                          uint32_t shardIndex, uint32_t shardCount);
 
   static jsg::Ref<ScheduledEvent> constructor(kj::String type) = delete;
 
   double getScheduledTime() { return scheduledTime; }
   kj::StringPtr getCron() { return cron; }
+  uint32_t getShardIndex() { return shardIndex; }
+  uint32_t getShardCount() { return shardCount; }
   void noRetry();
 
   JSG_RESOURCE_TYPE(ScheduledEvent) {
@@ -24,6 +27,8 @@ public:
 
       JSG_READONLY_INSTANCE_PROPERTY(scheduledTime, getScheduledTime);
       JSG_READONLY_INSTANCE_PROPERTY(cron, getCron);
+      JSG_READONLY_INSTANCE_PROPERTY(shardIndex, getShardIndex);
+      JSG_READONLY_INSTANCE_PROPERTY(shardCount, getShardCount);
       JSG_METHOD(noRetry);
   }
 
@@ -34,6 +39,11 @@ public:
 private:
   double scheduledTime;
   kj::String cron;
+
+  // Which slice of a fanned-out trigger this invocation covers. An unsharded invocation is
+  // shard 0 of 1.
+  uint32_t shardIndex;
+  uint32_t shardCount;
 };
 
 // Type used when calling a module-exported scheduled event handler.
@@ -44,11 +54,15 @@ public:
 
   double getScheduledTime() { return event->getScheduledTime(); }
   kj::StringPtr getCron() { return event->getCron(); }
+  uint32_t getShardIndex() { return event->getShardIndex(); }
+  uint32_t getShardCount() { return event->getShardCount(); }
   void noRetry() { event->noRetry(); }
 
   JSG_RESOURCE_TYPE(ScheduledController) {
     JSG_READONLY_INSTANCE_PROPERTY(scheduledTime, getScheduledTime);
     JSG_READONLY_INSTANCE_PROPERTY(cron, getCron);
+    JSG_READONLY_INSTANCE_PROPERTY(shardIndex, getShardIndex);
+    JSG_READONLY_INSTANCE_PROPERTY(shardCount, getShardCount);
     JSG_METHOD(noRetry);
   }
 
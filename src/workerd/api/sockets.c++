@@ -345,6 +345,14 @@ jsg::Ref<Socket> Socket::startTls(jsg::Lock& js, jsg::Optional<TlsOptions> tlsOp
     // that's the case.
     JSG_REQUIRE(*tlsStarter != nullptr, TypeError,
         "The request has finished before startTls completed.");
+    // TODO(perf): The handshake kicked off here runs entirely on this thread's event loop, inside
+    //   kj::TlsContext via the tlsStarter callback that the kj HTTP layer populated at connect
+    //   time. The asymmetric crypto (certificate chain verification plus the ECDHE exchange) is
+    //   CPU-bound, so a burst of outbound TLS connects can stall co-located workers. Offloading it
+    //   would mean either pumping the handshake through memory BIOs on a worker thread here, or
+    //   growing kj::TlsContext an async handshake hook (BoringSSL's private-key-method style) —
+    //   the latter is the right layer, since workerd never sees the SSL object. Until then, keep
+    //   an eye on handshake latency showing up in event loop lag metrics.
     auto secureStream = KJ_ASSERT_NONNULL(*tlsStarter)(acceptedHostname).then(
       [stream = connectionStream->addWrappedRef()]() mutable -> kj::Own<kj::AsyncIoStream> {
         return kj::mv(stream);
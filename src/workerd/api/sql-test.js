@@ -36,6 +36,27 @@ async function test(storage) {
     assert.equal(result[0]['?'], 456)
   }
 
+  {
+    // Test toArray() bulk materialization
+    const result = sql.exec("SELECT 123 AS a, 'hello' AS b, x'ff' AS c").toArray()
+    assert.equal(result.length, 1)
+    assert.equal(result[0].a, 123)
+    assert.equal(result[0].b, 'hello')
+    assert.equal(new Uint8Array(result[0].c)[0], 255)
+
+    // A consumed cursor yields an empty batch.
+    const cursor = sql.exec('SELECT 123')
+    assert.equal(cursor.toArray().length, 1)
+    assert.equal(cursor.toArray().length, 0)
+  }
+
+  {
+    // Test rawToArray() bulk materialization
+    const result = sql.exec("SELECT 123, 'hello'").rawToArray()
+    assert.equal(result.length, 1)
+    assert.deepEqual(result[0], [123, 'hello'])
+  }
+
   {
     // Test multiple binding values
     const result = [...sql.exec('SELECT ? + ?', 123, 456)]
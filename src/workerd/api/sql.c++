@@ -141,6 +141,94 @@ jsg::Ref<SqlStorage::Cursor::RawIterator> SqlStorage::Cursor::raw(jsg::Lock&) {
   return jsg::alloc<RawIterator>(JSG_THIS);
 }
 
+namespace {
+
+// Convert the value in the given column of the query's current row directly to a V8 value.
+// Unlike the iterator path, which routes values through JSG-wrapped kj types, this converts
+// eagerly while SQLite's buffers for the row are still valid, so it never needs to take
+// ownership of text values.
+jsg::JsValue columnToJs(jsg::Lock& js, SqliteDatabase::Query& query, uint column) {
+  KJ_SWITCH_ONEOF(query.getValue(column)) {
+    KJ_CASE_ONEOF(data, kj::ArrayPtr<const byte>) {
+      return jsg::JsValue(js.arrayBuffer(kj::heapArray(data)).getHandle(js));
+    }
+    KJ_CASE_ONEOF(text, kj::StringPtr) {
+      return js.str(text);
+    }
+    KJ_CASE_ONEOF(i, int64_t) {
+      // Coerce to double to match the iterator path; see rowIteratorNext().
+      return js.num(static_cast<double>(i));
+    }
+    KJ_CASE_ONEOF(d, double) {
+      return js.num(d);
+    }
+    KJ_CASE_ONEOF(_, decltype(nullptr)) {
+      return js.null();
+    }
+  }
+  KJ_UNREACHABLE;
+}
+
+}  // namespace
+
+template <typename Func>
+jsg::JsArray SqlStorage::Cursor::toArrayImpl(jsg::Lock& js, Func&& makeRow) {
+  kj::Vector<jsg::JsValue> rows;
+  KJ_IF_SOME(s, state) {
+    auto& query = s->query;
+
+    if (s->isFirst) {
+      s->isFirst = false;
+    } else {
+      query.nextRow();
+    }
+
+    while (!query.isDone()) {
+      rows.add(makeRow(js, *s));
+      query.nextRow();
+    }
+
+    // Save off row counts before the query goes away.
+    rowsRead = query.getRowsRead();
+    rowsWritten = query.getRowsWritten();
+    state = kj::none;
+  } else {
+    JSG_REQUIRE(!canceled, Error,
+        "SQL cursor was closed because the same statement was executed again. If you need to "
+        "run multiple copies of the same statement concurrently, you must create multiple "
+        "prepared statement objects.");
+    // Cursor was already fully consumed; the batch is simply empty.
+  }
+  return js.arr(rows.asPtr());
+}
+
+jsg::JsArray SqlStorage::Cursor::toArray(jsg::Lock& js) {
+  KJ_IF_SOME(s, state) {
+    cachedColumnNames.ensureInitialized(js, s->query);
+  }
+  auto names = state == kj::none
+      ? kj::ArrayPtr<jsg::JsRef<jsg::JsString>>(nullptr)
+      : cachedColumnNames.get();
+  return toArrayImpl(js, [&](jsg::Lock& js, State& s) {
+    auto row = js.obj();
+    for (auto i: kj::zeroTo(s.query.columnCount())) {
+      row.set(js, jsg::JsValue(names[i].getHandle(js)), columnToJs(js, s.query, i));
+    }
+    return jsg::JsValue(row);
+  });
+}
+
+jsg::JsArray SqlStorage::Cursor::rawToArray(jsg::Lock& js) {
+  return toArrayImpl(js, [&](jsg::Lock& js, State& s) {
+    auto columns = kj::heapArrayBuilder<jsg::JsValue>(s.query.columnCount());
+    for (auto i: kj::zeroTo(columns.capacity())) {
+      columns.add(columnToJs(js, s.query, i));
+    }
+    auto values = columns.finish();
+    return jsg::JsValue(js.arr(values.asPtr()));
+  });
+}
+
 // Returns the set of column names for the current Cursor. An exception will be thrown if the
 // iterator has already been fully consumed. The resulting columns may contain duplicate entries,
 // for instance a `SELECT *` across a join of two tables that share a column name.
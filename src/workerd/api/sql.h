@@ -111,9 +111,22 @@ public:
   double getRowsWritten();
 
   kj::Array<jsg::JsRef<jsg::JsString>> getColumnNames(jsg::Lock& js);
+
+  // Materializes all remaining rows into a single JavaScript array of row objects, consuming
+  // the cursor. For large results this is significantly faster than iterating row by row, since
+  // it crosses the JS/native boundary once for the whole batch and converts each cell to a V8
+  // value while SQLite's buffers for the current row are still valid.
+  jsg::JsArray toArray(jsg::Lock& js);
+
+  // Like toArray(), but each row is an array of values (in column order) rather than an object,
+  // mirroring raw().
+  jsg::JsArray rawToArray(jsg::Lock& js);
+
   JSG_RESOURCE_TYPE(Cursor) {
     JSG_ITERABLE(rows);
     JSG_METHOD(raw);
+    JSG_METHOD(toArray);
+    JSG_METHOD(rawToArray);
     JSG_READONLY_PROTOTYPE_PROPERTY(columnNames, getColumnNames);
     JSG_READONLY_PROTOTYPE_PROPERTY(rowsRead, getRowsRead);
     JSG_READONLY_PROTOTYPE_PROPERTY(rowsWritten, getRowsWritten);
@@ -203,6 +216,9 @@ private:
   kj::Maybe<CachedColumnNames> ownCachedColumnNames;
   CachedColumnNames& cachedColumnNames;
 
+  // Counts this cursor toward the isolate's per-category memory accounting.
+  jsg::MemoryAccountingToken accounting{jsg::MemoryCategory::SQL_CURSORS};
+
   void visitForGc(jsg::GcVisitor& visitor) {
     visitor.visit(statement);
   }
@@ -212,6 +228,11 @@ private:
 
   static kj::Maybe<RowDict> rowIteratorNext(jsg::Lock& js, jsg::Ref<Cursor>& obj);
   static kj::Maybe<kj::Array<Value>> rawIteratorNext(jsg::Lock& js, jsg::Ref<Cursor>& obj);
+  // Shared implementation of toArray()/rawToArray(): steps through all remaining rows, calling
+  // `makeRow` to convert each one to a JS value while the row's buffers are valid.
+  template <typename Func>
+  jsg::JsArray toArrayImpl(jsg::Lock& js, Func&& makeRow);
+
   template <typename Func>
   static auto iteratorImpl(jsg::Lock& js, jsg::Ref<Cursor>& obj, Func&& func)
       -> kj::Maybe<kj::Array<
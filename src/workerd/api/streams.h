@@ -12,6 +12,7 @@
 #include "streams/transform.h"
 #include "streams/compression.h"
 #include "streams/encoding.h"
+#include "streams/json.h"
 
 namespace workerd::api {
 
@@ -46,6 +47,7 @@ namespace workerd::api {
   api::DecompressionStream,                                           \
   api::TextEncoderStream,                                             \
   api::TextDecoderStream,                                             \
+  api::JsonParseStream,                                               \
   api::TextDecoderStream::TextDecoderStreamInit,                      \
   api::ByteLengthQueuingStrategy,                                     \
   api::CountQueuingStrategy,                                          \
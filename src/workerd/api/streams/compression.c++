@@ -4,6 +4,11 @@
 
 #include "compression.h"
 #include <workerd/io/features.h>
+#include <kj/mutex.h>
+#include <kj/thread.h>
+#include <kj/vector.h>
+#include <brotli/decode.h>
+#include <brotli/encode.h>
 #include <zlib.h>
 #include <deque>
 #include <vector>
@@ -13,6 +18,31 @@ namespace workerd::api {
 
 namespace {
 
+// Returns the executor for the process-wide compression thread, starting it on first use.
+//
+// (De)compressing a chunk is pure CPU work that can take milliseconds for large payloads, and
+// running it on the isolate thread stalls unrelated requests sharing that isolate. Instead, each
+// chunk is shipped to this dedicated thread and the result is delivered back to the calling
+// thread's event loop via executeAsync(). A single thread (rather than a pool) is sufficient
+// since each stream's chunks must be processed in order anyway, and it keeps cross-stream
+// ordering concerns out of the picture entirely.
+const kj::Executor& getCompressionExecutor() {
+  static const kj::Executor& executor = []() -> const kj::Executor& {
+    // Deliberately leaked: the thread and its event loop live for the rest of the process.
+    auto ready = new kj::MutexGuarded<kj::Maybe<kj::Own<const kj::Executor>>>();
+    new kj::Thread([ready]() {
+      kj::EventLoop loop;
+      kj::WaitScope waitScope(loop);
+      *ready->lockExclusive() = kj::getCurrentThreadExecutor().addRef();
+      kj::Promise<void>(kj::NEVER_DONE).wait(waitScope);
+    });
+    auto lock = ready->lockExclusive();
+    lock.wait([](auto& value) { return value != kj::none; });
+    return *KJ_ASSERT_NONNULL(*lock);
+  }();
+  return executor;
+}
+
 class Context {
 public:
   enum class Mode {
@@ -31,7 +61,132 @@ public:
   };
 
   explicit Context(Mode mode, kj::StringPtr format, ContextFlags flags) :
-      mode(mode), strictCompression(flags) {
+      mode(mode),
+      algorithm(format == "brotli" ? Algorithm::BROTLI : Algorithm::ZLIB),
+      strictCompression(flags) {
+    switch (algorithm) {
+      case Algorithm::ZLIB:
+        initZlib(getWindowBits(format));
+        break;
+      case Algorithm::BROTLI:
+        initBrotli();
+        break;
+    }
+  }
+
+  ~Context() noexcept(false) {
+    switch (algorithm) {
+      case Algorithm::ZLIB:
+        if (!StatePool::instance().tryRelease(mode, windowBits, ctx)) {
+          switch (mode) {
+            case Mode::COMPRESS:
+              deflateEnd(&ctx);
+              break;
+            case Mode::DECOMPRESS:
+              inflateEnd(&ctx);
+              break;
+          }
+        }
+        break;
+      case Algorithm::BROTLI:
+        if (brotliEncoder != nullptr) BrotliEncoderDestroyInstance(brotliEncoder);
+        if (brotliDecoder != nullptr) BrotliDecoderDestroyInstance(brotliDecoder);
+        break;
+    }
+  }
+
+  KJ_DISALLOW_COPY_AND_MOVE(Context);
+
+  void setInput(const void* in, size_t size) {
+    switch (algorithm) {
+      case Algorithm::ZLIB:
+        ctx.next_in = const_cast<byte*>(reinterpret_cast<const byte*>(in));
+        ctx.avail_in = size;
+        break;
+      case Algorithm::BROTLI:
+        brotliNextIn = reinterpret_cast<const byte*>(in);
+        brotliAvailIn = size;
+        break;
+    }
+  }
+
+  Result pumpOnce(int flush) {
+    switch (algorithm) {
+      case Algorithm::ZLIB:
+        return pumpZlibOnce(flush);
+      case Algorithm::BROTLI:
+        return pumpBrotliOnce(flush);
+    }
+    KJ_UNREACHABLE;
+  }
+
+private:
+  enum class Algorithm {
+    ZLIB,
+    BROTLI,
+  };
+
+  // Recycles zlib (de)compression states. Initializing a deflate context allocates a few hundred
+  // kilobytes of working memory, which is significant for workloads that compress thousands of
+  // small messages through short-lived streams. Resetting an existing state for reuse is cheap,
+  // so retired states are parked here, keyed by the parameters that are baked in at init time.
+  // Brotli states are not pooled since brotli exposes no public reset API.
+  class StatePool {
+  public:
+    static StatePool& instance() {
+      static StatePool pool;
+      return pool;
+    }
+
+    kj::Maybe<z_stream> tryAcquire(Mode mode, int windowBits) {
+      auto lock = entries.lockExclusive();
+      for (auto& entry: *lock) {
+        if (entry.mode == mode && entry.windowBits == windowBits) {
+          auto result = entry.ctx;
+          entry = lock->back();
+          lock->removeLast();
+          return result;
+        }
+      }
+      return kj::none;
+    }
+
+    // Takes ownership of `ctx` and returns true if it was successfully reset and pooled.
+    bool tryRelease(Mode mode, int windowBits, z_stream& ctx) {
+      int result = Z_OK;
+      switch (mode) {
+        case Mode::COMPRESS:
+          result = deflateReset(&ctx);
+          break;
+        case Mode::DECOMPRESS:
+          result = inflateReset(&ctx);
+          break;
+      }
+      if (result != Z_OK) return false;
+
+      auto lock = entries.lockExclusive();
+      if (lock->size() >= kMaxPooled) return false;
+      lock->add(Entry { mode, windowBits, ctx });
+      return true;
+    }
+
+  private:
+    struct Entry {
+      Mode mode;
+      int windowBits;
+      z_stream ctx;
+    };
+
+    static constexpr size_t kMaxPooled = 16;
+    kj::MutexGuarded<kj::Vector<Entry>> entries;
+  };
+
+  void initZlib(int windowBits) {
+    this->windowBits = windowBits;
+    KJ_IF_SOME(recycled, StatePool::instance().tryAcquire(mode, windowBits)) {
+      ctx = recycled;
+      return;
+    }
     int result = Z_OK;
     switch (mode) {
       case Mode::COMPRESS:
@@ -39,38 +194,33 @@ public:
             &ctx,
             Z_DEFAULT_COMPRESSION,
             Z_DEFLATED,
-            getWindowBits(format),
+            windowBits,
             8,  // memLevel = 8 is the default
             Z_DEFAULT_STRATEGY);
         break;
       case Mode::DECOMPRESS:
-        result = inflateInit2(&ctx, getWindowBits(format));
+        result = inflateInit2(&ctx, windowBits);
         break;
-      default:
-        KJ_UNREACHABLE;
     }
     JSG_REQUIRE(result == Z_OK, Error, "Failed to initialize compression context.");
   }
 
-  ~Context() noexcept(false) {
+  void initBrotli() {
     switch (mode) {
       case Mode::COMPRESS:
-        deflateEnd(&ctx);
+        brotliEncoder = BrotliEncoderCreateInstance(nullptr, nullptr, nullptr);
+        JSG_REQUIRE(brotliEncoder != nullptr, Error,
+            "Failed to initialize compression context.");
         break;
       case Mode::DECOMPRESS:
-        inflateEnd(&ctx);
+        brotliDecoder = BrotliDecoderCreateInstance(nullptr, nullptr, nullptr);
+        JSG_REQUIRE(brotliDecoder != nullptr, Error,
+            "Failed to initialize compression context.");
         break;
     }
   }
 
-  KJ_DISALLOW_COPY_AND_MOVE(Context);
-
-  void setInput(const void* in, size_t size) {
-    ctx.next_in = const_cast<byte*>(reinterpret_cast<const byte*>(in));
-    ctx.avail_in = size;
-  }
-
-  Result pumpOnce(int flush) {
+  Result pumpZlibOnce(int flush) {
     ctx.next_out = buffer;
     ctx.avail_out = sizeof(buffer);
 
@@ -110,7 +260,49 @@ public:
     };
   }
 
-private:
+  Result pumpBrotliOnce(int flush) {
+    byte* nextOut = buffer;
+    size_t availOut = sizeof(buffer);
+
+    switch (mode) {
+      case Mode::COMPRESS: {
+        auto op = flush == Z_FINISH ? BROTLI_OPERATION_FINISH : BROTLI_OPERATION_PROCESS;
+        JSG_REQUIRE(BrotliEncoderCompressStream(brotliEncoder, op,
+            &brotliAvailIn, &brotliNextIn, &availOut, &nextOut, nullptr),
+            Error, "Compression failed.");
+
+        // Keep pumping while there's input left or the encoder is sitting on buffered output.
+        bool moreWork = !BrotliEncoderIsFinished(brotliEncoder) &&
+            (brotliAvailIn > 0 || BrotliEncoderHasMoreOutput(brotliEncoder));
+        return Result {
+          .success = moreWork,
+          .buffer = kj::arrayPtr(buffer, sizeof(buffer) - availOut),
+        };
+      }
+      case Mode::DECOMPRESS: {
+        auto result = BrotliDecoderDecompressStream(brotliDecoder,
+            &brotliAvailIn, &brotliNextIn, &availOut, &nextOut, nullptr);
+        JSG_REQUIRE(result != BROTLI_DECODER_RESULT_ERROR, Error, "Decompression failed.");
+
+        if (strictCompression == ContextFlags::STRICT) {
+          // Mirror the zlib checks above: trailing data after the end of the stream, or closing
+          // the stream before the complete data has arrived, are TypeErrors.
+          JSG_REQUIRE(!(result == BROTLI_DECODER_RESULT_SUCCESS && brotliAvailIn > 0), TypeError,
+              "Trailing bytes after end of compressed data");
+          JSG_REQUIRE(!(flush == Z_FINISH && result == BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT),
+              TypeError,
+              "Called close() on a decompression stream with incomplete data");
+        }
+
+        return Result {
+          .success = result == BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT,
+          .buffer = kj::arrayPtr(buffer, sizeof(buffer) - availOut),
+        };
+      }
+    }
+    KJ_UNREACHABLE;
+  }
+
   static int getWindowBits(kj::StringPtr format) {
     // We use a windowBits value of 15 combined with the magic value
     // for the compression format type. For gzip, the magic value is
@@ -128,7 +320,13 @@ private:
   }
 
   Mode mode;
+  Algorithm algorithm;
   z_stream ctx = {};
+  int windowBits = 0;
+  BrotliEncoderState* brotliEncoder = nullptr;
+  BrotliDecoderState* brotliDecoder = nullptr;
+  const byte* brotliNextIn = nullptr;
+  size_t brotliAvailIn = 0;
   kj::byte buffer[4096];
 
   // For the eponymous compatibility flag
@@ -155,8 +353,7 @@ public:
         return kj::cp(exception);
       }
       KJ_CASE_ONEOF(open, Open) {
-        context.setInput(buffer.begin(), buffer.size());
-        return writeInternal(Z_NO_FLUSH);
+        return writeInternal(buffer, Z_NO_FLUSH);
       }
     }
     KJ_UNREACHABLE;
@@ -185,7 +382,9 @@ public:
 
   kj::Promise<void> end() override {
     state = Ended();
-    return writeInternal(Z_FINISH);
+    // Until the final flush lands, reads must not report EOF even though the state says Ended.
+    finishing = true;
+    return writeInternal(nullptr, Z_FINISH);
   }
 
   void abort(kj::Exception reason) override {
@@ -198,8 +397,9 @@ public:
     KJ_ASSERT(minBytes <= maxBytes);
     KJ_SWITCH_ONEOF(state) {
       KJ_CASE_ONEOF(ended, Ended) {
-        // There might still be data in the output buffer remaining to read.
-        if (output.empty()) return size_t(0);
+        // There might still be data in the output buffer remaining to read, and the final flush
+        // may still be running on the compression thread.
+        if (output.empty() && !finishing) return size_t(0);
         return tryReadInternal(
             kj::ArrayPtr<kj::byte>(reinterpret_cast<kj::byte*>(buffer), maxBytes),
             minBytes);
@@ -257,7 +457,7 @@ private:
     // output queue.
     // If we reached the end, resolve the read immediately as well, since no
     // new data is expected.
-    if (output.size() >= minBytes || state.template is<Ended>()) {
+    if (output.size() >= minBytes || (state.template is<Ended>() && !finishing)) {
       return copyIntoBuffer(dest);
     }
 
@@ -280,29 +480,44 @@ private:
     return canceler.wrap(kj::mv(promise.promise));
   }
 
-  kj::Promise<void> writeInternal(int flush) {
+  kj::Promise<void> writeInternal(kj::ArrayPtr<const kj::byte> input, int flush) {
     // TODO(later): This does not yet implement any backpressure. A caller can keep calling
     // write without reading, which will continue to fill the internal buffer.
     KJ_ASSERT(flush == Z_FINISH || state.template is<Open>());
-    Context::Result result;
-    KJ_IF_SOME(exception, kj::runCatchingExceptions([this, flush, &result]() {
-      result = context.pumpOnce(flush);
-    })) {
-      cancelInternal(kj::cp(exception));
-      return kj::mv(exception);
-    }
 
-    if (result.buffer.size() == 0) {
-      if (result.success) {
-        return writeInternal(flush);
+    // Run the zlib pump on the shared compression thread so the isolate's event loop stays
+    // responsive. This is safe because:
+    // - `input` remains valid until the returned promise settles, per the WritableStreamSink
+    //   contract, and writes on this sink are serialized, so `context` is only ever touched by
+    //   one task at a time.
+    // - If the returned promise is dropped, executeAsync() doesn't return until the remote task
+    //   has been canceled or completed, so the task can't outlive `this`.
+    // - Everything else (`output`, `pendingReads`, `state`) is only touched on this thread, in
+    //   the continuations below.
+    return getCompressionExecutor().executeAsync(
+        [this, input, flush]() -> kj::Array<const kj::byte> {
+      context.setInput(input.begin(), input.size());
+      kj::Vector<kj::byte> compressed;
+      for (;;) {
+        auto result = context.pumpOnce(flush);
+        compressed.addAll(result.buffer);
+        if (result.buffer.size() == 0 && !result.success) break;
       }
+      return compressed.releaseAsArray();
+    }).then([this, flush](kj::Array<const kj::byte> data) -> kj::Promise<void> {
+      KJ_IF_SOME(exception, state.template tryGet<kj::Exception>()) {
+        // The stream was canceled or aborted while the task was in flight; don't resurrect it.
+        return kj::cp(exception);
+      }
+      if (flush == Z_FINISH) {
+        finishing = false;
+      }
+      std::copy(data.begin(), data.end(), std::back_inserter(output));
       return maybeFulfillRead();
-    }
-
-    if (result.buffer.size() > 0) {
-      std::copy(result.buffer.begin(), result.buffer.end(), std::back_inserter(output));
-    }
-    return writeInternal(flush);
+    }, [this](kj::Exception&& exception) -> kj::Promise<void> {
+      cancelInternal(kj::cp(exception));
+      return kj::mv(exception);
+    });
   }
 
   // Fulfill as many pending reads as we can from the output buffer.
@@ -379,6 +594,11 @@ private:
   struct Open {};
 
   kj::OneOf<Open, Ended, kj::Exception> state = Open();
+
+  // True while the Z_FINISH triggered by end() is still in flight on the compression thread.
+  // Reads must not report EOF in that window even though `state` is already Ended.
+  bool finishing = false;
+
   Context context;
 
   kj::Canceler canceler;
@@ -387,9 +607,24 @@ private:
 };
 }  // namespace
 
+namespace {
+void checkFormat(jsg::Lock& js, kj::StringPtr format) {
+  // "brotli" is a non-standard extension, so it is only accepted when the brotli_content_encoding
+  // compatibility flag is enabled.
+  if (FeatureFlags::get(js).getBrotliContentEncoding()) {
+    JSG_REQUIRE(format == "deflate" || format == "gzip" || format == "deflate-raw" ||
+                 format == "brotli", TypeError,
+                 "The compression format must be either 'deflate', 'deflate-raw', 'gzip' or "
+                 "'brotli'.");
+  } else {
+    JSG_REQUIRE(format == "deflate" || format == "gzip" || format == "deflate-raw", TypeError,
+                 "The compression format must be either 'deflate', 'deflate-raw' or 'gzip'.");
+  }
+}
+}  // namespace
+
 jsg::Ref<CompressionStream> CompressionStream::constructor(jsg::Lock& js, kj::String format) {
-  JSG_REQUIRE(format == "deflate" || format == "gzip" || format == "deflate-raw", TypeError,
-               "The compression format must be either 'deflate', 'deflate-raw' or 'gzip'.");
+  checkFormat(js, format);
 
   auto readableSide =
       kj::refcounted<CompressionStreamImpl<Context::Mode::COMPRESS>>(kj::mv(format),
@@ -404,8 +639,7 @@ jsg::Ref<CompressionStream> CompressionStream::constructor(jsg::Lock& js, kj::St
 }
 
 jsg::Ref<DecompressionStream> DecompressionStream::constructor(jsg::Lock& js, kj::String format) {
-  JSG_REQUIRE(format == "deflate" || format == "gzip" || format == "deflate-raw", TypeError,
-               "The compression format must be either 'deflate', 'deflate-raw' or 'gzip'.");
+  checkFormat(js, format);
 
   auto readableSide =
       kj::refcounted<CompressionStreamImpl<Context::Mode::DECOMPRESS>>(
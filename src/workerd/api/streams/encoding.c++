@@ -24,6 +24,10 @@ jsg::Ref<TextEncoderStream> TextEncoderStream::constructor(jsg::Lock& js) {
       .transform = jsg::Function<Transformer::TransformAlgorithm>(
           [](jsg::Lock& js, auto chunk, auto controller) {
       auto str = jsg::check(chunk->ToString(js.v8Context()));
+      if (str->Length() == 0) {
+        // Per the spec's "encode and enqueue a chunk", empty output is not enqueued.
+        return js.resolvedPromise();
+      }
       auto maybeBuffer = v8::ArrayBuffer::MaybeNew(js.v8Isolate, str->Utf8Length(js.v8Isolate));
       JSG_ASSERT(!maybeBuffer.IsEmpty(), RangeError,
                   "Cannot allocate space for TextEncoder.encode");
@@ -70,6 +74,13 @@ jsg::Ref<TextDecoderStream> TextDecoderStream::constructor(
 
   // The controller will store c++ references to both the readable and writable
   // streams underlying controllers.
+  //
+  // Note that while this uses the standard TransformStream machinery, the per-chunk work is
+  // already native: the transform algorithm below is a C++ lambda invoked directly by the
+  // C++ controller, and the decode itself happens in TextDecoder without entering user JS.
+  // A fully internal path like IdentityTransformStream isn't possible here -- the internal
+  // stream implementation is byte-oriented, and this stream's output chunks are strings,
+  // which can only flow through the standard controller's JS-value queue.
   auto transformer = TransformStream::constructor(
     js,
     Transformer {
@@ -78,20 +89,29 @@ jsg::Ref<TextDecoderStream> TextDecoderStream::constructor(
                                 (decoder),
                                 (jsg::Lock& js, auto chunk, auto controller) {
         jsg::BufferSource source(js, chunk);
-        controller->enqueue(js, JSG_REQUIRE_NONNULL(
+        auto text = JSG_REQUIRE_NONNULL(
             decoder->decodePtr(js, source.asArrayPtr(), false),
             TypeError,
-            "Failed to decode input."));
+            "Failed to decode input.");
+        // Per the spec's "decode and enqueue a chunk", empty output -- e.g. a chunk that ends
+        // in the middle of a UTF-8 sequence -- is not enqueued at all. Skipping it also spares
+        // the reader a wakeup per empty chunk, which matters for small-chunk workloads.
+        if (text.length(js) > 0) {
+          controller->enqueue(js, text);
+        }
         return js.resolvedPromise();
       })),
       .flush = jsg::Function<Transformer::FlushAlgorithm>(
           JSG_VISITABLE_LAMBDA((decoder = decoder.addRef()),
                                 (decoder),
                                 (jsg::Lock& js, auto controller) {
-        controller->enqueue(js, JSG_REQUIRE_NONNULL(
+        auto text = JSG_REQUIRE_NONNULL(
             decoder->decodePtr(js, kj::ArrayPtr<kj::byte>(), true),
             TypeError,
-            "Failed to decode input."));
+            "Failed to decode input.");
+        if (text.length(js) > 0) {
+          controller->enqueue(js, text);
+        }
         return js.resolvedPromise();
       }))
     },
@@ -186,6 +186,48 @@ KJ_TEST("honest small stream") {
   KJ_ASSERT(stream.maxMaxBytesSeen(), 100);
 }
 
+KJ_TEST("IdentityTransformStream BYOB read accumulates across writes") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  auto impl = kj::refcounted<IdentityTransformStreamImpl>();
+
+  // A read with minBytes > 1 must not resolve until enough bytes arrive, and every write in
+  // between lands directly in the caller's buffer.
+  kj::byte buffer[16];
+  auto promise = impl->tryRead(buffer, 10, sizeof(buffer));
+
+  impl->write("abcd"_kj.asBytes()).wait(waitScope);
+  KJ_ASSERT(!promise.poll(waitScope));
+  impl->write("efgh"_kj.asBytes()).wait(waitScope);
+  KJ_ASSERT(!promise.poll(waitScope));
+  impl->write("ijkl"_kj.asBytes()).wait(waitScope);
+
+  KJ_ASSERT(promise.wait(waitScope) == 12);
+  KJ_ASSERT(kj::arrayPtr(buffer, 12) == "abcdefghijkl"_kj.asBytes());
+}
+
+KJ_TEST("IdentityTransformStream BYOB read returns partial data at close") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  auto impl = kj::refcounted<IdentityTransformStreamImpl>();
+
+  kj::byte buffer[16];
+  auto promise = impl->tryRead(buffer, 10, sizeof(buffer));
+
+  impl->write("abcd"_kj.asBytes()).wait(waitScope);
+  KJ_ASSERT(!promise.poll(waitScope));
+  impl->end().wait(waitScope);
+
+  // The close resolves the pending read with the bytes accumulated so far; the short count
+  // signals EOF.
+  KJ_ASSERT(promise.wait(waitScope) == 4);
+  KJ_ASSERT(kj::arrayPtr(buffer, 4) == "abcd"_kj.asBytes());
+
+  KJ_ASSERT(impl->tryRead(buffer, 1, sizeof(buffer)).wait(waitScope) == 0);
+}
+
 KJ_TEST("WritableStreamInternalController queue size assertion") {
 
   capnp::MallocMessageBuilder message;
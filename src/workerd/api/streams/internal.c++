@@ -8,6 +8,7 @@
 #include <workerd/jsg/jsg.h>
 #include <kj/vector.h>
 #include <workerd/api/util.h>
+#include <workerd/util/stream-utils.h>
 #include <workerd/util/string-buffer.h>
 #include <workerd/io/features.h>
 
@@ -31,19 +32,49 @@ namespace {
 }
 
 kj::Promise<void> pumpTo(ReadableStreamSource& input, WritableStreamSink& output, bool end) {
-  kj::byte buffer[4096]{};
+  // The pump adapts its per-iteration window to the sink's observed drain rate rather
+  // than using a fixed high water mark. Each chunk's write overlaps the next chunk's
+  // read; when the write finishes before the read does, the sink is keeping up and the
+  // window widens to cut down on round trips, while a write that is still pending when
+  // the read completes shrinks the window so that less data queues up behind a slow
+  // sink. The bounds line up with the pooled buffer size classes.
+  constexpr size_t MIN_WINDOW = 4096;
+  constexpr size_t MAX_WINDOW = 65536;
+  size_t window = 16384;
+
+  // Borrow pooled scratch buffers rather than embedding arrays in every pump's
+  // coroutine frame. Two buffers let the write of one chunk proceed while the next
+  // chunk is read into the other.
+  auto front = acquirePooledBuffer(MAX_WINDOW);
+  auto back = acquirePooledBuffer(MAX_WINDOW);
+
+  size_t amount = co_await input.tryRead(front.begin(), 1, window);
+
+  while (amount > 0) {
+    bool writeDone = false;
+    auto write = output.write(front.asPtr().slice(0, amount))
+        .then([&writeDone]() { writeDone = true; })
+        .eagerlyEvaluate(nullptr);
+
+    // Read the next chunk while the previous write is still in flight.
+    size_t nextAmount = co_await input.tryRead(back.begin(), 1, window);
+
+    if (writeDone) {
+      window = kj::min(window * 2, MAX_WINDOW);
+    } else {
+      window = kj::max(window / 2, MIN_WINDOW);
+    }
 
-  while (true) {
-    auto amount = co_await input.tryRead(buffer, 1, kj::size(buffer));
+    co_await write;
 
-    if (amount == 0) {
-      if (end) {
-        co_await output.end();
-      }
-      co_return;
-    }
+    auto tmp = kj::mv(front);
+    front = kj::mv(back);
+    back = kj::mv(tmp);
+    amount = nextAmount;
+  }
 
-    co_await output.write(kj::arrayPtr(buffer, amount));
+  if (end) {
+    co_await output.end();
   }
 }
 
@@ -1594,9 +1625,54 @@ jsg::Promise<void> WritableStreamInternalController::writeLoopAfterFrontOutputLo
       auto& writable = state.get<Writable>();
       auto check = makeChecker(request);
 
+      // If more writes are already queued up behind this one, drain as many of them as is
+      // reasonable into a single vectored write on the sink rather than paying a syscall per
+      // chunk. The limits here are a heuristic: coalescing a small number of small chunks is
+      // where the per-write overhead dominates; large writes are better off going out as they
+      // are queued.
+      //
+      // Note that this only helps writers that don't await every write() (awaiting each one
+      // serializes the queue, so there is never anything to coalesce). Buffering awaited
+      // writes -- cork/uncork with the ack resolved before the bytes reach the sink -- was
+      // considered and rejected: it would report success for data still sitting in a user-space
+      // buffer and defer write errors to some later operation, which changes observable
+      // stream semantics. Chatty producers (e.g. SSE) get coalescing today by issuing their
+      // writes without awaiting each one.
+      static constexpr size_t kMaxCoalescedWrites = 16;
+      static constexpr size_t kMaxCoalescedBytes = 64 * 1024;
+
+      size_t count = 1;
       auto amountToWrite = request.bytes.size();
+      while (count < queue.size() &&
+             count < kMaxCoalescedWrites &&
+             amountToWrite < kMaxCoalescedBytes) {
+        auto& next = queue[count];
+        // Writes waiting on an output lock cannot be issued yet, and zero-length writes are
+        // no-ops that the front of the loop handles specially. Both end the run.
+        if (next.outputLock != kj::none) break;
+        KJ_IF_SOME(write, next.event.tryGet<Write>()) {
+          if (write.bytes.size() == 0) break;
+          amountToWrite += write.bytes.size();
+          count++;
+        } else {
+          break;
+        }
+      }
 
-      auto promise = writable->write(request.bytes).attach(kj::mv(request.ownBytes));
+      kj::Promise<void> promise = nullptr;
+      if (count == 1) {
+        promise = writable->write(request.bytes).attach(kj::mv(request.ownBytes));
+      } else {
+        auto pieces = kj::heapArray<kj::ArrayPtr<const kj::byte>>(count);
+        auto backing = kj::heapArrayBuilder<jsg::V8Ref<v8::ArrayBuffer>>(count);
+        for (size_t i = 0; i < count; i++) {
+          auto& write = queue[i].event.get<Write>();
+          pieces[i] = write.bytes;
+          backing.add(kj::mv(write.ownBytes));
+        }
+        auto piecesPtr = pieces.asPtr();
+        promise = writable->write(piecesPtr).attach(kj::mv(pieces), backing.finish());
+      }
 
       // TODO(soon): We use awaitIoLegacy() here because if the stream terminates in JavaScript in
       // this same isolate, then the promise may actually be waiting on JavaScript to do something,
@@ -1608,15 +1684,20 @@ jsg::Promise<void> WritableStreamInternalController::writeLoopAfterFrontOutputLo
       // That's a larger refactor, though.
       return ioContext.awaitIoLegacy(js, kj::mv(promise)).then(js,
           ioContext.addFunctor(
-            [this, check, maybeAbort, amountToWrite](jsg::Lock& js) -> jsg::Promise<void> {
+            [this, check, maybeAbort, amountToWrite, count](jsg::Lock& js) -> jsg::Promise<void> {
         auto& request = check();
         maybeResolvePromise(js, request.promise);
         decreaseCurrentWriteBufferSize(js, amountToWrite);
         queue.pop_front();
+        for (size_t i = 1; i < count; i++) {
+          KJ_ASSERT(!queue.empty());
+          maybeResolvePromise(js, queue.front().event.get<Write>().promise);
+          queue.pop_front();
+        }
         maybeAbort(js, request);
         return writeLoop(js, IoContext::current());
       }), ioContext.addFunctor(
-            [this, check, maybeAbort, amountToWrite](jsg::Lock& js, jsg::Value reason)
+            [this, check, maybeAbort, amountToWrite, count](jsg::Lock& js, jsg::Value reason)
                 -> jsg::Promise<void> {
           auto handle = reason.getHandle(js);
           auto& request = check();
@@ -1624,6 +1705,11 @@ jsg::Promise<void> WritableStreamInternalController::writeLoopAfterFrontOutputLo
           decreaseCurrentWriteBufferSize(js, amountToWrite);
           maybeRejectPromise<void>(js, request.promise, handle);
           queue.pop_front();
+          for (size_t i = 1; i < count; i++) {
+            KJ_ASSERT(!queue.empty());
+            maybeRejectPromise<void>(js, queue.front().event.get<Write>().promise, handle);
+            queue.pop_front();
+          }
           if (!maybeAbort(js, request)) {
             writable->abort(js.exceptionToKj(reason.addRef(js)));
             drain(js, handle);
@@ -2208,44 +2294,28 @@ kj::Promise<size_t> IdentityTransformStreamImpl::tryRead(
     void* buffer,
     size_t minBytes,
     size_t maxBytes) {
-  size_t total = 0;
-  while (total < minBytes) {
-    // TODO(perf): tryReadInternal was written assuming minBytes would always be 1 but we've now
-    // introduced an API for user to specify a larger minBytes. For now, this is implemented as a
-    // naiive loop dispatching to the 1 byte version but would be better to bake it deeper into
-    // the implementation where it can be more efficient.
-    auto amount = co_await tryReadInternal(buffer, maxBytes);
-    KJ_ASSERT(amount <= maxBytes);
-    if (amount == 0) {
-      // EOF.
-      break;
-    }
-
-    total += amount;
-    buffer = reinterpret_cast<char*>(buffer) + amount;
-    maxBytes -= amount;
-  }
-
-  co_return total;
-}
-
-kj::Promise<size_t> IdentityTransformStreamImpl::tryReadInternal(void* buffer, size_t maxBytes) {
-  auto promise = readHelper(kj::arrayPtr(static_cast<kj::byte*>(buffer), maxBytes));
+  // The rendezvous accumulates bytes from successive writes directly in the caller's buffer
+  // until `minBytes` is satisfied, so a BYOB read never stages through an intermediate buffer
+  // or re-dispatches a loop of single-chunk reads.
+  auto promise = readHelper(kj::arrayPtr(static_cast<kj::byte*>(buffer), maxBytes), minBytes);
 
   KJ_IF_SOME(l, limit) {
-    promise = promise.then([this, &l = l](size_t amount) -> kj::Promise<size_t> {
+    promise = promise.then([this, &l = l, minBytes](size_t amount) -> kj::Promise<size_t> {
       if (amount > l) {
         auto exception = JSG_KJ_EXCEPTION(FAILED, TypeError,
             "Attempt to write too many bytes through a FixedLengthStream.");
         cancel(exception);
         return kj::mv(exception);
-      } else if (amount == 0 && l != 0) {
+      }
+      l -= amount;
+      if (amount < minBytes && l != 0) {
+        // A short read means the writable end was closed, but the expected length hasn't been
+        // reached.
         auto exception = JSG_KJ_EXCEPTION(FAILED, TypeError,
             "FixedLengthStream did not see all expected bytes before close().");
         cancel(exception);
         return kj::mv(exception);
       }
-      l -= amount;
       return amount;
     });
   }
@@ -2266,7 +2336,65 @@ kj::Promise<DeferredProxy<void>> IdentityTransformStreamImpl::pumpTo(
   JSG_REQUIRE(kj::dynamicDowncastIfAvailable<IdentityTransformStreamImpl>(output) == kj::none,
       TypeError, "Inter-TransformStream ReadableStream.pipeTo() is not implemented.");
 
-  return ReadableStreamSource::pumpTo(output, end);
+  if (limit != kj::none) {
+    // FixedLengthStream relies on the read path to enforce its byte limit, so it cannot use
+    // the direct-forwarding fast path below.
+    return ReadableStreamSource::pumpTo(output, end);
+  }
+
+  // Rather than bouncing every chunk through our internal rendezvous buffer via the generic
+  // read/write loop, enter a pumping state in which each write() on the writable end is
+  // forwarded directly into `output`. This saves a copy and a promise round trip per chunk.
+  KJ_SWITCH_ONEOF(state) {
+    KJ_CASE_ONEOF(idle, Idle) {
+      // Fall through to enter the pumping state below.
+    }
+    KJ_CASE_ONEOF(request, ReadRequest) {
+      KJ_FAIL_ASSERT("read operation already in flight");
+    }
+    KJ_CASE_ONEOF(request, WriteRequest) {
+      // Handled below.
+    }
+    KJ_CASE_ONEOF(exception, kj::Exception) {
+      return kj::cp(exception);
+    }
+    KJ_CASE_ONEOF(closed, StreamStates::Closed) {
+      // The writable end was already closed; all that's left is to finish the output.
+      if (end) {
+        return addNoopDeferredProxy(output.end());
+      }
+      return addNoopDeferredProxy(kj::READY_NOW);
+    }
+  }
+
+  auto paf = kj::newPromiseAndFulfiller<void>();
+
+  kj::Promise<void> preface = kj::READY_NOW;
+  KJ_IF_SOME(request, state.tryGet<WriteRequest>()) {
+    // A write was already waiting before the pump began. Deliver it to the sink first; the
+    // pumping state takes over for all subsequent writes.
+    preface = output.write(request.bytes)
+        .then([&fulfiller = *request.fulfiller]() {
+      fulfiller.fulfill();
+    }, [&fulfiller = *request.fulfiller](kj::Exception&& exception) {
+      fulfiller.reject(kj::cp(exception));
+      kj::throwFatalException(kj::mv(exception));
+    }).attach(kj::mv(request.fulfiller));
+  }
+
+  state = Pumping { output, end, kj::mv(paf.fulfiller) };
+
+  auto promise = preface
+      .then([pump = kj::mv(paf.promise)]() mutable { return kj::mv(pump); })
+      .attach(kj::defer([this]() {
+    // If we are torn down while still in the pumping state -- because the pump was canceled
+    // or the sink failed -- make sure later writes don't touch the now-invalid sink.
+    if (state.is<Pumping>()) {
+      state = KJ_EXCEPTION(DISCONNECTED, "pump canceled");
+    }
+  }));
+
+  return addNoopDeferredProxy(kj::mv(promise));
 }
 
 kj::Maybe<uint64_t> IdentityTransformStreamImpl::tryGetLength(StreamEncoding encoding) {
@@ -2288,6 +2416,9 @@ void IdentityTransformStreamImpl::cancel(kj::Exception reason) {
     KJ_CASE_ONEOF(request, WriteRequest) {
       request.fulfiller->reject(kj::cp(reason));
     }
+    KJ_CASE_ONEOF(pumping, Pumping) {
+      pumping.fulfiller->reject(kj::cp(reason));
+    }
     KJ_CASE_ONEOF(exception, kj::Exception) {
       // Already errored.
       return;
@@ -2312,9 +2443,13 @@ kj::Promise<void> IdentityTransformStreamImpl::write(kj::ArrayPtr<const byte> bu
 
 kj::Promise<void> IdentityTransformStreamImpl::write(
     kj::ArrayPtr<const kj::ArrayPtr<const kj::byte>> pieces) {
-  KJ_UNIMPLEMENTED("IdentityTransformStreamImpl piecewise write() not currently supported");
-  // TODO(soon): This will be called by TeeBranch::pumpTo(). We disallow that anyway, since we
-  //   disallow inter-TransformStream pumping.
+  // Deliver the pieces one at a time through writeHelper(). When the readable end is being
+  // pumped, each piece is forwarded straight to the sink; otherwise each one rendezvouses
+  // with a read as usual.
+  for (auto piece: pieces) {
+    if (piece.size() == 0) continue;
+    co_await writeHelper(piece);
+  }
 }
 
 kj::Promise<void> IdentityTransformStreamImpl::end() {
@@ -2335,6 +2470,9 @@ void IdentityTransformStreamImpl::abort(kj::Exception reason) {
     KJ_CASE_ONEOF(request, WriteRequest) {
       KJ_FAIL_ASSERT("abort() is supposed to wait for any pending write() to finish");
     }
+    KJ_CASE_ONEOF(pumping, Pumping) {
+      pumping.fulfiller->reject(kj::cp(reason));
+    }
     KJ_CASE_ONEOF(exception, kj::Exception) {
       // Already errored.
       return;
@@ -2349,13 +2487,14 @@ void IdentityTransformStreamImpl::abort(kj::Exception reason) {
   // TODO(conform): Proactively put ReadableStream into Errored state.
 }
 
-kj::Promise<size_t> IdentityTransformStreamImpl::readHelper(kj::ArrayPtr<kj::byte> bytes) {
+kj::Promise<size_t> IdentityTransformStreamImpl::readHelper(
+    kj::ArrayPtr<kj::byte> bytes, size_t minBytes) {
   KJ_SWITCH_ONEOF(state) {
     KJ_CASE_ONEOF(idle, Idle) {
       // No outstanding write request, switch to ReadRequest state.
 
       auto paf = kj::newPromiseAndFulfiller<size_t>();
-      state = ReadRequest { bytes, kj::mv(paf.fulfiller) };
+      state = ReadRequest { bytes, kj::mv(paf.fulfiller), minBytes };
       return kj::mv(paf.promise);
     }
     KJ_CASE_ONEOF(request, ReadRequest) {
@@ -2363,15 +2502,23 @@ kj::Promise<size_t> IdentityTransformStreamImpl::readHelper(kj::ArrayPtr<kj::byt
     }
     KJ_CASE_ONEOF(request, WriteRequest) {
       if (bytes.size() >= request.bytes.size()) {
-        // The write buffer will entirely fit into our read buffer; fulfill both requests.
+        // The write buffer will entirely fit into our read buffer; fulfill the write request.
         memcpy(bytes.begin(), request.bytes.begin(), request.bytes.size());
-        auto result = request.bytes.size();
+        auto amount = request.bytes.size();
         request.fulfiller->fulfill();
 
-        // Switch to idle state.
-        state = Idle();
+        if (amount >= minBytes) {
+          // Switch to idle state.
+          state = Idle();
+          return amount;
+        }
 
-        return result;
+        // The read wants more bytes before waking its caller; leave it pending with the
+        // remaining buffer space. Subsequent writes will continue filling it in place.
+        auto paf = kj::newPromiseAndFulfiller<size_t>();
+        state = ReadRequest {
+          bytes.slice(amount, bytes.size()), kj::mv(paf.fulfiller), minBytes - amount, amount };
+        return kj::mv(paf.promise);
       }
 
       // The write buffer won't quite fit into our read buffer; fulfill only the read request.
@@ -2379,6 +2526,9 @@ kj::Promise<size_t> IdentityTransformStreamImpl::readHelper(kj::ArrayPtr<kj::byt
       request.bytes = request.bytes.slice(bytes.size(), request.bytes.size());
       return bytes.size();
     }
+    KJ_CASE_ONEOF(pumping, Pumping) {
+      KJ_FAIL_ASSERT("read operation not permitted while pumping");
+    }
     KJ_CASE_ONEOF(exception, kj::Exception) {
       return kj::cp(exception);
     }
@@ -2419,8 +2569,9 @@ kj::Promise<void> IdentityTransformStreamImpl::writeHelper(kj::ArrayPtr<const kj
       }
 
       if (bytes.size() == 0) {
-        // This is a close operation.
-        request.fulfiller->fulfill(size_t(0));
+        // This is a close operation. If the read has accumulated bytes from earlier writes,
+        // deliver them; the short count tells the reader the stream ended.
+        request.fulfiller->fulfill(kj::cp(request.filled));
         state = StreamStates::Closed();
         return kj::READY_NOW;
       }
@@ -2428,17 +2579,28 @@ kj::Promise<void> IdentityTransformStreamImpl::writeHelper(kj::ArrayPtr<const kj
       KJ_ASSERT(request.bytes.size() > 0);
 
       if (request.bytes.size() >= bytes.size()) {
-        // Our write buffer will entirely fit into the read buffer; fulfill both requests.
+        // Our write buffer will entirely fit into the read buffer.
         memcpy(request.bytes.begin(), bytes.begin(), bytes.size());
-        request.fulfiller->fulfill(bytes.size());
-        state = Idle();
+
+        if (bytes.size() >= request.minBytes) {
+          // The read has now seen at least minBytes total; fulfill both requests.
+          request.fulfiller->fulfill(request.filled + bytes.size());
+          state = Idle();
+          return kj::READY_NOW;
+        }
+
+        // The read wants more bytes before waking its caller; record our contribution and leave
+        // it pending. Only the write is fulfilled.
+        request.bytes = request.bytes.slice(bytes.size(), request.bytes.size());
+        request.minBytes -= bytes.size();
+        request.filled += bytes.size();
         return kj::READY_NOW;
       }
 
       // Our write buffer won't quite fit into the read buffer; fulfill only the read request.
       memcpy(request.bytes.begin(), bytes.begin(), request.bytes.size());
       bytes = bytes.slice(request.bytes.size(), bytes.size());
-      request.fulfiller->fulfill(request.bytes.size());
+      request.fulfiller->fulfill(request.filled + request.bytes.size());
 
       auto paf = kj::newPromiseAndFulfiller<void>();
       state = WriteRequest { bytes, kj::mv(paf.fulfiller) };
@@ -2447,6 +2609,39 @@ kj::Promise<void> IdentityTransformStreamImpl::writeHelper(kj::ArrayPtr<const kj
     KJ_CASE_ONEOF(request, WriteRequest) {
       KJ_FAIL_ASSERT("write operation already in flight");
     }
+    KJ_CASE_ONEOF(pumping, Pumping) {
+      if (bytes.size() == 0) {
+        // This is a close operation. Finish the sink if requested, then resolve the pump.
+        auto fulfiller = kj::mv(pumping.fulfiller);
+        auto& output = pumping.output;
+        bool callEnd = pumping.end;
+        state = StreamStates::Closed();
+
+        if (callEnd) {
+          return output.end().then([&fulfiller = *fulfiller]() {
+            fulfiller.fulfill();
+          }, [&fulfiller = *fulfiller](kj::Exception&& exception) {
+            fulfiller.reject(kj::cp(exception));
+            kj::throwFatalException(kj::mv(exception));
+          }).attach(kj::mv(fulfiller));
+        }
+
+        fulfiller->fulfill();
+        return kj::READY_NOW;
+      }
+
+      // Forward the bytes directly into the sink, bypassing the rendezvous buffer entirely.
+      return pumping.output.write(bytes)
+          .catch_([this](kj::Exception&& exception) -> kj::Promise<void> {
+        // The sink rejected the write. Fail the pump and error the stream so that both ends
+        // observe the failure.
+        KJ_IF_SOME(pumping, state.tryGet<Pumping>()) {
+          pumping.fulfiller->reject(kj::cp(exception));
+          state = kj::cp(exception);
+        }
+        return kj::mv(exception);
+      });
+    }
     KJ_CASE_ONEOF(exception, kj::Exception) {
       return kj::cp(exception);
     }
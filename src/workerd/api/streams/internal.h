@@ -389,8 +389,6 @@ public:
 
   kj::Promise<size_t> tryRead(void* buffer, size_t minBytes, size_t maxBytes) override;
 
-  kj::Promise<size_t> tryReadInternal(void* buffer, size_t maxBytes);
-
   kj::Promise<DeferredProxy<void>> pumpTo(WritableStreamSink& output, bool end) override;
 
   kj::Maybe<uint64_t> tryGetLength(StreamEncoding encoding) override;
@@ -408,7 +406,7 @@ public:
   void abort(kj::Exception reason) override;
 
 private:
-  kj::Promise<size_t> readHelper(kj::ArrayPtr<kj::byte> bytes);
+  kj::Promise<size_t> readHelper(kj::ArrayPtr<kj::byte> bytes, size_t minBytes);
 
   kj::Promise<void> writeHelper(kj::ArrayPtr<const kj::byte> bytes);
 
@@ -420,6 +418,14 @@ private:
     //   read was canceled.)
 
     kj::Own<kj::PromiseFulfiller<size_t>> fulfiller;
+
+    // Additional bytes that must be copied into `bytes` before the read is fulfilled. A pending
+    // request accumulates bytes across multiple writes directly in the caller's buffer; `bytes`
+    // always points at the remaining unfilled space.
+    size_t minBytes = 1;
+
+    // Bytes already copied into the caller's buffer by earlier writes.
+    size_t filled = 0;
   };
 
   struct WriteRequest {
@@ -429,7 +435,19 @@ private:
 
   struct Idle {};
 
-  kj::OneOf<Idle, ReadRequest, WriteRequest, kj::Exception, StreamStates::Closed> state = Idle();
+  // The readable end is being pumped directly into a sink. While in this state, each write()
+  // on the writable end is forwarded straight into `output`, bypassing the internal
+  // rendezvous buffer and the extra promise hop per chunk. `output` remains valid for as long
+  // as this state is active: if the pump is canceled, the state is replaced before the caller
+  // destroys the sink.
+  struct Pumping {
+    WritableStreamSink& output;
+    bool end;
+    kj::Own<kj::PromiseFulfiller<void>> fulfiller;
+  };
+
+  kj::OneOf<Idle, ReadRequest, WriteRequest, Pumping, kj::Exception,
+            StreamStates::Closed> state = Idle();
 };
 
 }  // namespace workerd::api
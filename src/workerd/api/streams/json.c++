@@ -0,0 +1,109 @@
+// Copyright (c) 2017-2022 Cloudflare, Inc.
+// Licensed under the Apache 2.0 license found in the LICENSE file or at:
+//     https://opensource.org/licenses/Apache-2.0
+
+#include "json.h"
+#include "standard.h"
+#include <workerd/jsg/buffersource.h>
+#include <kj/vector.h>
+#include <cstring>
+
+namespace workerd::api {
+
+namespace {
+
+// Carries the trailing partial line between chunks. Complete lines are parsed directly
+// out of the incoming chunk whenever possible, so in the common case (many complete
+// records per chunk) no intermediate copy of the text is ever made. The newline scan
+// uses memchr(), which libc vectorizes.
+class NdJsonParser final: public kj::Refcounted {
+public:
+  void transform(jsg::Lock& js,
+                 kj::ArrayPtr<const char> chunk,
+                 jsg::Ref<TransformStreamDefaultController>& controller) {
+    while (chunk.size() > 0) {
+      auto nl = static_cast<const char*>(memchr(chunk.begin(), '\n', chunk.size()));
+      if (nl == nullptr) {
+        // No complete line remains in this chunk; stash the tail until more data arrives.
+        leftover.addAll(chunk);
+        return;
+      }
+      auto line = chunk.first(nl - chunk.begin());
+      chunk = chunk.slice(nl - chunk.begin() + 1, chunk.size());
+      if (leftover.size() > 0) {
+        leftover.addAll(line);
+        emit(js, leftover.asPtr(), controller);
+        leftover.clear();
+      } else {
+        emit(js, line, controller);
+      }
+    }
+  }
+
+  void flush(jsg::Lock& js, jsg::Ref<TransformStreamDefaultController>& controller) {
+    // A final record is permitted to omit the trailing newline.
+    if (leftover.size() > 0) {
+      emit(js, leftover.asPtr(), controller);
+      leftover.clear();
+    }
+  }
+
+private:
+  kj::Vector<char> leftover;
+
+  static void emit(jsg::Lock& js,
+                   kj::ArrayPtr<const char> line,
+                   jsg::Ref<TransformStreamDefaultController>& controller) {
+    // Tolerate CRLF separators and surrounding whitespace; skip blank lines entirely.
+    while (line.size() > 0 &&
+           (line.back() == '\r' || line.back() == ' ' || line.back() == '\t')) {
+      line = line.first(line.size() - 1);
+    }
+    while (line.size() > 0 && (line.front() == ' ' || line.front() == '\t')) {
+      line = line.slice(1, line.size());
+    }
+    if (line.size() == 0) {
+      return;
+    }
+
+    // An invalid record throws here, erroring both sides of the transform.
+    controller->enqueue(js, js.parseJson(line).getHandle(js));
+  }
+};
+
+}  // namespace
+
+jsg::Ref<JsonParseStream> JsonParseStream::constructor(jsg::Lock& js) {
+  auto parser = kj::refcounted<NdJsonParser>();
+
+  auto transformer = TransformStream::constructor(
+    js,
+    Transformer {
+      .transform = jsg::Function<Transformer::TransformAlgorithm>(
+          [parser = kj::addRef(*parser)]
+          (jsg::Lock& js, auto chunk, auto controller) mutable {
+        if (chunk->IsString()) {
+          auto text = js.toString(chunk);
+          parser->transform(js, text.asPtr(), controller);
+        } else {
+          jsg::BufferSource source(js, chunk);
+          parser->transform(js, source.asArrayPtr().asChars(), controller);
+        }
+        return js.resolvedPromise();
+      }),
+      .flush = jsg::Function<Transformer::FlushAlgorithm>(
+          [parser = kj::mv(parser)]
+          (jsg::Lock& js, auto controller) mutable {
+        parser->flush(js, controller);
+        return js.resolvedPromise();
+      })
+    },
+    StreamQueuingStrategy {},
+    StreamQueuingStrategy {});
+
+  return jsg::alloc<JsonParseStream>(
+      transformer->getReadable(),
+      transformer->getWritable());
+}
+
+}  // namespace workerd::api
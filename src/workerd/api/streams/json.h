@@ -0,0 +1,34 @@
+// Copyright (c) 2017-2022 Cloudflare, Inc.
+// Licensed under the Apache 2.0 license found in the LICENSE file or at:
+//     https://opensource.org/licenses/Apache-2.0
+
+#pragma once
+
+#include "transform.h"
+#include <workerd/jsg/jsg.h>
+
+namespace workerd::api {
+
+// A non-standard TransformStream that incrementally parses newline-delimited JSON
+// (NDJSON). The writable side accepts bytes (ArrayBuffer or ArrayBufferView) or
+// strings; the readable side emits one parsed JavaScript value per input line as
+// soon as that line is complete, so a multi-megabyte body never has to be buffered
+// and decoded as a single string before parsing can begin. Blank lines and CRLF
+// separators are tolerated; a trailing record without a final newline is parsed
+// when the writable side closes. A line that fails to parse errors the stream.
+//
+// Currently exposed only when the experimental compatibility flag is enabled.
+class JsonParseStream: public TransformStream {
+public:
+  using TransformStream::TransformStream;
+
+  static jsg::Ref<JsonParseStream> constructor(jsg::Lock& js);
+
+  JSG_RESOURCE_TYPE(JsonParseStream) {
+    JSG_INHERIT(TransformStream);
+
+    JSG_TS_OVERRIDE(extends TransformStream<ArrayBuffer | ArrayBufferView | string, any>);
+  }
+};
+
+}  // namespace workerd::api
@@ -0,0 +1,80 @@
+// Copyright (c) 2023 Cloudflare, Inc.
+// Licensed under the Apache 2.0 license found in the LICENSE file or at:
+//     https://opensource.org/licenses/Apache-2.0
+
+import {
+  deepStrictEqual,
+  rejects,
+  strictEqual,
+} from 'node:assert';
+
+async function collect(readable) {
+  const results = [];
+  for await (const value of readable) {
+    results.push(value);
+  }
+  return results;
+}
+
+export const basic = {
+  async test(ctrl, env, ctx) {
+    const ts = new JsonParseStream();
+    const writer = ts.writable.getWriter();
+    const enc = new TextEncoder();
+
+    const done = collect(ts.readable);
+    await writer.write(enc.encode('{"a":1}\n{"b"'));
+    await writer.write(enc.encode(':[2,3]}\n'));
+    await writer.close();
+
+    deepStrictEqual(await done, [{ a: 1 }, { b: [2, 3] }]);
+  }
+};
+
+export const trailingRecordAndBlankLines = {
+  async test(ctrl, env, ctx) {
+    const ts = new JsonParseStream();
+    const writer = ts.writable.getWriter();
+    const enc = new TextEncoder();
+
+    const done = collect(ts.readable);
+    // CRLF separators, blank lines, and a final record with no trailing
+    // newline are all tolerated.
+    await writer.write(enc.encode('1\r\n\r\n  \n"two"\r\n'));
+    await writer.write(enc.encode('[3]'));
+    await writer.close();
+
+    deepStrictEqual(await done, [1, 'two', [3]]);
+  }
+};
+
+export const stringChunks = {
+  async test(ctrl, env, ctx) {
+    const ts = new JsonParseStream();
+    const writer = ts.writable.getWriter();
+
+    const done = collect(ts.readable);
+    await writer.write('{"x":');
+    await writer.write('true}\n');
+    await writer.close();
+
+    deepStrictEqual(await done, [{ x: true }]);
+  }
+};
+
+export const invalidRecordErrors = {
+  async test(ctrl, env, ctx) {
+    const ts = new JsonParseStream();
+    const writer = ts.writable.getWriter();
+    const reader = ts.readable.getReader();
+    const enc = new TextEncoder();
+
+    writer.write(enc.encode('{"ok":1}\nnot json\n')).catch(() => {});
+
+    const first = await reader.read();
+    deepStrictEqual(first.value, { ok: 1 });
+    strictEqual(first.done, false);
+
+    await rejects(reader.read(), SyntaxError);
+  }
+};
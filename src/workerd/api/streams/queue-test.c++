@@ -102,7 +102,7 @@ auto byobRead(jsg::Lock& js, auto& consumer, int size) {
 };
 
 auto getEntry(jsg::Lock& js, auto size) {
-  return kj::heap<ValueQueue::Entry>(js.v8Ref(v8::True(js.v8Isolate).As<v8::Value>()), size);
+  return kj::refcounted<ValueQueue::Entry>(js.v8Ref(v8::True(js.v8Isolate).As<v8::Value>()), size);
 }
 
 #pragma region ValueQueue Tests
@@ -373,7 +373,7 @@ KJ_TEST("ByteQueue basics work") {
     KJ_ASSERT(queue.desiredSize() == 2);
     KJ_ASSERT(queue.size() == 0);
 
-    auto entry = kj::heap<ByteQueue::Entry>(
+    auto entry = kj::refcounted<ByteQueue::Entry>(
         jsg::BufferSource(js, jsg::BackingStore::alloc(js, 4)));
 
     queue.push(js, kj::mv(entry));
@@ -386,7 +386,7 @@ KJ_TEST("ByteQueue basics work") {
     queue.close(js);
 
     try {
-      auto entry = kj::heap<ByteQueue::Entry>(
+      auto entry = kj::refcounted<ByteQueue::Entry>(
           jsg::BufferSource(js, jsg::BackingStore::alloc(js, 4)));
       queue.push(js, kj::mv(entry));
       KJ_FAIL_ASSERT("The queue push after close should have failed.");
@@ -408,7 +408,7 @@ KJ_TEST("ByteQueue erroring works") {
     KJ_ASSERT(queue.desiredSize() == 0);
 
     try {
-      auto entry = kj::heap<ByteQueue::Entry>(
+      auto entry = kj::refcounted<ByteQueue::Entry>(
           jsg::BufferSource(js, jsg::BackingStore::alloc(js, 4)));
       queue.push(js, kj::mv(entry));
       KJ_FAIL_ASSERT("The queue push after close should have failed.");
@@ -429,7 +429,7 @@ KJ_TEST("ByteQueue with single consumer") {
     auto store = jsg::BackingStore::alloc(js, 4);
     store.asArrayPtr().fill('a');
 
-    auto entry = kj::heap<ByteQueue::Entry>(
+    auto entry = kj::refcounted<ByteQueue::Entry>(
         jsg::BufferSource(js, kj::mv(store)));
     queue.push(js, kj::mv(entry));
 
@@ -909,7 +909,7 @@ KJ_TEST("ByteQueue with default consumer with atLeast") {
 
     const auto push = [&](auto store) {
       try {
-        queue.push(js, kj::heap<ByteQueue::Entry>(
+        queue.push(js, kj::refcounted<ByteQueue::Entry>(
             jsg::BufferSource(js, kj::mv(store))));
       } catch (kj::Exception& ex) {
         KJ_DBG(ex.getDescription());
@@ -1000,7 +1000,7 @@ KJ_TEST("ByteQueue with multiple default consumers with atLeast (same rate)") {
 
     const auto push = [&](auto store) {
       try {
-        queue.push(js, kj::heap<ByteQueue::Entry>(
+        queue.push(js, kj::refcounted<ByteQueue::Entry>(
             jsg::BufferSource(js, kj::mv(store))));
       } catch (kj::Exception& ex) {
         KJ_DBG(ex.getDescription());
@@ -1110,7 +1110,7 @@ KJ_TEST("ByteQueue with multiple default consumers with atLeast (different rate)
 
     const auto push = [&](auto store) {
       try {
-        queue.push(js, kj::heap<ByteQueue::Entry>(
+        queue.push(js, kj::refcounted<ByteQueue::Entry>(
             jsg::BufferSource(js, kj::mv(store))));
       } catch (kj::Exception& ex) {
         KJ_DBG(ex.getDescription());
@@ -1221,6 +1221,37 @@ KJ_TEST("ByteQueue with multiple default consumers with atLeast (different rate)
   });
 }
 
+KJ_TEST("ByteQueue buffer pool recycles blocks") {
+  ByteQueue::BufferPool pool;
+  kj::byte* blockStart;
+
+  {
+    // Sequential allocations are carved contiguously out of the same block.
+    auto first = pool.alloc(100);
+    auto second = pool.alloc(100);
+    KJ_ASSERT(first.data.size() == 100);
+    KJ_ASSERT(first.data.end() == second.data.begin());
+
+    // addRef shares the same bytes rather than copying.
+    auto shared = first.addRef();
+    KJ_ASSERT(shared.data.begin() == first.data.begin());
+
+    auto big = pool.alloc(60000);
+    KJ_ASSERT(big.data.begin() == second.data.end());
+
+    blockStart = first.data.begin();
+  }
+
+  // All of the slices above have been released, so an allocation that does not fit in the
+  // remaining tail of the block recycles the block from the start rather than growing the pool.
+  auto recycled = pool.alloc(60000);
+  KJ_ASSERT(recycled.data.begin() == blockStart);
+
+  // Allocations at or above the block size get a dedicated, exactly-sized buffer.
+  auto standalone = pool.alloc(100000);
+  KJ_ASSERT(standalone.data.size() == 100000);
+}
+
 #pragma endregion ByteQueue Tests
 
 }  // namespace
@@ -47,7 +47,9 @@ void ValueQueue::Entry::visitForGc(jsg::GcVisitor& visitor) {
 #pragma region ValueQueue::QueueEntry
 
 kj::Own<ValueQueue::Entry> ValueQueue::Entry::clone(jsg::Lock& js) {
-  return kj::heap<Entry>(getValue(js), getSize());
+  // Entries are immutable once pushed into the queue, so all consumers can share a
+  // single refcounted instance.
+  return kj::addRef(*this);
 }
 
 ValueQueue::QueueEntry ValueQueue::QueueEntry::clone(jsg::Lock& js) {
@@ -305,16 +307,90 @@ kj::Own<ByteQueue::ByobRequest> ByteQueue::ReadRequest::makeByobReadRequest(
 
 #pragma endregion ByteQueue::ReadRequest
 
+#pragma region ByteQueue::BufferPool
+
+ByteQueue::BufferPool::Slice ByteQueue::BufferPool::alloc(size_t size) {
+  KJ_REQUIRE(size > 0);
+
+  if (size >= kBlockSize) {
+    // Too large to sub-allocate out of a shared block. Give it a dedicated one.
+    return allocStandalone(size);
+  }
+
+  // First, see if any of the existing blocks still has room at the end.
+  for (auto& block : blocks) {
+    if (block->used + size <= block->data.size()) {
+      auto data = block->data.slice(block->used, block->used + size);
+      block->used += size;
+      return Slice { kj::addRef(*block), data };
+    }
+  }
+
+  // All of the blocks are full. Recycle one whose slices have all been released.
+  for (auto& block : blocks) {
+    if (block->available()) {
+      block->used = size;
+      return Slice { kj::addRef(*block), block->data.slice(0, size) };
+    }
+  }
+
+  // Every block still has live slices. Grow the pool if it is under the limit, otherwise
+  // fall back to a dedicated allocation that will be freed when the slice is released.
+  if (blocks.size() >= kMaxBlocks) {
+    return allocStandalone(size);
+  }
+
+  auto block = kj::refcounted<Block>(kBlockSize);
+  block->used = size;
+  auto slice = Slice { kj::addRef(*block), block->data.slice(0, size) };
+  blocks.add(kj::mv(block));
+  return slice;
+}
+
+ByteQueue::BufferPool::Slice ByteQueue::BufferPool::allocStandalone(size_t size) {
+  KJ_REQUIRE(size > 0);
+  auto block = kj::refcounted<Block>(size);
+  block->used = size;
+  auto data = block->data.asPtr();
+  return Slice { kj::mv(block), data };
+}
+
+#pragma endregion ByteQueue::BufferPool
+
 #pragma region ByteQueue::Entry
 
 ByteQueue::Entry::Entry(jsg::BufferSource store) : store(kj::mv(store)) {}
 
-kj::ArrayPtr<kj::byte> ByteQueue::Entry::toArrayPtr() { return store.asArrayPtr(); }
+ByteQueue::Entry::Entry(BufferPool::Slice slice) : store(kj::mv(slice)) {}
+
+kj::ArrayPtr<kj::byte> ByteQueue::Entry::toArrayPtr() {
+  KJ_SWITCH_ONEOF(store) {
+    KJ_CASE_ONEOF(source, jsg::BufferSource) {
+      return source.asArrayPtr();
+    }
+    KJ_CASE_ONEOF(slice, BufferPool::Slice) {
+      return slice.data;
+    }
+  }
+  KJ_UNREACHABLE;
+}
 
-size_t ByteQueue::Entry::getSize() const { return store.size(); }
+size_t ByteQueue::Entry::getSize() const {
+  KJ_SWITCH_ONEOF(store) {
+    KJ_CASE_ONEOF(source, jsg::BufferSource) {
+      return source.size();
+    }
+    KJ_CASE_ONEOF(slice, BufferPool::Slice) {
+      return slice.data.size();
+    }
+  }
+  KJ_UNREACHABLE;
+}
 
 kj::Own<ByteQueue::Entry> ByteQueue::Entry::clone(jsg::Lock& js) {
-  return kj::heap<ByteQueue::Entry>(store.clone(js));
+  // Entries are immutable once pushed into the queue, so all consumers can share a
+  // single refcounted instance; each consumer tracks its own consumption offset.
+  return kj::addRef(*this);
 }
 
 void ByteQueue::Entry::visitForGc(jsg::GcVisitor& visitor) {}
@@ -429,23 +505,28 @@ bool ByteQueue::ByobRequest::respond(jsg::Lock& js, size_t amount) {
 
   auto sourcePtr = req.pullInto.store.asArrayPtr();
 
+  // Allocates small copies out of the queue's recycled buffer pool rather than paying for a
+  // fresh backing store per chunk. If the queue has already been closed there is no pool to
+  // reach, so fall back to a dedicated allocation.
+  const auto allocSlice = [this](size_t size) {
+    KJ_IF_SOME(state, queue.getState()) {
+      return state.pool.alloc(size);
+    }
+    return BufferPool::allocStandalone(size);
+  };
+
   if (queue.getConsumerCount() > 1) {
     // Allocate the entry into which we will be copying the provided data for the
     // other consumers of the queue.
-    KJ_IF_SOME(store, jsg::BufferSource::tryAlloc(js, amount)) {
-
-      auto entry = kj::heap<Entry>(kj::mv(store));
+    auto entry = kj::refcounted<Entry>(allocSlice(amount));
 
-      auto start = sourcePtr.begin() + req.pullInto.filled;
+    auto start = sourcePtr.begin() + req.pullInto.filled;
 
-      // Safely copy the data over into the entry.
-      std::copy(start, start + amount, entry->toArrayPtr().begin());
+    // Safely copy the data over into the entry.
+    std::copy(start, start + amount, entry->toArrayPtr().begin());
 
-      // Push the entry into the other consumers.
-      queue.push(js, kj::mv(entry), consumer);
-    } else {
-      js.throwException(js.error("Failed to allocate memory for the byob read response."_kj));
-    }
+    // Push the entry into the other consumers.
+    queue.push(js, kj::mv(entry), consumer);
   }
 
   // For this consumer, if the number of bytes provided in the response does not
@@ -479,13 +560,9 @@ bool ByteQueue::ByobRequest::respond(jsg::Lock& js, size_t amount) {
   if (unaligned > 0) {
     auto start = sourcePtr.begin() + (amount - unaligned);
 
-    KJ_IF_SOME(store, jsg::BufferSource::tryAlloc(js, unaligned)) {
-      auto excess = kj::heap<Entry>(kj::mv(store));
-      std::copy(start, start + unaligned, excess->toArrayPtr().begin());
-      consumer.push(js, kj::mv(excess));
-    } else {
-      js.throwException(js.error("Failed to allocate memory for the byob read response."_kj));
-    }
+    auto excess = kj::refcounted<Entry>(allocSlice(unaligned));
+    std::copy(start, start + unaligned, excess->toArrayPtr().begin());
+    consumer.push(js, kj::mv(excess));
   }
 
   return true;
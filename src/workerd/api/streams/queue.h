@@ -7,6 +7,8 @@
 #include "common.h"
 #include <workerd/jsg/jsg.h>
 #include <workerd/jsg/buffersource.h>
+#include <kj/refcount.h>
+#include <kj/vector.h>
 #include <deque>
 #include <set>
 
@@ -85,8 +87,8 @@ namespace workerd::api {
 //
 // The bookkeeping for a value queue is fairly simple:
 //
-//  - A single value entry is created.
-//  - Clones of that single value entry are distributed to each of
+//  - A single refcounted value entry is created.
+//  - References to that single value entry are distributed to each of
 //    the value queue consumers.
 //  - If a consumer has a pending read, the read is fulfilled immediately
 //    and the reference is never added to that consumer's internal buffer.
@@ -626,7 +628,10 @@ public:
 
   // A value queue entry consists of an arbitrary JavaScript value and a size that is
   // calculated by the size algorithm function provided in the stream constructor.
-  class Entry {
+  //
+  // Entries are refcounted so that all consumers of a queue share a single instance;
+  // each consumer's buffer holds only a reference. Entries are immutable once pushed.
+  class Entry final: public kj::Refcounted {
   public:
     explicit Entry(jsg::Value value, size_t size);
     KJ_DISALLOW_COPY_AND_MOVE(Entry);
@@ -839,8 +844,56 @@ public:
     QueueImpl& queue;
   };
 
+  // A simple slab allocator for the entries that the byte queue allocates internally (the
+  // copies made for additional consumers of a BYOB response, excess byte spillover, etc).
+  // High-throughput pipelines can churn through a very large number of small chunks; carving
+  // those out of a few large recycled blocks avoids paying for a fresh backing store allocation
+  // per chunk. Each slice holds a reference on its block; once every slice into a block has
+  // been released the block becomes eligible for reuse.
+  class BufferPool {
+  public:
+    class Block final: public kj::Refcounted {
+    public:
+      explicit Block(size_t size) : data(kj::heapArray<kj::byte>(size)) {}
+      KJ_DISALLOW_COPY_AND_MOVE(Block);
+
+    private:
+      kj::Array<kj::byte> data;
+      size_t used = 0;
+
+      // True when the pool holds the only reference, meaning every slice carved out of this
+      // block has been released and the block can be recycled.
+      bool available() const { return !isShared(); }
+
+      friend class BufferPool;
+    };
+
+    // A view over a range of bytes within a pooled block. Holding the Slice keeps the
+    // block alive.
+    struct Slice {
+      kj::Own<Block> block;
+      kj::ArrayPtr<kj::byte> data;
+
+      Slice addRef() { return Slice { kj::addRef(*block), data }; }
+    };
+
+    // Carves a slice of the given size out of one of the pooled blocks, recycling a fully
+    // released block or growing the pool as necessary.
+    Slice alloc(size_t size);
+
+    // Allocates a dedicated, exactly-sized slice that is not associated with any pool. Used
+    // when no pool is reachable (e.g. the queue has already been closed).
+    static Slice allocStandalone(size_t size);
+
+  private:
+    static constexpr size_t kBlockSize = 65536;
+    static constexpr size_t kMaxBlocks = 4;
+    kj::Vector<kj::Own<Block>> blocks;
+  };
+
   struct State {
     std::deque<kj::Own<ByobRequest>> pendingByobReadRequests;
+    BufferPool pool;
 
     JSG_MEMORY_INFO(ByteQueue::State) {
       for (auto& request : pendingByobReadRequests) {
@@ -849,11 +902,18 @@ public:
     }
   };
 
-  // A byte queue entry consists of a jsg::BufferSource containing a non-zero-length
-  // sequence of bytes. The size is determined by the number of bytes in the entry.
-  class Entry {
+  // A byte queue entry consists of a non-zero-length sequence of bytes, backed either by a
+  // jsg::BufferSource (for data enqueued from JavaScript) or by a slice of a pooled buffer
+  // (for copies the queue makes internally). The size is determined by the number of bytes
+  // in the entry.
+  //
+  // Entries are refcounted so that all consumers of a queue share a single instance;
+  // each consumer's buffer holds only a reference plus its own consumption offset.
+  // Entries are immutable once pushed.
+  class Entry final: public kj::Refcounted {
   public:
     explicit Entry(jsg::BufferSource store);
+    explicit Entry(BufferPool::Slice slice);
 
     kj::ArrayPtr<kj::byte> toArrayPtr();
 
@@ -864,11 +924,18 @@ public:
     kj::Own<Entry> clone(jsg::Lock& js);
 
     JSG_MEMORY_INFO(ByteQueue::Entry) {
-      tracker.trackField("store", store);
+      KJ_SWITCH_ONEOF(store) {
+        KJ_CASE_ONEOF(source, jsg::BufferSource) {
+          tracker.trackField("store", source);
+        }
+        KJ_CASE_ONEOF(slice, BufferPool::Slice) {
+          tracker.trackFieldWithSize("store", slice.data.size());
+        }
+      }
     }
 
   private:
-    jsg::BufferSource store;
+    kj::OneOf<jsg::BufferSource, BufferPool::Slice> store;
   };
 
   struct QueueEntry {
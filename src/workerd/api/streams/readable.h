@@ -407,6 +407,9 @@ private:
   // Used to signal when this ReadableStream reads EOF. This signal is required for TCP sockets.
   kj::Maybe<jsg::PromiseResolverPair<void>> eofResolverPair;
 
+  // Counts this stream toward the isolate's per-category memory accounting.
+  jsg::MemoryAccountingToken accounting{jsg::MemoryCategory::STREAMS};
+
   void visitForGc(jsg::GcVisitor& visitor);
 };
 
@@ -178,6 +178,9 @@ private:
   kj::Own<WeakRef<WritableStream>> weakRef =
       kj::refcounted<WeakRef<WritableStream>>(kj::Badge<WritableStream>(), *this);
 
+  // Counts this stream toward the isolate's per-category memory accounting.
+  jsg::MemoryAccountingToken accounting{jsg::MemoryCategory::STREAMS};
+
   kj::Own<WeakRef<WritableStream>> addWeakRef() { return weakRef->addRef(); }
 
   void visitForGc(jsg::GcVisitor& visitor);
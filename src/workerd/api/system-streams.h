@@ -17,6 +17,11 @@ namespace workerd::api {
 // one of the `tryRead()` overloads is never called, then a `pumpTo()` to a WritableStreamSink
 // returned by `newSystemStream()` of the same encoding will not cause any decoding/encoding steps.
 //
+// `tryRead()` writes directly into the caller's buffer -- for BYOB reads, that is the backing
+// memory of the script's own ArrayBuffer -- without staging through any intermediate buffer. The
+// only copies on the read path are those inherent to decoding when the stream's encoding is not
+// IDENTITY, in which case the decompressor's internal buffering applies.
+//
 // NOTE: `inner` must be wholly-owned. In particular, it cannot contain references to JavaScript
 //   heap objects, as the stream is allowed to outlive the isolate, especially in the case of
 //   deferred proxying. If the inner stream for some reason contains JS references, you'll need
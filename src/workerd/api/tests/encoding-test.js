@@ -613,3 +613,31 @@ export const textDecoderStream = {
     strictEqual(enc.encoding, 'utf-8');
   }
 };
+
+export const textDecoderStreamSplitSequences = {
+  async test() {
+    const stream = new TextDecoderStream();
+    const writer = stream.writable.getWriter();
+    const reader = stream.readable.getReader();
+
+    const bytes = new TextEncoder().encode('a€b');  // '€' encodes to 3 bytes
+    const writePromise = (async () => {
+      // Split in the middle of the euro sign's UTF-8 sequence.
+      await writer.write(bytes.slice(0, 2));
+      await writer.write(bytes.slice(2));
+      await writer.close();
+    })();
+
+    const chunks = [];
+    for (;;) {
+      const { value, done } = await reader.read();
+      if (done) break;
+      // Chunks that decode to nothing (incomplete sequences, final flush with no pending
+      // data) must not surface as empty string reads.
+      ok(value.length > 0);
+      chunks.push(value);
+    }
+    await writePromise;
+    strictEqual(chunks.join(''), 'a€b');
+  }
+};
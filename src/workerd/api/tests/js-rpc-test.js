@@ -1,5 +1,5 @@
 import assert from 'node:assert';
-import {WorkerEntrypoint,DurableObject,RpcStub,RpcTarget} from 'cloudflare:workers';
+import {WorkerEntrypoint,DurableObject,RpcStub,RpcTarget,RpcSerialized} from 'cloudflare:workers';
 
 class MyCounter extends RpcTarget {
   constructor(i = 0) {
@@ -471,6 +471,21 @@ export let basicServiceBinding = {
   },
 }
 
+export let preSerializedArguments = {
+  async test(controller, env, ctx) {
+    // An RpcSerialized can be passed in place of a single argument; the callee sees the original
+    // value, and the same object can be reused across calls without re-serializing.
+    let arg = new RpcSerialized(3);
+    assert.strictEqual(await env.self.oneArg(arg), 36);
+    assert.strictEqual(await env.MyService.oneArgMethod(arg), 36);
+
+    // Values needing per-call bookkeeping (like functions) are rejected at construction time.
+    assert.throws(() => new RpcSerialized(() => {}), {
+      name: "DataCloneError",
+    });
+  },
+}
+
 export let extendingEntrypointClasses = {
   async test(controller, env, ctx) {
     // Verify that we can instantiate classes that inherit built-in classes.
@@ -209,6 +209,33 @@ export const fallbackChainingOnError = {
   }
 }
 
+export const refreshAhead = {
+  async test(ctrl, env) {
+    // CACHE4 is configured with asyncRefreshWindowMs = 1000.
+    let fallbackCalls = 0;
+    const first = await env.CACHE4.read('ra', async () => {
+      fallbackCalls++;
+      return { value: 'v1', expiration: Date.now() + 500 };
+    });
+    strictEqual(first, 'v1');
+    // The entry expires within the refresh window, so this read serves the
+    // cached value immediately while invoking the fallback in the background.
+    const second = await env.CACHE4.read('ra', async () => {
+      fallbackCalls++;
+      return { value: 'v2', expiration: Date.now() + 60000 };
+    });
+    strictEqual(second, 'v1');
+    strictEqual(fallbackCalls, 2);
+    // Once the background refresh completes, the new value is served without
+    // invoking the fallback again.
+    await scheduler.wait(100);
+    const third = await env.CACHE4.read('ra', async () => {
+      throw new Error('should not be called');
+    });
+    strictEqual(third, 'v2');
+  }
+};
+
 export const fallbackNotLocked = {
   async test(ctrl, env) {
     // Test that one long running fallback does not block another one.
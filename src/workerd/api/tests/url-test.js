@@ -9801,3 +9801,33 @@ export const urlSearchParamsPipe = {
     strictEqual(url.searchParams.toString(), 'a=b%7Cc');
   }
 };
+
+export const urlSearchParamsLargeListLookups = {
+  test() {
+    // Exercises the lazily-built lookup index used once the param list is large enough,
+    // including invalidation on mutation.
+    const params = new URLSearchParams();
+    for (let i = 0; i < 40; i++) {
+      params.append(`key${i}`, `value${i}`);
+    }
+    params.append('key7', 'second');
+
+    strictEqual(params.get('key7'), 'value7');
+    deepStrictEqual(params.getAll('key7'), ['value7', 'second']);
+    ok(params.has('key7'));
+    ok(!params.has('nope'));
+    strictEqual(params.get('nope'), null);
+
+    // Mutations must be visible to subsequent lookups.
+    params.delete('key7');
+    ok(!params.has('key7'));
+    params.set('key8', 'replaced');
+    strictEqual(params.get('key8'), 'replaced');
+    deepStrictEqual(params.getAll('key8'), ['replaced']);
+
+    // Iteration order is unaffected by lookups: still insertion order.
+    const keys = [...params.keys()];
+    strictEqual(keys[0], 'key0');
+    strictEqual(keys[keys.length - 1], 'key39');
+  }
+};
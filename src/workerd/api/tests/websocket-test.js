@@ -0,0 +1,48 @@
+// Copyright (c) 2017-2022 Cloudflare, Inc.
+// Licensed under the Apache 2.0 license found in the LICENSE file or at:
+//     https://opensource.org/licenses/Apache-2.0
+
+import { strictEqual, deepStrictEqual, throws } from 'node:assert';
+
+export const sendBatch = {
+  async test() {
+    const pair = new WebSocketPair();
+    const [server, client] = [pair[0], pair[1]];
+    server.accept();
+    client.accept();
+
+    const received = [];
+    const done = new Promise((resolve) => {
+      client.addEventListener('message', (event) => {
+        received.push(event.data);
+      });
+      client.addEventListener('close', resolve);
+    });
+
+    // A batch delivers its messages in array order, interleaved correctly with
+    // surrounding send() calls.
+    server.send('before');
+    server.sendBatch(['one', 'two', new TextEncoder().encode('three').buffer]);
+    server.send('after');
+    server.close(1000, 'done');
+    await done;
+
+    strictEqual(received.length, 5);
+    deepStrictEqual(received.slice(0, 3), ['before', 'one', 'two']);
+    strictEqual(new TextDecoder().decode(received[3]), 'three');
+    strictEqual(received[4], 'after');
+
+    // An empty batch is a no-op, and batching after close() throws like send() does.
+    throws(() => server.sendBatch(['too late']), TypeError);
+  },
+};
+
+export const sendBatchEmpty = {
+  async test() {
+    const pair = new WebSocketPair();
+    pair[0].accept();
+    pair[1].accept();
+    pair[0].sendBatch([]);
+    pair[0].close(1000, 'done');
+  },
+};
@@ -581,6 +581,10 @@ kj::Promise<void> sendTracesToExportedHandler(
   auto& context = incomingRequest->getContext();
   auto& metrics = incomingRequest->getMetrics();
 
+  // Tail events are bulk work; don't let them queue ahead of interactive traffic on a shared
+  // isolate.
+  context.setLockPriority(Worker::LockPriority::BACKGROUND);
+
   KJ_IF_SOME(t, incomingRequest->getWorkerTracer()) {
     t.setEventInfo(context.now(), Trace::TraceEventInfo(traces));
   }
@@ -635,7 +639,16 @@ auto TraceCustomEventImpl::sendRpc(
       capnp::ByteStreamFactory& byteStreamFactory,
       kj::TaskSet& waitUntilTasks,
       workerd::rpc::EventDispatcher::Client dispatcher) -> kj::Promise<Result> {
-  auto req = dispatcher.sendTracesRequest();
+  // Trace batches can be large, so size the message's first segment to fit the whole batch and
+  // avoid the builder repeatedly growing (and copying) segments while we fill it in. Each trace
+  // tracks how many bytes of content it holds, which makes for a good estimate.
+  capnp::MessageSize hint { 16, 0 };
+  for (auto& trace: traces) {
+    hint.wordCount += trace->bytesUsed / sizeof(capnp::word) +
+        capnp::sizeInWords<rpc::Trace>() + 8;
+  }
+
+  auto req = dispatcher.sendTracesRequest(hint);
   auto out = req.initTraces(traces.size());
   for (auto i: kj::indices(traces)) {
     traces[i]->copyTo(out[i]);
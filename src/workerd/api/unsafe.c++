@@ -1,5 +1,9 @@
 #include "unsafe.h"
 
+#include <workerd/util/sentry.h>
+#include <kj/map.h>
+#include <kj/mutex.h>
+
 namespace workerd::api {
 
 namespace {
@@ -13,6 +17,53 @@ static constexpr auto ASYNC_FN_SUFFIX = "}"_kjc;
 inline kj::StringPtr getName(jsg::Optional<kj::String>& name, kj::StringPtr def) {
   return name.map([](kj::String& str) { return str.asPtr(); }).orDefault(def);
 }
+
+// Serialized code cache for functions produced by newFunction()/newAsyncFunction(), shared
+// process-wide and keyed by the full compilation input (source text plus the name and argument
+// names, which affect the generated code). Templated codegen tends to eval the same function
+// text over and over — and again after every isolate reload — so consuming V8's code cache
+// turns every compilation after the first into a cheap deserialization. Entries are never
+// evicted: the set of distinct sources is bounded by the calling code, and the cached data
+// must stay alive for as long as compilations may reference it.
+using EvalCodeCache = kj::HashMap<kj::String, kj::Own<v8::ScriptCompiler::CachedData>>;
+kj::MutexGuarded<EvalCodeCache>& evalCodeCache() {
+  static kj::MutexGuarded<EvalCodeCache> cache;
+  return cache;
+}
+
+kj::String makeCodeCacheKey(jsg::Lock& js, kj::StringPtr tag, jsg::JsString script,
+                            kj::StringPtr name,
+                            jsg::Arguments<jsg::JsRef<jsg::JsString>>& args) {
+  auto parts = kj::heapArrayBuilder<kj::String>(args.size());
+  for (auto& arg: args) {
+    parts.add(jsg::JsString(arg.getHandle(js)).toString(js));
+  }
+  return kj::str(tag, '\0', name, '\0',
+                 kj::strArray(parts.finish(), "\x01"), '\0',
+                 script.toString(js));
+}
+
+// Returns a CachedData instance to pass to the v8::ScriptCompiler::Source constructor (which
+// takes ownership of it) if we have cached code for this key, else nullptr.
+v8::ScriptCompiler::CachedData* findCachedCode(kj::StringPtr key) {
+  auto lock = evalCodeCache().lockShared();
+  KJ_IF_SOME(c, lock->find(key)) {
+    // We new here because v8 will take ownership of the CachedData instance, even tho we are
+    // maintaining ownership of the underlying buffer.
+    return new v8::ScriptCompiler::CachedData(c->data, c->length);
+  }
+  return nullptr;
+}
+
+void storeCachedCode(kj::String key, v8::ScriptCompiler::CachedData* cachePtr) {
+  if (cachePtr == nullptr) return;
+  kj::Own<v8::ScriptCompiler::CachedData> cached(cachePtr,
+      kj::_::HeapDisposer<v8::ScriptCompiler::CachedData>::instance);
+  auto lock = evalCodeCache().lockExclusive();
+  if (lock->find(key) == kj::none) {
+    lock->insert(kj::mv(key), kj::mv(cached));
+  }
+}
 } // namespace
 
 jsg::JsValue UnsafeEval::eval(jsg::Lock& js, kj::String script, jsg::Optional<kj::String> name) {
@@ -31,16 +82,34 @@ UnsafeEval::newFunction(jsg::Lock& js, jsg::JsString script, jsg::Optional<kj::S
 
   auto nameStr = js.str(getName(name, ANON_STR));
   v8::ScriptOrigin origin(nameStr);
-  v8::ScriptCompiler::Source source(script, origin);
+
+  auto key = makeCodeCacheKey(js, "function", script, getName(name, ANON_STR), args);
+  // Note that the Source takes ownership of the CachedData pointer that we pass in.
+  // Do not use it after this point.
+  v8::ScriptCompiler::Source source(script, origin, findCachedCode(key));
+
+  auto options = v8::ScriptCompiler::CompileOptions::kNoCompileOptions;
+  auto maybeCached = source.GetCachedData();
+  if (maybeCached != nullptr) {
+    if (!maybeCached->rejected) {
+      options = v8::ScriptCompiler::CompileOptions::kConsumeCodeCache;
+    } else {
+      LOG_WARNING_ONCE("NOSENTRY Cached data for unsafe-eval function was rejected");
+    }
+  }
 
   auto argNames = KJ_MAP(arg, args) {
     return v8::Local<v8::String>(arg.getHandle(js));
   };
 
   auto fn = jsg::check(v8::ScriptCompiler::CompileFunction(js.v8Context(), &source, argNames.size(),
-                                                           argNames.begin(), 0, nullptr));
+                                                           argNames.begin(), 0, nullptr, options));
   fn->SetName(nameStr);
 
+  if (options != v8::ScriptCompiler::CompileOptions::kConsumeCodeCache) {
+    storeCachedCode(kj::mv(key), v8::ScriptCompiler::CreateCodeCacheForFunction(fn));
+  }
+
   return KJ_ASSERT_NONNULL(handler.tryUnwrap(js, fn));
 }
 
@@ -80,9 +149,29 @@ UnsafeEval::newAsyncFunction(jsg::Lock& js, jsg::JsString script, jsg::Optional<
   prepared = v8::String::Concat(js.v8Isolate, prepared, nameStr);
 
   v8::ScriptOrigin origin(nameStr);
-  v8::ScriptCompiler::Source source(prepared, origin);
 
-  auto compiled = jsg::check(v8::ScriptCompiler::Compile(js.v8Context(), &source));
+  auto key = makeCodeCacheKey(js, "asyncFunction", script, getName(name, ANON_STR), args);
+  // Note that the Source takes ownership of the CachedData pointer that we pass in.
+  // Do not use it after this point.
+  v8::ScriptCompiler::Source source(prepared, origin, findCachedCode(key));
+
+  auto options = v8::ScriptCompiler::CompileOptions::kNoCompileOptions;
+  auto maybeCached = source.GetCachedData();
+  if (maybeCached != nullptr) {
+    if (!maybeCached->rejected) {
+      options = v8::ScriptCompiler::CompileOptions::kConsumeCodeCache;
+    } else {
+      LOG_WARNING_ONCE("NOSENTRY Cached data for unsafe-eval async function was rejected");
+    }
+  }
+
+  auto compiled = jsg::check(v8::ScriptCompiler::Compile(js.v8Context(), &source, options));
+
+  if (options != v8::ScriptCompiler::CompileOptions::kConsumeCodeCache) {
+    storeCachedCode(kj::mv(key), v8::ScriptCompiler::CreateCodeCache(
+        compiled->GetUnboundScript()));
+  }
+
   auto result = jsg::check(compiled->Run(js.v8Context()));
 
   KJ_REQUIRE(result->IsAsyncFunction());
@@ -50,6 +50,16 @@ bool URL::canParse(kj::String url, jsg::Optional<kj::String> maybeBase) {
   return jsg::Url::canParse(url, maybeBase.map([](kj::String& str) { return str.asPtr(); }));
 }
 
+kj::Array<kj::Maybe<jsg::Ref<URL>>> URL::parseAll(
+    kj::Array<kj::String> urls, jsg::Optional<kj::String> maybeBase) {
+  auto inputs = KJ_MAP(url, urls) -> kj::ArrayPtr<const char> { return url.asPtr(); };
+  auto results = jsg::Url::tryParseBatch(inputs,
+      maybeBase.map([](kj::String& str) -> kj::ArrayPtr<const char> { return str.asPtr(); }));
+  return KJ_MAP(result, results) -> kj::Maybe<jsg::Ref<URL>> {
+    return kj::mv(result).map([](jsg::Url&& url) { return jsg::alloc<URL>(kj::mv(url)); });
+  };
+}
+
 jsg::Ref<URLSearchParams> URL::getSearchParams() {
   KJ_IF_SOME(searchParams, maybeSearchParams) {
     return searchParams.addRef();
@@ -166,6 +176,30 @@ uint URLSearchParams::getSize() {
   return inner.size();
 }
 
+namespace {
+// Param count below which a linear scan through the entries is cheaper than building the
+// lookup index.
+constexpr size_t MIN_INDEXED_SIZE = 16;
+}  // namespace
+
+kj::Maybe<URLSearchParams::Index&> URLSearchParams::getIndex() {
+  KJ_IF_SOME(index, maybeIndex) {
+    return index;
+  }
+  if (inner.size() < MIN_INDEXED_SIZE) {
+    return kj::none;
+  }
+  Index index;
+  auto iter = inner.getEntries();
+  while (iter.hasNext()) {
+    auto entry = KJ_ASSERT_NONNULL(iter.next());
+    index.findOrCreate(entry.key, [&]() -> Index::Entry {
+      return { entry.key, {} };
+    }).add(entry.value);
+  }
+  return maybeIndex.emplace(kj::mv(index));
+}
+
 void URLSearchParams::update() {
   KJ_IF_SOME(url, maybeUrl) {
     auto serialized = toString();
@@ -177,15 +211,18 @@ void URLSearchParams::reset() {
   KJ_IF_SOME(url, maybeUrl) {
     auto search = kj::Maybe(url.inner.getSearch());
     inner = initFromSearch(search);
+    invalidateIndex();
   }
 }
 
 void URLSearchParams::append(kj::String name, kj::String value) {
   inner.append(name, value);
+  invalidateIndex();
   update();
 }
 
 void URLSearchParams::delete_(jsg::Lock& js, kj::String name, jsg::Optional<kj::String> value) {
+  invalidateIndex();
   KJ_ON_SCOPE_SUCCESS(update());
   if (FeatureFlags::get(js).getUrlSearchParamsDeleteHasValueArg()) {
     // The whatwg url spec was updated to add a second optional argument to delete()
@@ -201,10 +238,22 @@ void URLSearchParams::delete_(jsg::Lock& js, kj::String name, jsg::Optional<kj::
 }
 
 kj::Maybe<kj::ArrayPtr<const char>> URLSearchParams::get(kj::String name) {
+  KJ_IF_SOME(index, getIndex()) {
+    KJ_IF_SOME(values, index.find(name.asArray())) {
+      return values[0];
+    }
+    return kj::none;
+  }
   return inner.get(name);
 }
 
 kj::Array<kj::ArrayPtr<const char>> URLSearchParams::getAll(kj::String name) {
+  KJ_IF_SOME(index, getIndex()) {
+    KJ_IF_SOME(values, index.find(name.asArray())) {
+      return kj::heapArray<kj::ArrayPtr<const char>>(values.asPtr());
+    }
+    return {};
+  }
   return inner.getAll(name);
 }
 
@@ -215,19 +264,32 @@ bool URLSearchParams::has(jsg::Lock& js, kj::String name, jsg::Optional<kj::Stri
     // the change could break at least a couple existing deployed workers so we have
     // to gate support behind a compat flag.
     KJ_IF_SOME(v, value) {
+      KJ_IF_SOME(index, getIndex()) {
+        KJ_IF_SOME(values, index.find(name.asArray())) {
+          for (auto& candidate: values) {
+            if (candidate == v.asArray()) return true;
+          }
+        }
+        return false;
+      }
       return inner.has(name, kj::Maybe(v.asPtr()));
     }
   }
+  KJ_IF_SOME(index, getIndex()) {
+    return index.find(name.asArray()) != kj::none;
+  }
   return inner.has(name);
 }
 
 void URLSearchParams::set(kj::String name, kj::String value) {
   inner.set(name, value);
+  invalidateIndex();
   update();
 }
 
 void URLSearchParams::sort() {
   inner.sort();
+  invalidateIndex();
   update();
 }
 
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <kj/hash.h>
+#include <kj/map.h>
 #include "form-data.h"
 #include <workerd/jsg/jsg.h>
 #include <workerd/jsg/url.h>
@@ -124,6 +125,18 @@ private:
   jsg::UrlSearchParams inner;
   kj::Maybe<URL&> maybeUrl;
 
+  // Lazily-built index over the current entries, so get()/has()/getAll() on large param lists
+  // don't scan linearly per lookup. The ArrayPtrs point into `inner`'s storage, so every
+  // mutation of `inner` must call invalidateIndex(). Iteration order semantics are untouched:
+  // the iterators and forEach() still walk `inner` directly.
+  using Index = kj::HashMap<kj::ArrayPtr<const char>, kj::Vector<kj::ArrayPtr<const char>>>;
+  kj::Maybe<Index> maybeIndex;
+
+  // Returns the index, building it on first use. Returns none for small lists, where a linear
+  // scan is cheaper than building the table; callers then fall back to scanning `inner`.
+  kj::Maybe<Index&> getIndex();
+  void invalidateIndex() { maybeIndex = kj::none; }
+
   // Updates the associated URL (if any) with the serialized contents of this URLSearchParam
   void update();
 
@@ -149,6 +162,7 @@ private:
 class URL: public jsg::Object {
 public:
   URL(kj::StringPtr url, kj::Maybe<kj::StringPtr> base = kj::none);
+  explicit URL(jsg::Url inner): inner(kj::mv(inner)) {}
   ~URL() noexcept(false) override;
 
   static jsg::Ref<URL> constructor(kj::String url, jsg::Optional<kj::String> base);
@@ -206,6 +220,12 @@ public:
   //
   static bool canParse(kj::String url, jsg::Optional<kj::String> base = kj::none);
 
+  // Non-standard extension: parses an array of URL strings (optionally against a shared base)
+  // in one call, returning a URL instance or null per input. Bulk callers (e.g. routers
+  // validating a table of routes) avoid crossing the JS/C++ boundary once per URL.
+  static kj::Array<kj::Maybe<jsg::Ref<URL>>> parseAll(
+      kj::Array<kj::String> urls, jsg::Optional<kj::String> base = kj::none);
+
   JSG_RESOURCE_TYPE(URL) {
     JSG_READONLY_PROTOTYPE_PROPERTY(origin, getOrigin);
     JSG_PROTOTYPE_PROPERTY(href, getHref, setHref);
@@ -223,6 +243,7 @@ public:
     JSG_METHOD_NAMED(toString, getHref);
     JSG_STATIC_METHOD(canParse);
     JSG_STATIC_METHOD(parse);
+    JSG_STATIC_METHOD(parseAll);
 
     JSG_TS_OVERRIDE(URL {
       constructor(url: string | URL, base?: string | URL);
@@ -523,6 +523,10 @@ void URLSearchParams::delete_(kj::String name) {
   url->query.truncate(pivot - url->query.begin());
 }
 
+// TODO(perf): get()/has()/getAll() scan the query list linearly per lookup. The standard
+//   URLSearchParams (url-standard.c++) caches a lazily-built name index; that isn't safe here
+//   because `url->query` is shared with the owning URL object, which rewrites it directly from
+//   its href/search setters with no hook through which to invalidate a cache held here.
 kj::Maybe<kj::String> URLSearchParams::get(kj::String name) {
   for (auto& [k, v]: url->query) {
     if (k == name) {
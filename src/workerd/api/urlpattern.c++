@@ -23,6 +23,64 @@ jsg::JsRef<jsg::JsRegExp> compileRegex(jsg::Lock& js,
   });
 }
 
+// If the generated regex is an anchored literal (e.g. "^https$" for the
+// pattern "https"), returns the unescaped literal string it matches. Returns
+// none for anything containing an unescaped regex metacharacter or a group.
+kj::Maybe<kj::String> tryGetAnchoredLiteral(kj::StringPtr regex) {
+  if (regex.size() < 2 || regex[0] != '^' || regex[regex.size() - 1] != '$') {
+    return kj::none;
+  }
+  auto body = regex.asArray().slice(1, regex.size() - 1);
+  kj::Vector<char> literal(body.size() + 1);
+  for (size_t i = 0; i < body.size(); i++) {
+    char c = body[i];
+    if (c == '\\') {
+      // An escaped ASCII punctuation character matches itself literally.
+      // Anything else escaped (e.g. \d, \w) is a character class.
+      if (++i >= body.size()) return kj::none;
+      char e = body[i];
+      if (!((e >= '!' && e <= '/') || (e >= ':' && e <= '@') ||
+            (e >= '[' && e <= '`') || (e >= '{' && e <= '~'))) {
+        return kj::none;
+      }
+      literal.add(e);
+    } else if (c == '^' || c == '$' || c == '.' || c == '*' || c == '+' ||
+               c == '?' || c == '(' || c == ')' || c == '[' || c == ']' ||
+               c == '{' || c == '}' || c == '|') {
+      return kj::none;
+    } else {
+      literal.add(c);
+    }
+  }
+  literal.add('\0');
+  return kj::String(literal.releaseAsArray());
+}
+
+URLPattern::ComponentMatcher compileComponent(jsg::Lock& js,
+                                              const jsg::UrlPattern::Component& component,
+                                              bool ignoreCase) {
+  using Kind = URLPattern::ComponentMatcher::Kind;
+  // The compiled RegExp is kept even when a native fast path applies so that
+  // compile-time validation behavior (and the fallback) remain unchanged.
+  auto regex = compileRegex(js, component, ignoreCase);
+
+  // A component whose pattern is a lone `*` (including defaulted components)
+  // compiles to exactly "^(.*)$" with a single group; any input matches it.
+  if (component.getRegex() == "^(.*)$"_kj && component.getNames().size() == 1) {
+    return { .kind = Kind::MATCH_ANY, .literal = kj::String(), .regex = kj::mv(regex) };
+  }
+
+  // Case-insensitive literal matching is left to the RegExp so that we don't
+  // have to reproduce V8's unicode case folding.
+  if (!ignoreCase && component.getNames().size() == 0) {
+    KJ_IF_SOME(literal, tryGetAnchoredLiteral(component.getRegex())) {
+      return { .kind = Kind::LITERAL, .literal = kj::mv(literal), .regex = kj::mv(regex) };
+    }
+  }
+
+  return { .kind = Kind::REGEX, .literal = kj::String(), .regex = kj::mv(regex) };
+}
+
 jsg::Ref<URLPattern> create(jsg::Lock& js, jsg::UrlPattern pattern) {
   bool ignoreCase = pattern.getIgnoreCase();
 
@@ -30,8 +88,8 @@ jsg::Ref<URLPattern> create(jsg::Lock& js, jsg::UrlPattern pattern) {
   // is used also to define the constructor for URLPattern so to make
   // sure things line up right we reuse that pattern here also. Because
   // we are moving the pattern into the constructor, we need to make sure
-  // the regex patterns are compiled first so we use the macro twice.
-#define V(Name, var) auto var = compileRegex(js, pattern.get##Name(), ignoreCase);
+  // the matchers are built first so we use the macro twice.
+#define V(Name, var) auto var = compileComponent(js, pattern.get##Name(), ignoreCase);
   URL_PATTERN_COMPONENTS(V)
 #undef V
 
@@ -41,14 +99,40 @@ jsg::Ref<URLPattern> create(jsg::Lock& js, jsg::UrlPattern pattern) {
 #undef V
 }
 
-kj::Maybe<URLPattern::URLPatternComponentResult> execRegex(
+kj::Maybe<URLPattern::URLPatternComponentResult> execComponent(
     jsg::Lock& js,
-    jsg::JsRef<jsg::JsRegExp>& regex,
+    URLPattern::ComponentMatcher& matcher,
     kj::ArrayPtr<const kj::String> nameList,
     kj::StringPtr input) {
   using Groups = jsg::Dict<kj::String, kj::String>;
+  using Kind = URLPattern::ComponentMatcher::Kind;
+
+  switch (matcher.kind) {
+    case Kind::MATCH_ANY: {
+      // A lone `*` wildcard matches any input, capturing all of it in its
+      // single group, so the result can be built without entering V8.
+      auto fields = kj::heapArray<Groups::Field>(1);
+      fields[0] = Groups::Field {
+        .name = kj::str(nameList[0]),
+        .value = kj::str(input),
+      };
+      return URLPattern::URLPatternComponentResult {
+        .input = kj::str(input),
+        .groups = Groups { .fields = kj::mv(fields) },
+      };
+    }
+    case Kind::LITERAL: {
+      if (input != matcher.literal) return kj::none;
+      return URLPattern::URLPatternComponentResult {
+        .input = kj::str(input),
+        .groups = Groups { .fields = nullptr },
+      };
+    }
+    case Kind::REGEX:
+      break;
+  }
 
-  KJ_IF_SOME(array, regex.getHandle(js)(js, input)) {
+  KJ_IF_SOME(array, matcher.regex.getHandle(js)(js, input)) {
     // Starting at 1 here looks a bit odd but it is intentional. The result of the regex
     // is an array and we're skipping the first element.
     uint32_t index = 1;
@@ -76,27 +160,28 @@ kj::Maybe<URLPattern::URLPatternComponentResult> execRegex(
 
 URLPattern::URLPattern(
     jsg::UrlPattern inner,
-    jsg::JsRef<jsg::JsRegExp> protocolRegex,
-    jsg::JsRef<jsg::JsRegExp> usernameRegex,
-    jsg::JsRef<jsg::JsRegExp> passwordRegex,
-    jsg::JsRef<jsg::JsRegExp> hostnameRegex,
-    jsg::JsRef<jsg::JsRegExp> portRegex,
-    jsg::JsRef<jsg::JsRegExp> pathnameRegex,
-    jsg::JsRef<jsg::JsRegExp> searchRegex,
-    jsg::JsRef<jsg::JsRegExp> hashRegex)
+    ComponentMatcher protocolMatcher,
+    ComponentMatcher usernameMatcher,
+    ComponentMatcher passwordMatcher,
+    ComponentMatcher hostnameMatcher,
+    ComponentMatcher portMatcher,
+    ComponentMatcher pathnameMatcher,
+    ComponentMatcher searchMatcher,
+    ComponentMatcher hashMatcher)
     : inner(kj::mv(inner)),
-      protocolRegex(kj::mv(protocolRegex)),
-      usernameRegex(kj::mv(usernameRegex)),
-      passwordRegex(kj::mv(passwordRegex)),
-      hostnameRegex(kj::mv(hostnameRegex)),
-      portRegex(kj::mv(portRegex)),
-      pathnameRegex(kj::mv(pathnameRegex)),
-      searchRegex(kj::mv(searchRegex)),
-      hashRegex(kj::mv(hashRegex)) {}
+      protocolMatcher(kj::mv(protocolMatcher)),
+      usernameMatcher(kj::mv(usernameMatcher)),
+      passwordMatcher(kj::mv(passwordMatcher)),
+      hostnameMatcher(kj::mv(hostnameMatcher)),
+      portMatcher(kj::mv(portMatcher)),
+      pathnameMatcher(kj::mv(pathnameMatcher)),
+      searchMatcher(kj::mv(searchMatcher)),
+      hashMatcher(kj::mv(hashMatcher)) {}
 
 void URLPattern::visitForGc(jsg::GcVisitor& visitor) {
-  visitor.visit(protocolRegex, usernameRegex, passwordRegex, hostnameRegex,
-                portRegex, pathnameRegex, searchRegex, hashRegex);
+  visitor.visit(protocolMatcher.regex, usernameMatcher.regex, passwordMatcher.regex,
+                hostnameMatcher.regex, portMatcher.regex, pathnameMatcher.regex,
+                searchMatcher.regex, hashMatcher.regex);
 }
 
 kj::StringPtr URLPattern::getProtocol() { return inner.getProtocol().getPattern(); }
@@ -249,14 +334,19 @@ kj::Maybe<URLPattern::URLPatternResult> URLPattern::exec(
     }
   }
 
-  auto protocolExecResult = execRegex(js, protocolRegex, inner.getProtocol().getNames(), protocol);
-  auto usernameExecResult = execRegex(js, usernameRegex, inner.getUsername().getNames(), username);
-  auto passwordExecResult = execRegex(js, passwordRegex, inner.getPassword().getNames(), password);
-  auto hostnameExecResult = execRegex(js, hostnameRegex, inner.getHostname().getNames(), hostname);
-  auto portExecResult = execRegex(js, portRegex, inner.getPort().getNames(), port);
-  auto pathnameExecResult = execRegex(js, pathnameRegex, inner.getPathname().getNames(), pathname);
-  auto searchExecResult = execRegex(js, searchRegex, inner.getSearch().getNames(), search);
-  auto hashExecResult = execRegex(js, hashRegex, inner.getHash().getNames(), hash);
+  auto protocolExecResult =
+      execComponent(js, protocolMatcher, inner.getProtocol().getNames(), protocol);
+  auto usernameExecResult =
+      execComponent(js, usernameMatcher, inner.getUsername().getNames(), username);
+  auto passwordExecResult =
+      execComponent(js, passwordMatcher, inner.getPassword().getNames(), password);
+  auto hostnameExecResult =
+      execComponent(js, hostnameMatcher, inner.getHostname().getNames(), hostname);
+  auto portExecResult = execComponent(js, portMatcher, inner.getPort().getNames(), port);
+  auto pathnameExecResult =
+      execComponent(js, pathnameMatcher, inner.getPathname().getNames(), pathname);
+  auto searchExecResult = execComponent(js, searchMatcher, inner.getSearch().getNames(), search);
+  auto hashExecResult = execComponent(js, hashMatcher, inner.getHash().getNames(), hash);
 
   if (protocolExecResult == kj::none ||
       usernameExecResult == kj::none ||
@@ -75,9 +75,28 @@ public:
     JSG_STRUCT(ignoreCase);
   };
 
+  // Describes how a single component will be matched. The kind is decided
+  // once, at construction: components whose generated regex reduces to an
+  // exact literal or to the lone `*` wildcard -- the overwhelmingly common
+  // cases in routing tables -- are matched natively in exec()/test() without
+  // entering V8. Everything else falls back to the compiled RegExp, which is
+  // kept around in all cases.
+  struct ComponentMatcher {
+    enum class Kind {
+      MATCH_ANY,  // The component pattern is a lone `*`; any input matches.
+      LITERAL,    // The component pattern is an exact string with no groups.
+      REGEX,      // Anything else; run the compiled V8 RegExp.
+    };
+    Kind kind;
+    // The exact string the component must equal. Only meaningful when
+    // kind is Kind::LITERAL.
+    kj::String literal;
+    jsg::JsRef<jsg::JsRegExp> regex;
+  };
+
   explicit URLPattern(
       jsg::UrlPattern inner
-#define V(_, name) ,jsg::JsRef<jsg::JsRegExp> name##Regex
+#define V(_, name) ,ComponentMatcher name##Matcher
       URL_PATTERN_COMPONENTS(V)
 #undef V
       );
@@ -116,7 +135,7 @@ public:
 
 private:
   jsg::UrlPattern inner;
-#define V(_, name) jsg::JsRef<jsg::JsRegExp> name##Regex;
+#define V(_, name) ComponentMatcher name##Matcher;
   URL_PATTERN_COMPONENTS(V)
 #undef V
 
@@ -7,16 +7,14 @@
 #include <workerd/io/io-context.h>
 #include <workerd/util/thread-scopes.h>
 #include <workerd/util/mimetype.h>
+#include <workerd/util/strings.h>
 
 namespace workerd::api {
 
 jsg::ByteString toLower(kj::StringPtr str) {
   auto buf = kj::heapArray<char>(str.size() + 1);
-  for (auto i: kj::indices(str)) {
-    char c = str[i];
-    if ('A' <= c && c <= 'Z') c += 'a' - 'A';
-    buf[i] = c;
-  }
+  memcpy(buf.begin(), str.begin(), str.size());
+  toLowerAscii(buf.begin(), str.size());
   buf.back() = '\0';
   return jsg::ByteString(kj::mv(buf));
 }
@@ -41,9 +39,7 @@ kj::ArrayPtr<const char> split(kj::ArrayPtr<const char>& text, char c) {
 }  // namespace
 
 kj::String toLower(kj::String&& str) {
-  for (char& c: str) {
-    if ('A' <= c && c <= 'Z') c += 'a' - 'A';
-  }
+  toLowerAscii(str.begin(), str.size());
   return kj::mv(str);
 }
 
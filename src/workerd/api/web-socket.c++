@@ -250,8 +250,12 @@ jsg::Ref<WebSocket> WebSocket::constructor(
   auto connUrl = urlRecord.toString();
   auto ws = jsg::alloc<WebSocket>(kj::mv(url));
 
-  headers.set(kj::HttpHeaderId::SEC_WEBSOCKET_EXTENSIONS, kj::str("permessage-deflate"));
-  // By default, browsers set the compression extension header for `new WebSocket()`.
+  headers.set(kj::HttpHeaderId::SEC_WEBSOCKET_EXTENSIONS,
+      kj::str("permessage-deflate; client_max_window_bits"));
+  // By default, browsers set the compression extension header for `new WebSocket()`, offering
+  // `client_max_window_bits` so the server may pick a smaller deflate window for the client side.
+  // Some server implementations only negotiate compression at all when that parameter is offered,
+  // so match the browsers' offer exactly.
 
   if (!FeatureFlags::get(js).getWebSocketCompression()) {
     // If we haven't enabled the websocket compression compatibility flag, strip the header from the
@@ -377,6 +381,13 @@ kj::Promise<DeferredProxy<void>> WebSocket::couple(kj::Own<kj::WebSocket> other,
   // away while still being able to successfully pump the websocket connection.
   // 2. This is a hibernatable websocket and we are falling through to deferred proxying to
   // potentially allow for hibernation to occur.
+  //
+  // Note that case 1 is detected automatically: a socket that was obtained from a subrequest and
+  // returned in the Response without being accept()ed has no local peer, so no JS can ever observe
+  // its messages and nothing requires the isolate to stay in memory. We cannot make the same jump
+  // for a socket terminated in the worker just because it has no message handlers registered at
+  // coupling time -- the script keeps a reference to its end of the pair and may add listeners at
+  // any point later, so it falls under the pinning branch above.
 
   // To begin deferred proxying, we can use this magic `KJ_CO_MAGIC` expression, which fulfills
   // our outer promise for a DeferredProxy<void>, which wraps a promise for the rest of this
@@ -537,7 +548,7 @@ void WebSocket::startReadLoop(jsg::Lock& js, kj::Maybe<kj::Own<InputGate::Critic
   })));
 }
 
-void WebSocket::send(jsg::Lock& js, kj::OneOf<kj::Array<byte>, kj::String> message) {
+bool WebSocket::validateCanSend(jsg::Lock& js) {
   auto& native = *farNative;
   JSG_REQUIRE(!native.closedOutgoing, TypeError, "Can't call WebSocket send() after close().");
   if (native.outgoingAborted || native.state.is<Released>()) {
@@ -550,18 +561,26 @@ void WebSocket::send(jsg::Lock& js, kj::OneOf<kj::Array<byte>, kj::String> messa
     // * It makes no sense that *receiving* a close message should prevent further calls to send().
     //   The spec seems broken here. What if you need to send a couple final messages for a clean
     //   shutdown?
-    return;
+    return false;
   } else if (awaitingHibernatableError()) {
     // Ready for the hibernatable error event state, after encountering an error, the websocket
     // isn't able to send outbound messages; let's release it.
     tryReleaseNative(js);
-    return;
+    return false;
   }
 
   JSG_REQUIRE(native.state.is<Accepted>(), TypeError,
       "You must call one of accept() or state.acceptWebSocket() on this WebSocket before sending "\
       "messages.");
 
+  return true;
+}
+
+void WebSocket::send(jsg::Lock& js, kj::OneOf<kj::Array<byte>, kj::String> message) {
+  if (!validateCanSend(js)) {
+    return;
+  }
+
   auto maybeOutputLock = IoContext::current().waitForOutputLocksIfNecessary();
   auto msg = [&]() -> kj::WebSocket::Message {
     KJ_SWITCH_ONEOF(message) {
@@ -586,6 +605,46 @@ void WebSocket::send(jsg::Lock& js, kj::OneOf<kj::Array<byte>, kj::String> messa
   ensurePumping(js);
 }
 
+void WebSocket::sendBatch(
+    jsg::Lock& js, kj::Array<kj::OneOf<kj::Array<byte>, kj::String>> messages) {
+  if (!validateCanSend(js)) {
+    return;
+  }
+  if (messages.size() == 0) {
+    return;
+  }
+
+  // The whole batch is enqueued while we hold the isolate lock, so every message is gated on the
+  // same output lock and the same set of pending auto-responses. Only the first GatedMessage needs
+  // to carry them; the pump loop then drains the rest back-to-back without further waits.
+  auto maybeOutputLock = IoContext::current().waitForOutputLocksIfNecessary();
+  auto pendingAutoResponses = autoResponseStatus.pendingAutoResponseDeque.size() -
+      autoResponseStatus.queuedAutoResponses;
+  autoResponseStatus.queuedAutoResponses = autoResponseStatus.pendingAutoResponseDeque.size();
+
+  for (auto& message: messages) {
+    auto msg = [&]() -> kj::WebSocket::Message {
+      KJ_SWITCH_ONEOF(message) {
+        KJ_CASE_ONEOF(text, kj::String) {
+          return kj::mv(text);
+        }
+        KJ_CASE_ONEOF(data, kj::Array<byte>) {
+          return kj::mv(data);
+        }
+      }
+
+      KJ_UNREACHABLE;
+    }();
+
+    outgoingMessages->insert(
+        GatedMessage{kj::mv(maybeOutputLock), kj::mv(msg), pendingAutoResponses});
+    maybeOutputLock = kj::none;
+    pendingAutoResponses = 0;
+  }
+
+  ensurePumping(js);
+}
+
 void WebSocket::close(
     jsg::Lock& js, jsg::Optional<int> code, jsg::Optional<kj::String> reason) {
   auto& native = *farNative;
@@ -325,6 +325,25 @@ void tryCallDisposeMethod(jsg::Lock& js, jsg::JsValue value) {
 
 } // namespace
 
+jsg::Ref<JsRpcSerialized> JsRpcSerialized::constructor(jsg::Lock& js, jsg::JsValue value) {
+  // Serialize exactly the way a one-argument call does (see serializeJsValue()): the callee
+  // deserializes call params as an array of arguments, so we store the bytes of a
+  // single-element array containing the value. No external handler is supplied, so values
+  // containing stubs, streams, or functions -- which need per-call bookkeeping -- throw here
+  // rather than at send time.
+  jsg::Serializer serializer(js, jsg::Serializer::Options {
+    .version = 15,
+    .omitHeader = false,
+    .treatClassInstancesAsPlainObjects = false,
+  });
+  serializer.write(js, js.arr(kj::arrayPtr(&value, 1)));
+  kj::Array<const byte> data = serializer.release().data;
+  JSG_ASSERT(data.size() <= MAX_JS_RPC_MESSAGE_SIZE, Error,
+      "Serialized RPC arguments or return values are limited to 1MiB, but the size of this value "
+      "was: ", data.size(), " bytes.");
+  return jsg::alloc<JsRpcSerialized>(kj::mv(data));
+}
+
 JsRpcPromise::JsRpcPromise(jsg::JsRef<jsg::JsPromise> inner, kj::Own<WeakRef> weakRefParam,
                            IoOwn<rpc::JsRpcTarget::CallResults::Pipeline> pipeline)
     : inner(kj::mv(inner)), weakRef(kj::mv(weakRefParam)), state(Pending { kj::mv(pipeline) }) {
@@ -475,28 +494,18 @@ JsRpcPromiseAndPipleine callImpl(
         client = lock.then([client = kj::mv(client)]() mutable { return kj::mv(client); });
       }
 
-      auto builder = client.callRequest();
-
-      // This code here is slightly overcomplicated in order to avoid pushing anything to the
-      // kj::Vector in the common case that the parent path is empty. I'm probably trying too hard
-      // but oh well.
-      if (path.empty()) {
-        KJ_IF_SOME(n, name) {
-          builder.setMethodName(n);
-        } else {
-          // No name and no path, must be directly calling a stub.
-          builder.initMethodPath(0);
-        }
-      } else {
-        auto pathBuilder = builder.initMethodPath(path.size() + (name != kj::none));
-        for (auto i: kj::indices(path)) {
-          pathBuilder.set(i, path[i]);
-        }
-        KJ_IF_SOME(n, name) {
-          pathBuilder.set(path.size(), n);
-        }
+      // Size of the non-argument parts of the call params: the params struct itself, a pointer
+      // and text blob per method path segment, and a capability for resultsStreamSink.
+      capnp::MessageSize paramsSizeHint = {capnp::sizeInWords<rpc::JsRpcTarget::CallParams>(), 1};
+      for (auto& p: path) {
+        paramsSizeHint.wordCount += 1 + p.size() / sizeof(capnp::word) + 1;
+      }
+      KJ_IF_SOME(n, name) {
+        paramsSizeHint.wordCount += 1 + n.size() / sizeof(capnp::word) + 1;
       }
 
+      kj::Maybe<capnp::Request<rpc::JsRpcTarget::CallParams, rpc::JsRpcTarget::CallResults>>
+          maybeBuilder;
       kj::Maybe<StreamSinkFulfiller> paramsStreamSinkFulfiller;
 
       KJ_IF_SOME(args, maybeArgs) {
@@ -506,13 +515,36 @@ JsRpcPromiseAndPipleine callImpl(
           argv.add(jsg::JsValue(args[n]));
         }
 
+        // Fan-out fast path: a lone JsRpcSerialized argument already carries the bytes of a
+        // one-argument call (see its constructor), so fill in the call params directly and
+        // skip V8 serialization for this call entirely.
+        kj::Maybe<jsg::Ref<JsRpcSerialized>> preSerialized;
+        if (argv.size() == 1) {
+          KJ_IF_SOME(obj, argv[0].tryCast<jsg::JsObject>()) {
+            preSerialized = obj.tryUnwrapAs<JsRpcSerialized>(js);
+          }
+        }
+
         // If we have arguments, serialize them.
         // Note that we may fail to serialize some element, in which case this will throw back to
         // JS.
-        if (argv.size() > 0) {
+        KJ_IF_SOME(p, preSerialized) {
+          auto data = p->getData();
+          capnp::MessageSize hint = paramsSizeHint;
+          hint.wordCount += (data.size() + sizeof(capnp::word) - 1) / sizeof(capnp::word)
+              + capnp::sizeInWords<rpc::JsValue>();
+          maybeBuilder.emplace(client.callRequest(hint))
+              .getOperation().initCallWithArgs().setV8Serialized(data);
+        } else {
           serializeJsValue(js, js.arr(argv.asPtr()), [&](capnp::MessageSize hint) {
-            // TODO(perf): Actually use the size hint.
-            return builder.getOperation().initCallWithArgs();
+            // We serialize the arguments before allocating the request so that the size hint --
+            // which accounts for the serialized bytes as well as the rest of the call params --
+            // can be used to allocate the message's first segment at the right size up front,
+            // instead of growing it through reallocation on every call.
+            hint.wordCount += paramsSizeHint.wordCount;
+            hint.capCount += paramsSizeHint.capCount;
+            return maybeBuilder.emplace(client.callRequest(hint))
+                .getOperation().initCallWithArgs();
           }, [&]() -> rpc::JsValue::StreamSink::Client {
             // A stream was encountered in the params, so we must expect the response to contain
             // paramsStreamSink. But we don't have the response yet. So, we need to set up a
@@ -522,7 +554,38 @@ JsRpcPromiseAndPipleine callImpl(
             return kj::mv(paf.promise);
           });
         }
+      }
+
+      auto& builder = ([&]() -> auto& {
+        KJ_IF_SOME(b, maybeBuilder) {
+          return b;
+        }
+        // No arguments were serialized (a property access or zero-argument call), so the request
+        // wasn't allocated above.
+        return maybeBuilder.emplace(client.callRequest(paramsSizeHint));
+      })();
+
+      // This code here is slightly overcomplicated in order to avoid pushing anything to the
+      // kj::Vector in the common case that the parent path is empty. I'm probably trying too hard
+      // but oh well.
+      if (path.empty()) {
+        KJ_IF_SOME(n, name) {
+          builder.setMethodName(n);
+        } else {
+          // No name and no path, must be directly calling a stub.
+          builder.initMethodPath(0);
+        }
       } else {
+        auto pathBuilder = builder.initMethodPath(path.size() + (name != kj::none));
+        for (auto i: kj::indices(path)) {
+          pathBuilder.set(i, path[i]);
+        }
+        KJ_IF_SOME(n, name) {
+          pathBuilder.set(path.size(), n);
+        }
+      }
+
+      if (maybeArgs == kj::none) {
         // This is a property access.
         builder.getOperation().setGetProperty();
       }
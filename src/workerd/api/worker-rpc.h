@@ -126,6 +126,35 @@ public:
   JSG_ONEWAY_SERIALIZABLE(rpc::SerializationTag::JS_RPC_STUB);
 };
 
+// Pre-serialized RPC arguments, for fanning the same payload out to many stubs.
+//
+// Constructing one runs V8 serialization once. When an instance is then passed as the sole
+// argument of an RPC call, the send path copies the stored bytes into the call params instead
+// of serializing again, so a loop delivering one payload to N service bindings pays for one
+// serialization rather than N. The callee observes the original value as its single argument
+// and cannot tell the difference from a plain call.
+//
+// The wrapped value may not contain stubs, streams, functions, or other RPC-special types:
+// those need per-call bookkeeping, so trying to pre-serialize them throws.
+class JsRpcSerialized final: public jsg::Object {
+public:
+  JsRpcSerialized(kj::Array<const kj::byte> data): data(kj::mv(data)) {}
+
+  static jsg::Ref<JsRpcSerialized> constructor(jsg::Lock& js, jsg::JsValue value);
+
+  // The stored bytes, which are exactly what serializing a one-argument call would produce.
+  kj::ArrayPtr<const kj::byte> getData() const { return data; }
+
+  JSG_RESOURCE_TYPE(JsRpcSerialized) {}
+
+  void visitForMemoryInfo(jsg::MemoryTracker& tracker) const {
+    tracker.trackFieldWithSize("data", data.size());
+  }
+
+private:
+  kj::Array<const kj::byte> data;
+};
+
 // Common superclass of JsRpcStub and Fetcher, the two types that may serve as the basis for
 // RPC calls.
 //
@@ -492,6 +521,7 @@ public:
     JSG_NESTED_TYPE_NAMED(JsRpcProperty, RpcProperty);
     JSG_NESTED_TYPE_NAMED(JsRpcStub, RpcStub);
     JSG_NESTED_TYPE_NAMED(JsRpcTarget, RpcTarget);
+    JSG_NESTED_TYPE_NAMED(JsRpcSerialized, RpcSerialized);
   }
 };
 
@@ -500,6 +530,7 @@ public:
   api::JsRpcProperty,                \
   api::JsRpcStub,                    \
   api::JsRpcTarget,                  \
+  api::JsRpcSerialized,              \
   api::WorkerEntrypoint,             \
   api::DurableObjectBase,            \
   api::EntrypointsModule
@@ -0,0 +1,386 @@
+// Copyright (c) 2017-2022 Cloudflare, Inc.
+// Licensed under the Apache 2.0 license found in the LICENSE file or at:
+//     https://opensource.org/licenses/Apache-2.0
+
+#include "actor-cache.h"
+#include "io-gate.h"
+#include <workerd/tests/bench-tools.h>
+#include <kj/async-io.h>
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+// Benchmark and stress target for ActorCache. Unlike actor-cache-test.c++, which scripts every
+// storage interaction through MockServer, the backend here is a synthetic storage server that
+// answers every RPC automatically from an in-memory map after a simulated round trip, so
+// workloads can run thousands of operations and report aggregate cache behavior. The benchmark
+// argument is the simulated storage RTT in microseconds (with uniform jitter of +/- RTT/8), and
+// each workload reports the statistic it is meant to tune:
+//
+//   read-heavy:  LRU hit rate under a hot-set access pattern (tunes SharedLru soft limit).
+//   write-burst: average flush batch size (tunes dirty list limit and flush pipelining).
+//   list-scan:   cached-scan rate for sliding range reads.
+//
+// Run via `bazel run //src/workerd/io:actor-cache-bench`.
+
+namespace workerd {
+namespace {
+
+// In-memory storage contents plus the latency model, shared between the stage capability and
+// any transactions it vends.
+struct SyntheticDb: public kj::Refcounted {
+  SyntheticDb(kj::Timer& timer, kj::Duration rtt): timer(timer), rtt(rtt) {}
+
+  struct KeyOrder {
+    bool operator()(const kj::String& a, const kj::String& b) const {
+      return a.asPtr() < b.asPtr();
+    }
+  };
+
+  kj::Timer& timer;
+  kj::Duration rtt;
+  uint64_t rngState = 0x9e3779b97f4a7c15ull;
+  std::map<kj::String, kj::Array<kj::byte>, KeyOrder> data;
+
+  uint64_t nextRand() {
+    // xorshift64*; plenty for jitter.
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return rngState * 0x2545f4914f6cdd1dull;
+  }
+
+  // One simulated storage round trip: the nominal RTT plus uniform jitter of +/- RTT/8.
+  kj::Promise<void> delay() {
+    if (rtt == 0 * kj::SECONDS) return kj::READY_NOW;
+    int64_t windowUs = (rtt / 4) / kj::MICROSECONDS;
+    auto jittered = rtt - rtt / 8;
+    if (windowUs > 0) {
+      jittered += int64_t(nextRand() % uint64_t(windowUs)) * kj::MICROSECONDS;
+    }
+    return timer.afterDelay(jittered);
+  }
+
+  void put(capnp::List<rpc::ActorStorage::KeyValue>::Reader entries) {
+    for (auto entry: entries) {
+      data.insert_or_assign(
+          kj::str(entry.getKey().asChars()), kj::heapArray(entry.getValue().asBytes()));
+    }
+  }
+
+  uint delete_(capnp::List<capnp::Data>::Reader keys) {
+    uint count = 0;
+    for (auto key: keys) {
+      count += data.erase(kj::str(key.asChars()));
+    }
+    return count;
+  }
+};
+
+struct FoundEntry {
+  kj::StringPtr key;
+  kj::ArrayPtr<const kj::byte> value;
+};
+
+// Deliver entries over a ListStream the way a real storage backend would: one values() batch
+// followed by end().
+kj::Promise<void> sendValues(
+    rpc::ActorStorage::ListStream::Client stream, kj::Array<FoundEntry> entries) {
+  auto req = stream.valuesRequest();
+  auto list = req.initList(entries.size());
+  for (auto i: kj::indices(entries)) {
+    list[i].setKey(entries[i].key.asBytes());
+    list[i].setValue(entries[i].value);
+  }
+  co_await req.send();
+  co_await stream.endRequest(capnp::MessageSize {4, 0}).send();
+}
+
+// A transaction over the synthetic database. Writes are applied directly to the shared map;
+// the bench never rolls back, so staging them would only add bookkeeping without changing any
+// measured behavior.
+class SyntheticTransaction final: public rpc::ActorStorage::Stage::Transaction::Server {
+public:
+  explicit SyntheticTransaction(kj::Own<SyntheticDb> db): db(kj::mv(db)) {}
+
+  kj::Promise<void> put(PutContext context) override {
+    co_await db->delay();
+    db->put(context.getParams().getEntries());
+  }
+
+  kj::Promise<void> delete_(DeleteContext context) override {
+    co_await db->delay();
+    context.getResults().setNumDeleted(db->delete_(context.getParams().getKeys()));
+  }
+
+  kj::Promise<void> commit(CommitContext context) override {
+    return db->delay();
+  }
+
+  kj::Promise<void> rollback(RollbackContext context) override {
+    return kj::READY_NOW;
+  }
+
+private:
+  kj::Own<SyntheticDb> db;
+};
+
+// Storage stage that answers ActorCache's RPCs from the shared map after a simulated round
+// trip. Only the methods the cache actually issues are implemented.
+class SyntheticStorage final: public rpc::ActorStorage::Stage::Server {
+public:
+  explicit SyntheticStorage(kj::Own<SyntheticDb> db): db(kj::mv(db)) {}
+
+  kj::Promise<void> get(GetContext context) override {
+    co_await db->delay();
+    auto iter = db->data.find(kj::str(context.getParams().getKey().asChars()));
+    if (iter != db->data.end()) {
+      context.getResults().setValue(iter->second);
+    }
+  }
+
+  kj::Promise<void> getMultiple(GetMultipleContext context) override {
+    co_await db->delay();
+    auto params = context.getParams();
+    kj::Vector<FoundEntry> found;
+    for (auto key: params.getKeys()) {
+      auto iter = db->data.find(kj::str(key.asChars()));
+      if (iter != db->data.end()) {
+        found.add(FoundEntry {iter->first, iter->second});
+      }
+    }
+    // The cache expects results streamed in ascending key order.
+    auto entries = found.releaseAsArray();
+    std::sort(entries.begin(), entries.end(),
+        [](const FoundEntry& a, const FoundEntry& b) { return a.key < b.key; });
+    co_await sendValues(params.getStream(), kj::mv(entries));
+  }
+
+  kj::Promise<void> list(ListContext context) override {
+    co_await db->delay();
+    auto params = context.getParams();
+    auto start = kj::str(params.getStart().asChars());
+    kj::Maybe<kj::String> end;
+    if (params.hasEnd()) {
+      end = kj::str(params.getEnd().asChars());
+    }
+    int32_t limit = params.getLimit();
+
+    kj::Vector<FoundEntry> found;
+    for (auto iter = db->data.lower_bound(start); iter != db->data.end(); ++iter) {
+      KJ_IF_SOME(e, end) {
+        if (!(iter->first.asPtr() < e.asPtr())) break;
+      }
+      found.add(FoundEntry {iter->first, iter->second});
+    }
+    auto entries = found.releaseAsArray();
+    if (params.getReverse()) {
+      std::reverse(entries.begin(), entries.end());
+    }
+    if (limit > 0 && size_t(limit) < entries.size()) {
+      entries = kj::heapArray(entries.first(limit));
+    }
+    co_await sendValues(params.getStream(), kj::mv(entries));
+  }
+
+  kj::Promise<void> put(PutContext context) override {
+    co_await db->delay();
+    db->put(context.getParams().getEntries());
+  }
+
+  kj::Promise<void> delete_(DeleteContext context) override {
+    co_await db->delay();
+    context.getResults().setNumDeleted(db->delete_(context.getParams().getKeys()));
+  }
+
+  kj::Promise<void> txn(TxnContext context) override {
+    context.getResults().setTransaction(kj::heap<SyntheticTransaction>(kj::addRef(*db)));
+    return kj::READY_NOW;
+  }
+
+private:
+  kj::Own<SyntheticDb> db;
+};
+
+// Hooks that count flushes so workloads can report batching efficiency.
+struct BenchHooks final: public ActorCache::Hooks {
+  size_t flushCount = 0;
+  size_t entriesFlushed = 0;
+
+  void flushedBatch(size_t entryCount) override {
+    ++flushCount;
+    entriesFlushed += entryCount;
+  }
+};
+
+// Fixed-width keys so that numeric order matches lexicographic order for list scans.
+kj::String benchKey(uint i) {
+  return kj::str("key-", 10000000 + i);
+}
+
+kj::Array<kj::byte> benchValue(size_t size) {
+  auto value = kj::heapArray<kj::byte>(size);
+  memset(value.begin(), 'x', size);
+  return value;
+}
+
+// Everything one workload needs: an event loop with a real timer for the latency model, the
+// synthetic backend, and an ActorCache in front of it.
+struct BenchEnv {
+  BenchEnv(benchmark::State& state, ActorCache::SharedLru::Options lruOptions,
+           uint initialKeys = 0, size_t valueSize = 1024)
+      : io(kj::setupAsyncIo()),
+        db(kj::refcounted<SyntheticDb>(
+            io.provider->getTimer(), state.range(0) * kj::MICROSECONDS)),
+        lru(lruOptions),
+        cache(rpc::ActorStorage::Stage::Client(kj::heap<SyntheticStorage>(kj::addRef(*db))),
+              lru, gate, hooks),
+        gateBroken(gate.onBroken().eagerlyEvaluate([](kj::Exception&& e) {
+          KJ_LOG(ERROR, "output gate broken during benchmark", e);
+        })) {
+    for (uint i = 0; i < initialKeys; i++) {
+      db->data.insert_or_assign(benchKey(i), benchValue(valueSize));
+    }
+  }
+
+  kj::WaitScope& waitScope() { return io.waitScope; }
+
+  kj::AsyncIoContext io;
+  kj::Own<SyntheticDb> db;
+  ActorCache::SharedLru lru;
+  OutputGate gate;
+  BenchHooks hooks;
+  ActorCache cache;
+  kj::Promise<void> gateBroken;
+};
+
+constexpr ActorCache::SharedLru::Options BENCH_LRU_OPTIONS = {
+  .softLimit = 1024 * 1024,
+  .hardLimit = 16 * 1024 * 1024,
+  .staleTimeout = 1 * kj::SECONDS,
+  .dirtyListByteLimit = 64 * 1024,
+  .maxKeysPerRpc = 128,
+};
+
+// 90% of gets hit a small hot set, the rest spray across a working set several times larger
+// than the LRU soft limit, so the hit rate directly reflects how well the LRU retains the hot
+// set under eviction pressure.
+void readHeavy(benchmark::State& state) {
+  constexpr uint TOTAL_KEYS = 4096;
+  constexpr uint HOT_KEYS = 256;
+  constexpr uint GETS_PER_BATCH = 64;
+
+  BenchEnv env(state, BENCH_LRU_OPTIONS, TOTAL_KEYS);
+  size_t hits = 0;
+  size_t total = 0;
+
+  for (auto _: state) {
+    kj::Vector<kj::Promise<void>> uncached;
+    for (uint i = 0; i < GETS_PER_BATCH; i++) {
+      uint key = env.db->nextRand() % 10 < 9
+          ? env.db->nextRand() % HOT_KEYS
+          : env.db->nextRand() % TOTAL_KEYS;
+      KJ_SWITCH_ONEOF(env.cache.get(benchKey(key), {})) {
+        KJ_CASE_ONEOF(value, kj::Maybe<ActorCache::Value>) {
+          benchmark::DoNotOptimize(value);
+          ++hits;
+        }
+        KJ_CASE_ONEOF(promise, kj::Promise<kj::Maybe<ActorCache::Value>>) {
+          uncached.add(promise.ignoreResult());
+        }
+      }
+      ++total;
+    }
+    for (auto& promise: uncached) {
+      promise.wait(env.waitScope());
+    }
+  }
+
+  state.SetItemsProcessed(total);
+  state.counters["hitRate"] = double(hits) / double(total);
+}
+WD_BENCHMARK(readHeavy)->Name("actor-cache/read-heavy")->ArgName("rttUs")
+    ->Arg(0)->Arg(500)->Arg(2000);
+
+// Bursts of puts followed by a wait for flush quiescence. Longer RTTs let more writes coalesce
+// behind the in-flight flush, so avgFlushBatch shows how well batching amortizes the round
+// trips.
+void writeBurst(benchmark::State& state) {
+  constexpr uint KEY_SPACE = 1024;
+  constexpr uint PUTS_PER_BURST = 64;
+
+  BenchEnv env(state, BENCH_LRU_OPTIONS);
+  uint keyCounter = 0;
+  size_t total = 0;
+  size_t bursts = 0;
+  uint64_t epochsBefore = env.gate.currentEpoch();
+
+  for (auto _: state) {
+    ++bursts;
+    kj::Vector<kj::Promise<void>> backpressure;
+    for (uint i = 0; i < PUTS_PER_BURST; i++) {
+      KJ_IF_SOME(promise,
+          env.cache.put(benchKey(keyCounter++ % KEY_SPACE), benchValue(128), {})) {
+        backpressure.add(kj::mv(promise));
+      }
+      ++total;
+    }
+    for (auto& promise: backpressure) {
+      promise.wait(env.waitScope());
+    }
+    KJ_IF_SOME(promise, env.cache.onNoPendingFlush()) {
+      promise.wait(env.waitScope());
+    }
+  }
+
+  state.SetItemsProcessed(total);
+  if (env.hooks.flushCount > 0) {
+    state.counters["avgFlushBatch"] =
+        double(env.hooks.entriesFlushed) / double(env.hooks.flushCount);
+    state.counters["flushes"] = double(env.hooks.flushCount);
+  }
+  if (bursts > 0) {
+    // Ideally 1.0: all writes of a burst confirmed under a single output gate cycle.
+    state.counters["gateEpochsPerBurst"] =
+        double(env.gate.currentEpoch() - epochsBefore) / double(bursts);
+  }
+}
+WD_BENCHMARK(writeBurst)->Name("actor-cache/write-burst")->ArgName("rttUs")
+    ->Arg(0)->Arg(500)->Arg(2000);
+
+// A window slides through the key space in 128-key list() calls. With the working set well over
+// the soft limit, cachedScans shows how often a scan could be answered without a storage round
+// trip.
+void listScan(benchmark::State& state) {
+  constexpr uint TOTAL_KEYS = 4096;
+  constexpr uint WINDOW = 128;
+
+  BenchEnv env(state, BENCH_LRU_OPTIONS, TOTAL_KEYS);
+  uint pos = 0;
+  size_t keysListed = 0;
+  size_t cachedScans = 0;
+  size_t totalScans = 0;
+
+  for (auto _: state) {
+    auto result = env.cache.list(benchKey(pos), benchKey(pos + WINDOW), WINDOW, {});
+    pos = (pos + WINDOW) % TOTAL_KEYS;
+    ++totalScans;
+    KJ_SWITCH_ONEOF(result) {
+      KJ_CASE_ONEOF(list, ActorCache::GetResultList) {
+        keysListed += list.size();
+        ++cachedScans;
+      }
+      KJ_CASE_ONEOF(promise, kj::Promise<ActorCache::GetResultList>) {
+        keysListed += promise.wait(env.waitScope()).size();
+      }
+    }
+  }
+
+  state.SetItemsProcessed(keysListed);
+  state.counters["cachedScans"] = double(cachedScans) / double(totalScans);
+}
+WD_BENCHMARK(listScan)->Name("actor-cache/list-scan")->ArgName("rttUs")
+    ->Arg(0)->Arg(500)->Arg(2000);
+
+} // namespace
+} // namespace workerd
@@ -198,6 +198,8 @@ struct ActorCacheTestOptions {
   size_t maxKeysPerRpc = 128;
   bool noCache = false;
   bool neverFlush = false;
+  size_t flushPipelineDepth = 1;
+  bool enableAbsentKeyFilter = false;
 };
 
 struct ActorCacheTest: public ActorCacheConvenienceWrappers {
@@ -222,8 +224,9 @@ struct ActorCacheTest: public ActorCacheConvenienceWrappers {
         ws(loop), mockStorage(kj::mv(mockPair.mock)),
         lru({options.softLimit, options.hardLimit,
              options.staleTimeout, options.dirtyListByteLimit, options.maxKeysPerRpc,
-             options.noCache, options.neverFlush}),
-        cache(kj::mv(mockPair.client), lru, gate),
+             options.noCache, options.neverFlush, options.flushPipelineDepth}),
+        cache(kj::mv(mockPair.client), lru, gate, ActorCache::Hooks::DEFAULT, kj::none,
+              options.enableAbsentKeyFilter),
         gateBrokenPromise(options.monitorOutputGate
             ? eagerlyReportExceptions(gate.onBroken())
             : kj::Promise<void>(kj::READY_NOW)) {}
@@ -1867,6 +1870,76 @@ KJ_TEST("ActorCache list() multiple ranges") {
   (void)expectUncached(test.get("c"));
 }
 
+KJ_TEST("ActorCache list() trims range where the tail is already cached") {
+  ActorCacheTest test;
+  auto& ws = test.ws;
+  auto& mockStorage = test.mockStorage;
+
+  // Populate the cache with the tail of the range we'll list later.
+  {
+    auto promise = expectUncached(test.list("c", "f"));
+
+    mockStorage->expectCall("list", ws)
+        .withParams(CAPNP(start = "c", end = "f"), "stream"_kj)
+        .useCallback("stream", [&](MockClient stream) {
+      stream.call("values", CAPNP(list = [(key = "c", value = "3"),
+                                          (key = "d", value = "4")]))
+          .expectReturns(CAPNP(), ws);
+      stream.call("end", CAPNP()).expectReturns(CAPNP(), ws);
+    }).expectCanceled();
+
+    KJ_ASSERT(promise.wait(ws) == kvs({{"c", "3"}, {"d", "4"}}));
+  }
+
+  // A list over a wider range only reads the part before the cached tail from storage.
+  {
+    auto promise = expectUncached(test.list("a", "f"));
+
+    mockStorage->expectCall("list", ws)
+        .withParams(CAPNP(start = "a", end = "c"), "stream"_kj)
+        .useCallback("stream", [&](MockClient stream) {
+      stream.call("values", CAPNP(list = [(key = "a", value = "1"),
+                                          (key = "b", value = "2")]))
+          .expectReturns(CAPNP(), ws);
+      stream.call("end", CAPNP()).expectReturns(CAPNP(), ws);
+    }).expectCanceled();
+
+    KJ_ASSERT(promise.wait(ws) ==
+        kvs({{"a", "1"}, {"b", "2"}, {"c", "3"}, {"d", "4"}}));
+  }
+
+  // And now the whole wider range is known.
+  KJ_ASSERT(expectCached(test.list("a", "f")) ==
+      kvs({{"a", "1"}, {"b", "2"}, {"c", "3"}, {"d", "4"}}));
+}
+
+KJ_TEST("ActorCache list() coalesces with overlapping in-flight list()") {
+  ActorCacheTest test;
+  auto& ws = test.ws;
+  auto& mockStorage = test.mockStorage;
+
+  auto promise1 = expectUncached(test.list("bar", "qux"));
+
+  // Further lists over ranges covered by the in-flight one coalesce onto it rather than issuing
+  // their own storage reads. (The mock would fail the test on an unexpected second list call.)
+  auto promise2 = expectUncached(test.list("bar", "qux"));
+  auto promise3 = expectUncached(test.list("baz", "foo"));
+
+  mockStorage->expectCall("list", ws)
+      .withParams(CAPNP(start = "bar", end = "qux"), "stream"_kj)
+      .useCallback("stream", [&](MockClient stream) {
+    stream.call("values", CAPNP(list = [(key = "bar", value = "456"),
+                                        (key = "baz", value = "789"),
+                                        (key = "foo", value = "123")]))
+        .expectReturns(CAPNP(), ws);
+    stream.call("end", CAPNP()).expectReturns(CAPNP(), ws);
+  }).expectCanceled();
+
+  KJ_ASSERT(promise1.wait(ws) == kvs({{"bar", "456"}, {"baz", "789"}, {"foo", "123"}}));
+  KJ_ASSERT(promise2.wait(ws) == kvs({{"bar", "456"}, {"baz", "789"}, {"foo", "123"}}));
+  KJ_ASSERT(promise3.wait(ws) == kvs({{"baz", "789"}}));
+}
+
 KJ_TEST("ActorCache list() with some already-cached keys in range") {
   ActorCacheTest test;
   auto& ws = test.ws;
@@ -2252,17 +2325,13 @@ KJ_TEST("ActorCache list() ending in known-empty gap") {
     KJ_ASSERT(promise.wait(ws) == kvs({}));
   }
 
-  // Now list from "bar" to "foo", which ends in the gap.
+  // Now list from "bar" to "foo", which ends in the gap. Since the tail of the range -- from
+  // "corge" on -- is already known, the storage list is trimmed to end at "corge".
   {
     auto promise = expectUncached(test.list("bar", "foo"));
 
-    // Note that the implementation of `list()` only looks for a prefix that it can skip, not a
-    // suffix. Hence, the underlying list() call will go all the way to "foo", even though the
-    // range from "qux" to "foo" is entirely in cache and hence in theory could be skipped. This
-    // optimization is missing  because the code is complex enough already and it doesn't seem like
-    // it would be a win that often.
     mockStorage->expectCall("list", ws)
-        .withParams(CAPNP(start = "bar", end = "foo"), "stream"_kj)
+        .withParams(CAPNP(start = "bar", end = "corge"), "stream"_kj)
         .useCallback("stream", [&](MockClient stream) {
       stream.call("values", CAPNP(list = [(key = "baz", value = "123")]))
           .expectReturns(CAPNP(), ws);
@@ -2869,6 +2938,30 @@ KJ_TEST("ActorCache listReverse() multiple ranges") {
   (void)expectUncached(test.get("c"));
 }
 
+KJ_TEST("ActorCache listReverse() coalesces with in-flight list()") {
+  ActorCacheTest test;
+  auto& ws = test.ws;
+  auto& mockStorage = test.mockStorage;
+
+  // A reverse list over a range covered by an in-flight forward list coalesces onto it -- once
+  // the results are in cache, direction no longer matters.
+  auto promise1 = expectUncached(test.list("bar", "qux"));
+  auto promise2 = expectUncached(test.listReverse("bar", "qux"));
+
+  mockStorage->expectCall("list", ws)
+      .withParams(CAPNP(start = "bar", end = "qux"), "stream"_kj)
+      .useCallback("stream", [&](MockClient stream) {
+    stream.call("values", CAPNP(list = [(key = "bar", value = "456"),
+                                        (key = "baz", value = "789"),
+                                        (key = "foo", value = "123")]))
+        .expectReturns(CAPNP(), ws);
+    stream.call("end", CAPNP()).expectReturns(CAPNP(), ws);
+  }).expectCanceled();
+
+  KJ_ASSERT(promise1.wait(ws) == kvs({{"bar", "456"}, {"baz", "789"}, {"foo", "123"}}));
+  KJ_ASSERT(promise2.wait(ws) == kvs({{"foo", "123"}, {"baz", "789"}, {"bar", "456"}}));
+}
+
 KJ_TEST("ActorCache listReverse() with some already-cached keys in range") {
   ActorCacheTest test;
   auto& ws = test.ws;
@@ -5394,5 +5487,258 @@ KJ_TEST("ActorCache can shutdown") {
   });
 }
 
+KJ_TEST("ActorCache pipelined flushes overlap independent writes") {
+  ActorCacheTest test({.flushPipelineDepth = 2});
+  auto& ws = test.ws;
+  auto& mockStorage = test.mockStorage;
+
+  test.put("foo", "123");
+  auto firstFlush = mockStorage->expectCall("put", ws)
+      .withParams(CAPNP(entries = [(key = "foo", value = "123")]));
+
+  // A write to a different key may flush while the first flush is still awaiting confirmation.
+  // Note that the pipelined flush re-sends the still-in-flight (identical) "foo" write, since
+  // every flush transaction covers all dirty entries.
+  test.put("bar", "456");
+  auto secondFlush = mockStorage->expectCall("put", ws)
+      .withParams(CAPNP(entries = [(key = "foo", value = "123"),
+                                   (key = "bar", value = "456")]));
+
+  kj::mv(firstFlush).thenReturn(CAPNP());
+  kj::mv(secondFlush).thenReturn(CAPNP());
+
+  KJ_ASSERT(KJ_ASSERT_NONNULL(expectCached(test.get("foo"))) == "123");
+  KJ_ASSERT(KJ_ASSERT_NONNULL(expectCached(test.get("bar"))) == "456");
+}
+
+KJ_TEST("ActorCache pipelined flushes serialize rewrites of an in-flight key") {
+  ActorCacheTest test({.flushPipelineDepth = 2});
+  auto& ws = test.ws;
+  auto& mockStorage = test.mockStorage;
+
+  test.put("foo", "123");
+  auto firstFlush = mockStorage->expectCall("put", ws)
+      .withParams(CAPNP(entries = [(key = "foo", value = "123")]));
+
+  // Overwriting a key whose previous value is still in flight must stay ordered behind it, so
+  // no second RPC may start until the first settles.
+  test.put("foo", "456");
+  mockStorage->expectNoActivity(ws);
+
+  kj::mv(firstFlush).thenReturn(CAPNP());
+
+  mockStorage->expectCall("put", ws)
+      .withParams(CAPNP(entries = [(key = "foo", value = "456")]))
+      .thenReturn(CAPNP());
+
+  KJ_ASSERT(KJ_ASSERT_NONNULL(expectCached(test.get("foo"))) == "456");
+}
+
+KJ_TEST("ActorCache pipelined flushes keep re-sent keys registered in flight") {
+  ActorCacheTest test({.flushPipelineDepth = 2});
+  auto& ws = test.ws;
+  auto& mockStorage = test.mockStorage;
+
+  test.put("foo", "123");
+  auto firstFlush = mockStorage->expectCall("put", ws)
+      .withParams(CAPNP(entries = [(key = "foo", value = "123")]));
+
+  // The pipelined second flush re-transmits the in-flight "foo" write alongside "bar".
+  test.put("bar", "456");
+  auto secondFlush = mockStorage->expectCall("put", ws)
+      .withParams(CAPNP(entries = [(key = "foo", value = "123"),
+                                   (key = "bar", value = "456")]));
+
+  // The first flush settles, but "foo" is still in flight as part of the second flush, which
+  // must hold its own registration for the key. A rewrite of "foo" therefore stays ordered
+  // behind the second flush -- if it overlapped, storage could commit foo=123 after foo=789,
+  // durably losing the later write.
+  kj::mv(firstFlush).thenReturn(CAPNP());
+  test.put("foo", "789");
+  mockStorage->expectNoActivity(ws);
+
+  kj::mv(secondFlush).thenReturn(CAPNP());
+
+  mockStorage->expectCall("put", ws)
+      .withParams(CAPNP(entries = [(key = "foo", value = "789")]))
+      .thenReturn(CAPNP());
+
+  KJ_ASSERT(KJ_ASSERT_NONNULL(expectCached(test.get("foo"))) == "789");
+  KJ_ASSERT(KJ_ASSERT_NONNULL(expectCached(test.get("bar"))) == "456");
+}
+
+KJ_TEST("ActorCache pipelined flush conflicts wait for all in-flight flushes") {
+  ActorCacheTest test({.flushPipelineDepth = 3});
+  auto& ws = test.ws;
+  auto& mockStorage = test.mockStorage;
+
+  test.put("foo", "123");
+  auto firstFlush = mockStorage->expectCall("put", ws)
+      .withParams(CAPNP(entries = [(key = "foo", value = "123")]));
+
+  test.put("bar", "456");
+  auto secondFlush = mockStorage->expectCall("put", ws)
+      .withParams(CAPNP(entries = [(key = "foo", value = "123"),
+                                   (key = "bar", value = "456")]));
+
+  // Settle the *second* flush first; the first is still in flight and still covers "foo". A
+  // conflicting rewrite of "foo" must wait for every outstanding flush, not just the most
+  // recently scheduled one.
+  kj::mv(secondFlush).thenReturn(CAPNP());
+  test.put("foo", "789");
+  mockStorage->expectNoActivity(ws);
+
+  kj::mv(firstFlush).thenReturn(CAPNP());
+
+  mockStorage->expectCall("put", ws)
+      .withParams(CAPNP(entries = [(key = "foo", value = "789")]))
+      .thenReturn(CAPNP());
+
+  KJ_ASSERT(KJ_ASSERT_NONNULL(expectCached(test.get("foo"))) == "789");
+}
+
+KJ_TEST("ActorCache SharedReadTier basics") {
+  auto tier = kj::atomicRefcounted<ActorCache::SharedReadTier>(1024);
+
+  KJ_EXPECT(tier->find("foo") == kj::none);
+
+  tier->insert("foo", "123"_kj.asBytes());
+  KJ_EXPECT(KJ_ASSERT_NONNULL(tier->find("foo")) == "123"_kj.asBytes());
+  KJ_EXPECT(tier->currentSize() > 0);
+
+  // Re-inserting an existing key keeps the existing entry.
+  tier->insert("foo", "456"_kj.asBytes());
+  KJ_EXPECT(KJ_ASSERT_NONNULL(tier->find("foo")) == "123"_kj.asBytes());
+
+  // Writes drop the key.
+  tier->invalidate("foo");
+  KJ_EXPECT(tier->find("foo") == kj::none);
+
+  tier->insert("bar", "abc"_kj.asBytes());
+  tier->insert("baz", "def"_kj.asBytes());
+  tier->invalidateAll();
+  KJ_EXPECT(tier->find("bar") == kj::none);
+  KJ_EXPECT(tier->find("baz") == kj::none);
+  KJ_EXPECT(tier->currentSize() == 0);
+}
+
+KJ_TEST("ActorCache SharedReadTier evicts least-recently-used entries when over limit") {
+  auto value = kj::heapArray<kj::byte>(8);
+
+  // Measure the accounted size of one entry so we can pick a limit that holds exactly two.
+  size_t entrySize;
+  {
+    auto probe = kj::atomicRefcounted<ActorCache::SharedReadTier>(kj::maxValue);
+    probe->insert("aaa", value);
+    entrySize = probe->currentSize();
+  }
+
+  auto tier = kj::atomicRefcounted<ActorCache::SharedReadTier>(2 * entrySize);
+  tier->insert("aaa", value);
+  tier->insert("bbb", value);
+
+  // Touch "aaa" so that "bbb" is the eviction candidate.
+  KJ_EXPECT(tier->find("aaa") != kj::none);
+
+  tier->insert("ccc", value);
+  KJ_EXPECT(tier->find("bbb") == kj::none);
+  KJ_EXPECT(tier->find("aaa") != kj::none);
+  KJ_EXPECT(tier->find("ccc") != kj::none);
+}
+
+KJ_TEST("ActorCache AbsentKeyFilter answers misses after a full-range list()") {
+  ActorCacheTest test({.enableAbsentKeyFilter = true});
+  auto& ws = test.ws;
+  auto& mockStorage = test.mockStorage;
+
+  // Until the cache has had complete knowledge of the key space at some point, the filter can't
+  // rule anything out, so a miss still reads storage.
+  {
+    auto promise = expectUncached(test.get("qux", {.noCache = true}));
+
+    mockStorage->expectCall("get", ws)
+        .withParams(CAPNP(key = "qux"))
+        .thenReturn(CAPNP());
+
+    KJ_ASSERT(promise.wait(ws) == nullptr);
+  }
+
+  // An unbounded list() over the whole key space enumerates every key in storage, making the
+  // filter authoritative. We use noCache so that nothing is left in the entry cache -- any
+  // cached answer later in this test must come from the filter itself, not an entry or a
+  // known-empty gap marker.
+  {
+    auto promise = expectUncached(test.list("", nullptr, kj::none, {.noCache = true}));
+
+    mockStorage->expectCall("list", ws)
+        .withParams(CAPNP(), "stream"_kj)
+        .useCallback("stream", [&](MockClient stream) {
+      stream.call("values", CAPNP(list = [(key = "foo", value = "123")]))
+          .expectReturns(CAPNP(), ws);
+      stream.call("end", CAPNP()).expectReturns(CAPNP(), ws);
+    }).expectCanceled();
+
+    KJ_ASSERT(promise.wait(ws) == kvs({{"foo", "123"}}));
+  }
+
+  // A key that has never existed is now a definite miss, answered without any storage RPC.
+  KJ_ASSERT(expectCached(test.get("corge")) == nullptr);
+
+  // But a key the filter has seen still goes to storage -- the filter only proves absences.
+  {
+    auto promise = expectUncached(test.get("foo"));
+
+    mockStorage->expectCall("get", ws)
+        .withParams(CAPNP(key = "foo"))
+        .thenReturn(CAPNP(value = "123"));
+
+    KJ_ASSERT(KJ_ASSERT_NONNULL(promise.wait(ws)) == "123");
+  }
+}
+
+KJ_TEST("ActorCache AbsentKeyFilter becomes authoritative after deleteAll()") {
+  ActorCacheTest test({.enableAbsentKeyFilter = true});
+  auto& ws = test.ws;
+  auto& mockStorage = test.mockStorage;
+
+  auto timePoint = kj::UNIX_EPOCH;
+  KJ_ASSERT(test.cache.evictStale(timePoint) == nullptr);
+
+  // deleteAll() leaves storage logically empty, so the filter gains complete knowledge; writes
+  // after it re-populate the filter.
+  auto deleteAll = test.cache.deleteAll({});
+  test.put("foo", "123");
+
+  mockStorage->expectCall("deleteAll", ws)
+      .thenReturn(CAPNP(numDeleted = 2));
+  KJ_ASSERT(deleteAll.count.wait(ws) == 2);
+
+  mockStorage->expectCall("put", ws)
+      .withParams(CAPNP(entries = [(key = "foo", value = "123")]))
+      .thenReturn(CAPNP());
+  test.gate.wait().wait(ws);
+
+  // Evict everything, so that neither entries nor known-empty gap markers can answer reads.
+  timePoint += 1 * kj::SECONDS;
+  KJ_ASSERT(test.cache.evictStale(timePoint) == nullptr);
+  timePoint += 1 * kj::SECONDS;
+  KJ_ASSERT(test.cache.evictStale(timePoint) == nullptr);
+  KJ_EXPECT(test.lru.currentSize() == 0);
+
+  // A key never written since the deleteAll() is a definite miss with no storage read.
+  KJ_ASSERT(expectCached(test.get("bar")) == nullptr);
+
+  // The written key fell out of cache, so it reads storage as usual.
+  {
+    auto promise = expectUncached(test.get("foo"));
+
+    mockStorage->expectCall("get", ws)
+        .withParams(CAPNP(key = "foo"))
+        .thenReturn(CAPNP(value = "123"));
+
+    KJ_ASSERT(KJ_ASSERT_NONNULL(promise.wait(ws)) == "123");
+  }
+}
+
 }  // namespace
 }  // namespace workerd
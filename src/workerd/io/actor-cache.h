@@ -255,18 +255,131 @@ public:
     virtual void updateAlarmInMemory(kj::Maybe<kj::Date> newAlarmTime) {};
 
     // Used to track metrics of read and write operation latencies from the isolate's perspective.
-    virtual void storageReadCompleted(kj::Duration latency) {}
-    virtual void storageWriteCompleted(kj::Duration latency) {}
+    // The base implementations record the latencies into always-on process-wide histograms (see
+    // util/hot-metrics.h); overrides that want to keep those histograms populated should call
+    // through to the base class.
+    virtual void storageReadCompleted(kj::Duration latency);
+    virtual void storageWriteCompleted(kj::Duration latency);
+
+    // Called once per flush with the total number of dirty entries (puts and deletes) written by
+    // that flush. The base implementation records the size into an always-on histogram.
+    virtual void flushedBatch(size_t entryCount);
 
     static Hooks DEFAULT;
   };
 
+  // An optional process-wide tier of read-only values shared by multiple ActorCache instances.
+  //
+  // When a cache misses on a get(), it consults the tier before issuing a storage RPC, and
+  // populates the tier with whatever the RPC returns. Any write through any cache sharing the
+  // tier invalidates the written key, and deleteAll() invalidates the whole tier.
+  //
+  // IMPORTANT: A tier must only be shared among caches that observe the same underlying data
+  // for the same keys -- e.g. replicas of one actor, or a namespace whose keys are
+  // content-addressed/immutable by convention. The tier can't know which actor wrote a key, so
+  // sharing it across actors with independent key spaces would serve wrong values.
+  class SharedReadTier final: public kj::AtomicRefcounted {
+  public:
+    explicit SharedReadTier(size_t softLimit);
+    ~SharedReadTier() noexcept(false);
+    KJ_DISALLOW_COPY_AND_MOVE(SharedReadTier);
+
+    // Look up a key, returning a copy of the value and refreshing its LRU position.
+    kj::Maybe<Value> find(KeyPtr key) const;
+
+    // Record a value read from storage. Evicts least-recently-used entries if over the limit.
+    void insert(KeyPtr key, ValuePtr value) const;
+
+    // Drop a key from the tier. Called for every write made through a cache sharing the tier.
+    void invalidate(KeyPtr key) const;
+
+    // Drop everything, e.g. on deleteAll().
+    void invalidateAll() const;
+
+    // Mostly for testing.
+    size_t currentSize() const { return size.load(std::memory_order_relaxed); }
+
+  private:
+    struct TierEntry {
+      TierEntry(Key key, Value value): key(kj::mv(key)), value(kj::mv(value)) {}
+      KJ_DISALLOW_COPY_AND_MOVE(TierEntry);
+
+      const Key key;
+      const Value value;
+
+      // Entries live in `lru`, least-recently-used first.
+      kj::ListLink<TierEntry> link;
+
+      size_t size() const { return sizeof(*this) + key.size() + value.size(); }
+    };
+
+    struct State {
+      kj::HashMap<KeyPtr, kj::Own<TierEntry>> map;
+      kj::List<TierEntry, &TierEntry::link> lru;
+    };
+
+    // Memory usage the tier will try to stay under by evicting least-recently-used entries.
+    const size_t softLimit;
+
+    mutable std::atomic<size_t> size = 0;
+
+    kj::MutexGuarded<State> state;
+
+    // Unlink and erase the given entry. `entry` must be in the map.
+    void eraseEntry(State& state, TierEntry& entry) const;
+  };
+
+  // An optional compact filter recording (a superset of) the keys that may exist in storage,
+  // letting reads answer definite misses without a storage RPC -- even for keys the cache has
+  // never seen, and even after the corresponding negative entries or known-empty gap markers
+  // have been evicted. This is aimed at workloads that mostly probe for keys that don't exist,
+  // e.g. deduplication actors checking message IDs.
+  //
+  // The filter starts out non-authoritative: it can't rule anything out because storage may
+  // contain keys it has never heard of. It becomes authoritative once the cache has had
+  // complete knowledge of the key space at some moment -- after a deleteAll(), or when an
+  // unbounded full-range list() completes. Every key written and every key seen in a read
+  // result is inserted from construction onward, so from that moment on, a key that misses the
+  // filter definitely isn't in storage. Deleted keys are never removed, and the bit table is
+  // fixed-size, so the filter only ever over-approximates; false positives just fall back to a
+  // normal storage read.
+  class AbsentKeyFilter {
+  public:
+    AbsentKeyFilter();
+
+    void insert(KeyPtr key);
+    bool mightContain(KeyPtr key) const;
+
+    // The key space is known to be completely empty (deleteAll()). Forget everything and start
+    // answering definite misses.
+    void resetAsAuthoritative();
+
+    // Every key currently in storage has been insert()ed (an unbounded full-range list()
+    // finished streaming). Start answering definite misses.
+    void markAuthoritative() { authoritative = true; }
+
+    bool isAuthoritative() const { return authoritative; }
+
+  private:
+    // A fixed 64 KiB table (512K bits). With four probes per key, false positives stay around
+    // 1% up to roughly 50k keys, degrading gracefully (toward "always fall back to storage")
+    // beyond that. Workloads this filter targets mostly query keys that are absent, so the
+    // table fills slowly.
+    static constexpr size_t TABLE_WORDS = 8192;
+    static constexpr uint NUM_HASHES = 4;
+
+    bool authoritative = false;
+    kj::Array<uint64_t> words;
+  };
+
   static constexpr auto SHUTDOWN_ERROR_MESSAGE =
       "broken.ignored; jsg.Error: "
       "Durable Object storage is no longer accessible."_kj;
 
   ActorCache(rpc::ActorStorage::Stage::Client storage, const SharedLru& lru, OutputGate& gate,
-      Hooks& hooks = Hooks::DEFAULT);
+      Hooks& hooks = Hooks::DEFAULT,
+      kj::Maybe<kj::Own<const SharedReadTier>> sharedReadTier = kj::none,
+      bool enableAbsentKeyFilter = false);
   ~ActorCache() noexcept(false);
 
   kj::Maybe<SqliteDatabase&> getSqliteDatabase() override { return kj::none; }
@@ -454,6 +567,12 @@ private:
     bool isStale = false;
     bool flushStarted = false;
 
+    // Epoch (see ActorCache::flushEpochCounter) of the most recent flush transaction that
+    // included this entry. Only meaningful while `flushStarted` is true. Used by pipelined
+    // flushes so that an earlier flush completing out of order doesn't mark entries clean
+    // that a later flush re-sent and still has in flight.
+    uint64_t flushEpoch = 0;
+
     // If true, then a past list() operation covered the space between this entry and the following
     // entry, meaning that we know for sure that there are no other keys on disk between them.
     bool gapIsKnownEmpty = false;
@@ -574,6 +693,13 @@ private:
   const SharedLru& lru;
   OutputGate& gate;
   Hooks& hooks;
+
+  // If present, a cross-actor read-only tier consulted on read misses; see SharedReadTier.
+  kj::Maybe<kj::Own<const SharedReadTier>> sharedReadTier;
+
+  // If present, consulted on read misses to answer definite absences without a storage RPC;
+  // see AbsentKeyFilter.
+  kj::Maybe<AbsentKeyFilter> absentKeyFilter;
   const kj::MonotonicClock& clock;
 
   // Wrapper around kj::List that keeps track of the total size of all elements.
@@ -656,6 +782,32 @@ private:
   // The count of the number of flushes that have been queued without yet resolving.
   size_t flushesEnqueued = 0;
 
+  // Monotonic counter identifying each flushImpl() invocation (including retries). Entries are
+  // stamped with the epoch of the most recent flush that included them; see Entry::flushEpoch.
+  uint64_t flushEpochCounter = 0;
+
+  // Epoch that startFlushTransaction() stamps onto entries; set by flushImpl() before building
+  // the transaction.
+  uint64_t currentFlushEpoch = 0;
+
+  // Keys with a write currently in flight, with a count of in-flight flushes covering each.
+  // Only maintained when `flushPipelineDepth > 1`, to decide whether a new flush may start
+  // before earlier ones settle without reordering writes to the same key.
+  kj::HashMap<Key, uint> keysInFlight;
+
+  // Keys registered by the startFlushTransaction() call currently in progress. flushImpl()
+  // moves these into the flush's completion handler, which releases them from `keysInFlight`
+  // when the flush settles.
+  kj::Vector<Key> currentFlushRegisteredKeys;
+
+  // Called when a flush is about to start while earlier flushes are still in flight, to decide
+  // whether it may safely overlap them. See SharedLru::Options::flushPipelineDepth.
+  bool canPipelineFlush();
+
+  // Record that `entry`'s key is about to have a write in flight. No-op unless pipelining is
+  // enabled.
+  void registerInFlightFlushKey(Entry& entry);
+
   struct DeleteAllState {
     // If deleteAll() was called since the last flush, these are all the dirty entries that existed
     // in the cache immediately before the deleteAll(). Since deleteAll() cannot be part of a
@@ -668,8 +820,10 @@ private:
 
   kj::Maybe<DeleteAllState> requestedDeleteAll;
 
-  // Promise for the completion of the previous flush. We can only execute one flushImpl() at a time
-  // because we can't allow out-of-order writes.
+  // Promise for the completion of all scheduled or in-flight flushes: each newly scheduled flush
+  // is joined into this rather than replacing it, since with `flushPipelineDepth > 1` several
+  // flushes can be outstanding at once and a flush that can't safely overlap them must wait for
+  // every one of them, not just the most recent.
   kj::ForkedPromise<void> lastFlush = kj::Promise<void>(kj::READY_NOW).fork();
   // TODO(perf): If we could rely on e-order on the ActorStorage API, we could pipeline additional
   //   writes and not have to worry about this. However, at present, ActorStorage has automatic
@@ -727,6 +881,44 @@ private:
   // Mark all gaps empty between the begin and end key.
   void markGapsEmpty(Lock& lock, KeyPtr begin, kj::Maybe<KeyPtr> end, const ReadOptions& options);
 
+  // A storage list operation that is currently streaming results into the cache, covering the
+  // key range [begin, end). Tracked so that overlapping list() calls can coalesce onto it
+  // instead of issuing duplicate storage reads for the same range; see
+  // findCoalescableListRange().
+  struct InFlightListRange {
+    // Identifies the stream that registered this range, for unregisterInFlightListRange().
+    const void* owner;
+
+    Key begin;
+
+    // kj::none means the end of the key space.
+    kj::Maybe<Key> end;
+
+    // Fulfilled when the operation completes (successfully or not), at which point its results
+    // -- including `gapIsKnownEmpty` markings -- are in `currentValues`.
+    kj::Own<kj::PromiseFulfiller<void>> fulfiller;
+    kj::ForkedPromise<void> done;
+  };
+
+  // List operations currently streaming from storage. Almost always empty or tiny, so a simple
+  // vector suffices. Only operations whose results actually stay in cache (i.e. not `noCache`)
+  // are registered, since only those are useful to anyone else.
+  kj::Vector<InFlightListRange> inFlightListRanges;
+
+  // If some in-flight list operation's range covers [begin, end), return a promise that resolves
+  // when it completes. The caller should then retry against the cache rather than issuing its
+  // own storage read. Note that the in-flight operation may have had a limit and stopped early,
+  // in which case the retry will issue a (smaller) storage read after all -- this only delays
+  // such callers slightly, it never produces wrong results, since the retry recomputes
+  // everything from cache state.
+  kj::Maybe<kj::Promise<void>> findCoalescableListRange(KeyPtr begin, kj::Maybe<KeyPtr> end);
+
+  void registerInFlightListRange(const void* owner, KeyPtr begin, kj::Maybe<KeyPtr> end);
+
+  // Remove the range registered by `owner`, waking any coalesced waiters. No-op if `owner` never
+  // registered (or already unregistered).
+  void unregisterInFlightListRange(const void* owner);
+
   // Implements put() or delete(). Multi-key variants call this for each key.
   void putImpl(Lock& lock, kj::Own<Entry> newEntry,
                const WriteOptions& options,  kj::Maybe<CountedDelete&> counted);
@@ -812,47 +1004,74 @@ private:
 class ActorCacheOps::GetResultList {
   using Entry = ActorCache::Entry;
 public:
+  // In both storage modes, iteration yields KeyValuePtrPair views that borrow the underlying
+  // storage -- either a refcounted cache Entry or an owned KeyValuePair -- so consumers never
+  // take a copy of the value; the views remain valid as long as the GetResultList is alive.
   class Iterator {
   public:
     KeyValuePtrPairWithCache operator*() {
-      KJ_IREQUIRE(ptr->get()->getValueStatus() == ActorCache::EntryValueStatus::PRESENT);
-      return { ptr->get()->key, ptr->get()->getValuePtr().orDefault({}), *statusPtr };
+      if (pairPtr != nullptr) {
+        return { pairPtr->key, pairPtr->value, CacheStatus::UNCACHED };
+      }
+      KJ_IREQUIRE(entryPtr->get()->getValueStatus() == ActorCache::EntryValueStatus::PRESENT);
+      return { entryPtr->get()->key, entryPtr->get()->getValuePtr().orDefault({}), *statusPtr };
     }
     Iterator& operator++() {
-      ++ptr;
-      ++statusPtr;
+      if (pairPtr != nullptr) {
+        ++pairPtr;
+      } else {
+        ++entryPtr;
+        ++statusPtr;
+      }
       return *this;
     }
     Iterator operator++(int) {
       auto copy = *this;
-      ++ptr;
-      ++statusPtr;
+      ++*this;
       return copy;
     }
     bool operator==(const Iterator& other) const {
-      return ptr == other.ptr && statusPtr == other.statusPtr;
+      return entryPtr == other.entryPtr && statusPtr == other.statusPtr &&
+             pairPtr == other.pairPtr;
     }
 
   private:
-    const kj::Own<Entry>* ptr;
-    const CacheStatus* statusPtr;
-
-    explicit Iterator(const kj::Own<Entry>* ptr, const CacheStatus* statusPtr)
-        : ptr(ptr), statusPtr(statusPtr) {}
+    // Exactly one of `entryPtr` (with `statusPtr`) or `pairPtr` is in use, depending on which
+    // storage mode the GetResultList was constructed in.
+    const kj::Own<Entry>* entryPtr = nullptr;
+    const CacheStatus* statusPtr = nullptr;
+    const KeyValuePair* pairPtr = nullptr;
+
+    explicit Iterator(const kj::Own<Entry>* entryPtr, const CacheStatus* statusPtr)
+        : entryPtr(entryPtr), statusPtr(statusPtr) {}
+    explicit Iterator(const KeyValuePair* pairPtr): pairPtr(pairPtr) {}
     friend class GetResultList;
   };
 
-  Iterator begin() const { return Iterator(entries.begin(), cacheStatuses.begin()); }
-  Iterator end() const { return Iterator(entries.end(), cacheStatuses.end()); }
-  size_t size() const { return entries.size(); }
+  Iterator begin() const {
+    if (usesOwnedPairs) return Iterator(ownedPairs.begin());
+    return Iterator(entries.begin(), cacheStatuses.begin());
+  }
+  Iterator end() const {
+    if (usesOwnedPairs) return Iterator(ownedPairs.end());
+    return Iterator(entries.end(), cacheStatuses.end());
+  }
+  size_t size() const { return usesOwnedPairs ? ownedPairs.size() : entries.size(); }
 
-  // Construct a simple GetResultList from key-value pairs.
+  // Construct a simple GetResultList from key-value pairs. The pairs are stored (and iterated
+  // over) as-is; unlike the Entry-based constructor no per-pair allocation takes place. Such
+  // results always report CacheStatus::UNCACHED.
   explicit GetResultList(kj::Vector<KeyValuePair> contents);
 
 private:
   kj::Vector<kj::Own<Entry>> entries;
   kj::Vector<CacheStatus> cacheStatuses;
 
+  // Alternate storage for results that don't originate from cache entries (e.g. SQLite-backed
+  // storage); see the pair constructor above.
+  kj::Vector<KeyValuePair> ownedPairs;
+  bool usesOwnedPairs = false;
+
   enum Order {
     FORWARD,
     REVERSE
@@ -905,6 +1124,15 @@ struct ActorCacheSharedLruOptions {
   // If true, don't actually flush anything. This is used in preview sessions, since they keep
   // state strictly in memory.
   bool neverFlush = false;
+
+  // Maximum number of flush transactions to keep in flight concurrently. With the default of 1,
+  // a new flush always waits for the previous one to settle before starting. Values greater
+  // than 1 enable pipelined flushes: a newly scheduled flush may start while earlier flushes
+  // are still awaiting confirmation, as long as it is provably independent of them -- no key
+  // it writes may have a different value still in flight, and counted deletes, alarm writes,
+  // and deleteAll() always fall back to the serialized behavior. Write-heavy actors that touch
+  // disjoint keys per request gain storage throughput without weakening ordering guarantees.
+  size_t flushPipelineDepth = 1;
 };
 
 class ActorCache::SharedLru {
@@ -11,12 +11,36 @@ namespace workerd {
 
 ActorSqlite::ActorSqlite(kj::Own<SqliteDatabase> dbParam, OutputGate& outputGate,
                          kj::Function<kj::Promise<void>()> commitCallback,
-                         Hooks& hooks)
+                         Hooks& hooks, kj::Maybe<kj::Own<CommitBatcher>> commitBatcher)
     : db(kj::mv(dbParam)), outputGate(outputGate), commitCallback(kj::mv(commitCallback)),
-      hooks(hooks), kv(*db), commitTasks(*this) {
+      hooks(hooks), commitBatcher(kj::mv(commitBatcher)), kv(*db), commitTasks(*this) {
   db->onWrite(KJ_BIND_METHOD(*this, onWrite));
 }
 
+kj::Promise<void> ActorSqlite::CommitBatcher::nextBatch() {
+  KJ_IF_SOME(c, current) {
+    return c.addBranch();
+  }
+
+  // No batch is accumulating, so start one. The evalLater() gives every write made during the
+  // current event-loop turn -- by this actor or any other sharing the batcher -- a chance to
+  // join before the tick fires. Once it does, each joined commit's continuation wakes in the
+  // order it joined, and the tick clears itself so that commits scheduled afterward form a new
+  // batch.
+  //
+  // Capturing `this` is safe: the tick only evaluates while some joined commit awaits its
+  // branch, and every such commit belongs to an actor holding a ref on this batcher. (An owned
+  // ref here would create a cycle and leak.)
+  auto fork = kj::evalLater([this]() {
+    current = kj::none;
+  }).fork();
+
+  // Take our own branch before publishing the fork so that this first commit wakes first.
+  auto branch = fork.addBranch();
+  current = kj::mv(fork);
+  return branch;
+}
+
 ActorSqlite::ImplicitTxn::ImplicitTxn(ActorSqlite& parent)
     : parent(parent) {
   KJ_REQUIRE(parent.currentTxn.is<NoTxn>());
@@ -135,7 +159,18 @@ void ActorSqlite::onWrite() {
   if (currentTxn.is<NoTxn>()) {
     auto txn = kj::heap<ImplicitTxn>(*this);
 
-    commitTasks.add(outputGate.lockWhile(kj::evalLater(
+    // With a batcher, wait for the shared batch tick instead of a private evalLater(): the
+    // timing is the same, but all co-located actors' COMMITs then run back-to-back. (The
+    // synchronous COMMITs execute consecutively when the tick fires; only the commitCallback()
+    // promises overlap afterward.)
+    auto turn = [&]() -> kj::Promise<void> {
+      KJ_IF_SOME(b, commitBatcher) {
+        return b->nextBatch();
+      }
+      return kj::evalLater([]() {});
+    }();
+
+    commitTasks.add(outputGate.lockWhile(turn.then(
         [this, txn = kj::mv(txn)]() mutable -> kj::Promise<void> {
       // Don't commit if shutdown() has been called.
       requireNotBroken();
@@ -177,6 +212,19 @@ void ActorSqlite::requireNotBroken() {
   }
 }
 
+void ActorSqlite::runIdleMaintenance() {
+  if (broken != kj::none) return;
+
+  // If a commit is still in flight, skip this round entirely rather than ANALYZE-ing inside
+  // someone else's transaction; the next idle period will pick it up.
+  if (!currentTxn.is<NoTxn>()) return;
+
+  // Cap the number of rows ANALYZE will examine per index so a single maintenance pass can't
+  // stall the event loop on a huge table; repeated idle passes converge on full statistics.
+  db->run("PRAGMA analysis_limit = 1000");
+  db->run("PRAGMA optimize");
+}
+
 // =======================================================================================
 // ActorCacheInterface implementation
 
@@ -196,12 +244,13 @@ kj::OneOf<ActorCacheOps::GetResultList, kj::Promise<ActorCacheOps::GetResultList
     ActorSqlite::get(kj::Array<Key> keys, ReadOptions options) {
   requireNotBroken();
 
-  kj::Vector<KeyValuePair> results;
-  for (auto& key: keys) {
-    kv.get(key, [&](ValuePtr value) {
-      results.add(KeyValuePair { kj::mv(key), kj::heapArray(value) });
-    });
-  }
+  kj::Vector<KeyValuePair> results(keys.size());
+  auto keyPtrs = KJ_MAP(k, keys) -> SqliteKv::KeyPtr { return k; };
+  kv.get(keyPtrs, [&](KeyPtr key, ValuePtr value) {
+    results.add(KeyValuePair { kj::str(key), kj::heapArray(value) });
+  });
+
+  // The batched lookup only guarantees sorted results within each batch, so sort the whole set.
   std::sort(results.begin(), results.end(),
       [](auto& a, auto& b) { return a.key < b.key; });
   return GetResultList(kj::mv(results));
@@ -252,9 +301,10 @@ kj::Maybe<kj::Promise<void>> ActorSqlite::put(
     kj::Array<KeyValuePair> pairs, WriteOptions options) {
   requireNotBroken();
 
-  for (auto& pair: pairs) {
-    kv.put(pair.key, pair.value);
-  }
+  auto entries = KJ_MAP(pair, pairs) -> SqliteKv::Pair {
+    return { pair.key, pair.value };
+  };
+  kv.put(entries);
   return kj::none;
 }
 
@@ -268,11 +318,8 @@ kj::OneOf<uint, kj::Promise<uint>> ActorSqlite::delete_(
     kj::Array<Key> keys, WriteOptions options) {
   requireNotBroken();
 
-  uint count = 0;
-  for (auto& key: keys) {
-    count += kv.delete_(key);
-  }
-  return count;
+  auto keyPtrs = KJ_MAP(k, keys) -> SqliteKv::KeyPtr { return k; };
+  return kv.delete_(keyPtrs);
 }
 
 kj::Maybe<kj::Promise<void>> ActorSqlite::setAlarm(
@@ -358,6 +405,12 @@ kj::Maybe<kj::Promise<void>> ActorSqlite::onNoPendingFlush() {
 
 ActorSqlite::Hooks ActorSqlite::Hooks::DEFAULT = ActorSqlite::Hooks{};
 
+// TODO(perf): When alarms are implemented for SQLite-backed actors, alarm-state updates (the
+//   alarm time write on setAlarm() and the deferred deletion when an alarm run completes) must
+//   join the invocation's data transaction rather than committing separately, so that one alarm
+//   run costs one WAL commit (and one fsync) instead of two. The deferred-deletion semantics of
+//   armAlarmHandler()/cancelDeferredAlarmDeletion() -- delete on successful completion, retained
+//   on failure or cancellation -- need to hold for the fused commit as well.
 kj::Maybe<kj::Own<void>> ActorSqlite::Hooks::armAlarmHandler(kj::Date scheduledTime, bool noCache) {
   JSG_FAIL_REQUIRE(Error, "alarms are not yet implemented for SQLite-backed Durable Objects");
 }
@@ -30,6 +30,32 @@ public:
     static Hooks DEFAULT;
   };
 
+  // Groups the implicit-transaction commits of co-located ActorSqlite instances.
+  //
+  // Each actor normally commits its implicit transaction in its own event-loop task, scattered
+  // among whatever else the loop is running, so N actors writing within the same window pay N
+  // WAL syncs issued independently. Actors sharing a batcher instead rendezvous on a common
+  // batch tick: every commit that becomes pending before the tick fires runs when it does, in
+  // the order the commits were scheduled, with nothing in between. The synchronous COMMITs
+  // therefore execute back-to-back -- letting the storage device merge the underlying flushes
+  // -- while the (asynchronous) commit callbacks overlap afterward. Scheduling order doubles
+  // as dependency order: a commit scheduled after another's never runs before it.
+  //
+  // A batcher may only be shared among actors running on the same event loop; it is not
+  // thread-safe. Typically one batcher is shared per `SqliteDatabase::Vfs`, since that is the
+  // set of databases whose syncs land on the same device.
+  class CommitBatcher final: public kj::Refcounted {
+  public:
+    // Returns a promise that resolves when the next batch tick fires. The tick fires once the
+    // current event-loop turn's writes have all had a chance to join, mirroring the timing a
+    // lone actor's commit would have had anyway -- batching adds no commit latency.
+    kj::Promise<void> nextBatch();
+
+  private:
+    // The tick that commits are currently accumulating behind, if any.
+    kj::Maybe<kj::ForkedPromise<void>> current;
+  };
+
   // Constructs ActorSqlite, arranging to honor the output gate, that is, any writes to the
   // database which occur without any `await`s in between will automatically be combined into a
   // single atomic write. This is accomplished using transactions. In addition to ensuring
@@ -39,12 +65,26 @@ public:
   // `commitCallback` will be invoked after committing a transaction. The output gate will block on
   // the returned promise. This can be used e.g. when the database needs to be replicated to other
   // machines before being considered durable.
+  //
+  // If `commitBatcher` is provided, implicit-transaction commits are scheduled through it so
+  // that co-located actors commit together; see CommitBatcher.
   explicit ActorSqlite(kj::Own<SqliteDatabase> dbParam, OutputGate& outputGate,
                        kj::Function<kj::Promise<void>()> commitCallback,
-                       Hooks& hooks = Hooks::DEFAULT);
+                       Hooks& hooks = Hooks::DEFAULT,
+                       kj::Maybe<kj::Own<CommitBatcher>> commitBatcher = kj::none);
 
   bool isCommitScheduled() { return !currentTxn.is<NoTxn>(); }
 
+  // Runs a bounded slice of SQLite maintenance (`PRAGMA optimize`), refreshing the query
+  // planner's statistics for any table whose content has changed significantly since they were
+  // last gathered. Without this, plans in a long-lived database degrade as the data drifts away
+  // from whatever ANALYZE last saw. The analysis limit keeps each call to a bounded amount of
+  // work, so it is safe to call often; calls are no-ops when there is nothing worth refreshing.
+  //
+  // Must not be called while a commit is scheduled or a transaction is open; callers should
+  // invoke this only when the actor is idle.
+  void runIdleMaintenance();
+
   kj::Maybe<SqliteDatabase&> getSqliteDatabase() override { return *db; }
 
   kj::OneOf<kj::Maybe<Value>, kj::Promise<kj::Maybe<Value>>> get(
@@ -78,6 +118,9 @@ private:
   OutputGate& outputGate;
   kj::Function<kj::Promise<void>()> commitCallback;
   Hooks& hooks;
+
+  // If present, implicit-transaction commits rendezvous here with other co-located actors.
+  kj::Maybe<kj::Own<CommitBatcher>> commitBatcher;
   SqliteKv kv;
 
   SqliteDatabase::Statement beginTxn = db->prepare("BEGIN TRANSACTION");
@@ -292,6 +292,13 @@ KJ_TEST("compatibility flag parsing") {
       " globalFetchStrictlyPublic = false,"
       " newModuleRegistry = false)", {},
       CompatibilityDateValidation::FUTURE_FOR_TEST, false, false);
+
+  // Results are memoized process-wide; a repeated configuration must replay its errors, not just
+  // its flag values. (Several configurations above are already compiled twice implicitly.)
+  expectCompileCompatibilityFlags("2021-05-17", {"no_such_flag_for_cache_test"_kj}, "()",
+      {"No such compatibility flag: no_such_flag_for_cache_test"});
+  expectCompileCompatibilityFlags("2021-05-17", {"no_such_flag_for_cache_test"_kj}, "()",
+      {"No such compatibility flag: no_such_flag_for_cache_test"});
 }
 
 KJ_TEST("encode to flag list for FL") {
@@ -9,6 +9,7 @@
 #include <capnp/dynamic.h>
 #include <kj/debug.h>
 #include <kj/map.h>
+#include <kj/mutex.h>
 #include <kj/vector.h>
 
 namespace workerd {
@@ -92,7 +93,10 @@ kj::String currentDateStr() {
   return CompatDate::today().toString();
 }
 
-void compileCompatibilityFlags(kj::StringPtr compatDate, capnp::List<capnp::Text>::Reader compatFlags,
+namespace {
+
+void compileCompatibilityFlagsUncached(
+                         kj::StringPtr compatDate, capnp::List<capnp::Text>::Reader compatFlags,
                          CompatibilityFlags::Builder output,
                          Worker::ValidationErrorReporter& errorReporter,
                          bool allowExperimentalFeatures,
@@ -241,6 +245,90 @@ void compileCompatibilityFlags(kj::StringPtr compatDate, capnp::List<capnp::Text
   }
 }
 
+// Cached result of one flag compilation: the resolved value of every (boolean) field, in schema
+// field order, plus any validation errors the compilation produced. Errors must be replayed on
+// every hit -- a worker with a bad config should see the same errors whether or not another
+// worker with the same config was compiled first.
+struct CompiledFlagsCacheEntry {
+  kj::Array<bool> fieldValues;
+  kj::Array<kj::String> errors;
+};
+
+// Collects errors so they can be both forwarded and cached. compileCompatibilityFlagsUncached()
+// only ever reports errors, never handlers.
+class CachingErrorReporter final: public Worker::ValidationErrorReporter {
+public:
+  explicit CachingErrorReporter(Worker::ValidationErrorReporter& inner): inner(inner) {}
+
+  void addError(kj::String error) override {
+    errors.add(kj::str(error));
+    inner.addError(kj::mv(error));
+  }
+  void addHandler(kj::Maybe<kj::StringPtr> exportName, kj::StringPtr type) override {
+    KJ_UNREACHABLE;
+  }
+
+  kj::Array<kj::String> releaseErrors() { return errors.releaseAsArray(); }
+
+private:
+  Worker::ValidationErrorReporter& inner;
+  kj::Vector<kj::String> errors;
+};
+
+}  // namespace
+
+void compileCompatibilityFlags(kj::StringPtr compatDate, capnp::List<capnp::Text>::Reader compatFlags,
+                         CompatibilityFlags::Builder output,
+                         Worker::ValidationErrorReporter& errorReporter,
+                         bool allowExperimentalFeatures,
+                         CompatibilityDateValidation dateValidation) {
+  // The full schema annotation walk below is repeated for every worker instantiation, but nearly
+  // all workers in a process share a handful of (date, flags) configurations, so memoize the
+  // result process-wide. The key includes everything the walk's outcome depends on. Note that
+  // CURRENT_DATE_FOR_CLOUDFLARE validation consults the real clock; a cached "no error" result
+  // could go stale at a midnight UTC rollover, which only matters for rejecting future-dated
+  // configs slightly late -- acceptable for a long-lived server process.
+  // Flag names are identifiers, so ',' and '|' cannot appear in them and the key is unambiguous.
+  auto key = kj::str(compatDate, '|', static_cast<int>(dateValidation),
+      allowExperimentalFeatures ? 'y' : 'n', '|', kj::strArray(compatFlags, ","));
+
+  static kj::MutexGuarded<kj::HashMap<kj::String, CompiledFlagsCacheEntry>> cache;
+
+  auto schema = capnp::Schema::from<CompatibilityFlags>();
+  auto fields = schema.getFields();
+
+  {
+    auto lock = cache.lockShared();
+    KJ_IF_SOME(entry, lock->find(key)) {
+      auto dynamicOutput = capnp::toDynamic(output);
+      for (auto i: kj::indices(fields)) {
+        dynamicOutput.set(fields[i], entry.fieldValues[i]);
+      }
+      for (auto& error: entry.errors) {
+        errorReporter.addError(kj::str(error));
+      }
+      return;
+    }
+  }
+
+  CachingErrorReporter reporter(errorReporter);
+  compileCompatibilityFlagsUncached(compatDate, compatFlags, output, reporter,
+      allowExperimentalFeatures, dateValidation);
+
+  auto fieldValues = kj::heapArrayBuilder<bool>(fields.size());
+  auto dynamicReader = capnp::toDynamic(output.asReader());
+  for (auto field: fields) {
+    fieldValues.add(dynamicReader.get(field).as<bool>());
+  }
+
+  cache.lockExclusive()->upsert(kj::mv(key), CompiledFlagsCacheEntry {
+    .fieldValues = fieldValues.finish(),
+    .errors = reporter.releaseErrors(),
+  }, [](auto&&, auto&&) {
+    // Another thread compiled the same config concurrently; either result is fine.
+  });
+}
+
 namespace {
 
 struct ParsedField {
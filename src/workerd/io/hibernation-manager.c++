@@ -181,25 +181,77 @@ kj::Vector<jsg::Ref<api::WebSocket>> HibernationManagerImpl::getWebSockets(
   return kj::mv(matches);
 }
 
+kj::Promise<void> HibernationManagerImpl::deliverToTag(kj::StringPtr tag, kj::String message) {
+  // The message buffer is refcounted so every send can share it; we serialize once no matter how
+  // many sockets are in the tag, and neither the broadcast promise nor any individual socket's
+  // send queue needs to outlive the others.
+  struct SharedMessage: public kj::Refcounted {
+    kj::String message;
+    SharedMessage(kj::String message): message(kj::mv(message)) {}
+  };
+  auto sharedMessage = kj::refcounted<SharedMessage>(kj::mv(message));
+
+  kj::Vector<kj::Promise<void>> sends;
+  KJ_IF_SOME(collection, tagToWs.find(tag)) {
+    auto& list = *collection->list;
+    sends.reserve(list.size());
+    for (auto& item: list) {
+      auto& hibWS = KJ_REQUIRE_NONNULL(item.hibWS);
+      KJ_SWITCH_ONEOF(hibWS.activeOrPackage) {
+        KJ_CASE_ONEOF(apiWs, jsg::Ref<api::WebSocket>) {
+          // The socket is awake, so its outgoing pump may be running. Route the message through
+          // the api::WebSocket's auto-response send path, which already knows how to interleave
+          // an internally-generated message with queued user sends.
+          sends.add(apiWs->sendAutoResponse(
+              kj::str(sharedMessage->message), *KJ_REQUIRE_NONNULL(hibWS.ws))
+                  .catch_([](kj::Exception&&) {}));
+        }
+        KJ_CASE_ONEOF(package, api::WebSocket::HibernationPackage) {
+          if (!package.closedOutgoingConnection) {
+            // The socket is hibernating; write directly to the kj::WebSocket without waking it,
+            // chaining on any in-flight auto-response send so we never issue overlapping send()s.
+            auto& ws = *KJ_REQUIRE_NONNULL(hibWS.ws);
+            auto p = hibWS.autoResponsePromise.then(
+                [&ws, sharedMessage = kj::addRef(*sharedMessage)]() {
+              return ws.send(sharedMessage->message.asArray());
+            }).fork();
+            hibWS.autoResponsePromise = p.addBranch();
+            // A failed send just means this socket is going away; its read loop will dispatch the
+            // usual close/error events, and the rest of the tag should still get the message.
+            sends.add(p.addBranch().catch_([](kj::Exception&&) {}));
+          }
+        }
+      }
+    }
+  }
+
+  co_await kj::joinPromises(sends.releaseAsArray());
+}
+
 void HibernationManagerImpl::setWebSocketAutoResponse(
     kj::Maybe<kj::StringPtr> request, kj::Maybe<kj::StringPtr> response) {
+  autoResponsePairs.clear();
   KJ_IF_SOME(req, request) {
     // If we have a request, we must also have a response. If response is kj::none, we'll throw.
-    autoResponsePair->request = kj::str(req);
-    autoResponsePair->response = kj::str(KJ_REQUIRE_NONNULL(response));
-    return;
+    autoResponsePairs.add(AutoResponsePair {
+      .request = kj::str(req),
+      .response = kj::str(KJ_REQUIRE_NONNULL(response)),
+    });
+  }
+}
+
+void HibernationManagerImpl::setWebSocketAutoResponses(kj::Array<AutoResponsePair> pairs) {
+  autoResponsePairs.clear();
+  for (auto& pair: pairs) {
+    autoResponsePairs.add(kj::mv(pair));
   }
-  // If we don't have a request, we must unset both request and response.
-  autoResponsePair->request = kj::none;
-  autoResponsePair->response = kj::none;
 }
 
 kj::Maybe<jsg::Ref<api::WebSocketRequestResponsePair>> HibernationManagerImpl::getWebSocketAutoResponse() {
-  KJ_IF_SOME(req, autoResponsePair->request) {
-    // When getting the currently set auto-response pair, if we have a request we must have a response
-    // set. If not, we'll throw.
-    return api::WebSocketRequestResponsePair::constructor(kj::str(req),
-        kj::str(KJ_REQUIRE_NONNULL(autoResponsePair->response)));
+  if (autoResponsePairs.size() > 0) {
+    auto& pair = autoResponsePairs[0];
+    return api::WebSocketRequestResponsePair::constructor(
+        kj::str(pair.request), kj::str(pair.response));
   }
   return kj::none;
 }
@@ -284,57 +336,62 @@ kj::Promise<void> HibernationManagerImpl::readLoop(HibernatableWebSocket& hib) {
 
     auto skip = false;
 
-    // If we have a request != kj::none, we can compare it the received message. This also implies
-    // that we have a response set in autoResponsePair.
-    KJ_IF_SOME (req, autoResponsePair->request) {
-      KJ_SWITCH_ONEOF(message) {
-        KJ_CASE_ONEOF(text, kj::String) {
-          if (text == req) {
-            // If the received message matches the one set for auto-response, we must
-            // short-circuit readLoop, store the current timestamp and and automatically respond
-            // with the expected response.
-            TimerChannel& timerChannel = KJ_REQUIRE_NONNULL(timer);
-            // This should count as a new IO event, hence we should call syncTime
-            // otherwise the autoResponseTimestamp wouldn't be accurate.
-            timerChannel.syncTime();
-            // We should have set the timerChannel previously in the hibernation manager.
-            // If we haven't, we aren't able to get the current time.
-            hib.autoResponseTimestamp = timerChannel.now();
-            // We'll store the current timestamp in the HibernatableWebSocket to assure it gets
-            // stored even if the WebSocket is currently hibernating. In that scenario, the timestamp
-            // value will be loaded into the WebSocket during unhibernation.
-            KJ_SWITCH_ONEOF(hib.activeOrPackage){
-              KJ_CASE_ONEOF(apiWs, jsg::Ref<api::WebSocket>) {
-                // If the actor is not hibernated/If the WebSocket is active, we need to update
-                // autoResponseTimestamp on the active websocket.
-                apiWs->setAutoResponseStatus(hib.autoResponseTimestamp, kj::READY_NOW);
-                // Since we had a request set, we must have and response that's sent back using the
-                // same websocket here. The sending of response is managed in web-socket to avoid
-                // possible racing problems with regular websocket messages.
-                co_await apiWs->sendAutoResponse(
-                    kj::str(KJ_REQUIRE_NONNULL(autoResponsePair->response).asArray()), ws);
-              }
-              KJ_CASE_ONEOF(package, api::WebSocket::HibernationPackage) {
-                if (!package.closedOutgoingConnection) {
-                  // We need to store the autoResponsePromise because we may instantiate an api::websocket
-                  // If we do that, we have to provide it with the promise to avoid races. This can
-                  // happen if we have a websocket hibernating, that unhibernates and sends a
-                  // message while ws.send() for auto-response is also sending.
-                  auto p = ws.send(
-                      KJ_REQUIRE_NONNULL(autoResponsePair->response).asArray()).fork();
-                  hib.autoResponsePromise = p.addBranch();
-                  co_await p;
-                  hib.autoResponsePromise = kj::READY_NOW;
-                }
-              }
-            }
-            // If we've sent an auto response message, we should not unhibernate or deliver the
-            // received message to the actor
-            skip = true;
+    // Check the incoming message against the auto-response table. On a match we answer natively
+    // from right here in the read loop; the actor is never woken and we never enter the isolate.
+    kj::Maybe<kj::String> matchedResponse;
+    KJ_SWITCH_ONEOF(message) {
+      KJ_CASE_ONEOF(text, kj::String) {
+        for (auto& pair: autoResponsePairs) {
+          if (text == pair.request) {
+            // Copy the response so a concurrent setWebSocketAutoResponse() call can't invalidate
+            // the bytes while the send below is in flight.
+            matchedResponse = kj::str(pair.response);
+            break;
+          }
+        }
+      }
+      KJ_CASE_ONEOF_DEFAULT {}
+    }
+
+    KJ_IF_SOME(response, matchedResponse) {
+      // The received message matches an auto-response entry, so we must short-circuit readLoop,
+      // store the current timestamp and automatically respond with the expected response.
+      TimerChannel& timerChannel = KJ_REQUIRE_NONNULL(timer);
+      // This should count as a new IO event, hence we should call syncTime
+      // otherwise the autoResponseTimestamp wouldn't be accurate.
+      timerChannel.syncTime();
+      // We should have set the timerChannel previously in the hibernation manager.
+      // If we haven't, we aren't able to get the current time.
+      hib.autoResponseTimestamp = timerChannel.now();
+      // We'll store the current timestamp in the HibernatableWebSocket to assure it gets
+      // stored even if the WebSocket is currently hibernating. In that scenario, the timestamp
+      // value will be loaded into the WebSocket during unhibernation.
+      KJ_SWITCH_ONEOF(hib.activeOrPackage){
+        KJ_CASE_ONEOF(apiWs, jsg::Ref<api::WebSocket>) {
+          // If the actor is not hibernated/If the WebSocket is active, we need to update
+          // autoResponseTimestamp on the active websocket.
+          apiWs->setAutoResponseStatus(hib.autoResponseTimestamp, kj::READY_NOW);
+          // The response is sent back using the same websocket here. The sending of the response
+          // is managed in web-socket to avoid possible racing problems with regular websocket
+          // messages.
+          co_await apiWs->sendAutoResponse(kj::mv(response), ws);
+        }
+        KJ_CASE_ONEOF(package, api::WebSocket::HibernationPackage) {
+          if (!package.closedOutgoingConnection) {
+            // We need to store the autoResponsePromise because we may instantiate an api::websocket
+            // If we do that, we have to provide it with the promise to avoid races. This can
+            // happen if we have a websocket hibernating, that unhibernates and sends a
+            // message while ws.send() for auto-response is also sending.
+            auto p = ws.send(response.asArray()).attach(kj::mv(response)).fork();
+            hib.autoResponsePromise = p.addBranch();
+            co_await p;
+            hib.autoResponsePromise = kj::READY_NOW;
           }
         }
-        KJ_CASE_ONEOF_DEFAULT {}
       }
+      // If we've sent an auto response message, we should not unhibernate or deliver the
+      // received message to the actor
+      skip = true;
     }
 
     if (skip) {
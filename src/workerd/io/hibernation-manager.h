@@ -31,12 +31,21 @@ public:
       jsg::Lock& js,
       kj::Maybe<kj::StringPtr> tag) override;
 
+  // Sends `message` to every websocket associated with the given tag without waking any
+  // hibernating websockets. The message buffer is shared across all sends, so broadcasting to a
+  // large tag costs one serialization rather than one per socket, and hibernating sockets are
+  // written to directly -- we never enter the isolate. Sockets whose sends fail are skipped; their
+  // read loops will observe the failure and dispatch the usual close/error events. The returned
+  // promise resolves once the message has been written (or queued) to every socket in the tag.
+  kj::Promise<void> deliverToTag(kj::StringPtr tag, kj::String message);
+
   // Hibernates all the websockets held by the HibernationManager.
   // This converts our activeOrPackage from an api::WebSocket to a HibernationPackage.
   void hibernateWebSockets(Worker::Lock& lock) override;
 
   void setWebSocketAutoResponse(kj::Maybe<kj::StringPtr> request,
       kj::Maybe<kj::StringPtr> response) override;
+  void setWebSocketAutoResponses(kj::Array<AutoResponsePair> pairs) override;
   kj::Maybe<jsg::Ref<api::WebSocketRequestResponsePair>> getWebSocketAutoResponse() override;
   void setTimerChannel(TimerChannel& timerChannel) override;
 
@@ -166,15 +175,6 @@ private:
     TagCollection(TagCollection&& other) = default;
   };
 
-  // This structure will hold the request and corresponding response for hibernatable websockets
-  // auto-response feature. Although we store 2 kj::Maybe strings, if we don't have a request set
-  // we can't have a response, and vice versa.
-  // TODO(cleanup): Remove kj::Maybe from request and response strings.
-  struct AutoRequestResponsePair {
-    kj::Maybe<kj::String> request = kj::none;
-    kj::Maybe<kj::String> response = kj::none;
-  };
-
   // A hashmap of tags to HibernatableWebSockets associated with the tag.
   // We use a kj::List so we can quickly remove websockets that have disconnected.
   // Also note that we box the keys and values such that in the event of a hashmap resizing we don't
@@ -210,7 +210,12 @@ private:
   };
   DisconnectHandler onDisconnect;
   kj::TaskSet readLoopTasks;
-  kj::Own<AutoRequestResponsePair> autoResponsePair = kj::heap<AutoRequestResponsePair>();
+
+  // The auto-response table, matched against incoming text messages in readLoop(). Tables are
+  // tiny (a heartbeat pattern or two), so a linear scan beats any indexed structure; the first
+  // entry doubles as the value reported by getWebSocketAutoResponse().
+  kj::Vector<AutoResponsePair> autoResponsePairs;
+
   kj::Maybe<TimerChannel&> timer;
   kj::Maybe<uint32_t> eventTimeoutMs;
 };
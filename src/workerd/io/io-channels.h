@@ -47,6 +47,11 @@ public:
   virtual kj::Date now() = 0;
 
   // Returns a promise that resolves once `now() >= when`.
+  //
+  // Each outstanding call holds a registration in the underlying timer implementation, so
+  // components that track many deadlines (timeouts, alarm retries) are expected to multiplex:
+  // keep their own ordered queue and only have a promise outstanding for the earliest entry.
+  // TimeoutManagerImpl and AlarmScheduler both do this.
   virtual kj::Promise<void> atTime(kj::Date when) = 0;
 
   // Returns a promise that resolves after some time. This is intended to be used for implementing
@@ -9,6 +9,7 @@
 #include <workerd/jsg/jsg.h>
 #include <workerd/util/sentry.h>
 #include <workerd/util/uncaught-exception-source.h>
+#include <workerd/util/use-perfetto-categories.h>
 #include <map>
 
 namespace workerd {
@@ -89,6 +90,11 @@ private:
   // Promise that is waiting for the closest timeout, and will fulfill its fulfiller. We only ever
   // actually wait on the next timeout in `timeoutTasks`, so that we can't fulfill timer callbacks
   // out-of-order. This task gets replaced each time the lead timeout changes.
+  //
+  // If the lead timeout is already due, we don't arm a timer at all: resetTimerTask() fulfills it
+  // directly, and the next timeout is delivered when that one completes. This way a burst of
+  // already-expired timeouts costs one trip through the timer channel rather than one per
+  // timeout.
   kj::Promise<void> timerTask = nullptr;
 
   // Must be called any time timeoutTimes.begin() changes.
@@ -112,6 +118,264 @@ public:
   kj::Maybe<kj::Promise<void>> maybePromise;
 };
 
+// =======================================================================================
+// Deduplication of identical idempotent GET subrequests
+// (SubrequestOptions::dedupeIdempotentGets).
+
+// Cap on how much response body we'll buffer for replay. A response that exceeds this (or that
+// advertises a larger body up front) disables sharing for its entry; the primary requester
+// streams it through unaffected.
+static constexpr size_t MAX_DEDUPED_GET_BODY_BYTES = 1 << 20;  // 1 MiB
+
+struct IoContext::DedupedGetCache: public kj::Refcounted {
+  struct Entry: public kj::Refcounted {
+    Entry() {
+      auto paf = kj::newPromiseAndFulfiller<void>();
+      doneFulfiller = kj::mv(paf.fulfiller);
+      done = paf.promise.fork();
+    }
+
+    // Resolves once the entry's fate is known: the primary request either fully buffered its
+    // response or the entry was marked invalid. Never rejects; followers check `invalid` after
+    // waiting.
+    kj::ForkedPromise<void> done = nullptr;
+    kj::Maybe<kj::Own<kj::PromiseFulfiller<void>>> doneFulfiller;
+
+    // When true this response can't be replayed (WebSocket upgrade, 5xx, oversized body, or the
+    // primary request failed or abandoned its body); followers issue their own subrequests.
+    bool invalid = false;
+
+    uint statusCode = 0;
+    kj::String statusText;
+    kj::Maybe<kj::HttpHeaders> headers;
+    kj::Vector<kj::byte> body;
+
+    void fulfillDone() {
+      KJ_IF_SOME(f, doneFulfiller) {
+        f->fulfill();
+        doneFulfiller = kj::none;
+      }
+    }
+
+    // Marks the response unreplayable and immediately releases any followers waiting on `done`
+    // so they fall back to their own subrequests. This must not wait for the primary request to
+    // complete: for an unbounded body (e.g. a long-lived event stream that overflowed the
+    // replay buffer) that may never happen.
+    void invalidate() {
+      invalid = true;
+      body.clear();
+      fulfillDone();
+    }
+  };
+
+  // Keyed by URL plus serialized request headers (method is always GET).
+  kj::HashMap<kj::String, kj::Own<Entry>> entries;
+
+  // Removes `entry` from the map if it is still the one registered under `key`. (After an entry
+  // is invalidated and erased mid-stream, a fresh entry may be created under the same key; the
+  // original primary finishing must not knock that one out.)
+  void eraseIfCurrent(kj::StringPtr key, Entry& entry) {
+    KJ_IF_SOME(existing, entries.find(key)) {
+      if (existing.get() == &entry) {
+        entries.erase(key);
+      }
+    }
+  }
+
+  static kj::String makeKey(kj::StringPtr url, const kj::HttpHeaders& headers) {
+    kj::Vector<kj::String> parts;
+    parts.add(kj::str(url));
+    headers.forEach([&](kj::StringPtr name, kj::StringPtr value) {
+      parts.add(kj::str(name, ": ", value));
+    });
+    return kj::strArray(parts, "\n");
+  }
+};
+
+namespace {
+
+using DedupEntry = IoContext::DedupedGetCache::Entry;
+
+// Output stream that forwards writes to the primary requester while copying them into the
+// entry's replay buffer, until the buffer cap is hit.
+class BufferingOutputStream final: public kj::AsyncOutputStream {
+public:
+  BufferingOutputStream(kj::Own<kj::AsyncOutputStream> inner, kj::Own<DedupEntry> entry,
+      kj::Own<IoContext::DedupedGetCache> cache, kj::String key)
+      : inner(kj::mv(inner)), entry(kj::mv(entry)), cache(kj::mv(cache)), key(kj::mv(key)) {}
+
+  kj::Promise<void> write(kj::ArrayPtr<const kj::byte> buffer) override {
+    copyIn(buffer);
+    return inner->write(buffer);
+  }
+  kj::Promise<void> write(kj::ArrayPtr<const kj::ArrayPtr<const kj::byte>> pieces) override {
+    for (auto& piece: pieces) copyIn(piece);
+    return inner->write(pieces);
+  }
+  kj::Promise<void> whenWriteDisconnected() override {
+    return inner->whenWriteDisconnected();
+  }
+
+private:
+  kj::Own<kj::AsyncOutputStream> inner;
+  kj::Own<DedupEntry> entry;
+  kj::Own<IoContext::DedupedGetCache> cache;
+  kj::String key;
+
+  void copyIn(kj::ArrayPtr<const kj::byte> piece) {
+    if (entry->invalid) return;
+    if (entry->body.size() + piece.size() > MAX_DEDUPED_GET_BODY_BYTES) {
+      // The body outgrew the replay buffer mid-stream. Release waiting followers and drop the
+      // entry from the map right away: the primary may keep streaming indefinitely, and both
+      // current waiters and later identical GETs must fall back to their own subrequests now
+      // rather than waiting for it to finish.
+      entry->invalidate();
+      cache->eraseIfCurrent(key, *entry);
+      return;
+    }
+    entry->body.addAll(piece);
+  }
+};
+
+// Response interceptor used for the primary request of a dedup entry.
+class BufferingResponse final: public kj::HttpService::Response {
+public:
+  BufferingResponse(kj::HttpService::Response& inner, kj::Own<DedupEntry> entry,
+      kj::Own<IoContext::DedupedGetCache> cache, kj::String key)
+      : inner(inner), entry(kj::mv(entry)), cache(kj::mv(cache)), key(kj::mv(key)) {}
+
+  kj::Own<kj::AsyncOutputStream> send(
+      uint statusCode, kj::StringPtr statusText, const kj::HttpHeaders& headers,
+      kj::Maybe<uint64_t> expectedBodySize = kj::none) override {
+    // Server errors are plausibly transient, so don't fan one response out to all followers.
+    if (statusCode >= 500 || expectedBodySize.orDefault(0) > MAX_DEDUPED_GET_BODY_BYTES) {
+      // Release followers and drop the entry immediately rather than when the primary finishes
+      // streaming; a large body may take a while (or never end).
+      entry->invalidate();
+      cache->eraseIfCurrent(key, *entry);
+    } else {
+      entry->statusCode = statusCode;
+      entry->statusText = kj::str(statusText);
+      entry->headers = headers.clone();
+    }
+    auto stream = inner.send(statusCode, statusText, headers, expectedBodySize);
+    if (entry->invalid) {
+      return stream;
+    }
+    return kj::heap<BufferingOutputStream>(
+        kj::mv(stream), kj::addRef(*entry), kj::addRef(*cache), kj::str(key));
+  }
+
+  kj::Own<kj::WebSocket> acceptWebSocket(const kj::HttpHeaders& headers) override {
+    // As above, don't leave followers waiting out the lifetime of the WebSocket.
+    entry->invalidate();
+    cache->eraseIfCurrent(key, *entry);
+    return inner.acceptWebSocket(headers);
+  }
+
+private:
+  kj::HttpService::Response& inner;
+  kj::Own<DedupEntry> entry;
+  kj::Own<IoContext::DedupedGetCache> cache;
+  kj::String key;
+};
+
+class DedupedGetWorkerInterface final: public WorkerInterface {
+public:
+  DedupedGetWorkerInterface(kj::Own<WorkerInterface> inner,
+      kj::Own<IoContext::DedupedGetCache> cache)
+      : inner(kj::mv(inner)), cache(kj::mv(cache)) {}
+
+  kj::Promise<void> request(
+      kj::HttpMethod method, kj::StringPtr url, const kj::HttpHeaders& headers,
+      kj::AsyncInputStream& requestBody, kj::HttpService::Response& response) override {
+    if (method != kj::HttpMethod::GET) {
+      return inner->request(method, url, headers, requestBody, response);
+    }
+
+    auto key = IoContext::DedupedGetCache::makeKey(url, headers);
+    KJ_IF_SOME(entry, cache->entries.find(key)) {
+      return replay(kj::addRef(*entry), url, headers, requestBody, response);
+    }
+
+    auto entry = kj::refcounted<DedupEntry>();
+    cache->entries.insert(kj::mv(key), kj::addRef(*entry));
+    return runPrimary(kj::mv(entry), url, headers, requestBody, response);
+  }
+
+  kj::Promise<void> connect(kj::StringPtr host, const kj::HttpHeaders& headers,
+      kj::AsyncIoStream& connection, ConnectResponse& response,
+      kj::HttpConnectSettings settings) override {
+    return inner->connect(host, headers, connection, response, settings);
+  }
+  void prewarm(kj::StringPtr url) override {
+    inner->prewarm(url);
+  }
+  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron,
+      uint32_t shardIndex, uint32_t shardCount) override {
+    return inner->runScheduled(scheduledTime, cron, shardIndex, shardCount);
+  }
+  kj::Promise<AlarmResult> runAlarm(kj::Date scheduledTime, uint32_t retryCount) override {
+    return inner->runAlarm(scheduledTime, retryCount);
+  }
+  kj::Promise<CustomEvent::Result> customEvent(kj::Own<CustomEvent> event) override {
+    return inner->customEvent(kj::mv(event));
+  }
+
+private:
+  kj::Own<WorkerInterface> inner;
+  kj::Own<IoContext::DedupedGetCache> cache;
+
+  kj::Promise<void> runPrimary(kj::Own<DedupEntry> entry, kj::StringPtr url,
+      const kj::HttpHeaders& headers, kj::AsyncInputStream& requestBody,
+      kj::HttpService::Response& response) {
+    auto key = IoContext::DedupedGetCache::makeKey(url, headers);
+    BufferingResponse interceptor(response, kj::addRef(*entry), kj::addRef(*cache), kj::str(key));
+    bool success = false;
+    KJ_DEFER({
+      if (!success) {
+        entry->invalid = true;
+      }
+      // Wake followers either way. If the entry went invalid, also remove it from the map so
+      // that later identical GETs start fresh instead of replaying a failure. (Both may have
+      // already happened mid-stream, e.g. on a buffer-cap hit; invalidate() and eraseIfCurrent()
+      // are no-ops then, and a fresh entry created under the same key since is left alone.)
+      if (entry->invalid) {
+        entry->invalidate();
+        cache->eraseIfCurrent(key, *entry);
+      }
+      entry->fulfillDone();
+    });
+    co_await inner->request(kj::HttpMethod::GET, url, headers, requestBody, interceptor);
+    // The inner request resolving means the response body was fully produced; if send() was
+    // never called (e.g. the service short-circuited), there is nothing to replay.
+    success = entry->headers != kj::none;
+  }
+
+  kj::Promise<void> replay(kj::Own<DedupEntry> entry, kj::StringPtr url,
+      const kj::HttpHeaders& headers, kj::AsyncInputStream& requestBody,
+      kj::HttpService::Response& response) {
+    co_await entry->done.addBranch();
+    if (entry->invalid) {
+      // Sharing was not possible; issue our own subrequest.
+      co_await inner->request(kj::HttpMethod::GET, url, headers, requestBody, response);
+      co_return;
+    }
+    auto stream = response.send(entry->statusCode, entry->statusText,
+        KJ_ASSERT_NONNULL(entry->headers), entry->body.size());
+    co_await stream->write(entry->body.asPtr());
+  }
+};
+
+}  // namespace
+
+IoContext::DedupedGetCache& IoContext::getDedupedGetCache() {
+  KJ_IF_SOME(c, dedupedGetCache) {
+    return *c;
+  }
+  return *dedupedGetCache.emplace(kj::refcounted<DedupedGetCache>());
+}
+
 IoContext::IoContext(ThreadContext& thread,
                                kj::Own<const Worker> workerParam,
                                kj::Maybe<Worker::Actor&> actorParam,
@@ -124,6 +388,7 @@ IoContext::IoContext(ThreadContext& thread,
       deleteQueue(kj::atomicRefcounted<DeleteQueue>()),
       cachePutSerializer(kj::READY_NOW),
       waitUntilTasks(*this),
+      bestEffortWaitUntilTasks(*this),
       timeoutManager(kj::heap<TimeoutManagerImpl>()) {
   kj::PromiseFulfillerPair<void> paf = kj::newPromiseAndFulfiller<void>();
   abortFulfiller = kj::mv(paf.fulfiller);
@@ -225,6 +490,9 @@ void IoContext::IncomingRequest::delivered() {
   wasDelivered = true;
   metrics->delivered();
 
+  // A new I/O event has arrived; let Date.now() observe fresh time.
+  context->cachedNow = kj::none;
+
   KJ_IF_SOME(a, context->actor) {
     // Re-synchronize the timer and top up limits for every new incoming request to an actor.
     ioChannelFactory->getTimer().syncTime();
@@ -417,20 +685,31 @@ void IoContext::addTask(kj::Promise<void> promise) {
   tasks.add(kj::mv(promise));
 }
 
-void IoContext::addWaitUntil(kj::Promise<void> promise) {
+void IoContext::addWaitUntil(kj::Promise<void> promise, WaitUntilTaskClass taskClass) {
   if (actor == kj::none) {
     // This metric won't work correctly in actors since it's being tracked per-request, but tasks
     // are not tied to requests in actors. So we just skip it in actors.
     auto& metrics = getMetrics();
     if (metrics.getSpan().isObserved()) {
-      metrics.addedWaitUntilTask();
-      promise = promise.attach(kj::defer([metrics = kj::addRef(metrics)]() mutable {
-        metrics->finishedWaitUntilTask();
-      }));
+      if (taskClass == WaitUntilTaskClass::BEST_EFFORT) {
+        metrics.addedBestEffortWaitUntilTask();
+        promise = promise.attach(kj::defer([metrics = kj::addRef(metrics)]() mutable {
+          metrics->finishedBestEffortWaitUntilTask();
+        }));
+      } else {
+        metrics.addedWaitUntilTask();
+        promise = promise.attach(kj::defer([metrics = kj::addRef(metrics)]() mutable {
+          metrics->finishedWaitUntilTask();
+        }));
+      }
     }
   }
 
-  waitUntilTasks.add(kj::mv(promise));
+  if (taskClass == WaitUntilTaskClass::BEST_EFFORT) {
+    bestEffortWaitUntilTasks.add(kj::mv(promise));
+  } else {
+    waitUntilTasks.add(kj::mv(promise));
+  }
 }
 
 // Mark ourselves so we know that we made a best effort attempt to wait for waitUntilTasks.
@@ -458,7 +737,11 @@ kj::Promise<void> IoContext::IncomingRequest::drain() {
     // For non-actor requests, apply the configured soft timeout, typically 30 seconds.
     timeoutPromise = context->limitEnforcer->limitDrain();
   }
-  return context->waitUntilTasks.onEmpty().exclusiveJoin(kj::mv(timeoutPromise))
+  // Wait for critical tasks first; best-effort tasks (telemetry and the like) only get whatever
+  // time remains before the timeout, so they can never hold up required work.
+  return context->waitUntilTasks.onEmpty()
+      .then([this]() { return context->bestEffortWaitUntilTasks.onEmpty(); })
+      .exclusiveJoin(kj::mv(timeoutPromise))
       .exclusiveJoin(context->abortPromise.addBranch().then([]{}, [](kj::Exception&&){}));
 }
 
@@ -476,10 +759,16 @@ kj::Promise<IoContext_IncomingRequest::FinishScheduledResult> IoContext::Incomin
   KJ_ASSERT(context->incomingRequests.size() == 1);
   context->incomingRequests.front().waitedForWaitUntil = true;
 
-  auto timeoutPromise = context->limitEnforcer->limitScheduled().then([] {
-    return IoContext_IncomingRequest::FinishScheduledResult::TIMEOUT;
+  auto timeoutPromise = context->limitEnforcer->limitScheduled().then([this] {
+    // If only best-effort tasks (telemetry) are left at the deadline, the event itself did all
+    // of its required work, so report success; a telemetry straggler shouldn't be able to make
+    // a cron run look like it timed out.
+    return context->waitUntilTasks.isEmpty()
+        ? IoContext_IncomingRequest::FinishScheduledResult::COMPLETED
+        : IoContext_IncomingRequest::FinishScheduledResult::TIMEOUT;
   });
   return context->waitUntilTasks.onEmpty()
+      .then([this]() { return context->bestEffortWaitUntilTasks.onEmpty(); })
       .then([]() { return IoContext_IncomingRequest::FinishScheduledResult::COMPLETED; })
       .exclusiveJoin(kj::mv(timeoutPromise))
       .exclusiveJoin(context->abortPromise.addBranch().then([] {
@@ -522,7 +811,7 @@ IoContext::PendingEvent::~PendingEvent() noexcept(false) {
   context.runFinalizersTask = Worker::AsyncLock::whenThreadIdle()
       .then([&context = context]() noexcept {
     // We have nothing left to do and no PendingEvent has been registered. Run finalizers now.
-    return context.worker->takeAsyncLock(context.getMetrics()).then(
+    return context.worker->takeAsyncLock(context.getMetrics(), context.lockPriority).then(
         [&context](Worker::AsyncLock asyncLock) {
       context.runFinalizers(asyncLock);
     });
@@ -736,6 +1025,14 @@ void IoContext::TimeoutManagerImpl::resetTimerTask(TimerChannel& timerChannel) {
   if (timeoutTimes.size() == 0) {
     // Not waiting for any timer, clear the existing timer task.
     timerTask = nullptr;
+  } else if (timeoutTimes.begin()->key.when <= timerChannel.now()) {
+    // The lead timeout is already due. This is common both for zero-delay timeouts and for bursts
+    // of short timeouts that expired while an earlier callback was running. Fulfill it directly
+    // instead of taking a round trip through the timer channel; when it completes, its removal
+    // calls back into resetTimerTask() to deliver the next one. Note that we still only fulfill
+    // one timeout at a time, preserving the ordering invariant on `timeoutTimes`.
+    timerTask = nullptr;
+    timeoutTimes.begin()->value->fulfill();
   } else {
     // Wait for the first timer.
     auto& entry = *timeoutTimes.begin();
@@ -789,8 +1086,23 @@ size_t IoContext::getTimeoutCount() {
 }
 
 kj::Date IoContext::now(IncomingRequest& incomingRequest) {
-  kj::Date adjustedTime = incomingRequest.ioChannelFactory->getTimer().now();
-  incomingRequest.metrics->clockRead();
+  kj::Date adjustedTime = kj::UNIX_EPOCH;
+  KJ_IF_SOME(cached, cachedNow) {
+    // Repeated reads within the same turn of the event loop serve the cached timestamp,
+    // skipping the timer channel (and its spectre-mitigation accounting) entirely.
+    adjustedTime = cached;
+  } else {
+    adjustedTime = incomingRequest.ioChannelFactory->getTimer().now();
+    incomingRequest.metrics->clockRead();
+    cachedNow = adjustedTime;
+    // Invalidate the cache when the event loop next runs out of immediately-runnable
+    // work, so that time observably advances across I/O (but not within a synchronous
+    // stretch of execution, matching the documented "constant between ticks" behavior).
+    // This overwrites the previous, already-completed invalidator.
+    cachedNowInvalidator = kj::evalLast([this]() {
+      cachedNow = kj::none;
+    }).eagerlyEvaluate(nullptr);
+  }
 
   KJ_IF_SOME (maybeNextTimeout, timeoutManager->getNextTimeout()) {
     // Don't return a time beyond when the next setTimeout() callback is intended to run. This
@@ -810,6 +1122,8 @@ kj::Date IoContext::now() {
 kj::Own<WorkerInterface> IoContext::getSubrequestNoChecks(
     kj::FunctionParam<kj::Own<WorkerInterface>(SpanBuilder&, IoChannelFactory&)> func,
     SubrequestOptions options) {
+  // Links the subrequest to the IoContext::run() slice that issued it (same flow ID derivation).
+  TRACE_EVENT("workerd", "IoContext::subrequest", PERFETTO_FLOW_FROM_POINTER(this));
   SpanBuilder span = nullptr;
   KJ_IF_SOME(n, options.operationName) {
     span = makeTraceSpan(kj::mv(n));
@@ -824,6 +1138,10 @@ kj::Own<WorkerInterface> IoContext::getSubrequestNoChecks(
         kj::mv(ret), getHeaderIds().contentEncoding, metrics);
   }
 
+  if (options.dedupeIdempotentGets) {
+    ret = kj::heap<DedupedGetWorkerInterface>(kj::mv(ret), kj::addRef(getDedupedGetCache()));
+  }
+
   if (span.isObserved()) {
     ret = ret.attach(kj::mv(span));
   }
@@ -900,6 +1218,32 @@ kj::Own<CacheClient> IoContext::getCacheClient() {
   return getIoChannelFactory().getCache();
 }
 
+IoChannelFactory::ActorChannel& IoContext::getGlobalActorChannel(
+    uint channel, const ActorIdFactory::ActorId& id, kj::Maybe<kj::String> locationHint,
+    ActorGetMode mode, SpanParent parentSpan) {
+  // The options are folded into the key: a GET_EXISTING stub must not reuse a channel that was
+  // resolved with GET_OR_CREATE (or vice versa), and a location hint may influence where the
+  // actor lands.
+  auto key = kj::str("global.", channel, '.', static_cast<uint>(mode), '.',
+      locationHint.map([](kj::String& hint) -> kj::StringPtr { return hint; }).orDefault(nullptr),
+      '.', id.toString());
+  return *actorChannelMap.findOrCreate(key,
+      [&]() -> decltype(actorChannelMap)::Entry {
+    return {kj::mv(key), getIoChannelFactory().getGlobalActor(
+        channel, id, kj::mv(locationHint), mode, kj::mv(parentSpan))};
+  });
+}
+
+IoChannelFactory::ActorChannel& IoContext::getColoLocalActorChannel(
+    uint channel, kj::StringPtr id, SpanParent parentSpan) {
+  auto key = kj::str("local.", channel, '.', id);
+  return *actorChannelMap.findOrCreate(key,
+      [&]() -> decltype(actorChannelMap)::Entry {
+    return {kj::mv(key), getIoChannelFactory().getColoLocalActor(
+        channel, id, kj::mv(parentSpan))};
+  });
+}
+
 jsg::AsyncContextFrame::StorageScope IoContext::makeAsyncTraceScope(
     Worker::Lock& lock, kj::Maybe<SpanParent> spanParentOverride) {
   jsg::Lock& js = lock;
@@ -1020,6 +1364,10 @@ void IoContext::runImpl(Runnable& runnable, bool takePendingEvent,
                         Worker::LockType lockType,
                         kj::Maybe<InputGate::Lock> inputLock,
                         bool allowPermanentException) {
+  // The flow ID is derived from the IoContext's address so that this slice stitches together with
+  // the WorkerEntrypoint delivery and any subrequests issued while running (see
+  // getSubrequestNoChecks()).
+  TRACE_EVENT("workerd", "IoContext::run()", PERFETTO_FLOW_FROM_POINTER(this));
   KJ_IF_SOME(l, inputLock) {
     KJ_REQUIRE(l.isFor(KJ_ASSERT_NONNULL(actor).getInputGate()));
   }
@@ -1074,6 +1422,15 @@ void IoContext::runImpl(Runnable& runnable, bool takePendingEvent,
         // leads to an assert in v8 when the Lock is destroyed.
         tryCatch.Reset();
       }
+
+      if (TRACE_EVENT_CATEGORY_ENABLED("workerd")) {
+        // Report the isolate's heap usage on a counter track while tracing. This samples once per
+        // run so that heap growth correlates with the slices that caused it.
+        v8::HeapStatistics heapStats;
+        js.v8Isolate->GetHeapStatistics(&heapStats);
+        TRACE_COUNTER("workerd", PERFETTO_COUNTER_TRACK("isolateHeapUsedBytes"),
+                      heapStats.used_heap_size());
+      }
     });
 
     v8::TryCatch tryCatch(workerLock.getIsolate());
@@ -1257,8 +1614,60 @@ jsg::Promise<IoOwn<kj::AsyncInputStream>> IoContext::makeCachePutStream(
 
 void IoContext::writeLogfwdr(uint channel,
     kj::FunctionParam<void(capnp::AnyPointer::Builder)> buildMessage) {
-  addWaitUntil(getIoChannelFactory().writeLogfwdr(channel, kj::mv(buildMessage))
-      .attach(registerPendingEvent()));
+  auto message = kj::heap<capnp::MallocMessageBuilder>();
+  buildMessage(message->initRoot<capnp::AnyPointer>());
+
+  size_t totalBuffered = 1;
+  kj::Maybe<LogfwdrBatch&> maybeBatch;
+  for (auto& batch: pendingLogfwdrBatches) {
+    totalBuffered += batch.messages.size();
+    if (batch.channel == channel) {
+      maybeBatch = batch;
+    }
+  }
+  KJ_IF_SOME(batch, maybeBatch) {
+    batch.messages.add(kj::mv(message));
+  } else {
+    pendingLogfwdrBatches.add(LogfwdrBatch { channel, {} });
+    pendingLogfwdrBatches[pendingLogfwdrBatches.size() - 1].messages.add(kj::mv(message));
+  }
+
+  if (totalBuffered >= MAX_BUFFERED_LOGFWDR_MESSAGES) {
+    // Pathologically large burst; ship what we have right away rather than letting the buffer
+    // grow until the end of the turn.
+    addWaitUntil(flushLogfwdrBatches().attach(registerPendingEvent()),
+        WaitUntilTaskClass::BEST_EFFORT);
+  } else if (!logfwdrFlushScheduled) {
+    logfwdrFlushScheduled = true;
+    addWaitUntil(kj::evalLast([this]() {
+      logfwdrFlushScheduled = false;
+      return flushLogfwdrBatches();
+    }).attach(registerPendingEvent()), WaitUntilTaskClass::BEST_EFFORT);
+  }
+}
+
+kj::Promise<void> IoContext::flushLogfwdrBatches() {
+  auto batches = kj::mv(pendingLogfwdrBatches);
+  pendingLogfwdrBatches.clear();
+
+  for (auto& batch: batches) {
+    for (auto& message: batch.messages) {
+      // This runs from a plain event loop task, but IoChannelFactory implementations may call
+      // IoContext::current() in their synchronous part (before their first suspension), so make
+      // this context current just for the duration of the call.
+      kj::Promise<void> promise = nullptr;
+      {
+        IoContext* previousRequest = threadLocalRequest;
+        KJ_DEFER(threadLocalRequest = previousRequest);
+        threadLocalRequest = this;
+        promise = getIoChannelFactory().writeLogfwdr(batch.channel,
+            [&](capnp::AnyPointer::Builder ptr) {
+          ptr.setAs<capnp::AnyPointer>(message->getRoot<capnp::AnyPointer>().asReader());
+        });
+      }
+      co_await promise;
+    }
+  }
 }
 
 void IoContext::requireCurrentOrThrowJs() {
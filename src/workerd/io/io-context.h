@@ -21,6 +21,7 @@
 #include <kj/mutex.h>
 #include <kj/function.h>
 #include <capnp/dynamic.h>
+#include <capnp/message.h>
 #include <workerd/util/weak-refs.h>
 #include <workerd/io/limit-enforcer.h>
 #include <workerd/io/io-channels.h>
@@ -191,6 +192,7 @@ private:
 class IoContext final: public kj::Refcounted, private kj::TaskSet::ErrorHandler {
 public:
   class TimeoutManagerImpl;
+  struct DedupedGetCache;
 
   // Construct a new IoContext. Before using it, you must also create an IncomingRequest.
   IoContext(ThreadContext& thread,
@@ -223,6 +225,14 @@ public:
 
   LimitEnforcer& getLimitEnforcer() { return *limitEnforcer; }
 
+  // Selects which priority lane this context's isolate lock acquisitions use (see
+  // Worker::LockPriority). The default is interactive; the delivery path for background event
+  // types (alarms, queue batches, tail events) downgrades the context before running JavaScript
+  // so that bulk work doesn't queue ahead of latency-sensitive fetch traffic on a shared isolate.
+  void setLockPriority(Worker::LockPriority priority) { lockPriority = priority; }
+
+  Worker::LockPriority getLockPriority() { return lockPriority; }
+
   // Get the current input lock. Throws an exception if no input lock is held (e.g. because this is
   // not an actor request).
   InputGate::Lock getInputLock();
@@ -467,9 +477,22 @@ public:
   // Returns the number of times addTask() has been called (even if the tasks have completed).
   uint taskCount() { return addTaskCounter; }
 
+  // Classifies waitUntil tasks for draining purposes.
+  //
+  // CRITICAL tasks are ones whose loss would be observable, like actor storage flushes or
+  // script-provided `event.waitUntil()` promises; drain() and finishScheduled() wait for them
+  // up to the full soft timeout. BEST_EFFORT tasks are internal housekeeping like telemetry
+  // delivery: they get whatever time remains after the critical tasks finish, and a straggler
+  // cannot turn an otherwise-completed scheduled event into a timeout.
+  enum class WaitUntilTaskClass: uint8_t {
+    CRITICAL,
+    BEST_EFFORT,
+  };
+
   // Indicates that the script has requested that it stay active until the given promise resolves.
   // drain() waits until all such promises have completed.
-  void addWaitUntil(kj::Promise<void> promise);
+  void addWaitUntil(kj::Promise<void> promise,
+      WaitUntilTaskClass taskClass = WaitUntilTaskClass::CRITICAL);
 
   // Returns the status of waitUntil promises. If a promise fails, this sets the status to the
   // one corresponding to the exception type.
@@ -618,6 +641,13 @@ public:
 
     // The name to use for the request's span if tracing is turned on.
     kj::Maybe<kj::ConstString> operationName;
+
+    // Opt-in: deduplicate identical idempotent GETs issued through this client within this
+    // IoContext. Concurrent or repeated GETs with the same URL and headers share one underlying
+    // subrequest whose response is buffered (up to a size cap) and replayed; requests that
+    // aren't safely shareable (non-GET, WebSocket upgrades, 5xx responses, oversized bodies)
+    // fall back to issuing their own subrequest. See DedupedGetCache in io-context.c++.
+    bool dedupeIdempotentGets = false;
   };
 
   kj::Own<WorkerInterface> getSubrequestNoChecks(
@@ -673,16 +703,18 @@ public:
     return getIoChannelFactory().getCapability(channel);
   }
 
-  kj::Own<IoChannelFactory::ActorChannel> getGlobalActorChannel(
+  // Returns the channel to the given global actor, resolving it at most once per request:
+  // all stubs created for the same actor (with the same get options) within this request share
+  // one resolved channel rather than each resolving their own. The returned reference remains
+  // valid for the lifetime of the IoContext. Requests started while the channel is still
+  // resolving are pipelined by the channel implementation, so callers need not wait.
+  IoChannelFactory::ActorChannel& getGlobalActorChannel(
       uint channel, const ActorIdFactory::ActorId& id, kj::Maybe<kj::String> locationHint,
-      ActorGetMode mode, SpanParent parentSpan) {
-    return getIoChannelFactory().getGlobalActor(channel, id, kj::mv(locationHint), mode,
-        kj::mv(parentSpan));
-  }
-  kj::Own<IoChannelFactory::ActorChannel> getColoLocalActorChannel(uint channel, kj::StringPtr id,
-      SpanParent parentSpan) {
-    return getIoChannelFactory().getColoLocalActor(channel, id, kj::mv(parentSpan));
-  }
+      ActorGetMode mode, SpanParent parentSpan);
+
+  // Like getGlobalActorChannel(), but for colo-local actors.
+  IoChannelFactory::ActorChannel& getColoLocalActorChannel(uint channel, kj::StringPtr id,
+      SpanParent parentSpan);
 
   void abortAllActors() {
     return getIoChannelFactory().abortAllActors();
@@ -722,6 +754,11 @@ public:
     return localCapSet;
   }
 
+  // Buffers a message for the given logfwdr channel. `buildMessage` is invoked immediately, but
+  // delivery is batched: all messages buffered during the current event loop burst are shipped
+  // by a single flush task at the end of it (or sooner if the buffer grows large), so workers
+  // that emit many data points per request schedule one delivery instead of one per point.
+  // Like logfwdr itself, this makes no delivery guarantees.
   void writeLogfwdr(uint channel, kj::FunctionParam<void(capnp::AnyPointer::Builder)> buildMessage);
 
   jsg::JsObject getPromiseContextTag(jsg::Lock& js);
@@ -754,6 +791,9 @@ private:
 
   capnp::CapabilityServerSet<capnp::DynamicCapability> localCapSet;
 
+  // See setLockPriority().
+  Worker::LockPriority lockPriority = Worker::LockPriority::INTERACTIVE;
+
   bool failOpen = false;
 
   // For debug checks.
@@ -777,6 +817,28 @@ private:
 
   WarningAggregator::Map warningAggregatorMap;
 
+  // Actor channels resolved during this request, keyed by channel number plus actor ID (and,
+  // for global actors, the get options). See getGlobalActorChannel().
+  kj::HashMap<kj::String, kj::Own<IoChannelFactory::ActorChannel>> actorChannelMap;
+
+  // Messages waiting to be shipped to logfwdr channels, grouped by channel in insertion order.
+  // See writeLogfwdr() for the batching rationale. A worker typically has very few logfwdr
+  // channels, so a flat vector beats a map here.
+  struct LogfwdrBatch {
+    uint channel;
+    kj::Vector<kj::Own<capnp::MallocMessageBuilder>> messages;
+  };
+  kj::Vector<LogfwdrBatch> pendingLogfwdrBatches;
+  bool logfwdrFlushScheduled = false;
+
+  // Upper bound on buffered messages before the flush happens immediately rather than at the
+  // end of the event loop burst, to keep memory in check for pathological emitters.
+  static constexpr size_t MAX_BUFFERED_LOGFWDR_MESSAGES = 128;
+
+  // Delivers everything in `pendingLogfwdrBatches` through the IoChannelFactory, one message at
+  // a time in order.
+  kj::Promise<void> flushLogfwdrBatches();
+
   // Objects pointed to by IoOwn<T>s.
   // NOTE: This must live below `deleteQueue`, as some of these OwnedObjects may own attachctx()'ed
   //   objects which reference `deleteQueue` in their destructors.
@@ -788,6 +850,12 @@ private:
   kj::Promise<void> cachePutSerializer;
 
   kj::TaskSet waitUntilTasks;
+
+  // Tasks added with WaitUntilTaskClass::BEST_EFFORT. Kept separate so that drain() and
+  // finishScheduled() can distinguish "all required work is done" from "telemetry is still
+  // in flight".
+  kj::TaskSet bestEffortWaitUntilTasks;
+
   EventOutcome waitUntilStatusValue = EventOutcome::OK;
 
   void setTimeoutImpl(TimeoutId timeoutId, bool repeat, jsg::V8Ref<v8::Function> function,
@@ -807,6 +875,22 @@ private:
   // destructed.
   kj::Own<TimeoutManager> timeoutManager;
 
+  // Lazily-created state backing SubrequestOptions::dedupeIdempotentGets. Refcounted and shared
+  // with the client wrappers so a wrapper can never outlive the map it consults.
+  kj::Maybe<kj::Own<DedupedGetCache>> dedupedGetCache;
+
+  DedupedGetCache& getDedupedGetCache();
+
+  // Caches the timer read backing now() for the remainder of the current event loop
+  // turn. now() is documented to remain constant between ticks; the cache makes that
+  // cheap when a request calls Date.now() in a tight loop, which shows up as a top leaf
+  // function in profiles. The invalidator is a kj::evalLast() promise armed when the
+  // cache is filled; it is declared after `tasks`/`timeoutManager` so it is canceled
+  // first during teardown. The cache is also cleared whenever a new incoming request is
+  // delivered.
+  kj::Maybe<kj::Date> cachedNow;
+  kj::Maybe<kj::Promise<void>> cachedNowInvalidator;
+
   kj::Own<WorkerInterface> getSubrequestChannelImpl(
       uint channel, bool isInHouse, kj::Maybe<kj::String> cfBlobJson,
       SpanBuilder& span, IoChannelFactory& channelFactory);
@@ -917,15 +1001,24 @@ kj::PromiseForResult<Func, Worker::Lock&> IoContext::run(
   kj::Promise<Worker::AsyncLock> asyncLockPromise = nullptr;
   KJ_IF_SOME(a, actor) {
     if (inputLock == kj::none) {
-      return a.getInputGate().wait()
-          .then([this,func=kj::fwd<Func>(func)](InputGate::Lock&& inputLock) mutable {
-        return run(kj::fwd<Func>(func), kj::mv(inputLock));
-      });
+      // Common case: the input gate is idle, so we can take a lock synchronously rather than
+      // allocating a promise chain and waiting a turn of the event loop for every event
+      // delivered to the actor.
+      auto maybeLock = a.getInputGate().tryWait();
+      KJ_IF_SOME(l, maybeLock) {
+        inputLock = kj::mv(l);
+      } else {
+        return a.getInputGate().wait()
+            .then([this,func=kj::fwd<Func>(func)](InputGate::Lock&& inputLock) mutable {
+          return run(kj::fwd<Func>(func), kj::mv(inputLock));
+        });
+      }
     }
 
-    asyncLockPromise = worker->takeAsyncLockWhenActorCacheReady(now(), a, getMetrics());
+    asyncLockPromise = worker->takeAsyncLockWhenActorCacheReady(
+        now(), a, getMetrics(), lockPriority);
   } else {
-    asyncLockPromise = worker->takeAsyncLock(getMetrics());
+    asyncLockPromise = worker->takeAsyncLock(getMetrics(), lockPriority);
   }
 
   return asyncLockPromise
@@ -41,6 +41,34 @@ KJ_TEST("InputGate basics") {
   KJ_EXPECT(!gate.onBroken().poll(ws));
 }
 
+KJ_TEST("InputGate tryWait fast path") {
+  kj::EventLoop loop;
+  kj::WaitScope ws(loop);
+
+  InputGate gate;
+
+  {
+    // Idle gate: tryWait() grants a lock synchronously.
+    auto maybeLock = gate.tryWait();
+    auto lock = kj::mv(KJ_ASSERT_NONNULL(maybeLock));
+
+    // While that lock exists, tryWait() refuses, and other waiters queue as usual.
+    KJ_EXPECT(gate.tryWait() == kj::none);
+    auto promise = gate.wait();
+    KJ_EXPECT(!promise.poll(ws));
+
+    { auto drop = kj::mv(lock); }
+
+    // The queued waiter gets the gate before tryWait() can take it again.
+    KJ_EXPECT(promise.poll(ws));
+    auto lock2 = promise.wait(ws);
+    KJ_EXPECT(gate.tryWait() == kj::none);
+  }
+
+  // Back to idle.
+  KJ_EXPECT(gate.tryWait() != kj::none);
+}
+
 KJ_TEST("InputGate critical section") {
   kj::EventLoop loop;
   kj::WaitScope ws(loop);
@@ -455,6 +483,54 @@ KJ_TEST("OutputGate out-of-order") {
   KJ_EXPECT(!gate.onBroken().poll(ws));
 }
 
+KJ_TEST("OutputGate commit epochs") {
+  kj::EventLoop loop;
+  kj::WaitScope ws(loop);
+
+  OutputGate gate;
+
+  KJ_EXPECT(gate.currentEpoch() == 0);
+  KJ_EXPECT(!gate.isCurrentlyLocked());
+
+  // Two overlapping locks form one epoch: waiters experience a single blocking window.
+  auto paf1 = kj::newPromiseAndFulfiller<void>();
+  auto blocker1 = gate.lockWhile(kj::mv(paf1.promise));
+  KJ_EXPECT(gate.isCurrentlyLocked());
+
+  auto paf2 = kj::newPromiseAndFulfiller<void>();
+  auto blocker2 = gate.lockWhile(kj::mv(paf2.promise));
+
+  paf1.fulfiller->fulfill();
+  blocker1.wait(ws);
+
+  // The second lock is still pending, so the epoch hasn't advanced yet.
+  KJ_EXPECT(gate.currentEpoch() == 0);
+  KJ_EXPECT(gate.isCurrentlyLocked());
+
+  paf2.fulfiller->fulfill();
+  blocker2.wait(ws);
+
+  KJ_EXPECT(gate.currentEpoch() == 1);
+  KJ_EXPECT(!gate.isCurrentlyLocked());
+
+  // A lock taken after the gate drained starts a new epoch.
+  auto paf3 = kj::newPromiseAndFulfiller<void>();
+  auto blocker3 = gate.lockWhile(kj::mv(paf3.promise));
+  paf3.fulfiller->fulfill();
+  blocker3.wait(ws);
+
+  KJ_EXPECT(gate.currentEpoch() == 2);
+
+  // Canceling a lock still closes its epoch (while breaking the gate).
+  {
+    auto paf4 = kj::newPromiseAndFulfiller<void>();
+    auto blocker4 = gate.lockWhile(kj::mv(paf4.promise));
+    KJ_EXPECT(gate.isCurrentlyLocked());
+  }
+  KJ_EXPECT(gate.currentEpoch() == 3);
+  KJ_EXPECT(!gate.isCurrentlyLocked());
+}
+
 KJ_TEST("OutputGate exception") {
   kj::EventLoop loop;
   kj::WaitScope ws(loop);
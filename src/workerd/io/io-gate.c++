@@ -4,9 +4,25 @@
 
 #include <workerd/io/io-gate.h>
 #include <kj/debug.h>
+#include <workerd/util/use-perfetto-categories.h>
+
+#include <atomic>
 
 namespace workerd {
 
+namespace {
+
+// Process-wide gauge backing the "inputGateWaiters" perfetto counter track. Input gates live on
+// many threads, so the counter is aggregated across all of them.
+std::atomic<int64_t> inputGateWaiterCount{0};
+
+void inputGateWaiterCountChanged(int64_t delta) {
+  int64_t value KJ_UNUSED = inputGateWaiterCount.fetch_add(delta, std::memory_order_relaxed) + delta;
+  TRACE_COUNTER("workerd", PERFETTO_COUNTER_TRACK("inputGateWaiters"), value);
+}
+
+}  // namespace
+
 InputGate::Hooks InputGate::Hooks::DEFAULT;
 
 InputGate::InputGate(Hooks& hooks): InputGate(hooks, kj::newPromiseAndFulfiller<void>()) {}
@@ -27,6 +43,7 @@ InputGate::Waiter::Waiter(
     kj::PromiseFulfiller<Lock>& fulfiller, InputGate& gate, bool isChildWaiter)
     : fulfiller(fulfiller), gate(&gate), isChildWaiter(isChildWaiter) {
   gate.hooks.inputGateWaiterAdded();
+  inputGateWaiterCountChanged(1);
   if (isChildWaiter) {
     gate.waitingChildren.add(*this);
   } else {
@@ -35,6 +52,7 @@ InputGate::Waiter::Waiter(
 }
 InputGate::Waiter::~Waiter() noexcept(false) {
   gate->hooks.inputGateWaiterRemoved();
+  inputGateWaiterCountChanged(-1);
   if (link.isLinked()) {
     if (isChildWaiter) {
       gate->waitingChildren.remove(*this);
@@ -54,6 +72,15 @@ kj::Promise<InputGate::Lock> InputGate::wait() {
   }
 }
 
+kj::Maybe<InputGate::Lock> InputGate::tryWait() {
+  KJ_DASSERT(!isCriticalSection);
+
+  if (brokenState.is<kj::Exception>() || lockCount > 0) {
+    return kj::none;
+  }
+  return Lock(*this);
+}
+
 kj::Promise<void> InputGate::onBroken() {
   KJ_IF_SOME(e, brokenState.tryGet<kj::Exception>()) {
     return kj::cp(e);
@@ -312,9 +339,19 @@ kj::Own<kj::PromiseFulfiller<void>> OutputGate::lock() {
   auto paf = kj::newPromiseAndFulfiller<void>();
   auto joined = kj::joinPromises(kj::arr(pastLocksPromise.addBranch(), kj::mv(paf.promise)));
   pastLocksPromise = joined.fork();
+  ++activeLockCount;
   return kj::mv(paf.fulfiller);
 }
 
+void OutputGate::noteLockReleased() {
+  KJ_ASSERT(activeLockCount > 0);
+  if (--activeLockCount == 0) {
+    // The gate has fully drained; any lock taken after this point starts a new blocking window
+    // for waiters.
+    ++epoch;
+  }
+}
+
 kj::Promise<void> OutputGate::wait() {
   hooks.outputGateWaiterAdded();
   return pastLocksPromise.addBranch().attach(kj::defer([this]() {
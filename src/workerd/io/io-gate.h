@@ -99,6 +99,15 @@ public:
   // Wait until there are no `Lock`s, then create a new one and return it.
   kj::Promise<Lock> wait();
 
+  // If no `Lock`s currently exist, create one and return it synchronously. Returns none if the
+  // gate is locked or broken, in which case the caller must fall back to wait(). This exists so
+  // that the common case -- delivering an event to an actor whose gate is idle -- doesn't pay for
+  // a promise allocation and a turn of the event loop.
+  //
+  // Note that this must be called on the top-level gate, not on a CriticalSection; unlike wait(),
+  // it is not overridden to wait for the critical section to start.
+  kj::Maybe<Lock> tryWait();
+
   // Rejects if and when calls to `wait()` become broken due to a failed critical section. The
   // actor should be shut down in this case. This promise never resolves, only rejects.
   kj::Promise<void> onBroken();
@@ -259,17 +268,32 @@ public:
 
   bool isBroken();
 
+  // Identifies the current commit epoch. The epoch advances each time the gate transitions from
+  // locked back to fully unlocked, i.e. when the last overlapping lockWhile() resolves. All
+  // lockWhile() calls made within one epoch overlap, so waiters observe them as a single
+  // blocking window; a new epoch means waiters paid for another full gate cycle. ActorCache
+  // uses this to verify that a burst of writes shared one commit rather than queuing several.
+  uint64_t currentEpoch() const { return epoch; }
+
+  // True if at least one lockWhile() promise is still pending.
+  bool isCurrentlyLocked() const { return activeLockCount > 0; }
+
 private:
   Hooks& hooks;
 
   kj::ForkedPromise<void> pastLocksPromise;
 
+  // See currentEpoch() / isCurrentlyLocked().
+  uint64_t epoch = 0;
+  uint activeLockCount = 0;
+
   // A fulfiller for onBroken(), or an exception if already broken.
   kj::OneOf<kj::Own<kj::PromiseFulfiller<void>>, kj::Exception> brokenState;
 
   void setBroken(const kj::Exception& e);
 
   kj::Own<kj::PromiseFulfiller<void>> lock();
+  void noteLockReleased();
   static kj::Exception makeUnfulfilledException();
 };
 
@@ -290,6 +314,7 @@ kj::Promise<T> OutputGate::lockWhile(kj::Promise<T> promise) {
   hooks.outputGateLocked();
   auto rejectIfCanceled = kj::defer([this, &fulfiller](){
     hooks.outputGateReleased();
+    noteLockReleased();
     if (fulfiller->isWaiting()) {
       auto e = makeUnfulfilledException();
       setBroken(e);
@@ -43,6 +43,30 @@ void DeleteQueue::checkWeakGet(workerd::WeakRef<IoContext>& weak) {
   }
 }
 
+void* OwnedObjectSlabAllocator::allocateNode() {
+  if (freelist == nullptr) {
+    auto slab = kj::heapArray<kj::byte>(NODE_SIZE * NODES_PER_SLAB);
+    // Thread the fresh slab onto the free list back-to-front so nodes are handed out in address
+    // order.
+    for (size_t i = NODES_PER_SLAB; i > 0; i--) {
+      auto node = reinterpret_cast<FreeNode*>(slab.begin() + (i - 1) * NODE_SIZE);
+      node->next = freelist;
+      freelist = node;
+    }
+    slabs.add(kj::mv(slab));
+  }
+
+  auto node = freelist;
+  freelist = node->next;
+  return node;
+}
+
+void OwnedObjectSlabAllocator::freeNode(void* pointer) {
+  auto node = reinterpret_cast<FreeNode*>(pointer);
+  node->next = freelist;
+  freelist = node;
+}
+
 OwnedObjectList::~OwnedObjectList() noexcept(false) {
   while (head != kj::none) {
     // We want to have the same order of operations as the recursive destructor here. Without this
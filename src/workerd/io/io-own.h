@@ -66,10 +66,15 @@ private:
   friend class OwnedObjectList;
 };
 
+class OwnedObjectSlabAllocator;
+
 struct OwnedObject {
   kj::Maybe<kj::Own<OwnedObject>> next;
   kj::Maybe<kj::Own<OwnedObject>>* prev;
   kj::Maybe<Finalizeable&> finalizer;
+
+  // The allocator this node was drawn from, so the disposer can return the memory to it.
+  OwnedObjectSlabAllocator* slab = nullptr;
 };
 
 template <typename T>
@@ -78,12 +83,89 @@ struct SpecificOwnedObject: public OwnedObject {
   kj::Own<T> ptr;
 };
 
+// Allocates the fixed-size SpecificOwnedObject<T> nodes that every addObject() call creates.
+// Nodes are carved out of slabs owned by the allocator and recycled through a free list when
+// individually deleted, so steady-state IoOwn churn stops hitting the global heap entirely; the
+// slabs themselves are released wholesale when the allocator -- and thus the OwnedObjectList that
+// owns it -- is destroyed. Memory retained is bounded by the peak number of live nodes.
+//
+// No synchronization is needed: nodes are allocated on the IoContext's thread, and deletion also
+// always happens there (cross-thread IoOwn drops are queued on the DeleteQueue and processed by
+// the owning thread).
+class OwnedObjectSlabAllocator {
+public:
+  OwnedObjectSlabAllocator() = default;
+  KJ_DISALLOW_COPY_AND_MOVE(OwnedObjectSlabAllocator);
+
+  template <typename T>
+  kj::Own<OwnedObject> allocate(kj::Own<T> obj);
+
+private:
+  // Every SpecificOwnedObject<T> has the same layout regardless of T: the OwnedObject base plus
+  // a kj::Own<T>, which is always a disposer pointer and an object pointer. This stand-in gives
+  // us that common size and alignment; allocate() static_asserts the assumption per T.
+  struct CanonicalNode: public OwnedObject {
+    kj::Own<OwnedObject> ptr;
+  };
+  static constexpr size_t NODE_SIZE = sizeof(CanonicalNode);
+  static constexpr size_t NODE_ALIGN = alignof(CanonicalNode);
+  static constexpr size_t NODES_PER_SLAB = 64;
+
+  struct FreeNode {
+    FreeNode* next;
+  };
+
+  FreeNode* freelist = nullptr;
+  kj::Vector<kj::Array<kj::byte>> slabs;
+
+  void* allocateNode();
+  void freeNode(void* pointer);
+
+  template <typename T>
+  class DisposerImpl;
+};
+
+template <typename T>
+class OwnedObjectSlabAllocator::DisposerImpl final: public kj::Disposer {
+public:
+  static const DisposerImpl instance;
+
+  void disposeImpl(void* pointer) const override {
+    // Like kj::_::HeapDisposer in addObjectImpl()'s HACK comment, we rely on single inheritance
+    // making OwnedObject* and SpecificOwnedObject<T>* numerically equal.
+    auto node = reinterpret_cast<SpecificOwnedObject<T>*>(pointer);
+    KJ_DASSERT(node->slab != nullptr);
+    auto& allocator = *node->slab;
+    kj::dtor(*node);
+    allocator.freeNode(pointer);
+  }
+};
+
+template <typename T>
+const OwnedObjectSlabAllocator::DisposerImpl<T>
+    OwnedObjectSlabAllocator::DisposerImpl<T>::instance = DisposerImpl<T>();
+
+template <typename T>
+kj::Own<OwnedObject> OwnedObjectSlabAllocator::allocate(kj::Own<T> obj) {
+  static_assert(sizeof(SpecificOwnedObject<T>) == NODE_SIZE &&
+                alignof(SpecificOwnedObject<T>) == NODE_ALIGN,
+      "SpecificOwnedObject<T> layout unexpectedly varies by T");
+  auto node = reinterpret_cast<SpecificOwnedObject<T>*>(allocateNode());
+  kj::ctor(*node, kj::mv(obj));
+  node->slab = this;
+  return kj::Own<OwnedObject>(node, DisposerImpl<T>::instance);
+}
+
 class OwnedObjectList {
 public:
   OwnedObjectList() = default;
   KJ_DISALLOW_COPY_AND_MOVE(OwnedObjectList);
   ~OwnedObjectList() noexcept(false);
 
+  OwnedObjectSlabAllocator& getSlabAllocator() {
+    return slabAllocator;
+  }
+
   void link(kj::Own<OwnedObject> object);
   static void unlink(OwnedObject& object);
 
@@ -96,6 +178,10 @@ public:
   }
 
 private:
+  // Declared before `head` so the nodes (which return their memory to the allocator on
+  // destruction) are destroyed first even if the destructor body changes.
+  OwnedObjectSlabAllocator slabAllocator;
+
   kj::Maybe<kj::Own<OwnedObject>> head;
 
   bool finalizersRan = false;
@@ -144,13 +230,10 @@ inline SpecificOwnedObject<T>* DeleteQueue::addObjectImpl(
   //   to upcast kj::Own<SpecificOwnedObject<T>> to kj::Own<OwnedObject> since it can't guarantee
   //   the disposers are compatible. However, since we're only using single inheritance here, the
   //   disposers *are* compatible (the numeric value of pointers to SpecificOwnedObject<T> and
-  //   its parent OwnedObject are equal). So, instead of forcing OwnedObject to be polymorphic
-  //   (which would have forced a bunch of useless vtables and vtable pointers)... I'm manually
-  //   constructing the kj::Own<> using a disposer that I know is compatible.
+  //   its parent OwnedObject are equal). So, the slab allocator manually constructs the kj::Own<>
+  //   using a disposer that we know is compatible.
   // TODO(cleanup): Can KJ be made to support this use case?
-  kj::Own<OwnedObject> ownedObject(
-      new SpecificOwnedObject<T>(kj::mv(obj)),
-      kj::_::HeapDisposer<SpecificOwnedObject<T>>::instance);
+  kj::Own<OwnedObject> ownedObject = ownedObjects.getSlabAllocator().allocate<T>(kj::mv(obj));
 
   if constexpr (kj::canConvert<T&, Finalizeable&>()) {
     ownedObject->finalizer = ref;
@@ -13,6 +13,7 @@
 #include <workerd/io/trace.h>
 #include <workerd/io/features.capnp.h>
 #include <workerd/jsg/observer.h>
+#include <workerd/util/hot-metrics.h>
 
 namespace workerd {
 
@@ -87,6 +88,8 @@ public:
   virtual void finishedContextTask() {}
   virtual void addedWaitUntilTask() {}
   virtual void finishedWaitUntilTask() {}
+  virtual void addedBestEffortWaitUntilTask() {}
+  virtual void finishedBestEffortWaitUntilTask() {}
 
   virtual void setFailedOpen(bool value) {}
 
@@ -183,8 +186,19 @@ public:
     }
     KJ_DISALLOW_COPY_AND_MOVE(LockRecord);
 
-    void locked() { KJ_IF_SOME(l, lockTiming) l.get()->locked(); }
-    void gcPrologue() { KJ_IF_SOME(l, lockTiming) l.get()->gcPrologue(); }
+    // In addition to forwarding to `lockTiming`, these maintain always-on process-wide counters
+    // (see util/hot-metrics.h) so that lock and GC activity is visible even when no LockTiming
+    // implementation is attached, which is the common case in production.
+    void locked() {
+      static HotCounter counter("workerd_isolate_lock_acquisitions");
+      counter.add();
+      KJ_IF_SOME(l, lockTiming) l.get()->locked();
+    }
+    void gcPrologue() {
+      static HotCounter counter("workerd_isolate_gc_passes");
+      counter.add();
+      KJ_IF_SOME(l, lockTiming) l.get()->gcPrologue();
+    }
     void gcEpilogue() { KJ_IF_SOME(l, lockTiming) l.get()->gcEpilogue(); }
 
   private:
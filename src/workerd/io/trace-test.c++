@@ -0,0 +1,166 @@
+// Copyright (c) 2024 Cloudflare, Inc.
+// Licensed under the Apache 2.0 license found in the LICENSE file or at:
+//     https://opensource.org/licenses/Apache-2.0
+
+#include "trace.h"
+#include <capnp/message.h>
+#include <kj/test.h>
+
+namespace workerd {
+namespace {
+
+kj::Own<Trace> makeTrace(kj::StringPtr scriptName) {
+  return kj::refcounted<Trace>(kj::none, kj::str(scriptName), kj::none, kj::none, kj::none,
+                               nullptr, kj::none);
+}
+
+KJ_TEST("TraceBatchQueue batches buffered traces into one pull") {
+  kj::EventLoop loop;
+  kj::WaitScope ws(loop);
+
+  auto queue = kj::refcounted<TraceBatchQueue>(8, 4);
+
+  auto batchPromise = queue->pullBatch();
+  KJ_EXPECT(!batchPromise.poll(ws));
+
+  queue->push(makeTrace("a"));
+  queue->push(makeTrace("b"));
+  queue->push(makeTrace("c"));
+
+  KJ_ASSERT(batchPromise.poll(ws));
+  auto batch = batchPromise.wait(ws);
+  KJ_EXPECT(batch.size() == 3);
+  KJ_EXPECT(KJ_ASSERT_NONNULL(batch[0]->scriptName) == "a");
+  KJ_EXPECT(KJ_ASSERT_NONNULL(batch[2]->scriptName) == "c");
+  KJ_EXPECT(queue->getAndResetDroppedCount() == 0);
+}
+
+KJ_TEST("TraceBatchQueue limits batch size and preserves the remainder") {
+  kj::EventLoop loop;
+  kj::WaitScope ws(loop);
+
+  auto queue = kj::refcounted<TraceBatchQueue>(8, 2);
+
+  queue->push(makeTrace("a"));
+  queue->push(makeTrace("b"));
+  queue->push(makeTrace("c"));
+
+  auto first = queue->pullBatch().wait(ws);
+  KJ_EXPECT(first.size() == 2);
+  KJ_EXPECT(KJ_ASSERT_NONNULL(first[0]->scriptName) == "a");
+
+  auto second = queue->pullBatch().wait(ws);
+  KJ_EXPECT(second.size() == 1);
+  KJ_EXPECT(KJ_ASSERT_NONNULL(second[0]->scriptName) == "c");
+}
+
+KJ_TEST("TraceBatchQueue drops oldest traces when full") {
+  kj::EventLoop loop;
+  kj::WaitScope ws(loop);
+
+  auto queue = kj::refcounted<TraceBatchQueue>(2, 4);
+
+  queue->push(makeTrace("a"));
+  queue->push(makeTrace("b"));
+  queue->push(makeTrace("c"));  // overwrites "a"
+
+  KJ_EXPECT(queue->getAndResetDroppedCount() == 1);
+  KJ_EXPECT(queue->getAndResetDroppedCount() == 0);
+
+  auto batch = queue->pullBatch().wait(ws);
+  KJ_EXPECT(batch.size() == 2);
+  KJ_EXPECT(KJ_ASSERT_NONNULL(batch[0]->scriptName) == "b");
+  KJ_EXPECT(KJ_ASSERT_NONNULL(batch[1]->scriptName) == "c");
+}
+
+KJ_TEST("TraceBatchQueue pull can be canceled and retried") {
+  kj::EventLoop loop;
+  kj::WaitScope ws(loop);
+
+  auto queue = kj::refcounted<TraceBatchQueue>(8, 4);
+
+  {
+    auto canceled = queue->pullBatch();
+    KJ_EXPECT(!canceled.poll(ws));
+    // dropped here
+  }
+
+  queue->push(makeTrace("a"));
+  auto batch = queue->pullBatch().wait(ws);
+  KJ_EXPECT(batch.size() == 1);
+}
+
+KJ_TEST("PipelineTracer delivers completed traces to a batch queue") {
+  kj::EventLoop loop;
+  kj::WaitScope ws(loop);
+
+  auto queue = kj::refcounted<TraceBatchQueue>(8, 4);
+
+  for (auto name: {"one"_kj, "two"_kj}) {
+    auto pipeline = kj::refcounted<PipelineTracer>();
+    pipeline->deliverToBatchQueue(kj::addRef(*queue));
+    auto tracer = pipeline->makeWorkerTracer(PipelineLogLevel::FULL, kj::none, kj::none,
+        kj::str(name), kj::none, kj::none, nullptr, kj::none);
+    // Dropping the tracer and pipeline completes the trace.
+  }
+
+  auto batch = queue->pullBatch().wait(ws);
+  KJ_EXPECT(batch.size() == 2);
+  KJ_EXPECT(KJ_ASSERT_NONNULL(batch[0]->scriptName) == "one");
+  KJ_EXPECT(KJ_ASSERT_NONNULL(batch[1]->scriptName) == "two");
+}
+
+KJ_TEST("TraceSamplingPolicy drops logs for unsampled requests") {
+  auto tracer = kj::refcounted<WorkerTracer>(PipelineLogLevel::FULL,
+      TraceSamplingPolicy{.sampleRate = 0.0, .captureErrors = false});
+
+  tracer->log(kj::UNIX_EPOCH, LogLevel::INFO, kj::str("hello"));
+  tracer->addException(kj::UNIX_EPOCH, kj::str("Error"), kj::str("boom"), kj::none);
+
+  capnp::MallocMessageBuilder message;
+  auto builder = message.initRoot<rpc::Trace>();
+  tracer->extractTrace(builder);
+  KJ_EXPECT(builder.asReader().getLogs().size() == 0);
+  KJ_EXPECT(builder.asReader().getExceptions().size() == 0);
+}
+
+KJ_TEST("TraceSamplingPolicy escalates on exception and retains recent logs") {
+  auto tracer = kj::refcounted<WorkerTracer>(PipelineLogLevel::FULL,
+      TraceSamplingPolicy{.sampleRate = 0.0});
+
+  // More lines than the retention ring holds; only the most recent survive escalation.
+  for (auto i = 0; i < 20; i++) {
+    tracer->log(kj::UNIX_EPOCH, LogLevel::INFO, kj::str("line ", i));
+  }
+  tracer->addException(kj::UNIX_EPOCH, kj::str("Error"), kj::str("boom"), kj::none);
+  tracer->log(kj::UNIX_EPOCH, LogLevel::INFO, kj::str("after"));
+
+  capnp::MallocMessageBuilder message;
+  auto builder = message.initRoot<rpc::Trace>();
+  tracer->extractTrace(builder);
+  auto logs = builder.asReader().getLogs();
+  KJ_ASSERT(logs.size() == 17);  // 16 retained + 1 recorded after escalation
+  KJ_EXPECT(logs[0].getMessage() == "line 4");  // lines 0-3 were evicted from the ring
+  KJ_EXPECT(logs[15].getMessage() == "line 19");
+  KJ_EXPECT(logs[16].getMessage() == "after");
+  KJ_ASSERT(builder.asReader().getExceptions().size() == 1);
+  KJ_EXPECT(builder.asReader().getExceptions()[0].getMessage() == "boom");
+}
+
+KJ_TEST("TraceSamplingPolicy escalates on slow wall time") {
+  auto tracer = kj::refcounted<WorkerTracer>(PipelineLogLevel::FULL,
+      TraceSamplingPolicy{.sampleRate = 0.0, .latencyThreshold = 100 * kj::MILLISECONDS});
+
+  tracer->log(kj::UNIX_EPOCH, LogLevel::INFO, kj::str("slow request log"));
+  tracer->setWallTime(250 * kj::MILLISECONDS);
+
+  capnp::MallocMessageBuilder message;
+  auto builder = message.initRoot<rpc::Trace>();
+  tracer->extractTrace(builder);
+  auto logs = builder.asReader().getLogs();
+  KJ_ASSERT(logs.size() == 1);
+  KJ_EXPECT(logs[0].getMessage() == "slow request log");
+}
+
+}  // namespace
+}  // namespace workerd
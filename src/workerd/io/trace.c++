@@ -7,6 +7,7 @@
 #include <capnp/schema.h>
 #include <kj/debug.h>
 #include <cstdlib>
+#include <random>
 
 namespace workerd {
 
@@ -525,17 +526,78 @@ void SpanBuilder::addLog(kj::Date timestamp, kj::ConstString key, TagValue value
   }
 }
 
+TraceBatchQueue::TraceBatchQueue(size_t capacity, size_t maxBatchSize)
+    : maxBatchSize(maxBatchSize), slots(kj::heapArray<kj::Own<Trace>>(capacity)) {
+  KJ_REQUIRE(capacity > 0);
+  KJ_REQUIRE(maxBatchSize > 0);
+}
+
+void TraceBatchQueue::push(kj::Own<Trace> trace) {
+  if (count == slots.size()) {
+    // Full; overwrite the oldest buffered trace. We prefer dropping old traces over unbounded
+    // memory growth when the consumer falls behind.
+    slots[head] = kj::mv(trace);
+    head = (head + 1) % slots.size();
+    ++dropped;
+  } else {
+    slots[(head + count) % slots.size()] = kj::mv(trace);
+    ++count;
+  }
+
+  KJ_IF_SOME(w, waiter) {
+    w->fulfill();
+    waiter = kj::none;
+  }
+}
+
+kj::Promise<kj::Array<kj::Own<Trace>>> TraceBatchQueue::pullBatch() {
+  KJ_REQUIRE(waiter == kj::none, "only one pullBatch() may be outstanding at a time");
+
+  if (count == 0) {
+    auto paf = kj::newPromiseAndFulfiller<void>();
+    waiter = kj::mv(paf.fulfiller);
+    // If the pull is canceled while waiting, clear the waiter so a later pullBatch() can start
+    // over.
+    KJ_DEFER(waiter = kj::none);
+    co_await paf.promise;
+  }
+
+  auto n = kj::min(count, maxBatchSize);
+  auto builder = kj::heapArrayBuilder<kj::Own<Trace>>(n);
+  for (size_t i = 0; i < n; ++i) {
+    builder.add(kj::mv(slots[head]));
+    head = (head + 1) % slots.size();
+  }
+  count -= n;
+  co_return builder.finish();
+}
+
+size_t TraceBatchQueue::getAndResetDroppedCount() {
+  size_t result = dropped;
+  dropped = 0;
+  return result;
+}
+
 PipelineTracer::~PipelineTracer() noexcept(false) {
   KJ_IF_SOME(p, parentTracer) {
     for (auto& t: traces) {
       p->traces.add(kj::addRef(*t));
     }
   }
+  KJ_IF_SOME(q, batchQueue) {
+    for (auto& t: traces) {
+      q->push(kj::addRef(*t));
+    }
+  }
   KJ_IF_SOME(f, completeFulfiller) {
     f.get()->fulfill(traces.releaseAsArray());
   }
 }
 
+void PipelineTracer::deliverToBatchQueue(kj::Own<TraceBatchQueue> queue) {
+  batchQueue = kj::mv(queue);
+}
+
 kj::Promise<kj::Array<kj::Own<Trace>>> PipelineTracer::onComplete() {
   KJ_REQUIRE(completeFulfiller == kj::none, "onComplete() can only be called once");
 
@@ -548,20 +610,57 @@ kj::Own<WorkerTracer> PipelineTracer::makeWorkerTracer(
     PipelineLogLevel pipelineLogLevel, kj::Maybe<kj::String> scriptId, kj::Maybe<kj::String> stableId,
     kj::Maybe<kj::String> scriptName, kj::Maybe<kj::Own<ScriptVersion::Reader>> scriptVersion,
     kj::Maybe<kj::String> dispatchNamespace, kj::Array<kj::String> scriptTags,
-    kj::Maybe<kj::String> entrypoint) {
+    kj::Maybe<kj::String> entrypoint, TraceSamplingPolicy samplingPolicy) {
   auto trace = kj::refcounted<Trace>(kj::mv(stableId), kj::mv(scriptName), kj::mv(scriptVersion),
       kj::mv(dispatchNamespace), kj::mv(scriptId), kj::mv(scriptTags), kj::mv(entrypoint));
   traces.add(kj::addRef(*trace));
-  return kj::refcounted<WorkerTracer>(kj::addRef(*this), kj::mv(trace), pipelineLogLevel);
+  return kj::refcounted<WorkerTracer>(kj::addRef(*this), kj::mv(trace), pipelineLogLevel,
+      samplingPolicy);
+}
+
+namespace {
+
+// How many log lines an unsampled request retains for retroactive capture. Intentionally small:
+// the point of sampling out a request is to keep its cost near zero.
+constexpr size_t RECENT_LOG_RING_CAPACITY = 16;
+
+// Per-request head-sampling decision. Trace timing is coarsened for Spectre, so a thread-local
+// engine here is not observable from JS; seeding follows AlarmScheduler's jitter engine.
+bool decideSampled(const TraceSamplingPolicy& policy) {
+  if (policy.samplesEverything()) return true;
+  if (policy.sampleRate <= 0.0) return false;
+  static thread_local std::default_random_engine random(
+      (kj::systemPreciseMonotonicClock().now() - kj::origin<kj::TimePoint>()) / kj::NANOSECONDS);
+  return std::uniform_real_distribution<double>(0.0, 1.0)(random) < policy.sampleRate;
 }
 
+}  // namespace
+
 WorkerTracer::WorkerTracer(kj::Own<PipelineTracer> parentPipeline,
-      kj::Own<Trace> trace, PipelineLogLevel pipelineLogLevel)
-    : pipelineLogLevel(pipelineLogLevel), trace(kj::mv(trace)),
+      kj::Own<Trace> trace, PipelineLogLevel pipelineLogLevel,
+      TraceSamplingPolicy samplingPolicy)
+    : pipelineLogLevel(pipelineLogLevel), samplingPolicy(samplingPolicy), trace(kj::mv(trace)),
+      sampled(decideSampled(samplingPolicy)),
       parentPipeline(kj::mv(parentPipeline)) {}
-WorkerTracer::WorkerTracer(PipelineLogLevel pipelineLogLevel)
-    : pipelineLogLevel(pipelineLogLevel),
-      trace(kj::refcounted<Trace>(kj::none, kj::none, kj::none, kj::none, kj::none, nullptr, kj::none)) {}
+WorkerTracer::WorkerTracer(PipelineLogLevel pipelineLogLevel, TraceSamplingPolicy samplingPolicy)
+    : pipelineLogLevel(pipelineLogLevel), samplingPolicy(samplingPolicy),
+      trace(kj::refcounted<Trace>(kj::none, kj::none, kj::none, kj::none, kj::none, nullptr, kj::none)),
+      sampled(decideSampled(samplingPolicy)) {}
+
+void WorkerTracer::escalate() {
+  if (sampled) return;
+  sampled = true;
+
+  // Flush the retained ring in arrival order. The eager log() overload now records normally and
+  // applies the usual size accounting.
+  size_t count = recentLogs.size();
+  for (size_t i = 0; i < count; i++) {
+    auto& entry = recentLogs[(recentLogsHead + i) % count];
+    log(entry.timestamp, entry.logLevel, kj::mv(entry.message));
+  }
+  recentLogs.clear();
+  recentLogsHead = 0;
+}
 
 void WorkerTracer::log(kj::Date timestamp, LogLevel logLevel, kj::String message) {
   if (trace->exceededLogLimit) {
@@ -570,6 +669,20 @@ void WorkerTracer::log(kj::Date timestamp, LogLevel logLevel, kj::String message
   if (pipelineLogLevel == PipelineLogLevel::NONE) {
     return;
   }
+  if (!sampled) {
+    // Retain the line in the ring in case this request later escalates to full capture.
+    if (recentLogs.size() < RECENT_LOG_RING_CAPACITY) {
+      recentLogs.add(timestamp, logLevel, kj::mv(message));
+    } else {
+      // Trace::Log has no move-assignment, so overwrite the slot field by field.
+      auto& slot = recentLogs[recentLogsHead];
+      slot.timestamp = timestamp;
+      slot.logLevel = logLevel;
+      slot.message = kj::mv(message);
+      recentLogsHead = (recentLogsHead + 1) % RECENT_LOG_RING_CAPACITY;
+    }
+    return;
+  }
   size_t newSize = trace->bytesUsed + sizeof(Trace::Log) + message.size();
   if (newSize > MAX_TRACE_BYTES) {
     trace->exceededLogLimit = true;
@@ -584,6 +697,16 @@ void WorkerTracer::log(kj::Date timestamp, LogLevel logLevel, kj::String message
   trace->logs.add(timestamp, logLevel, kj::mv(message));
 }
 
+void WorkerTracer::log(kj::Date timestamp, LogLevel logLevel,
+                       kj::FunctionParam<kj::String()> buildMessage) {
+  // Mirror the early-outs of the eager overload so the message is never materialized for a
+  // trace that would drop it; the eager overload then handles size accounting as usual.
+  if (trace->exceededLogLimit || pipelineLogLevel == PipelineLogLevel::NONE) {
+    return;
+  }
+  log(timestamp, logLevel, buildMessage());
+}
+
 void WorkerTracer::addException(kj::Date timestamp, kj::String name, kj::String message,
                                 kj::Maybe<kj::String> stack) {
   if (trace->exceededExceptionLimit) {
@@ -595,6 +718,14 @@ void WorkerTracer::addException(kj::Date timestamp, kj::String name, kj::String
   if (pipelineLogLevel == PipelineLogLevel::NONE) {
     return;
   }
+  if (!sampled) {
+    if (!samplingPolicy.captureErrors) {
+      return;
+    }
+    // An error makes this request interesting: switch to full capture, retroactively including
+    // the retained log ring.
+    escalate();
+  }
   size_t newSize = trace->bytesUsed + sizeof(Trace::Exception) + name.size() + message.size();
   KJ_IF_SOME(s, stack) {
     newSize += s.size();
@@ -621,6 +752,9 @@ void WorkerTracer::addDiagnosticChannelEvent(kj::Date timestamp,
   if (pipelineLogLevel == PipelineLogLevel::NONE) {
     return;
   }
+  if (!sampled) {
+    return;
+  }
   size_t newSize = trace->bytesUsed + sizeof(Trace::DiagnosticChannelEvent) + channel.size() +
                    message.size();
   if (newSize > MAX_TRACE_BYTES) {
@@ -688,6 +822,13 @@ void WorkerTracer::setCPUTime(kj::Duration cpuTime) {
 
 void WorkerTracer::setWallTime(kj::Duration wallTime) {
   trace->wallTime = wallTime;
+  if (!sampled && samplingPolicy.latencyThreshold > 0 * kj::MILLISECONDS &&
+      wallTime >= samplingPolicy.latencyThreshold) {
+    // A slow request is interesting even if it was sampled out; capture what the log ring
+    // retained. Anything evicted from the ring earlier in the request is gone, which is the
+    // cost of not recording unsampled requests in full.
+    escalate();
+  }
 }
 
 void WorkerTracer::setFetchResponseInfo(Trace::FetchResponseInfo&& info) {
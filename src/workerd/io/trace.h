@@ -5,6 +5,7 @@
 #pragma once
 
 #include <kj/async.h>
+#include <kj/function.h>
 #include <kj/one-of.h>
 #include <kj/refcount.h>
 #include <kj/string.h>
@@ -34,6 +35,29 @@ enum class PipelineLogLevel {
   NONE, FULL
 };
 
+// Head-based sampling configuration for a worker stage's trace. The pipeline log level is an
+// all-or-nothing switch; this allows capturing only an interesting subset of requests while
+// keeping near-zero trace cost on the rest. The default policy records everything, matching the
+// previous behavior.
+struct TraceSamplingPolicy {
+  // Fraction [0, 1] of requests whose trace is recorded unconditionally. The decision is made
+  // once per request, when the tracer is created.
+  double sampleRate = 1.0;
+
+  // When a request falls outside the sampled fraction, escalate to full capture if it records an
+  // exception. Escalation is retroactive for logs: the tracer keeps a small ring of the most
+  // recent log lines while unsampled and flushes it into the trace at escalation time.
+  bool captureErrors = true;
+
+  // Also escalate (at completion, when wall time becomes known) if the request took at least this
+  // long. Zero disables the latency trigger.
+  kj::Duration latencyThreshold = 0 * kj::MILLISECONDS;
+
+  bool samplesEverything() const {
+    return sampleRate >= 1.0;
+  }
+};
+
 // TODO(someday): See if we can merge similar code concepts...  Trace fills a role similar to
 // MetricsCollector::Reporter::StageEvent, and Tracer fills a role similar to
 // MetricsCollector::Request.  Currently, the major differences are:
@@ -312,6 +336,47 @@ public:
 
 // =======================================================================================
 
+// A bounded queue that aggregates completed traces across many pipelines so they can be delivered
+// to a tail worker in consolidated batches rather than one invocation per traced request.
+//
+// Producers attach the queue to a PipelineTracer (see deliverToBatchQueue()); the pipeline's
+// traces are pushed when tracing completes. Completion happens in destructors and so can't block,
+// which is why the queue is a ring buffer: once `capacity` traces are buffered, pushing another
+// drops the oldest and counts it. The consumer repeatedly calls pullBatch(), which waits until at
+// least one trace is buffered and then drains up to `maxBatchSize` in completion order. This
+// provides natural backpressure -- while a tail invocation is in flight, further traces simply
+// accumulate into the next batch instead of triggering more invocations.
+class TraceBatchQueue final: public kj::Refcounted {
+public:
+  explicit TraceBatchQueue(size_t capacity, size_t maxBatchSize);
+  KJ_DISALLOW_COPY_AND_MOVE(TraceBatchQueue);
+
+  void push(kj::Own<Trace> trace);
+
+  // Waits until at least one trace is buffered, then returns up to `maxBatchSize` of them. Only
+  // one pullBatch() may be outstanding at a time, and the caller must keep the queue alive until
+  // the returned promise settles or is canceled.
+  kj::Promise<kj::Array<kj::Own<Trace>>> pullBatch();
+
+  // Returns the number of traces dropped due to a full buffer since the last call, resetting the
+  // counter.
+  size_t getAndResetDroppedCount();
+
+private:
+  size_t maxBatchSize;
+
+  // Fixed ring storage; `head` indexes the oldest buffered trace and `count` is the number
+  // currently buffered.
+  kj::Array<kj::Own<Trace>> slots;
+  size_t head = 0;
+  size_t count = 0;
+
+  size_t dropped = 0;
+
+  // Present while a pullBatch() is waiting for the first trace to arrive.
+  kj::Maybe<kj::Own<kj::PromiseFulfiller<void>>> waiter;
+};
+
 class WorkerTracer;
 
 // A tracer which records traces for a set of stages. All traces for a pipeline's stages and
@@ -342,13 +407,21 @@ public:
                                          kj::Maybe<kj::Own<ScriptVersion::Reader>> scriptVersion,
                                          kj::Maybe<kj::String> dispatchNamespace,
                                          kj::Array<kj::String> scriptTags,
-                                         kj::Maybe<kj::String> entrypoint);
+                                         kj::Maybe<kj::String> entrypoint,
+                                         TraceSamplingPolicy samplingPolicy = {});
   // Makes a tracer for a worker stage.
 
+  // Arranges for this pipeline's traces to be pushed into `queue` when tracing completes, in
+  // addition to fulfilling any onComplete() promise. Many pipelines may share one queue; this is
+  // how traces are batched across requests.
+  void deliverToBatchQueue(kj::Own<TraceBatchQueue> queue);
+
 private:
   kj::Vector<kj::Own<Trace>> traces;
   kj::Maybe<kj::Own<kj::PromiseFulfiller<kj::Array<kj::Own<Trace>>>>> completeFulfiller;
 
+  kj::Maybe<kj::Own<TraceBatchQueue>> batchQueue;
+
   kj::Maybe<kj::Own<PipelineTracer>> parentTracer;
 
   friend class WorkerTracer;
@@ -361,13 +434,21 @@ private:
 class WorkerTracer final : public kj::Refcounted {
 public:
   explicit WorkerTracer(kj::Own<PipelineTracer> parentPipeline,
-      kj::Own<Trace> trace, PipelineLogLevel pipelineLogLevel);
-  explicit WorkerTracer(PipelineLogLevel pipelineLogLevel);
+      kj::Own<Trace> trace, PipelineLogLevel pipelineLogLevel,
+      TraceSamplingPolicy samplingPolicy = {});
+  explicit WorkerTracer(PipelineLogLevel pipelineLogLevel,
+      TraceSamplingPolicy samplingPolicy = {});
   KJ_DISALLOW_COPY_AND_MOVE(WorkerTracer);
 
   // Adds log line to trace.  For Spectre, timestamp should only be as accurate as JS Date.now().
   void log(kj::Date timestamp, LogLevel logLevel, kj::String message);
 
+  // Like log(), but only builds the message if the trace is actually recording logs -- i.e.
+  // the pipeline log level keeps them and the size cap hasn't been hit yet. Callers whose
+  // message is expensive to materialize (JSON-encoding console.log() arguments, say) should
+  // prefer this overload: when the trace is dropping logs anyway, nothing is allocated.
+  void log(kj::Date timestamp, LogLevel logLevel, kj::FunctionParam<kj::String()> buildMessage);
+
   // TODO(soon): Eventually:
   //void setMetrics(...) // Or get from MetricsCollector::Request directly?
 
@@ -400,8 +481,22 @@ public:
 
 private:
   PipelineLogLevel pipelineLogLevel;
+  TraceSamplingPolicy samplingPolicy;
   kj::Own<Trace> trace;
 
+  // Whether this request's trace is currently being recorded in full. Starts true for requests
+  // in the sampled fraction and flips to true on escalation (see TraceSamplingPolicy).
+  bool sampled;
+
+  // While unsampled, the most recent log lines are kept here (a small fixed-capacity ring,
+  // overwriting the oldest) so escalation can retroactively include them. Diagnostic channel
+  // events are not buffered; while unsampled they are simply dropped.
+  kj::Vector<Trace::Log> recentLogs;
+  size_t recentLogsHead = 0;
+
+  // Flushes `recentLogs` into the trace and switches to full recording.
+  void escalate();
+
   // own an instance of the pipeline to make sure it doesn't get destroyed
   // before we're finished tracing
   kj::Maybe<kj::Own<PipelineTracer>> parentPipeline;
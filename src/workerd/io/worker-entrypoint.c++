@@ -59,7 +59,8 @@ public:
       kj::AsyncIoStream& connection, ConnectResponse& response,
       kj::HttpConnectSettings settings) override;
   void prewarm(kj::StringPtr url) override;
-  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron) override;
+  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron,
+      uint32_t shardIndex, uint32_t shardCount) override;
   kj::Promise<AlarmResult> runAlarm(kj::Date scheduledTime, uint32_t retryCount) override;
   kj::Promise<bool> test() override;
   kj::Promise<CustomEvent::Result> customEvent(kj::Own<CustomEvent> event) override;
@@ -224,6 +225,11 @@ kj::Promise<void> WorkerEntrypoint::request(
   incomingRequest->delivered();
   auto& context = incomingRequest->getContext();
 
+  // Emit a flow keyed on the IoContext so this delivery stitches together with the
+  // IoContext::run() slices executed on the context's behalf.
+  TRACE_EVENT_INSTANT("workerd", "WorkerEntrypoint::request() delivered",
+      PERFETTO_FLOW_FROM_POINTER(&context));
+
   auto wrappedResponse = kj::heap<ResponseSentTracker>(response);
 
   bool isActor = context.getActor() != kj::none;
@@ -313,7 +319,10 @@ kj::Promise<void> WorkerEntrypoint::request(
     TRACE_EVENT("workerd", "WorkerEntrypoint::request() finish proxying",
                 PERFETTO_TERMINATING_FLOW_FROM_POINTER(this));
     // Now that the IoContext is dropped (unless it had waitUntil()s), we can finish proxying
-    // without pinning it or the isolate into memory.
+    // without pinning it or the isolate into memory. Pass-through WebSocket sessions take this
+    // path too: WebSocket::couple() begins deferred proxying automatically for sockets with no
+    // local JS peer (and for hibernatable ones), so the pump for a long-lived proxied socket runs
+    // entirely out here, after the isolate is free to be evicted.
     KJ_IF_SOME(p, proxyTask) {
       return kj::mv(p);
     } else {
@@ -457,7 +466,9 @@ void WorkerEntrypoint::prewarm(kj::StringPtr url) {
 
 kj::Promise<WorkerInterface::ScheduledResult> WorkerEntrypoint::runScheduled(
     kj::Date scheduledTime,
-    kj::StringPtr cron) {
+    kj::StringPtr cron,
+    uint32_t shardIndex,
+    uint32_t shardCount) {
   TRACE_EVENT("workerd", "WorkerEntrypoint::runScheduled()");
   auto incomingRequest = kj::mv(KJ_REQUIRE_NONNULL(this->incomingRequest,
                                 "runScheduled() can only be called once"));
@@ -477,13 +488,13 @@ kj::Promise<WorkerInterface::ScheduledResult> WorkerEntrypoint::runScheduled(
 
   // Scheduled handlers run entirely in waitUntil() tasks.
   context.addWaitUntil(context.run(
-      [scheduledTime, cron, entrypointName=entrypointName, &context,
+      [scheduledTime, cron, shardIndex, shardCount, entrypointName=entrypointName, &context,
        &metrics = incomingRequest->getMetrics()]
       (Worker::Lock& lock) mutable {
     TRACE_EVENT("workerd", "WorkerEntrypoint::runScheduled() run");
     jsg::AsyncContextFrame::StorageScope traceScope = context.makeAsyncTraceScope(lock);
 
-    lock.getGlobalScope().startScheduled(scheduledTime, cron, lock,
+    lock.getGlobalScope().startScheduled(scheduledTime, cron, shardIndex, shardCount, lock,
         lock.getExportedHandler(entrypointName, context.getActor()));
   }));
 
@@ -516,6 +527,9 @@ kj::Promise<WorkerInterface::AlarmResult> WorkerEntrypoint::runAlarmImpl(
   TRACE_EVENT("workerd", "WorkerEntrypoint::runAlarmImpl()");
 
   auto& context = incomingRequest->getContext();
+  // Alarms are background work; don't let them queue ahead of interactive traffic on a shared
+  // isolate.
+  context.setLockPriority(Worker::LockPriority::BACKGROUND);
   auto& actor = KJ_REQUIRE_NONNULL(context.getActor(), "alarm() should only work with actors");
 
   KJ_IF_SOME(promise, actor.getAlarm(scheduledTime)) {
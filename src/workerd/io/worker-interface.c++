@@ -62,12 +62,14 @@ public:
     }
   }
 
-  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron) override {
+  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron,
+      uint32_t shardIndex, uint32_t shardCount) override {
     KJ_IF_SOME(w, worker) {
-      co_return co_await w.get()->runScheduled(scheduledTime, cron);
+      co_return co_await w.get()->runScheduled(scheduledTime, cron, shardIndex, shardCount);
     } else {
       co_await promise;
-      co_return co_await KJ_ASSERT_NONNULL(worker)->runScheduled(scheduledTime, cron);
+      co_return co_await KJ_ASSERT_NONNULL(worker)->runScheduled(
+          scheduledTime, cron, shardIndex, shardCount);
     }
   }
 
@@ -102,6 +104,10 @@ kj::Own<WorkerInterface> newPromisedWorkerInterface(
 }
 
 kj::Own<kj::HttpClient> asHttpClient(kj::Own<WorkerInterface> workerInterface) {
+  // This is how in-process subrequests between services flow: the destination's
+  // WorkerInterface is invoked directly as an HttpService, with no serialization involved.
+  // The adapter's internal body pipes support kj's pump-collapsing, so chained proxies hand
+  // bytes straight through rather than copying at each hop.
   return kj::newHttpClient(*workerInterface).attach(kj::mv(workerInterface));
 }
 
@@ -224,7 +230,8 @@ public:
       kj::AsyncIoStream& connection, ConnectResponse& response,
       kj::HttpConnectSettings settings) override;
   void prewarm(kj::StringPtr url) override;
-  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron) override;
+  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron,
+      uint32_t shardIndex, uint32_t shardCount) override;
   kj::Promise<AlarmResult> runAlarm(kj::Date scheduledTime, uint32_t retryCount) override;
   kj::Promise<CustomEvent::Result> customEvent(kj::Own<CustomEvent> event) override;
 
@@ -258,8 +265,10 @@ void RevocableWebSocketWorkerInterface::prewarm(kj::StringPtr url) {
 
 kj::Promise<WorkerInterface::ScheduledResult> RevocableWebSocketWorkerInterface::runScheduled(
     kj::Date scheduledTime,
-    kj::StringPtr cron) {
-  return worker.runScheduled(scheduledTime, cron);
+    kj::StringPtr cron,
+    uint32_t shardIndex,
+    uint32_t shardCount) {
+  return worker.runScheduled(scheduledTime, cron, shardIndex, shardCount);
 }
 
 kj::Promise<WorkerInterface::AlarmResult> RevocableWebSocketWorkerInterface::runAlarm(kj::Date scheduledTime, uint32_t retryCount) {
@@ -304,7 +313,8 @@ public:
     // ignore
   }
 
-  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron) override {
+  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron,
+      uint32_t shardIndex, uint32_t shardCount) override {
     kj::throwFatalException(kj::mv(exception));
   }
 
@@ -363,10 +373,17 @@ void RpcWorkerInterface::prewarm(kj::StringPtr url) {
 
 kj::Promise<WorkerInterface::ScheduledResult> RpcWorkerInterface::runScheduled(
     kj::Date scheduledTime,
-    kj::StringPtr cron) {
-  auto req = dispatcher.runScheduledRequest();
+    kj::StringPtr cron,
+    uint32_t shardIndex,
+    uint32_t shardCount) {
+  // These event-metadata messages are tiny; pass an exact size hint so each dispatch allocates
+  // one small first segment instead of capnp's much larger default.
+  auto req = dispatcher.runScheduledRequest(
+      capnp::MessageSize { cron.size() / sizeof(capnp::word) + 8, 0 });
   req.setScheduledTime((scheduledTime - kj::UNIX_EPOCH) / kj::SECONDS);
   req.setCron(cron);
+  req.setShardIndex(shardIndex);
+  req.setShardCount(shardCount);
   return req.send().then([](auto resp) {
     auto respResult = resp.getResult();
     return WorkerInterface::ScheduledResult {
@@ -377,7 +394,7 @@ kj::Promise<WorkerInterface::ScheduledResult> RpcWorkerInterface::runScheduled(
 }
 
 kj::Promise<WorkerInterface::AlarmResult> RpcWorkerInterface::runAlarm(kj::Date scheduledTime, uint32_t retryCount) {
-  auto req = dispatcher.runAlarmRequest();
+  auto req = dispatcher.runAlarmRequest(capnp::MessageSize { 8, 0 });
   req.setScheduledTime((scheduledTime - kj::UNIX_EPOCH) / kj::MILLISECONDS);
   req.setRetryCount(retryCount);
   return req.send().then([](auto resp) {
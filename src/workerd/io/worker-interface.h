@@ -77,7 +77,12 @@ public:
   // Trigger a scheduled event with the given scheduled (unix timestamp) time and cron string.
   // The cron string must be valid until the returned promise completes.
   // Async work is queued in a "waitUntil" task set.
-  virtual kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron) = 0;
+  //
+  // A caller fanning one trigger out across several parallel invocations identifies each
+  // invocation with `shardIndex` (in [0, shardCount)); a plain, unsharded invocation is shard
+  // 0 of 1.
+  virtual kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron,
+      uint32_t shardIndex, uint32_t shardCount) = 0;
 
   // Trigger an alarm event with the given scheduled (unix timestamp) time.
   virtual kj::Promise<AlarmResult> runAlarm(kj::Date scheduledTime, uint32_t retryCount) = 0;
@@ -178,7 +183,8 @@ public:
     ConnectResponse& tunnel, kj::HttpConnectSettings settings) override;
 
   void prewarm(kj::StringPtr url) override;
-  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron) override;
+  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron,
+      uint32_t shardIndex, uint32_t shardCount) override;
   kj::Promise<AlarmResult> runAlarm(kj::Date scheduledTime, uint32_t retryCount) override;
   kj::Promise<CustomEvent::Result> customEvent(kj::Own<CustomEvent> event) override;
 
@@ -326,11 +326,16 @@ uint64_t getCurrentThreadId() {
 // `AsyncWaiter`s. A particular thread only ever owns one `AsyncWaiter` at a time.
 class Worker::AsyncWaiter: public kj::Refcounted {
 public:
-  AsyncWaiter(kj::Own<const Isolate> isolate);
+  AsyncWaiter(kj::Own<const Isolate> isolate, LockPriority priority);
   ~AsyncWaiter() noexcept;
   KJ_DISALLOW_COPY_AND_MOVE(AsyncWaiter);
 
 private:
+  // Starvation bound for the priority lanes: once a background waiter has had this many
+  // interactive waiters inserted ahead of it, it can no longer be bypassed. This bounds a
+  // background waiter's total queue time to MAX_PRIORITY_BYPASSES + (its original position)
+  // lock holds, no matter how heavy interactive traffic gets.
+  static constexpr uint MAX_PRIORITY_BYPASSES = 16;
   // Executor for this waiter's thread.
   const kj::Executor& executor;
 
@@ -349,14 +354,33 @@ private:
   kj::ForkedPromise<void> releasePromise = nullptr;
   kj::Own<kj::PromiseFulfiller<void>> releaseFulfiller;
 
+  // Which priority lane this waiter queues in. Immutable after construction.
+  const LockPriority priority;
+
   // Protected by the lock on `Isolate::asyncWaiters` for the isolate identified by
   // `currentIsolate`. Must be null if `currentIsolate` is null. (All other members of `Waiter`
   // can only be accessed by the thread that created the `Waiter`.)
   kj::Maybe<AsyncWaiter&> next;
   kj::Maybe<AsyncWaiter&>* prev;
 
+  // How many interactive waiters have been inserted ahead of this waiter so far. Only meaningful
+  // for background waiters. Protected by the lock on `Isolate::asyncWaiters`.
+  uint bypassedCount = 0;
+
   static thread_local AsyncWaiter* threadCurrentWaiter;
 
+  // A lock attempt that found this thread already waiting for or holding a different isolate's
+  // lock. Parked attempts form a per-thread FIFO; each time the thread's current waiter is
+  // released, only the front attempt is woken, so a convoy of queued attempts proceeds one at a
+  // time instead of all stampeding to retry at once.
+  class ParkedAttempt;
+
+  // Parks the calling lock attempt until the thread's current waiter has been released.
+  static kj::Promise<void> parkUntilCurrentWaiterReleased();
+
+  // Wakes the attempt at the front of this thread's parked list, if any.
+  static void wakeNextParked();
+
   friend class Worker::Isolate;
   friend class Worker::AsyncLock;
 };
@@ -1142,6 +1166,51 @@ Worker::Isolate::Isolate(kj::Own<Api> apiParam,
   });
 }
 
+namespace {
+
+// Process-lifetime cache of serialized V8 code cache data for top-level worker scripts,
+// keyed by a hash of the script source and the compatibility flags it was compiled under.
+// When many isolates are created for the same script (or the same script is reloaded after
+// an isolate was evicted), this lets later compiles skip most of the parse/compile work.
+//
+// Entries are never removed or replaced, mirroring the memory-safety contract of the
+// builtin-module CompileCache in jsg/modules.c++: find() hands out a reference whose
+// lifetime is the lifetime of the process.
+class ScriptCodeCache {
+public:
+  struct Key {
+    uint64_t sourceHash;
+    uint64_t flagsHash;
+
+    bool operator==(const Key& other) const = default;
+    uint hashCode() const { return kj::hashCode(sourceHash, flagsHash); }
+  };
+
+  static Key makeKey(kj::StringPtr source, kj::StringPtr compatFlagsJson) {
+    return Key { kj::hashCode(source), kj::hashCode(compatFlagsJson) };
+  }
+
+  void add(Key key, kj::Array<kj::byte> data) const {
+    cache.lockExclusive()->upsert(key, kj::mv(data), [](auto&, auto&&) {});
+  }
+
+  kj::Maybe<kj::ArrayPtr<const kj::byte>> find(Key key) const {
+    return cache.lockShared()->find(key).map([](auto& data) {
+      return data.asPtr();
+    });
+  }
+
+  static const ScriptCodeCache& get() {
+    static ScriptCodeCache instance;
+    return instance;
+  }
+
+private:
+  kj::MutexGuarded<kj::HashMap<Key, kj::Array<kj::byte>>> cache;
+};
+
+}  // namespace
+
 Worker::Script::Script(kj::Own<const Isolate> isolateParam, kj::StringPtr id,
                        Script::Source source, IsolateObserver::StartType startType,
                        bool logNewScript, kj::Maybe<ValidationErrorReporter&> errorReporter)
@@ -1240,8 +1309,22 @@ Worker::Script::Script(kj::Own<const Isolate> isolateParam, kj::StringPtr id,
                   // excessively-expensive computation requiring a time limit. We'll go ahead and apply a time
                   // limit just to be safe. Don't add it to the rollover bank, though.
                   auto limitScope = isolate->getLimitEnforcer().enterStartupJs(lock, maybeLimitError);
-                  impl->unboundScriptOrMainModule =
-                      jsg::NonModuleScript::compile(script.mainScript, lock, script.mainScriptName);
+
+                  // Consult the process-wide code cache so that recompiles of the same script
+                  // (e.g. after isolate eviction, or for many isolates running the same script)
+                  // can reuse V8's serialized compile output. The cache key covers the compat
+                  // flags since they can affect codegen.
+                  auto codeCacheKey = ScriptCodeCache::makeKey(script.mainScript,
+                      isolate->getFeatureFlagsForFl().orDefault(nullptr));
+                  auto& codeCache = ScriptCodeCache::get();
+                  auto compiled = jsg::NonModuleScript::compile(
+                      script.mainScript, lock, script.mainScriptName, codeCache.find(codeCacheKey));
+                  if (codeCache.find(codeCacheKey) == kj::none) {
+                    KJ_IF_SOME(serialized, compiled.serializeCodeCache(lock)) {
+                      codeCache.add(codeCacheKey, kj::mv(serialized));
+                    }
+                  }
+                  impl->unboundScriptOrMainModule = kj::mv(compiled);
                 }
 
                 break;
@@ -1701,7 +1784,9 @@ void Worker::handleLog(jsg::Lock& js, ConsoleMode consoleMode, LogLevel level,
     auto& ioContext = IoContext::current();
     KJ_IF_SOME(tracer, ioContext.getWorkerTracer()) {
       auto timestamp = ioContext.now();
-      tracer.log(timestamp, level, message());
+      // Use the lazy overload so the arguments are only JSON-encoded if the trace is
+      // actually recording logs.
+      tracer.log(timestamp, level, [&]() { return message(); });
     }
   }
 
@@ -2097,6 +2182,82 @@ void Worker::Lock::validateHandlers(ValidationErrorReporter& errorReporter) {
 
 thread_local Worker::AsyncWaiter* Worker::AsyncWaiter::threadCurrentWaiter = nullptr;
 
+class Worker::AsyncWaiter::ParkedAttempt {
+public:
+  ParkedAttempt() {
+    auto paf = kj::newPromiseAndFulfiller<void>();
+    promise = kj::mv(paf.promise);
+    fulfiller = kj::mv(paf.fulfiller);
+
+    // Append ourselves to the thread's parked list. All of this state is thread-local, so no
+    // synchronization is needed.
+    next = kj::none;
+    prev = threadTail;
+    *threadTail = *this;
+    threadTail = &next;
+  }
+
+  ~ParkedAttempt() noexcept(false) {
+    if (prev != nullptr) {
+      // Still in the list, meaning we were never woken; just unlink.
+      *prev = next;
+      KJ_IF_SOME(n, next) {
+        n.prev = prev;
+      } else {
+        threadTail = prev;
+      }
+    } else if (woken && !consumed) {
+      // We were woken but the attempt was canceled before it could resume. Pass the wakeup along
+      // so the rest of the queue isn't stranded.
+      wakeNextParked();
+    }
+  }
+
+  KJ_DISALLOW_COPY_AND_MOVE(ParkedAttempt);
+
+  kj::Promise<void> promise = nullptr;
+  kj::Own<kj::PromiseFulfiller<void>> fulfiller;
+
+  // True once we have been popped from the list and our fulfiller fired.
+  bool woken = false;
+
+  // True once the parked lock attempt actually resumed after being woken.
+  bool consumed = false;
+
+  // Intrusive FIFO, same shape as `Isolate::AsyncWaiterList` but local to one thread.
+  kj::Maybe<ParkedAttempt&> next;
+  kj::Maybe<ParkedAttempt&>* prev = nullptr;
+
+  static thread_local kj::Maybe<ParkedAttempt&> threadHead;
+  static thread_local kj::Maybe<ParkedAttempt&>* threadTail;
+};
+
+thread_local kj::Maybe<Worker::AsyncWaiter::ParkedAttempt&>
+    Worker::AsyncWaiter::ParkedAttempt::threadHead = kj::none;
+thread_local kj::Maybe<Worker::AsyncWaiter::ParkedAttempt&>*
+    Worker::AsyncWaiter::ParkedAttempt::threadTail = &Worker::AsyncWaiter::ParkedAttempt::threadHead;
+
+kj::Promise<void> Worker::AsyncWaiter::parkUntilCurrentWaiterReleased() {
+  ParkedAttempt attempt;
+  co_await attempt.promise;
+  attempt.consumed = true;
+}
+
+void Worker::AsyncWaiter::wakeNextParked() {
+  KJ_IF_SOME(front, ParkedAttempt::threadHead) {
+    ParkedAttempt::threadHead = front.next;
+    KJ_IF_SOME(n, front.next) {
+      n.prev = &ParkedAttempt::threadHead;
+    } else {
+      ParkedAttempt::threadTail = &ParkedAttempt::threadHead;
+    }
+    front.next = kj::none;
+    front.prev = nullptr;
+    front.woken = true;
+    front.fulfiller->fulfill();
+  }
+}
+
 Worker::Isolate::AsyncWaiterList::~AsyncWaiterList() noexcept {
   // It should be impossible for this list to be non-empty since each member of the list holds a
   // strong reference back to us. But if the list is non-empty, we'd better crash here, to avoid
@@ -2106,19 +2267,19 @@ Worker::Isolate::AsyncWaiterList::~AsyncWaiterList() noexcept {
 }
 
 kj::Promise<Worker::AsyncLock> Worker::Isolate::takeAsyncLockWithoutRequest(
-    SpanParent parentSpan) const {
+    SpanParent parentSpan, LockPriority priority) const {
   auto lockTiming = getMetrics().tryCreateLockTiming(kj::mv(parentSpan));
-  return takeAsyncLockImpl(kj::mv(lockTiming));
+  return takeAsyncLockImpl(kj::mv(lockTiming), priority);
 }
 
 kj::Promise<Worker::AsyncLock> Worker::Isolate::takeAsyncLock(
-    RequestObserver& request) const {
+    RequestObserver& request, LockPriority priority) const {
   auto lockTiming = getMetrics().tryCreateLockTiming(kj::Maybe<RequestObserver&>(request));
-  return takeAsyncLockImpl(kj::mv(lockTiming));
+  return takeAsyncLockImpl(kj::mv(lockTiming), priority);
 }
 
 kj::Promise<Worker::AsyncLock> Worker::Isolate::takeAsyncLockImpl(
-    kj::Maybe<kj::Own<IsolateObserver::LockTiming>> lockTiming) const {
+    kj::Maybe<kj::Own<IsolateObserver::LockTiming>> lockTiming, LockPriority priority) const {
   kj::Maybe<uint> currentLoad;
   if (lockTiming != kj::none) {
     currentLoad = getCurrentLoad();
@@ -2134,7 +2295,7 @@ kj::Promise<Worker::AsyncLock> Worker::Isolate::takeAsyncLockImpl(
             KJ_ASSERT_NONNULL(currentLoad), false /* threadWaitingSameLock */,
             threadWaitingDifferentLockCount);
       }
-      auto newWaiter = kj::refcounted<AsyncWaiter>(kj::atomicAddRef(*this));
+      auto newWaiter = kj::refcounted<AsyncWaiter>(kj::atomicAddRef(*this), priority);
       co_await newWaiter->readyPromise;
       co_return AsyncLock(kj::mv(newWaiter), kj::mv(lockTiming));
     } else if (waiter->isolate == this) {
@@ -2149,29 +2310,34 @@ kj::Promise<Worker::AsyncLock> Worker::Isolate::takeAsyncLockImpl(
       co_await newWaiterRef->readyPromise;
       co_return AsyncLock(kj::mv(newWaiterRef), kj::mv(lockTiming));
     } else {
-      // Thread is already waiting for or holding a different isolate lock. Wait for that one to
-      // be released before we try to lock a different isolate.
-      // TODO(perf): Use of ForkedPromise leads to thundering herd here. Should be minor in practice,
-      //   but we could consider creating another linked list instead...
+      // Thread is already waiting for or holding a different isolate lock. Park this attempt in
+      // the thread's FIFO of pending lock attempts; the front attempt is woken when the current
+      // waiter is released. Previously every queued attempt waited on the waiter's forked
+      // releasePromise, so a single release woke the whole convoy at once and each wakeup but one
+      // immediately went back to sleep -- O(n^2) wakeups while a hot isolate (e.g. one busy with
+      // background GC) drained its queue.
       KJ_IF_SOME(lt, lockTiming) {
         lt.get()->waitingForOtherIsolate(waiter->isolate->getId());
       }
-      co_await waiter->releasePromise;
+      co_await AsyncWaiter::parkUntilCurrentWaiterReleased();
     }
   }
 }
 
-kj::Promise<Worker::AsyncLock> Worker::takeAsyncLockWithoutRequest(SpanParent parentSpan) const {
-  return script->getIsolate().takeAsyncLockWithoutRequest(kj::mv(parentSpan));
+kj::Promise<Worker::AsyncLock> Worker::takeAsyncLockWithoutRequest(
+    SpanParent parentSpan, LockPriority priority) const {
+  return script->getIsolate().takeAsyncLockWithoutRequest(kj::mv(parentSpan), priority);
 }
 
-kj::Promise<Worker::AsyncLock> Worker::takeAsyncLock(RequestObserver& request) const {
-  return script->getIsolate().takeAsyncLock(request);
+kj::Promise<Worker::AsyncLock> Worker::takeAsyncLock(
+    RequestObserver& request, LockPriority priority) const {
+  return script->getIsolate().takeAsyncLock(request, priority);
 }
 
-Worker::AsyncWaiter::AsyncWaiter(kj::Own<const Isolate> isolateParam)
+Worker::AsyncWaiter::AsyncWaiter(kj::Own<const Isolate> isolateParam, LockPriority priority)
     : executor(kj::getCurrentThreadExecutor()),
-      isolate(kj::mv(isolateParam)) {
+      isolate(kj::mv(isolateParam)),
+      priority(priority) {
   // Init `releasePromise` / `releaseFulfiller`.
   {
     auto paf = kj::newPromiseAndFulfiller<void>();
@@ -2185,17 +2351,57 @@ Worker::AsyncWaiter::AsyncWaiter(kj::Own<const Isolate> isolateParam)
     // Looks like the queue is empty, so we immediately get the lock.
     readyPromise = kj::Promise<void>(kj::READY_NOW).fork();
     // We can leave `readyFulfiller` null as no one will ever invoke it anyway.
+
+    next = kj::none;
+    prev = lock->tail;
+    *lock->tail = this;
+    lock->tail = &next;
   } else {
     // Arrange to get notified later.
     auto paf = kj::newPromiseAndCrossThreadFulfiller<void>();
     readyPromise = paf.promise.fork();
     readyFulfiller = kj::mv(paf.fulfiller);
-  }
 
-  next = kj::none;
-  prev = lock->tail;
-  *lock->tail = this;
-  lock->tail = &next;
+    // Pick the insertion point. Background waiters always append. Interactive waiters insert
+    // ahead of the first background waiter that hasn't yet exhausted its starvation bound --
+    // never ahead of the front node (which already holds or has been promised the lock), and
+    // never ahead of another interactive waiter, so each lane stays FIFO.
+    kj::Maybe<AsyncWaiter&>* insertPoint = lock->tail;
+    if (priority == LockPriority::INTERACTIVE) {
+      auto& front = KJ_ASSERT_NONNULL(lock->head);
+      kj::Maybe<AsyncWaiter&>* pos = &front.next;
+      for (;;) {
+        KJ_IF_SOME(n, *pos) {
+          if (n.priority == LockPriority::BACKGROUND &&
+              n.bypassedCount < MAX_PRIORITY_BYPASSES) {
+            insertPoint = pos;
+            // Every background waiter from here on now has one more waiter ahead of it.
+            for (auto* p = pos;;) {
+              KJ_IF_SOME(m, *p) {
+                if (m.priority == LockPriority::BACKGROUND) ++m.bypassedCount;
+                p = &m.next;
+              } else {
+                break;
+              }
+            }
+            break;
+          }
+          pos = &n.next;
+        } else {
+          break;  // reached the tail; append
+        }
+      }
+    }
+
+    next = *insertPoint;
+    prev = insertPoint;
+    KJ_IF_SOME(n, next) {
+      n.prev = &next;
+    } else {
+      lock->tail = &next;
+    }
+    *insertPoint = this;
+  }
 
   threadCurrentWaiter = this;
 
@@ -2230,6 +2436,10 @@ Worker::AsyncWaiter::~AsyncWaiter() noexcept {
 
   KJ_ASSERT(threadCurrentWaiter == this);
   threadCurrentWaiter = nullptr;
+
+  // Now that this thread holds no waiter, let the next parked lock attempt (if any) try to take
+  // its lock.
+  wakeNextParked();
 }
 
 kj::Promise<void> Worker::AsyncLock::whenThreadIdle() {
@@ -2305,6 +2515,24 @@ struct MessageQueue {
   enum class Status { ACTIVE, CLOSED } status;
 };
 
+// Incoming counterpart of MessageQueue: CDP commands that have already been parsed and
+// filtered on the InspectorService (I/O) thread, queued for dispatch under the isolate lock.
+// Parsing up front means the JSON decode of potentially large payloads never happens with the
+// isolate lock held, and commands that don't need the isolate at all are answered before they
+// are ever queued.
+struct CommandQueue {
+  struct PreparsedCdpMessage {
+    // The original JSON text; the V8 inspector session wants the raw message.
+    kj::String message;
+    // The parsed cdp::Command, so dispatch doesn't re-decode under the isolate lock.
+    kj::Own<capnp::MallocMessageBuilder> cmd;
+  };
+  kj::Vector<PreparsedCdpMessage> messages;
+  size_t head;
+  using Status = MessageQueue::Status;
+  Status status;
+};
+
 class Worker::Isolate::InspectorChannelImpl final: public v8_inspector::V8Inspector::Channel {
 public:
   InspectorChannelImpl(kj::Own<const Worker::Isolate> isolateParam, kj::WebSocket& webSocket)
@@ -2355,19 +2583,16 @@ public:
     ioHandler.disconnect();
   }
 
-  void dispatchProtocolMessage(kj::String message,
-                               v8_inspector::V8InspectorSession& session,
-                               Isolate& isolate,
-                               jsg::V8StackScope& stackScope,
-                               Isolate::Impl::Lock& recordedLock) {
-    capnp::MallocMessageBuilder messageBuilder;
-    auto cmd = messageBuilder.initRoot<cdp::Command>();
+  // Parses and filters one protocol message. Runs on the InspectorService (I/O) thread,
+  // without the isolate lock. Commands that never touch the isolate (the Network.* family)
+  // are answered directly from here; for everything else the parsed command is returned so
+  // the caller can queue it for dispatch under the isolate lock.
+  kj::Maybe<CommandQueue::PreparsedCdpMessage> preparseProtocolMessage(kj::String message) {
+    auto builder = kj::heap<capnp::MallocMessageBuilder>();
+    auto cmd = builder->initRoot<cdp::Command>();
     getCdpJsonCodec().decode(message, cmd);
 
     switch (cmd.which()) {
-      case cdp::Command::UNKNOWN: {
-        break;
-      }
       case cdp::Command::NETWORK_ENABLE: {
         setNetworkEnabled(true);
         cmd.getNetworkEnable().initResult();
@@ -2384,6 +2609,33 @@ public:
         err.setMessage("Network.getResponseBody is not supported in this fork");
         break;
       }
+      default: {
+        return CommandQueue::PreparsedCdpMessage { kj::mv(message), kj::mv(builder) };
+      }
+    }
+
+    sendNotification(cmd);
+    return kj::none;
+  }
+
+  void dispatchProtocolMessage(CommandQueue::PreparsedCdpMessage preparsed,
+                               v8_inspector::V8InspectorSession& session,
+                               Isolate& isolate,
+                               jsg::V8StackScope& stackScope,
+                               Isolate::Impl::Lock& recordedLock) {
+    kj::String message = kj::mv(preparsed.message);
+    auto cmd = preparsed.cmd->getRoot<cdp::Command>();
+
+    switch (cmd.which()) {
+      case cdp::Command::UNKNOWN: {
+        break;
+      }
+      case cdp::Command::NETWORK_ENABLE:
+      case cdp::Command::NETWORK_DISABLE:
+      case cdp::Command::NETWORK_GET_RESPONSE_BODY: {
+        // Fully handled during preparse; never queued for dispatch here.
+        break;
+      }
       case cdp::Command::PROFILER_STOP: {
         KJ_IF_SOME(p, isolate.impl->profiler) {
           auto& lock = recordedLock.lock;
@@ -2480,7 +2732,7 @@ public:
 
   void handleDispatchProtocolMessage(
       Worker::AsyncLock& asyncLock,
-      kj::MutexGuarded<MessageQueue>& incomingQueue) {
+      kj::MutexGuarded<CommandQueue>& incomingQueue) {
     auto lockedState = state.lockExclusive();
     v8_inspector::V8InspectorSession& session = *lockedState->get()->session;
     Isolate& isolate = const_cast<Isolate&>(*lockedState->get()->isolate);
@@ -2488,7 +2740,7 @@ public:
       Isolate::Impl::Lock recordedLock(isolate, asyncLock, stackScope);
 
       auto lockedQueue = incomingQueue.lockExclusive();
-      if (lockedQueue->status != MessageQueue::Status::ACTIVE) {
+      if (lockedQueue->status != CommandQueue::Status::ACTIVE) {
         return;
       }
 
@@ -2501,10 +2753,21 @@ public:
     });
   }
 
-  kj::Promise<void> dispatchProtocolMessages(kj::MutexGuarded<MessageQueue>& incomingQueue) {
+  kj::Promise<void> dispatchProtocolMessages(kj::MutexGuarded<CommandQueue>& incomingQueue) {
     // This method is called on the I/O thread, which also adds messages to the `incomingQueue`.
     // So long as this method does not yield/resume mid-way, there is no concern about how
     // long the queue lock is held for whilst dispatching messages.
+
+    // Messages that don't need the isolate are answered at receive time and never queued, so
+    // the queue may well be empty by the time the notifier fires; don't take the isolate lock
+    // just to discover that.
+    {
+      auto lockedQueue = incomingQueue.lockExclusive();
+      if (lockedQueue->head == lockedQueue->messages.size()) {
+        co_return;
+      }
+    }
+
     auto i = kj::atomicAddRef(*this->state.lockExclusive()->get()->isolate);
     auto asyncLock = co_await i->takeAsyncLockWithoutRequest(nullptr);
     handleDispatchProtocolMessage(asyncLock, incomingQueue);
@@ -2580,14 +2843,14 @@ private:
     // for use in the InspectorClient when breakpoints are hit. The InspectorClient
     // has to remain in runMessageLoopOnPause() but still receive CDP messages
     // (e.g. resume).
-    kj::Maybe<kj::String> waitForMessage() {
+    kj::Maybe<CommandQueue::PreparsedCdpMessage> waitForMessage() {
       return incomingQueue.when(
-          [](const MessageQueue& incomingQueue) {
+          [](const CommandQueue& incomingQueue) {
             return (incomingQueue.head < incomingQueue.messages.size() ||
-                    incomingQueue.status == MessageQueue::Status::CLOSED);
+                    incomingQueue.status == CommandQueue::Status::CLOSED);
           },
-          [](MessageQueue& incomingQueue) -> kj::Maybe<kj::String> {
-            if (incomingQueue.status == MessageQueue::Status::CLOSED) return {};
+          [](CommandQueue& incomingQueue) -> kj::Maybe<CommandQueue::PreparsedCdpMessage> {
+            if (incomingQueue.status == CommandQueue::Status::CLOSED) return {};
             return pollMessage(incomingQueue);
           });
     }
@@ -2606,9 +2869,9 @@ private:
     }
 
   private:
-    static kj::Maybe<kj::String> pollMessage(MessageQueue& messageQueue) {
+    static kj::Maybe<CommandQueue::PreparsedCdpMessage> pollMessage(CommandQueue& messageQueue) {
       if (messageQueue.head < messageQueue.messages.size()) {
-        kj::String message = kj::mv(messageQueue.messages[messageQueue.head++]);
+        auto message = kj::mv(messageQueue.messages[messageQueue.head++]);
         if (messageQueue.head == messageQueue.messages.size()) {
           messageQueue.head = 0;
           messageQueue.messages.clear();
@@ -2641,8 +2904,15 @@ private:
         auto message = co_await webSocket.receive(MAX_MESSAGE_SIZE);
         KJ_SWITCH_ONEOF(message) {
           KJ_CASE_ONEOF(text, kj::String) {
-            incomingQueue.lockExclusive()->messages.add(kj::mv(text));
-            incomingQueueNotifier->notify();
+            // Parse and filter here, on the I/O thread, so the isolate thread never has to
+            // decode CDP JSON. Messages fully handled during preparse are not queued at all.
+            KJ_IF_SOME(c, channel) {
+              auto maybeParsed = c.preparseProtocolMessage(kj::mv(text));
+              KJ_IF_SOME(parsed, maybeParsed) {
+                incomingQueue.lockExclusive()->messages.add(kj::mv(parsed));
+                incomingQueueNotifier->notify();
+              }
+            }
           }
           KJ_CASE_ONEOF(blob, kj::Array<byte>){
             // Ignore.
@@ -2693,7 +2963,7 @@ private:
       }
     }
 
-    kj::MutexGuarded<MessageQueue> incomingQueue;
+    kj::MutexGuarded<CommandQueue> incomingQueue;
     kj::Own<XThreadNotifier> incomingQueueNotifier;
 
     kj::MutexGuarded<MessageQueue> outgoingQueue;
@@ -3029,9 +3299,11 @@ struct Worker::Actor::Impl {
 
     void updateAlarmInMemory(kj::Maybe<kj::Date> newAlarmTime) override;
     void storageReadCompleted(kj::Duration latency) override {
+      ActorCache::Hooks::storageReadCompleted(latency);
       metrics.storageReadCompleted(latency);
     }
     void storageWriteCompleted(kj::Duration latency) override {
+      ActorCache::Hooks::storageWriteCompleted(latency);
       metrics.storageWriteCompleted(latency);
     }
 
@@ -3140,7 +3412,7 @@ struct Worker::Actor::Impl {
 };
 
 kj::Promise<Worker::AsyncLock> Worker::takeAsyncLockWhenActorCacheReady(
-    kj::Date now, Actor& actor, RequestObserver& request) const {
+    kj::Date now, Actor& actor, RequestObserver& request, LockPriority priority) const {
   auto lockTiming = getIsolate().getMetrics()
       .tryCreateLockTiming(kj::Maybe<RequestObserver&>(request));
 
@@ -3152,7 +3424,7 @@ kj::Promise<Worker::AsyncLock> Worker::takeAsyncLockWhenActorCacheReady(
     }
   }
 
-  co_return co_await getIsolate().takeAsyncLockImpl(kj::mv(lockTiming));
+  co_return co_await getIsolate().takeAsyncLockImpl(kj::mv(lockTiming), priority);
 }
 
 void Worker::setConnectOverride(kj::String networkAddress, ConnectFn connectFn) {
@@ -3756,7 +4028,8 @@ public:
       kj::HttpService::ConnectResponse& tunnel,
       kj::HttpConnectSettings settings) override;
   void prewarm(kj::StringPtr url) override;
-  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron) override;
+  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron,
+      uint32_t shardIndex, uint32_t shardCount) override;
   kj::Promise<AlarmResult> runAlarm(kj::Date scheduledTime, uint32_t retryCount) override;
   kj::Promise<CustomEvent::Result> customEvent(kj::Own<CustomEvent> event) override;
 
@@ -3978,8 +4251,8 @@ void Worker::Isolate::SubrequestClient::prewarm(kj::StringPtr url) {
   inner->prewarm(url);
 }
 kj::Promise<WorkerInterface::ScheduledResult> Worker::Isolate::SubrequestClient::runScheduled(
-    kj::Date scheduledTime, kj::StringPtr cron) {
-  return inner->runScheduled(scheduledTime, cron);
+    kj::Date scheduledTime, kj::StringPtr cron, uint32_t shardIndex, uint32_t shardCount) {
+  return inner->runScheduled(scheduledTime, cron, shardIndex, shardCount);
 }
 kj::Promise<WorkerInterface::AlarmResult> Worker::Isolate::SubrequestClient::runAlarm(
     kj::Date scheduledTime, uint32_t retryCount) {
@@ -115,11 +115,25 @@ public:
 
   class AsyncLock;
 
+  // Priority lane for async lock waiters. Interactive waiters (fetch and other latency-sensitive
+  // events) are admitted to the queue ahead of background waiters (alarms, queue batches, tail
+  // events), subject to a starvation bound: a background waiter that has been bypassed enough
+  // times becomes un-bypassable, so bulk traffic still makes progress under sustained interactive
+  // load. Within a lane, waiters remain FIFO.
+  enum class LockPriority: uint8_t {
+    INTERACTIVE,
+    BACKGROUND
+  };
+
   // Places this thread into the queue of threads which are interested in locking this isolate,
   // and returns when it is this thread's turn. The thread must still obtain a `Worker::Lock`, but
   // by obtaining an `AsyncLock` first, the thread ensures that it is not fighting over the lock
   // with many other threads, and all interested threads get their fair turn.
-  kj::Promise<AsyncLock> takeAsyncLockWithoutRequest(SpanParent parentSpan) const;
+  //
+  // Defaults to the background lane since work with no associated request (warmups, idle GC,
+  // inspector sessions) should not delay request traffic.
+  kj::Promise<AsyncLock> takeAsyncLockWithoutRequest(SpanParent parentSpan,
+      LockPriority priority = LockPriority::BACKGROUND) const;
 
   // Places this thread into the queue of threads which are interested in locking this isolate,
   // and returns when it is this thread's turn. The thread must still obtain a `Worker::Lock`, but
@@ -128,13 +142,14 @@ public:
   //
   // The version accepting a `request` metrics object accumulates lock timing data and reports the
   // data via `request`'s trace span.
-  kj::Promise<AsyncLock> takeAsyncLock(RequestObserver& request) const;
+  kj::Promise<AsyncLock> takeAsyncLock(RequestObserver& request,
+      LockPriority priority = LockPriority::INTERACTIVE) const;
 
   class Actor;
 
   // Like takeAsyncLock(), but also takes care of actor cache time-based eviction and backpressure.
   kj::Promise<AsyncLock> takeAsyncLockWhenActorCacheReady(kj::Date now, Actor& actor,
-      RequestObserver& request) const;
+      RequestObserver& request, LockPriority priority = LockPriority::INTERACTIVE) const;
 
   // Track a set of address->callback overrides for which the connect(address) behavior should be
   // overridden via callbacks rather than using the default Socket connect() logic.
@@ -322,10 +337,12 @@ public:
   void completedRequest() const;
 
   // See Worker::takeAsyncLock().
-  kj::Promise<AsyncLock> takeAsyncLockWithoutRequest(SpanParent parentSpan) const;
+  kj::Promise<AsyncLock> takeAsyncLockWithoutRequest(SpanParent parentSpan,
+      LockPriority priority = LockPriority::BACKGROUND) const;
 
   // See Worker::takeAsyncLock().
-  kj::Promise<AsyncLock> takeAsyncLock(RequestObserver&) const;
+  kj::Promise<AsyncLock> takeAsyncLock(RequestObserver&,
+      LockPriority priority = LockPriority::INTERACTIVE) const;
 
   bool isInspectorEnabled() const;
 
@@ -344,7 +361,7 @@ public:
 
 private:
   kj::Promise<AsyncLock> takeAsyncLockImpl(
-      kj::Maybe<kj::Own<IsolateObserver::LockTiming>> lockTiming) const;
+      kj::Maybe<kj::Own<IsolateObserver::LockTiming>> lockTiming, LockPriority priority) const;
 
   kj::String id;
   kj::Own<IsolateLimitEnforcer> limitEnforcer;
@@ -668,6 +685,18 @@ public:
     virtual void setWebSocketAutoResponse(kj::Maybe<kj::StringPtr> request,
         kj::Maybe<kj::StringPtr> response) = 0;
     virtual kj::Maybe<jsg::Ref<api::WebSocketRequestResponsePair>> getWebSocketAutoResponse() = 0;
+
+    // One entry of the native auto-response table. Incoming text messages that exactly match
+    // `request` are answered with `response` directly from the websocket read loop, without
+    // waking the actor or entering the isolate.
+    struct AutoResponsePair {
+      kj::String request;
+      kj::String response;
+    };
+
+    // Replaces the entire auto-response table. setWebSocketAutoResponse() above is the
+    // single-pair form of this and clears any other entries.
+    virtual void setWebSocketAutoResponses(kj::Array<AutoResponsePair> pairs) = 0;
     virtual void setTimerChannel(TimerChannel& timerChannel) = 0;
     virtual kj::Own<HibernationManager> addRef() = 0;
     virtual void setEventTimeout(kj::Maybe<uint32_t> timeoutMs) = 0;
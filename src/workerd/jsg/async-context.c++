@@ -29,6 +29,8 @@ AsyncContextFrame::AsyncContextFrame(Lock& js, StorageEntry storageEntry) {
     // frame and there is no storage to propagate.
     frame.storage.eraseAll([](const auto& entry) { return entry.key->isDead(); });
     for (auto& entry : frame.storage) {
+      // The entry for our own key is about to be replaced below; don't bother cloning it.
+      if (entry.key.get() == storageEntry.key.get()) continue;
       storage.insert(entry.clone(js));
     }
   }
@@ -37,9 +39,7 @@ AsyncContextFrame::AsyncContextFrame(Lock& js, StorageEntry storageEntry) {
   // just out of an excess of caution.
   if (storageEntry.key->isDead()) return;
 
-  storage.upsert(kj::mv(storageEntry), [](StorageEntry& existing, StorageEntry&& row) mutable {
-    existing.value = kj::mv(row.value);
-  });
+  storage.insert(kj::mv(storageEntry));
 }
 
 AsyncContextFrame::StorageEntry::StorageEntry(kj::Own<StorageKey> key, Value value)
@@ -70,6 +70,20 @@ kj::Maybe<AsyncContextFrame&> AsyncContextFrame::current(v8::Isolate* isolate) {
 }
 
 Ref<AsyncContextFrame> AsyncContextFrame::create(Lock& js, StorageEntry storageEntry) {
+  // If the current frame already holds exactly this value for this key, a new frame would be
+  // an identical copy of it. Frames are immutable once constructed (dead-key cleanup aside),
+  // so re-entering the current frame is observably equivalent and allocates nothing. This is
+  // the shape of nested als.run(store, ...) calls with a stable store -- e.g. propagating a
+  // request ID through every subrequest -- which otherwise clone the storage table per call.
+  if (!storageEntry.key->isDead()) {
+    KJ_IF_SOME(frame, current(js)) {
+      KJ_IF_SOME(existing, frame.get(*storageEntry.key)) {
+        if (existing.getHandle(js) == storageEntry.value.getHandle(js)) {
+          return frame.addRef();
+        }
+      }
+    }
+  }
   return alloc<AsyncContextFrame>(js, kj::mv(storageEntry));
 }
 
@@ -55,11 +55,31 @@ struct BufferSourceContext: public jsg::Object, public jsg::ContextGlobal {
     return BufferSource(js, BackingStore::alloc<v8::ArrayBuffer>(js, 3));
   }
 
+  bool checkAllocRecycling(jsg::Lock& js) {
+    // A small allocation released without ever being exposed to JS returns to the recycling
+    // pool as soon as the BackingStore drops, so the next allocation of the same size class
+    // reuses the block -- and must come back zeroed despite the scribbling.
+    kj::byte* first;
+    {
+      auto store = BackingStore::alloc(js, 100);
+      auto bytes = store.asArrayPtr();
+      first = bytes.begin();
+      for (auto& b: bytes) b = 0xab;
+    }
+    auto store = BackingStore::alloc(js, 100);
+    auto bytes = store.asArrayPtr();
+    for (auto b: bytes) {
+      KJ_ASSERT(b == 0);
+    }
+    return bytes.begin() == first;
+  }
+
   JSG_RESOURCE_TYPE(BufferSourceContext) {
     JSG_METHOD(takeBufferSource);
     JSG_METHOD(takeUint8Array);
     JSG_METHOD(makeBufferSource);
     JSG_METHOD(makeArrayBuffer);
+    JSG_METHOD(checkAllocRecycling);
   }
 };
 JSG_DECLARE_ISOLATE_TYPE(BufferSourceIsolate, BufferSourceContext);
@@ -79,6 +99,11 @@ KJ_TEST("BufferSource works") {
       "boolean",
       "true");
 
+  e.expectEval(
+      "checkAllocRecycling()",
+      "boolean",
+      "true");
+
   e.expectEval(
       "const ab = new ArrayBuffer(9); takeBufferSource(new Uint8Array(ab, 1, 8)).byteLength === 8",
       "boolean",
@@ -3,10 +3,60 @@
 //     https://opensource.org/licenses/Apache-2.0
 
 #include "buffersource.h"
+#include <kj/vector.h>
+#include <cstdlib>
+#include <cstring>
 
 namespace workerd::jsg {
 
 namespace {
+
+// =======================================================================================
+// Recycling pool for BackingStore::alloc().
+//
+// Native code paths -- stream reads, crypto outputs, Buffer allocations -- mint large numbers
+// of short-lived ArrayBuffers. Rather than paying a heap allocation and free for each one,
+// buffers of common sizes recycle through a thread-local size-classed pool: alloc() hands V8
+// an externalized backing store whose deleter pushes the memory back onto the pool of
+// whichever thread runs the GC callback. Raw malloc/free is used because ownership transfers
+// through V8's void* deleter interface.
+
+constexpr size_t POOL_SIZE_CLASSES[] = {256, 4096, 16384, 65536};
+
+// Per class and per thread; caps the idle footprint at ~675KB per thread.
+constexpr size_t MAX_POOLED_PER_CLASS = 8;
+
+kj::Maybe<kj::uint> poolSizeClassFor(size_t size) {
+  for (auto i: kj::indices(POOL_SIZE_CLASSES)) {
+    if (size <= POOL_SIZE_CLASSES[i]) return kj::uint(i);
+  }
+  return kj::none;
+}
+
+struct BackingStorePool {
+  kj::Vector<void*> freeLists[kj::size(POOL_SIZE_CLASSES)];
+
+  ~BackingStorePool() noexcept(false) {
+    for (auto& list: freeLists) {
+      for (void* ptr: list) free(ptr);
+    }
+  }
+};
+
+thread_local BackingStorePool threadBackingStorePool;
+
+void returnToPool(void* data, size_t byteLength, void*) {
+  // V8 may run this deleter on a different thread than the one that allocated; the memory then
+  // simply recycles through that thread's pool. The block was sized for the class covering
+  // `byteLength`, so the same lookup recovers it.
+  auto classIndex = KJ_ASSERT_NONNULL(poolSizeClassFor(byteLength));
+  auto& freeList = threadBackingStorePool.freeLists[classIndex];
+  if (freeList.size() < MAX_POOLED_PER_CLASS) {
+    freeList.add(data);
+  } else {
+    free(data);
+  }
+}
 auto getBacking(auto& handle) {
   auto buffer = handle->IsArrayBuffer() ?
       handle.template As<v8::ArrayBuffer>() :
@@ -77,6 +127,26 @@ BackingStore::BackingStore(
               kj::str("byteLength must be a multiple of ", this->elementSize, "."));
 }
 
+std::shared_ptr<v8::BackingStore> BackingStore::allocRawBytes(v8::Isolate* isolate, size_t size) {
+  if (size > 0) {
+    KJ_IF_SOME(classIndex, poolSizeClassFor(size)) {
+      void* data;
+      auto& freeList = threadBackingStorePool.freeLists[classIndex];
+      if (freeList.size() > 0) {
+        data = freeList.back();
+        freeList.removeLast();
+      } else {
+        data = malloc(POOL_SIZE_CLASSES[classIndex]);
+        KJ_ASSERT(data != nullptr);
+      }
+      // JavaScript must never observe a recycled buffer's previous contents.
+      memset(data, 0, size);
+      return v8::ArrayBuffer::NewBackingStore(data, size, &returnToPool, nullptr);
+    }
+  }
+  return v8::ArrayBuffer::NewBackingStore(isolate, size);
+}
+
 bool BackingStore::operator==(const BackingStore& other) {
   return backingStore == other.backingStore &&
          byteLength == other.byteLength &&
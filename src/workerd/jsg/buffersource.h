@@ -88,10 +88,16 @@ public:
   }
 
   // Creates a new BackingStore of the given size.
+  //
+  // Small allocations are satisfied from a thread-local size-classed pool of recycled buffers
+  // rather than a fresh heap allocation: the buffer is handed to V8 externalized, and its memory
+  // returns to the pool when the backing store is garbage collected. Native paths that mint
+  // many short-lived ArrayBuffers (stream reads, crypto outputs) allocate through here, so
+  // recycling removes a top allocation source. The exposed bytes are zeroed either way.
   template <BufferSourceType T = v8::Uint8Array>
   static BackingStore alloc(Lock& js, size_t size) {
     return BackingStore(
-        v8::ArrayBuffer::NewBackingStore(js.v8Isolate, size),
+        allocRawBytes(js.v8Isolate, size),
         size, 0,
         getBufferSourceElementSize<T>(), construct<T>,
         checkIsIntegerType<T>());
@@ -212,6 +218,10 @@ public:
   }
 
 private:
+  // Allocates zeroed memory for alloc(), drawing from the thread-local recycling pool when the
+  // size fits one of its classes and falling back to V8's own allocation otherwise.
+  static std::shared_ptr<v8::BackingStore> allocRawBytes(v8::Isolate* isolate, size_t size);
+
   std::shared_ptr<v8::BackingStore> backingStore;
   size_t byteLength;
   size_t byteOffset;
@@ -211,6 +211,9 @@ KJ_TEST("Generator works") {
 
   e.expectEval("sequenceOfSequenceTest([['a','b'],['c', undefined]])", "number", "4");
 
+  // Non-array iterables still go through the iterator protocol.
+  e.expectEval("sequenceOfSequenceTest(new Set([['a','b'],['c','d']]))", "number", "4");
+
   e.expectEval("generatorWrongType(['a'])", "throws",
       "TypeError: Incorrect type: the provided value is not of type 'Test'.");
 }
@@ -134,7 +134,7 @@ private:
       auto& wrapper) {
     auto context = isolate->GetCurrentContext();
     return wrapper.tryUnwrap(isolate->GetCurrentContext(),
-                             check(object->Get(context, v8StrIntern(isolate, name))),
+                             check(object->Get(context, v8StrInternCached(isolate, name))),
                              (Signature*)nullptr,
                              object);
   }
@@ -582,10 +582,10 @@ public:
 
       bool done = typeWrapper.template unwrap<bool>(
           context,
-          check(object->Get(context, v8StrIntern(isolate, "done"_kj))),
+          check(object->Get(context, v8StrInternCached(isolate, "done"_kj))),
           TypeErrorContext::other());
 
-      auto value = check(object->Get(context, v8StrIntern(isolate, "value"_kj)));
+      auto value = check(object->Get(context, v8StrInternCached(isolate, "value"_kj)));
 
       if (done) {
         // If done is true, then it is ok if the value does not map to anything.
@@ -728,6 +728,23 @@ public:
       kj::Maybe<v8::Local<v8::Object>> parentObject) {
     auto isolate = context->GetIsolate();
     auto& typeWrapper = TypeWrapper::from(isolate);
+    if (handle->IsArray()) {
+      // Fast path: for actual JS arrays we extract elements by index in a single loop under one
+      // handle scope rather than walking the iterator protocol (which costs a Symbol.iterator
+      // lookup plus a next() call and result-object property reads per element). This mirrors the
+      // kj::Array<U> unwrap in value.h, which likewise reads arrays by index. As with that path,
+      // a patched Array.prototype[Symbol.iterator] is not consulted, but index getters still are.
+      v8::HandleScope scope(isolate);
+      auto array = handle.As<v8::Array>();
+      auto length = array->Length();
+      auto builder = kj::heapArrayBuilder<U>(length);
+      for (auto i: kj::zeroTo(length)) {
+        v8::Local<v8::Value> element = check(array->Get(context, i));
+        builder.add(typeWrapper.template unwrap<U>(
+            context, element, TypeErrorContext::arrayElement(i)));
+      }
+      return Sequence<U>(builder.finish());
+    }
     KJ_IF_SOME(gen, typeWrapper.tryUnwrap(context, handle, (Generator<U>*)nullptr, parentObject)) {
       kj::Vector<U> items;
       // We intentionally ignore the forEach return value.
@@ -0,0 +1,167 @@
+// Copyright (c) 2017-2022 Cloudflare, Inc.
+// Licensed under the Apache 2.0 license found in the LICENSE file or at:
+//     https://opensource.org/licenses/Apache-2.0
+
+#include "jsg-test.h"
+#include "ser.h"
+#include <workerd/tests/bench-tools.h>
+
+// Benchmarks for the JSG conversion layers: TypeWrapper wrap/unwrap, jsg::Function
+// invocation, promise round-trips, and Serializer throughput. Run via
+// `bazel run //src/workerd/jsg:jsg-bench` to collect before/after numbers for runtime
+// upgrades.
+
+namespace workerd::jsg::test {
+namespace {
+
+V8System v8System;
+class ContextGlobalObject: public Object, public ContextGlobal {};
+
+struct BenchContext: public ContextGlobalObject {
+  // A struct with representative payload shape: short strings, a number, and a list.
+  struct Payload {
+    kj::String name;
+    double count;
+    kj::Array<kj::String> tags;
+    JSG_STRUCT(name, count, tags);
+  };
+
+  double addNumbers(double a, double b) {
+    return a + b;
+  }
+  kj::String echoString(kj::String s) {
+    return kj::mv(s);
+  }
+  Payload echoStruct(Payload p) {
+    return kj::mv(p);
+  }
+
+  // Calls the given JS function 100 times, measuring jsg::Function dispatch overhead.
+  double callFunction(jsg::Lock& js, jsg::Function<double(double)> fn) {
+    double total = 0;
+    for (int i = 0; i < 100; i++) {
+      total += fn(js, double(i));
+    }
+    return total;
+  }
+
+  JSG_RESOURCE_TYPE(BenchContext) {
+    JSG_METHOD(addNumbers);
+    JSG_METHOD(echoString);
+    JSG_METHOD(echoStruct);
+    JSG_METHOD(callFunction);
+  }
+};
+JSG_DECLARE_ISOLATE_TYPE(BenchIsolate, BenchContext, BenchContext::Payload);
+
+// Enters the (shared) benchmark isolate and context and runs `fn` with the lock held, so
+// the benchmark loop itself measures only the work under test, not isolate setup.
+template <typename Fn>
+void runInBenchContext(Fn&& fn) {
+  static BenchIsolate isolate(v8System, kj::heap<IsolateObserver>());
+  isolate.runInLockScope([&](BenchIsolate::Lock& lock) {
+    JSG_WITHIN_CONTEXT_SCOPE(lock,
+        lock.newContext<BenchContext>().getHandle(lock.v8Isolate),
+        [&](jsg::Lock& js) { fn(js); });
+  });
+}
+
+// Compiles and runs `code`, which must evaluate to a function, and returns that function.
+v8::Local<v8::Function> compileFunction(jsg::Lock& js, kj::StringPtr code) {
+  auto source = v8Str(js.v8Isolate, code);
+  auto script = check(v8::Script::Compile(js.v8Context(), source));
+  return check(script->Run(js.v8Context())).As<v8::Function>();
+}
+
+v8::Local<v8::Value> callNoArgs(jsg::Lock& js, v8::Local<v8::Function> fn) {
+  return check(fn->Call(js.v8Context(), js.v8Context()->Global(), 0, nullptr));
+}
+
+void typeWrapperNumbers(benchmark::State& state) {
+  runInBenchContext([&](jsg::Lock& js) {
+    auto fn = compileFunction(js,
+        "(() => { let t = 0; for (let i = 0; i < 1000; i++) t += addNumbers(i, i); return t; })");
+    for (auto _: state) {
+      // Scope per iteration so handles don't accumulate over the run.
+      js.withinHandleScope([&] { benchmark::DoNotOptimize(callNoArgs(js, fn)); });
+    }
+  });
+}
+WD_BENCHMARK(typeWrapperNumbers)->Name("jsg/typeWrapper/numbers");
+
+void typeWrapperStrings(benchmark::State& state) {
+  runInBenchContext([&](jsg::Lock& js) {
+    auto fn = compileFunction(js,
+        "(() => { const s = 'hello world, this is a mid-size header value';"
+        "  let t = 0; for (let i = 0; i < 100; i++) t += echoString(s).length; return t; })");
+    for (auto _: state) {
+      // Scope per iteration so handles don't accumulate over the run.
+      js.withinHandleScope([&] { benchmark::DoNotOptimize(callNoArgs(js, fn)); });
+    }
+  });
+}
+WD_BENCHMARK(typeWrapperStrings)->Name("jsg/typeWrapper/strings");
+
+void typeWrapperStructs(benchmark::State& state) {
+  runInBenchContext([&](jsg::Lock& js) {
+    auto fn = compileFunction(js,
+        "(() => { const p = { name: 'payload', count: 42,"
+        "    tags: ['alpha', 'beta', 'gamma', 'delta'] };"
+        "  let t = 0; for (let i = 0; i < 100; i++) t += echoStruct(p).count; return t; })");
+    for (auto _: state) {
+      // Scope per iteration so handles don't accumulate over the run.
+      js.withinHandleScope([&] { benchmark::DoNotOptimize(callNoArgs(js, fn)); });
+    }
+  });
+}
+WD_BENCHMARK(typeWrapperStructs)->Name("jsg/typeWrapper/structs");
+
+void functionInvocation(benchmark::State& state) {
+  runInBenchContext([&](jsg::Lock& js) {
+    auto fn = compileFunction(js, "(() => callFunction(x => x + 1))");
+    for (auto _: state) {
+      // Scope per iteration so handles don't accumulate over the run.
+      js.withinHandleScope([&] { benchmark::DoNotOptimize(callNoArgs(js, fn)); });
+    }
+  });
+}
+WD_BENCHMARK(functionInvocation)->Name("jsg/function/invocation");
+
+void promiseRoundTrip(benchmark::State& state) {
+  runInBenchContext([&](jsg::Lock& js) {
+    auto fn = compileFunction(js,
+        "(async () => { for (let i = 0; i < 100; i++) await Promise.resolve(i); })");
+    for (auto _: state) {
+      js.withinHandleScope([&] {
+        benchmark::DoNotOptimize(callNoArgs(js, fn));
+        js.runMicrotasks();
+      });
+    }
+  });
+}
+WD_BENCHMARK(promiseRoundTrip)->Name("jsg/promise/roundTrip");
+
+void serializerThroughput(benchmark::State& state) {
+  runInBenchContext([&](jsg::Lock& js) {
+    // Representative structured-clone payload: nested objects, strings, numbers, and a
+    // moderately sized array, similar to a typical KV/DO value.
+    auto fn = compileFunction(js,
+        "(() => ({ id: 'x'.repeat(36), count: 1234.5,"
+        "   tags: [...Array(16)].map((_, i) => 'tag' + i),"
+        "   nested: { a: 1, b: 'two', c: [3, 4, 5] },"
+        "   body: 'y'.repeat(1024) }))");
+    auto value = JsValue(callNoArgs(js, fn));
+    for (auto _: state) {
+      js.withinHandleScope([&] {
+        Serializer ser(js);
+        ser.write(js, value);
+        auto released = ser.release();
+        benchmark::DoNotOptimize(released.data.size());
+      });
+    }
+  });
+}
+WD_BENCHMARK(serializerThroughput)->Name("jsg/serializer/throughput");
+
+}  // namespace
+}  // namespace workerd::jsg::test
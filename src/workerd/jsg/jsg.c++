@@ -220,7 +220,7 @@ void Lock::requestGcForTesting() const {
 void Lock::v8Set(v8::Local<v8::Object> obj,
                  kj::StringPtr name,
                  v8::Local<v8::Value> value) {
-  KJ_ASSERT(check(obj->Set(v8Context(), v8StrIntern(v8Isolate, name), value)));
+  KJ_ASSERT(check(obj->Set(v8Context(), v8StrInternCached(v8Isolate, name), value)));
 }
 
 void Lock::v8Set(v8::Local<v8::Object> obj, kj::StringPtr name, Value& value) {
@@ -232,7 +232,7 @@ void Lock::v8Set(v8::Local<v8::Object> obj, V8Ref<v8::String>& name, Value& valu
 }
 
 v8::Local<v8::Value> Lock::v8Get(v8::Local<v8::Object> obj, kj::StringPtr name) {
-  return check(obj->Get(v8Context(), v8StrIntern(v8Isolate, name)));
+  return check(obj->Get(v8Context(), v8StrInternCached(v8Isolate, name)));
 }
 
 v8::Local<v8::Value> Lock::v8Get(v8::Local<v8::Array> obj, uint idx) {
@@ -240,11 +240,11 @@ v8::Local<v8::Value> Lock::v8Get(v8::Local<v8::Array> obj, uint idx) {
 }
 
 bool Lock::v8Has(v8::Local<v8::Object> obj, kj::StringPtr name) {
-  return check(obj->Has(v8Context(), v8StrIntern(v8Isolate, name)));
+  return check(obj->Has(v8Context(), v8StrInternCached(v8Isolate, name)));
 }
 
 bool Lock::v8HasOwn(v8::Local<v8::Object> obj, kj::StringPtr name) {
-  return check(obj->HasOwnProperty(v8Context(), v8StrIntern(v8Isolate, name)));
+  return check(obj->HasOwnProperty(v8Context(), v8StrInternCached(v8Isolate, name)));
 }
 
 kj::StringPtr Lock::getUuid() const {
@@ -486,6 +486,22 @@ using HasGetTemplateOverload = decltype(
     registry.template registerNestedType<Type, NAME>(); \
   } while (false)
 
+// Like JSG_NESTED_TYPE, but the nested type's FunctionTemplate is not built until the first
+// time user code actually accesses the property. Use this for large, rarely-used types: an
+// eager nested type is instantiated (along with everything it references) every time the
+// parent's template is built, which for global-scope members means every isolate.
+#define JSG_LAZY_NESTED_TYPE(Type) \
+  do { \
+    static const char NAME[] = #Type; \
+    registry.template registerLazyNestedType<Type, NAME>(); \
+  } while (false)
+
+#define JSG_LAZY_NESTED_TYPE_NAMED(Type, Name) \
+  do { \
+    static const char NAME[] = #Name; \
+    registry.template registerLazyNestedType<Type, NAME>(); \
+  } while (false)
+
 // Adds reflection to a resource type. See PropertyReflection<T> for usage.
 #define JSG_REFLECTION(...) \
   static constexpr bool jsgHasReflection = true; \
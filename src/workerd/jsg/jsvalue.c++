@@ -414,11 +414,9 @@ JsString Lock::str(kj::ArrayPtr<const kj::byte> str) {
 }
 
 JsString Lock::strIntern(kj::StringPtr str) {
-  return JsString(check(v8::String::NewFromUtf8(
-      v8Isolate,
-      str.begin(),
-      v8::NewStringType::kInternalized,
-      str.size())));
+  // Interned strings are almost always hot, repeated names spelled out in C++ code, so route them
+  // through the isolate's interned-string handle cache.
+  return JsString(v8StrInternCached(v8Isolate, str));
 }
 
 JsString Lock::strExtern(kj::ArrayPtr<const char> str) {
@@ -107,5 +107,21 @@ KJ_TEST("MemoryTracker test") {
   });
 }
 
+KJ_TEST("MemoryAccounting counters track construction and destruction") {
+  runTest([&](jsg::Lock& js, const TypeHandler<Ref<Foo>>&) {
+    auto& accounting = IsolateBase::from(js.v8Isolate).getMemoryAccounting();
+    auto before = accounting.get(MemoryCategory::BLOBS);
+    {
+      MemoryAccountingToken token(MemoryCategory::BLOBS, 128);
+      auto during = accounting.get(MemoryCategory::BLOBS);
+      KJ_ASSERT(during.count == before.count + 1);
+      KJ_ASSERT(during.externalBytes == before.externalBytes + 128);
+    }
+    auto after = accounting.get(MemoryCategory::BLOBS);
+    KJ_ASSERT(after.count == before.count);
+    KJ_ASSERT(after.externalBytes == before.externalBytes);
+  });
+}
+
 }  // namespace
 }  // namespace workerd::jsg::test
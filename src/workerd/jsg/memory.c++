@@ -1,4 +1,5 @@
 #include "memory.h"
+#include "setup.h"
 #include <kj/one-of.h>
 
 namespace workerd::jsg {
@@ -184,6 +185,26 @@ void MemoryTracker::addEdge(MemoryRetainerNode* node, kj::StringPtr edgeName) {
 
 // ======================================================================================
 
+MemoryAccountingToken::MemoryAccountingToken(MemoryCategory category, size_t externalBytes)
+    : category(category), externalBytes(externalBytes) {
+  // TryGetCurrent() returns null when we're not running under an isolate (e.g. FormData
+  // parsing outside the isolate lock); such objects are not attributed to anyone.
+  v8::Isolate* isolate = v8::Isolate::TryGetCurrent();
+  if (isolate != nullptr) {
+    auto& a = IsolateBase::from(isolate).getMemoryAccounting();
+    a.add(category, externalBytes);
+    accounting = a;
+  }
+}
+
+MemoryAccountingToken::~MemoryAccountingToken() noexcept(false) {
+  KJ_IF_SOME(a, accounting) {
+    a.subtract(category, externalBytes);
+  }
+}
+
+// ======================================================================================
+
 HeapSnapshotActivity::HeapSnapshotActivity(Callback callback): callback(kj::mv(callback)) {}
 
 v8::ActivityControl::ControlOption HeapSnapshotActivity::ReportProgressValue(
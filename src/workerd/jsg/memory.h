@@ -17,6 +17,7 @@
 #include <kj/string.h>
 #include <v8-profiler.h>
 #include <v8-array-buffer.h>
+#include <atomic>
 #include <stack>
 #include <string>
 
@@ -662,6 +663,95 @@ inline void visitSubclassForMemoryInfo(const T* obj, MemoryTracker& tracker) {
   }
 }
 
+// ======================================================================================
+// Continuous per-category accounting
+//
+// The embedder graph above gives full attribution but is only computed while generating
+// a heap snapshot, which pauses the isolate for seconds on large heaps. For the much more
+// common question "what kind of objects are bloating this isolate right now" we keep a
+// handful of always-on per-isolate counters, updated by selected API objects at
+// construction and destruction. Reading them is a few relaxed atomic loads, so they can
+// be sampled by metrics collection at any frequency without stopping JavaScript.
+
+// The categories of API objects we account for continuously. These are deliberately
+// coarse: each category corresponds to a kind of object that has historically shown up
+// in isolate memory investigations.
+enum class MemoryCategory : uint8_t {
+  // ReadableStream / WritableStream instances.
+  STREAMS,
+  // CryptoKey instances.
+  CRYPTO_KEYS,
+  // Blob / File instances. externalBytes counts the data owned directly by the blob;
+  // slices referencing a parent blob count as instances only.
+  BLOBS,
+  // SqlStorage::Cursor instances.
+  SQL_CURSORS,
+
+  // Must be last; not a real category.
+  COUNT_,
+};
+
+// The per-isolate set of counters, one slot per MemoryCategory. Owned by IsolateBase;
+// use IsolateBase::getMemoryAccounting() to read it.
+class MemoryAccounting final {
+public:
+  MemoryAccounting() = default;
+  KJ_DISALLOW_COPY_AND_MOVE(MemoryAccounting);
+
+  struct Totals {
+    // Number of live instances in the category.
+    size_t count;
+    // Bytes held outside the V8 heap by those instances, for categories that report them.
+    size_t externalBytes;
+  };
+
+  inline Totals get(MemoryCategory category) const {
+    auto& c = categories[static_cast<size_t>(category)];
+    return {
+      .count = c.count.load(std::memory_order_relaxed),
+      .externalBytes = c.externalBytes.load(std::memory_order_relaxed),
+    };
+  }
+
+private:
+  struct Counters {
+    std::atomic<size_t> count{0};
+    std::atomic<size_t> externalBytes{0};
+  };
+  Counters categories[static_cast<size_t>(MemoryCategory::COUNT_)];
+
+  inline void add(MemoryCategory category, size_t externalBytes) {
+    auto& c = categories[static_cast<size_t>(category)];
+    c.count.fetch_add(1, std::memory_order_relaxed);
+    c.externalBytes.fetch_add(externalBytes, std::memory_order_relaxed);
+  }
+
+  inline void subtract(MemoryCategory category, size_t externalBytes) {
+    auto& c = categories[static_cast<size_t>(category)];
+    c.count.fetch_sub(1, std::memory_order_relaxed);
+    c.externalBytes.fetch_sub(externalBytes, std::memory_order_relaxed);
+  }
+
+  friend class MemoryAccountingToken;
+};
+
+// RAII member for API objects participating in continuous accounting: increments its
+// category's counters on construction and decrements them on destruction. The token
+// resolves the isolate at construction time, so it is safe to destroy from the deferred
+// destruction queue. Objects constructed while no isolate is active (e.g. FormData
+// parsed outside the isolate lock by the fiddle service) are simply not attributed.
+class MemoryAccountingToken final {
+public:
+  explicit MemoryAccountingToken(MemoryCategory category, size_t externalBytes = 0);
+  ~MemoryAccountingToken() noexcept(false);
+  KJ_DISALLOW_COPY_AND_MOVE(MemoryAccountingToken);
+
+private:
+  kj::Maybe<MemoryAccounting&> accounting;
+  MemoryCategory category;
+  size_t externalBytes;
+};
+
 // ======================================================================================
 
 class HeapSnapshotActivity final: public v8::ActivityControl {
@@ -6,6 +6,7 @@
 #include <workerd/jsg/jsg.h>
 #include <workerd/jsg/function.h>
 #include <workerd/jsg/util.h>
+#include <workerd/util/autogate.h>
 #include <kj/mutex.h>
 #include <kj/table.h>
 
@@ -48,6 +49,18 @@ ModuleBundle::Type toModuleBuilderType(ModuleBundle::BuiltinBuilder::Type type)
   KJ_UNREACHABLE;
 }
 
+// Code cache entries for built-in ES modules, shared process-wide. Built-in sources are
+// compiled into the binary and registered with every isolate, but each worker script gets its
+// own Module instances, so a per-instance cache would still compile each built-in once per
+// script. Keying on the source content lets the first isolate in the process to import a given
+// built-in pay the compile cost while every later import consumes the cached code.
+using BuiltinCodeCache =
+    kj::HashMap<kj::ArrayPtr<const char>, kj::Own<v8::ScriptCompiler::CachedData>>;
+kj::MutexGuarded<BuiltinCodeCache>& builtinCodeCache() {
+  static kj::MutexGuarded<BuiltinCodeCache> cache;
+  return cache;
+}
+
 class EsModule final : public Module {
 public:
   explicit EsModule(Url specifier, Type type, Flags flags, kj::Array<const char> source)
@@ -95,7 +108,15 @@ public:
     v8::ScriptCompiler::CachedData* data = nullptr;
     auto options = v8::ScriptCompiler::CompileOptions::kNoCompileOptions;
 
-    {
+    if (externed) {
+      // Externed sources are compiled into the binary, so consult the process-wide cache.
+      auto lock = builtinCodeCache().lockShared();
+      KJ_IF_SOME(c, lock->find(ptr)) {
+        // We new here because v8 will take ownership of the CachedData instance,
+        // even tho we are maintaining ownership of the underlying buffer.
+        data = new v8::ScriptCompiler::CachedData(c->data, c->length);
+      }
+    } else {
       // Check to see if we have cached compilation data for this module.
       auto lock = cachedData.lockShared();
       KJ_IF_SOME(c, *lock) {
@@ -124,24 +145,46 @@ public:
       }
     }
 
+    if (options == v8::ScriptCompiler::CompileOptions::kNoCompileOptions &&
+        type() == Type::BUNDLE &&
+        util::Autogate::isEnabled(util::AutogateKey::EAGER_SCRIPT_COMPILE)) {
+      // No cached data to consume; compile the whole bundle module eagerly at startup rather
+      // than letting V8 lazily compile each function body on a request's critical path. With
+      // --parallel-compile-tasks-for-eager-toplevel (set in setup.c++), V8 spreads the inner
+      // function compiles across its worker threads rather than doing them all serially here.
+      options = v8::ScriptCompiler::CompileOptions::kEagerCompile;
+    }
+
     v8::Local<v8::Module> module;
 
     if (!v8::ScriptCompiler::CompileModule(js.v8Isolate, &source, options).ToLocal(&module)) {
       return v8::MaybeLocal<v8::Module>();
     }
 
-    // If the options are still kNoCompileOptions, then we did not have or use cached
-    // data. We should generate the cache now, if possible. We lock to ensure that
-    // we do not generate the cache multiple times needlessly. When the lock is acquired
-    // we check again to see if the cache is still empty, and skip generating if it is not.
-    if (options == v8::ScriptCompiler::CompileOptions::kNoCompileOptions) {
-      auto lock = cachedData.lockExclusive();
-      if (*lock == kj::none) {
-        auto ptr = v8::ScriptCompiler::CreateCodeCache(module->GetUnboundModuleScript());
-        if (ptr != nullptr) {
-          kj::Own<v8::ScriptCompiler::CachedData> cached(ptr,
-              kj::_::HeapDisposer<v8::ScriptCompiler::CachedData>::instance);
-          *lock = kj::mv(cached);
+    // If we did not consume cached data above, we should generate the cache now, if
+    // possible. We lock to ensure that we do not generate the cache multiple times
+    // needlessly. When the lock is acquired we check again to see if the cache is still
+    // empty, and skip generating if it is not.
+    if (options != v8::ScriptCompiler::CompileOptions::kConsumeCodeCache) {
+      if (externed) {
+        auto lock = builtinCodeCache().lockExclusive();
+        if (lock->find(ptr) == kj::none) {
+          auto cachePtr = v8::ScriptCompiler::CreateCodeCache(module->GetUnboundModuleScript());
+          if (cachePtr != nullptr) {
+            kj::Own<v8::ScriptCompiler::CachedData> cached(cachePtr,
+                kj::_::HeapDisposer<v8::ScriptCompiler::CachedData>::instance);
+            lock->insert(ptr, kj::mv(cached));
+          }
+        }
+      } else {
+        auto lock = cachedData.lockExclusive();
+        if (*lock == kj::none) {
+          auto cachePtr = v8::ScriptCompiler::CreateCodeCache(module->GetUnboundModuleScript());
+          if (cachePtr != nullptr) {
+            kj::Own<v8::ScriptCompiler::CachedData> cached(cachePtr,
+                kj::_::HeapDisposer<v8::ScriptCompiler::CachedData>::instance);
+            *lock = kj::mv(cached);
+          }
         }
       }
     }
@@ -824,6 +867,11 @@ public:
 
     {
       auto lock = cache.lockExclusive();
+      // Re-check under the exclusive lock in case another thread resolved the module
+      // while we weren't holding any lock.
+      KJ_IF_SOME(found, lock->storage.find(context.specifier)) {
+        return kj::Maybe<Module&>(const_cast<Module&>(*found));
+      }
       KJ_IF_SOME(resolved, callback(context)) {
         Module& module = *resolved;
         lock->storage.upsert(context.specifier.clone(), kj::mv(resolved));
@@ -874,7 +922,19 @@ public:
       return resolve(newContext);
     }
 
+    {
+      // Once a specifier has been resolved for any isolate sharing this bundle, later
+      // resolutions (including warm starts of other isolates of the same script) are
+      // pure cache hits, so take only a shared lock for them.
+      auto lock = cache.lockShared();
+      KJ_IF_SOME(cached, lock->find(context.specifier)) {
+        return checkModule(context, *cached);
+      }
+    }
+
     auto lock = cache.lockExclusive();
+    // Re-check under the exclusive lock in case another thread resolved the module
+    // while we weren't holding any lock.
     KJ_IF_SOME(cached, lock->find(context.specifier)) {
       return checkModule(context, *cached);
     }
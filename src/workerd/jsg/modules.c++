@@ -5,7 +5,10 @@
 #include "jsg.h"
 #include "promise.h"
 #include "setup.h"
+#include <workerd/util/autogate.h>
+#include <kj/map.h>
 #include <kj/mutex.h>
+#include <kj/vector.h>
 #include <set>
 
 namespace workerd::jsg {
@@ -396,13 +399,36 @@ void NonModuleScript::run(v8::Local<v8::Context> context) const {
   check(boundScript->Run(context));
 }
 
-NonModuleScript NonModuleScript::compile(kj::StringPtr code, jsg::Lock& js, kj::StringPtr name) {
+kj::Maybe<kj::Array<kj::byte>> NonModuleScript::serializeCodeCache(jsg::Lock& js) const {
+  auto cached = std::unique_ptr<v8::ScriptCompiler::CachedData>(
+      v8::ScriptCompiler::CreateCodeCache(unboundScript.Get(js.v8Isolate)));
+  if (cached == nullptr) return kj::none;
+  return kj::heapArray<kj::byte>(kj::arrayPtr(cached->data, cached->length));
+}
+
+NonModuleScript NonModuleScript::compile(kj::StringPtr code, jsg::Lock& js, kj::StringPtr name,
+    kj::Maybe<kj::ArrayPtr<const kj::byte>> maybeCodeCache) {
   // Create a dummy script origin for it to appear in Sources panel.
   auto isolate = js.v8Isolate;
   v8::ScriptOrigin origin(v8StrIntern(isolate, name));
+  KJ_IF_SOME(codeCache, maybeCodeCache) {
+    // The Source takes ownership of the CachedData instance, which borrows the caller's bytes.
+    // The caller's bytes only need to remain valid for the duration of the compile.
+    v8::ScriptCompiler::Source source(v8Str(isolate, code), origin,
+        new v8::ScriptCompiler::CachedData(codeCache.begin(), codeCache.size(),
+            v8::ScriptCompiler::CachedData::BufferNotOwned));
+    return NonModuleScript(js,
+        check(v8::ScriptCompiler::CompileUnboundScript(isolate, &source,
+            v8::ScriptCompiler::kConsumeCodeCache)));
+  }
+  // Like bundle ESM modules, service-worker scripts compile once at startup, so eager
+  // compilation moves V8's lazy function compilation off the first request's critical path.
+  auto options = util::Autogate::isEnabled(util::AutogateKey::EAGER_SCRIPT_COMPILE)
+      ? v8::ScriptCompiler::kEagerCompile
+      : v8::ScriptCompiler::kNoCompileOptions;
   v8::ScriptCompiler::Source source(v8Str(isolate, code), origin);
   return NonModuleScript(js,
-      check(v8::ScriptCompiler::CompileUnboundScript(isolate, &source)));
+      check(v8::ScriptCompiler::CompileUnboundScript(isolate, &source, options)));
 }
 
 void instantiateModule(jsg::Lock& js, v8::Local<v8::Module>& module) {
@@ -508,8 +534,15 @@ v8::Local<v8::Module> compileEsmModule(
 
   contentStr = jsg::v8Str(js.v8Isolate, content);
 
+  // Bundle modules are compiled once at worker startup, so when eager compilation is enabled we
+  // pay for full compilation there rather than letting V8 lazily compile each function body the
+  // first time a request calls it.
+  auto options = util::Autogate::isEnabled(util::AutogateKey::EAGER_SCRIPT_COMPILE)
+      ? v8::ScriptCompiler::kEagerCompile
+      : v8::ScriptCompiler::kNoCompileOptions;
+
   v8::ScriptCompiler::Source source(contentStr, origin);
-  auto module = jsg::check(v8::ScriptCompiler::CompileModule(js.v8Isolate, &source));
+  auto module = jsg::check(v8::ScriptCompiler::CompileModule(js.v8Isolate, &source, options));
 
   return module;
 }
@@ -575,15 +608,75 @@ ModuleRegistry::CapnpModuleInfo::CapnpModuleInfo(
       topLevelDecls(kj::mv(topLevelDecls)) {}
 
 
+namespace {
+
+// Process-wide cache of compiled Wasm modules, keyed by their wire bytes. V8 compiles Wasm in a
+// process-wide engine, so a v8::CompiledWasmModule produced in one isolate can be instantiated
+// in any other via FromCompiledModule(), sharing both the compilation work and the generated
+// code memory. Without this, every isolate loading the same Wasm dependency (Pyodide core, image
+// codecs, ...) recompiles it and keeps its own copy of the code.
+//
+// Entries are keyed by a hash of the wire bytes and verified against the cached module's own
+// wire bytes, so hash collisions merely fall back to a scan. The cache is never evicted: the set
+// of distinct Wasm modules is bounded by the configuration, and the wire bytes are retained by
+// the compiled module itself either way.
+class CompiledWasmModuleCache {
+public:
+  kj::Maybe<v8::CompiledWasmModule> find(kj::ArrayPtr<const uint8_t> code) {
+    auto lock = entries.lockExclusive();
+    KJ_IF_SOME(bucket, lock->find(kj::hashCode(code))) {
+      for (auto& compiled: bucket) {
+        auto wire = compiled.GetWireBytesRef();
+        if (kj::arrayPtr(wire.data(), wire.size()) == code) {
+          return compiled;
+        }
+      }
+    }
+    return kj::none;
+  }
+
+  void insert(v8::CompiledWasmModule compiled) {
+    auto wire = compiled.GetWireBytesRef();
+    auto code = kj::arrayPtr(wire.data(), wire.size());
+    auto lock = entries.lockExclusive();
+    auto& bucket = lock->findOrCreate(kj::hashCode(code), [&]() {
+      return Map::Entry { kj::hashCode(code), kj::Vector<v8::CompiledWasmModule>() };
+    });
+    for (auto& existing: bucket) {
+      auto existingWire = existing.GetWireBytesRef();
+      if (kj::arrayPtr(existingWire.data(), existingWire.size()) == code) {
+        // Another isolate compiled the same module concurrently; keep the existing entry.
+        return;
+      }
+    }
+    bucket.add(kj::mv(compiled));
+  }
+
+private:
+  using Map = kj::HashMap<uint, kj::Vector<v8::CompiledWasmModule>>;
+  kj::MutexGuarded<Map> entries;
+};
+
+CompiledWasmModuleCache compiledWasmModuleCache;
+
+}  // namespace
+
 v8::Local<v8::WasmModuleObject> compileWasmModule(jsg::Lock& js,
     kj::ArrayPtr<const uint8_t> code,
     const CompilationObserver& observer) {
+  KJ_IF_SOME(compiled, compiledWasmModuleCache.find(code)) {
+    auto metrics = observer.onWasmCompilationFromCacheStart(js.v8Isolate);
+    return jsg::check(v8::WasmModuleObject::FromCompiledModule(js.v8Isolate, compiled));
+  }
+
   // destroy the observer after compilation finishes to indicate the end of the process.
   auto compilationObserver = observer.onWasmCompilationStart(js.v8Isolate, code.size());
 
-  return jsg::check(v8::WasmModuleObject::Compile(
+  auto wasmModule = jsg::check(v8::WasmModuleObject::Compile(
       js.v8Isolate,
       v8::MemorySpan<const uint8_t>(code.begin(), code.size())));
+  compiledWasmModuleCache.insert(wasmModule->GetCompiledModule());
+  return wasmModule;
 }
 
 // ======================================================================================
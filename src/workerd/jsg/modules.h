@@ -176,7 +176,16 @@ public:
 
   v8::Local<v8::Value> runAndReturn(v8::Local<v8::Context> context) const;
 
-  static jsg::NonModuleScript compile(kj::StringPtr code, jsg::Lock& js, kj::StringPtr name = "worker.js");
+  // Serializes V8's code cache data for this script. The returned bytes can be passed to a
+  // later compile() of the same source (in any isolate with the same V8 configuration) to skip
+  // most of the parse/compile work. Returns none if V8 declines to produce cache data.
+  kj::Maybe<kj::Array<kj::byte>> serializeCodeCache(jsg::Lock& js) const;
+
+  // Compiles the given source. If `maybeCodeCache` is provided, it must be data previously
+  // produced by serializeCodeCache() for the same source; V8 verifies the data and silently
+  // falls back to a full compile if it is stale or mismatched.
+  static jsg::NonModuleScript compile(kj::StringPtr code, jsg::Lock& js, kj::StringPtr name = "worker.js",
+      kj::Maybe<kj::ArrayPtr<const kj::byte>> maybeCodeCache = kj::none);
 
 private:
   v8::Global<v8::UnboundScript> unboundScript;
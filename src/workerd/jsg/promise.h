@@ -144,6 +144,27 @@ struct ThenCatchPair {
   CatchFunc catchFunc;
 };
 
+// A ThenCatchPair carries no state when both sides are captureless lambdas (which are empty
+// and, since C++20, default-constructible) or the placeholder `bool` used for the unused side
+// of the pair. Such a pair need not be opaque-wrapped and stored on the continuation at all:
+// it can be reconstructed from its type alone when the continuation runs, saving a refcounted
+// wrapper allocation plus a V8 object per .then()/.catch_(). Continuations that capture
+// nothing are common in deep native promise chains, so this adds up.
+template <typename T>
+constexpr bool isStatelessContinuationFunc() {
+  return (kj::isSameType<T, bool>()) ||
+      (std::is_empty_v<T> && std::is_default_constructible_v<T>);
+}
+
+template <typename FuncPair>
+constexpr bool isStatelessFuncPair_ = false;
+template <typename ThenFunc, typename CatchFunc>
+constexpr bool isStatelessFuncPair_<ThenCatchPair<ThenFunc, CatchFunc>> =
+    isStatelessContinuationFunc<ThenFunc>() && isStatelessContinuationFunc<CatchFunc>();
+
+template <typename FuncPair>
+constexpr bool isStatelessFuncPair() { return isStatelessFuncPair_<kj::Decay<FuncPair>>; }
+
 // FunctionCallback implementing a C++ .then() continuation on a JS promise.
 //
 // We expect the input is already an opaque-wrapped value, args.Data() is an opaque-wrapped C++
@@ -158,7 +179,14 @@ void promiseContinuation(const v8::FunctionCallbackInfo<v8::Value>& args) {
     // so it's likely to be caught in debug, and we'd like to avoid the extra overhead in releases.
     DISALLOW_KJ_IO_DESTRUCTORS_SCOPE;
 #endif
-    auto funcPair = unwrapOpaque<FuncPairType>(isolate, args.Data());
+    auto funcPair = [&]() {
+      if constexpr (isStatelessFuncPair<FuncPairType>()) {
+        // A stateless pair is never materialized or attached as data; see thenImpl().
+        return FuncPairType{};
+      } else {
+        return unwrapOpaque<FuncPairType>(isolate, args.Data());
+      }
+    }();
 #ifdef KJ_DEBUG
     kj::AllowAsyncDestructorsScope allowAsyncDestructors;
 #endif
@@ -199,7 +227,9 @@ void promiseContinuation(const v8::FunctionCallbackInfo<v8::Value>& args) {
 template <typename FuncPairType, bool isCatch>
 void identityPromiseContinuation(const v8::FunctionCallbackInfo<v8::Value>& args) {
   auto isolate = args.GetIsolate();
-  dropOpaque<FuncPairType>(isolate, args.Data());
+  if constexpr (!isStatelessFuncPair<FuncPairType>()) {
+    dropOpaque<FuncPairType>(isolate, args.Data());
+  }
   if constexpr (isCatch) {
     isolate->ThrowException(args[0]);
   } else {
@@ -421,7 +451,12 @@ private:
     return js.withinHandleScope([&] {
       auto context = js.v8Context();
 
-      auto funcPairHandle = wrapOpaque(context, kj::mv(funcPair));
+      // Stateless continuations are reconstructed from their type when invoked, so there is
+      // nothing to attach as data; see isStatelessFuncPair().
+      v8::Local<v8::Value> funcPairHandle;
+      if constexpr (!isStatelessFuncPair<FuncPair>()) {
+        funcPairHandle = wrapOpaque(context, kj::mv(funcPair));
+      }
 
       auto then = check(v8::Function::New(
           context, thenCallback, funcPairHandle, 1, v8::ConstructorBehavior::kThrow));
@@ -178,6 +178,11 @@ struct ConstructorCallback<TypeWrapper, T, Unimplemented(Args...), kj::_::Indexe
 };
 
 // Implements the V8 callback function for calling a method of the C++ class.
+//
+// Note that each JSG_METHOD declaration produces a distinct instantiation of this template, whose
+// `callback` is a direct static function pointer installed on the v8::FunctionTemplate. Dispatch
+// from JS to the C++ method therefore involves no runtime lookup through the TypeWrapper mixin
+// hierarchy -- argument unwrapping and return-value wrapping are resolved at compile time.
 template <typename TypeWrapper, const char* methodName, bool isContext,
           typename T, typename Method, Method method, typename Indexes>
 struct MethodCallback;
@@ -1045,6 +1050,31 @@ struct ResourceTypeBuilder {
     prototype->Set(isolate, name, typeWrapper.getTemplate(isolate, (Type*)nullptr));
   }
 
+  // Like registerNestedType(), but defers building the nested type's FunctionTemplate until
+  // the first time the property is actually read. The property lives on the instance template
+  // (like registerLazyInstanceProperty()); on first access V8 invokes the callback below, which
+  // builds the template and replaces the property with the resulting constructor function.
+  template<typename Type, const char* name>
+  inline void registerLazyNestedType() {
+    static_assert(Type::JSG_KIND == ::workerd::jsg::JsgKind::RESOURCE,
+        "Type is not a resource type, and therefore cannot not be declared nested");
+
+    constexpr auto hasGetTemplate = ::workerd::jsg::isDetected<
+        ::workerd::jsg::HasGetTemplateOverload, decltype(typeWrapper), Type>();
+    static_assert(hasGetTemplate,
+          "Type must be listed in JSG_DECLARE_ISOLATE_TYPE to be declared nested.");
+
+    instance->SetLazyDataProperty(v8StrIntern(isolate, name),
+        [](v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& info) {
+      liftKj(info, [&]() {
+        auto isolate = info.GetIsolate();
+        auto& wrapper = TypeWrapper::from(isolate);
+        return check(wrapper.getTemplate(isolate, (Type*)nullptr)
+            ->GetFunction(isolate->GetCurrentContext()));
+      });
+    });
+  }
+
   inline void registerTypeScriptRoot() { /* only needed for RTTI */ }
 
   template<const char* tsOverride>
@@ -1160,6 +1190,9 @@ struct JsSetup {
   template<typename Type, const char* name>
   inline void registerNestedType() { }
 
+  template<typename Type, const char* name>
+  inline void registerLazyNestedType() { }
+
   inline void registerTypeScriptRoot() { }
 
   template<const char* tsOverride>
@@ -577,6 +577,9 @@ struct MemberCounter {
   template<typename Type, const char* name>
   inline void registerNestedType() { ++members; }
 
+  template<typename Type, const char* name>
+  inline void registerLazyNestedType() { ++members; }
+
   template<const char* name, typename Property, auto property>
   inline void registerStructProperty() { ++members; }
 
@@ -658,6 +661,11 @@ struct MembersBuilder {
     BuildRtti<Configuration, Type>::build(nested.initStructure(), rtti);
   }
 
+  // Laziness is a runtime optimization only; for type information purposes a lazy nested type
+  // is just a nested type.
+  template<typename Type, const char* name>
+  inline void registerLazyNestedType() { registerNestedType<Type, name>(); }
+
   template<const char* name, typename Getter, Getter getter, typename Setter, Setter setter>
   inline void registerInstanceProperty() {
     auto prop = members[memberIndex++].initProperty();
@@ -314,6 +314,14 @@ JsValue structuredClone(
     Lock& js,
     const JsValue& value,
     kj::Maybe<kj::Array<JsValue>> maybeTransfer) {
+  if (maybeTransfer == kj::none && !value.isObject() && !value.isSymbol()) {
+    // Primitives (other than symbols) are immutable and structured-clone to themselves, so the
+    // serialize/deserialize round trip would just hand back an equivalent value. Symbols are not
+    // cloneable -- fall through so the serializer throws DataCloneError. With a transfer list we
+    // also fall through so that the listed ArrayBuffers get detached.
+    return value;
+  }
+
   Serializer ser(js);
   KJ_IF_SOME(transfers, maybeTransfer) {
     for (auto& item : transfers) {
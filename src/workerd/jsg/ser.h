@@ -278,6 +278,9 @@ protected:
 };
 constexpr SerializedBufferDisposer SERIALIZED_BUFFER_DISPOSER;
 
+// Deep-clones a value by passing it through the serializer. As an optimization, non-symbol
+// primitives are returned as-is (they are immutable, so the round trip would be a no-op), unless
+// a transfer list is given, in which case the serializer must run to detach the listed buffers.
 JsValue structuredClone(
     Lock& js,
     const JsValue& value,
@@ -115,6 +115,14 @@ V8System::V8System(kj::Own<v8::Platform> platformParam, kj::ArrayPtr<const kj::S
   // more flags.)
   v8::V8::SetFlagsFromString("--noincremental-marking");
 
+  // Let V8 farm the compile phase of eager toplevel compilation out to the platform's worker
+  // threads instead of compiling every function body serially on the isolate thread. This mainly
+  // benefits module graphs compiled with kEagerCompile (see modules-new.c++), where the inner
+  // functions of each module can be compiled in parallel while parsing proceeds. Instantiation
+  // and evaluation ordering are unaffected; V8 joins outstanding compile tasks before the
+  // compiled script is used.
+  v8::V8::SetFlagsFromString("--parallel-compile-tasks-for-eager-toplevel");
+
 #ifdef __APPLE__
   // On macOS arm64, we find that V8 can be collecting pages that contain compiled code when
   // handling requests in short succession. There are some specific differences for macOS arm64
@@ -315,6 +323,86 @@ namespace {
   }
 }
 
+namespace {
+
+// State for the process-wide memory governor; see IsolateBase::setProcessMemoryTarget().
+std::atomic<size_t> processMemoryTarget{0};
+std::atomic<bool> processMemoryPressureHigh{false};
+
+kj::MutexGuarded<kj::HashSet<IsolateBase*>>& isolateRegistry() {
+  static kj::MutexGuarded<kj::HashSet<IsolateBase*>> registry;
+  return registry;
+}
+
+}  // namespace
+
+void IsolateBase::setProcessMemoryTarget(size_t bytes) {
+  processMemoryTarget.store(bytes, std::memory_order_relaxed);
+}
+
+void IsolateBase::updateMemoryUsageFromGc(
+    v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags, void* data) noexcept {
+  auto& self = *reinterpret_cast<IsolateBase*>(data);
+  v8::HeapStatistics stats;
+  isolate->GetHeapStatistics(&stats);
+  self.lastObservedMemoryUsage.store(stats.used_heap_size() + stats.external_memory(),
+      std::memory_order_relaxed);
+}
+
+void IsolateBase::relieveProcessMemoryPressure(IsolateBase* source) {
+  size_t target = processMemoryTarget.load(std::memory_order_relaxed);
+  if (target == 0) return;
+
+  auto lock = isolateRegistry().lockShared();
+  size_t total = 0;
+  for (auto& iso: *lock) {
+    total += iso->lastObservedMemoryUsage.load(std::memory_order_relaxed);
+  }
+
+  if (total < target) {
+    // Hysteresis: only re-arm once aggregate usage has fallen comfortably below the target, so
+    // an aggregate hovering right at the line doesn't trigger a GC storm. On the falling edge,
+    // restore every isolate to the moderate baseline pressure level that the embedder sets at
+    // isolate creation, undoing the critical level left behind by the notifications below.
+    if (total < target - target / 8 &&
+        processMemoryPressureHigh.exchange(false, std::memory_order_relaxed)) {
+      for (auto& iso: *lock) {
+        iso->ptr->MemoryPressureNotification(v8::MemoryPressureLevel::kModerate);
+      }
+    }
+    return;
+  }
+
+  // Aggregate usage crossed the target; act once per crossing.
+  if (processMemoryPressureHigh.exchange(true, std::memory_order_relaxed)) return;
+
+  // Poke the largest idle isolate and the largest isolate overall (other than the caller, which
+  // just collected). Collecting in an idle isolate reclaims memory without pausing any request;
+  // the overall largest is included because the biggest heap is where the reclaimable bytes are.
+  // MemoryPressureNotification() is safe to call from a foreign thread: V8 posts the GC to the
+  // isolate's own task runner.
+  IsolateBase* largest = nullptr;
+  IsolateBase* largestIdle = nullptr;
+  for (auto& iso: *lock) {
+    if (iso == source) continue;
+    size_t usage = iso->lastObservedMemoryUsage.load(std::memory_order_relaxed);
+    if (largest == nullptr ||
+        usage > largest->lastObservedMemoryUsage.load(std::memory_order_relaxed)) {
+      largest = iso;
+    }
+    if (!iso->ptr->IsInUse() && (largestIdle == nullptr ||
+        usage > largestIdle->lastObservedMemoryUsage.load(std::memory_order_relaxed))) {
+      largestIdle = iso;
+    }
+  }
+  if (largestIdle != nullptr) {
+    largestIdle->ptr->MemoryPressureNotification(v8::MemoryPressureLevel::kCritical);
+  }
+  if (largest != nullptr && largest != largestIdle) {
+    largest->ptr->MemoryPressureNotification(v8::MemoryPressureLevel::kCritical);
+  }
+}
+
 IsolateBase::IsolateBase(const V8System& system, v8::Isolate::CreateParams&& createParams,
                          kj::Own<IsolateObserver> observer)
     : system(system),
@@ -362,6 +450,9 @@ IsolateBase::IsolateBase(const V8System& system, v8::Isolate::CreateParams&& cre
 
     ptr->GetHeapProfiler()->AddBuildEmbedderGraphCallback(buildEmbedderGraph, this);
 
+    // Keep lastObservedMemoryUsage current for the process memory governor.
+    ptr->AddGCEpilogueCallback(&updateMemoryUsageFromGc, this);
+
     {
       // We don't need a v8::Locker here since there's no way another thread could be using the
       // isolate yet, but we do need v8::Isolate::Scope.
@@ -379,9 +470,12 @@ IsolateBase::IsolateBase(const V8System& system, v8::Isolate::CreateParams&& cre
               v8::NewStringType::kInternalized).ToLocalChecked()));
     }
   });
+
+  isolateRegistry().lockExclusive()->insert(this);
 }
 
 IsolateBase::~IsolateBase() noexcept(false) {
+  isolateRegistry().lockExclusive()->eraseMatch(this);
   jsg::runInV8Stack([&](jsg::V8StackScope& stackScope) {
     ptr->Dispose();
     cppHeap.reset();;
@@ -392,6 +486,45 @@ v8::Local<v8::FunctionTemplate> IsolateBase::getOpaqueTemplate(v8::Isolate* isol
   return reinterpret_cast<IsolateBase*>(isolate->GetData(0))->opaqueTemplate.Get(isolate);
 }
 
+v8::Local<v8::String> IsolateBase::getInternedString(kj::StringPtr text) {
+  KJ_IF_SOME(handle, internedStrings.find(text)) {
+    return handle.Get(ptr);
+  }
+
+  auto result = check(v8::String::NewFromUtf8(
+      ptr, text.begin(), v8::NewStringType::kInternalized, text.size()));
+  if (internedStrings.size() < INTERNED_STRING_CACHE_LIMIT) {
+    internedStrings.insert(kj::str(text), v8::Global<v8::String>(ptr, result));
+  }
+  return result;
+}
+
+void IsolateBase::runIdleGc() {
+  v8::HeapStatistics stats;
+  ptr->GetHeapStatistics(&stats);
+
+  // Skip the collection unless the heap grew meaningfully since the last one.
+  // LowMemoryNotification() performs a full compacting collection, which is not free even when
+  // there is little garbage, and an isolate that bounces in and out of idleness shouldn't pay
+  // for it on every transition.
+  constexpr size_t IDLE_GC_MIN_GROWTH = 4 * 1024 * 1024;
+  if (stats.used_heap_size() < lastIdleGcHeapSize + IDLE_GC_MIN_GROWTH) {
+    // Even when skipping the collection, this is an idle transition -- a cheap moment to check
+    // whether the process as a whole needs memory relief.
+    relieveProcessMemoryPressure(this);
+    return;
+  }
+
+  ptr->LowMemoryNotification();
+
+  ptr->GetHeapStatistics(&stats);
+  lastIdleGcHeapSize = stats.used_heap_size();
+  lastObservedMemoryUsage.store(stats.used_heap_size() + stats.external_memory(),
+      std::memory_order_relaxed);
+
+  relieveProcessMemoryPressure(this);
+}
+
 void IsolateBase::dropWrappers(kj::Own<void> typeWrapperInstance) {
   // Delete all wrappers.
   jsg::runInV8Stack([&](jsg::V8StackScope& stackScope) {
@@ -408,6 +541,7 @@ void IsolateBase::dropWrappers(kj::Own<void> typeWrapperInstance) {
     // Make sure v8::Globals are destroyed under lock (but not until later).
     KJ_DEFER(symbolAsyncDispose.Reset());
     KJ_DEFER(opaqueTemplate.Reset());
+    KJ_DEFER(internedStrings.clear());
 
     // Make sure the TypeWrapper is destroyed under lock by declaring a new copy of the variable
     // that is destroyed before the lock is released.
@@ -32,6 +32,15 @@ kj::Own<v8::Platform> defaultPlatform(uint backgroundThreadCount);
 // In order to use any part of the JSG API, you must first construct a V8System. You can only
 // construct one of these per process. This performs process-wide initialization of the V8
 // library.
+//
+// Note on custom startup snapshots: it is tempting to bake the global scope templates and
+// intrinsics into a custom V8 snapshot blob to cut isolate cold-start time. This does not work
+// for JSG isolates. A snapshot can only contain C++ pointers that appear in a static
+// external-references table, but JSG installs a distinct template-instantiated callback for
+// every method and property of every resource type, and wrapper objects carry raw pointers in
+// internal fields and context embedder data slots that V8 cannot serialize. The templates are
+// instead built lazily per type (see ResourceWrapper::getTemplate()), so an isolate only pays
+// for the types it actually touches; compiled-code caching covers the script side.
 class V8System {
 public:
   // Use the default v8::Platform implementation, as if by:
@@ -153,6 +162,10 @@ public:
 
   IsolateObserver& getObserver() { return *observer; }
 
+  // The continuously-updated per-category memory counters for this isolate. See the
+  // documentation in memory.h. Safe to read from any thread, without the isolate lock.
+  MemoryAccounting& getMemoryAccounting() { return memoryAccounting; }
+
   // Implementation of MemoryRetainer
   void jsgGetMemoryInfo(MemoryTracker& tracker) const;
   kj::StringPtr jsgGetMemoryName() const { return "IsolateBase"_kjc; }
@@ -163,6 +176,28 @@ public:
     return JsSymbol(symbolAsyncDispose.Get(ptr));
   }
 
+  // Returns a handle to an internalized copy of `text`, caching the handle on the isolate so that
+  // repeated conversions of the same hot string (header names, MIME types, event names) reuse a
+  // single V8 heap allocation instead of re-hashing and re-copying the characters on every call.
+  // Interned strings live for the life of the isolate anyway, so the cache adds no extra
+  // retention; it is capped, and once full, further strings are internalized without caching.
+  v8::Local<v8::String> getInternedString(kj::StringPtr text);
+
+  // Runs a garbage collection now if the heap has grown meaningfully since the last idle
+  // collection, so that GC debt is paid down outside any user-visible latency window. Call only
+  // when the embedder knows the isolate is otherwise idle (e.g. no active or queued requests),
+  // with the isolate lock held. Cheap when there is little garbage to collect.
+  void runIdleGc();
+
+  // Sets the aggregate memory target, in bytes, for all isolates in this process. When the sum
+  // of every isolate's heap plus external memory crosses the target, the process-wide governor
+  // sends critical memory pressure notifications to the largest other isolates (idle ones
+  // preferred, since collecting there pauses no request), prompting V8 to run full GCs and
+  // shrink them. The pressure level is restored once aggregate usage falls back below 7/8 of
+  // the target, providing hysteresis against flapping. Zero (the default) disables
+  // coordination; each isolate then reacts only to its own heap limit.
+  static void setProcessMemoryTarget(size_t bytes);
+
 private:
   template <typename TypeWrapper>
   friend class Isolate;
@@ -199,6 +234,24 @@ private:
   kj::Maybe<kj::String> uuid;
   bool evalAllowed = false;
 
+  // Heap usage observed at the end of the last runIdleGc() collection, used to skip idle
+  // collections when little has been allocated since.
+  size_t lastIdleGcHeapSize = 0;
+
+  // Used heap size plus external memory observed at the end of this isolate's most recent GC.
+  // Read cross-thread by the process memory governor; see setProcessMemoryTarget().
+  std::atomic<size_t> lastObservedMemoryUsage{0};
+
+  // GC epilogue callback keeping `lastObservedMemoryUsage` current. Does nothing but read heap
+  // statistics and store the atomic, so it is safe to run inside the GC callback context.
+  static void updateMemoryUsageFromGc(
+      v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags, void* data) noexcept;
+
+  // Evaluates the process memory target and pokes other isolates if aggregate usage crossed
+  // it. Called from runIdleGc(), i.e. at isolate-idle transitions, so governor work never
+  // delays a request on this thread.
+  static void relieveProcessMemoryPressure(IsolateBase* source);
+
   // The Web Platform API specifications require that any API that returns a JavaScript Promise
   // should never throw errors synchronously. Rather, they are supposed to capture any synchronous
   // throws and return a rejected Promise. Historically, Workers did not follow that guideline
@@ -220,6 +273,15 @@ private:
   // Polyfilled Symbol.asyncDispose.
   v8::Global<v8::Symbol> symbolAsyncDispose;
 
+  // If the interned-string cache reaches this many entries, further strings are internalized
+  // without caching. The set of strings passed to getInternedString() is expected to be small
+  // (property names and the like spelled out in C++ code), so the cap exists only as a safety
+  // valve in case some call site starts feeding it request-derived data.
+  static constexpr size_t INTERNED_STRING_CACHE_LIMIT = 1024;
+
+  // Cache of handles to internalized strings, see getInternedString().
+  kj::HashMap<kj::String, v8::Global<v8::String>> internedStrings;
+
   // We expect queues to remain relatively small -- 8 is the largest size I have observed from local
   // testing.
   static constexpr auto DESTRUCTION_QUEUE_INITIAL_SIZE = 8;
@@ -282,6 +344,7 @@ private:
 
   HeapTracer heapTracer;
   kj::Own<IsolateObserver> observer;
+  MemoryAccounting memoryAccounting;
 
   friend class Data;
   friend class Wrappable;
@@ -369,6 +369,15 @@ private:
 //
 // Note that a pointer to the TypeWrapper object is stored in the V8 context's "embedder data",
 // in slot 1, so that we can get back to it from V8 callbacks.
+//
+// Although the mixin inheritance may look like it implies dynamic dispatch, it does not: all of
+// the wrap()/tryUnwrap() overloads aggregated via the `using` declarations below are resolved by
+// ordinary C++ overload resolution at compile time, and every JSG_METHOD / JSG_*_PROPERTY
+// declaration instantiates its own static callback (see MethodCallback et al. in resource.h)
+// which is installed directly on the v8::FunctionTemplate. So there is no per-call walk of the
+// wrapper chain to optimize away; the per-call overhead of a JS->C++ call consists only of the
+// callback's own fixed prologue (fetching the current context, loading the TypeWrapper from
+// isolate data, and extracting the wrapped object's internal pointer).
 template <typename Self, typename... T>
 class TypeWrapper: public DynamicResourceTypeMap<Self>,
                    public TypeWrapperBase<Self, T>...,
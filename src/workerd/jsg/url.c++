@@ -168,6 +168,16 @@ kj::Maybe<Url> Url::tryParse(kj::ArrayPtr<const char> input,
   return Url(wrap(result));
 }
 
+kj::Array<kj::Maybe<Url>> Url::tryParseBatch(
+    kj::ArrayPtr<const kj::ArrayPtr<const char>> inputs,
+    kj::Maybe<kj::ArrayPtr<const char>> base) {
+  auto builder = kj::heapArrayBuilder<kj::Maybe<Url>>(inputs.size());
+  for (auto& input: inputs) {
+    builder.add(tryParse(input, base));
+  }
+  return builder.finish();
+}
+
 kj::Maybe<Url> Url::resolve(kj::ArrayPtr<const char> input) {
   return tryParse(input, getHref());
 }
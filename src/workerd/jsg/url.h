@@ -68,6 +68,14 @@ public:
                                  kj::Maybe<kj::StringPtr> base = kj::none)
                                  KJ_WARN_UNUSED_RESULT;
 
+  // Parses many inputs, optionally against a shared base, in a single call. The results are
+  // delivered in one allocation (entries are kj::none where the corresponding input failed to
+  // parse) rather than paying a separate allocation and call per URL, which matters for callers
+  // that validate or normalize URL lists in bulk.
+  static kj::Array<kj::Maybe<Url>> tryParseBatch(
+      kj::ArrayPtr<const kj::ArrayPtr<const char>> inputs,
+      kj::Maybe<kj::ArrayPtr<const char>> base = kj::none) KJ_WARN_UNUSED_RESULT;
+
   kj::Array<const char> getOrigin() const KJ_WARN_UNUSED_RESULT;
   kj::ArrayPtr<const char> getProtocol() const KJ_LIFETIMEBOUND KJ_WARN_UNUSED_RESULT;
   kj::ArrayPtr<const char> getHref() const KJ_LIFETIMEBOUND KJ_WARN_UNUSED_RESULT;
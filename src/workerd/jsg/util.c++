@@ -21,6 +21,10 @@ bool getCaptureThrowsAsRejections(v8::Isolate* isolate) {
   return jsgIsolate.getCaptureThrowsAsRejections();
 }
 
+v8::Local<v8::String> v8StrInternCached(v8::Isolate* isolate, kj::StringPtr str) {
+  return IsolateBase::from(isolate).getInternedString(str);
+}
+
 bool getCommonJsExportDefault(v8::Isolate* isolate) {
   auto& jsgIsolate = *reinterpret_cast<IsolateBase*>(isolate->GetData(0));
   return jsgIsolate.getCommonJsExportDefault();
@@ -209,7 +213,16 @@ DecodedException decodeTunneledException(v8::Isolate* isolate,
           auto& js = Lock::from(isolate);
           auto errorName = kj::str(errorType.slice(0, closeParen));
           auto message = appMessage(errorType.slice(1 + closeParen));
-          auto exception = js.domException(kj::mv(errorName), kj::str(message));
+          // DISCONNECTED exceptions (e.g. AbortError from a client hanging up mid-stream) are
+          // decoded while resuming from I/O, where there are no JS frames to capture -- the
+          // stack would format as just "Name: message" anyway. Synthesize that string directly
+          // instead of paying for a per-instance V8 stack walk; these fire on every torn-down
+          // stream, so construction cost matters more than usual here.
+          kj::Maybe<kj::String> stack;
+          if (excType == kj::Exception::Type::DISCONNECTED) {
+            stack = kj::str(errorName, ": ", message);
+          }
+          auto exception = js.domException(kj::mv(errorName), kj::str(message), kj::mv(stack));
           result.handle = KJ_ASSERT_NONNULL(exception.tryGetHandle(js));
           break;
         }
@@ -256,6 +256,12 @@ inline v8::Local<v8::String> v8StrIntern(v8::Isolate* isolate, kj::StringPtr str
   return v8Str(isolate, str, v8::NewStringType::kInternalized);
 }
 
+// Like v8StrIntern(), but caches the resulting handle on the isolate (see
+// IsolateBase::getInternedString()). Prefer this for strings that are converted over and over on
+// hot paths, like well-known property names. Not defined inline due to cyclic dependency with
+// setup.h.
+v8::Local<v8::String> v8StrInternCached(v8::Isolate* isolate, kj::StringPtr str);
+
 template <typename T> constexpr bool isVoid() { return false; }
 template <> constexpr bool isVoid<void>() { return true; }
 
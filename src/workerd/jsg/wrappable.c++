@@ -299,6 +299,16 @@ void Wrappable::traceFromV8(cppgc::Visitor& cppgcVisitor) {
   jsgVisitForGc(visitor);
 }
 
+// TODO(perf): A "lightweight wrap" mode for small leaf objects — embedder fields only, skipping
+//   the TracedReference and shim registration below — has been floated for cutting per-wrap cost
+//   on hot allocation paths. It doesn't pay off in this design: every wrapper must be findable by
+//   HeapTracer for forced cleanup at isolate shutdown, and ResetRoot()/detachWrapper() assume the
+//   full bookkeeping exists. The cheap cases are already cheap: droppable TracedReferences let V8
+//   discard wrappers of objects only reachable from C++, and the CppgcShim freelist recycles shim
+//   allocations across minor GCs. Objects that never cross into JS never get here at all (e.g.
+//   Headers entries are plain strings inside one wrapped Headers; BufferSources share the V8
+//   BackingStore rather than wrapping per view). If wrap cost shows up in profiles again, measure
+//   allocateShim() and the visitation pass below before reaching for a second object model.
 void Wrappable::attachWrapper(v8::Isolate* isolate,
                               v8::Local<v8::Object> object, bool needsGcTracing) {
   auto& tracer = HeapTracer::getTracer(isolate);
@@ -37,9 +37,15 @@ AlarmScheduler::AlarmScheduler(
         return kj::mv(db);
       }()),
       tasks(*this) {
+    tasks.add(runTimerQueue());
     loadAlarmsFromDb();
   }
 
+AlarmScheduler::~AlarmScheduler() noexcept(false) {
+  // Make sure buffered writes reach the database before it is closed.
+  flushPendingWrites();
+}
+
 void AlarmScheduler::ensureInitialized(SqliteDatabase& db) {
   // TODO(sqlite): Do this automatically at a lower layer?
   db.run("PRAGMA journal_mode=WAL;");
@@ -98,9 +104,70 @@ kj::Maybe<kj::Date> AlarmScheduler::getAlarm(ActorKey actor) {
   }
 }
 
+void AlarmScheduler::queueWrite(const ActorKey& actor, kj::Maybe<kj::Date> scheduledTime) {
+  if (scheduledTime == kj::none && alarms.find(actor) == kj::none &&
+      pendingWrites.find(actor) == kj::none) {
+    // Deleting a row that neither the database nor the write buffer knows about is a no-op;
+    // don't schedule a flush for it.
+    return;
+  }
+
+  auto& write = pendingWrites.findOrCreate(actor, [&]() {
+    auto owned = actor.clone();
+    auto& keyRef = *owned;
+    return decltype(pendingWrites)::Entry {
+        keyRef, PendingWrite { kj::mv(owned), scheduledTime } };
+  });
+  write.scheduledTime = scheduledTime;
+  ensureFlushScheduled();
+}
+
+void AlarmScheduler::ensureFlushScheduled() {
+  if (!flushScheduled) {
+    flushScheduled = true;
+    tasks.add(kj::evalLast([this]() {
+      flushScheduled = false;
+      flushPendingWrites();
+    }));
+  }
+}
+
+void AlarmScheduler::flushPendingWrites() {
+  if (pendingWrites.size() == 0) return;
+
+  auto writes = kj::mv(pendingWrites);
+  pendingWrites.clear();
+
+  db->run("BEGIN TRANSACTION");
+  try {
+    for (auto& write: writes) {
+      KJ_IF_SOME(time, write.value.scheduledTime) {
+        stmtSetAlarm.run(write.key.uniqueKey, write.key.actorId,
+            (time - kj::UNIX_EPOCH) / kj::NANOSECONDS);
+      } else {
+        stmtDeleteAlarm.run(write.key.uniqueKey, write.key.actorId);
+      }
+    }
+    db->run("COMMIT");
+  } catch (...) {
+    auto exception = kj::getCaughtExceptionAsKj();
+    KJ_LOG(ERROR, "Failed to flush alarm writes to disk", exception);
+    db->run("ROLLBACK");
+  }
+}
+
+bool AlarmScheduler::alarmInDb(const ActorKey& actor) {
+  KJ_IF_SOME(write, pendingWrites.find(actor)) {
+    return write.scheduledTime != kj::none;
+  }
+  KJ_IF_SOME(alarm, alarms.find(actor)) {
+    return alarm.rowExists;
+  }
+  return false;
+}
+
 bool AlarmScheduler::setAlarm(ActorKey actor, kj::Date scheduledTime) {
-  int64_t scheduledTimeNs = (scheduledTime - kj::UNIX_EPOCH) / kj::NANOSECONDS;
-  auto query = stmtSetAlarm.run(actor.uniqueKey, actor.actorId, scheduledTimeNs);
+  queueWrite(actor, scheduledTime);
 
   bool existing = true;
   auto& entry = alarms.findOrCreate(actor, [&]() {
@@ -124,12 +191,15 @@ bool AlarmScheduler::setAlarm(ActorKey actor, kj::Date scheduledTime) {
       entry = scheduleAlarm(clock.now(), kj::mv(entry.actor), scheduledTime);
     }
   }
+  entry.rowExists = true;
 
-  return query.changeCount() > 0;
+  // The buffered write is an upsert, which always touches exactly one row.
+  return true;
 }
 
 bool AlarmScheduler::deleteAlarm(ActorKey actor) {
-  auto query = stmtDeleteAlarm.run(actor.uniqueKey, actor.actorId);
+  bool existed = alarmInDb(actor);
+  queueWrite(actor, kj::none);
 
   KJ_IF_SOME(entry, alarms.findEntry(actor)) {
     KJ_IF_SOME(queued, entry.value.queuedAlarm) {
@@ -138,16 +208,19 @@ bool AlarmScheduler::deleteAlarm(ActorKey actor) {
         entry.value.queuedAlarm = kj::none;
       } else {
         entry.value = scheduleAlarm(clock.now(), kj::mv(entry.value.actor), queued);
+        entry.value.rowExists = false;
       }
     } else {
       if (entry.value.status != AlarmStatus::STARTED) {
         // We can't remove running alarms.
         alarms.erase(entry);
+      } else {
+        entry.value.rowExists = false;
       }
     }
   }
 
-  return query.changeCount() > 0;
+  return existed;
 }
 
 kj::Promise<AlarmScheduler::RetryInfo> AlarmScheduler::runAlarm(
@@ -171,24 +244,55 @@ AlarmScheduler::ScheduledAlarm AlarmScheduler::scheduleAlarm(
   return ScheduledAlarm { kj::mv(actor), scheduledTime, kj::mv(task) };
 }
 
-kj::Promise<void> AlarmScheduler::checkTimestamp(kj::Duration delay, kj::Date scheduledTime) {
-  co_await timer.afterDelay(delay);
+kj::Promise<void> AlarmScheduler::waitUntilScheduled(kj::Date scheduledTime) {
+  auto paf = kj::newPromiseAndFulfiller<void>();
 
-  // Since we are waiting on timer.afterDelay, it's possible that timer.now() was behind
-  // the real time by a few ms, leading to premature alarm() execution. This checks it the current
-  // time is >= than scheduledTime to ensure we run alarms only on or after their scheduled time.
-  auto now = clock.now();
-  if (now < scheduledTime) {
-    // If it's not yet time to trigger the alarm, we shall wait a while longer until we can
-    // trigger it. This repeats until it's time for the alarm to run.
-    co_await checkTimestamp(scheduledTime - now, scheduledTime);
+  bool newEarliest = timerQueue.empty() || scheduledTime < timerQueue.begin()->first;
+  timerQueue.insert(std::make_pair(scheduledTime, kj::mv(paf.fulfiller)));
+
+  if (newEarliest) {
+    KJ_IF_SOME(wakeup, timerQueueWakeup) {
+      wakeup->fulfill();
+      timerQueueWakeup = kj::none;
+    }
+  }
+
+  return kj::mv(paf.promise);
+}
+
+kj::Promise<void> AlarmScheduler::runTimerQueue() {
+  for (;;) {
+    auto wakeup = kj::newPromiseAndFulfiller<void>();
+    timerQueueWakeup = kj::mv(wakeup.fulfiller);
+
+    if (timerQueue.empty()) {
+      co_await wakeup.promise;
+      continue;
+    }
+
+    auto delay = kj::max(0 * kj::SECONDS, timerQueue.begin()->first - clock.now());
+    co_await timer.afterDelay(delay).exclusiveJoin(kj::mv(wakeup.promise));
+
+    // Since we are waiting on timer.afterDelay, it's possible that timer.now() was behind
+    // the real time by a few ms, leading to premature alarm() execution. Deadlines are only
+    // fired once `clock` agrees they are due; otherwise the loop just re-arms the timer for
+    // the remaining duration.
+    auto now = clock.now();
+    while (!timerQueue.empty() && timerQueue.begin()->first <= now) {
+      auto entry = timerQueue.begin();
+      auto fulfiller = kj::mv(entry->second);
+      timerQueue.erase(entry);
+      fulfiller->fulfill();
+    }
   }
 }
 
 kj::Promise<void> AlarmScheduler::makeAlarmTask(kj::Duration delay,
                                                 const ActorKey& actorRef,
                                                 kj::Date scheduledTime) {
-  co_await checkTimestamp(delay, scheduledTime);
+  // Wait out the requested delay, but never fire before the scheduled time itself. (Retries pass
+  // the original scheduled time along with a backoff delay relative to now.)
+  co_await waitUntilScheduled(kj::max(clock.now() + delay, scheduledTime));
   uint32_t retryCount = 0;
   {
     auto& entry = KJ_ASSERT_NONNULL(alarms.findEntry(actorRef));
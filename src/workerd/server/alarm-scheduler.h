@@ -11,6 +11,7 @@
 #include <kj/timer.h>
 #include <kj/map.h>
 
+#include <map>
 #include <random>
 
 #include <workerd/util/sqlite.h>
@@ -65,6 +66,7 @@ public:
     kj::Timer& timer,
     const SqliteDatabase::Vfs& vfs,
     kj::PathPtr path);
+  ~AlarmScheduler() noexcept(false);
 
   kj::Maybe<kj::Date> getAlarm(ActorKey actor);
   bool setAlarm(ActorKey actor, kj::Date scheduledTime);
@@ -104,10 +106,39 @@ private:
 
     // Counter for retry attempts that apply to the retry limit.
     uint32_t countedRetry = 0;
+
+    // Whether the alarm currently has a row in the database (counting writes that are still
+    // buffered in `pendingWrites`). This can be false while the entry remains in memory, e.g.
+    // when deleteAlarm() is called on a running alarm.
+    bool rowExists = true;
   };
 
   kj::HashMap<ActorKey, ScheduledAlarm> alarms;
 
+  // A database write that has been applied to the in-memory alarm set but not yet to SQLite.
+  // A scheduledTime of kj::none means the row should be deleted.
+  struct PendingWrite {
+    kj::Own<ActorKey> actor;
+    kj::Maybe<kj::Date> scheduledTime;
+  };
+
+  // Buffered writes, keyed the same way as `alarms` (the key references strings owned by the
+  // value). Writes to the same actor collapse to the latest one, and the whole batch is flushed
+  // to SQLite in a single transaction at the end of the current event loop turn, so a burst of
+  // alarm activity costs one fsync rather than one per alarm.
+  kj::HashMap<ActorKey, PendingWrite> pendingWrites;
+  bool flushScheduled = false;
+
+  // Records a write for the given actor and schedules a flush if one isn't already queued.
+  void queueWrite(const ActorKey& actor, kj::Maybe<kj::Date> scheduledTime);
+  void ensureFlushScheduled();
+
+  // Applies all of `pendingWrites` to the database in one transaction.
+  void flushPendingWrites();
+
+  // Whether the actor has an alarm row, taking buffered writes into account.
+  bool alarmInDb(const ActorKey& actor);
+
   struct RetryInfo {
     bool retry;
     bool retryCountsAgainstLimit;
@@ -120,7 +151,22 @@ private:
 
   kj::Promise<void> makeAlarmTask(kj::Duration delay, const ActorKey& actor, kj::Date scheduledTime);
 
-  kj::Promise<void> checkTimestamp(kj::Duration delay, kj::Date scheduledTime);
+  // All pending alarm deadlines, ordered by time. A single dispatcher task (`runTimerQueue`)
+  // keeps one kj::Timer registration armed for the earliest entry, so scheduling an alarm is an
+  // O(log n) insert here rather than a separate timer registration per actor. Entries whose
+  // waiter has been canceled (e.g. the alarm was rescheduled) are discarded lazily when their
+  // deadline passes, at which point fulfilling them is a no-op.
+  std::multimap<kj::Date, kj::Own<kj::PromiseFulfiller<void>>> timerQueue;
+
+  // Fulfilled by waitUntilScheduled() when a new earliest deadline arrives, waking the dispatcher
+  // so it can re-arm its timer.
+  kj::Maybe<kj::Own<kj::PromiseFulfiller<void>>> timerQueueWakeup;
+
+  // Returns a promise that resolves once `clock` reaches `scheduledTime`.
+  kj::Promise<void> waitUntilScheduled(kj::Date scheduledTime);
+
+  // Dispatcher loop servicing `timerQueue`.
+  kj::Promise<void> runTimerQueue();
 
   SqliteDatabase::Statement stmtSetAlarm = db->prepare(R"(
     INSERT INTO _cf_ALARM VALUES(?, ?, ?)
@@ -644,6 +644,46 @@ KJ_TEST("Server: serve basic modular Worker") {
   conn.httpGet200("/", "Hello: http://foo/");
 }
 
+KJ_TEST("Server: --prewarm sends a warming dispatch before live traffic") {
+  TestServer test(singleWorker(R"((
+    compatibilityDate = "2022-08-17",
+    modules = [
+      ( name = "main.js",
+        esModule =
+          `let dispatches = 0;
+          `export default {
+          `  async fetch(request) {
+          `    return new Response("dispatch #" + ++dispatches);
+          `  }
+          `}
+      )
+    ]
+  ))"_kj));
+
+  test.server.enablePrewarm(kj::str("hello"));
+  test.start();
+
+  // The warming dispatch already ran the worker once, so the first live request observes the
+  // second dispatch.
+  auto conn = test.connect("test-addr");
+  conn.httpGet200("/", "dispatch #2");
+}
+
+KJ_TEST("Server: --prewarm with unknown service reports a config error") {
+  TestServer test(singleWorker(R"((
+    compatibilityDate = "2022-08-17",
+    serviceWorkerScript =
+        `addEventListener("fetch", event => {
+        `  event.respondWith(new Response("OK"));
+        `})
+  ))"_kj));
+
+  test.server.enablePrewarm(kj::str("no-such-service"));
+  test.expectErrors(
+      "Config defines no service named \"no-such-service\" to match the --prewarm option "
+      "provided on the command line.\n");
+}
+
 KJ_TEST("Server: serve modular Worker with imports") {
   TestServer test(singleWorker(R"((
     compatibilityDate = "2022-08-17",
@@ -1014,6 +1054,71 @@ KJ_TEST("Server: subrequest to default outbound") {
   )"_blockquote);
 }
 
+KJ_TEST("Server: admission control rejects requests over maxConcurrentRequests") {
+  TestServer test(singleWorker(R"((
+    compatibilityDate = "2022-08-17",
+    admissionControl = (maxConcurrentRequests = 1),
+    modules = [
+      ( name = "main.js",
+        esModule =
+          `export default {
+          `  async fetch(request, env) {
+          `    let resp = await fetch("http://subhost/foo");
+          `    return new Response("got: " + await resp.text());
+          `  }
+          `}
+      )
+    ]
+  ))"_kj));
+
+  test.start();
+
+  // The first request occupies the worker's only admission slot while its subrequest is pending.
+  auto conn = test.connect("test-addr");
+  conn.sendHttpGet("/");
+  auto subreq = test.receiveInternetSubrequest("subhost");
+  subreq.recv(R"(
+    GET /foo HTTP/1.1
+    Host: subhost
+
+  )"_blockquote);
+
+  // A second request is rejected up front rather than queuing behind the first.
+  auto conn2 = test.connect("test-addr");
+  conn2.sendHttpGet("/");
+  conn2.recv(R"(
+    HTTP/1.1 503 Service Unavailable
+    Content-Length: 19
+
+    Service Unavailable)"_blockquote);
+
+  // Completing the subrequest lets the first request finish normally.
+  subreq.send(R"(
+    HTTP/1.1 200 OK
+    Content-Length: 5
+
+    corge
+  )"_blockquote);
+  conn.recvHttp200("got: corge");
+
+  // With the slot free again, a new request is admitted.
+  auto conn3 = test.connect("test-addr");
+  conn3.sendHttpGet("/");
+  auto subreq2 = test.receiveInternetSubrequest("subhost");
+  subreq2.recv(R"(
+    GET /foo HTTP/1.1
+    Host: subhost
+
+  )"_blockquote);
+  subreq2.send(R"(
+    HTTP/1.1 200 OK
+    Content-Length: 5
+
+    corge
+  )"_blockquote);
+  conn3.recvHttp200("got: corge");
+}
+
 KJ_TEST("Server: override 'internet' service") {
   TestServer test(R"((
     services = [
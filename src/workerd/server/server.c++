@@ -10,6 +10,7 @@
 #include <kj/compat/url.h>
 #include <kj/encoding.h>
 #include <kj/map.h>
+#include <kj/thread.h>
 #include <capnp/message.h>
 #include <capnp/rpc-twoparty.h>
 #include <capnp/compat/json.h>
@@ -28,14 +29,29 @@
 #include <workerd/io/request-tracker.h>
 #include <workerd/util/http-util.h>
 #include <workerd/api/actor-state.h>
+#include <workerd/util/event-loop-health.h>
+#include <workerd/util/hot-metrics.h>
 #include <workerd/util/mimetype.h>
+#include <workerd/util/stream-utils.h>
 #include <workerd/util/uuid.h>
 #include <workerd/util/use-perfetto-categories.h>
 #include <workerd/api/worker-rpc.h>
+#include <v8-profiler.h>
 #include "workerd-api.h"
 #include "workerd/io/hibernation-manager.h"
 #include <stdlib.h>
 
+#if _WIN32
+#include <kj/win32-api-version.h>
+#include <windows.h>
+#include <kj/windows-sanity.h>
+#include <winsock2.h>
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#endif
+
 namespace workerd::server {
 
 namespace {
@@ -428,6 +444,11 @@ kj::Own<Server::Service> Server::makeInvalidConfigService() {
 // A NetworkAddress whose connect() method waits for a Promise<NetworkAddress> and then forwards
 // to it. Used by ExternalHttpService so that we don't have to wait for DNS lookup before the
 // server can start.
+//
+// The lookup is kicked off eagerly at construction (i.e. at service startup) rather than when
+// connect() is first awaited, so that the first subrequest over the binding doesn't pay the
+// resolution RTT; a lookup failure is held and rethrown from connect() per-request, same as
+// before.
 class PromisedNetworkAddress final: public kj::NetworkAddress {
   // TODO(cleanup): kj::Network should be extended with a new version of parseAddress() which does
   //   not do DNS lookup immediately, and therefore can return a NetworkAddress synchronously.
@@ -437,7 +458,7 @@ public:
   PromisedNetworkAddress(kj::Promise<kj::Own<kj::NetworkAddress>> promise)
       : promise(promise.then([this](kj::Own<kj::NetworkAddress> result) {
           addr = kj::mv(result);
-        }).fork()) {}
+        }).eagerlyEvaluate(nullptr).fork()) {}
 
   kj::Promise<kj::Own<kj::AsyncIoStream>> connect() override {
     KJ_IF_SOME(a, addr) {
@@ -473,10 +494,11 @@ private:
   kj::Maybe<kj::Own<kj::NetworkAddress>> addr;
 };
 
-class Server::ExternalTcpService final: public Service, private WorkerInterface {
+class Server::ExternalTcpService final: public Service, private WorkerInterface,
+                                        private kj::TaskSet::ErrorHandler {
 public:
-  ExternalTcpService(kj::Own<kj::NetworkAddress> addrParam)
-    : addr(kj::mv(addrParam)) {}
+  ExternalTcpService(kj::Own<kj::NetworkAddress> addrParam, kj::Timer& timer, uint poolSize)
+    : addr(kj::mv(addrParam)), timer(timer), poolSize(poolSize), refillTasks(*this) {}
 
   kj::Own<WorkerInterface> startRequest(IoChannelFactory::SubrequestMetadata metadata) override {
     return { this, kj::NullDisposer::instance };
@@ -488,6 +510,71 @@ public:
 
 private:
   kj::Own<kj::NetworkAddress> addr;
+  kj::Timer& timer;
+
+  // Close idle pooled connections after this long, so a binding that goes quiet drops back to
+  // zero open connections rather than pinning sockets on the back-end forever.
+  static constexpr auto POOLED_CONNECTION_IDLE_TIMEOUT = 60 * kj::SECONDS;
+
+  // An established connection waiting to be handed to the next connect() call. `watchTask`
+  // removes the entry if the peer disconnects or the idle timeout expires; it must be canceled
+  // (by dropping it) before the stream is given out, per KJ stream rules.
+  struct IdleConnection {
+    kj::Own<kj::AsyncIoStream> stream;
+    kj::Promise<void> watchTask = nullptr;
+  };
+
+  // Warm connection pool, newest last. Configured via `connectionPoolSize`; empty and unused
+  // when the pool size is zero. Because the pool is per-binding and the address (including any
+  // TLS wrapping) is fixed at config time, every pooled stream is interchangeable: its TCP and
+  // TLS handshakes completed when it was established in the background.
+  kj::Vector<IdleConnection> idlePool;
+  uint poolSize;
+  uint refillsInFlight = 0;
+  kj::TaskSet refillTasks;
+
+  void taskFailed(kj::Exception&& exception) override {
+    // A background refill failed, e.g. the back-end is down. Don't retry here; later connect()
+    // calls will connect directly (and report the failure to the worker) or refill the pool.
+    LOG_EXCEPTION("externalTcpPoolRefill", exception);
+  }
+
+  kj::Maybe<kj::Own<kj::AsyncIoStream>> tryGetPooledConnection() {
+    if (idlePool.size() == 0) return kj::none;
+    auto entry = kj::mv(idlePool[idlePool.size() - 1]);
+    idlePool.removeLast();
+    // Dropping `entry.watchTask` here cancels the disconnect/timeout watcher before the stream
+    // changes hands.
+    return kj::mv(entry.stream);
+  }
+
+  void ensurePoolFilled() {
+    while (idlePool.size() + refillsInFlight < poolSize) {
+      ++refillsInFlight;
+      refillTasks.add(refillOne());
+    }
+  }
+
+  kj::Promise<void> refillOne() {
+    KJ_DEFER(--refillsInFlight);
+    auto stream = co_await addr->connect();
+    auto& streamRef = *stream;
+    auto watchTask = streamRef.whenWriteDisconnected()
+        .exclusiveJoin(timer.afterDelay(POOLED_CONNECTION_IDLE_TIMEOUT))
+        .then([this, &streamRef]() {
+      for (auto i: kj::indices(idlePool)) {
+        if (idlePool[i].stream.get() == &streamRef) {
+          // This task cannot destroy itself, so park it on the task set before removing the
+          // entry; it completes immediately afterwards.
+          refillTasks.add(kj::mv(idlePool[i].watchTask));
+          idlePool[i] = kj::mv(idlePool[idlePool.size() - 1]);
+          idlePool.removeLast();
+          break;
+        }
+      }
+    });
+    idlePool.add(IdleConnection { kj::mv(stream), kj::mv(watchTask) });
+  }
 
   kj::Promise<void> request(
       kj::HttpMethod method, kj::StringPtr url, const kj::HttpHeaders& headers,
@@ -499,7 +586,16 @@ private:
       kj::StringPtr host, const kj::HttpHeaders& headers, kj::AsyncIoStream& connection,
       ConnectResponse& tunnel, kj::HttpConnectSettings settings) override {
       TRACE_EVENT("workerd", "ExternalTcpService::connect()", "host", host.cStr());
-      auto io_stream = co_await addr->connect();
+      kj::Own<kj::AsyncIoStream> io_stream;
+      auto maybePooled = tryGetPooledConnection();
+      KJ_IF_SOME(pooled, maybePooled) {
+        io_stream = kj::mv(pooled);
+      } else {
+        io_stream = co_await addr->connect();
+      }
+      // Replace what we just took (or prime the pool on first use) in the background, off the
+      // request's critical path.
+      ensurePoolFilled();
 
       auto promises = kj::heapArrayBuilder<kj::Promise<void>>(2);
 
@@ -517,7 +613,8 @@ private:
   }
 
   void prewarm(kj::StringPtr url) override {}
-  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron) override {
+  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron,
+      uint32_t shardIndex, uint32_t shardCount) override {
     throwUnsupported();
   }
   kj::Promise<AlarmResult> runAlarm(kj::Date scheduledTime, uint32_t retryCount) override {
@@ -540,9 +637,14 @@ public:
                       kj::Own<HttpRewriter> rewriter, kj::HttpHeaderTable& headerTable,
                       kj::Timer& timer, kj::EntropySource& entropySource,
                       capnp::ByteStreamFactory& byteStreamFactory,
-                      capnp::HttpOverCapnpFactory& httpOverCapnpFactory)
+                      capnp::HttpOverCapnpFactory& httpOverCapnpFactory,
+                      kj::Duration idleConnectionTimeout)
       : addr(kj::mv(addrParam)),
         inner(kj::newHttpClient(timer, headerTable, *addr, {
+          // The client is shared by all subrequests on this binding, so keepalive connections
+          // it retains are reused across requests. How long they linger while idle is
+          // per-binding config.
+          .idleTimeout = idleConnectionTimeout,
           .entropySource = entropySource,
           .webSocketCompressionMode = kj::HttpClientSettings::MANUAL_COMPRESSION
         })),
@@ -646,7 +748,8 @@ private:
     }
 
     void prewarm(kj::StringPtr url) override {}
-    kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron) override {
+    kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron,
+        uint32_t shardIndex, uint32_t shardCount) override {
       throwUnsupported();
     }
     kj::Promise<AlarmResult> runAlarm(kj::Date scheduledTime, uint32_t retryCount) override {
@@ -728,7 +831,8 @@ kj::Own<Server::Service> Server::makeExternalService(
       return kj::heap<ExternalHttpService>(
           kj::mv(addr), kj::mv(rewriter), headerTableBuilder.getFutureTable(),
           timer, entropySource, globalContext->byteStreamFactory,
-          globalContext->httpOverCapnpFactory);
+          globalContext->httpOverCapnpFactory,
+          conf.getHttp().getIdleConnectionTimeoutMs() * kj::MILLISECONDS);
     }
     case config::ExternalServer::HTTPS: {
       auto httpsConf = conf.getHttps();
@@ -742,7 +846,8 @@ kj::Own<Server::Service> Server::makeExternalService(
       return kj::heap<ExternalHttpService>(
           kj::mv(addr), kj::mv(rewriter), headerTableBuilder.getFutureTable(),
           timer, entropySource, globalContext->byteStreamFactory,
-          globalContext->httpOverCapnpFactory);
+          globalContext->httpOverCapnpFactory,
+          httpsConf.getOptions().getIdleConnectionTimeoutMs() * kj::MILLISECONDS);
     }
     case config::ExternalServer::TCP: {
       auto tcpConf = conf.getTcp();
@@ -755,7 +860,7 @@ kj::Own<Server::Service> Server::makeExternalService(
         addr = kj::heap<PromisedNetworkAddress>(
             makeTlsNetworkAddress(tcpConf.getTlsOptions(), addrStr, certificateHost, 0));
       }
-      return kj::heap<ExternalTcpService>(kj::mv(addr));
+      return kj::heap<ExternalTcpService>(kj::mv(addr), timer, tcpConf.getConnectionPoolSize());
     }
   }
   reportConfigError(kj::str(
@@ -813,7 +918,8 @@ private:
   }
 
   void prewarm(kj::StringPtr url) override {}
-  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron) override {
+  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron,
+      uint32_t shardIndex, uint32_t shardCount) override {
     throwUnsupported();
   }
   kj::Promise<AlarmResult> runAlarm(kj::Date scheduledTime, uint32_t retryCount) override {
@@ -1069,7 +1175,8 @@ private:
     throwUnsupported();
   }
   void prewarm(kj::StringPtr url) override {}
-  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron) override {
+  kj::Promise<ScheduledResult> runScheduled(kj::Date scheduledTime, kj::StringPtr cron,
+      uint32_t shardIndex, uint32_t shardCount) override {
     throwUnsupported();
   }
   kj::Promise<AlarmResult> runAlarm(kj::Date scheduledTime, uint32_t retryCount) override {
@@ -1369,9 +1476,119 @@ void Server::InspectorServiceIsolateRegistrar::registerIsolate(kj::StringPtr nam
 
 // =======================================================================================
 
+// LimitEnforcer used for workerd requests. It enforces no limits, but accounts the CPU time each
+// request spends in JavaScript using the thread CPU clock, sampled at the jsg lock boundaries
+// where enterJs()'s scope object is created and dropped. The per-request total is recorded in the
+// always-on "workerd_request_cpu_time_us" histogram (see util/hot-metrics.h, exported via
+// `--metrics-addr`) so that percentiles are available, and requests that burn an excessive amount
+// of CPU are logged, making scripts that would trend toward production CPU limits visible during
+// local development.
+class CpuAccountingLimitEnforcer final: public LimitEnforcer {
+public:
+  ~CpuAccountingLimitEnforcer() noexcept(false) {
+    static HotHistogram histogram("workerd_request_cpu_time_us");
+    histogram.record(cpuTime / kj::MICROSECONDS);
+    if (cpuTime >= CPU_WARNING_THRESHOLD) {
+      KJ_LOG(WARNING, "request used a large amount of CPU time", cpuTime);
+    }
+  }
+
+  kj::Own<void> enterJs(jsg::Lock& lock, IoContext& context) override {
+    KJ_IF_SOME(start, threadCpuNow()) {
+      return kj::heap<JsScope>(*this, start);
+    }
+    return {};
+  }
+  void topUpActor() override {}
+  void newSubrequest(bool isInHouse) override {}
+  void newKvRequest(KvOpType op) override {}
+  void newAnalyticsEngineRequest() override {}
+  kj::Promise<void> limitDrain() override { return kj::NEVER_DONE; }
+  kj::Promise<void> limitScheduled() override { return kj::NEVER_DONE; }
+  kj::Duration getAlarmLimit() override { return 15 * kj::MINUTES; }
+  size_t getBufferingLimit() override { return kj::maxValue; }
+  kj::Maybe<EventOutcome> getLimitsExceeded() override { return kj::none; }
+  kj::Promise<void> onLimitsExceeded() override { return kj::NEVER_DONE; }
+  void requireLimitsNotExceeded() override {}
+  void reportMetrics(RequestObserver& requestMetrics) override {}
+
+private:
+  // Chosen to be far above the CPU limits enforced in production so that it only flags scripts
+  // that would clearly be in trouble there, without nagging about ordinarily heavy workloads.
+  static constexpr kj::Duration CPU_WARNING_THRESHOLD = 300 * kj::MILLISECONDS;
+
+  // Total CPU time spent in JavaScript on behalf of this request.
+  kj::Duration cpuTime = 0 * kj::SECONDS;
+
+  // Returns the calling thread's consumed CPU time, or kj::none if the platform doesn't expose a
+  // cheap thread CPU clock.
+  static kj::Maybe<kj::Duration> threadCpuNow() {
+#if _WIN32
+    // TODO(someday): Use GetThreadTimes() or QueryThreadCycleTime() here.
+    return kj::none;
+#else
+    struct timespec ts;
+    KJ_SYSCALL(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts));
+    return ts.tv_sec * kj::SECONDS + ts.tv_nsec * kj::NANOSECONDS;
+#endif
+  }
+
+  class JsScope {
+  public:
+    JsScope(CpuAccountingLimitEnforcer& parent, kj::Duration start)
+        : parent(parent), start(start) {}
+    KJ_DISALLOW_COPY_AND_MOVE(JsScope);
+    ~JsScope() noexcept(false) {
+      // The scope is dropped on the same thread that created it, before the isolate lock is
+      // released, so the delta is exactly the CPU this JS execution consumed.
+      KJ_IF_SOME(end, threadCpuNow()) {
+        parent.cpuTime += end - start;
+      }
+    }
+
+  private:
+    CpuAccountingLimitEnforcer& parent;
+    kj::Duration start;
+  };
+};
+
+// IsolateObserver that additionally remembers how long the most recent isolate lock acquisition
+// spent waiting. The observer already sees every lock acquisition, so request admission control
+// (see `Worker.admissionControl` in workerd.capnp) can read contention from it without adding any
+// probes to the lock path itself.
+class LockWaitObserver final: public IsolateObserver {
+public:
+  // Wall time the most recent lock acquisition spent waiting before it got the lock.
+  kj::Duration getRecentLockWait() const {
+    return recentWaitNs.load(std::memory_order_relaxed) * kj::NANOSECONDS;
+  }
+
+  kj::Maybe<kj::Own<LockTiming>> tryCreateLockTiming(
+      kj::OneOf<SpanParent, kj::Maybe<RequestObserver&>> parentOrRequest) const override {
+    return kj::heap<Timing>(*this);
+  }
+
+private:
+  class Timing final: public LockTiming {
+  public:
+    explicit Timing(const LockWaitObserver& parent): parent(parent) {}
+    void start() override {
+      startTime = kj::systemPreciseMonotonicClock().now();
+    }
+    void locked() override {
+      auto wait = kj::systemPreciseMonotonicClock().now() - startTime;
+      parent.recentWaitNs.store(wait / kj::NANOSECONDS, std::memory_order_relaxed);
+    }
+  private:
+    const LockWaitObserver& parent;
+    kj::TimePoint startTime = kj::origin<kj::TimePoint>();
+  };
+
+  mutable std::atomic<uint64_t> recentWaitNs{0};
+};
+
 class Server::WorkerService final: public Service, private kj::TaskSet::ErrorHandler,
-                                   private IoChannelFactory, private TimerChannel,
-                                   private LimitEnforcer {
+                                   private IoChannelFactory, private TimerChannel {
 public:
   class ActorNamespace;
 
@@ -1386,16 +1603,27 @@ public:
   using LinkCallback = kj::Function<LinkedIoChannels(WorkerService&)>;
   using AbortActorsCallback = kj::Function<void()>;
 
+  // Parsed form of `Worker.admissionControl` from the config. Zero means "no limit".
+  struct AdmissionControlSettings {
+    uint maxConcurrentRequests = 0;
+    kj::Duration maxLockWait = 0 * kj::SECONDS;
+  };
+
   WorkerService(ThreadContext& threadContext, kj::Own<const Worker> worker,
                 kj::Maybe<kj::HashSet<kj::String>> defaultEntrypointHandlers,
                 kj::HashMap<kj::String, kj::HashSet<kj::String>> namedEntrypointsParam,
                 const kj::HashMap<kj::String, ActorConfig>& actorClasses,
-                LinkCallback linkCallback, AbortActorsCallback abortActorsCallback)
+                LinkCallback linkCallback, AbortActorsCallback abortActorsCallback,
+                AdmissionControlSettings admissionControl = {})
       : threadContext(threadContext),
         ioChannels(kj::mv(linkCallback)),
         worker(kj::mv(worker)),
         defaultEntrypointHandlers(kj::mv(defaultEntrypointHandlers)),
-        waitUntilTasks(*this), abortActorsCallback(kj::mv(abortActorsCallback)) {
+        waitUntilTasks(*this), abortActorsCallback(kj::mv(abortActorsCallback)),
+        lastRequestTime(threadContext.getUnsafeTimer().now()),
+        admissionControl(admissionControl),
+        lockWaitObserver(kj::dynamicDowncastIfAvailable<const LockWaitObserver>(
+            this->worker->getIsolate().getMetrics())) {
 
     namedEntrypoints.reserve(namedEntrypointsParam.size());
     for (auto& ep: namedEntrypointsParam) {
@@ -1418,6 +1646,12 @@ public:
     return KJ_MAP(e, namedEntrypoints) -> kj::StringPtr { return e.key; };
   }
 
+  // Returns a strong reference to this service's worker. Used by the diagnostics profiling
+  // endpoint, which needs the worker to stay alive across an unlocked sampling window.
+  kj::Own<const Worker> addRefWorker() const {
+    return kj::atomicAddRef(*worker);
+  }
+
   void link() override {
     LinkCallback callback = kj::mv(KJ_REQUIRE_NONNULL(
         ioChannels.tryGet<LinkCallback>(), "already called link()"));
@@ -1453,19 +1687,75 @@ public:
       IoChannelFactory::SubrequestMetadata metadata, kj::Maybe<kj::StringPtr> entrypointName,
       kj::Maybe<kj::Own<Worker::Actor>> actor = kj::none) {
     TRACE_EVENT("workerd", "Server::WorkerService::startRequest()");
+    lastRequestTime = threadContext.getUnsafeTimer().now();
+    idleGcDone = false;
+    if (idleGcTask == kj::none) {
+      idleGcTask = idleGcLoop().eagerlyEvaluate([](kj::Exception&& e) { KJ_LOG(ERROR, e); });
+    }
+    KJ_IF_SOME(exception, checkAdmission()) {
+      return WorkerInterface::fromException(kj::mv(exception));
+    }
+    ++concurrentRequests;
+    auto admissionSlot = kj::defer([this]() { --concurrentRequests; });
     return newWorkerEntrypoint(
         threadContext,
         kj::atomicAddRef(*worker),
         entrypointName,
         kj::mv(actor),
-        kj::Own<LimitEnforcer>(this, kj::NullDisposer::instance),
+        kj::heap<CpuAccountingLimitEnforcer>(),
         {},                        // ioContextDependency
         kj::Own<IoChannelFactory>(this, kj::NullDisposer::instance),
         kj::refcounted<RequestObserver>(),  // default observer makes no observations
         waitUntilTasks,
         true,                      // tunnelExceptions
         kj::none,                  // workerTracer
-        kj::mv(metadata.cfBlobJson));
+        kj::mv(metadata.cfBlobJson))
+        .attach(kj::mv(admissionSlot));
+  }
+
+  // Fast-fail admission check, run before any per-request objects are allocated. Returns the
+  // exception to fail the request with, or none to admit it. The lock-wait check only applies
+  // while other requests are in flight: the contention sample is only refreshed by new lock
+  // acquisitions, so with nothing in flight it is stale and must not keep rejecting traffic.
+  kj::Maybe<kj::Exception> checkAdmission() {
+    if (admissionControl.maxConcurrentRequests != 0 &&
+        concurrentRequests >= admissionControl.maxConcurrentRequests) {
+      return KJ_EXCEPTION(OVERLOADED,
+          "Worker is at its configured maxConcurrentRequests limit.");
+    }
+    if (admissionControl.maxLockWait != 0 * kj::SECONDS && concurrentRequests > 0) {
+      KJ_IF_SOME(o, lockWaitObserver) {
+        if (o.getRecentLockWait() > admissionControl.maxLockWait) {
+          return KJ_EXCEPTION(OVERLOADED,
+              "Worker's isolate lock wait time exceeds its configured admission budget.");
+        }
+      }
+    }
+    return kj::none;
+  }
+
+  // Trims this worker's isolate heap once the worker has gone quiet. Worker isolates in
+  // workerd live for the life of the process -- unlike durable objects they cannot be
+  // evicted and lazily recreated -- so the closest thing to evicting a cold isolate is
+  // collecting its garbage ahead of memory pressure. Keying the collection on each
+  // worker's own traffic means that when a memory spike does hit, V8's pressure-time GC
+  // finds the cold heaps already trimmed instead of pausing the hottest isolate.
+  kj::Promise<void> idleGcLoop() {
+    auto& timer = threadContext.getUnsafeTimer();
+    for (;;) {
+      co_await timer.afterDelay(IDLE_GC_PERIOD);
+      if (idleGcDone) continue;
+      if (timer.now() - lastRequestTime < IDLE_GC_PERIOD) continue;
+      // A request may still be in flight (we only track request starts); in that case the
+      // async lock waits for JavaScript to yield and the growth check in runIdleGc() keeps
+      // the collection cheap if there is little garbage.
+      auto workerRef = kj::atomicAddRef(*worker);
+      Worker::AsyncLock asyncLock = co_await workerRef->takeAsyncLockWithoutRequest(nullptr);
+      workerRef->runInLockScope(asyncLock, [&](Worker::Lock& lock) {
+        jsg::IsolateBase::from(lock.getIsolate()).runIdleGc();
+      });
+      idleGcDone = true;
+    }
   }
 
   class ActorNamespace final {
@@ -1551,11 +1841,22 @@ public:
       }
 
       void active() override {
-        // We're handling a new request, cancel the eviction promise.
+        // We're handling a new request, cancel the eviction promise and any pending idle
+        // collection or maintenance.
         shutdownTask = kj::none;
+        idleGcTask = kj::none;
+        idleDbMaintenanceTask = kj::none;
       }
 
       void inactive() override {
+        // Pay down GC debt while no request is watching. If a new request arrives first, the
+        // task is canceled in active() and the collection simply doesn't happen.
+        idleGcTask = handleIdleGc().eagerlyEvaluate([](kj::Exception&& e) { KJ_LOG(ERROR, e); });
+
+        // Similarly, refresh the actor database's query planner statistics while idle.
+        idleDbMaintenanceTask = handleIdleDbMaintenance()
+            .eagerlyEvaluate([](kj::Exception&& e) { KJ_LOG(ERROR, e); });
+
         // Durable objects are evictable by default.
         bool isEvictable = true;
         KJ_SWITCH_ONEOF(parent.config) {
@@ -1624,6 +1925,48 @@ public:
         actor = kj::none;
       }
 
+      // Runs a garbage collection in the actor's isolate once it has been idle for a moment,
+      // so that bursty actors pay GC debt between bursts rather than inside a request's
+      // latency window. The isolate-level growth check in runIdleGc() keeps this cheap when
+      // little has been allocated since the last collection.
+      kj::Promise<void> handleIdleGc() {
+        // Wait a moment so that back-to-back requests don't each pay for taking the isolate
+        // lock just to attempt a collection.
+        co_await timer.afterDelay(1 * kj::SECONDS);
+        KJ_IF_SOME(a, actor) {
+          auto& worker = a->getWorker();
+          auto workerStrongRef = kj::atomicAddRef(worker);
+          // As with handleShutdown(), there is no race here: if a new request comes in while
+          // we wait for the lock, active() cancels this promise.
+          Worker::AsyncLock asyncLock = co_await worker.takeAsyncLockWithoutRequest(nullptr);
+          workerStrongRef->runInLockScope(asyncLock, [&](Worker::Lock& lock) {
+            jsg::IsolateBase::from(lock.getIsolate()).runIdleGc();
+          });
+        }
+      }
+
+      // Runs a bounded slice of SQLite maintenance (`PRAGMA optimize`) on the actor's database
+      // once the actor has been idle for a moment, keeping query planner statistics fresh as the
+      // data changes. Long-lived actor databases otherwise keep running on whatever statistics
+      // the planner started with, and query plans slowly degrade.
+      kj::Promise<void> handleIdleDbMaintenance() {
+        // Wait a bit longer than the idle GC task does, so that a brief gap between requests
+        // pays for at most one kind of idle work.
+        co_await timer.afterDelay(5 * kj::SECONDS);
+        KJ_IF_SOME(a, actor) {
+          KJ_IF_SOME(cache, a->getPersistent()) {
+            KJ_IF_SOME(sqlite, kj::dynamicDowncastIfAvailable<ActorSqlite>(cache)) {
+              // This runs synchronously on the actor's event loop, and active() cancels this
+              // task before any new request starts, so it cannot interleave with request
+              // processing. Skip the round if a commit is still pending.
+              if (!sqlite.isCommitScheduled()) {
+                sqlite.runIdleMaintenance();
+              }
+            }
+          }
+        }
+      }
+
       kj::StringPtr getKey() { return key; }
       RequestTracker& getTracker() { return *tracker; }
       kj::Maybe<kj::Own<Worker::Actor::HibernationManager>> tryGetManagerRef() {
@@ -1650,6 +1993,8 @@ public:
       kj::TimePoint lastAccess;
       kj::Maybe<kj::Own<Worker::Actor::HibernationManager>> manager;
       kj::Maybe<kj::Promise<void>> shutdownTask;
+      kj::Maybe<kj::Promise<void>> idleGcTask;
+      kj::Maybe<kj::Promise<void>> idleDbMaintenanceTask;
       bool onBrokenTriggered = false;
 
       // Non-empty if at least one client has a reference to this actor.
@@ -1702,6 +2047,20 @@ public:
     kj::Maybe<kj::Promise<void>> cleanupTask;
     kj::Timer& timer;
 
+    // Created on first use: in-memory SQLite storage backing this namespace's Durable actors
+    // when the server has no durableObjectStorage disk configured. Owned by the namespace so
+    // that actor state outlives any individual Worker::Actor across idle evictions.
+    kj::Maybe<kj::Own<SqliteDatabase::Vfs>> inMemoryStorage;
+
+    SqliteDatabase::Vfs& getInMemoryStorage() {
+      KJ_IF_SOME(vfs, inMemoryStorage) {
+        return *vfs;
+      }
+      auto dir = kj::newInMemoryDirectory(kj::systemPreciseCalendarClock());
+      auto vfs = kj::heap<SqliteDatabase::Vfs>(*dir).attach(kj::mv(dir));
+      return *inMemoryStorage.emplace(kj::mv(vfs));
+    }
+
     // An owned actor and an ActorContainerRef
     // used to track the client that requested it.
     struct GetActorResult {
@@ -1844,28 +2203,35 @@ public:
                   ActorCache::Hooks& hooks) {
             return config.tryGet<Durable>()
                 .map([&](const Durable& d) -> kj::Own<ActorCacheInterface> {
+              // When no durableObjectStorage disk is configured, fall back to a
+              // namespace-owned in-memory VFS. Either way the actor's persisted state lives
+              // outside the Worker::Actor itself, in compact SQLite pages: idle eviction can
+              // drop the whole JS heap while the state survives, to be restored lazily the
+              // next time an event arrives. (Previously the diskless path used a
+              // never-flushed ActorCache that was destroyed together with the actor, so
+              // eviction lost all state.)
+              SqliteDatabase::Vfs* vfs;
               KJ_IF_SOME(as, channels.actorStorage) {
-                // The idPtr can end up being freed if the Actor gets hibernated so we need
-                // to create a copy that is ensured to live as long as the ActorSqliteHooks
-                // instance we're creating here.
-                // TODO(cleanup): Is there a better way to handle the ActorKey in general here?
-                auto idStr = kj::str(idPtr);
-                auto sqliteHooks = kj::heap<ActorSqliteHooks>(channels.alarmScheduler, ActorKey{
-                  .uniqueKey = d.uniqueKey, .actorId = idStr
-                }).attach(kj::mv(idStr));
-
-                auto db = kj::heap<SqliteDatabase>(*as,
-                    kj::Path({d.uniqueKey, kj::str(idPtr, ".sqlite")}),
-                    kj::WriteMode::CREATE | kj::WriteMode::MODIFY | kj::WriteMode::CREATE_PARENT);
-                return kj::heap<ActorSqlite>(kj::mv(db), outputGate,
-                    []() -> kj::Promise<void> { return kj::READY_NOW; },
-                    *sqliteHooks).attach(kj::mv(sqliteHooks));
+                vfs = as.get();
               } else {
-                // Create an ActorCache backed by a fake, empty storage. Elsewhere, we configure
-                // ActorCache never to flush, so this effectively creates in-memory storage.
-                return kj::heap<ActorCache>(
-                    kj::heap<EmptyReadOnlyActorStorageImpl>(), sharedLru, outputGate, hooks);
+                vfs = &getInMemoryStorage();
               }
+
+              // The idPtr can end up being freed if the Actor gets hibernated so we need
+              // to create a copy that is ensured to live as long as the ActorSqliteHooks
+              // instance we're creating here.
+              // TODO(cleanup): Is there a better way to handle the ActorKey in general here?
+              auto idStr = kj::str(idPtr);
+              auto sqliteHooks = kj::heap<ActorSqliteHooks>(channels.alarmScheduler, ActorKey{
+                .uniqueKey = d.uniqueKey, .actorId = idStr
+              }).attach(kj::mv(idStr));
+
+              auto db = kj::heap<SqliteDatabase>(*vfs,
+                  kj::Path({d.uniqueKey, kj::str(idPtr, ".sqlite")}),
+                  kj::WriteMode::CREATE | kj::WriteMode::MODIFY | kj::WriteMode::CREATE_PARENT);
+              return kj::heap<ActorSqlite>(kj::mv(db), outputGate,
+                  []() -> kj::Promise<void> { return kj::READY_NOW; },
+                  *sqliteHooks).attach(kj::mv(sqliteHooks));
             });
           };
 
@@ -1978,6 +2344,27 @@ private:
   kj::TaskSet waitUntilTasks;
   AbortActorsCallback abortActorsCallback;
 
+  // A worker that has started no request for this long is considered cold; see idleGcLoop().
+  static constexpr auto IDLE_GC_PERIOD = 30 * kj::SECONDS;
+
+  // When the last request started, used by idleGcLoop() to decide whether this worker is cold.
+  kj::TimePoint lastRequestTime;
+
+  // True once idleGcLoop() has collected for the current idle period, so that a worker that
+  // stays cold is not re-collected every period. Reset when a new request starts.
+  bool idleGcDone = false;
+
+  // Started lazily by the first request so that workers that never see traffic don't run a
+  // timer at all.
+  kj::Maybe<kj::Promise<void>> idleGcTask;
+
+  // Admission control state; see checkAdmission(). `lockWaitObserver` is null when the worker
+  // was built with a different observer type (e.g. by an embedder), in which case the lock-wait
+  // limit is inert.
+  AdmissionControlSettings admissionControl;
+  kj::Maybe<const LockWaitObserver&> lockWaitObserver;
+  uint concurrentRequests = 0;
+
   class ActorChannelImpl final: public IoChannelFactory::ActorChannel {
   public:
     ActorChannelImpl(ActorNamespace& ns, Worker::Actor::Id id)
@@ -2170,24 +2557,6 @@ private:
     return threadContext.getUnsafeTimer().afterDelay(t);
   }
 
-  // ---------------------------------------------------------------------------
-  // implements LimitEnforcer
-  //
-  // No limits are enforced.
-
-  kj::Own<void> enterJs(jsg::Lock& lock, IoContext& context) override { return {}; }
-  void topUpActor() override {}
-  void newSubrequest(bool isInHouse) override {}
-  void newKvRequest(KvOpType op) override {}
-  void newAnalyticsEngineRequest() override {}
-  kj::Promise<void> limitDrain() override { return kj::NEVER_DONE; }
-  kj::Promise<void> limitScheduled() override { return kj::NEVER_DONE; }
-  kj::Duration getAlarmLimit() override { return 15 * kj::MINUTES; }
-  size_t getBufferingLimit() override { return kj::maxValue; }
-  kj::Maybe<EventOutcome> getLimitsExceeded() override { return kj::none; }
-  kj::Promise<void> onLimitsExceeded() override { return kj::NEVER_DONE; }
-  void requireLimitsNotExceeded() override {}
-  void reportMetrics(RequestObserver& requestMetrics) override {}
 };
 
 struct FutureSubrequestChannel {
@@ -2536,6 +2905,7 @@ static kj::Maybe<WorkerdApi::Global> createBinding(
       cacheCopy.maxKeys = limits.getMaxKeys();
       cacheCopy.maxValueSize = limits.getMaxValueSize();
       cacheCopy.maxTotalValueSize = limits.getMaxTotalValueSize();
+      cacheCopy.asyncRefreshWindowMs = limits.getAsyncRefreshWindowMs();
       return makeGlobal(kj::mv(cacheCopy));
     }
   }
@@ -2565,24 +2935,36 @@ void Server::abortAllActors() {
   }
 }
 
-kj::Own<Server::Service> Server::makeWorker(kj::StringPtr name, config::Worker::Reader conf,
-    capnp::List<config::Extension>::Reader extensions) {
-  TRACE_EVENT("workerd", "Server::makeWorker()", "name", name.cStr());
-  auto& localActorConfigs = KJ_ASSERT_NONNULL(actorConfigs.find(name));
-
-  struct ErrorReporter: public Worker::ValidationErrorReporter {
-    ErrorReporter(Server& server, kj::StringPtr name): server(server), name(name) {}
+// State for a worker service whose script is being compiled on a background thread. Everything
+// in here is produced on the main thread by startWorkerCompilation(), except `worker`, which the
+// compilation thread fills in. The thread member is declared last so that destroying a
+// WorkerCompilation joins the thread before anything the thread references goes away.
+struct Server::WorkerCompilation {
+  struct ErrorReporter final: public Worker::ValidationErrorReporter {
+    ErrorReporter(kj::StringPtr name): name(name) {}
 
-    Server& server;
     kj::StringPtr name;
 
+    // Errors are buffered rather than reported immediately because addError() may be called
+    // from the compilation thread, where Server::reportConfigError (an arbitrary caller-provided
+    // callback) is not safe to invoke. reportTo() flushes the buffer on the main thread, both
+    // before the compilation thread starts and after it is joined.
+    kj::Vector<kj::String> errors;
+
     kj::HashMap<kj::String, kj::HashSet<kj::String>> namedEntrypoints;
 
     // The `HashSet`s are the set of exported handlers, like `fetch`, `test`, etc.
     kj::Maybe<kj::HashSet<kj::String>> defaultEntrypoint;
 
     void addError(kj::String error) override {
-      server.reportConfigError(kj::str("service ", name, ": ", error));
+      errors.add(kj::mv(error));
+    }
+
+    void reportTo(Server& server) {
+      for (auto& error: errors) {
+        server.reportConfigError(kj::str("service ", name, ": ", error));
+      }
+      errors.clear();
     }
 
     void addHandler(kj::Maybe<kj::StringPtr> exportName, kj::StringPtr type) override {
@@ -2614,7 +2996,31 @@ kj::Own<Server::Service> Server::makeWorker(kj::StringPtr name, config::Worker::
     }
   };
 
-  ErrorReporter errorReporter(*this, name);
+  WorkerCompilation(kj::StringPtr name, config::Worker::Reader conf,
+                    kj::HashMap<kj::String, ActorConfig>& localActorConfigs)
+      : name(name), conf(conf), localActorConfigs(localActorConfigs), errorReporter(name) {}
+
+  kj::StringPtr name;
+  config::Worker::Reader conf;
+  kj::HashMap<kj::String, ActorConfig>& localActorConfigs;
+  ErrorReporter errorReporter;
+  kj::Vector<FutureSubrequestChannel> subrequestChannels;
+  kj::Vector<FutureActorChannel> actorChannels;
+  kj::Vector<WorkerdApi::Global> globals;
+
+  // Filled in by the compilation thread.
+  kj::Maybe<kj::Own<const Worker>> worker;
+
+  kj::Maybe<kj::Thread> thread;
+};
+
+kj::Own<Server::WorkerCompilation> Server::startWorkerCompilation(kj::StringPtr name,
+    config::Worker::Reader conf, capnp::List<config::Extension>::Reader extensions) {
+  TRACE_EVENT("workerd", "Server::startWorkerCompilation()", "name", name.cStr());
+  auto& localActorConfigs = KJ_ASSERT_NONNULL(actorConfigs.find(name));
+
+  auto result = kj::heap<WorkerCompilation>(name, conf, localActorConfigs);
+  auto& errorReporter = result->errorReporter;
 
   capnp::MallocMessageBuilder arena;
   // TODO(beta): Factor out FeatureFlags from WorkerBundle.
@@ -2676,7 +3082,7 @@ kj::Own<Server::Service> Server::makeWorker(kj::StringPtr name, config::Worker::
     }
   };
 
-  auto observer = kj::atomicRefcounted<IsolateObserver>();
+  auto observer = kj::atomicRefcounted<LockWaitObserver>();
   auto limitEnforcer = kj::heap<NullIsolateLimitEnforcer>();
 
   kj::Maybe<kj::Own<jsg::modules::ModuleRegistry>> newModuleRegistry;
@@ -2895,45 +3301,71 @@ kj::Own<Server::Service> Server::makeWorker(kj::StringPtr name, config::Worker::
     });
   }
 
-  auto script = isolate->newScript(
-      name, WorkerdApi::extractSource(name, conf, errorReporter, extensions),
-      IsolateObserver::StartType::COLD, false, errorReporter);
-
-  kj::Vector<FutureSubrequestChannel> subrequestChannels;
-  kj::Vector<FutureActorChannel> actorChannels;
-
   auto confBindings = conf.getBindings();
-  using Global = WorkerdApi::Global;
-  kj::Vector<Global> globals(confBindings.size());
+  result->globals.reserve(confBindings.size());
   for (auto binding: confBindings) {
     KJ_IF_SOME(global, createBinding(name, conf, binding, errorReporter,
-                                     subrequestChannels, actorChannels, actorConfigs,
-                                     experimental)) {
-      globals.add(kj::mv(global));
+                                     result->subrequestChannels, result->actorChannels,
+                                     actorConfigs, experimental)) {
+      result->globals.add(kj::mv(global));
     }
   }
 
-  auto worker = kj::atomicRefcounted<Worker>(
-      kj::mv(script),
-      kj::atomicRefcounted<WorkerObserver>(),
-      [&](jsg::Lock& lock, const Worker::Api& api, v8::Local<v8::Object> target) {
-        return WorkerdApi::from(api).compileGlobals(
-            lock, globals, target, 1);
-      },
-      IsolateObserver::StartType::COLD,
-      nullptr,          // systemTracer -- TODO(beta): factor out
-      Worker::Lock::TakeSynchronously(kj::none),
-      errorReporter);
+  auto source = WorkerdApi::extractSource(name, conf, errorReporter, extensions);
+
+  // Report any errors produced so far (e.g. bad compatibility dates) now, while we're still on
+  // the main thread; anything the compilation thread reports is flushed when it is joined.
+  errorReporter.reportTo(*this);
+
+  // Compilation happens under the new isolate's own lock, so it can proceed in parallel with
+  // compilation of other workers and with the rest of config processing. Nothing in this lambda
+  // may touch the Server, which is not thread-safe; errors go to the buffering ErrorReporter.
+  result->thread.emplace(
+      [&compilation = *result, isolate = kj::mv(isolate), source = kj::mv(source)]() mutable {
+    TRACE_EVENT("workerd", "Server worker compilation", "name", compilation.name.cStr());
+
+    auto script = isolate->newScript(
+        compilation.name, kj::mv(source),
+        IsolateObserver::StartType::COLD, false, compilation.errorReporter);
+
+    auto worker = kj::atomicRefcounted<Worker>(
+        kj::mv(script),
+        kj::atomicRefcounted<WorkerObserver>(),
+        [&](jsg::Lock& lock, const Worker::Api& api, v8::Local<v8::Object> target) {
+          return WorkerdApi::from(api).compileGlobals(
+              lock, compilation.globals, target, 1);
+        },
+        IsolateObserver::StartType::COLD,
+        nullptr,          // systemTracer -- TODO(beta): factor out
+        Worker::Lock::TakeSynchronously(kj::none),
+        compilation.errorReporter);
 
-  {
     worker->runInLockScope(Worker::Lock::TakeSynchronously(kj::none), [&](Worker::Lock& lock) {
-      lock.validateHandlers(errorReporter);
+      lock.validateHandlers(compilation.errorReporter);
     });
-  }
+
+    compilation.worker = kj::mv(worker);
+  });
+
+  return result;
+}
+
+kj::Own<Server::Service> Server::finishWorkerCompilation(kj::Own<WorkerCompilation> compilation) {
+  TRACE_EVENT("workerd", "Server::finishWorkerCompilation()",
+              "name", compilation->name.cStr());
+
+  // Join the compilation thread. If compilation failed with an exception, the join rethrows it
+  // here, just as if we had compiled synchronously.
+  compilation->thread = kj::none;
+  compilation->errorReporter.reportTo(*this);
+
+  auto worker = kj::mv(KJ_ASSERT_NONNULL(compilation->worker));
+  kj::StringPtr name = compilation->name;
+  auto conf = compilation->conf;
 
   auto linkCallback =
-      [this, name, conf, subrequestChannels = kj::mv(subrequestChannels),
-       actorChannels = kj::mv(actorChannels)](WorkerService& workerService) mutable {
+      [this, name, conf, subrequestChannels = kj::mv(compilation->subrequestChannels),
+       actorChannels = kj::mv(compilation->actorChannels)](WorkerService& workerService) mutable {
     WorkerService::LinkedIoChannels result{.alarmScheduler = *alarmScheduler};
 
     auto services = kj::heapArrayBuilder<Service*>(subrequestChannels.size() +
@@ -3012,10 +3444,26 @@ kj::Own<Server::Service> Server::makeWorker(kj::StringPtr name, config::Worker::
     return result;
   };
 
+  WorkerService::AdmissionControlSettings admissionControl;
+  if (conf.hasAdmissionControl()) {
+    auto ac = conf.getAdmissionControl();
+    admissionControl.maxConcurrentRequests = ac.getMaxConcurrentRequests();
+    admissionControl.maxLockWait = ac.getMaxLockWaitMilliseconds() * kj::MILLISECONDS;
+  }
+
   return kj::heap<WorkerService>(globalContext->threadContext, kj::mv(worker),
-                                 kj::mv(errorReporter.defaultEntrypoint),
-                                 kj::mv(errorReporter.namedEntrypoints), localActorConfigs,
-                                 kj::mv(linkCallback), KJ_BIND_METHOD(*this, abortAllActors));
+                                 kj::mv(compilation->errorReporter.defaultEntrypoint),
+                                 kj::mv(compilation->errorReporter.namedEntrypoints),
+                                 compilation->localActorConfigs,
+                                 kj::mv(linkCallback), KJ_BIND_METHOD(*this, abortAllActors),
+                                 admissionControl);
+}
+
+kj::Own<Server::Service> Server::makeWorker(kj::StringPtr name, config::Worker::Reader conf,
+    capnp::List<config::Extension>::Reader extensions) {
+  // Start the compilation and immediately wait for it. startServices() doesn't use this; it
+  // starts all workers' compilations before finishing any of them, so that they overlap.
+  return finishWorkerCompilation(startWorkerCompilation(name, conf, extensions));
 }
 
 // =======================================================================================
@@ -3357,6 +3805,15 @@ private:
 
     kj::Promise<void> handleApplicationError(
         kj::Exception exception, kj::Maybe<kj::HttpService::Response&> response) override {
+      if (exception.getType() == kj::Exception::Type::OVERLOADED) {
+        // An overloaded worker rejected the request before it started (see
+        // WorkerService::checkAdmission()). This is expected under load, so don't spam the log,
+        // and report it as 503 so callers can tell overload apart from bugs.
+        KJ_IF_SOME(r, response) {
+          co_return co_await r.sendError(503, "Service Unavailable", parent.headerTable);
+        }
+        co_return;
+      }
       KJ_LOG(ERROR, kj::str("Uncaught exception: ", exception));
       KJ_IF_SOME(r, response) {
         co_return co_await r.sendError(500, "Internal Server Error", parent.headerTable);
@@ -3402,6 +3859,12 @@ kj::Promise<void> Server::run(jsg::V8System& v8System, config::Config::Reader co
 
   auto forkedDrainWhen = handleDrain(kj::mv(drainWhen)).fork();
 
+  // Sample the health of this thread's event loop -- the one serving all worker traffic -- for
+  // the lifetime of the server. Nearly free (two clock reads per second), and the resulting
+  // histograms are scrapable via `--metrics-addr`.
+  auto healthProbe = kj::heap<EventLoopHealthProbe>(timer, kj::systemPreciseMonotonicClock());
+  tasks.add(healthProbe->run(1 * kj::SECONDS).attach(kj::mv(healthProbe)));
+
   startServices(v8System, config, headerTableBuilder, forkedDrainWhen);
 
   auto listenPromise = listenOnSockets(config, headerTableBuilder, forkedDrainWhen);
@@ -3411,9 +3874,244 @@ kj::Promise<void> Server::run(jsg::V8System& v8System, config::Config::Reader co
   // services take longer to get ready.
   auto ownHeaderTable = headerTableBuilder.build();
 
+  if (prewarmSpecs.size() > 0) {
+    // Run the warming dispatches concurrently with serving. Sockets are already listening at this
+    // point, so an orchestrator that waits for the "ready" control event gets a process that has
+    // both bound its ports and executed each requested worker once.
+    tasks.add(prewarmServices(*ownHeaderTable));
+  }
+
   co_return co_await listenPromise.exclusiveJoin(kj::mv(fatalPromise));
 }
 
+namespace {
+
+// Escapes a string for embedding in JSON output.
+kj::String escapeJsonString(kj::StringPtr text) {
+  static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+  kj::Vector<char> escaped(text.size() + 1);
+  for (char c: text) {
+    switch (c) {
+      case '\"': escaped.addAll("\\\""_kj); break;
+      case '\\': escaped.addAll("\\\\"_kj); break;
+      case '\b': escaped.addAll("\\b"_kj); break;
+      case '\f': escaped.addAll("\\f"_kj); break;
+      case '\n': escaped.addAll("\\n"_kj); break;
+      case '\r': escaped.addAll("\\r"_kj); break;
+      case '\t': escaped.addAll("\\t"_kj); break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          escaped.addAll("\\u00"_kj);
+          escaped.add(HEX_DIGITS[(c >> 4) & 0xf]);
+          escaped.add(HEX_DIGITS[c & 0xf]);
+        } else {
+          escaped.add(c);
+        }
+        break;
+    }
+  }
+  return kj::str(kj::StringPtr(escaped.begin(), escaped.size()));
+}
+
+// Serializes a V8 CPU profile to the DevTools ".cpuprofile" JSON format -- the same shape the
+// inspector's Profiler.stop returns, loadable directly in Chrome DevTools and speedscope.
+kj::String serializeCpuProfile(v8::CpuProfile& profile) {
+  kj::Vector<const v8::CpuProfileNode*> allNodes;
+  kj::Vector<const v8::CpuProfileNode*> unvisited;
+  unvisited.add(profile.GetTopDownRoot());
+  while (!unvisited.empty()) {
+    auto next = unvisited.back();
+    allNodes.add(next);
+    unvisited.removeLast();
+    for (int i = 0; i < next->GetChildrenCount(); i++) {
+      unvisited.add(next->GetChild(i));
+    }
+  }
+
+  auto nodes = KJ_MAP(node, allNodes) -> kj::String {
+    kj::Vector<kj::String> childIds(node->GetChildrenCount());
+    for (int i = 0; i < node->GetChildrenCount(); i++) {
+      childIds.add(kj::str(node->GetChild(i)->GetNodeId()));
+    }
+    // V8 locations are 1-based, but the DevTools format is 0-based.
+    return kj::str(
+        "{\"id\":", node->GetNodeId(),
+        ",\"callFrame\":{\"functionName\":\"", escapeJsonString(node->GetFunctionNameStr()),
+        "\",\"scriptId\":\"", node->GetScriptId(),
+        "\",\"url\":\"", escapeJsonString(node->GetScriptResourceNameStr()),
+        "\",\"lineNumber\":", node->GetLineNumber() - 1,
+        ",\"columnNumber\":", node->GetColumnNumber() - 1,
+        "},\"hitCount\":", node->GetHitCount(),
+        ",\"children\":[", kj::strArray(childIds, ","), "]}");
+  };
+
+  int sampleCount = profile.GetSamplesCount();
+  kj::Vector<kj::String> samples(sampleCount);
+  kj::Vector<kj::String> timeDeltas(sampleCount);
+  auto lastTimestamp = profile.GetStartTime();
+  for (int i = 0; i < sampleCount; i++) {
+    samples.add(kj::str(profile.GetSample(i)->GetNodeId()));
+    auto sampleTime = profile.GetSampleTimestamp(i);
+    timeDeltas.add(kj::str(sampleTime - lastTimestamp));
+    lastTimestamp = sampleTime;
+  }
+
+  return kj::str(
+      "{\"nodes\":[", kj::strArray(nodes, ","),
+      "],\"startTime\":", profile.GetStartTime(),
+      ",\"endTime\":", profile.GetEndTime(),
+      ",\"samples\":[", kj::strArray(samples, ","),
+      "],\"timeDeltas\":[", kj::strArray(timeDeltas, ","), "]}");
+}
+
+}  // namespace
+
+kj::Promise<kj::String> Server::captureCpuProfile(kj::Duration duration) {
+  // Samples every worker isolate in the process for `duration` and returns a JSON object mapping
+  // service name to a DevTools-format CPU profile. Must run on the main thread's event loop,
+  // which owns `services`; the metrics thread gets here via kj::Executor::executeAsync().
+  //
+  // The profilers are started and stopped under each isolate's lock, but the sampling window
+  // itself runs unlocked -- V8's sampling profiler interrupts the isolate from a signal-based
+  // timer, so live traffic keeps flowing while we wait. At the 1ms interval used here the
+  // steady-state overhead is a few percent at worst, which is why this is safe to expose as a
+  // pull endpoint rather than a one-shot debugging tool.
+  //
+  // A started profiler keeps sampling (and accumulating, given kNoSampleLimit) until it is
+  // stopped, so this coroutine must not be destroyed mid-flight: the metrics endpoint runs it
+  // as a member of `tasks` and only the scraper's wait on the result is cancelable. For the
+  // same reason a failure on one worker must not skip the stop pass for the others, so
+  // per-worker errors below are logged and the loops carry on.
+  static constexpr kj::StringPtr PROFILE_NAME = "workerd diagnostics"_kj;
+
+  struct Target {
+    kj::StringPtr name;
+    kj::Own<const Worker> worker;
+    v8::CpuProfiler* profiler = nullptr;
+  };
+  kj::Vector<Target> targets;
+  for (auto& service: services) {
+    KJ_IF_SOME(workerService, kj::dynamicDowncastIfAvailable<WorkerService>(*service.value)) {
+      targets.add(Target { service.key, workerService.addRefWorker() });
+    }
+  }
+
+  for (auto& target: targets) {
+    try {
+      Worker::AsyncLock asyncLock = co_await target.worker->takeAsyncLockWithoutRequest(nullptr);
+      target.worker->runInLockScope(asyncLock, [&](Worker::Lock& lock) {
+        jsg::Lock& js = lock;
+        auto profiler = v8::CpuProfiler::New(
+            lock.getIsolate(), v8::kDebugNaming, v8::kLazyLogging);
+        // 1ms matches the inspector's default sampling interval.
+        profiler->SetSamplingInterval(1000);
+        js.withinHandleScope([&] {
+          profiler->StartProfiling(jsg::v8StrIntern(js.v8Isolate, PROFILE_NAME),
+              v8::CpuProfilingOptions(v8::kLeafNodeLineNumbers,
+                                      v8::CpuProfilingOptions::kNoSampleLimit));
+        });
+        target.profiler = profiler;
+      });
+    } catch (...) {
+      auto exception = kj::getCaughtExceptionAsKj();
+      KJ_LOG(ERROR, "failed to start profiling worker", target.name, exception);
+    }
+  }
+
+  co_await timer.afterDelay(duration);
+
+  kj::Vector<kj::String> parts(targets.size());
+  for (auto& target: targets) {
+    if (target.profiler == nullptr) continue;
+    try {
+      Worker::AsyncLock asyncLock = co_await target.worker->takeAsyncLockWithoutRequest(nullptr);
+      target.worker->runInLockScope(asyncLock, [&](Worker::Lock& lock) {
+        jsg::Lock& js = lock;
+        js.withinHandleScope([&] {
+          auto profile = target.profiler->StopProfiling(
+              jsg::v8StrIntern(js.v8Isolate, PROFILE_NAME));
+          if (profile != nullptr) {
+            parts.add(kj::str("\"", escapeJsonString(target.name), "\":",
+                              serializeCpuProfile(*profile)));
+            profile->Delete();
+          }
+        });
+        target.profiler->Dispose();
+        target.profiler = nullptr;
+      });
+    } catch (...) {
+      auto exception = kj::getCaughtExceptionAsKj();
+      KJ_LOG(ERROR, "failed to stop profiling worker", target.name, exception);
+    }
+  }
+
+  co_return kj::str("{", kj::strArray(parts, ","), "}");
+}
+
+kj::Promise<void> Server::prewarmServices(kj::HttpHeaderTable& headerTable) {
+  // The services were all compiled during startServices(), but a worker's first dispatch still
+  // pays one-time costs: top-level script evaluation and JIT warmup of the handler path. Sending
+  // a throwaway request up front moves those costs ahead of live traffic.
+
+  // Discards whatever the worker sends back; only the side effect of running it matters.
+  class PrewarmResponse final: public kj::HttpService::Response {
+  public:
+    kj::Own<kj::AsyncOutputStream> send(uint statusCode, kj::StringPtr statusText,
+        const kj::HttpHeaders& headers, kj::Maybe<uint64_t> expectedBodySize = kj::none) override {
+      return newNullOutputStream();
+    }
+    kj::Own<kj::WebSocket> acceptWebSocket(const kj::HttpHeaders& headers) override {
+      KJ_FAIL_REQUIRE("warming request unexpectedly returned a WebSocket");
+    }
+  };
+
+  for (auto& spec: prewarmSpecs) {
+    kj::String name;
+    kj::String path;
+    KJ_IF_SOME(pos, spec.findFirst(':')) {
+      name = kj::str(spec.first(pos));
+      path = kj::str(spec.slice(pos + 1));
+    } else {
+      name = kj::str(spec);
+      path = kj::str("/");
+    }
+    if (!path.startsWith("/")) {
+      path = kj::str("/", path);
+    }
+
+    KJ_IF_SOME(service, services.find(name)) {
+      TRACE_EVENT("workerd", "Server.prewarmServices", "service", name.cStr());
+      auto worker = service->startRequest({});
+      kj::HttpHeaders headers(headerTable);
+      auto url = kj::str("http://prewarm", path);
+      auto requestBody = newNullInputStream();
+      PrewarmResponse response;
+      try {
+        co_await worker->request(kj::HttpMethod::GET, url, headers, *requestBody, response);
+      } catch (...) {
+        // A warming request failing shouldn't take down the server -- the worker may simply not
+        // handle GETs on the chosen path. Readiness is still reported: the expensive part (script
+        // evaluation) has happened by the time the handler throws.
+        auto exception = kj::getCaughtExceptionAsKj();
+        KJ_LOG(ERROR, "warming request failed", name, path, exception);
+      }
+    } else {
+      reportConfigError(kj::str(
+          "Config defines no service named \"", name, "\" to match the --prewarm option "
+          "provided on the command line."));
+    }
+  }
+
+  KJ_IF_SOME(stream, controlOverride) {
+    auto message = kj::str("{\"event\":\"ready\"}\n");
+    try {
+      stream->write(message.asBytes());
+    } catch (kj::Exception& e) {
+      KJ_LOG(ERROR, e);
+    }
+  }
+}
+
 void Server::startAlarmScheduler(config::Config::Reader config) {
   auto& clock = kj::systemPreciseCalendarClock();
   auto dir = kj::newInMemoryDirectory(clock);
@@ -3474,6 +4172,94 @@ uint startInspector(kj::StringPtr inspectorAddress,
   );
 }
 
+// Configure and start the metrics endpoint, returning the port it is listening on. Like the
+// inspector, this runs on its own thread with its own event loop so that scraping never competes
+// with worker traffic; it only reads process-wide atomics (see util/hot-metrics.h).
+uint startMetricsEndpoint(kj::StringPtr metricsAddress,
+    kj::Function<kj::Promise<kj::String>(kj::Duration)> profileFunc) {
+  static constexpr uint UNASSIGNED_PORT = 0;
+  static constexpr uint DEFAULT_PORT = 9230;
+  kj::MutexGuarded<uint> metricsPort(UNASSIGNED_PORT);
+
+  kj::Thread thread([metricsAddress, &metricsPort, profileFunc = kj::mv(profileFunc)]() mutable {
+    kj::AsyncIoContext io = kj::setupAsyncIo();
+
+    // A minimal service that renders the process-wide hot metrics on every request, plus an
+    // on-demand sampling profiler under /debug/profile.
+    class MetricsService final: public kj::HttpService {
+    public:
+      using ProfileFunc = kj::Function<kj::Promise<kj::String>(kj::Duration)>;
+
+      MetricsService(kj::HttpHeaderTable& headerTable, ProfileFunc& profileFunc)
+          : headerTable(headerTable), profileFunc(profileFunc) {}
+
+      kj::Promise<void> request(
+          kj::HttpMethod method, kj::StringPtr url, const kj::HttpHeaders& headers,
+          kj::AsyncInputStream& requestBody, Response& response) override {
+        kj::HttpHeaders responseHeaders(headerTable);
+
+        if (url.startsWith("/debug/profile")) {
+          // GET /debug/profile?seconds=N samples every worker isolate for N seconds (default 5,
+          // clamped to [1, 60]) and returns a JSON object mapping service name to a DevTools
+          // ".cpuprofile" profile. The capture itself runs on the main thread's event loop.
+          uint seconds = 5;
+          KJ_IF_SOME(q, url.findFirst('?')) {
+            auto query = url.slice(q + 1);
+            if (query.startsWith("seconds=")) {
+              KJ_IF_SOME(parsed, query.slice("seconds="_kj.size()).tryParseAs<uint>()) {
+                seconds = parsed;
+              }
+            }
+          }
+          seconds = kj::min(kj::max(seconds, 1u), 60u);
+
+          auto body = co_await profileFunc(seconds * kj::SECONDS);
+          responseHeaders.set(kj::HttpHeaderId::CONTENT_TYPE, "application/json");
+          auto stream = response.send(200, "OK", responseHeaders, body.size());
+          co_await stream->write(body.asBytes());
+          co_return;
+        }
+
+        responseHeaders.set(kj::HttpHeaderId::CONTENT_TYPE, "text/plain; version=0.0.4");
+        auto body = renderHotMetrics();
+        auto stream = response.send(200, "OK", responseHeaders, body.size());
+        co_await stream->write(body.asBytes());
+      }
+
+    private:
+      kj::HttpHeaderTable& headerTable;
+      ProfileFunc& profileFunc;
+    };
+
+    kj::HttpHeaderTable::Builder headerTableBuilder;
+    auto ownHeaderTable = headerTableBuilder.build();
+    MetricsService service(*ownHeaderTable, profileFunc);
+    kj::HttpServer server(io.provider->getTimer(), *ownHeaderTable, service);
+
+    auto& network = io.provider->getNetwork();
+
+    // TODO(cleanup): Same caveat as the inspector above: if listen fails, nothing notices.
+    auto listen = (kj::coCapture([&network, &metricsAddress, &metricsPort,
+                                   &server]() -> kj::Promise<void> {
+      auto parsed = co_await network.parseAddress(metricsAddress, DEFAULT_PORT);
+      auto listener = parsed->listen();
+      // Signal to the thread that started the metrics endpoint that it is ready.
+      *metricsPort.lockExclusive() = listener->getPort();
+      KJ_LOG(INFO, "Metrics endpoint is listening");
+      co_await server.listenHttp(*listener);
+    }))();
+
+    kj::NEVER_DONE.wait(io.waitScope);
+  });
+  thread.detach();
+
+  // Wait for the endpoint to be initialized before proceeding.
+  return metricsPort.when(
+    [](const uint& port) { return port != UNASSIGNED_PORT; },
+    [](const uint& port) { return port; }
+  );
+}
+
 void Server::startServices(jsg::V8System& v8System, config::Config::Reader config,
                            kj::HttpHeaderTable::Builder& headerTableBuilder,
                            kj::ForkedPromise<void>& forkedDrainWhen) {
@@ -3559,10 +4345,64 @@ void Server::startServices(jsg::V8System& v8System, config::Config::Reader confi
     inspectorIsolateRegistrar = kj::mv(registrar);
   }
 
+  // If requested, start the metrics pull endpoint.
+  KJ_IF_SOME(metricsAddress, metricsOverride) {
+    // The profile callback bounces back to this thread's event loop, which owns the services
+    // and can lock their isolates safely; the Server outlives the detached metrics thread's
+    // use of it since the process exits by returning from run().
+    auto& mainExecutor = kj::getCurrentThreadExecutor();
+    auto port = startMetricsEndpoint(metricsAddress,
+        [this, &mainExecutor](kj::Duration duration) -> kj::Promise<kj::String> {
+      return mainExecutor.executeAsync([this, duration]() {
+        // Run the capture as a server task rather than returning it directly: if the scraper
+        // disconnects mid-capture, the cross-thread promise is canceled, and canceling the
+        // capture itself would destroy its coroutine frame with profilers still attached to
+        // the isolates, leaving them sampling (and accumulating) forever. The task always runs
+        // to completion; only the wait is canceled. Errors are routed to the waiting scraper
+        // via the fulfiller -- `tasks` treats task failures as fatal.
+        auto paf = kj::newPromiseAndFulfiller<kj::String>();
+        tasks.add(captureCpuProfile(duration).then(
+            [&fulfiller = *paf.fulfiller](kj::String result) {
+          fulfiller.fulfill(kj::mv(result));
+        }, [&fulfiller = *paf.fulfiller](kj::Exception&& exception) {
+          fulfiller.reject(kj::mv(exception));
+        }).attach(kj::mv(paf.fulfiller)));
+        return kj::mv(paf.promise);
+      });
+    });
+    KJ_IF_SOME(stream, controlOverride) {
+      auto message = kj::str("{\"event\":\"listen-metrics\",\"port\":", port, "}\n");
+      try {
+        stream->write(message.asBytes());
+      } catch (kj::Exception& e) {
+        KJ_LOG(ERROR, e);
+      }
+    }
+  }
+
   // Second pass: Build services.
+  //
+  // Worker script compilation dominates startup time, and each worker gets its own isolate, so
+  // V8 permits the compilations to proceed on separate threads in parallel. Start all of them
+  // before constructing any services; everything that touches shared Server state (binding
+  // setup, error reporting, the services table) still happens here, on this thread.
+  kj::Vector<kj::Own<WorkerCompilation>> workerCompilations;
+  for (auto serviceConf: config.getServices()) {
+    if (serviceConf.isWorker()) {
+      workerCompilations.add(startWorkerCompilation(
+          serviceConf.getName(), serviceConf.getWorker(), config.getExtensions()));
+    }
+  }
+
+  size_t workerIndex = 0;
   for (auto serviceConf: config.getServices()) {
     kj::StringPtr name = serviceConf.getName();
-    auto service = makeService(serviceConf, headerTableBuilder, config.getExtensions());
+    kj::Own<Service> service;
+    if (serviceConf.isWorker()) {
+      service = finishWorkerCompilation(kj::mv(workerCompilations[workerIndex++]));
+    } else {
+      service = makeService(serviceConf, headerTableBuilder, config.getExtensions());
+    }
 
     services.upsert(kj::str(name), kj::mv(service), [&](auto&&...) {
       reportConfigError(kj::str("Config defines multiple services named \"", name, "\"."));
@@ -3598,6 +4438,40 @@ void Server::startServices(jsg::V8System& v8System, config::Config::Reader confi
   }
 }
 
+// Applies a socket's `listenOptions` to its listener. Options set on a listening socket are
+// inherited by accepted connections, so setting them once here covers every connection without
+// per-accept syscalls. SO_SNDBUF/SO_RCVBUF are portable; the TCP options only exist on some
+// platforms, so each is guarded by its own #ifdef and skipped where the kernel doesn't offer it.
+static void applyListenOptions(kj::ConnectionReceiver& listener,
+                               config::ListenOptions::Reader options) {
+  if (uint size = options.getSendBufferSize()) {
+    int value = size;
+    listener.setsockopt(SOL_SOCKET, SO_SNDBUF, &value, sizeof(value));
+  }
+  if (uint size = options.getReceiveBufferSize()) {
+    int value = size;
+    listener.setsockopt(SOL_SOCKET, SO_RCVBUF, &value, sizeof(value));
+  }
+#ifdef TCP_NOTSENT_LOWAT
+  if (uint lowat = options.getNotsentLowat()) {
+    int value = lowat;
+    listener.setsockopt(IPPROTO_TCP, TCP_NOTSENT_LOWAT, &value, sizeof(value));
+  }
+#endif
+#ifdef TCP_QUICKACK
+  if (options.getTcpQuickAck()) {
+    int value = 1;
+    listener.setsockopt(IPPROTO_TCP, TCP_QUICKACK, &value, sizeof(value));
+  }
+#endif
+#ifdef TCP_DEFER_ACCEPT
+  if (uint seconds = options.getDeferAcceptSeconds()) {
+    int value = seconds;
+    listener.setsockopt(IPPROTO_TCP, TCP_DEFER_ACCEPT, &value, sizeof(value));
+  }
+#endif
+}
+
 kj::Promise<void> Server::listenOnSockets(config::Config::Reader config,
                                           kj::HttpHeaderTable::Builder& headerTableBuilder,
                                           kj::ForkedPromise<void>& forkedDrainWhen,
@@ -3659,6 +4533,13 @@ kj::Promise<void> Server::listenOnSockets(config::Config::Reader config,
     continue;
 
   validSocket:
+    // Each socket gets exactly one accept loop, on this thread. workerd is a single-event-loop
+    // runtime: the service graph, IoChannelFactory, and actor namespaces are not thread-safe, so
+    // in-process accept sharding across threads isn't an option. To use multiple cores, run one
+    // workerd process per core; a supervisor can bind SO_REUSEPORT sockets (or hand out pre-bound
+    // FDs via `--socket-fd`) so the kernel distributes connections across the processes.
+    // Worker::Isolate is atomic-refcounted specifically so embedders that do share compiled
+    // isolates across threads can, but workerd itself does not.
     using PromisedReceived = kj::Promise<kj::Own<kj::ConnectionReceiver>>;
     PromisedReceived listener = nullptr;
     KJ_IF_SOME(l, listenerOverride) {
@@ -3670,6 +4551,18 @@ kj::Promise<void> Server::listenOnSockets(config::Config::Reader config,
       })(network.parseAddress(addrStr, defaultPort));
     }
 
+    if (sock.hasListenOptions()) {
+      // Apply kernel tuning before any TLS wrapping, since the TLS receiver doesn't forward
+      // setsockopt() to the underlying socket. (Capturing the reader is safe: the config message
+      // outlives the server, as with the other readers captured below.)
+      listener = ([](PromisedReceived promise, config::ListenOptions::Reader options)
+          -> PromisedReceived {
+        auto listener = co_await promise;
+        applyListenOptions(*listener, options);
+        co_return kj::mv(listener);
+      })(kj::mv(listener), sock.getListenOptions());
+    }
+
     KJ_IF_SOME(t, tls) {
       listener = ([](kj::Promise<kj::Own<kj::ConnectionReceiver>> promise,
                      kj::Own<kj::TlsContext> tls)
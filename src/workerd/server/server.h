@@ -58,9 +58,19 @@ public:
   void enableInspector(kj::String addr) {
     inspectorOverride = kj::mv(addr);
   }
+  void enableMetrics(kj::String addr) {
+    metricsOverride = kj::mv(addr);
+  }
   void enableControl(uint fd) {
     controlOverride = kj::heap<kj::FdOutputStream>(fd);
   }
+  // Requests that a warming dispatch be sent to the named service at startup. `spec` is
+  // "<service>" or "<service>:<path>"; the path defaults to "/". Once every requested warming
+  // dispatch has completed, a "ready" event is reported on the control socket (see
+  // enableControl()).
+  void enablePrewarm(kj::String spec) {
+    prewarmSpecs.add(kj::mv(spec));
+  }
   void setPythonDiskCacheRoot(kj::Maybe<kj::Own<const kj::Directory>> &&dkr) {
     pythonConfig.diskCacheRoot = kj::mv(dkr);
   }
@@ -124,6 +134,8 @@ private:
   kj::HashMap<kj::String, kj::String> externalOverrides;
 
   kj::Maybe<kj::String> inspectorOverride;
+  kj::Maybe<kj::String> metricsOverride;
+  kj::Vector<kj::String> prewarmSpecs;
   kj::Maybe<kj::Own<InspectorServiceIsolateRegistrar>> inspectorIsolateRegistrar;
   kj::Maybe<kj::Own<kj::FdOutputStream>> controlOverride;
 
@@ -193,6 +205,19 @@ private:
       kj::HttpHeaderTable::Builder& headerTableBuilder);
   kj::Own<Service> makeWorker(kj::StringPtr name, config::Worker::Reader conf,
       capnp::List<config::Extension>::Reader extensions);
+
+  // Worker script compilation is expensive but runs entirely under the new isolate's lock, so
+  // it can proceed on a background thread while the main thread continues processing config.
+  // startWorkerCompilation() performs all the main-thread setup for a worker (isolate creation,
+  // binding setup) and then kicks off compilation on a thread; finishWorkerCompilation() joins
+  // that thread and wraps the result in a WorkerService. makeWorker() is the sequential
+  // composition of the two; startServices() instead starts all workers' compilations before
+  // finishing any of them, so that they run in parallel.
+  struct WorkerCompilation;
+  kj::Own<WorkerCompilation> startWorkerCompilation(kj::StringPtr name,
+      config::Worker::Reader conf, capnp::List<config::Extension>::Reader extensions);
+  kj::Own<Service> finishWorkerCompilation(kj::Own<WorkerCompilation> compilation);
+
   kj::Own<Service> makeService(
       config::Service::Reader conf,
       kj::HttpHeaderTable::Builder& headerTableBuilder,
@@ -227,6 +252,18 @@ private:
                                     kj::HttpHeaderTable::Builder& headerTableBuilder,
                                     kj::ForkedPromise<void>& forkedDrainWhen,
                                     bool forTest = false);
+
+  // Sends the warming dispatches requested via enablePrewarm(), then reports readiness on the
+  // control socket. Must be called after startServices!
+  kj::Promise<void> prewarmServices(kj::HttpHeaderTable& headerTable);
+
+  // Samples every worker isolate for `duration` and returns a JSON object mapping service name
+  // to a DevTools-format CPU profile. Must run on the main thread's event loop, which owns the
+  // services; the metrics endpoint thread reaches it via kj::Executor. Must not be canceled
+  // once started -- started profilers keep sampling until stopped -- so it runs as a member of
+  // `tasks` with the caller waiting on a separate fulfiller. Must be called after
+  // startServices!
+  kj::Promise<kj::String> captureCpuProfile(kj::Duration duration);
 };
 
 // An ActorStorage implementation which will always respond to reads as if the state is empty,
@@ -642,7 +642,8 @@ static v8::Local<v8::Value> createBindingValue(
                 .maxKeys = cache.maxKeys,
                 .maxValueSize = cache.maxValueSize,
                 .maxTotalValueSize = cache.maxTotalValueSize,
-              })));
+              },
+              cache.asyncRefreshWindowMs)));
     }
 
     KJ_CASE_ONEOF(ns, Global::EphemeralActorNamespace) {
@@ -133,6 +133,7 @@ public:
       uint32_t maxKeys;
       uint32_t maxValueSize;
       uint64_t maxTotalValueSize;
+      uint32_t asyncRefreshWindowMs = 0;
 
       MemoryCache clone() const {
         return MemoryCache {
@@ -140,6 +141,7 @@ public:
           .maxKeys = maxKeys,
           .maxValueSize = maxValueSize,
           .maxTotalValueSize = maxTotalValueSize,
+          .asyncRefreshWindowMs = asyncRefreshWindowMs,
         };
       }
     };
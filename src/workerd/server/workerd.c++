@@ -718,6 +718,10 @@ public:
                           "<addr> instead of the address specified in the config file.")
         .addOptionWithArg({'i', "inspector-addr"}, CLI_METHOD(enableInspector), "<addr>",
                           "Enable the inspector protocol to connect to the address <addr>.")
+        .addOptionWithArg({"metrics-addr"}, CLI_METHOD(enableMetrics), "<addr>",
+                          "Serve always-on process metrics in Prometheus text format over HTTP "
+                          "on the address <addr>. The same endpoint serves an on-demand CPU "
+                          "sampling profile under /debug/profile?seconds=<n>.")
 #if defined(WORKERD_USE_PERFETTO)
         // TODO(later): In the future, we might want to enable providing a perfetto
         // TraceConfig structure here rather than just the categories.
@@ -746,10 +750,20 @@ public:
                           "of the address specified in the config file.")
         .addOptionWithArg({'S', "socket-fd"}, CLI_METHOD(overrideSocketFd), "<name>=<fd>",
                           "Override the socket named <name> to listen on the already-open socket "
-                          "descriptor <fd> instead of the address specified in the config file.")
+                          "descriptor <fd> instead of the address specified in the config file. "
+                          "To spread load across cores, a supervisor can bind one SO_REUSEPORT "
+                          "socket per CPU and pass each to its own workerd process this way; the "
+                          "kernel then shards incoming connections across the processes.")
         .addOptionWithArg({"control-fd"}, CLI_METHOD(enableControl), "<fd>",
                           "Enable sending of control messages on descriptor <fd>. Currently this "
                           "only reports the port each socket is listening on when ready.")
+        .addOptionWithArg({"prewarm"}, CLI_METHOD(enablePrewarm), "<service>[:<path>]",
+                          "Send a warming request (GET <path>, default \"/\") to <service> at "
+                          "startup, so the first live request doesn't pay for script evaluation "
+                          "and JIT warmup. May be specified multiple times. Once all warming "
+                          "requests complete, a \"ready\" event is reported on the control "
+                          "socket (see --control-fd), signaling that it is safe to route "
+                          "traffic to this process.")
         .callAfterParsing(CLI_METHOD(serve))
         .build();
   }
@@ -931,12 +945,20 @@ public:
     server->enableInspector(kj::str(param));
   }
 
+  void enableMetrics(kj::StringPtr param) {
+    server->enableMetrics(kj::str(param));
+  }
+
   void enableControl(kj::StringPtr param) {
     int fd = KJ_UNWRAP_OR(param.tryParseAs<uint>(),
         CLI_ERROR("Output value must be a file descriptor (non-negative integer)."));
     server->enableControl(fd);
   }
 
+  void enablePrewarm(kj::StringPtr param) {
+    server->enablePrewarm(kj::str(param));
+  }
+
   void setPythonDiskCacheDir(kj::StringPtr pathStr) {
     kj::Path path = fs->getCurrentPath().eval(pathStr);
     kj::Maybe<kj::Own<const kj::Directory>> dir = fs->getRoot().tryOpenSubdir(path, kj::WriteMode::MODIFY);
@@ -1209,12 +1231,19 @@ public:
           KJ_MAP(flag, config.getV8Flags()) -> kj::StringPtr { return flag; });
       auto promise = func(v8System, config);
       KJ_IF_SOME(w, watcher) {
-        promise = promise.exclusiveJoin(waitForChanges(w).then([this]() {
-          // Watch succeeded.
-          reloadFromConfigChange();
-        }));
+        if (!drainOnConfigChange) {
+          promise = promise.exclusiveJoin(waitForChanges(w).then([this]() {
+            // Watch succeeded.
+            reloadFromConfigChange();
+          }));
+        }
       }
       promise.wait(io.waitScope);
+      if (reloadAfterDrain) {
+        // A config change triggered the server's drain (see serve()); now that in-flight
+        // requests have finished, exec the new config.
+        reloadFromConfigChange();
+      }
 #ifdef WORKERD_USE_PERFETTO
       KJ_IF_SOME(perfettoSession, maybePerfettoSession) {
         auto dropMe = kj::mv(perfettoSession);
@@ -1236,9 +1265,17 @@ public:
 #if _WIN32
       return server->run(v8System, config);
 #else
-      return server->run(v8System, config,
-          // Gracefully drain when SIGTERM is received.
-          io.unixEventPort.onSignal(SIGTERM).ignoreResult());
+      // Gracefully drain when SIGTERM is received. In --watch mode, a config change triggers
+      // the same drain: requests in flight finish against the old config before serveImpl()
+      // execs the new one, rather than being cut off mid-response by an immediate exec.
+      auto drainWhen = io.unixEventPort.onSignal(SIGTERM).ignoreResult();
+      KJ_IF_SOME(w, watcher) {
+        drainOnConfigChange = true;
+        drainWhen = drainWhen.exclusiveJoin(waitForChanges(w).then([this]() {
+          reloadAfterDrain = true;
+        }));
+      }
+      return server->run(v8System, config, kj::mv(drainWhen));
 #endif
     });
   }
@@ -1315,6 +1352,14 @@ private:
   bool noVerbose = false;
   kj::Maybe<FileWatcher> watcher;
 
+  // True when serve() routes --watch config changes through the server's graceful drain
+  // rather than serveImpl() exec'ing immediately on change.
+  bool drainOnConfigChange = false;
+
+  // Set when a config change (as opposed to SIGTERM) initiated the drain, telling
+  // serveImpl() to exec the new config once the server promise resolves.
+  bool reloadAfterDrain = false;
+
   kj::Own<kj::Filesystem> fs = kj::newDiskFilesystem();
   kj::AsyncIoContext io = kj::setupAsyncIo();
   NetworkWithLoopback network { io.provider->getNetwork(), *io.provider };
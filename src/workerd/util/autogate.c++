@@ -17,6 +17,8 @@ kj::StringPtr KJ_STRINGIFY(AutogateKey key) {
       return "test-workerd"_kj;
     case AutogateKey::PYODIDE_LOAD_EXTERNAL:
       return "pyodide-load-external"_kj;
+    case AutogateKey::EAGER_SCRIPT_COMPILE:
+      return "eager-script-compile"_kj;
     case AutogateKey::NumOfKeys:
       KJ_FAIL_ASSERT("NumOfKeys should not be used in getName");
   }
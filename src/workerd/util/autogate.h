@@ -14,6 +14,9 @@ namespace workerd::util {
 enum class AutogateKey {
   TEST_WORKERD,
   PYODIDE_LOAD_EXTERNAL,
+  // Compile worker scripts eagerly at startup instead of letting V8 lazily compile function
+  // bodies on first call, trading startup time and memory for first-request latency.
+  EAGER_SCRIPT_COMPILE,
   NumOfKeys // Reserved for iteration.
 };
 
@@ -4,6 +4,7 @@
 
 #include "batch-queue.h"
 #include <kj/test.h>
+#include <kj/thread.h>
 
 namespace workerd {
 namespace {
@@ -97,5 +98,69 @@ KJ_TEST("BatchQueue reconstructs buffers if they grow above maxCapacity") {
   KJ_EXPECT(buffer1.begin() == buffer3.begin());
 }
 
+KJ_TEST("MpscBatchQueue basic operations") {
+  MpscBatchQueue<int> queue { INITIAL_CAPACITY, MAX_CAPACITY };
+
+  KJ_EXPECT(queue.popAll().size() == 0);
+
+  queue.push(1);
+  queue.push(2);
+  queue.push(3);
+
+  auto batch = queue.popAll();
+  KJ_EXPECT(batch.size() == 3);
+  // FIFO order despite the LIFO internal list.
+  for (auto i: kj::indices(batch)) {
+    KJ_EXPECT(batch[i] == int(i) + 1);
+  }
+
+  KJ_EXPECT(queue.popAll().size() == 0);
+}
+
+KJ_TEST("MpscBatchQueue accepts pushes from multiple threads") {
+  static constexpr auto PUSHES_PER_THREAD = 1000;
+
+  MpscBatchQueue<int> queue { INITIAL_CAPACITY, MAX_CAPACITY };
+
+  {
+    kj::Thread thread1([&queue]() {
+      for (auto i = 0; i < PUSHES_PER_THREAD; ++i) queue.push(i);
+    });
+    kj::Thread thread2([&queue]() {
+      for (auto i = 0; i < PUSHES_PER_THREAD; ++i) queue.push(i);
+    });
+  }
+
+  // Both threads have joined, so everything they pushed must be visible.
+  size_t total = 0;
+  auto counts = kj::heapArray<int>(PUSHES_PER_THREAD);
+  for (auto& count: counts) count = 0;
+  for (auto value: queue.popAll()) {
+    ++counts[value];
+    ++total;
+  }
+  KJ_EXPECT(total == 2 * PUSHES_PER_THREAD);
+  for (auto count: counts) {
+    KJ_EXPECT(count == 2);
+  }
+}
+
+KJ_TEST("MpscBatchQueue destroys unpopped elements") {
+  struct DestructionDetector {
+    DestructionDetector(uint& count): count(count) {}
+    ~DestructionDetector() noexcept(false) { ++count; }
+    KJ_DISALLOW_COPY_AND_MOVE(DestructionDetector);
+    uint& count;
+  };
+
+  uint count = 0;
+  {
+    MpscBatchQueue<kj::Own<DestructionDetector>> queue { INITIAL_CAPACITY, MAX_CAPACITY };
+    queue.push(kj::heap<DestructionDetector>(count));
+    queue.push(kj::heap<DestructionDetector>(count));
+  }
+  KJ_EXPECT(count == 2);
+}
+
 }  // namespace
 }  // namespace workerd
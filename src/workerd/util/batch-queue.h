@@ -6,6 +6,7 @@
 
 #include <kj/debug.h>
 #include <kj/vector.h>
+#include <atomic>
 #include <utility>
 
 namespace workerd {
@@ -98,10 +99,112 @@ public:
   auto size() const { return pushBuffer.size(); }
 
 private:
+  // Called after each completed pop operation with the size of the batch that was just consumed.
+  // Buffers grow organically under bursts (kj::Vector doubles as needed); this implements the
+  // inverse: once a full observation window of batches has stayed well below the buffer's
+  // capacity, the pop buffer is reconstructed near the recent peak so a single long-ago burst
+  // doesn't pin memory forever. (Capacities beyond `maxCapacity` are still reset immediately.)
+  void recordBatchSize(size_t batchSize) {
+    peakRecentBatchSize = kj::max(peakRecentBatchSize, batchSize);
+    if (++popsSinceShrinkCheck >= SHRINK_WINDOW) {
+      size_t target = kj::max(size_t(initialCapacity), 2 * peakRecentBatchSize);
+      if (popBuffer.capacity() > 2 * target) {
+        popBuffer = kj::Vector<T>(target);
+      }
+      popsSinceShrinkCheck = 0;
+      peakRecentBatchSize = 0;
+    }
+  }
+
+  static constexpr uint SHRINK_WINDOW = 32;
+
   kj::Vector<T> pushBuffer;
   kj::Vector<T> popBuffer;
   uint initialCapacity;
   uint maxCapacity;
+  uint popsSinceShrinkCheck = 0;
+  size_t peakRecentBatchSize = 0;
+};
+
+// A lock-free multiple-producer, single-consumer variant of BatchQueue, for hot paths where a
+// `kj::MutexGuarded<BatchQueue<T>>` would contend (e.g. trace event collection fanning in from
+// many threads).
+//
+// `push()` may be called from any thread with no external synchronization; it is one allocation
+// plus a CAS loop on the list head. `popAll()` must only be called from one consumer at a time;
+// it detaches the whole list with a single exchange and returns the elements in FIFO order.
+//
+// Batch sizing is adaptive: the vector returned by `popAll()` is pre-allocated near the recently
+// observed batch size, growing immediately under bursts and decaying back toward
+// `initialCapacity` as traffic quiets down.
+template <typename T>
+class MpscBatchQueue {
+public:
+  explicit MpscBatchQueue(uint initialCapacity, uint maxCapacity)
+      : initialCapacity(initialCapacity),
+        maxCapacity(maxCapacity),
+        reserveHint(initialCapacity) {}
+  KJ_DISALLOW_COPY_AND_MOVE(MpscBatchQueue);
+
+  ~MpscBatchQueue() noexcept(false) {
+    Node* node = head.exchange(nullptr, std::memory_order_acquire);
+    while (node != nullptr) {
+      Node* next = node->next;
+      delete node;
+      node = next;
+    }
+  }
+
+  // Add an item to the current batch. Safe to call from any thread.
+  template <typename U>
+  void push(U&& value) {
+    Node* node = new Node { kj::fwd<U>(value), head.load(std::memory_order_relaxed) };
+    while (!head.compare_exchange_weak(node->next, node,
+        std::memory_order_release, std::memory_order_relaxed)) {}
+  }
+
+  // Detach and return everything pushed so far, oldest first. Must not be called concurrently
+  // with itself.
+  kj::Vector<T> popAll() {
+    // Producers push LIFO, so reverse the detached list to restore FIFO order.
+    Node* node = head.exchange(nullptr, std::memory_order_acquire);
+    Node* reversed = nullptr;
+    while (node != nullptr) {
+      Node* next = node->next;
+      node->next = reversed;
+      reversed = node;
+      node = next;
+    }
+
+    kj::Vector<T> batch(reserveHint);
+    while (reversed != nullptr) {
+      batch.add(kj::mv(reversed->value));
+      Node* next = reversed->next;
+      delete reversed;
+      reversed = next;
+    }
+
+    if (batch.size() > reserveHint) {
+      // Burst: jump straight to the observed size so the next pop doesn't reallocate.
+      reserveHint = kj::min(size_t(maxCapacity), batch.size());
+    } else {
+      // Decay toward current usage, but never below the configured floor.
+      reserveHint = kj::max(size_t(initialCapacity), (reserveHint + batch.size()) / 2);
+    }
+
+    return batch;
+  }
+
+private:
+  struct Node {
+    T value;
+    Node* next;
+  };
+
+  std::atomic<Node*> head{nullptr};
+  uint initialCapacity;
+  uint maxCapacity;
+  size_t reserveHint;
 };
 
 // =======================================================================================
@@ -110,11 +213,13 @@ private:
 template <typename T>
 BatchQueue<T>::Batch::~Batch() noexcept(false) {
   KJ_IF_SOME(bq, batchQueue) {
+    auto batchSize = bq.popBuffer.size();
     bq.popBuffer.clear();
     if (auto capacity = bq.popBuffer.capacity(); capacity > bq.maxCapacity) {
       // Reset the queue to avoid letting it grow unbounded.
       bq.popBuffer = kj::Vector<T>(bq.initialCapacity);
     }
+    bq.recordBatchSize(batchSize);
   }
 }
 
@@ -0,0 +1,32 @@
+// Copyright (c) 2017-2022 Cloudflare, Inc.
+// Licensed under the Apache 2.0 license found in the LICENSE file or at:
+//     https://opensource.org/licenses/Apache-2.0
+
+#include "event-loop-health.h"
+#include "hot-metrics.h"
+
+#include <kj/async-io.h>
+#include <kj/test.h>
+
+namespace workerd {
+namespace {
+
+KJ_TEST("EventLoopHealthProbe samples the event loop") {
+  auto io = kj::setupAsyncIo();
+  auto& timer = io.provider->getTimer();
+
+  EventLoopHealthProbe probe(timer, kj::systemPreciseMonotonicClock());
+  auto task = probe.run(1 * kj::MILLISECONDS).eagerlyEvaluate(nullptr);
+
+  // Let the probe take a few samples.
+  timer.afterDelay(20 * kj::MILLISECONDS).wait(io.waitScope);
+  KJ_EXPECT(probe.getSampleCount() >= 3, probe.getSampleCount());
+
+  // The histograms are registered process-wide and show up in the rendered metrics.
+  auto rendered = renderHotMetrics();
+  KJ_EXPECT(rendered.contains("workerd_event_loop_wakeup_lag_us"));
+  KJ_EXPECT(rendered.contains("workerd_event_loop_drain_us"));
+}
+
+}  // namespace
+}  // namespace workerd
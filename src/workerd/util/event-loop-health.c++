@@ -0,0 +1,32 @@
+// Copyright (c) 2017-2022 Cloudflare, Inc.
+// Licensed under the Apache 2.0 license found in the LICENSE file or at:
+//     https://opensource.org/licenses/Apache-2.0
+
+#include "event-loop-health.h"
+#include "hot-metrics.h"
+
+namespace workerd {
+
+kj::Promise<void> EventLoopHealthProbe::run(kj::Duration interval) {
+  static HotHistogram wakeupLagHistogram("workerd_event_loop_wakeup_lag_us");
+  static HotHistogram drainTimeHistogram("workerd_event_loop_drain_us");
+
+  for (;;) {
+    auto sleepStart = clock.now();
+    co_await timer.afterDelay(interval);
+    auto woke = clock.now();
+
+    // The timer can't fire early, but guard against clock jitter anyway.
+    auto lag = kj::max(0 * kj::MICROSECONDS, (woke - sleepStart) - interval);
+    wakeupLagHistogram.record(lag / kj::MICROSECONDS);
+
+    // evalLast() doesn't run until the loop has no other ready work, so this measures how long
+    // the current burst of queued work takes to drain.
+    co_await kj::evalLast([]() {});
+    drainTimeHistogram.record((clock.now() - woke) / kj::MICROSECONDS);
+
+    ++samples;
+  }
+}
+
+}  // namespace workerd
@@ -0,0 +1,44 @@
+// Copyright (c) 2017-2022 Cloudflare, Inc.
+// Licensed under the Apache 2.0 license found in the LICENSE file or at:
+//     https://opensource.org/licenses/Apache-2.0
+
+#pragma once
+
+#include <kj/async.h>
+#include <kj/time.h>
+
+namespace workerd {
+
+// Periodically samples the health of the kj event loop it runs on, recording the results into
+// process-wide hot-metrics histograms (see util/hot-metrics.h) so they can be scraped via the
+// server's metrics endpoint. Two signals are sampled per interval:
+//
+// - wakeup lag: how much later than requested a timer wakeup fired. A saturated event loop --
+//   whether because JavaScript held the thread or because queued native work piled up -- delays
+//   the wakeup, so this is effectively the time-to-first-poll after the loop should have woken.
+// - drain time: once woken, how long the loop took to run out of ready work (measured with
+//   kj::evalLast()). This approximates the duration of the busiest turn burst and separates
+//   "loop is starved by long turns" from "loop is idle but wakes up late".
+//
+// Together with the per-request isolate CPU histogram, these distinguish isolate CPU saturation
+// from event-loop starvation. The probe itself is nearly free: two clock reads and one timer per
+// interval.
+class EventLoopHealthProbe {
+public:
+  EventLoopHealthProbe(kj::Timer& timer, const kj::MonotonicClock& clock)
+      : timer(timer), clock(clock) {}
+  KJ_DISALLOW_COPY_AND_MOVE(EventLoopHealthProbe);
+
+  // Samples forever, once per `interval`. Run this on the event loop to be observed.
+  kj::Promise<void> run(kj::Duration interval);
+
+  // How many samples have been taken so far. Exposed for tests.
+  uint64_t getSampleCount() const { return samples; }
+
+private:
+  kj::Timer& timer;
+  const kj::MonotonicClock& clock;
+  uint64_t samples = 0;
+};
+
+}  // namespace workerd
@@ -0,0 +1,66 @@
+// Copyright (c) 2017-2022 Cloudflare, Inc.
+// Licensed under the Apache 2.0 license found in the LICENSE file or at:
+//     https://opensource.org/licenses/Apache-2.0
+
+#include "hot-metrics.h"
+
+#include <kj/test.h>
+
+namespace workerd {
+namespace {
+
+// The registry is process-global and never unregisters, so these tests assert on substrings of
+// the rendered output rather than on the full text.
+bool rendersLine(kj::StringPtr line) {
+  auto rendered = renderHotMetrics();
+  return rendered.contains(kj::str(line, "\n"));
+}
+
+KJ_TEST("HotCounter counts and renders") {
+  static HotCounter counter("test_hot_counter_basic");
+
+  KJ_EXPECT(counter.get() == 0);
+  counter.add();
+  counter.add(41);
+  KJ_EXPECT(counter.get() == 42);
+
+  KJ_EXPECT(rendersLine("# TYPE test_hot_counter_basic counter"));
+  KJ_EXPECT(rendersLine("test_hot_counter_basic 42"));
+}
+
+KJ_TEST("HotHistogram buckets samples by power of two") {
+  static HotHistogram histogram("test_hot_histogram_buckets");
+
+  histogram.record(0);   // bucket 0
+  histogram.record(1);   // bucket 1
+  histogram.record(5);   // bucket 3: [4, 7]
+  histogram.record(7);   // bucket 3
+  histogram.record(8);   // bucket 4: [8, 15]
+
+  KJ_EXPECT(histogram.getBucket(0) == 1);
+  KJ_EXPECT(histogram.getBucket(1) == 1);
+  KJ_EXPECT(histogram.getBucket(2) == 0);
+  KJ_EXPECT(histogram.getBucket(3) == 2);
+  KJ_EXPECT(histogram.getBucket(4) == 1);
+  KJ_EXPECT(histogram.getCount() == 5);
+  KJ_EXPECT(histogram.getSum() == 21);
+}
+
+KJ_TEST("HotHistogram renders cumulative Prometheus buckets") {
+  static HotHistogram histogram("test_hot_histogram_render");
+
+  histogram.record(0);
+  histogram.record(3);
+  histogram.record(100);
+
+  KJ_EXPECT(rendersLine("# TYPE test_hot_histogram_render histogram"));
+  KJ_EXPECT(rendersLine("test_hot_histogram_render_bucket{le=\"0\"} 1"));
+  KJ_EXPECT(rendersLine("test_hot_histogram_render_bucket{le=\"3\"} 2"));
+  KJ_EXPECT(rendersLine("test_hot_histogram_render_bucket{le=\"127\"} 3"));
+  KJ_EXPECT(rendersLine("test_hot_histogram_render_bucket{le=\"+Inf\"} 3"));
+  KJ_EXPECT(rendersLine("test_hot_histogram_render_sum 103"));
+  KJ_EXPECT(rendersLine("test_hot_histogram_render_count 3"));
+}
+
+}  // namespace
+}  // namespace workerd
@@ -0,0 +1,88 @@
+// Copyright (c) 2017-2022 Cloudflare, Inc.
+// Licensed under the Apache 2.0 license found in the LICENSE file or at:
+//     https://opensource.org/licenses/Apache-2.0
+
+#include "hot-metrics.h"
+
+#include <kj/vector.h>
+
+#include <bit>
+#include <limits>
+
+namespace workerd {
+
+namespace {
+
+// Heads of the global registries. Entries are pushed with a CAS loop so that metrics constructed
+// lazily from multiple threads (function-local statics) never race; entries are never removed.
+std::atomic<HotCounter*> counterRegistry{nullptr};
+std::atomic<HotHistogram*> histogramRegistry{nullptr};
+
+template <typename T>
+void registerMetric(std::atomic<T*>& head, T& metric, T*& nextSlot) {
+  T* expected = head.load(std::memory_order_relaxed);
+  do {
+    nextSlot = expected;
+  } while (!head.compare_exchange_weak(expected, &metric,
+      std::memory_order_release, std::memory_order_relaxed));
+}
+
+// Upper bound (inclusive) of histogram bucket `i`, for the `le` label.
+uint64_t bucketUpperBound(size_t i) {
+  if (i >= 64) return std::numeric_limits<uint64_t>::max();
+  return (uint64_t(1) << i) - 1;
+}
+
+}  // namespace
+
+HotCounter::HotCounter(kj::StringPtr name): name(name) {
+  registerMetric(counterRegistry, *this, next);
+}
+
+HotHistogram::HotHistogram(kj::StringPtr name): name(name) {
+  registerMetric(histogramRegistry, *this, next);
+}
+
+void HotHistogram::record(uint64_t sample) {
+  size_t bucket = std::bit_width(sample);  // zero maps to bucket 0
+  buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  sum.fetch_add(sample, std::memory_order_relaxed);
+}
+
+uint64_t HotHistogram::getCount() const {
+  uint64_t count = 0;
+  for (auto& bucket: buckets) {
+    count += bucket.load(std::memory_order_relaxed);
+  }
+  return count;
+}
+
+kj::String renderHotMetrics() {
+  kj::Vector<kj::String> lines;
+
+  for (HotCounter* counter = counterRegistry.load(std::memory_order_acquire);
+       counter != nullptr; counter = counter->next) {
+    lines.add(kj::str("# TYPE ", counter->name, " counter\n"));
+    lines.add(kj::str(counter->name, " ", counter->get(), "\n"));
+  }
+
+  for (HotHistogram* histogram = histogramRegistry.load(std::memory_order_acquire);
+       histogram != nullptr; histogram = histogram->next) {
+    lines.add(kj::str("# TYPE ", histogram->name, " histogram\n"));
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < HotHistogram::BUCKET_COUNT; i++) {
+      uint64_t count = histogram->getBucket(i);
+      if (count == 0) continue;  // cumulative buckets may be sparse
+      cumulative += count;
+      lines.add(kj::str(histogram->name, "_bucket{le=\"", bucketUpperBound(i), "\"} ",
+                        cumulative, "\n"));
+    }
+    lines.add(kj::str(histogram->name, "_bucket{le=\"+Inf\"} ", cumulative, "\n"));
+    lines.add(kj::str(histogram->name, "_sum ", histogram->getSum(), "\n"));
+    lines.add(kj::str(histogram->name, "_count ", cumulative, "\n"));
+  }
+
+  return kj::strArray(lines, "");
+}
+
+}  // namespace workerd
@@ -0,0 +1,87 @@
+// Copyright (c) 2017-2022 Cloudflare, Inc.
+// Licensed under the Apache 2.0 license found in the LICENSE file or at:
+//     https://opensource.org/licenses/Apache-2.0
+
+#pragma once
+
+#include <kj/string.h>
+#include <atomic>
+#include <cstdint>
+
+namespace workerd {
+
+// Process-wide, always-on metrics primitives for hot paths.
+//
+// Unlike the observer interfaces (IsolateObserver, RequestObserver, ActorCache::Hooks), which are
+// virtual hooks that embedders may or may not implement, these counters are meant to be cheap
+// enough to leave enabled unconditionally in production: each update is a single relaxed atomic
+// add with no locks, no clock reads, and no allocation.
+//
+// Counters and histograms register themselves in a global intrusive list at construction and are
+// never unregistered, so they must have static storage duration. The intended usage pattern is a
+// function-local static at the instrumentation site:
+//
+//     static HotCounter counter("workerd_isolate_lock_acquisitions");
+//     counter.add();
+//
+// All registered metrics can be rendered at once with renderHotMetrics(), which the server exposes
+// over a pull endpoint (see `--metrics-addr`).
+
+// A monotonically increasing 64-bit counter.
+class HotCounter {
+public:
+  // `name` must be a string literal (or otherwise outlive the process); it is not copied.
+  explicit HotCounter(kj::StringPtr name);
+  KJ_DISALLOW_COPY_AND_MOVE(HotCounter);
+
+  void add(uint64_t n = 1) { value.fetch_add(n, std::memory_order_relaxed); }
+  uint64_t get() const { return value.load(std::memory_order_relaxed); }
+  kj::StringPtr getName() const { return name; }
+
+private:
+  kj::StringPtr name;
+  std::atomic<uint64_t> value{0};
+
+  // Next entry in the global registry, fixed at construction.
+  HotCounter* next;
+
+  friend kj::String renderHotMetrics();
+};
+
+// A histogram over non-negative integer samples (durations in microseconds, sizes in bytes or
+// entries, etc.) using power-of-two buckets: bucket i counts samples whose value fits in i bits,
+// i.e. samples in [2^(i-1), 2^i - 1], with bucket 0 reserved for zero. This keeps record() down to
+// a bit-scan plus two relaxed atomic adds while still giving usable latency percentiles.
+class HotHistogram {
+public:
+  // One bucket per possible bit width of a uint64_t sample, plus one for zero.
+  static constexpr size_t BUCKET_COUNT = 65;
+
+  // `name` must be a string literal (or otherwise outlive the process); it is not copied.
+  explicit HotHistogram(kj::StringPtr name);
+  KJ_DISALLOW_COPY_AND_MOVE(HotHistogram);
+
+  void record(uint64_t sample);
+
+  uint64_t getCount() const;
+  uint64_t getSum() const { return sum.load(std::memory_order_relaxed); }
+  uint64_t getBucket(size_t i) const { return buckets[i].load(std::memory_order_relaxed); }
+  kj::StringPtr getName() const { return name; }
+
+private:
+  kj::StringPtr name;
+  std::atomic<uint64_t> buckets[BUCKET_COUNT] = {};
+  std::atomic<uint64_t> sum{0};
+
+  // Next entry in the global registry, fixed at construction.
+  HotHistogram* next;
+
+  friend kj::String renderHotMetrics();
+};
+
+// Renders every registered counter and histogram in the Prometheus text exposition format.
+// Individual values are read with relaxed loads, so the output is not an atomic snapshot, but
+// every counter is monotonic so scrapes are still meaningful.
+kj::String renderHotMetrics();
+
+}  // namespace workerd
@@ -580,6 +580,26 @@ KJ_TEST("Extract Mime Type") {
   }
 }
 
+KJ_TEST("Canonical mime types are interned and copy-on-write") {
+  auto a = KJ_ASSERT_NONNULL(MimeType::tryParse("application/json"_kj));
+  auto b = KJ_ASSERT_NONNULL(MimeType::tryParse("application/json"_kj));
+
+  // Both instances share the interned canonical storage.
+  KJ_ASSERT(a.type().begin() == b.type().begin());
+  KJ_ASSERT(a == MimeType::JSON);
+  KJ_ASSERT(a.toString() == "application/json");
+
+  // Mutating one copies the shared data first, leaving the other untouched.
+  KJ_ASSERT(a.addParam("charset"_kj, "utf-8"_kj));
+  KJ_ASSERT(a.toString() == "application/json;charset=utf-8");
+  KJ_ASSERT(b.params().size() == 0);
+  KJ_ASSERT(a.type().begin() != b.type().begin());
+
+  // A spelling not in the table still parses normally.
+  auto c = KJ_ASSERT_NONNULL(MimeType::tryParse("application/vnd.api+json"_kj));
+  KJ_ASSERT(c.toString() == "application/vnd.api+json");
+}
+
 }  // namespace
 }  // namespace workerd
 
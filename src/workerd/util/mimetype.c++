@@ -83,9 +83,52 @@ MimeType MimeType::parse(kj::StringPtr input, ParseOptions options) {
 }
 
 kj::Maybe<MimeType> MimeType::tryParse(kj::ArrayPtr<const char> input, ParseOptions options) {
+  if (!(options & ParseOptions::IGNORE_PARAMS)) {
+    // Fast path: the handful of content types we see constantly are interned, letting us
+    // skip the parse and all per-call allocations.
+    KJ_IF_SOME(canonical, findCanonical(input)) {
+      return MimeType(&canonical);
+    }
+  }
   return tryParseImpl(input, kj::mv(options));
 }
 
+kj::Maybe<const MimeType&> MimeType::findCanonical(kj::ArrayPtr<const char> input) {
+  // Only exact spellings are matched; anything else takes the regular parse path. The
+  // list covers the content types that dominate fetch traffic.
+  static const kj::HashMap<kj::ArrayPtr<const char>, MimeType> table = []() {
+    static constexpr kj::StringPtr SPELLINGS[] = {
+      "application/json"_kj,
+      "application/json; charset=utf-8"_kj,
+      "application/json;charset=utf-8"_kj,
+      "application/javascript"_kj,
+      "application/octet-stream"_kj,
+      "application/x-www-form-urlencoded"_kj,
+      "application/wasm"_kj,
+      "text/plain"_kj,
+      "text/plain;charset=UTF-8"_kj,
+      "text/plain; charset=utf-8"_kj,
+      "text/html"_kj,
+      "text/html; charset=utf-8"_kj,
+      "text/html;charset=UTF-8"_kj,
+      "text/css"_kj,
+      "text/javascript"_kj,
+      "text/event-stream"_kj,
+      "image/png"_kj,
+      "image/jpeg"_kj,
+      "image/gif"_kj,
+      "image/webp"_kj,
+      "image/svg+xml"_kj,
+    };
+    kj::HashMap<kj::ArrayPtr<const char>, MimeType> map;
+    for (auto spelling: SPELLINGS) {
+      map.insert(spelling.asArray(), KJ_ASSERT_NONNULL(tryParseImpl(spelling)));
+    }
+    return map;
+  }();
+  return table.find(input);
+}
+
 kj::Maybe<MimeType> MimeType::tryParseImpl(kj::ArrayPtr<const char> input, ParseOptions options) {
   // Skip leading whitespace from start
   input = skipWhitespace(input);
@@ -216,27 +259,43 @@ MimeType::MimeType(kj::StringPtr type,
   KJ_IF_SOME(p, params) { params_ = kj::mv(p); }
 }
 
+void MimeType::materialize() {
+  KJ_IF_SOME(s, shared_) {
+    type_ = kj::str(s.type_);
+    subtype_ = kj::str(s.subtype_);
+    for (const auto& entry : s.params_) {
+      params_.insert(kj::str(entry.key), kj::str(entry.value));
+    }
+    shared_ = kj::none;
+  }
+}
+
 kj::StringPtr MimeType::type() const {
+  KJ_IF_SOME(s, shared_) return s.type_;
   return type_;
 }
 
 bool MimeType::setType(kj::StringPtr type) {
   if (type.size() == 0 || hasInvalidCodepoints(type, isTokenChar)) return false;
+  materialize();
   type_ = toLowerCopy(type);
   return true;
 }
 
 kj::StringPtr MimeType::subtype() const {
+  KJ_IF_SOME(s, shared_) return s.subtype_;
   return subtype_;
 }
 
 bool MimeType::setSubtype(kj::StringPtr type) {
   if (type.size() == 0 || hasInvalidCodepoints(type, isTokenChar)) return false;
+  materialize();
   subtype_ = toLowerCopy(type);
   return true;
 }
 
 const MimeType::MimeParams& MimeType::params() const {
+  KJ_IF_SOME(s, shared_) return s.params_;
   return params_;
 }
 
@@ -246,11 +305,13 @@ bool MimeType::addParam(kj::ArrayPtr<const char> name, kj::ArrayPtr<const char>
       hasInvalidCodepoints(value, isQuotedStringTokenChar)) {
     return false;
   }
+  materialize();
   params_.upsert(toLowerCopy(name), kj::str(value), [](auto&, auto&&) {});
   return true;
 }
 
 void MimeType::eraseParam(kj::StringPtr name) {
+  materialize();
   params_.erase(toLowerCopy(name));
 }
 
@@ -293,7 +354,7 @@ void MimeType::paramsToString(MimeType::ToStringBuffer& buffer) const {
 kj::String MimeType::toString() const {
   ToStringBuffer buffer(512);
   buffer.append(type(), "/", subtype());
-  if (params_.size() > 0) {
+  if (params().size() > 0) {
     buffer.append(";");
     paramsToString(buffer);
   }
@@ -301,6 +362,13 @@ kj::String MimeType::toString() const {
 }
 
 MimeType MimeType::clone(ParseOptions options) const {
+  KJ_IF_SOME(s, shared_) {
+    if (!(options & ParseOptions::IGNORE_PARAMS) || s.params_.size() == 0) {
+      // Cloning a shared instance just shares the same canonical storage.
+      return MimeType(&s);
+    }
+    return s.clone(options);
+  }
   MimeParams copy;
   if (!(options & ParseOptions::IGNORE_PARAMS)) {
     for (const auto& entry : params_) {
@@ -311,7 +379,7 @@ MimeType MimeType::clone(ParseOptions options) const {
 }
 
 bool MimeType::operator==(const MimeType& other) const {
-  return this == &other || (type_ == other.type_ && subtype_ == other.subtype_);
+  return this == &other || (type() == other.type() && subtype() == other.subtype());
 }
 
 MimeType::operator kj::String() const { return toString(); }
@@ -405,7 +473,7 @@ kj::Maybe<MimeType> MimeType::extract(kj::StringPtr input) {
   };
 
   constexpr static auto processPart = [](auto& mimeType, auto& part) -> kj::Maybe<MimeType>{
-    KJ_IF_SOME(parsed, tryParseImpl(part)) {
+    KJ_IF_SOME(parsed, tryParse(part)) {
       if (parsed == MimeType::WILDCARD) return kj::none;
 
       KJ_IF_SOME(current, mimeType) {
@@ -25,6 +25,11 @@ public:
   // Returning nullptr implies that the input is not a valid mime type construction.
   // If the ParseOptions::IGNORE_PARAMS option is set then the mime type parameters
   // will be ignored and will not be included in the parsed result.
+  //
+  // As an optimization, inputs that exactly match one of a small set of very common
+  // content-type spellings skip parsing entirely and return an instance sharing the
+  // storage of an interned canonical MimeType. Such instances behave identically to
+  // parsed ones; mutation copies the shared data first (copy-on-write).
   static kj::Maybe<MimeType> tryParse(kj::ArrayPtr<const char> input,
                                       ParseOptions options = ParseOptions::DEFAULT);
 
@@ -109,13 +114,30 @@ private:
   kj::String subtype_;
   MimeParams params_;
 
+  // When set, this instance shares the storage of an interned canonical MimeType with
+  // static lifetime and the fields above are unused. Cleared by materialize().
+  kj::Maybe<const MimeType&> shared_;
+
   using ToStringBuffer = StringBuffer<128>;
   // 128 bytes will keep all reasonable mimetypes on the stack.
 
+  // Creates an instance sharing the storage of `canonical`, which must have static
+  // lifetime. Used by the tryParse fast path.
+  explicit MimeType(const MimeType* canonical): shared_(*canonical) {}
+
+  // If this instance shares a canonical MimeType's storage, copy that data into our own
+  // fields so it can be mutated. Called by all mutators.
+  void materialize();
+
   void paramsToString(ToStringBuffer& buffer) const;
 
   static kj::Maybe<MimeType> tryParseImpl(kj::ArrayPtr<const char> input,
                                           ParseOptions options = ParseOptions::DEFAULT);
+
+  // Returns the interned canonical instance for `input` if it exactly matches one of the
+  // most common content-type spellings. The table is built once on first use and is
+  // immutable afterward, so lookups are lock-free reads.
+  static kj::Maybe<const MimeType&> findCanonical(kj::ArrayPtr<const char> input);
 };
 
 kj::String KJ_STRINGIFY(const MimeType& state);
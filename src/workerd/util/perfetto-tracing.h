@@ -51,6 +51,8 @@ private:
 #define PERFETTO_FLOW_FROM_POINTER(ptr) perfetto::Flow::FromPointer(ptr)
 #define PERFETTO_TERMINATING_FLOW_FROM_POINTER(ptr) perfetto::TerminatingFlow::FromPointer(ptr)
 #define PERFETTO_TRACK_FROM_POINTER(ptr) perfetto::Track::FromPointer(ptr)
+// A named counter track for use with TRACE_COUNTER. The name must be a string literal.
+#define PERFETTO_COUNTER_TRACK(name) perfetto::CounterTrack(name)
 
 KJ_DECLARE_NON_POLYMORPHIC(PerfettoSession::Impl);
 }  // workerd
@@ -68,4 +70,5 @@ struct PerfettoNoop {};
 #define PERFETTO_FLOW_FROM_POINTER(ptr) PerfettoNoop {}
 #define PERFETTO_TERMINATING_FLOW_FROM_POINTER(ptr) PerfettoNoop {}
 #define PERFETTO_TRACK_FROM_POINTER(ptr) PerfettoNoop {}
+#define PERFETTO_COUNTER_TRACK(name) PerfettoNoop {}
 #endif  // defined(WORKERD_USE_PERFETTO)
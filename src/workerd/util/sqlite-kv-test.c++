@@ -91,5 +91,173 @@ KJ_TEST("SQLite-KV") {
   KJ_EXPECT(list(nullptr, kj::none, kj::none, F) == "");
 }
 
+KJ_TEST("SQLite-KV multi-key operations") {
+  auto dir = kj::newInMemoryDirectory(kj::nullClock());
+  SqliteDatabase::Vfs vfs(*dir);
+  SqliteDatabase db(vfs, kj::Path({"foo"}), kj::WriteMode::CREATE | kj::WriteMode::MODIFY);
+  SqliteKv kv(db);
+
+  // Use enough entries to exercise the full-batch, small-batch, and single-row paths.
+  constexpr size_t COUNT = 75;
+  static_assert(COUNT > 2 * SqliteKv::MULTI_BATCH_SIZE);
+
+  auto keys = KJ_MAP(i, kj::range<size_t>(0, COUNT)) -> kj::String {
+    return kj::str("key", i);
+  };
+  auto values = KJ_MAP(i, kj::range<size_t>(0, COUNT)) -> kj::String {
+    return kj::str("value", i);
+  };
+  auto pairs = KJ_MAP(i, kj::range<size_t>(0, COUNT)) -> SqliteKv::Pair {
+    return { keys[i], values[i].asBytes() };
+  };
+  kv.put(pairs);
+
+  auto keyPtrs = KJ_MAP(k, keys) -> SqliteKv::KeyPtr { return k; };
+
+  {
+    uint found = kv.get(keyPtrs, [&](kj::StringPtr key, kj::ArrayPtr<const byte> value) {
+      KJ_EXPECT(kj::str(value.asChars()) == kj::str("value", key.slice(3)));
+    });
+    KJ_EXPECT(found == COUNT);
+  }
+
+  // Multi-put can overwrite existing entries.
+  auto updated = KJ_MAP(i, kj::range<size_t>(0, COUNT)) -> kj::String {
+    return kj::str("updated", i);
+  };
+  auto updatedPairs = KJ_MAP(i, kj::range<size_t>(0, COUNT)) -> SqliteKv::Pair {
+    return { keys[i], updated[i].asBytes() };
+  };
+  kv.put(updatedPairs);
+
+  {
+    uint found = kv.get(keyPtrs, [&](kj::StringPtr key, kj::ArrayPtr<const byte> value) {
+      KJ_EXPECT(kj::str(value.asChars()) == kj::str("updated", key.slice(3)));
+    });
+    KJ_EXPECT(found == COUNT);
+  }
+
+  // Missing keys are simply not reported.
+  {
+    kj::Vector<SqliteKv::KeyPtr> someKeys;
+    someKeys.add("key3");
+    someKeys.add("no-such-key");
+    someKeys.add("key70");
+    uint found = kv.get(someKeys, [&](kj::StringPtr key, kj::ArrayPtr<const byte> value) {
+      KJ_EXPECT(key == "key3" || key == "key70", key);
+    });
+    KJ_EXPECT(found == 2);
+  }
+
+  // Multi-delete counts only the keys that were matched, including across batch boundaries.
+  {
+    kj::Vector<SqliteKv::KeyPtr> toDelete;
+    for (size_t i = 0; i < 40; i++) {
+      toDelete.add(keys[i]);
+    }
+    toDelete.add("no-such-key");
+    KJ_EXPECT(kv.delete_(toDelete) == 40);
+    KJ_EXPECT(kv.delete_(toDelete) == 0);
+  }
+
+  {
+    uint found = kv.get(keyPtrs, [&](kj::StringPtr key, kj::ArrayPtr<const byte> value) {});
+    KJ_EXPECT(found == COUNT - 40);
+  }
+}
+
+KJ_TEST("SQLite-KV chunked large values") {
+  auto dir = kj::newInMemoryDirectory(kj::nullClock());
+  SqliteDatabase::Vfs vfs(*dir);
+  SqliteDatabase db(vfs, kj::Path({"foo"}), kj::WriteMode::CREATE | kj::WriteMode::MODIFY);
+  SqliteKv kv(db);
+
+  // A value spanning multiple chunks, with a non-chunk-aligned tail.
+  auto bigValue = kj::heapArray<byte>(2 * SqliteKv::VALUE_CHUNK_SIZE + 12345);
+  for (auto i: kj::indices(bigValue)) {
+    bigValue[i] = static_cast<byte>(i * 31 + (i >> 11));
+  }
+
+  kv.put("big", bigValue);
+  kv.put("small", "abc"_kj.asBytes());
+
+  {
+    bool called = false;
+    KJ_EXPECT(kv.get("big", [&](kj::ArrayPtr<const byte> value) {
+      KJ_EXPECT(value == bigValue.asPtr());
+      called = true;
+    }));
+    KJ_EXPECT(called);
+  }
+
+  // list() reassembles chunked values, too.
+  {
+    uint seen = 0;
+    kv.list(nullptr, kj::none, kj::none, SqliteKv::FORWARD,
+        [&](kj::StringPtr key, kj::ArrayPtr<const byte> value) {
+      if (key == "big") {
+        KJ_EXPECT(value == bigValue.asPtr());
+      } else {
+        KJ_EXPECT(key == "small");
+        KJ_EXPECT(kj::str(value.asChars()) == "abc");
+      }
+      ++seen;
+    });
+    KJ_EXPECT(seen == 2);
+  }
+
+  // So does the multi-key get.
+  {
+    kj::Vector<SqliteKv::KeyPtr> keys;
+    keys.add("big");
+    keys.add("small");
+    uint found = kv.get(keys, [&](kj::StringPtr key, kj::ArrayPtr<const byte> value) {
+      if (key == "big") {
+        KJ_EXPECT(value == bigValue.asPtr());
+      }
+    });
+    KJ_EXPECT(found == 2);
+  }
+
+  // A second SqliteKv on the same database (as after a restart) can read chunked values.
+  {
+    SqliteKv kv2(db);
+    bool called = false;
+    KJ_EXPECT(kv2.get("big", [&](kj::ArrayPtr<const byte> value) {
+      KJ_EXPECT(value == bigValue.asPtr());
+      called = true;
+    }));
+    KJ_EXPECT(called);
+  }
+
+  // Overwriting a chunked value with a small one cleans up the chunk rows.
+  kv.put("big", "tiny"_kj.asBytes());
+  {
+    bool called = false;
+    KJ_EXPECT(kv.get("big", [&](kj::ArrayPtr<const byte> value) {
+      KJ_EXPECT(kj::str(value.asChars()) == "tiny");
+      called = true;
+    }));
+    KJ_EXPECT(called);
+    KJ_EXPECT(db.run("SELECT count(*) FROM _cf_KV_chunks").getInt(0) == 0);
+  }
+
+  // Deleting a chunked value works and is counted once.
+  kv.put("big", bigValue);
+  KJ_EXPECT(kv.delete_("big"));
+  KJ_EXPECT(!kv.get("big", [&](kj::ArrayPtr<const byte> value) {
+    KJ_FAIL_EXPECT("should not call callback after delete", value.asChars());
+  }));
+  KJ_EXPECT(db.run("SELECT count(*) FROM _cf_KV_chunks").getInt(0) == 0);
+
+  // deleteAll() clears chunk rows as well.
+  kv.put("big", bigValue);
+  kv.deleteAll();
+  KJ_EXPECT(db.run("SELECT count(*) FROM _cf_KV_chunks").getInt(0) == 0);
+  KJ_EXPECT(!kv.get("big", [&](kj::ArrayPtr<const byte> value) {
+    KJ_FAIL_EXPECT("should not call callback after deleteAll", value.asChars());
+  }));
+}
+
 }  // namespace
 }  // namespace workerd
@@ -4,9 +4,19 @@
 
 #include "sqlite-kv.h"
 
+#include <string.h>
+
 namespace workerd {
 
-SqliteKv::SqliteKv(SqliteDatabase& db, bool): db(db) {}
+SqliteKv::SqliteKv(SqliteDatabase& db, bool): db(db) {
+  // If a previous session stored chunked values, the chunk table already exists and we must be
+  // prepared to read such values and to clean up chunk rows on overwrites and deletes.
+  auto query = db.run("SELECT 1 FROM sqlite_master WHERE name = '_cf_KV_chunks'");
+  if (!query.isDone()) {
+    chunkStatements.emplace(db);
+    mayContainChunks = true;
+  }
+}
 
 SqliteDatabase& SqliteKv::ensureInitialized(SqliteDatabase& db) {
   // TODO(sqlite): Do this automatically at a lower layer?
@@ -23,17 +33,224 @@ SqliteDatabase& SqliteKv::ensureInitialized(SqliteDatabase& db) {
 }
 
 void SqliteKv::put(KeyPtr key, ValuePtr value) {
-  stmtPut.run(key, value);
+  if (value.size() <= VALUE_CHUNK_SIZE) {
+    stmtPut.run(key, value);
+    if (mayContainChunks) {
+      // The previous value for this key may have been chunked.
+      KJ_ASSERT_NONNULL(chunkStatements).delete_.run(key);
+    }
+  } else {
+    auto& chunks = ensureChunkTable();
+    chunks.delete_.run(key);
+
+    // Store a NULL marker in the main row. Legitimate values are never NULL (an empty value is a
+    // zero-length blob), so a NULL value unambiguously means "assembled from _cf_KV_chunks".
+    stmtPut.run(key, nullptr);
+
+    int64_t seq = 0;
+    for (size_t offset = 0; offset < value.size(); offset += VALUE_CHUNK_SIZE) {
+      size_t n = kj::min(VALUE_CHUNK_SIZE, value.size() - offset);
+      chunks.put.run(key, seq++, value.slice(offset, offset + n));
+    }
+
+    mayContainChunks = true;
+  }
+}
+
+void SqliteKv::put(kj::ArrayPtr<const Pair> pairs) {
+  bool hasOversized = false;
+  for (auto& pair: pairs) {
+    if (pair.value.size() > VALUE_CHUNK_SIZE) {
+      hasOversized = true;
+      break;
+    }
+  }
+
+  if (KJ_LIKELY(!hasOversized)) {
+    putBatched(pairs);
+  } else {
+    // Oversized values take the chunked path individually; the rest are still batched.
+    kj::Vector<Pair> inlinePairs(pairs.size());
+    for (auto& pair: pairs) {
+      if (pair.value.size() > VALUE_CHUNK_SIZE) {
+        put(pair.key, pair.value);
+      } else {
+        inlinePairs.add(pair);
+      }
+    }
+    putBatched(inlinePairs);
+  }
+}
+
+void SqliteKv::putBatched(kj::ArrayPtr<const Pair> pairs) {
+  size_t pos = 0;
+
+  auto runBatches = [&](SqliteDatabase::Statement& stmt, size_t batchSize) {
+    while (pairs.size() - pos >= batchSize) {
+      SqliteDatabase::Query::ValuePtr bindings[MULTI_BATCH_SIZE * 2];
+      for (size_t i = 0; i < batchSize; i++) {
+        bindings[i * 2] = pairs[pos + i].key;
+        bindings[i * 2 + 1] = pairs[pos + i].value;
+      }
+      kj::ArrayPtr<const SqliteDatabase::Query::ValuePtr> bindingsPtr =
+          kj::arrayPtr(bindings, batchSize * 2);
+      stmt.run(bindingsPtr);
+
+      if (mayContainChunks) {
+        // Some of the overwritten keys may previously have held chunked values. The key list can
+        // be padded with duplicates just like in the multi-key delete_().
+        SqliteDatabase::Query::ValuePtr keyBindings[MULTI_BATCH_SIZE];
+        for (size_t i = 0; i < batchSize; i++) {
+          keyBindings[i] = pairs[pos + i].key;
+        }
+        for (size_t i = batchSize; i < MULTI_BATCH_SIZE; i++) {
+          keyBindings[i] = pairs[pos].key;
+        }
+        kj::ArrayPtr<const SqliteDatabase::Query::ValuePtr> keyBindingsPtr = keyBindings;
+        KJ_ASSERT_NONNULL(chunkStatements).multiDelete.run(keyBindingsPtr);
+      }
+
+      pos += batchSize;
+    }
+  };
+
+  runBatches(stmtMultiPut, MULTI_BATCH_SIZE);
+  runBatches(stmtMultiPutSmall, MULTI_PUT_SMALL_BATCH);
+
+  for (; pos < pairs.size(); pos++) {
+    put(pairs[pos].key, pairs[pos].value);
+  }
 }
 
 bool SqliteKv::delete_(KeyPtr key) {
-  auto query = stmtDelete.run(key);
-  return query.changeCount() > 0;
+  uint count = stmtDelete.run(key).changeCount();
+  if (mayContainChunks) {
+    KJ_ASSERT_NONNULL(chunkStatements).delete_.run(key);
+  }
+  return count > 0;
+}
+
+uint SqliteKv::delete_(kj::ArrayPtr<const KeyPtr> keys) {
+  uint count = 0;
+
+  size_t pos = 0;
+  while (pos < keys.size()) {
+    size_t n = kj::min(keys.size() - pos, MULTI_BATCH_SIZE);
+
+    SqliteDatabase::Query::ValuePtr bindings[MULTI_BATCH_SIZE];
+    for (size_t i = 0; i < n; i++) {
+      bindings[i] = keys[pos + i];
+    }
+    for (size_t i = n; i < MULTI_BATCH_SIZE; i++) {
+      // Pad the final batch with a repeated key; the row it names is deleted (and counted) only
+      // once regardless.
+      bindings[i] = keys[pos];
+    }
+
+    kj::ArrayPtr<const SqliteDatabase::Query::ValuePtr> bindingsPtr = bindings;
+    count += stmtMultiDelete.run(bindingsPtr).changeCount();
+    if (mayContainChunks) {
+      KJ_ASSERT_NONNULL(chunkStatements).multiDelete.run(bindingsPtr);
+    }
+
+    pos += n;
+  }
+
+  return count;
 }
 
 uint SqliteKv::deleteAll() {
-  auto query = stmtDeleteAll.run();
-  return query.changeCount();
+  uint count = stmtDeleteAll.run().changeCount();
+  if (mayContainChunks) {
+    KJ_ASSERT_NONNULL(chunkStatements).deleteAll.run();
+    mayContainChunks = false;
+  }
+  return count;
+}
+
+SqliteKv::ChunkStatements::ChunkStatements(SqliteDatabase& db)
+    : get(db.prepare(R"(
+        SELECT chunk FROM _cf_KV_chunks WHERE key = ? ORDER BY seq
+      )")),
+      size(db.prepare(R"(
+        SELECT sum(length(chunk)) FROM _cf_KV_chunks WHERE key = ?
+      )")),
+      put(db.prepare(R"(
+        INSERT INTO _cf_KV_chunks VALUES(?, ?, ?)
+      )")),
+      delete_(db.prepare(R"(
+        DELETE FROM _cf_KV_chunks WHERE key = ?
+      )")),
+      deleteAll(db.prepare(R"(
+        DELETE FROM _cf_KV_chunks
+      )")),
+      multiDelete(db.prepare(SqliteDatabase::TRUSTED, multiDeleteChunksSql())) {}
+
+SqliteKv::ChunkStatements& SqliteKv::ensureChunkTable() {
+  KJ_IF_SOME(s, chunkStatements) {
+    return s;
+  }
+
+  db.run(R"(
+    CREATE TABLE IF NOT EXISTS _cf_KV_chunks (
+      key TEXT,
+      seq INTEGER,
+      chunk BLOB,
+      PRIMARY KEY(key, seq)
+    ) WITHOUT ROWID;
+  )");
+
+  return chunkStatements.emplace(db);
+}
+
+kj::Array<kj::byte> SqliteKv::readChunks(KeyPtr key) {
+  auto& chunks = KJ_ASSERT_NONNULL(chunkStatements);
+
+  // Query the total size up front so that the value can be assembled directly into its final
+  // buffer, without growth reallocations that would briefly double the memory footprint.
+  size_t size = (size_t)chunks.size.run(key).getInt64(0);
+  auto result = kj::heapArray<kj::byte>(size);
+
+  size_t offset = 0;
+  auto query = chunks.get.run(key);
+  while (!query.isDone()) {
+    auto chunk = query.getBlob(0);
+    KJ_ASSERT(offset + chunk.size() <= size);
+    memcpy(result.begin() + offset, chunk.begin(), chunk.size());
+    offset += chunk.size();
+    query.nextRow();
+  }
+  KJ_ASSERT(offset == size);
+
+  return result;
+}
+
+static kj::String makePlaceholderList(size_t count, kj::StringPtr placeholder) {
+  auto parts = kj::heapArray<kj::StringPtr>(count);
+  for (auto& part: parts) part = placeholder;
+  return kj::strArray(parts, ", ");
+}
+
+kj::String SqliteKv::multiGetSql() {
+  return kj::str(
+      "SELECT key, value FROM _cf_KV WHERE key IN (",
+      makePlaceholderList(MULTI_BATCH_SIZE, "?"), ") ORDER BY key");
+}
+
+kj::String SqliteKv::multiPutSql(size_t pairCount) {
+  return kj::str(
+      "INSERT INTO _cf_KV VALUES ", makePlaceholderList(pairCount, "(?, ?)"),
+      " ON CONFLICT DO UPDATE SET value = excluded.value;");
+}
+
+kj::String SqliteKv::multiDeleteSql() {
+  return kj::str(
+      "DELETE FROM _cf_KV WHERE key IN (", makePlaceholderList(MULTI_BATCH_SIZE, "?"), ")");
+}
+
+kj::String SqliteKv::multiDeleteChunksSql() {
+  return kj::str(
+      "DELETE FROM _cf_KV_chunks WHERE key IN (", makePlaceholderList(MULTI_BATCH_SIZE, "?"), ")");
 }
 
 }  // namespace workerd
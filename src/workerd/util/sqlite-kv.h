@@ -15,6 +15,10 @@ namespace workerd {
 // perform direct SQL queries, we can block it from accessing any table prefixed with `_cf_`.
 // (Ideally this class would allow configuring the table name, but this would require a somewhat
 // obnoxious amount of string allocation.)
+//
+// Values larger than VALUE_CHUNK_SIZE are transparently split across multiple rows of a second
+// table, `_cf_KV_chunks`, which is created lazily the first time such a value is stored. See
+// put() for details.
 class SqliteKv {
 public:
   explicit SqliteKv(SqliteDatabase& db): SqliteKv(ensureInitialized(db), true) {}
@@ -40,6 +44,16 @@ public:
   uint list(KeyPtr begin, kj::Maybe<KeyPtr> end, kj::Maybe<uint> limit, Order order,
             Func&& callback);
 
+  // Values at most this large are stored inline as a single blob cell. Larger values are split
+  // into rows of this size in the chunk table, so that neither writing nor reading a
+  // multi-megabyte value requires SQLite to materialize it as one huge cell (the transient
+  // memory per statement stays bounded by the chunk size; the caller-visible value is of course
+  // still assembled contiguously).
+  //
+  // Incremental blob I/O (sqlite3_blob_open) would avoid even the per-chunk copies, but it does
+  // not work on WITHOUT ROWID tables like ours, so chunked rows are the next best thing.
+  static constexpr size_t VALUE_CHUNK_SIZE = 256 * 1024;
+
   // Store a value into the table.
   void put(KeyPtr key, ValuePtr value);
 
@@ -48,10 +62,31 @@ public:
 
   uint deleteAll();
 
-  // TODO(perf): Should we provide multi-get, multi-put, and multi-delete? It's a bit tricky to
-  //   implement them as single SQL queries, while still using prepared statements. The c-array
-  //   extension might help here, though it can only support arrays of NUL-terminated strings, not
-  //   byte blobs or strings containing NUL bytes.
+  // Number of rows handled per statement by the multi-key overloads below. Each multi-key
+  // statement is prepared once with this many parameter slots; larger inputs are split into
+  // multiple batches.
+  static constexpr size_t MULTI_BATCH_SIZE = 32;
+
+  // Search for matches for all of the given keys, calling the callback (with KeyPtr and ValuePtr
+  // parameters) for each key that was found. Keys are looked up in batches of MULTI_BATCH_SIZE
+  // using a single `IN`-list query per batch, rather than one query per key. The callback is
+  // invoked in sorted key order within each batch, but not across batches; callers that need a
+  // total order over more than MULTI_BATCH_SIZE results must sort. Returns the number of keys
+  // found.
+  template <typename Func>
+  uint get(kj::ArrayPtr<const KeyPtr> keys, Func&& callback);
+
+  struct Pair {
+    KeyPtr key;
+    ValuePtr value;
+  };
+
+  // Store multiple values into the table, using a multi-row upsert per batch of
+  // MULTI_BATCH_SIZE pairs rather than one statement per pair.
+  void put(kj::ArrayPtr<const Pair> pairs);
+
+  // Delete all of the given keys and return how many of them were matched.
+  uint delete_(kj::ArrayPtr<const KeyPtr> keys);
 
 private:
   SqliteDatabase& db;
@@ -114,6 +149,57 @@ private:
     DELETE FROM _cf_KV
   )");
 
+  // A short batch of puts cannot be padded with duplicates the way the `IN`-list statements can
+  // (that would perform redundant writes), so the tail of a multi-put steps down to this smaller
+  // batch statement before falling back to single-row puts.
+  static constexpr size_t MULTI_PUT_SMALL_BATCH = 8;
+
+  // The multi-key statements need one `?` (or one `(?, ?)` row) per batch slot, which is too
+  // repetitive to comfortably write out as a literal, so their SQL text is generated.
+  static kj::String multiGetSql();
+  static kj::String multiPutSql(size_t pairCount);
+  static kj::String multiDeleteSql();
+
+  SqliteDatabase::Statement stmtMultiGet =
+      db.prepare(SqliteDatabase::TRUSTED, multiGetSql());
+  SqliteDatabase::Statement stmtMultiPut =
+      db.prepare(SqliteDatabase::TRUSTED, multiPutSql(MULTI_BATCH_SIZE));
+  SqliteDatabase::Statement stmtMultiPutSmall =
+      db.prepare(SqliteDatabase::TRUSTED, multiPutSql(MULTI_PUT_SMALL_BATCH));
+  SqliteDatabase::Statement stmtMultiDelete =
+      db.prepare(SqliteDatabase::TRUSTED, multiDeleteSql());
+
+  // Statements against the chunk table. These can only be prepared once the table exists, which
+  // we avoid creating until the first oversized value is stored, both to keep the common case
+  // cheap and to avoid surprising applications that introspect sqlite_master.
+  struct ChunkStatements {
+    SqliteDatabase::Statement get;
+    SqliteDatabase::Statement size;
+    SqliteDatabase::Statement put;
+    SqliteDatabase::Statement delete_;
+    SqliteDatabase::Statement deleteAll;
+    SqliteDatabase::Statement multiDelete;
+
+    explicit ChunkStatements(SqliteDatabase& db);
+  };
+  kj::Maybe<ChunkStatements> chunkStatements;
+
+  // True if the database may contain chunked values, i.e. the chunk table exists and might be
+  // non-empty. While false, writes and deletes skip the chunk-cleanup statements entirely.
+  bool mayContainChunks = false;
+
+  // Creates the chunk table if it does not exist yet and returns the prepared statements for it.
+  ChunkStatements& ensureChunkTable();
+
+  // Reassembles a chunked value. Must only be called for keys whose main-table row holds the
+  // NULL marker.
+  kj::Array<kj::byte> readChunks(KeyPtr key);
+
+  // The batching portion of multi-put, for pairs that are small enough to be stored inline.
+  void putBatched(kj::ArrayPtr<const Pair> pairs);
+
+  static kj::String multiDeleteChunksSql();
+
   SqliteDatabase& ensureInitialized(SqliteDatabase& db);
   // Make sure the KV table is created, then return the same object.
 
@@ -133,19 +219,73 @@ bool SqliteKv::get(KeyPtr key, Func&& callback) {
 
   if (query.isDone()) {
     return false;
+  } else if (query.isNull(0)) {
+    // A NULL value marks a large value stored in chunks; see put().
+    auto assembled = readChunks(key);
+    kj::ArrayPtr<const kj::byte> ptr = assembled;
+    callback(ptr);
+    return true;
   } else {
     callback(query.getBlob(0));
     return true;
   }
 }
 
+template <typename Func>
+uint SqliteKv::get(kj::ArrayPtr<const KeyPtr> keys, Func&& callback) {
+  uint count = 0;
+
+  size_t pos = 0;
+  while (pos < keys.size()) {
+    size_t n = kj::min(keys.size() - pos, MULTI_BATCH_SIZE);
+
+    SqliteDatabase::Query::ValuePtr bindings[MULTI_BATCH_SIZE];
+    for (size_t i = 0; i < n; i++) {
+      bindings[i] = keys[pos + i];
+    }
+    for (size_t i = n; i < MULTI_BATCH_SIZE; i++) {
+      // Pad the final batch by repeating one of its keys. Duplicates in an `IN` list have no
+      // effect on the result, and padding lets us prepare the statement for one fixed batch size.
+      bindings[i] = keys[pos];
+    }
+
+    kj::ArrayPtr<const SqliteDatabase::Query::ValuePtr> bindingsPtr = bindings;
+    auto query = stmtMultiGet.run(bindingsPtr);
+    while (!query.isDone()) {
+      auto key = query.getText(0);
+      if (query.isNull(1)) {
+        // A NULL value marks a large value stored in chunks; see put().
+        auto assembled = readChunks(key);
+        kj::ArrayPtr<const kj::byte> ptr = assembled;
+        callback(key, ptr);
+      } else {
+        callback(key, query.getBlob(1));
+      }
+      query.nextRow();
+      ++count;
+    }
+
+    pos += n;
+  }
+
+  return count;
+}
+
 template <typename Func>
 uint SqliteKv::list(KeyPtr begin, kj::Maybe<KeyPtr> end, kj::Maybe<uint> limit, Order order,
                     Func&& callback) {
   auto iterate = [&](SqliteDatabase::Query&& query) {
     size_t count = 0;
     while (!query.isDone()) {
-      callback(query.getText(0), query.getBlob(1));
+      auto key = query.getText(0);
+      if (query.isNull(1)) {
+        // A NULL value marks a large value stored in chunks; see put().
+        auto assembled = readChunks(key);
+        kj::ArrayPtr<const kj::byte> ptr = assembled;
+        callback(key, ptr);
+      } else {
+        callback(key, query.getBlob(1));
+      }
       query.nextRow();
       ++count;
     }
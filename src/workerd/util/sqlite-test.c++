@@ -5,6 +5,7 @@
 #include "sqlite.h"
 #include <cstdint>
 #include <kj/test.h>
+#include <kj/vector.h>
 #include <kj/thread.h>
 #include <stdlib.h>
 #include <errno.h>
@@ -736,5 +737,199 @@ KJ_TEST("DELETE with LIMIT") {
   KJ_EXPECT(q.getInt(0) == 3);
 }
 
+KJ_TEST("SQLite ad-hoc statement cache") {
+  auto dir = kj::newInMemoryDirectory(kj::nullClock());
+  SqliteDatabase::Vfs vfs(*dir);
+  SqliteDatabase db(vfs, kj::Path({"foo"}), kj::WriteMode::CREATE | kj::WriteMode::MODIFY);
+
+  db.run(R"(CREATE TABLE things (id INTEGER PRIMARY KEY))");
+
+  // Running the same SQL repeatedly (the cached path) keeps working, with fresh bindings each
+  // time.
+  static constexpr kj::StringPtr INSERT = "INSERT INTO things (id) VALUES (?)"_kj;
+  for (int i = 0; i < 10; i++) {
+    db.run(SqliteDatabase::TRUSTED, INSERT, i);
+  }
+  {
+    auto q = db.run("SELECT COUNT(*) FROM things");
+    KJ_EXPECT(q.getInt(0) == 10);
+  }
+
+  // Multi-statement SQL is not cached, and its leading statements execute on every run().
+  for (int i = 0; i < 2; i++) {
+    auto q = db.run(SqliteDatabase::TRUSTED,
+        "INSERT INTO things (id) VALUES ((SELECT MAX(id) + 1 FROM things)); "
+        "SELECT COUNT(*) FROM things"_kj);
+    KJ_EXPECT(q.getInt(0) == 11 + i);
+  }
+
+  // Shrinking the cache (including to zero) doesn't break subsequent queries.
+  db.setStatementCacheSize(1);
+  db.setStatementCacheSize(0);
+  {
+    auto q = db.run("SELECT COUNT(*) FROM things");
+    KJ_EXPECT(q.getInt(0) >= 10);
+  }
+  db.setStatementCacheSize(64);
+  db.run(SqliteDatabase::TRUSTED, INSERT, 1000);
+  {
+    auto q = db.run("SELECT COUNT(*) FROM things");
+    KJ_EXPECT(q.getInt(0) >= 11);
+  }
+}
+
+KJ_TEST("SQLite ad-hoc statement cache: busy and foreign-regulator entries") {
+  auto dir = kj::newInMemoryDirectory(kj::nullClock());
+  SqliteDatabase::Vfs vfs(*dir);
+  SqliteDatabase db(vfs, kj::Path({"foo"}), kj::WriteMode::CREATE | kj::WriteMode::MODIFY);
+
+  db.run(R"(CREATE TABLE things (id INTEGER PRIMARY KEY))");
+  for (int i = 0; i < 3; i++) {
+    db.run(SqliteDatabase::TRUSTED, "INSERT INTO things (id) VALUES (?)", i);
+  }
+
+  static constexpr kj::StringPtr SELECT = "SELECT id FROM things ORDER BY id"_kj;
+
+  // Running the same SQL again while the first query is still alive (as the lazy JS SqlStorage
+  // cursor does) must not try to insert a duplicate cache entry; the second query runs as a
+  // one-off. Both cursors iterate independently.
+  {
+    auto q1 = db.run(SqliteDatabase::TRUSTED, SELECT);
+    auto q2 = db.run(SqliteDatabase::TRUSTED, SELECT);
+    KJ_EXPECT(q1.getInt(0) == 0);
+    q1.nextRow();
+    KJ_EXPECT(q1.getInt(0) == 1);
+    KJ_EXPECT(q2.getInt(0) == 0);
+  }
+
+  // Once both are released, the cached statement is reusable again.
+  {
+    auto q = db.run(SqliteDatabase::TRUSTED, SELECT);
+    KJ_EXPECT(q.getInt(0) == 0);
+  }
+
+  // The same SQL under a different regulator can't reuse the TRUSTED entry, and must not
+  // collide with it either -- including while the cached statement is simultaneously live.
+  class RegulatorImpl: public SqliteDatabase::Regulator {} regulator;
+  {
+    auto q1 = db.run(SqliteDatabase::TRUSTED, SELECT);
+    auto q2 = db.run(regulator, SELECT);
+    KJ_EXPECT(q1.getInt(0) == 0);
+    KJ_EXPECT(q2.getInt(0) == 0);
+  }
+  {
+    auto q = db.run(regulator, SELECT);
+    KJ_EXPECT(q.getInt(0) == 0);
+  }
+}
+
+KJ_TEST("SQLite VFS write observer") {
+  // Records every mutation for later assertions. The test is single-threaded, so no
+  // synchronization is needed despite the const methods.
+  class Recorder final: public SqliteDatabase::WriteObserver {
+  public:
+    struct Update {
+      kj::String name;
+      uint64_t offset;
+      uint64_t size;
+    };
+
+    void updated(kj::StringPtr name, uint64_t offset,
+                 kj::ArrayPtr<const byte> data) const override {
+      updates.add(Update { kj::str(name), offset, data.size() });
+    }
+    void truncated(kj::StringPtr name, uint64_t size) const override {
+      truncates.add(kj::str(name));
+    }
+    void deleted(kj::StringPtr name) const override {
+      deletes.add(kj::str(name));
+    }
+
+    mutable kj::Vector<Update> updates;
+    mutable kj::Vector<kj::String> truncates;
+    mutable kj::Vector<kj::String> deletes;
+  };
+
+  auto dir = kj::newInMemoryDirectory(kj::nullClock());
+  Recorder recorder;
+  SqliteDatabase::Vfs vfs(*dir, {.writeObserver = recorder});
+
+  SqliteDatabase db(vfs, kj::Path({"foo"}), kj::WriteMode::CREATE | kj::WriteMode::MODIFY);
+
+  db.run("CREATE TABLE things (id INTEGER PRIMARY KEY, value TEXT)");
+  db.run("INSERT INTO things VALUES (123, 'hello')");
+
+  uint64_t pageSize = db.run("PRAGMA page_size;").getInt64(0);
+
+  // All writes to the main database file are whole, aligned pages, so the observer can compute
+  // page numbers from offsets.
+  uint mainDbWrites = 0;
+  for (auto& update: recorder.updates) {
+    if (update.name == "foo") {
+      KJ_EXPECT(update.offset % pageSize == 0, update.offset);
+      KJ_EXPECT(update.size == pageSize, update.size);
+      ++mainDbWrites;
+    }
+  }
+  KJ_EXPECT(mainDbWrites > 0);
+
+  // In the default (DELETE) journal mode, each commit deletes the rollback journal, which gives
+  // a replication consumer its "transaction durable" signal.
+  bool sawJournalDelete = false;
+  for (auto& name: recorder.deletes) {
+    if (name == "foo-journal") sawJournalDelete = true;
+  }
+  KJ_EXPECT(sawJournalDelete);
+}
+
+KJ_TEST("SQLite manual WAL checkpoint scheduling") {
+  auto dir = kj::newInMemoryDirectory(kj::nullClock());
+  SqliteDatabase::Vfs vfs(*dir);
+  SqliteDatabase db(vfs, kj::Path({"foo"}), kj::WriteMode::CREATE | kj::WriteMode::MODIFY);
+
+  setupSql(db);
+
+  // Take over checkpoint scheduling from the automatic threshold.
+  db.setAutoCheckpointThreshold(kj::none);
+
+  // Commit a bunch of writes; with auto-checkpointing off, they accumulate in the WAL.
+  for (uint i = 0; i < 10; i++) {
+    db.run("INSERT INTO people (id, name, email) VALUES (?, ?, ?)",
+           1000 + i, kj::str("person", i), kj::str("person", i, "@example.com"));
+  }
+  KJ_EXPECT(db.getWalFrameCount() > 0);
+
+  // A truncating checkpoint transfers everything into the main database and empties the WAL.
+  auto result = db.checkpoint(SqliteDatabase::CheckpointMode::TRUNCATE);
+  KJ_EXPECT(!result.busy);
+  KJ_EXPECT(result.walFrames > 0);
+  KJ_EXPECT(result.checkpointedFrames == result.walFrames);
+  KJ_EXPECT(db.getWalFrameCount() == 0);
+
+  {
+    auto file = KJ_ASSERT_NONNULL(dir->tryOpenFile(kj::Path({"foo-wal"})));
+    KJ_EXPECT(file->stat().size == 0);
+  }
+
+  // The data survived the trip through the checkpoint.
+  KJ_EXPECT(db.run("SELECT count(*) FROM people").getInt(0) == 12);
+}
+
+KJ_TEST("SQLite page cache limits") {
+  auto dir = kj::newInMemoryDirectory(kj::nullClock());
+  SqliteDatabase::Vfs vfs(*dir, {.pageCacheLimitKiB = 64});
+  SqliteDatabase db(vfs, kj::Path({"foo"}), kj::WriteMode::CREATE | kj::WriteMode::MODIFY);
+
+  setupSql(db);
+  checkSql(db);
+
+  // The per-database cache cap was applied at open. (A negative value means KiB.)
+  KJ_EXPECT(db.run("PRAGMA cache_size;").getInt64(0) == -64);
+
+  // The process-wide budget is settable and reports the previous value back.
+  SqliteDatabase::setSoftHeapLimit(256ull * 1024 * 1024);
+  KJ_EXPECT(SqliteDatabase::setSoftHeapLimit(0) == 256ull * 1024 * 1024);
+}
+
 }  // namespace
 }  // namespace workerd
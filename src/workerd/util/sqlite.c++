@@ -403,9 +403,23 @@ SqliteDatabase::SqliteDatabase(const Vfs& vfs, kj::PathPtr path, kj::Maybe<kj::W
   KJ_ON_SCOPE_FAILURE(sqlite3_close_v2(db));
 
   setupSecurity();
+  setupWalHook();
+
+  KJ_IF_SOME(limit, vfs.options.pageCacheLimitKiB) {
+    // A negative cache_size limits the cache to that many KiB, rather than counting pages.
+    run(TRUSTED, kj::str("PRAGMA cache_size = -", limit));
+  }
+}
+
+uint64_t SqliteDatabase::setSoftHeapLimit(uint64_t bytes) {
+  return (uint64_t)sqlite3_soft_heap_limit64((sqlite3_int64)bytes);
 }
 
 SqliteDatabase::~SqliteDatabase() noexcept(false) {
+  // Drop cached prepared statements first: sqlite3_close() fails if any statements remain
+  // unfinalized.
+  evictStatementsOverLimit(0);
+
   auto err = sqlite3_close(db);
   if (err == SQLITE_BUSY) {
     KJ_LOG(ERROR, "sqlite database destroyed while dependent objects still exist");
@@ -423,6 +437,61 @@ void SqliteDatabase::notifyWrite() {
   }
 }
 
+void SqliteDatabase::setupWalHook() {
+  sqlite3_wal_hook(db, [](void* userdata, sqlite3* db, const char* dbName, int frames) -> int {
+    // Careful: This is a C callback, so exceptions cannot pass through it.
+    auto& self = *reinterpret_cast<SqliteDatabase*>(userdata);
+    self.walFrameCount = frames < 0 ? 0 : (uint)frames;
+
+    KJ_IF_SOME(threshold, self.autoCheckpointThreshold) {
+      if (self.walFrameCount >= threshold) {
+        // Mirror SQLite's built-in auto-checkpoint: passive mode, ignoring the result. A failed
+        // or incomplete checkpoint just means the WAL stays large until a later attempt; it must
+        // not fail the commit that triggered it.
+        sqlite3_wal_checkpoint_v2(db, dbName, SQLITE_CHECKPOINT_PASSIVE, nullptr, nullptr);
+      }
+    }
+
+    return SQLITE_OK;
+  }, this);
+}
+
+SqliteDatabase::CheckpointResult SqliteDatabase::checkpoint(CheckpointMode mode) {
+  int sqliteMode = 0;
+  switch (mode) {
+    case CheckpointMode::PASSIVE: sqliteMode = SQLITE_CHECKPOINT_PASSIVE; break;
+    case CheckpointMode::FULL: sqliteMode = SQLITE_CHECKPOINT_FULL; break;
+    case CheckpointMode::RESTART: sqliteMode = SQLITE_CHECKPOINT_RESTART; break;
+    case CheckpointMode::TRUNCATE: sqliteMode = SQLITE_CHECKPOINT_TRUNCATE; break;
+  }
+
+  int walFrames = 0;
+  int checkpointedFrames = 0;
+  int rc = sqlite3_wal_checkpoint_v2(db, nullptr, sqliteMode, &walFrames, &checkpointedFrames);
+
+  if (rc == SQLITE_BUSY) {
+    // A competing reader or checkpointer held the locks the requested mode needs.
+    return { .walFrames = walFrameCount, .checkpointedFrames = 0, .busy = true };
+  }
+
+  Regulator& regulator = TRUSTED;
+  SQLITE_CALL_FAILED("sqlite3_wal_checkpoint_v2()", rc);
+
+  // The out-params are -1 when the database isn't in WAL mode.
+  if (walFrames < 0) walFrames = 0;
+  if (checkpointedFrames < 0) checkpointedFrames = 0;
+
+  if (mode == CheckpointMode::TRUNCATE) {
+    walFrameCount = 0;
+  }
+
+  return {
+    .walFrames = (uint)walFrames,
+    .checkpointedFrames = (uint)checkpointedFrames,
+    .busy = false,
+  };
+}
+
 kj::StringPtr SqliteDatabase::getCurrentQueryForDebug() {
   KJ_IF_SOME(s, currentStatement) {
     return sqlite3_normalized_sql(&s);
@@ -434,7 +503,8 @@ kj::StringPtr SqliteDatabase::getCurrentQueryForDebug() {
 // Set up the regulator that will be used for authorizer callbacks while preparing this
 // statement.
 kj::Own<sqlite3_stmt> SqliteDatabase::prepareSql(
-    Regulator& regulator, kj::StringPtr sqlCode, uint prepFlags, Multi multi) {
+    Regulator& regulator, kj::StringPtr sqlCode, uint prepFlags, Multi multi,
+    kj::Maybe<bool&> sawMultiStatements) {
   KJ_ASSERT(currentRegulator == kj::none, "recursive prepareSql()?");
   KJ_DEFER(currentRegulator = kj::none);
   currentRegulator = regulator;
@@ -458,6 +528,9 @@ kj::Own<sqlite3_stmt> SqliteDatabase::prepareSql(
       case MULTI:
         if (tail != sqlCode.end()) {
           // There are more statements after this one, so execute this statement now.
+          KJ_IF_SOME(flag, sawMultiStatements) {
+            flag = true;
+          }
 
           SQLITE_REQUIRE(sqlite3_bind_parameter_count(result) == 0,
               "When executing multiple SQL statements in a single call, only the last statement "
@@ -866,6 +939,49 @@ SqliteDatabase::Statement SqliteDatabase::prepare(Regulator& regulator, kj::Stri
       prepareSql(regulator, sqlCode, SQLITE_PREPARE_PERSISTENT, SINGLE));
 }
 
+void SqliteDatabase::setStatementCacheSize(size_t size) {
+  statementCacheLimit = size;
+  evictStatementsOverLimit(size);
+}
+
+kj::Maybe<SqliteDatabase::CachedStatement&> SqliteDatabase::findCachedStatement(
+    Regulator& regulator, kj::StringPtr sqlCode) {
+  KJ_IF_SOME(entry, statementCache.find(sqlCode)) {
+    if (&entry->regulator != &regulator || entry->inUse) {
+      return kj::none;
+    }
+    statementCacheLru.remove(*entry);
+    statementCacheLru.add(*entry);
+    return *entry;
+  }
+  return kj::none;
+}
+
+SqliteDatabase::CachedStatement& SqliteDatabase::addCachedStatement(
+    Regulator& regulator, kj::StringPtr sqlCode, kj::Own<sqlite3_stmt> stmt) {
+  auto entry = kj::heap<CachedStatement>(kj::str(sqlCode), regulator, kj::mv(stmt));
+  auto& result = *entry;
+  statementCacheLru.add(result);
+  statementCache.insert(result.sql, kj::mv(entry));
+  evictStatementsOverLimit(statementCacheLimit);
+  return result;
+}
+
+void SqliteDatabase::evictStatementsOverLimit(size_t limit) {
+  auto iter = statementCacheLru.begin();
+  while (statementCache.size() > limit && iter != statementCacheLru.end()) {
+    auto& entry = *iter;
+    ++iter;
+    if (entry.inUse) {
+      // A Query is still executing this statement; skip it. (It will age back to the front of
+      // the LRU and be evicted on a later pass once released.)
+      continue;
+    }
+    statementCacheLru.remove(entry);
+    KJ_ASSERT(statementCache.erase(entry.sql));
+  }
+}
+
 SqliteDatabase::Query::Query(SqliteDatabase& db, Regulator& regulator, Statement& statement,
                              kj::ArrayPtr<const ValuePtr> bindings)
     : db(db), regulator(regulator), statement(statement) {
@@ -877,12 +993,50 @@ SqliteDatabase::Query::Query(SqliteDatabase& db, Regulator& regulator, Statement
 
 SqliteDatabase::Query::Query(SqliteDatabase& db, Regulator& regulator, kj::StringPtr sqlCode,
                              kj::ArrayPtr<const ValuePtr> bindings)
-    : db(db), regulator(regulator),
-      ownStatement(db.prepareSql(regulator, sqlCode, 0, MULTI)),
-      statement(ownStatement) {
+    : db(db), regulator(regulator), statement(nullptr) {
+  initStatement(sqlCode);
   init(bindings);
 }
 
+void SqliteDatabase::Query::initStatement(kj::StringPtr sqlCode) {
+  if (db.statementCacheLimit > 0) {
+    KJ_IF_SOME(cached, db.findCachedStatement(regulator, sqlCode)) {
+      cached.inUse = true;
+      cachedStatement = cached;
+      statement = cached.stmt;
+      // The statement's row counters contain data from its previous execution; reset them.
+      resetRowCounters();
+      return;
+    }
+
+    bool sawMultiStatements = false;
+    auto prepared = db.prepareSql(
+        regulator, sqlCode, SQLITE_PREPARE_PERSISTENT, MULTI, sawMultiStatements);
+    if (!sawMultiStatements && db.statementCache.find(sqlCode) == kj::none) {
+      auto& cached = db.addCachedStatement(regulator, sqlCode, kj::mv(prepared));
+      cached.inUse = true;
+      cachedStatement = cached;
+      statement = cached.stmt;
+      return;
+    }
+
+    // We can't cache this statement, for one of two reasons:
+    // - The SQL contained multiple statements. The leading statements execute as a side effect
+    //   of preparation, so caching the (already-prepared) trailing statement would skip those
+    //   side effects on reuse.
+    // - The cache already holds an entry for this SQL which findCachedStatement() declined to
+    //   return, because it is busy executing another live Query or was prepared under a
+    //   different regulator. Inserting a second entry would collide with the existing key.
+    // Either way, run the statement we just prepared as a one-off.
+    ownStatement = kj::mv(prepared);
+    statement = ownStatement;
+    return;
+  }
+
+  ownStatement = db.prepareSql(regulator, sqlCode, 0, MULTI);
+  statement = ownStatement;
+}
+
 SqliteDatabase::Query::~Query() noexcept(false) {
   // We only need to reset the statement if we don't own it. If we own it, it's about to be
   // destroyed anyway.
@@ -895,6 +1049,10 @@ SqliteDatabase::Query::~Query() noexcept(false) {
     // should be interpreted, so we ignore it.
     sqlite3_clear_bindings(statement);
   }
+
+  KJ_IF_SOME(cached, cachedStatement) {
+    cached.inUse = false;
+  }
 }
 
 void SqliteDatabase::Query::checkRequirements(size_t size) {
@@ -1119,6 +1277,10 @@ struct SqliteDatabase::Vfs::WrappedNativeFileImpl: public sqlite3_file {
   const Vfs* vfs;
   int rootFd;
 
+  // Name passed to xOpen. SQLite guarantees this string remains valid until xClose, so we can
+  // just keep the pointer. null for unnamed temporary files.
+  const char* zName;
+
   // It's expected that the wrapped sqlite_file begins in memory immediately after this object.
   sqlite3_file* getWrapped() { return reinterpret_cast<sqlite3_file*>(this + 1); }
 
@@ -1169,8 +1331,36 @@ const sqlite3_io_methods SqliteDatabase::Vfs::WrappedNativeFileImpl::METHOD_TABL
 
   WRAP(xClose),
   WRAP(xRead),
-  WRAP(xWrite),
-  WRAP(xTruncate),
+  .xWrite = [](sqlite3_file* file, const void* buffer, int iAmt,
+               sqlite3_int64 iOfst) noexcept -> int {
+    auto wrapper = static_cast<WrappedNativeFileImpl*>(file);
+    file = wrapper->getWrapped();
+    KJ_ASSERT(currentVfsRoot == AT_FDCWD);
+    currentVfsRoot = wrapper->rootFd;
+    KJ_DEFER(currentVfsRoot = AT_FDCWD);
+    int result = (file->pMethods->xWrite)(file, buffer, iAmt, iOfst);
+    if (result == SQLITE_OK && wrapper->zName != nullptr) {
+      KJ_IF_SOME(observer, wrapper->vfs->options.writeObserver) {
+        observer.updated(wrapper->zName, iOfst,
+            kj::arrayPtr(reinterpret_cast<const byte*>(buffer), iAmt));
+      }
+    }
+    return result;
+  },
+  .xTruncate = [](sqlite3_file* file, sqlite3_int64 size) noexcept -> int {
+    auto wrapper = static_cast<WrappedNativeFileImpl*>(file);
+    file = wrapper->getWrapped();
+    KJ_ASSERT(currentVfsRoot == AT_FDCWD);
+    currentVfsRoot = wrapper->rootFd;
+    KJ_DEFER(currentVfsRoot = AT_FDCWD);
+    int result = (file->pMethods->xTruncate)(file, size);
+    if (result == SQLITE_OK && wrapper->zName != nullptr) {
+      KJ_IF_SOME(observer, wrapper->vfs->options.writeObserver) {
+        observer.truncated(wrapper->zName, size);
+      }
+    }
+    return result;
+  },
   WRAP(xSync),
   WRAP(xFileSize),
   WRAP(xLock),
@@ -1266,6 +1456,7 @@ sqlite3_vfs SqliteDatabase::Vfs::makeWrappedNativeVfs() {
         wrapper->pMethods = &WrappedNativeFileImpl::METHOD_TABLE;
         wrapper->vfs = &self;
         wrapper->rootFd = self.rootFd;
+        wrapper->zName = zName;
       }
 
       return result;
@@ -1274,7 +1465,19 @@ sqlite3_vfs SqliteDatabase::Vfs::makeWrappedNativeVfs() {
 #define WRAP(name) \
     .name = &MethodWrapperHack<decltype(&sqlite3_vfs::name), &sqlite3_vfs::name>::wrapper
 
-    WRAP(xDelete),
+    .xDelete = [](sqlite3_vfs* vfs, const char* zName, int syncDir) noexcept -> int {
+      auto& self = *reinterpret_cast<SqliteDatabase::Vfs*>(vfs->pAppData);
+      KJ_ASSERT(currentVfsRoot == AT_FDCWD);
+      currentVfsRoot = self.rootFd;
+      KJ_DEFER(currentVfsRoot = AT_FDCWD);
+      int result = self.native.xDelete(&self.native, zName, syncDir);
+      if (result == SQLITE_OK) {
+        KJ_IF_SOME(observer, self.options.writeObserver) {
+          observer.deleted(zName);
+        }
+      }
+      return result;
+    },
     WRAP(xAccess),
     .xFullPathname = [](sqlite3_vfs*, const char *zName, int nOut, char *zOut) -> int {
       // Override xFullPathname so that it doesn't rewrite the path at all.
@@ -1332,6 +1535,10 @@ struct SqliteDatabase::Vfs::FileImpl: public sqlite3_file {
   //
   // We leave this null if the file is not the main database file.
 
+  // The name SQLite opened this file under, for reporting to the Vfs's WriteObserver. Empty for
+  // unnamed temporary files, which are never reported.
+  kj::String name;
+
   FileImpl(const Vfs& vfs, kj::Own<const kj::File> file, kj::Maybe<kj::Own<Lock>> lock)
       : sqlite3_file { .pMethods = &FILE_METHOD_TABLE },
         vfs(vfs),
@@ -1387,6 +1594,11 @@ const sqlite3_io_methods SqliteDatabase::Vfs::FileImpl::FILE_METHOD_TABLE = {
       KJ_IF_SOME(writableFile, self.writableFile) {
         auto bytes = kj::arrayPtr(reinterpret_cast<const byte*>(buffer), iAmt);
         writableFile.write(iOfst, bytes);
+        if (self.name != nullptr) {
+          KJ_IF_SOME(observer, self.vfs.options.writeObserver) {
+            observer.updated(self.name, iOfst, bytes);
+          }
+        }
         return SQLITE_OK;
       } else {
         return SQLITE_READONLY;
@@ -1398,6 +1610,11 @@ const sqlite3_io_methods SqliteDatabase::Vfs::FileImpl::FILE_METHOD_TABLE = {
     WRAP_METHOD(SQLITE_IOERR_TRUNCATE, {
       KJ_IF_SOME(writableFile, self.writableFile) {
         writableFile.truncate(size);
+        if (self.name != nullptr) {
+          KJ_IF_SOME(observer, self.vfs.options.writeObserver) {
+            observer.truncated(self.name, size);
+          }
+        }
         return SQLITE_OK;
       } else {
         return SQLITE_READONLY;
@@ -1637,6 +1854,10 @@ sqlite3_vfs SqliteDatabase::Vfs::makeKjVfs() {
           kj::ctor(target, self, kj::mv(kjFile), kj::mv(lock));
         }
 
+        if (zName != nullptr) {
+          target.name = kj::str(zName);
+        }
+
         // In theory if read-write was requested, but failed, we should retry read-only, and then
         // alter the pOutFlags to reflect this... I'm not going to bother.
         if (pOutFlags != nullptr) {
@@ -1649,6 +1870,9 @@ sqlite3_vfs SqliteDatabase::Vfs::makeKjVfs() {
     .xDelete = [](sqlite3_vfs* vfs, const char *zName, int syncDir) -> int {
       WRAP_METHOD(SQLITE_IOERR_DELETE, {
         if (self.directory.tryRemove(kj::Path::parse(zName))) {
+          KJ_IF_SOME(observer, self.options.writeObserver) {
+            observer.deleted(zName);
+          }
           return SQLITE_OK;
         } else {
           return SQLITE_IOERR_DELETE_NOENT;
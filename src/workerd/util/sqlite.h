@@ -5,6 +5,8 @@
 #pragma once
 
 #include <kj/filesystem.h>
+#include <kj/list.h>
+#include <kj/map.h>
 #include <kj/one-of.h>
 #include <utility>
 
@@ -34,6 +36,7 @@ public:
   class Lock;
   class LockManager;
   class Regulator;
+  class WriteObserver;
   struct VfsOptions;
 
   struct IngestResult {
@@ -104,9 +107,99 @@ public:
   // Execute a function with the given regulator.
   void executeWithRegulator(Regulator& regulator, kj::FunctionParam<void()> func);
 
+  // Sets the maximum number of ad-hoc statements from run() to keep prepared for reuse; see
+  // `statementCache`. Setting a smaller size evicts immediately; zero disables the cache
+  // entirely (and drops any statements already cached).
+  void setStatementCacheSize(size_t size);
+
+  // ---------------------------------------------------------------------------------------------
+  // WAL checkpoint scheduling
+  //
+  // By default, the connection whose commit pushes the WAL past a threshold (1000 frames) runs a
+  // checkpoint synchronously before returning -- for a heavily-written database, that stall
+  // lands on whatever request happened to commit at the wrong time. Callers that want
+  // predictable commit latency can disable the automatic checkpoint and instead call
+  // checkpoint() themselves at idle moments, polling getWalFrameCount() to decide when it's
+  // worth doing.
+
+  enum class CheckpointMode {
+    // Copy what can be copied without waiting for readers; never blocks.
+    PASSIVE,
+    // Additionally wait for in-flight readers, so the whole WAL can be copied.
+    FULL,
+    // Like FULL, and also block new writers until the next writer restarts the WAL from the
+    // beginning.
+    RESTART,
+    // Like RESTART, and also truncate the WAL file to zero bytes.
+    TRUNCATE,
+  };
+
+  struct CheckpointResult {
+    // Total frames in the WAL, and how many of them had been transferred into the database file
+    // by the time the checkpoint finished.
+    uint walFrames;
+    uint checkpointedFrames;
+
+    // True if the checkpoint stopped short because a competing reader or checkpointer held the
+    // necessary locks. Not an error; try again later.
+    bool busy;
+  };
+
+  // Run a checkpoint now. Only meaningful for databases in WAL mode.
+  CheckpointResult checkpoint(CheckpointMode mode = CheckpointMode::PASSIVE);
+
+  // Sets the WAL frame count at which a commit triggers an automatic passive checkpoint,
+  // mirroring SQLite's built-in behavior (and its default of 1000). Pass kj::none to disable
+  // automatic checkpointing entirely, in which case the caller is responsible for calling
+  // checkpoint() periodically, lest the WAL grow without bound.
+  void setAutoCheckpointThreshold(kj::Maybe<uint> frames) { autoCheckpointThreshold = frames; }
+
+  // Frames in the WAL as of the most recent commit on this connection (zero before any commit,
+  // or if not in WAL mode). Cheap; suitable for polling to decide when to checkpoint.
+  uint getWalFrameCount() { return walFrameCount; }
+
+  // Sets a process-wide soft limit on SQLite's total heap usage, the bulk of which is page
+  // cache. When total usage passes the limit, SQLite reclaims clean cache pages from across
+  // every database in the process, most-recently-used pages surviving -- effectively one shared
+  // page cache budget with per-database views, where hot databases hold onto their pages and
+  // cold ones shrink on demand. Combine with `VfsOptions::pageCacheLimitKiB` to also bound any
+  // single database's share. Pass zero to remove the limit. Returns the previous limit.
+  static uint64_t setSoftHeapLimit(uint64_t bytes);
+
 private:
   sqlite3* db;
 
+  // A prepared statement retained by the ad-hoc statement cache. See `statementCache`.
+  struct CachedStatement {
+    CachedStatement(kj::String sql, Regulator& regulator, kj::Own<sqlite3_stmt> stmt)
+        : sql(kj::mv(sql)), regulator(regulator), stmt(kj::mv(stmt)) {}
+    KJ_DISALLOW_COPY_AND_MOVE(CachedStatement);
+
+    kj::String sql;
+
+    // The regulator the statement was prepared under. A cache hit requires the same regulator,
+    // since authorization decisions made during preparation depend on it.
+    Regulator& regulator;
+
+    kj::Own<sqlite3_stmt> stmt;
+
+    // Entries live in `statementCacheLru`, least-recently-used first.
+    kj::ListLink<CachedStatement> lruLink;
+
+    // True while a Query is executing this statement. A run() of the same SQL while the cached
+    // statement is busy falls back to preparing a one-off statement.
+    bool inUse = false;
+  };
+
+  // Cache of prepared statements for SQL text passed to run(), giving repetitive ad-hoc queries
+  // (e.g. ORM-generated SQL running through the JS SqlStorage API) prepare-once semantics
+  // without requiring callers to manage Statement objects themselves. Only single-statement SQL
+  // is cached: multi-statement strings execute their leading statements as a side effect of
+  // preparation, which must happen on every run().
+  kj::HashMap<kj::StringPtr, kj::Own<CachedStatement>> statementCache;
+  kj::List<CachedStatement, &CachedStatement::lruLink> statementCacheLru;
+  size_t statementCacheLimit = 64;
+
   // Set while a query is compiling.
   kj::Maybe<Regulator&> currentRegulator;
 
@@ -115,6 +208,17 @@ private:
 
   kj::Maybe<kj::Function<void()>> onWriteCallback;
 
+  // WAL frame count at which the WAL hook runs an automatic passive checkpoint after a commit;
+  // none disables automatic checkpointing. Matches SQLITE_DEFAULT_WAL_AUTOCHECKPOINT by default.
+  kj::Maybe<uint> autoCheckpointThreshold = 1000;
+
+  // WAL size reported by the most recent WAL hook invocation; see getWalFrameCount().
+  uint walFrameCount = 0;
+
+  // Install the WAL hook implementing `autoCheckpointThreshold` and `walFrameCount`. Note that
+  // this takes the place of SQLite's built-in auto-checkpoint hook, which uses the same slot.
+  void setupWalHook();
+
   void close();
 
   enum Multi { SINGLE, MULTI };
@@ -124,9 +228,26 @@ private:
   // In SINGLE mode, an exception is thrown if `sqlCode` contains multiple statements.
   //
   // In MULTI mode, if `sqlCode` contains multiple statements, each statement before the last one
-  // is executed immediately. The returned object represents the last statement.
+  // is executed immediately. The returned object represents the last statement. If
+  // `sawMultiStatements` is provided, it is set to indicate whether more than one statement was
+  // present (and hence whether side effects already occurred during preparation).
   kj::Own<sqlite3_stmt> prepareSql(
-      Regulator& regulator, kj::StringPtr sqlCode, uint prepFlags, Multi multi);
+      Regulator& regulator, kj::StringPtr sqlCode, uint prepFlags, Multi multi,
+      kj::Maybe<bool&> sawMultiStatements = kj::none);
+
+  // Look up `sqlCode` in the statement cache, refreshing its LRU position on a hit. Returns
+  // none if the statement isn't cached or can't be reused (wrong regulator, or currently
+  // executing).
+  kj::Maybe<CachedStatement&> findCachedStatement(Regulator& regulator, kj::StringPtr sqlCode);
+
+  // Add a statement to the cache, evicting least-recently-used entries if over the limit. The
+  // caller must have verified that no entry for `sqlCode` exists yet -- an unusable existing
+  // entry (in use, or wrong regulator) means the new statement must run as a one-off instead.
+  CachedStatement& addCachedStatement(
+      Regulator& regulator, kj::StringPtr sqlCode, kj::Own<sqlite3_stmt> stmt);
+
+  // Evict least-recently-used, not-in-use cached statements until at most `limit` remain.
+  void evictStatementsOverLimit(size_t limit);
 
   // Implements SQLite authorizer callback, see sqlite3_set_authorizer().
   bool isAuthorized(int actionCode,
@@ -293,7 +414,10 @@ public:
 private:
   SqliteDatabase& db;
   Regulator& regulator;
-  kj::Own<sqlite3_stmt> ownStatement;   // for one-off queries
+  kj::Own<sqlite3_stmt> ownStatement;   // for one-off queries that bypass the statement cache
+  // Set when running a statement borrowed from the db's statement cache; marked not-in-use
+  // again on destruction.
+  kj::Maybe<CachedStatement&> cachedStatement;
   sqlite3_stmt* statement;
   bool done = false;
 
@@ -310,12 +434,14 @@ private:
   }
   template <typename... Params>
   Query(SqliteDatabase& db, Regulator& regulator, kj::StringPtr sqlCode, Params&&... bindings)
-      : db(db), regulator(regulator),
-        ownStatement(db.prepareSql(regulator, sqlCode, 0, MULTI)),
-        statement(ownStatement) {
+      : db(db), regulator(regulator), statement(nullptr) {
+    initStatement(sqlCode);
     bindAll(std::index_sequence_for<Params...>(), kj::fwd<Params>(bindings)...);
   }
 
+  // Sets up `statement` for the given SQL, preferring the db's statement cache when possible.
+  void initStatement(kj::StringPtr sqlCode);
+
   void checkRequirements(size_t size);
 
   void init(kj::ArrayPtr<const ValuePtr> bindings);
@@ -343,6 +469,35 @@ private:
   }
 };
 
+// Observes mutations that SQLite makes to files opened through a `Vfs`. This is the building
+// block for incremental backup / replication: the observer sees every range of bytes written,
+// so it can forward just the changed pages to a standby rather than copying the whole database
+// file. Writes to the main database file are always whole pages, so `offset / page_size`
+// identifies the page being replaced. Batching and compression of the resulting deltas is left
+// to the implementation; callbacks are invoked synchronously on SQLite's I/O path and should
+// not block.
+//
+// Since a `Vfs` may be shared across threads, implementations must be thread-safe (hence all
+// methods are `const`).
+//
+// Note that the observer sees writes to *all* files SQLite manages, including the journal or
+// WAL. `name` is the VFS-relative file name as SQLite sees it (e.g. "foo", "foo-journal").
+// A replication implementation typically only needs to act on main database file changes that
+// are made durable, using `truncated()`/`deleted()` of the journal as the commit signal.
+class SqliteDatabase::WriteObserver {
+public:
+  // Called after `data` has been successfully written to the file at byte position `offset`.
+  // `data` is only valid for the duration of the call.
+  virtual void updated(kj::StringPtr name, uint64_t offset,
+                       kj::ArrayPtr<const byte> data) const = 0;
+
+  // Called after the file has been successfully truncated to `size` bytes.
+  virtual void truncated(kj::StringPtr name, uint64_t size) const {}
+
+  // Called after the file has been deleted.
+  virtual void deleted(kj::StringPtr name) const {}
+};
+
 // Options affecting SqliteDatabase::Vfs onstructor.
 struct SqliteDatabase::VfsOptions {
 
@@ -362,6 +517,20 @@ struct SqliteDatabase::VfsOptions {
   // will fall back to the native VFS implementation. In that case, the options you set here will
   // be ORed with the ones set by the underlying VFS.
   int deviceCharacteristics = 0x00001000;  // = SQLITE_FCNTL_POWERSAFE_OVERWRITE
+
+  // If non-null, the observer is notified of all mutations SQLite makes to files opened through
+  // this VFS. This allows capturing an incremental change stream -- e.g. to replicate a database
+  // to a warm standby -- without copying the whole file. The observer must remain valid for the
+  // lifetime of the `Vfs`.
+  kj::Maybe<const WriteObserver&> writeObserver = kj::none;
+
+  // If set, each database opened through this VFS limits its private page cache to this many
+  // kibibytes (via `PRAGMA cache_size`) instead of SQLite's default of 2000 KiB. When thousands
+  // of small actor databases live in one process, the per-connection default dominates RSS even
+  // though most databases are cold. A small per-database cap, combined with the process-wide
+  // budget of `SqliteDatabase::setSoftHeapLimit()`, keeps aggregate cache memory bounded while
+  // still letting hot databases keep their working set.
+  kj::Maybe<uint> pageCacheLimitKiB = kj::none;
 };
 
 // Implements a SQLite VFS based on a KJ directory.
@@ -0,0 +1,48 @@
+// Copyright (c) 2017-2022 Cloudflare, Inc.
+// Licensed under the Apache 2.0 license found in the LICENSE file or at:
+//     https://opensource.org/licenses/Apache-2.0
+
+#include "stream-utils.h"
+#include <kj/test.h>
+
+namespace workerd {
+namespace {
+
+KJ_TEST("PooledBuffer recycles buffers within a thread") {
+  kj::byte* first;
+  {
+    auto buffer = acquirePooledBuffer(4096);
+    KJ_EXPECT(buffer.size() >= 4096);
+    first = buffer.begin();
+    memset(buffer.begin(), 0xab, buffer.size());
+  }
+  {
+    // Same size class, so we get the recycled buffer back.
+    auto buffer = acquirePooledBuffer(100);
+    KJ_EXPECT(buffer.begin() == first);
+  }
+}
+
+KJ_TEST("PooledBuffer rounds up to its size class") {
+  auto buffer = acquirePooledBuffer(5000);
+  KJ_EXPECT(buffer.size() == 16384);
+}
+
+KJ_TEST("PooledBuffer bypasses the pool for large requests") {
+  kj::byte* first;
+  {
+    auto buffer = acquirePooledBuffer(1024 * 1024);
+    KJ_EXPECT(buffer.size() == 1024 * 1024);
+    first = buffer.begin();
+  }
+  {
+    // Not pooled, so a fresh allocation of exactly the requested size each time. (The
+    // allocator may of course reuse the address; just check the size here.)
+    auto buffer = acquirePooledBuffer(2 * 1024 * 1024);
+    KJ_EXPECT(buffer.size() == 2 * 1024 * 1024);
+    KJ_EXPECT(buffer.begin() != first || buffer.size() != 1024 * 1024);
+  }
+}
+
+}  // namespace
+}  // namespace workerd
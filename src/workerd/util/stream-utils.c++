@@ -3,6 +3,7 @@
 #include <kj/exception.h>
 #include <kj/one-of.h>
 #include <kj/debug.h>
+#include <kj/vector.h>
 
 namespace workerd {
 
@@ -211,4 +212,56 @@ kj::Own<NeuterableIoStream> newNeuterableIoStream(kj::AsyncIoStream& inner) {
   return kj::heap<NeuterableIoStreamImpl>(inner);
 }
 
+namespace {
+
+// Size classes chosen to match the buffer sizes our streaming paths actually request:
+// small pump chunks, the default stream read chunk, and large tee/copy chunks.
+constexpr size_t BUFFER_SIZE_CLASSES[] = { 4096, 16384, 65536 };
+
+// Per thread, per class. Three classes at four buffers each caps the idle footprint of a
+// thread's pool at 336KiB, only ever reached if the thread actually used that many
+// buffers concurrently.
+constexpr size_t MAX_POOLED_PER_CLASS = 4;
+
+struct BufferPool {
+  kj::Vector<kj::Array<kj::byte>> freeLists[kj::size(BUFFER_SIZE_CLASSES)];
+};
+thread_local BufferPool threadBufferPool;
+
+kj::Maybe<kj::uint> sizeClassFor(size_t size) {
+  for (auto i: kj::indices(BUFFER_SIZE_CLASSES)) {
+    if (size <= BUFFER_SIZE_CLASSES[i]) return kj::uint(i);
+  }
+  return kj::none;
+}
+
+}  // namespace
+
+PooledBuffer::~PooledBuffer() noexcept(false) {
+  KJ_IF_SOME(c, sizeClass) {
+    if (buffer.size() > 0) {
+      // Note that if we were moved to another thread, this recycles the buffer into that
+      // thread's pool, which is harmless.
+      auto& freeList = threadBufferPool.freeLists[c];
+      if (freeList.size() < MAX_POOLED_PER_CLASS) {
+        freeList.add(kj::mv(buffer));
+      }
+    }
+  }
+}
+
+PooledBuffer acquirePooledBuffer(size_t size) {
+  KJ_IF_SOME(c, sizeClassFor(size)) {
+    auto& freeList = threadBufferPool.freeLists[c];
+    if (freeList.size() > 0) {
+      auto buffer = kj::mv(freeList.back());
+      freeList.removeLast();
+      return PooledBuffer(kj::mv(buffer), c);
+    }
+    return PooledBuffer(kj::heapArray<kj::byte>(BUFFER_SIZE_CLASSES[c]), c);
+  }
+  // Too big to pool.
+  return PooledBuffer(kj::heapArray<kj::byte>(size), kj::none);
+}
+
 }  // namespace workerd
@@ -26,5 +26,39 @@ public:
 kj::Own<NeuterableInputStream> newNeuterableInputStream(kj::AsyncInputStream&);
 kj::Own<NeuterableIoStream> newNeuterableIoStream(kj::AsyncIoStream&);
 
+class PooledBuffer;
+
+// Borrow a scratch byte buffer of at least `size` bytes from a small thread-local,
+// size-classed pool. Hot streaming paths (body pumps, tee reads) need a transient buffer
+// per operation; recycling a few warm buffers per thread avoids a round trip through the
+// allocator each time. The returned buffer may be larger than requested. Requests larger
+// than the largest size class fall back to a plain heap allocation that is freed rather
+// than pooled.
+PooledBuffer acquirePooledBuffer(size_t size);
+
+// RAII handle for a buffer borrowed via acquirePooledBuffer(). Returns the buffer to the
+// pool of whichever thread destroys it. The contents are not zeroed between uses.
+class PooledBuffer {
+public:
+  PooledBuffer(PooledBuffer&&) = default;
+  PooledBuffer& operator=(PooledBuffer&&) = default;
+  ~PooledBuffer() noexcept(false);
+  KJ_DISALLOW_COPY(PooledBuffer);
+
+  kj::ArrayPtr<kj::byte> asPtr() { return buffer; }
+  operator kj::ArrayPtr<kj::byte>() { return buffer; }
+  kj::byte* begin() { return buffer.begin(); }
+  size_t size() const { return buffer.size(); }
+
+private:
+  PooledBuffer(kj::Array<kj::byte> buffer, kj::Maybe<kj::uint> sizeClass)
+      : buffer(kj::mv(buffer)), sizeClass(sizeClass) {}
+  friend PooledBuffer acquirePooledBuffer(size_t size);
+
+  kj::Array<kj::byte> buffer;
+
+  // Which size class to return the buffer to, or kj::none if it bypassed the pool.
+  kj::Maybe<kj::uint> sizeClass;
+};
 
 }  // namespace workerd
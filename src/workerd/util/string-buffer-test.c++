@@ -44,5 +44,28 @@ KJ_TEST("overflow") {
     "abcabcabcabcabcabcabc"_kj == buffer.toString());
 }
 
+KJ_TEST("forEachSegment") {
+  StringBuffer<10> buffer(11);
+  KJ_EXPECT(buffer.size() == 0);
+
+  // An empty buffer yields no segments.
+  buffer.forEachSegment([](kj::ArrayPtr<const char> segment) {
+    KJ_FAIL_EXPECT("expected no segments", segment);
+  });
+
+  for (auto i = 0; i < 100; i++) {
+    buffer.append("abc");
+  }
+  KJ_EXPECT(buffer.size() == 300);
+
+  // Segments concatenate to the same bytes toString() produces, without gaps or overlap.
+  kj::Vector<char> assembled;
+  buffer.forEachSegment([&](kj::ArrayPtr<const char> segment) {
+    KJ_EXPECT(segment.size() > 0);
+    assembled.addAll(segment);
+  });
+  KJ_EXPECT(kj::str(assembled.asPtr()) == buffer.toString());
+}
+
 } // namespace
 } // namespace workerd
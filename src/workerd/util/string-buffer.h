@@ -36,6 +36,31 @@ public:
     return result;
   }
 
+  // Total number of bytes appended so far.
+  size_t size() const { return len; }
+
+  // Invokes func(kj::ArrayPtr<const char>) once for each filled segment, in order. The data is
+  // already chained in segments internally, so this lets consumers that can take scattered
+  // buffers (writev-style I/O, incremental hashing, etc.) read the content without the
+  // intermediate linearization copy that toString() performs. Segment pointers are only valid
+  // until the next append().
+  template <typename Func>
+  void forEachSegment(Func&& func) const {
+    size_t onStack = kj::min(len, StackSize);
+    if (onStack > 0) {
+      func(kj::ArrayPtr<const char>(arr, onStack));
+    }
+
+    size_t remaining = len - onStack;
+    for (auto& chunk: chunks) {
+      if (remaining == 0) break;
+      size_t inChunk = kj::min(remaining, chunk.size()); // last chunk won't be full
+      func(kj::ArrayPtr<const char>(chunk.begin(), inChunk));
+      remaining -= inChunk;
+    }
+    KJ_IREQUIRE(remaining == 0);
+  }
+
 private:
   // minimum heap chunk size
   const size_t heapChunkSize;
@@ -96,23 +121,10 @@ private:
   }
 
   void copyTo(char* dest) {
-    // copy stack portion first
-    size_t onStack = kj::min(len, StackSize);
-    memcpy(dest, arr, onStack);
-    dest += onStack;
-
-    // copy from heap chunks
-    if (onStack < len) {
-      size_t remaining = len - onStack;
-      for (auto& chunk: chunks) {
-        size_t inChunk = kj::min(remaining, chunk.size()); // last chunk won't be full
-        memcpy(dest, chunk.begin(), inChunk);
-        dest += inChunk;
-        remaining -= inChunk;
-      }
-
-      KJ_IREQUIRE(remaining == 0);
-    }
+    forEachSegment([&](kj::ArrayPtr<const char> segment) {
+      memcpy(dest, segment.begin(), segment.size());
+      dest += segment.size();
+    });
   }
 };
 
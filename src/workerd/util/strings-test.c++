@@ -0,0 +1,54 @@
+// Copyright (c) 2023 Cloudflare, Inc.
+// Licensed under the Apache 2.0 license found in the LICENSE file or at:
+//     https://opensource.org/licenses/Apache-2.0
+
+#include "strings.h"
+#include <kj/test.h>
+
+namespace workerd {
+namespace {
+
+KJ_TEST("toLowerCopy") {
+  // Short strings exercise the scalar tail; longer ones exercise the 16-byte-wide kernel,
+  // including inputs whose length is not a multiple of the vector width.
+  KJ_EXPECT(toLowerCopy("") == "");
+  KJ_EXPECT(toLowerCopy("a") == "a");
+  KJ_EXPECT(toLowerCopy("A") == "a");
+  KJ_EXPECT(toLowerCopy("Content-Type") == "content-type");
+  KJ_EXPECT(toLowerCopy("ABCDEFGHIJKLMNOP") == "abcdefghijklmnop");
+  KJ_EXPECT(toLowerCopy("ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789") ==
+            "abcdefghijklmnopqrstuvwxyz0123456789");
+  KJ_EXPECT(toLowerCopy("Access-Control-Allow-Credentials") ==
+            "access-control-allow-credentials");
+
+  // Bytes adjacent to the uppercase range and bytes >= 0x80 must pass through unchanged.
+  KJ_EXPECT(toLowerCopy("@AZ[`az{") == "@az[`az{");
+  KJ_EXPECT(toLowerCopy("\x80\xC1\xFF@AZ[\x80\xC1\xFF@AZ[\x80\xC1") ==
+            "\x80\xC1\xFF@az[\x80\xC1\xFF@az[\x80\xC1");
+}
+
+KJ_TEST("equalsIgnoreCase") {
+  KJ_EXPECT(equalsIgnoreCase("", ""));
+  KJ_EXPECT(equalsIgnoreCase("Set-Cookie", "set-cookie"));
+  KJ_EXPECT(equalsIgnoreCase("SET-COOKIE", "set-cookie"));
+  KJ_EXPECT(!equalsIgnoreCase("set-cookie", "set-cookies"));
+  KJ_EXPECT(!equalsIgnoreCase("set-cookie", "set-cookiE!"));
+  KJ_EXPECT(!equalsIgnoreCase("cookie", "rookie"));
+
+  // Long enough to hit the vector loop, with the mismatch in the scalar tail and vice versa.
+  KJ_EXPECT(equalsIgnoreCase("Access-Control-Allow-Credentials",
+                             "access-control-allow-credentials"));
+  KJ_EXPECT(!equalsIgnoreCase("Access-Control-Allow-Credentials",
+                              "access-control-allow-credentialz"));
+  KJ_EXPECT(!equalsIgnoreCase("Xccess-Control-Allow-Credentials",
+                              "access-control-allow-credentials"));
+
+  // Only ASCII letters fold: '@' (0x40) and '`' (0x60) differ by the case bit but are distinct,
+  // as are high bytes differing by 0x20.
+  KJ_EXPECT(!equalsIgnoreCase("@", "`"));
+  KJ_EXPECT(!equalsIgnoreCase("\xC0", "\xE0"));
+  KJ_EXPECT(equalsIgnoreCase("\xC0\xE0", "\xC0\xE0"));
+}
+
+}  // namespace
+}  // namespace workerd
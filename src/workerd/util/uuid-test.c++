@@ -4,6 +4,7 @@
 
 #include "uuid.h"
 #include <kj/test.h>
+#include <kj/vector.h>
 
 namespace workerd {
 namespace {
@@ -48,5 +49,23 @@ KJ_TEST("Invalid UUIDs") {
   KJ_EXPECT(UUID::fromString("0123456789abcdef0123456789abcdef") == kj::none);
 }
 
+KJ_TEST("Random UUIDs are valid and unique across entropy block refills") {
+  // Enough UUIDs to force the thread-local entropy block to refill several times.
+  kj::Vector<kj::String> uuids;
+  for (int i = 0; i < 200; i++) {
+    auto uuid = randomUUID(kj::none);
+    KJ_ASSERT(uuid.size() == 36);
+    KJ_ASSERT(uuid[8] == '-' && uuid[13] == '-' && uuid[18] == '-' && uuid[23] == '-');
+    KJ_ASSERT(uuid[14] == '4');  // Version 4.
+    KJ_ASSERT(uuid[19] == '8' || uuid[19] == '9' || uuid[19] == 'a' || uuid[19] == 'b');
+    uuids.add(kj::mv(uuid));
+  }
+  for (auto i: kj::indices(uuids)) {
+    for (size_t j = i + 1; j < uuids.size(); j++) {
+      KJ_ASSERT(uuids[i] != uuids[j]);
+    }
+  }
+}
+
 } // namespace
 } // namespace workerd
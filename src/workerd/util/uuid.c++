@@ -7,20 +7,58 @@
 #include <kj/compat/http.h>
 #include <openssl/rand.h>
 #include <cstdlib>
+#include <cstring>
 
 namespace workerd {
 namespace {
 constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+// Entropy for UUIDs is harvested in blocks and sliced 16 bytes at a time, amortizing the
+// cost of a CSPRNG invocation across many UUIDs; workers generating per-record IDs in
+// streaming pipelines call randomUUID() at very high rates. The block is keyed by the
+// entropy source that filled it (nullptr for the default RAND_bytes path), so a call with
+// a different source discards whatever the previous source prefetched. Note that this
+// means UUID bytes are drawn from a source in batches, ahead of other consumers of the
+// same source; that is indistinguishable for a CSPRNG.
+//
+// Consumed bytes are scrubbed so spent entropy doesn't linger in memory.
+constexpr size_t ENTROPY_BLOCK_UUIDS = 64;
+
+struct EntropyBlock {
+  kj::EntropySource* source = nullptr;
+  size_t pos = sizeof(bytes);  // Start exhausted.
+  kj::byte bytes[16 * ENTROPY_BLOCK_UUIDS];
+};
+thread_local EntropyBlock threadEntropyBlock;
+
+void fillUuidEntropy(kj::byte (&buffer)[16], kj::Maybe<kj::EntropySource&> optionalEntropySource) {
+  auto& block = threadEntropyBlock;
+  kj::EntropySource* source = nullptr;
+  KJ_IF_SOME(entropySource, optionalEntropySource) {
+    source = &entropySource;
+  }
+
+  if (block.source != source || block.pos == sizeof(block.bytes)) {
+    if (source == nullptr) {
+      KJ_ASSERT(RAND_bytes(block.bytes, sizeof(block.bytes)) == 1);
+    } else {
+      source->generate(block.bytes);
+    }
+    block.source = source;
+    block.pos = 0;
+  }
+
+  memcpy(buffer, block.bytes + block.pos, sizeof(buffer));
+  memset(block.bytes + block.pos, 0, sizeof(buffer));
+  block.pos += sizeof(buffer);
+}
+
 }  // namespace
 
 kj::String randomUUID(kj::Maybe<kj::EntropySource&> optionalEntropySource) {
   kj::byte buffer[16]{};
 
-  KJ_IF_SOME(entropySource, optionalEntropySource) {
-    entropySource.generate(buffer);
-  } else {
-    KJ_ASSERT(RAND_bytes(buffer, sizeof(buffer)) == 1);
-  }
+  fillUuidEntropy(buffer, optionalEntropySource);
   buffer[6] = kj::byte((buffer[6] & 0x0f) | 0x40);
   buffer[8] = kj::byte((buffer[8] & 0x3f) | 0x80);
 
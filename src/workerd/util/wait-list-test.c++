@@ -99,5 +99,28 @@ KJ_TEST("CrossThreadWaitList exceptions") {
   }
 }
 
+KJ_TEST("CrossThreadWaitList canceled waiters unlink promptly") {
+  CrossThreadWaitList list;
+
+  {
+    kj::EventLoop loop;
+    kj::WaitScope ws(loop);
+
+    // Register some waiters and drop them without waiting. Each destructor must unlink from its
+    // shard immediately rather than leaving a dangling entry for fulfill() to find later.
+    for (uint i = 0; i < 10; i++) {
+      auto promise = list.addWaiter();
+      KJ_ASSERT(!promise.poll(ws));
+    }
+
+    // A fresh waiter registered after the cancellations still works.
+    auto promise = list.addWaiter();
+    list.fulfill();
+    promise.wait(ws);
+  }
+
+  KJ_ASSERT(list.isDone());
+}
+
 }  // namespace
 }  // namespace workerd
@@ -5,6 +5,8 @@
 #include "wait-list.h"
 #include <kj/debug.h>
 
+#include <atomic>
+
 namespace workerd {
 
 namespace {
@@ -12,6 +14,14 @@ namespace {
 // share the signal rather than send two cross-thread signals.
 thread_local CrossThreadWaitList::WaiterMap threadLocalWaiters;
 
+// Each thread is assigned one shard for all its waiter registrations, so threads only contend on
+// a shard mutex when their shard assignments happen to collide.
+uint pickShard(uint shardCount) {
+  static std::atomic<uint> counter{0};
+  thread_local uint index = counter.fetch_add(1, std::memory_order_relaxed);
+  return index % shardCount;
+}
+
 void END_WAIT_LIST_CANCELER_STACK_START_CANCELEE_STACK() {}
 }  // namespace
 
@@ -24,8 +34,9 @@ void CrossThreadWaitList::destroyed() {
 
 CrossThreadWaitList::Waiter::Waiter(const State& state,
     kj::Own<kj::CrossThreadPromiseFulfiller<void>> fulfillerArg)
-    : state(kj::atomicAddRef(state)), fulfiller(kj::mv(fulfillerArg)) {
-  auto lock = state.waiters.lockExclusive();
+    : state(kj::atomicAddRef(state)), fulfiller(kj::mv(fulfillerArg)),
+      shardIndex(pickShard(State::SHARD_COUNT)) {
+  auto lock = state.shards[shardIndex].waiters.lockExclusive();
   if (__atomic_load_n(&state.done, __ATOMIC_ACQUIRE)) {
     KJ_IF_SOME(e, state.exception) {
       fulfiller->reject(kj::cp(e));
@@ -41,7 +52,7 @@ CrossThreadWaitList::Waiter::~Waiter() noexcept(false) {
     // No need to take a lock, already unlinked.
     KJ_ASSERT(!link.isLinked());
   } else {
-    auto lock = state->waiters.lockExclusive();
+    auto lock = state->shards[shardIndex].waiters.lockExclusive();
     if (link.isLinked()) {
       lock->remove(*this);
     }
@@ -119,41 +130,61 @@ kj::Own<kj::CrossThreadPromiseFulfiller<void>> CrossThreadWaitList::makeSeparate
 
 void CrossThreadWaitList::State::fulfill() const {
   if (__atomic_load_n(&done, __ATOMIC_ACQUIRE)) return;
-  auto lock = waiters.lockExclusive();
-  if (done) return;
-  __atomic_store_n(&done, true, __ATOMIC_RELEASE);
-
-  for (auto& waiter: *lock) {
-    lock->remove(waiter);
-    waiter.fulfiller->fulfill();
-    __atomic_store_n(&waiter.unlinked, true, __ATOMIC_RELEASE);
+  {
+    auto lock = transitionLock.lockExclusive();
+    if (done) return;
+    __atomic_store_n(&done, true, __ATOMIC_RELEASE);
+  }
+
+  // New waiters observe `done` under their shard lock, so each shard only needs to be drained
+  // once: anyone who manages to link before we take a given shard's lock is woken here, and
+  // anyone who comes later fulfills themselves directly.
+  for (auto& shard: shards) {
+    auto lock = shard.waiters.lockExclusive();
+    for (auto& waiter: *lock) {
+      lock->remove(waiter);
+      waiter.fulfiller->fulfill();
+      __atomic_store_n(&waiter.unlinked, true, __ATOMIC_RELEASE);
+    }
   }
 }
 
 void CrossThreadWaitList::State::reject(kj::Exception&& e) const {
   if (__atomic_load_n(&done, __ATOMIC_ACQUIRE)) return;
-  auto lock = waiters.lockExclusive();
-  if (done) return;
-  auto& exceptionRef = exception.emplace(kj::mv(e));
-  __atomic_store_n(&done, true, __ATOMIC_RELEASE);
-
-  for (auto& waiter: *lock) {
-    lock->remove(waiter);
-    waiter.fulfiller->reject(kj::cp(exceptionRef));
-    __atomic_store_n(&waiter.unlinked, true, __ATOMIC_RELEASE);
+  {
+    auto lock = transitionLock.lockExclusive();
+    if (done) return;
+    // `exception` must be fully written before `done` is published, since waiters read it with
+    // no lock in common beyond their own shard's.
+    exception.emplace(kj::mv(e));
+    __atomic_store_n(&done, true, __ATOMIC_RELEASE);
+  }
+  auto& exceptionRef = KJ_ASSERT_NONNULL(exception);
+
+  for (auto& shard: shards) {
+    auto lock = shard.waiters.lockExclusive();
+    for (auto& waiter: *lock) {
+      lock->remove(waiter);
+      waiter.fulfiller->reject(kj::cp(exceptionRef));
+      __atomic_store_n(&waiter.unlinked, true, __ATOMIC_RELEASE);
+    }
   }
 }
 
 void CrossThreadWaitList::State::lostFulfiller() const {
   if (__atomic_load_n(&done, __ATOMIC_ACQUIRE)) return;
-  auto lock = waiters.lockExclusive();
-  if (done) return;
-  auto& exceptionRef = exception.emplace(kj::getDestructionReason(
-        reinterpret_cast<void*>(&END_WAIT_LIST_CANCELER_STACK_START_CANCELEE_STACK),
-        kj::Exception::Type::FAILED, __FILE__, __LINE__, "wait list was never fulfilled"_kj));
-  __atomic_store_n(&done, true, __ATOMIC_RELEASE);
-
-  if (!lock->empty()) {
+  {
+    auto lock = transitionLock.lockExclusive();
+    if (done) return;
+    exception.emplace(kj::getDestructionReason(
+          reinterpret_cast<void*>(&END_WAIT_LIST_CANCELER_STACK_START_CANCELEE_STACK),
+          kj::Exception::Type::FAILED, __FILE__, __LINE__, "wait list was never fulfilled"_kj));
+    __atomic_store_n(&done, true, __ATOMIC_RELEASE);
+  }
+  auto& exceptionRef = KJ_ASSERT_NONNULL(exception);
+
+  for (auto& shard: shards) {
+    auto lock = shard.waiters.lockExclusive();
     for (auto& waiter: *lock) {
       lock->remove(waiter);
       waiter.fulfiller->reject(kj::cp(exceptionRef));
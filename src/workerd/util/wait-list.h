@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <kj/array.h>
 #include <kj/mutex.h>
 #include <kj/async.h>
 #include <kj/list.h>
@@ -79,7 +80,10 @@ private:
     kj::Own<const State> state;
     kj::Own<kj::CrossThreadPromiseFulfiller<void>> fulfiller;
 
-    // Protected by list mutex.
+    // Which of the state's shards this waiter registered with.
+    uint shardIndex;
+
+    // Protected by the shard's mutex.
     kj::ListLink<Waiter> link;
 
     // Optimization: This is atomically set true when the waiter is removed from the list so that
@@ -91,12 +95,26 @@ private:
   };
 
   struct State: public kj::AtomicRefcounted {
-    kj::MutexGuarded<kj::List<Waiter, &Waiter::link>> waiters;
+    // Waiter registration is sharded to reduce mutex contention when many threads register
+    // waiters against the same list (e.g. hibernating-socket wakeup fan-out). Each thread
+    // consistently uses one shard, so registration from N threads only contends 1/SHARD_COUNT of
+    // the time; fulfillment drains the shards one at a time.
+    static constexpr uint SHARD_COUNT = 16;
+
+    struct Shard {
+      kj::MutexGuarded<kj::List<Waiter, &Waiter::link>> waiters;
+    };
+    kj::Array<Shard> shards;
+
+    // Serializes the `done` transition in fulfill()/reject()/lostFulfiller(), since `exception`
+    // must be fully written before `done` is published. Shard mutexes are taken afterward, one at
+    // a time, to drain the waiters.
+    kj::MutexGuarded<uint> transitionLock;
 
     const bool useThreadLocalOptimization = false;
 
     // Atomically set true at the start of fulfill() or reject(). This can be checked before taking
-    // the lock, but if false, it must be checked again after taking the lock, to avoid a race.
+    // a shard lock, but if false, it must be checked again after taking the lock, to avoid a race.
     mutable bool done = false;
 
     // If `done` is true due to `reject()` being called, this is the exception. This field
@@ -109,7 +127,8 @@ private:
     void lostFulfiller() const;
 
     explicit State(const Options& options)
-        : useThreadLocalOptimization(options.useThreadLocalOptimization) {}
+        : shards(kj::heapArray<Shard>(SHARD_COUNT)),
+          useThreadLocalOptimization(options.useThreadLocalOptimization) {}
   };
 
   kj::Own<const State> state;
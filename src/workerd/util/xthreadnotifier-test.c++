@@ -0,0 +1,67 @@
+// Copyright (c) 2017-2022 Cloudflare, Inc.
+// Licensed under the Apache 2.0 license found in the LICENSE file or at:
+//     https://opensource.org/licenses/Apache-2.0
+
+#include "xthreadnotifier.h"
+
+#include <kj/test.h>
+
+namespace workerd {
+namespace {
+
+KJ_TEST("XThreadNotifier coalesces rapid notifications into one wakeup") {
+  kj::EventLoop loop;
+  kj::WaitScope ws(loop);
+
+  auto notifier = XThreadNotifier::create();
+
+  notifier->notify();
+  notifier->notify();
+  notifier->notify();
+
+  // All three notifications collapse into a single wakeup.
+  notifier->awaitNotification().wait(ws);
+
+  auto next = notifier->awaitNotification();
+  KJ_EXPECT(!next.poll(ws));
+
+  // A fresh notification after the consumer re-armed produces a new wakeup.
+  notifier->notify();
+  KJ_EXPECT(next.poll(ws));
+  next.wait(ws);
+}
+
+KJ_TEST("XThreadNotifier wakes all concurrent waiters") {
+  kj::EventLoop loop;
+  kj::WaitScope ws(loop);
+
+  auto notifier = XThreadNotifier::create();
+
+  auto first = notifier->awaitNotification();
+  auto second = notifier->awaitNotification();
+  KJ_EXPECT(!first.poll(ws));
+  KJ_EXPECT(!second.poll(ws));
+
+  notifier->notify();
+
+  KJ_EXPECT(first.poll(ws));
+  KJ_EXPECT(second.poll(ws));
+  first.wait(ws);
+  second.wait(ws);
+}
+
+KJ_TEST("XThreadNotifier does not lose notifications delivered between rounds") {
+  kj::EventLoop loop;
+  kj::WaitScope ws(loop);
+
+  auto notifier = XThreadNotifier::create();
+
+  notifier->notify();
+  notifier->awaitNotification().wait(ws);
+
+  notifier->notify();
+  notifier->awaitNotification().wait(ws);
+}
+
+}  // namespace
+}  // namespace workerd
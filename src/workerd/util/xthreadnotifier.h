@@ -7,11 +7,22 @@
 #include <kj/async.h>
 #include <kj/mutex.h>
 
+#include <atomic>
+
 namespace workerd {
 
 class XThreadNotifier final: public kj::AtomicRefcounted {
   // Class encapsulating the ability to notify a waiting thread from other threads.
   //
+  // Notifications are coalesced: if notify() is called several times before the waiting thread
+  // gets around to processing the notification, only the first call pays for a cross-thread
+  // wakeup and the rest just flip an atomic flag. This matters for the inspector channel, where
+  // bursts of CDP messages used to issue one executor call each.
+  //
+  // Multiple concurrent waiters are supported; a notification wakes all of them. Waiters must
+  // always re-check their queues after awaitNotification() resolves, as coalescing can produce
+  // spurious wakeups.
+  //
   // TODO(cleanup): Can this be consolidated with wait-list.h?
   //
   // TODO(cleanup): This could be a lot simpler if only it were possible to cancel
@@ -23,23 +34,55 @@ public:
     return kj::atomicRefcounted<XThreadNotifier>();
   }
 
-  XThreadNotifier() : paf(kj::newPromiseAndCrossThreadFulfiller<void>()) { }
+  XThreadNotifier(): state(makeState()) {}
 
   kj::Promise<void> awaitNotification() {
-    auto promise = kj::mv(paf.lockExclusive()->promise);
-    co_await promise;
-    auto lockedPaf = paf.lockExclusive();
-    auto nextPaf = kj::newPromiseAndCrossThreadFulfiller<void>();
-    lockedPaf->promise = kj::mv(nextPaf.promise);
-    lockedPaf->fulfiller = kj::mv(nextPaf.fulfiller);
+    auto lockedState = state.lockExclusive();
+    auto branch = lockedState->promise.addBranch();
+    uint64_t generation = lockedState->generation;
+    lockedState.release();
+    co_await branch;
+    auto locked = state.lockExclusive();
+    if (locked->generation == generation) {
+      // We're the first waiter from this round to wake, so re-arm for the next round. The
+      // `pending` flag must only be cleared after the new fulfiller is installed, otherwise a
+      // concurrent notify() could fulfill the already-consumed one and the wakeup would be lost.
+      auto nextPaf = kj::newPromiseAndCrossThreadFulfiller<void>();
+      locked->promise = nextPaf.promise.fork();
+      locked->fulfiller = kj::mv(nextPaf.fulfiller);
+      ++locked->generation;
+      pending.store(false, std::memory_order_release);
+    }
+    // Note that our caller necessarily inspects its queues after this point, so any notify() that
+    // was coalesced away (i.e. saw `pending` still set) published its work before our re-arm and
+    // will be observed now.
   }
 
   void notify() const {
-    paf.lockExclusive()->fulfiller->fulfill();
+    if (!pending.exchange(true, std::memory_order_acq_rel)) {
+      state.lockExclusive()->fulfiller->fulfill();
+    }
   }
 
 private:
-  kj::MutexGuarded<kj::PromiseCrossThreadFulfillerPair<void>> paf;
+  struct State {
+    kj::ForkedPromise<void> promise;
+    kj::Own<kj::CrossThreadPromiseFulfiller<void>> fulfiller;
+
+    // Incremented each time the promise is re-armed, so that only the first waiter to wake from
+    // a given round performs the re-arm.
+    uint64_t generation;
+  };
+
+  static State makeState() {
+    auto paf = kj::newPromiseAndCrossThreadFulfiller<void>();
+    return State { paf.promise.fork(), kj::mv(paf.fulfiller), 0 };
+  }
+
+  kj::MutexGuarded<State> state;
+
+  // True if a notification has been delivered but not yet consumed by a waiter.
+  mutable std::atomic<bool> pending{false};
 };
 
 }  // namespace workerd
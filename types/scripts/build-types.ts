@@ -118,6 +118,32 @@ function spawnWorkerd(
   });
 }
 
+// Most compatibility dates produce byte-identical definitions for most files, so formatting
+// and type-checking each entrypoint's output from scratch repeats a lot of expensive work.
+// Memoize on the raw definitions text; entries are promises so that entrypoints built
+// concurrently share a single in-flight format/check for identical input.
+const formattedTypings = new Map<string, Promise<string>>();
+
+function formatAndCheckTypings(definitions: string): Promise<string> {
+  let promise = formattedTypings.get(definitions);
+  if (promise === undefined) {
+    promise = (async () => {
+      const prettierIgnoreRegexp = /^\s*\/\/\s*prettier-ignore\s*\n/gm;
+      let typings = definitions.replaceAll(prettierIgnoreRegexp, "");
+
+      typings = await prettier.format(typings, {
+        parser: "typescript",
+      });
+
+      checkDiagnostics(new SourcesMap([["/$virtual/source.ts", typings]]));
+
+      return typings;
+    })();
+    formattedTypings.set(definitions, promise);
+  }
+  return promise;
+}
+
 async function buildEntrypoint(
   entrypoint: (typeof ENTRYPOINTS)[number],
   workerUrl: URL
@@ -132,22 +158,18 @@ async function buildEntrypoint(
   await fs.mkdir(entrypointPath, { recursive: true });
   for (const [name, definitions] of bundle) {
     assert(typeof definitions === "string");
-    const prettierIgnoreRegexp = /^\s*\/\/\s*prettier-ignore\s*\n/gm;
-    let typings = definitions.replaceAll(prettierIgnoreRegexp, "");
-
-    typings = await prettier.format(typings, {
-      parser: "typescript",
-    });
-
-    checkDiagnostics(new SourcesMap([["/$virtual/source.ts", typings]]));
-
+    const typings = await formatAndCheckTypings(definitions);
     await fs.writeFile(path.join(entrypointPath, name), typings);
   }
 }
 
 async function buildAllEntrypoints(workerUrl: URL) {
-  for (const entrypoint of ENTRYPOINTS)
-    await buildEntrypoint(entrypoint, workerUrl);
+  // Entrypoints are independent of one another, so extract them all concurrently; the worker
+  // handles the parallel bundle requests and the format/check work for outputs shared between
+  // dates is deduplicated by formatAndCheckTypings().
+  await Promise.all(
+    ENTRYPOINTS.map((entrypoint) => buildEntrypoint(entrypoint, workerUrl))
+  );
 }
 export async function main() {
   const worker = await spawnWorkerd("./types/scripts/config.capnp");